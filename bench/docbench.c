@@ -0,0 +1,320 @@
+/**
+ * @file docbench.c
+ * @brief End-to-end benchmark of the formatters over whole documents
+ *
+ *     docbench [-n runs] [-j json] -p command... corpus...
+ *
+ * Each command given with -p, a program and its arguments separated by
+ * spaces, is run on each corpus as its standard input, and the best
+ * wall time of the runs is reported as pages and input megabytes per
+ * second, with the peak resident size the kernel reports for the child.
+ * One more run, under ptrace(), counts the system calls the command
+ * and any threads or processes it starts make (Linux only; `-`
+ * elsewhere, or where tracing is not allowed).  Each command is also
+ * run on an empty input, for what it costs to start and stop.
+ *
+ * The pages of a corpus are those the first command writes for it, in
+ * nroff's 66-line pages; the pages per second of the other commands,
+ * the preprocessors among them, are of the same pages.  A corpus the
+ * first command writes nothing for has no page rate.
+ *
+ * With -j the results are also written, as JSON, to the file given.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#ifdef __linux__
+#include <sys/ptrace.h>
+#endif
+
+#define DB_RUNS 5 /* runs of each corpus, the best is kept */
+#define DB_PAGELEN 66 /* lines in a page of nroff output */
+#define DB_MAXCMD 16 /* commands given with -p */
+#define DB_MAXARG 32 /* words in a command */
+
+/* One run of a command: what it wrote and what it took */
+struct run {
+    size_t nout;
+    long pages;
+    double secs;
+    long maxrss; /* kilobytes */
+};
+
+/* A command given with -p */
+struct cmd {
+    char *text;
+    char *argv[DB_MAXARG + 1];
+};
+
+static void fail(const char *msg, const char *arg) {
+    fprintf(stderr, "docbench: %s %s\n", msg, arg);
+    exit(1);
+}
+
+static double now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Split text at spaces into c->argv */
+static void parse(struct cmd *c, const char *text) {
+    char *p;
+    int n;
+
+    if ((c->text = malloc(strlen(text) + 1)) == NULL || (p = malloc(strlen(text) + 1)) == NULL)
+        fail("out of memory", "");
+    strcpy(c->text, text);
+    strcpy(p, text);
+    for (n = 0, p = strtok(p, " "); p != NULL; p = strtok(NULL, " ")) {
+        if (n == DB_MAXARG)
+            fail("too many words in", text);
+        c->argv[n++] = p;
+    }
+    if (n == 0)
+        fail("empty command", "");
+    c->argv[n] = NULL;
+}
+
+/* Pages in the output at fd: its lines in DB_PAGELEN-line pages */
+static long pages(int fd) {
+    char buf[8192];
+    ssize_t r, i;
+    long lines = 0;
+    int last = '\n';
+
+    lseek(fd, 0, SEEK_SET);
+    while ((r = read(fd, buf, sizeof(buf))) > 0)
+        for (i = 0; i < r; i++)
+            lines += (last = buf[i]) == '\n';
+    lines += last != '\n';
+    return (lines + DB_PAGELEN - 1) / DB_PAGELEN;
+}
+
+/* Run c with in as its standard input, once */
+static void run1(struct cmd *c, int in, struct run *r) {
+    char tmpl[] = "/tmp/docbenchXXXXXX";
+    struct rusage ru;
+    double t0;
+    pid_t pid;
+    int out, status;
+
+    if ((out = mkstemp(tmpl)) < 0)
+        fail("cannot create", tmpl);
+    unlink(tmpl);
+    lseek(in, 0, SEEK_SET);
+    t0 = now();
+    if ((pid = fork()) < 0)
+        fail("cannot fork for", c->text);
+    if (pid == 0) {
+        dup2(in, 0);
+        dup2(out, 1);
+        execv(c->argv[0], c->argv);
+        _exit(127);
+    }
+    while (wait4(pid, &status, 0, &ru) < 0)
+        if (errno != EINTR)
+            fail("lost", c->text);
+    r->secs = now() - t0;
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 127)
+        fail("cannot run", c->text);
+    r->maxrss = ru.ru_maxrss;
+    r->nout = (size_t)lseek(out, 0, SEEK_END);
+    r->pages = pages(out);
+    close(out);
+}
+
+/* The best of n runs of c on in */
+static struct run best(struct cmd *c, int in, int n) {
+    struct run b, r;
+    int k;
+
+    for (k = 0; k < n; k++) {
+        run1(c, in, &r);
+        if (k == 0 || r.secs < b.secs)
+            b = r;
+    }
+    return b;
+}
+
+/*
+ * System calls made by one run of c on in, by every thread and process
+ * it starts; -1 if they cannot be counted.  A call is counted at its
+ * entry, so one that never returns, such as exit_group(), counts too.
+ */
+static long syscalls(struct cmd *c, int in) {
+#if defined(__linux__) && defined(PTRACE_GET_SYSCALL_INFO)
+    struct __ptrace_syscall_info info;
+    long n = 0;
+    pid_t pid, w;
+    int out, status, sig;
+
+    if ((out = open("/dev/null", O_WRONLY)) < 0)
+        return -1;
+    lseek(in, 0, SEEK_SET);
+    if ((pid = fork()) < 0)
+        fail("cannot fork for", c->text);
+    if (pid == 0) {
+        dup2(in, 0);
+        dup2(out, 1);
+        if (ptrace(PTRACE_TRACEME, 0, NULL, NULL) < 0)
+            _exit(126);
+        execv(c->argv[0], c->argv);
+        _exit(127);
+    }
+    close(out);
+    /* The first stop is at the exec; a child that exits did not get that far */
+    if (waitpid(pid, &status, 0) < 0 || !WIFSTOPPED(status))
+        return -1;
+    ptrace(PTRACE_SETOPTIONS, pid, NULL,
+           (void *)(long)(PTRACE_O_TRACESYSGOOD | PTRACE_O_TRACECLONE | PTRACE_O_TRACEFORK |
+                          PTRACE_O_TRACEVFORK | PTRACE_O_EXITKILL));
+    ptrace(PTRACE_SYSCALL, pid, NULL, NULL);
+    while ((w = waitpid(-1, &status, __WALL)) > 0) {
+        if (!WIFSTOPPED(status))
+            continue; /* a thread or process ended */
+        sig = WSTOPSIG(status);
+        if (sig == (SIGTRAP | 0x80)) {
+            if (ptrace(PTRACE_GET_SYSCALL_INFO, w, (void *)sizeof(info), &info) > 0 &&
+                info.op == PTRACE_SYSCALL_INFO_ENTRY)
+                n++;
+            sig = 0;
+        } else if (sig == SIGTRAP || sig == SIGSTOP)
+            sig = 0; /* a clone, fork or exec event, or a new task's first stop */
+        ptrace(PTRACE_SYSCALL, w, NULL, (void *)(long)sig);
+    }
+    return n;
+#else
+    (void)c;
+    (void)in;
+    return -1;
+#endif
+}
+
+/* s as a JSON string */
+static void jstr(FILE *f, const char *s) {
+    putc('"', f);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\')
+            putc('\\', f);
+        putc(*s, f);
+    }
+    putc('"', f);
+}
+
+/* One result: a line of the table, and a JSON object if json is open */
+static void report(FILE *json, int *first, struct cmd *c, const char *corpus, size_t nin,
+                   long npages, struct run *b, long nsys) {
+    double mbs = b->secs > 0 ? nin / b->secs / 1e6 : 0;
+    double pps = npages > 0 && b->secs > 0 ? npages / b->secs : 0;
+
+    printf("%-22s %-22s %7zu %5ld %9.2f ", c->text, corpus, nin / 1024, npages, b->secs * 1e3);
+    if (npages > 0)
+        printf("%9.0f ", pps);
+    else
+        printf("%9s ", "-");
+    if (nin > 0)
+        printf("%7.2f ", mbs);
+    else
+        printf("%7s ", "-");
+    printf("%8ld ", b->maxrss);
+    if (nsys >= 0)
+        printf("%9ld\n", nsys);
+    else
+        printf("%9s\n", "-");
+    if (json == NULL)
+        return;
+    fprintf(json, "%s\n    {\"command\": ", *first ? "" : ",");
+    jstr(json, c->text);
+    fprintf(json, ", \"corpus\": ");
+    jstr(json, corpus);
+    fprintf(json,
+            ", \"in_bytes\": %zu, \"out_bytes\": %zu, \"pages\": %ld, \"secs\": %.6f, "
+            "\"pages_per_sec\": %.1f, \"mb_per_sec\": %.3f, \"peak_kb\": %ld, \"syscalls\": %ld}",
+            nin, b->nout, npages, b->secs, pps, mbs, b->maxrss, nsys);
+    *first = 0;
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: docbench [-n runs] [-j json] -p command... corpus...\n");
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    static struct cmd cmds[DB_MAXCMD];
+    const char *jfile = NULL;
+    struct run b;
+    size_t nin;
+    long npages;
+    int i, k, in, ncmd = 0, nruns = DB_RUNS, first = 1;
+    FILE *json = NULL;
+
+    for (; argc > 1 && argv[1][0] == '-'; argc--, argv++) {
+        if (argc < 3)
+            usage();
+        switch (argv[1][1]) {
+        case 'n':
+            nruns = atoi(argv[2]);
+            break;
+        case 'j':
+            jfile = argv[2];
+            break;
+        case 'p':
+            if (ncmd == DB_MAXCMD)
+                fail("too many commands", "");
+            parse(&cmds[ncmd++], argv[2]);
+            break;
+        default:
+            usage();
+        }
+        argc--, argv++;
+    }
+    if (argc < 2 || ncmd == 0 || nruns < 1)
+        usage();
+    if (jfile != NULL) {
+        if ((json = fopen(jfile, "w")) == NULL)
+            fail("cannot write", jfile);
+        fprintf(json, "{\"runs\": %d, \"page_lines\": %d, \"results\": [", nruns, DB_PAGELEN);
+    }
+
+    printf("%-22s %-22s %7s %5s %9s %9s %7s %8s %9s\n", "command", "corpus", "in KB", "pages",
+           "ms", "pages/s", "MB/s", "peak KB", "syscalls");
+    for (k = 0; k < ncmd; k++) {
+        if ((in = open("/dev/null", O_RDONLY)) < 0)
+            fail("cannot read", "/dev/null");
+        b = best(&cmds[k], in, nruns);
+        report(json, &first, &cmds[k], "(start-up)", 0, 0, &b, syscalls(&cmds[k], in));
+        close(in);
+    }
+    for (i = 1; i < argc; i++) {
+        if ((in = open(argv[i], O_RDONLY)) < 0)
+            fail("cannot read", argv[i]);
+        nin = (size_t)lseek(in, 0, SEEK_END);
+        npages = 0;
+        for (k = 0; k < ncmd; k++) {
+            b = best(&cmds[k], in, nruns);
+            if (k == 0)
+                npages = b.pages;
+            report(json, &first, &cmds[k], argv[i], nin, npages, &b, syscalls(&cmds[k], in));
+        }
+        close(in);
+    }
+    if (json != NULL) {
+        fprintf(json, "\n]}\n");
+        if (fclose(json) != 0)
+            fail("cannot write", jfile);
+    }
+    return 0;
+}
@@ -0,0 +1,296 @@
+/**
+ * @file eqnbench.c
+ * @brief neqn throughput benchmark and golden-output check
+ *
+ *     eqnbench [-n runs] [-a shim] [-c dir | -g dir] neqn corpus...
+ *
+ * Each corpus is given to the neqn named as its standard input, the
+ * way a pipeline before troff would, and the best wall time of the
+ * runs is reported as equations and input bytes per second, with the
+ * output size and the peak resident size the kernel reports for the
+ * child.  With -a the shared object given (alloccount.so) is preloaded
+ * for one more run to count the calls to the allocator.
+ *
+ * With -c the output of each corpus is compared with <dir>/<corpus
+ * name>.golden and any difference makes the exit status 1, so that a
+ * speed-up cannot change the output unnoticed; a corpus with no golden
+ * file is reported and skipped.  -g writes the golden files instead.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#define EB_RUNS 5 /* runs of each corpus, the best is kept */
+
+/* One run of neqn: what it wrote and what it took */
+struct run {
+    char *out;
+    size_t nout;
+    double secs;
+    long maxrss; /* kilobytes */
+    long allocs[4]; /* malloc, calloc, realloc, free; -1 if not counted */
+};
+
+static void fail(const char *msg, const char *arg) {
+    fprintf(stderr, "eqnbench: %s %s\n", msg, arg);
+    exit(1);
+}
+
+static double now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* The whole of a file, NUL-terminated; *n is its length */
+static char *slurp(const char *file, size_t *n) {
+    FILE *f;
+    char *p;
+    long len;
+
+    if ((f = fopen(file, "rb")) == NULL)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    rewind(f);
+    if ((p = malloc((size_t)len + 1)) == NULL)
+        fail("out of memory", "");
+    *n = fread(p, 1, (size_t)len, f);
+    p[*n] = 0;
+    fclose(f);
+    return p;
+}
+
+/* Read everything left in fd from the start */
+static char *readback(int fd, size_t *n) {
+    char *p = NULL;
+    size_t cap = 0;
+    ssize_t r;
+
+    *n = 0;
+    lseek(fd, 0, SEEK_SET);
+    for (;;) {
+        if (*n + 8192 + 1 > cap && (p = realloc(p, cap = 2 * cap + 8192 + 1)) == NULL)
+            fail("out of memory", "");
+        if ((r = read(fd, p + *n, 8192)) <= 0)
+            break;
+        *n += (size_t)r;
+    }
+    p[*n] = 0;
+    return p;
+}
+
+/*
+ * Displays and inline equations in a corpus: one per .EQ line, and
+ * one per pair of delimiters once a "delim" line has set them.
+ */
+static long equations(const char *s) {
+    const char *p, *nl;
+    long n = 0, k;
+    int left = 0;
+
+    for (p = s; *p; p = nl + 1) {
+        if ((nl = strchr(p, '\n')) == NULL)
+            nl = p + strlen(p);
+        if (strncmp(p, ".EQ", 3) == 0)
+            n++;
+        else if (strncmp(p, "delim ", 6) == 0 && p[6] != '\n')
+            left = strncmp(p + 6, "off", 3) == 0 ? 0 : (unsigned char)p[6];
+        else if (left && p[0] != '.') {
+            for (k = 0; p < nl; p++)
+                k += (*p == left);
+            n += k / 2;
+        }
+        if (*nl == 0)
+            break;
+    }
+    return n;
+}
+
+/* Run neqn on corpus once, with the allocator shim preloaded if given */
+static void run1(const char *neqn, const char *corpus, const char *shim, struct run *r) {
+    char tmpl[] = "/tmp/eqnbenchXXXXXX", cnt[] = "/tmp/eqnallocXXXXXX", *c;
+    struct rusage ru;
+    double t0;
+    size_t n;
+    pid_t pid;
+    int in, out, cfd = -1, status, k;
+
+    if ((in = open(corpus, O_RDONLY)) < 0)
+        fail("cannot open", corpus);
+    if ((out = mkstemp(tmpl)) < 0)
+        fail("cannot create", tmpl);
+    unlink(tmpl);
+    if (shim != NULL) {
+        if ((cfd = mkstemp(cnt)) < 0)
+            fail("cannot create", cnt);
+        unlink(cnt);
+    }
+    t0 = now();
+    if ((pid = fork()) < 0)
+        fail("cannot fork for", neqn);
+    if (pid == 0) {
+        dup2(in, 0);
+        dup2(out, 1);
+        if (shim != NULL) {
+            dup2(cfd, 3);
+            setenv("LD_PRELOAD", shim, 1);
+            setenv("EQNBENCH_ALLOCFD", "3", 1);
+        }
+        execl(neqn, neqn, (char *)NULL);
+        _exit(127);
+    }
+    while (wait4(pid, &status, 0, &ru) < 0)
+        if (errno != EINTR)
+            fail("lost", neqn);
+    r->secs = now() - t0;
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 127)
+        fail("cannot run", neqn);
+    r->maxrss = ru.ru_maxrss;
+    r->out = readback(out, &r->nout);
+    for (k = 0; k < 4; k++)
+        r->allocs[k] = -1;
+    if (shim != NULL) {
+        c = readback(cfd, &n);
+        if (sscanf(c, "%ld %ld %ld %ld", &r->allocs[0], &r->allocs[1], &r->allocs[2],
+                   &r->allocs[3]) != 4)
+            for (k = 0; k < 4; k++)
+                r->allocs[k] = -1;
+        free(c);
+        close(cfd);
+    }
+    close(in);
+    close(out);
+}
+
+/* <dir>/<last part of corpus without .txt>.golden */
+static char *goldname(const char *dir, const char *corpus) {
+    const char *b, *e;
+    char *g;
+
+    b = (b = strrchr(corpus, '/')) != NULL ? b + 1 : corpus;
+    e = strrchr(b, '.');
+    if (e == NULL || strcmp(e, ".txt") != 0)
+        e = b + strlen(b);
+    if ((g = malloc(strlen(dir) + (size_t)(e - b) + 9)) == NULL)
+        fail("out of memory", "");
+    sprintf(g, "%s/%.*s.golden", dir, (int)(e - b), b);
+    return g;
+}
+
+/* Compare out with the golden file; 1 if they differ */
+static int check(const char *gold, const char *out, size_t nout) {
+    const char *p, *q;
+    char *g;
+    size_t ng;
+    long line;
+
+    if ((g = slurp(gold, &ng)) == NULL) {
+        printf("  no %s, not checked\n", gold);
+        return 0;
+    }
+    if (ng == nout && memcmp(g, out, nout) == 0) {
+        free(g);
+        return 0;
+    }
+    for (p = g, q = out, line = 1; p < g + ng && q < out + nout && *p == *q; p++, q++)
+        line += (*p == '\n');
+    printf("  output differs from %s at line %ld\n", gold, line);
+    free(g);
+    return 1;
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: eqnbench [-n runs] [-a shim] [-c dir | -g dir] neqn corpus...\n");
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    const char *neqn, *shim = NULL, *cdir = NULL, *gdir = NULL;
+    struct run best, r;
+    char *src, *g;
+    size_t nsrc;
+    long neq;
+    int i, k, nruns = EB_RUNS, bad = 0;
+    FILE *f;
+
+    for (; argc > 1 && argv[1][0] == '-'; argc--, argv++) {
+        if (argc < 3)
+            usage();
+        switch (argv[1][1]) {
+        case 'n':
+            nruns = atoi(argv[2]);
+            break;
+        case 'a':
+            shim = argv[2];
+            break;
+        case 'c':
+            cdir = argv[2];
+            break;
+        case 'g':
+            gdir = argv[2];
+            break;
+        default:
+            usage();
+        }
+        argc--, argv++;
+    }
+    if (argc < 3 || nruns < 1)
+        usage();
+    neqn = argv[1];
+
+    printf("%-24s %9s %11s %11s %10s %9s %10s\n", "corpus", "equations", "eqn/s",
+           "bytes/s", "out bytes", "peak KB", "allocs");
+    for (i = 2; i < argc; i++) {
+        if ((src = slurp(argv[i], &nsrc)) == NULL)
+            fail("cannot read", argv[i]);
+        neq = equations(src);
+        memset(&best, 0, sizeof(best));
+        for (k = 0; k < nruns; k++) {
+            run1(neqn, argv[i], NULL, &r);
+            if (k == 0 || r.secs < best.secs) {
+                free(best.out);
+                best = r;
+            } else {
+                free(r.out);
+            }
+        }
+        if (shim != NULL) {
+            run1(neqn, argv[i], shim, &r);
+            memcpy(best.allocs, r.allocs, sizeof(best.allocs));
+            free(r.out);
+        }
+        printf("%-24s %9ld %11.0f %11.0f %10zu %9ld ", argv[i], neq, neq / best.secs,
+               nsrc / best.secs, best.nout, best.maxrss);
+        if (best.allocs[0] >= 0)
+            printf("%10ld\n", best.allocs[0] + best.allocs[1] + best.allocs[2]);
+        else
+            printf("%10s\n", "-");
+
+        if (gdir != NULL) {
+            g = goldname(gdir, argv[i]);
+            if ((f = fopen(g, "wb")) == NULL || fwrite(best.out, 1, best.nout, f) != best.nout ||
+                fclose(f) != 0)
+                fail("cannot write", g);
+            free(g);
+        } else if (cdir != NULL) {
+            g = goldname(cdir, argv[i]);
+            bad |= check(g, best.out, best.nout);
+            free(g);
+        }
+        free(best.out);
+        free(src);
+    }
+    return bad;
+}
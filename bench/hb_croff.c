@@ -0,0 +1,145 @@
+/**
+ * @file hb_croff.c
+ * @brief croff's n8.c hyphenator as a benchmark engine
+ *
+ * n8.c is included whole, as test_n8.c does, with the few formatter
+ * globals and input routines it touches defined here.  Besides the
+ * hyphenateWord() entry point, hb_croff_upto() runs the word only as
+ * far as a given phase, so that hyphbench.c can charge the time to
+ * exword(), suffix() and digram() by difference.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tdef.h"
+#include "hyphbench.h"
+
+/* Formatter state n8.c expects to find elsewhere */
+int *wdstart, *wdend;
+int *hyptr[NHYP];
+int **hyp;
+int hyoff;
+int suffid;
+int noscale;
+int xxx;
+
+#include "n8.c"
+
+/* Input routines used only by .hw and .ht, never called here */
+int skip(void) {
+    return 1;
+}
+
+int tatoi(void) {
+    return 0;
+}
+
+void prstr(const char *s) {
+    (void)s;
+}
+
+int getch(void) {
+    return '\n';
+}
+
+static int hbword[HB_WORD + 1];
+
+/* Copy word into hbword; 0 if it is too long */
+static int hbload(const char *word) {
+    int k;
+
+    for (k = 0; word[k]; k++) {
+        if (k == HB_WORD) {
+            return 0;
+        }
+        hbword[k] = (unsigned char)word[k];
+    }
+    hbword[k] = 0;
+    return 1;
+}
+
+void hb_croff_init(const char *except) {
+    if (except != NULL && hxload(except) < 0) {
+        fprintf(stderr, "hyphbench: cannot read %s\n", except);
+        exit(1);
+    }
+}
+
+void hb_croff_mode(int cache, int patterns) {
+    static int size = -1;
+
+    if (size < 0) {
+        size = hcsize;
+    }
+    hcsize = cache ? size : 0;
+    hypat = patterns;
+    hcclear();
+    hchit = hcmiss = 0;
+}
+
+void hb_croff(const char *word, char *out) {
+    int k, **h;
+
+    hyptr[0] = 0;
+    if (hbload(word)) {
+        hyphenateWord(hbword);
+    }
+    for (k = 0, h = hyptr; word[k]; k++) {
+        if (*h == &hbword[k]) {
+            *out++ = '-';
+        }
+        while (*h == &hbword[k]) {
+            h++;
+        }
+        *out++ = word[k];
+    }
+    *out = 0;
+}
+
+/*
+ * The set-up of hyphenateWord() followed by its phases up to and
+ * including phase, without the cache.  Returns the number of breaks
+ * so that the work cannot be optimised away.
+ */
+int hb_croff_upto(const char *word, int phase) {
+    int *i;
+
+    if (!hbload(word)) {
+        return 0;
+    }
+    i = hbword;
+    while (punct(*i++)) {
+    }
+    if (!alph(*--i)) {
+        return 0;
+    }
+    wdstart = i++;
+    while (alph(*i++)) {
+    }
+    hyend = wdend = --i - 1;
+    while (punct(*i++)) {
+    }
+    if (*--i || (wdend - wdstart - 4) < 0) {
+        return 0;
+    }
+    hyp = hyptr;
+    *hyp = 0;
+    hyoff = 2;
+
+    if (phase >= HB_EXWORD && !exword()) {
+        if (phase >= HB_SUFFIX && !suffix() && phase >= HB_DIGRAM) {
+            digram();
+        }
+    }
+    return (int)(hyp - hyptr);
+}
+
+void hb_croff_cache(long *hit, long *miss) {
+    *hit = hchit;
+    *miss = hcmiss;
+}
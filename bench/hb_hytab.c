@@ -0,0 +1,34 @@
+/**
+ * @file hb_hytab.c
+ * @brief croff's hytab_api.c as a benchmark engine
+ *
+ * should_hyphenate_at() is asked about every position of the letters
+ * of the word, as a caller with no engine of its own would, against
+ * the default digram threshold.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#include <string.h>
+
+#include "hytab.h"
+#include "hyphbench.h"
+
+void hb_hytab(const char *word, char *out) {
+    size_t b, e, n, k;
+
+    n = strlen(word);
+    for (b = 0; b < n && char_to_index(word[b]) < 0; b++)
+        ;
+    for (e = b; e < n && char_to_index(word[e]) >= 0; e++)
+        ;
+    for (k = 0; k < n; k++) {
+        if (k > b && k < e &&
+            should_hyphenate_at(word + b, e - b, k - b, OTROFF_DIGRAM_THRESH)) {
+            *out++ = '-';
+        }
+        *out++ = word[k];
+    }
+    *out = 0;
+}
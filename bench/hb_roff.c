@@ -0,0 +1,68 @@
+/**
+ * @file hb_roff.c
+ * @brief roff's roff5.c hyphenator as a benchmark engine
+ *
+ * roff5.c is included whole with the roff globals and character tests
+ * it uses defined here.  alph() and alph2() are those of stubs.c, which
+ * troff links, so the breaks found are the ones troff would find.  The
+ * names roff shares with croff are renamed so that both engines link
+ * into one program.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#include "hyphbench.h"
+
+#define hyphen roff_hyphen
+#define hypat roff_hypat
+#define thresh roff_thresh
+#define alph roff_alph
+#define alph2 roff_alph2
+
+#include "roff5.c"
+
+/* roff state hyphen() reads and sets */
+int hypedf;
+int hyf = 1;
+int hypat;
+int nhyph;
+int thresh = 0240;
+int old;
+char *wordp;
+char *hstart;
+char *nhstart;
+char *maxloc;
+int maxdig;
+
+int alph(int c) {
+    return isalpha(c) != 0;
+}
+
+int alph2(int c) {
+    return alph(c);
+}
+
+void hb_roff(const char *word, char *out) {
+    char w[HB_WORD + 1];
+    int k;
+
+    for (k = 0; word[k] && k < HB_WORD; k++) {
+        w[k] = word[k];
+    }
+    if (word[k]) {
+        strcpy(out, word);
+        return;
+    }
+    w[k] = 0;
+    hypedf = 0;
+    wordp = w;
+    hyphen();
+    for (k = 0; w[k]; k++) {
+        if (w[k] & HYPHEN_MARK) {
+            *out++ = '-';
+        }
+        *out++ = word[k];
+    }
+    *out = 0;
+}
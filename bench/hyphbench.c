@@ -0,0 +1,341 @@
+/**
+ * @file hyphbench.c
+ * @brief Hyphenation throughput benchmark and golden-file check
+ *
+ *     hyphbench [-E except] [-c golden | -g golden] corpus...
+ *
+ * Each corpus is split at white space and every word, punctuation and
+ * all, is given to each engine in turn: croff's hyphenateWord() with
+ * and without its cache and with Liang patterns, roff's hyphen() and
+ * hytab_api's should_hyphenate_at().  For each engine the time per
+ * word is reported, with the cache hit rate for croff, and croff's time
+ * is split into its set-up, exword, suffix and digram phases.
+ *
+ * With -c the breaks every engine finds are compared with a golden
+ * file and any difference makes the exit status 1, so that a speed-up
+ * cannot change the output unnoticed; -g writes the golden file
+ * instead.  It holds one line per distinct word: the word and then its
+ * croff, croff -P, roff and hytab forms, separated by tabs.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "hyphbench.h"
+#include "os/os_abstraction.h"
+
+#define HB_OUT (2 * HB_WORD + 1) /* a word with a hyphen before each letter */
+#define HB_MINT 0.2              /* seconds each measurement runs for */
+#define HB_NCOL 4                /* engine columns in the golden file */
+#define HB_NDIFF 10              /* differences shown before going quiet */
+
+/* One engine as benchmarked; variants of an engine share a column */
+struct engine {
+    const char *name;
+    int col;
+    int croff, cache, patterns;
+    void (*fn)(const char *word, char *out);
+};
+
+static const struct engine engines[] = {
+    {"croff", 0, 1, 1, 0, hb_croff},
+    {"croff -H0", 0, 1, 0, 0, hb_croff},
+    {"croff -P", 1, 1, 1, 1, hb_croff},
+    {"roff", 2, 0, 0, 0, hb_roff},
+    {"hytab", 3, 0, 0, 0, hb_hytab},
+};
+
+#define HB_NENG ((int)(sizeof(engines) / sizeof(engines[0])))
+
+/* Words of a corpus, in text order */
+struct corpus {
+    const char *file;
+    char **word;
+    int nword;
+};
+
+/* Golden forms, HB_NCOL per distinct word, sorted by word */
+static char **dict;
+static char **gold;
+static int ndict;
+static int ndiff;
+
+static void fail(const char *msg, const char *arg) {
+    fprintf(stderr, "hyphbench: %s %s\n", msg, arg);
+    exit(1);
+}
+
+static void *xalloc(size_t n) {
+    void *p;
+
+    if ((p = calloc(n ? n : 1, 1)) == NULL)
+        fail("out of memory", "");
+    return p;
+}
+
+static double now(void) {
+    return os_now_ns() / 1e9;
+}
+
+static char *readfile(const char *file, long *len) {
+    FILE *fp;
+    char *buf;
+
+    if ((fp = fopen(file, "rb")) == NULL)
+        fail("cannot read", file);
+    fseek(fp, 0, SEEK_END);
+    *len = ftell(fp);
+    rewind(fp);
+    buf = xalloc((size_t)*len + 1);
+    if (fread(buf, 1, (size_t)*len, fp) != (size_t)*len)
+        fail("cannot read", file);
+    fclose(fp);
+    return buf;
+}
+
+/* Split a corpus at white space; words too long to hyphenate are dropped */
+static void load(struct corpus *c, const char *file) {
+    char *buf, *p, *w;
+    long len;
+
+    buf = readfile(file, &len);
+    c->file = file;
+    c->word = xalloc(((size_t)len / 2 + 1) * sizeof(*c->word));
+    c->nword = 0;
+    for (p = buf; *p;) {
+        while (isspace((unsigned char)*p))
+            p++;
+        if (!*p)
+            break;
+        for (w = p; *p && !isspace((unsigned char)*p); p++)
+            ;
+        if (*p)
+            *p++ = 0;
+        if (strlen(w) <= HB_WORD)
+            c->word[c->nword++] = w;
+    }
+}
+
+static int cmpword(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+static int lookup(const char *w) {
+    char **d;
+
+    d = bsearch(&w, dict, (size_t)ndict, sizeof(*dict), cmpword);
+    return d ? (int)(d - dict) : -1;
+}
+
+/* The distinct words of every corpus, with no golden forms yet */
+static void mkdict(struct corpus *c, int nc) {
+    int i, k, n;
+
+    for (n = i = 0; i < nc; i++)
+        n += c[i].nword;
+    dict = xalloc((size_t)n * sizeof(*dict));
+    for (n = i = 0; i < nc; i++)
+        for (k = 0; k < c[i].nword; k++)
+            dict[n++] = c[i].word[k];
+    qsort(dict, (size_t)n, sizeof(*dict), cmpword);
+    for (ndict = i = 0; i < n; i++)
+        if (!ndict || strcmp(dict[ndict - 1], dict[i]) != 0)
+            dict[ndict++] = dict[i];
+    gold = xalloc((size_t)ndict * HB_NCOL * sizeof(*gold));
+}
+
+static void rdgold(const char *file) {
+    char *buf, *p, *f[HB_NCOL + 1];
+    long len;
+    int k, d;
+
+    buf = readfile(file, &len);
+    for (p = buf; *p;) {
+        for (k = 0; k <= HB_NCOL; k++) {
+            f[k] = p;
+            while (*p && *p != '\t' && *p != '\n')
+                p++;
+            if (k < HB_NCOL && *p != '\t')
+                fail("bad line in", file);
+            if (*p)
+                *p++ = 0;
+        }
+        if ((d = lookup(f[0])) >= 0)
+            for (k = 0; k < HB_NCOL; k++)
+                gold[d * HB_NCOL + k] = f[k + 1];
+    }
+}
+
+static void wrgold(const char *file) {
+    FILE *fp;
+    int d, k;
+
+    if ((fp = fopen(file, "w")) == NULL)
+        fail("cannot write", file);
+    for (d = 0; d < ndict; d++) {
+        fputs(dict[d], fp);
+        for (k = 0; k < HB_NCOL; k++)
+            fprintf(fp, "\t%s", gold[d * HB_NCOL + k] ? gold[d * HB_NCOL + k] : "");
+        fputc('\n', fp);
+    }
+    if (fclose(fp) != 0)
+        fail("cannot write", file);
+}
+
+static void setup(const struct engine *e) {
+    if (e->croff)
+        hb_croff_mode(e->cache, e->patterns);
+}
+
+/*
+ * Run e over the corpus once, untimed, and compare each form with the
+ * golden one; with mk set, record the forms instead.
+ */
+static void check(const struct engine *e, const struct corpus *c, int mk) {
+    char out[HB_OUT];
+    char **g;
+    int i, d;
+
+    setup(e);
+    for (i = 0; i < c->nword; i++) {
+        e->fn(c->word[i], out);
+        d = lookup(c->word[i]);
+        g = &gold[d * HB_NCOL + e->col];
+        if (mk && *g == NULL) {
+            *g = xalloc(strlen(out) + 1);
+            strcpy(*g, out);
+        } else if (*g == NULL || strcmp(*g, out) != 0) {
+            if (ndiff++ < HB_NDIFF)
+                printf("  %s: %s gives %s, golden %s\n", c->file, e->name, out,
+                       *g ? *g : "(none)");
+        }
+    }
+}
+
+/* Nanoseconds per word of e over c; each pass starts with a cold cache */
+static double bench(const struct engine *e, const struct corpus *c) {
+    char out[HB_OUT];
+    double t, t0;
+    long n;
+    int i;
+
+    if (!c->nword)
+        return 0.0;
+    n = 0;
+    t = 0;
+    do {
+        setup(e);
+        t0 = now();
+        for (i = 0; i < c->nword; i++)
+            e->fn(c->word[i], out);
+        t += now() - t0;
+        n += c->nword;
+    } while (t < HB_MINT);
+    return n ? t * 1e9 / n : 0.0;
+}
+
+/* Nanoseconds per word of croff run up to and including phase */
+static double benchupto(const struct corpus *c, int phase) {
+    volatile int sink;
+    double t, t0;
+    long n;
+    int i;
+
+    if (!c->nword)
+        return 0.0;
+    hb_croff_mode(0, 0);
+    n = 0;
+    t = 0;
+    do {
+        t0 = now();
+        for (i = 0; i < c->nword; i++)
+            sink = hb_croff_upto(c->word[i], phase);
+        t += now() - t0;
+        n += c->nword;
+    } while (t < HB_MINT);
+    (void)sink;
+    return n ? t * 1e9 / n : 0.0;
+}
+
+static void report(const struct corpus *c) {
+    static const char *phase[HB_NPHASE] = {"set-up", "exword", "suffix", "digram"};
+    double ns[HB_NPHASE];
+    long hit, miss;
+    int k;
+
+    printf("%s: %d words\n", c->file, c->nword);
+    printf("  %-10s %10s %10s\n", "engine", "ns/word", "cache hit");
+    for (k = 0; k < HB_NENG; k++) {
+        printf("  %-10s %10.1f", engines[k].name, bench(&engines[k], c));
+        if (engines[k].croff && engines[k].cache) {
+            hb_croff_cache(&hit, &miss);
+            printf(" %9.1f%%", hit + miss ? 100.0 * hit / (hit + miss) : 0.0);
+        }
+        printf("\n");
+    }
+    printf("  croff phases, ns/word:");
+    for (k = 0; k < HB_NPHASE; k++) {
+        ns[k] = benchupto(c, k);
+        printf(" %s %.1f", phase[k], k ? ns[k] - ns[k - 1] : ns[k]);
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv) {
+    struct corpus *c;
+    const char *except, *golden;
+    int nc, i, k, mk;
+
+    except = golden = NULL;
+    mk = 0;
+    for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+        if (i + 1 == argc)
+            fail("missing argument to", argv[i]);
+        if (strcmp(argv[i], "-E") == 0)
+            except = argv[++i];
+        else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "-g") == 0) {
+            mk = argv[i][1] == 'g';
+            golden = argv[++i];
+        } else
+            fail("unknown option", argv[i]);
+    }
+    if (i == argc) {
+        fprintf(stderr, "usage: hyphbench [-E except] [-c golden | -g golden] corpus...\n");
+        return 2;
+    }
+
+    nc = argc - i;
+    c = xalloc((size_t)nc * sizeof(*c));
+    for (k = 0; k < nc; k++)
+        load(&c[k], argv[i + k]);
+    hb_croff_init(except);
+    mkdict(c, nc);
+
+    if (golden != NULL && !mk)
+        rdgold(golden);
+    if (golden != NULL) {
+        for (k = 0; k < nc; k++)
+            for (i = 0; i < HB_NENG; i++)
+                check(&engines[i], &c[k], mk);
+    }
+    if (mk) {
+        wrgold(golden);
+        printf("hyphbench: wrote %d words to %s\n", ndict, golden);
+    }
+
+    for (k = 0; k < nc; k++)
+        report(&c[k]);
+
+    if (ndiff) {
+        printf("hyphbench: %d forms differ from %s\n", ndiff, golden);
+        return 1;
+    }
+    if (golden != NULL && !mk)
+        printf("hyphbench: every form matches %s\n", golden);
+    return 0;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file hyphbench.h
+ * @brief Engines driven by the hyphenation benchmark
+ *
+ * Each engine module wraps one hyphenator behind the same calls so
+ * that hyphbench.c can time them over a corpus and compare their
+ * output with the golden file.  A word is passed as it appears in the
+ * text, punctuation included, and comes back with a '-' at every
+ * break the engine found.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#ifndef HYPHBENCH_H
+#define HYPHBENCH_H
+
+#define HB_WORD 64 /* longest word hyphenated; longer ones pass through */
+
+/* croff phases timed separately by hb_croff_upto() */
+enum { HB_SETUP, HB_EXWORD, HB_SUFFIX, HB_DIGRAM, HB_NPHASE };
+
+/* croff: n8.c hyphenateWord() */
+void hb_croff_init(const char *except);
+void hb_croff_mode(int cache, int patterns);
+void hb_croff(const char *word, char *out);
+int hb_croff_upto(const char *word, int phase);
+void hb_croff_cache(long *hit, long *miss);
+
+/* roff: roff5.c hyphen() */
+void hb_roff(const char *word, char *out);
+
+/* hytab_api.c should_hyphenate_at() */
+void hb_hytab(const char *word, char *out);
+
+#endif /* HYPHBENCH_H */
@@ -0,0 +1,381 @@
+/**
+ * @file microbench.c
+ * @brief Per-module microbenchmarks of croff
+ *
+ *     microbench [-r rounds] [name...]
+ *
+ * Links against croff's own objects, n1.c built with its main() renamed,
+ * and starts the formatter as main() would before timing one entry
+ * point of each module in a loop:
+ *
+ *   getch       n1.c  getch() over text held in memory
+ *   oput        n2.c  oput() into the output ring, flusho() after each line
+ *   macro       n3.c  a macro body written with wbf() and read with rbf0()
+ *   register    n4.c  findr() and nrp() over a set of register names
+ *   number      n4.c  nrchars(), \n of a page and section counters
+ *   width       n6.c  width() of the printable characters in turn
+ *   text        n7.c  text() over filled lines, as the main loop calls it
+ *   hyphenate   n8.c  hyphenateWord() over a word list, with its cache
+ *
+ * Each is run for rounds rounds (default 7) of a fixed number of
+ * operations; the best and the median round are printed in ns per
+ * operation, so that one slow round does not move the figure.  With
+ * names only those are run.  What the formatter writes goes to
+ * /dev/null.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "tdef.h"
+#include "t.h"
+#include "troff_processor.h"
+#include "os/os_abstraction.h" // os_now_ns
+
+#define MB_ROUNDS 7 /* rounds of each benchmark */
+#define MB_MAXROUNDS 64
+
+/* Formatter entry points and state used here */
+extern void init1(char a);
+extern void init2(void);
+extern int getch(void);
+extern void oput(int i);
+extern void flusho(void);
+extern int alloc(void);
+extern void blk_free(int i);
+extern void wbf(int i);
+extern void wbfl(void);
+extern int rbf0(int p);
+extern int incoff(int p);
+extern int findr(int i);
+extern int *nrp(int j);
+extern int *nrchars(int i);
+extern int *fmt;
+extern int width(int c);
+extern void text(void);
+extern void hyphenateWord(int *wp);
+extern void hcclear(void);
+extern int *cp, *ap, ip, nx, ch, ch0, nchar, nlflg, offset;
+extern int *hyptr[NHYP];
+
+/* One benchmark: set up, then ops operations per call of run() */
+struct mb {
+    const char *name;
+    const char *what;
+    long ops;
+    void (*setup)(void);
+    void (*run)(void);
+};
+
+static volatile long sink; /* keeps results from being optimised away */
+
+/* Text of filled prose, a line at a time, with no escapes or requests */
+static const char *prose[] = {
+    "Input consists of text lines, which are destined to be printed,\n",
+    "interspersed with control lines, which set parameters or otherwise\n",
+    "control subsequent processing.  Each line is filled and adjusted\n",
+    "unless the document asks otherwise, and broken into pages with\n",
+    "the headers, footers and traps the macros define for it.\n",
+};
+#define NPROSE (sizeof(prose) / sizeof(prose[0]))
+
+static char *textbuf; /* prose repeated */
+static size_t textlen;
+static long textlines;
+
+static void maketext(long lines) {
+    size_t k;
+    long n;
+
+    free(textbuf);
+    for (textlen = 0, n = 0; n < lines; n++)
+        textlen += strlen(prose[n % NPROSE]);
+    if ((textbuf = malloc(textlen + 1)) == NULL) {
+        fprintf(stderr, "microbench: out of memory\n");
+        exit(1);
+    }
+    for (k = 0, n = 0; n < lines; n++) {
+        strcpy(textbuf + k, prose[n % NPROSE]);
+        k += strlen(prose[n % NPROSE]);
+    }
+    textlines = lines;
+}
+
+/* Point the input at the text, as a mapped file would be */
+static void feed(void) {
+    cp = ap = NULL;
+    ip = nx = ch0 = nchar = 0;
+    g_processor.inputPtr = textbuf;
+    g_processor.endInput = textbuf + textlen;
+}
+
+/* n1.c */
+#define GETCH_OPS 200000L
+
+static void getch_setup(void) {
+    maketext(GETCH_OPS / 50);
+}
+
+static void getch_run(void) {
+    size_t k;
+    long s = 0;
+
+    feed();
+    for (k = 0; k < textlen; k++)
+        s += getch();
+    sink = s;
+}
+
+/* n2.c */
+#define OPUT_OPS 200000L
+
+static void oput_run(void) {
+    long k;
+
+    for (k = 0; k < OPUT_OPS; k++) {
+        oput('a' + (int)(k % 26));
+        if (k % 64 == 63) {
+            oput('\n');
+            k++;
+        }
+    }
+    flusho();
+}
+
+/* n3.c */
+#define MACRO_OPS 100000L
+
+static void macro_run(void) {
+    int first, p;
+    long k, s = 0;
+
+    if ((first = offset = alloc()) == 0) {
+        fprintf(stderr, "microbench: no macro space\n");
+        exit(1);
+    }
+    for (k = 0; k < MACRO_OPS / 2; k++)
+        wbf('a' + (int)(k % 26));
+    wbf(0);
+    wbfl();
+    for (p = first, k = 0; k < MACRO_OPS / 2; k++, p = incoff(p))
+        s += rbf0(p);
+    blk_free(first);
+    offset = 0;
+    sink = s;
+}
+
+/* n4.c */
+#define REGISTER_OPS 200000L
+#define NREGNAMES 64
+
+static int regnames[NREGNAMES];
+
+static void register_setup(void) {
+    int k;
+
+    for (k = 0; k < NREGNAMES; k++)
+        regnames[k] = ('a' + k % 26) | (('A' + k / 26) << BYTE); /* as getrq() packs them */
+}
+
+static void register_run(void) {
+    long k, s = 0;
+    int j;
+
+    for (k = 0; k < REGISTER_OPS; k++)
+        if ((j = findr(regnames[k % NREGNAMES])) >= 0)
+            s += ++*nrp(j);
+    sink = s;
+}
+
+#define NUMBER_OPS 200000L
+#define NUMBER_RUN 50 /* interpolations between changes, as in a page's headers */
+
+static int numregs[3];
+
+static void number_setup(void) {
+    numregs[0] = 'P' | ('N' << BYTE);
+    numregs[1] = 'H' | ('1' << BYTE);
+    numregs[2] = 'H' | ('2' << BYTE);
+    *nrp(findr(numregs[0])) = 1;
+    *nrp(findr(numregs[1])) = 1997;
+    fmt[findr(numregs[1])] = 'I';
+    fmt[findr(numregs[2])] = 3; /* .af H2 001 */
+}
+
+static void number_run(void) {
+    long k, s = 0;
+
+    for (k = 0; k < NUMBER_OPS; k++) {
+        if (k % NUMBER_RUN == 0)
+            ++*nrp(findr(numregs[(k / NUMBER_RUN) % 3]));
+        s += *nrchars(numregs[k % 3]);
+    }
+    sink = s;
+}
+
+/* n6.c */
+#define WIDTH_OPS 200000L
+
+static void width_run(void) {
+    long k, s = 0;
+
+    for (k = 0; k < WIDTH_OPS; k++)
+        s += width(040 + (int)(k % 95));
+    sink = s;
+}
+
+/* n7.c */
+#define TEXT_LINES 500L
+#define TEXT_SLACK 4 /* lines left unread, so the input never runs out */
+
+static char *textstop; /* where the last line timed ends */
+
+static void text_setup(void) {
+    long n;
+
+    maketext(TEXT_LINES + TEXT_SLACK);
+    for (textstop = textbuf, n = 0; n < TEXT_LINES; n++)
+        textstop = strchr(textstop, '\n') + 1;
+}
+
+/*
+ * The text branch of the main loop, which starts each line with the
+ * newline flag clear as the loop in troff's n1.c did
+ */
+static void text_run(void) {
+    int i;
+
+    feed();
+    while (g_processor.inputPtr < textstop) {
+        nlflg = 0;
+        if (!((i = getch()) & MOT)) {
+            ch = i;
+            text();
+        }
+    }
+    flusho();
+}
+
+/* n8.c */
+#define HYPH_OPS 20000L
+
+static const char *hyphwords[] = {
+    "formatting",   "paragraph",     "hyphenation",  "processing",   "interspersed",
+    "subsequent",   "typewriter",     "terminal",     "adjustment",   "environment",
+    "diversion",    "character",      "registers",    "arithmetic",   "preprocessor",
+    "mathematics",  "equations",      "resolution",   "information",  "distribution",
+    "independent",  "programmer",     "workbench",    "laboratories", "documentation",
+    "benchmark",    "measurement",    "performance",  "microseconds", "representation",
+    "considerable", "communication",
+};
+#define NHYPHWORDS (sizeof(hyphwords) / sizeof(hyphwords[0]))
+
+static int hyphbuf[NHYPHWORDS][32];
+
+static void hyph_setup(void) {
+    size_t k, i;
+
+    for (k = 0; k < NHYPHWORDS; k++) {
+        for (i = 0; hyphwords[k][i]; i++)
+            hyphbuf[k][i] = (unsigned char)hyphwords[k][i];
+        hyphbuf[k][i] = 0;
+    }
+    hcclear();
+}
+
+static void hyph_run(void) {
+    long k, s = 0;
+
+    for (k = 0; k < HYPH_OPS; k++) {
+        hyptr[0] = 0;
+        hyphenateWord(hyphbuf[k % NHYPHWORDS]);
+        s += hyptr[0] != 0;
+    }
+    sink = s;
+}
+
+static struct mb benches[] = {
+    {"getch", "n1.c getch()", 0, getch_setup, getch_run}, /* ops: the bytes of the text */
+    {"oput", "n2.c oput(), flusho()", OPUT_OPS, NULL, oput_run},
+    {"macro", "n3.c wbf(), rbf0()", MACRO_OPS, NULL, macro_run},
+    {"register", "n4.c findr(), nrp()", REGISTER_OPS, register_setup, register_run},
+    {"number", "n4.c nrchars()", NUMBER_OPS, number_setup, number_run},
+    {"width", "n6.c width()", WIDTH_OPS, NULL, width_run},
+    {"text", "n7.c text() per line", TEXT_LINES, text_setup, text_run},
+    {"hyphenate", "n8.c hyphenateWord()", HYPH_OPS, hyph_setup, hyph_run},
+};
+#define NBENCH (sizeof(benches) / sizeof(benches[0]))
+
+static int cmpd(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+
+    return x < y ? -1 : x > y;
+}
+
+static int wanted(const char *name, int argc, char **argv) {
+    int i;
+
+    if (argc <= 1)
+        return 1;
+    for (i = 1; i < argc; i++)
+        if (strcmp(argv[i], name) == 0)
+            return 1;
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    double ns[MB_MAXROUNDS];
+    uint64_t t0;
+    FILE *out;
+    size_t b;
+    int k, rounds = MB_ROUNDS, fd;
+
+    if (argc > 2 && strcmp(argv[1], "-r") == 0) {
+        rounds = atoi(argv[2]);
+        argc -= 2, argv += 2;
+    }
+    if (rounds < 1 || rounds > MB_MAXROUNDS) {
+        fprintf(stderr, "usage: microbench [-r rounds] [name...]\n");
+        return 2;
+    }
+
+    /* The report keeps standard output; the formatter gets /dev/null */
+    if ((fd = dup(1)) < 0 || (out = fdopen(fd, "w")) == NULL ||
+        (fd = open("/dev/null", O_WRONLY)) < 0 || dup2(fd, 1) < 0) {
+        fprintf(stderr, "microbench: cannot redirect the output\n");
+        return 1;
+    }
+    close(fd);
+    init1('n');
+    init2();
+
+    fprintf(out, "%-10s %-24s %10s %10s %10s\n", "module", "entry", "ops", "best ns", "median ns");
+    for (b = 0; b < NBENCH; b++) {
+        struct mb *m = &benches[b];
+
+        if (!wanted(m->name, argc, argv))
+            continue;
+        if (m->setup != NULL)
+            m->setup();
+        if (m->ops == 0)
+            m->ops = (long)textlen; /* getch: a call per byte of the text */
+        m->run(); /* once to touch what it uses */
+        for (k = 0; k < rounds; k++) {
+            t0 = os_now_ns();
+            m->run();
+            ns[k] = (double)(os_now_ns() - t0) / m->ops;
+        }
+        qsort(ns, (size_t)rounds, sizeof(ns[0]), cmpd);
+        fprintf(out, "%-10s %-24s %10ld %10.1f %10.1f\n", m->name, m->what, m->ops, ns[0],
+                ns[rounds / 2]);
+        fflush(out);
+    }
+    fclose(out);
+    return 0;
+}
@@ -0,0 +1,301 @@
+/**
+ * @file tblbench.c
+ * @brief tbl throughput benchmark and golden-output check
+ *
+ *     tblbench [-n runs] [-r troff] [-c dir | -g dir] tbl corpus...
+ *
+ * Each corpus is given to the tbl named as its standard input, and the
+ * best wall time of the runs is reported as table rows per second, with
+ * the output size, the output bytes per row and the peak resident size
+ * the kernel reports for the child.  With -r the troff given is run,
+ * the same number of times, on what tbl wrote, and its best time is
+ * reported as well: the cost of the code tbl emits, end to end.
+ *
+ * A row is a line of data, a rule line included; the lines of a T{
+ * text block and the troff requests between rows are not counted.
+ *
+ * With -c the output of each corpus is compared with <dir>/<corpus
+ * name>.golden and any difference makes the exit status 1; a corpus
+ * with no golden file is reported and skipped.  -g writes the golden
+ * files instead.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#define TB_RUNS 5 /* runs of each corpus, the best is kept */
+
+/* One run of a program: what it wrote and what it took */
+struct run {
+    int out; /* its output, unlinked */
+    size_t nout;
+    double secs;
+    long maxrss; /* kilobytes */
+};
+
+/* What is in a corpus */
+struct count {
+    long tables, rows;
+};
+
+static void fail(const char *msg, const char *arg) {
+    fprintf(stderr, "tblbench: %s %s\n", msg, arg);
+    exit(1);
+}
+
+static double now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* The whole of a file, NUL-terminated; *n is its length */
+static char *slurp(const char *file, size_t *n) {
+    FILE *f;
+    char *p;
+    long len;
+
+    if ((f = fopen(file, "rb")) == NULL)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    rewind(f);
+    if ((p = malloc((size_t)len + 1)) == NULL)
+        fail("out of memory", "");
+    *n = fread(p, 1, (size_t)len, f);
+    p[*n] = 0;
+    fclose(f);
+    return p;
+}
+
+/* Read everything in fd from the start */
+static char *readback(int fd, size_t *n) {
+    char *p = NULL;
+    size_t cap = 0;
+    ssize_t r;
+
+    *n = 0;
+    lseek(fd, 0, SEEK_SET);
+    for (;;) {
+        if (*n + 8192 + 1 > cap && (p = realloc(p, cap = 2 * cap + 8192 + 1)) == NULL)
+            fail("out of memory", "");
+        if ((r = read(fd, p + *n, 8192)) <= 0)
+            break;
+        *n += (size_t)r;
+    }
+    p[*n] = 0;
+    return p;
+}
+
+/*
+ * Tables and rows in a corpus.  After .TS come the options, if the
+ * first line ends in ';', then the format, through the line ending in
+ * '.'; .T& starts a format again.
+ */
+static struct count rows(const char *s) {
+    struct count c = {0, 0};
+    const char *p, *nl, *e;
+    int in = 0, spec = 0, block = 0, first = 0;
+
+    for (p = s; *p; p = nl + 1) {
+        if ((nl = strchr(p, '\n')) == NULL)
+            nl = p + strlen(p);
+        for (e = nl; e > p && (e[-1] == ' ' || e[-1] == '\t'); e--)
+            ;
+        if (!in) {
+            if (strncmp(p, ".TS", 3) == 0) {
+                c.tables++;
+                in = spec = first = 1;
+                block = 0;
+            }
+        } else if (block) {
+            if (strncmp(p, "T}", 2) == 0)
+                block = e - p >= 2 && strncmp(e - 2, "T{", 2) == 0;
+        } else if (strncmp(p, ".TE", 3) == 0)
+            in = 0;
+        else if (strncmp(p, ".T&", 3) == 0)
+            spec = 1;
+        else if (spec) {
+            if (!(first && e > p && e[-1] == ';') && e > p && e[-1] == '.')
+                spec = 0;
+            first = 0;
+        } else if (p[0] != '.' && p[0] != '\'') {
+            c.rows++;
+            block = e - p >= 2 && strncmp(e - 2, "T{", 2) == 0;
+        }
+        if (*nl == 0)
+            break;
+    }
+    return c;
+}
+
+/* Run prog with the file in as its standard input, once */
+static void run1(const char *prog, int in, struct run *r) {
+    char tmpl[] = "/tmp/tblbenchXXXXXX";
+    struct rusage ru;
+    double t0;
+    pid_t pid;
+    int status;
+
+    if ((r->out = mkstemp(tmpl)) < 0)
+        fail("cannot create", tmpl);
+    unlink(tmpl);
+    lseek(in, 0, SEEK_SET);
+    t0 = now();
+    if ((pid = fork()) < 0)
+        fail("cannot fork for", prog);
+    if (pid == 0) {
+        dup2(in, 0);
+        dup2(r->out, 1);
+        execl(prog, prog, (char *)NULL);
+        _exit(127);
+    }
+    while (wait4(pid, &status, 0, &ru) < 0)
+        if (errno != EINTR)
+            fail("lost", prog);
+    r->secs = now() - t0;
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 127)
+        fail("cannot run", prog);
+    r->maxrss = ru.ru_maxrss;
+    r->nout = (size_t)lseek(r->out, 0, SEEK_END);
+}
+
+/* The best of n runs of prog on in */
+static struct run best(const char *prog, int in, int n) {
+    struct run b, r;
+    int k;
+
+    for (k = 0; k < n; k++) {
+        run1(prog, in, &r);
+        if (k == 0 || r.secs < b.secs) {
+            if (k > 0)
+                close(b.out);
+            b = r;
+        } else
+            close(r.out);
+    }
+    return b;
+}
+
+/* <dir>/<last part of corpus without .txt>.golden */
+static char *goldname(const char *dir, const char *corpus) {
+    const char *b, *e;
+    char *g;
+
+    b = (b = strrchr(corpus, '/')) != NULL ? b + 1 : corpus;
+    e = strrchr(b, '.');
+    if (e == NULL || strcmp(e, ".txt") != 0)
+        e = b + strlen(b);
+    if ((g = malloc(strlen(dir) + (size_t)(e - b) + 9)) == NULL)
+        fail("out of memory", "");
+    sprintf(g, "%s/%.*s.golden", dir, (int)(e - b), b);
+    return g;
+}
+
+/* Compare out with the golden file; 1 if they differ */
+static int check(const char *gold, const char *out, size_t nout) {
+    const char *p, *q;
+    char *g;
+    size_t ng;
+    long line;
+
+    if ((g = slurp(gold, &ng)) == NULL) {
+        printf("  no %s, not checked\n", gold);
+        return 0;
+    }
+    if (ng == nout && memcmp(g, out, nout) == 0) {
+        free(g);
+        return 0;
+    }
+    for (p = g, q = out, line = 1; p < g + ng && q < out + nout && *p == *q; p++, q++)
+        line += (*p == '\n');
+    printf("  output differs from %s at line %ld\n", gold, line);
+    free(g);
+    return 1;
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: tblbench [-n runs] [-r troff] [-c dir | -g dir] tbl corpus...\n");
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    const char *tbl, *troff = NULL, *cdir = NULL, *gdir = NULL;
+    struct run b, rb;
+    struct count c;
+    char *src, *out, *g;
+    size_t nsrc;
+    int i, in, nruns = TB_RUNS, bad = 0;
+    FILE *f;
+
+    for (; argc > 1 && argv[1][0] == '-'; argc--, argv++) {
+        if (argc < 3)
+            usage();
+        switch (argv[1][1]) {
+        case 'n':
+            nruns = atoi(argv[2]);
+            break;
+        case 'r':
+            troff = argv[2];
+            break;
+        case 'c':
+            cdir = argv[2];
+            break;
+        case 'g':
+            gdir = argv[2];
+            break;
+        default:
+            usage();
+        }
+        argc--, argv++;
+    }
+    if (argc < 3 || nruns < 1)
+        usage();
+    tbl = argv[1];
+
+    printf("%-24s %6s %7s %11s %10s %8s %9s %9s\n", "corpus", "tables", "rows", "rows/s",
+           "out bytes", "bytes/row", "peak KB", "troff ms");
+    for (i = 2; i < argc; i++) {
+        if ((src = slurp(argv[i], &nsrc)) == NULL || (in = open(argv[i], O_RDONLY)) < 0)
+            fail("cannot read", argv[i]);
+        c = rows(src);
+        b = best(tbl, in, nruns);
+        printf("%-24s %6ld %7ld %11.0f %10zu %8.1f %9ld ", argv[i], c.tables, c.rows,
+               c.rows / b.secs, b.nout, c.rows > 0 ? (double)b.nout / c.rows : 0.0, b.maxrss);
+        if (troff != NULL) {
+            rb = best(troff, b.out, nruns);
+            printf("%9.1f\n", rb.secs * 1e3);
+            close(rb.out);
+        } else
+            printf("%9s\n", "-");
+
+        out = readback(b.out, &b.nout);
+        if (gdir != NULL) {
+            g = goldname(gdir, argv[i]);
+            if ((f = fopen(g, "wb")) == NULL || fwrite(out, 1, b.nout, f) != b.nout ||
+                fclose(f) != 0)
+                fail("cannot write", g);
+            free(g);
+        } else if (cdir != NULL) {
+            g = goldname(cdir, argv[i]);
+            bad |= check(g, out, b.nout);
+            free(g);
+        }
+        free(out);
+        close(b.out);
+        close(in);
+        free(src);
+    }
+    return bad;
+}
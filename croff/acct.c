@@ -0,0 +1,99 @@
+/* C17 - no scaffold needed */
+/*
+ * acct.c - Paper accounting records, batched
+ *
+ * report() at done() hands its record to acctput(), which keeps it in
+ * acctbuf[] with those before it; acctflush() appends them all with one
+ * write(2), so a process writes at most once per ACCTN records and
+ * never seeks.  The descriptor is opened with O_APPEND and the batch is
+ * whole records, so processes appending to one file at once do not
+ * tear each other's records or need a lock.
+ *
+ * acctg() opens the shared file while setuid, as before.  With
+ * -A<dir> the records go instead to a spool of this process's own,
+ * <dir>/troffactg.<pid>, opened once after the options (acctspool());
+ * the children of -B and -D inherit it, so a busy server appends to a
+ * file no other server writes.  A spool begins with a date line, as
+ * the shared file does, and tacct -m -f<dir> merges every spool in the
+ * directory into one report.
+ *
+ * Records are three ints, paper used and uid and a spare, the layout
+ * tacct reads.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define OSA_TAG "croff.acct"
+#include "os/os_acct.h" /* OSA_WRITE */
+
+#define ACCTN 64 /* records kept before a write */
+
+int acctf = -1; /* Accounting file descriptor */
+char *acctdir; /* -A<dir> */
+
+/* One record, as tacct reads it */
+struct acctrec {
+    int use; /* paper used */
+    int uid;
+    int spare;
+};
+
+static struct acctrec acctbuf[ACCTN];
+static int nacct;
+
+/* Open the shared accounting file name for appending */
+int acctopen(const char *name) {
+    return (acctf = open(name, O_WRONLY | O_APPEND));
+}
+
+/*
+ * Switch to a spool of this process's own in acctdir, made with a date
+ * line; the shared file, if open, is closed.
+ *
+ * Returns: the descriptor, or -1 with the shared file kept
+ */
+int acctspool(void) {
+    char name[4096], date[64];
+    time_t t;
+    int fd, n;
+
+    if (acctdir == NULL)
+        return (-1);
+    if (snprintf(name, sizeof(name), "%s/troffactg.%ld", acctdir, (long)getpid()) >=
+            (int)sizeof(name) ||
+        (fd = open(name, O_WRONLY | O_APPEND | O_CREAT | O_EXCL, 0644)) < 0)
+        return (-1);
+    t = time(NULL);
+    n = (int)strftime(date, sizeof(date), "%a %b %e %H:%M:%S %Y\n", localtime(&t));
+    if (OSA_WRITE(fd, date, (size_t)n) != n) {
+        close(fd);
+        unlink(name);
+        return (-1);
+    }
+    if (acctf >= 0)
+        close(acctf);
+    return (acctf = fd);
+}
+
+/* Append what is kept, as one write of whole records */
+void acctflush(void) {
+    ssize_t n;
+
+    if (nacct && acctf >= 0) {
+        n = OSA_WRITE(acctf, acctbuf, nacct * sizeof(*acctbuf));
+        (void)n; /* a full disk loses the batch, as it would the record */
+    }
+    nacct = 0;
+}
+
+/* Keep a record of use units of paper for uid */
+void acctput(int use, int uid) {
+    if (nacct == ACCTN)
+        acctflush();
+    acctbuf[nacct].use = use;
+    acctbuf[nacct].uid = uid;
+    acctbuf[nacct++].spare = 0;
+}
@@ -0,0 +1,208 @@
+/* C17 - no scaffold needed */
+/*
+ * batch.c - Format many documents from one start-up with -B
+ *
+ * With -B<suffix> every file left on the command line is a separate
+ * document.  Start-up, the -m package (or its -K snapshot) and the
+ * terminal table are done once.  Then, when nextfile() is about to
+ * open the first document, the formatter forks once per document.
+ * Each child resumes from the loaded state as an untouched copy of
+ * it, formats its one file into <file><suffix> (standard output for
+ * "-") and exits through done() as a single run would.  -j<n> runs up
+ * to n children at once, by default one per processor.  The parent
+ * exits with the status of the worst.  As it forks each child, the
+ * parent starts reading the next document in (prefetch.c).
+ *
+ * Everything a child changes stays in the child, so no document sees
+ * the macros, registers, traps or environments another one left.  The
+ * spilled macro blocks in ibf are the one thing the processes would
+ * share, so each child gets a private copy of that file first.
+ */
+
+#include "tdef.h" // troff definitions
+#include "troff_processor.h" // processor state
+#include "diag.h" // -Q diagnostics
+#define OSA_TAG "croff.batch"
+#include "os/os_acct.h" // OSA_MALLOC, OSA_FREE, OSA_WRITE, ...
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#define BSUFFIX ".out" /* -B without a suffix */
+
+extern int ibf;
+extern int ptid;
+extern int rargc;
+extern char **argp;
+
+void prstr(const char *s);
+void flusho(void);
+void obwait(void);
+void obfork(void);
+void pfstart(const char *name);
+void pfdrop(void);
+
+char *bsuffix; /* -B: the suffix of each output file, NULL without -B */
+int bjobs; /* -j: children at once, 0 for one per processor */
+
+void bfork(void);
+int bcopytmp(void);
+
+/* Give this process its own copy of the temp file behind ibf; also for -D */
+int bcopytmp(void) {
+    char tmp[] = "/tmp/taXXXXXX";
+    char buf[8192];
+    struct stat st;
+    off_t off;
+    ssize_t n;
+    int fd;
+
+    if (ibf < 0)
+        return (0); /* no temp file yet; the child makes its own */
+    if (fstat(ibf, &st) < 0)
+        return (-1);
+    if (st.st_size == 0)
+        return (0); /* nothing has spilled yet */
+    if ((fd = mkstemp(tmp)) < 0)
+        return (-1);
+    unlink(tmp);
+    for (off = 0; (n = OSA_PREAD(ibf, buf, sizeof(buf), off)) > 0; off += n)
+        if (OSA_WRITE(fd, buf, (size_t)n) != n) {
+            close(fd);
+            return (-1);
+        }
+    if (n < 0 || dup2(fd, ibf) < 0) {
+        close(fd);
+        return (-1);
+    }
+    close(fd);
+    return (0);
+}
+
+/* Point the device output of a child at the result file for doc */
+static int bout(const char *doc) {
+    char *name;
+    size_t n;
+    int fd;
+
+    if (strcmp(doc, "-") == 0)
+        return (0);
+    n = strlen(doc) + strlen(bsuffix) + 1;
+    if ((name = OSA_MALLOC(n)) == NULL)
+        return (-1);
+    strcpy(name, doc);
+    strcat(name, bsuffix);
+    fd = open(name, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd < 0) {
+        prstr("Cannot create ");
+        prstr(name);
+        prstr("\n");
+        OSA_FREE(name);
+        return (-1);
+    }
+    OSA_FREE(name);
+    if (ptid > 2)
+        close(ptid);
+    if (dup2(fd, 1) < 0)
+        return (-1);
+    close(fd);
+    ptid = 1;
+    return (0);
+}
+
+/* Wait for one of the running children and fold in its status */
+static int bwait(pid_t *run, int nrun, int *worst) {
+    pid_t w;
+    int k, status;
+
+    for (;;) {
+        if ((w = waitpid(-1, &status, 0)) < 0) {
+            if (errno == EINTR)
+                continue;
+            *worst |= 01;
+            return (nrun - 1); /* ECHILD: nothing left to wait for */
+        }
+        for (k = 0; k < nrun; k++)
+            if (run[k] == w)
+                break;
+        if (k < nrun)
+            break;
+        /* not one of ours, e.g. from .pi */
+    }
+    if (!WIFEXITED(status))
+        *worst |= 01;
+    else
+        *worst |= WEXITSTATUS(status);
+    run[k] = run[nrun - 1];
+    return (nrun - 1);
+}
+
+/*
+ * bfork - Run each remaining document in a child of its own
+ *
+ * Up to bjobs children run at once.  Whenever one finishes, the next
+ * document in command-line order goes to a new child, so a few long
+ * documents do not hold back the short ones behind them.  Each result
+ * goes to its own file, so the output does not depend on which child
+ * finished first.
+ *
+ * Returns in each child, with the file list cut down to its document;
+ * the parent never returns.
+ */
+void bfork(void) {
+    pid_t pid, *run;
+    int k, n, nrun, worst;
+
+    if (*bsuffix == 0)
+        bsuffix = BSUFFIX;
+    if (bjobs < 1 && (bjobs = (int)sysconf(_SC_NPROCESSORS_ONLN)) < 1)
+        bjobs = 1;
+    n = rargc;
+    if (bjobs > n)
+        bjobs = n;
+    if ((run = OSA_MALLOC(bjobs * sizeof(*run))) == NULL) {
+        prstr("Cannot fork.\n");
+        exit(02);
+    }
+    /* Whatever the package wrote goes out once, from here */
+    if (g_processor.outputPtr != g_processor.outputBuffer)
+        flusho();
+    else
+        obwait();
+    dgflush(); /* or each child would write what is held again */
+
+    worst = nrun = 0;
+    for (k = 0; k < n; k++) {
+        if (nrun == bjobs)
+            nrun = bwait(run, nrun, &worst);
+        if ((pid = fork()) < 0) {
+            prstr("Cannot fork.\n");
+            worst |= 02;
+            break;
+        }
+        if (pid == 0) {
+            obfork();
+            pfdrop();
+            if (bcopytmp() < 0 || bout(argp[k]) < 0)
+                _exit(02);
+            argp += k;
+            rargc = 1;
+            bsuffix = NULL;
+            OSA_FREE(run);
+            return;
+        }
+        run[nrun++] = pid;
+        if (k + 1 < n)
+            pfstart(argp[k + 1]); /* in while this one is formatted */
+    }
+    while (nrun > 0)
+        nrun = bwait(run, nrun, &worst);
+    if (ibf >= 0)
+        close(ibf);
+    exit(worst);
+}
@@ -0,0 +1,131 @@
+/* C17 - no scaffold needed */
+/*
+ * caps.c - Hard caps on what one document may take, for -C
+ *
+ * For documents that cannot be trusted, -C caps the resources a run
+ * may take:
+ *
+ *   -Cm<KB>,d<KB>,s<n>,o<KB>,t<sec>
+ *
+ * m  macro storage: every block of macros, strings and diversions in
+ *    use, whether in core or spilled to the temp file, so it bounds
+ *    both the store and the temp file behind it
+ * d  one diversion: the words written to it since .di or .da opened it
+ * s  the depth of macro, string and trap calls: the frames pushi()
+ *    makes and whose argument space grows with them
+ * o  output, in bytes written to the device
+ * t  processor seconds, through RLIMIT_CPU
+ *
+ * Any may be left out, and 0 is no cap.  Given twice, a cap keeps the
+ * lower value, so a -D job's own -C cannot lift the server's.
+ *
+ * The caps are armed by capstart() when the first document is opened,
+ * in the process that formats it: the package and tables loaded before
+ * then are counted against them but cannot pass them, and the parents
+ * of -B and -D, which run for ever, are not capped themselves.
+ *
+ * A cap passed is not a formatting error to be carried past: capfail()
+ * names it on the diagnostic output and ends the run as a full temp
+ * file does, writing what is formatted without ejecting the page, so
+ * no trap runs again.  The caps are disarmed first, so the ending does
+ * not trip them.  The status is 0100.
+ */
+
+#include "tdef.h" // troff definitions
+#include "caps.h"
+#define OSA_TAG "croff.caps"
+#include "os/os_acct.h" // OSA_WRITE
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+extern void prstr(const char *s);
+extern void done2(int x);
+extern void done3(int x);
+
+int capblk; /* macro storage, in blocks */
+long capdiv; /* one diversion, in words */
+int capdepth; /* frames */
+long long capout; /* output bytes */
+long capdw[NDI]; /* words in the diversion at each level */
+char *capopt; /* the -C option itself */
+
+static long capv[5]; /* -C, in its own units, until armed */
+static int caparmed;
+
+static const char *capname[] = {"macro storage", "diversion size", "call depth", "output",
+                                "processor time"};
+static const char *capunit[] = {"KB", "KB", "frames", "KB", "seconds"};
+
+/* -C: key letters each with a number; a cap given again keeps the lower */
+void capset(char *s) {
+    static const char keys[] = "mdsot";
+    const char *k;
+    char *e;
+    long n;
+
+    capopt = s - 2; /* s is &argv[i][2] */
+    while (*s) {
+        if ((k = strchr(keys, *s)) == NULL) {
+            s++;
+            continue;
+        }
+        n = strtol(s + 1, &e, 10);
+        s = *e == ',' ? e + 1 : e;
+        if (n > 0 && (capv[k - keys] == 0 || n < capv[k - keys]))
+            capv[k - keys] = n;
+    }
+}
+
+static void capxcpu(int signo) {
+    static const char m[] = "Cap on processor time reached.\n";
+    ssize_t r;
+
+    (void)signo;
+    r = OSA_WRITE(2, m, sizeof(m) - 1);
+    (void)r;
+    done3(0100);
+}
+
+/* Arm the caps, once, in the process that formats the documents */
+void capstart(void) {
+    struct rlimit rl;
+    struct rusage ru;
+    rlim_t t;
+
+    if (caparmed++)
+        return;
+    capblk = (int)(capv[CAP_MACRO] * 1024 / (BLK * sizeof(int)));
+    if (capv[CAP_MACRO] && capblk == 0)
+        capblk = 1;
+    capdiv = capv[CAP_DIV] * 1024 / (long)sizeof(int);
+    capdepth = (int)capv[CAP_DEPTH];
+    capout = (long long)capv[CAP_OUT] << 10;
+    if (capv[CAP_CPU] && getrlimit(RLIMIT_CPU, &rl) == 0 && getrusage(RUSAGE_SELF, &ru) == 0) {
+        t = (rlim_t)(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + capv[CAP_CPU]);
+        if (rl.rlim_cur == RLIM_INFINITY || t < rl.rlim_cur) {
+            rl.rlim_cur = t;
+            if (rl.rlim_max != RLIM_INFINITY && rl.rlim_max < t)
+                rl.rlim_cur = rl.rlim_max;
+            signal(SIGXCPU, capxcpu);
+            setrlimit(RLIMIT_CPU, &rl);
+        }
+    }
+}
+
+/* Cap what has been passed: say so, and end the run */
+void capfail(int what) {
+    char m[128];
+
+    capblk = capdepth = 0;
+    capdiv = 0;
+    capout = 0;
+    snprintf(m, sizeof(m), "Cap on %s of %ld %s reached.\n", capname[what], capv[what],
+             capunit[what]);
+    prstr(m);
+    done2(0100);
+}
@@ -0,0 +1,38 @@
+/* C17 - no scaffold needed */
+/*
+ * caps.h - Hard caps on what one document may take, for -C
+ *
+ * Each cap is 0 (no cap) until capstart() arms those -C gave, as the
+ * first document is opened.  The hooks below are one test each; a cap
+ * passed ends the run in capfail() with a diagnostic naming it.
+ */
+
+#ifndef CAPS_H
+#define CAPS_H
+
+/* What has been passed */
+#define CAP_MACRO 0 /* blocks of macro storage, in core and spilled */
+#define CAP_DIV 1 /* words in one diversion */
+#define CAP_DEPTH 2 /* macro, string and trap frames nested */
+#define CAP_OUT 3 /* bytes of output */
+#define CAP_CPU 4 /* processor seconds */
+
+extern int capblk; /* macro storage, in blocks */
+extern long capdiv; /* one diversion, in words */
+extern int capdepth; /* frames */
+extern long long capout; /* output bytes */
+extern long capdw[]; /* words in the diversion at each level */
+extern char *capopt; /* the -C option itself, for -D jobs started afresh */
+
+void capset(char *s);
+void capstart(void);
+void capfail(int what);
+
+/* Block n of macro storage now in use */
+#define CAPBLK(n) (capblk && (n) > capblk ? capfail(CAP_MACRO) : (void)0)
+/* A word more in the diversion at level lev */
+#define CAPDIV(lev) (capdiv && ++capdw[lev] > capdiv ? capfail(CAP_DIV) : (void)0)
+/* Frame n pushed */
+#define CAPDEPTH(n) (capdepth && (n) > capdepth ? capfail(CAP_DEPTH) : (void)0)
+
+#endif /* CAPS_H */
@@ -8,6 +8,8 @@
  */
 
 #include "tdef.h"
+#define OSA_TAG "croff"
+#include "os/os_acct.h" /* OSA_FREE */
 #include <stdio.h>
 
 /* External declarations for functions */
@@ -23,6 +25,13 @@ extern void mchbits(void);
 extern int findn(int i);
 extern int findmn(int i);
 extern void clrmn(int i);
+extern void setmn(int i, int rq);
+
+/* Request/macro table, see ni.c */
+extern struct contab {
+    int rq;
+    int (*f)(void);
+} *contab;
 
 /* External variables for text formatting state */
 extern int lss;        /* Line spacing size (vertical spacing) */
@@ -39,7 +48,7 @@ extern int sps;        /* Space size */
 extern int ics;        /* Inter-character spacing */
 extern int bd;         /* Bold mode */
 extern int cs;         /* Constant spacing mode */
-extern int lgf;        /* Ligature flag */
+extern int lg;         /* Ligature mode */
 extern int font;       /* Current font */
 extern int pts;        /* Current point size */
 extern int ulfont;     /* Underline font */
@@ -157,9 +166,8 @@ int casern(void) {
     }
 
     /* Clear destination if it exists, then rename */
-    if ((j = findmn(j)) >= 0) {
-        clrmn(j);
-    }
+    clrmn(findmn(j));
+    setmn(i, (contab[i].rq & MMASK) | j);
 
     return 0;
 }
@@ -298,19 +306,19 @@ int casebd(void) {
     return 0;
 }
 
-/* Ligature command handler (.lg request) */
+/* Ligature command handler (.lg request): .lg N, 1 if N is left out */
 int caselg(void) {
-    int i;
+    extern void getmap(void);
+    extern void lgflush(void);
 
-    skip();
-    if (skip()) {
-        lgf = 1;  /* Enable ligatures by default */
-    } else {
+    lg = 1;
+    if (!skip()) {
         noscale++;
-        i = inumb(&lgf);
+        lg = inumb(&lg);
         noscale = 0;
-        lgf = (i > 0) ? 1 : 0;
     }
+    getmap(); /* 'f' begins a ligature, or no longer does */
+    lgflush(); /* .lg 2 forms no ffi or ffl */
     return 0;
 }
 
@@ -357,14 +365,6 @@ int caseuf(void) {
 
 /* Additional utility functions */
 
-/* Hyphenation function */
-int hyphen(void *p) {
-    (void)p; /* Unused - hyphenation disabled for now */
-    /* Hyphenation is complex and requires dictionary lookup
-     * For now, return 0 (no hyphenation points found) */
-    return 0;
-}
-
 /* Make macro function - creates motion command */
 void makem(int i) {
     /* This function is actually for making motion commands
@@ -372,22 +372,6 @@ void makem(int i) {
     (void)i;
 }
 
-/* Get word function - word collection for processing */
-int getword(int x, int y) {
-    /* Word collection is handled by the main word processing
-     * This is a stub for compatibility */
-    (void)x;
-    (void)y;
-    return 0;
-}
-
-/* Suffix table byte getter - hyphenation support */
-int suftab_get_byte(size_t index) {
-    /* Suffix table is used for hyphenation
-     * Return 0 for now (no hyphenation data) */
-    (void)index;
-    return 0;
-}
 
 /* Other utility functions */
 
@@ -403,12 +387,6 @@ int seek(int fd, long offset, int whence) {
     return (int)lseek(fd, offset, whence);
 }
 
-/* Get ligature - ligature processing */
-void getlg(int x) {
-    /* Ligature processing handled elsewhere */
-    (void)x;
-}
-
 /* Extra line spacing - special spacing command */
 void xlss(void) {
     /* Extra line spacing - handled in line spacing code */
@@ -427,18 +405,6 @@ void reset(int x) {
     /* Reset handled by main reset() function */
 }
 
-/* System write - write wrapper */
-void sys_write(int fd, const void *buf, size_t count) {
-    extern ssize_t write(int, const void *, size_t);
-    write(fd, buf, count);
-}
-
-/* System read - read wrapper */
-int sys_read(int fd, void *buf, size_t count) {
-    extern ssize_t read(int, void *, size_t);
-    return (int)read(fd, buf, count);
-}
-
 /* Wolf - width function (historical name) */
 void Wolf(int x) {
     /* Width function - handled by width() */
@@ -474,7 +440,7 @@ void fnumb(int x, int (*f)(int)) {
 /* Free memory - wrapper for free() */
 void troff_free(void *p) {
     extern void free(void *);
-    free(p);
+    OSA_FREE(p);
 }
 
 /* Get string - string collection */
@@ -0,0 +1,311 @@
+/* chtab_hash.h - generated by mkchtab from ntab.c; do not edit */
+
+/* 124 names in 1024 slots, multiplier found in 23 tries */
+#define CHHASH_MUL 0x9c0aa21bu
+#define CHHASH_BITS 10
+#define CHHASH(name) (((unsigned)(name) * CHHASH_MUL) >> (32 - CHHASH_BITS))
+
+/* The name in each slot, 0 if none, and the code it gives */
+extern const int chhname[1024];
+extern const short chhcode[1024];
+/* The first name giving each code, 0 if none */
+extern const int chrev[256];
+
+#ifdef CHTAB_TABLES /* ntab.c */
+const int chhname[1024] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0x2a70, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0x2a47, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0x7370, 0, 0,
+    0, 0, 0, 0, 0x7275, 0, 0, 0,
+    0, 0, 0, 0, 0, 0x2a75, 0, 0,
+    0, 0, 0, 0, 0x666c, 0, 0, 0x2a4c,
+    0, 0, 0x6571, 0x6879, 0, 0, 0, 0,
+    0, 0x7263, 0, 0, 0, 0, 0, 0,
+    0, 0, 0x2a63, 0, 0, 0, 0, 0,
+    0, 0, 0x6962, 0, 0x6f72, 0, 0, 0,
+    0, 0, 0, 0, 0, 0x6464, 0x2a7a, 0,
+    0, 0, 0, 0, 0x6369, 0, 0, 0x2a51,
+    0, 0, 0, 0x7363, 0, 0, 0, 0,
+    0, 0, 0x7268, 0, 0, 0, 0, 0,
+    0, 0, 0, 0x2a68, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0x6161, 0x6469, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0x6273, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0x2a6d, 0, 0x6d6f, 0,
+    0, 0, 0, 0, 0x6c74, 0x2a44, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0x2b2d, 0, 0, 0,
+    0, 0x6c62, 0, 0, 0, 0, 0, 0,
+    0, 0x6e6f, 0, 0, 0, 0x2a72, 0, 0,
+    0, 0, 0x6361, 0x6669, 0, 0, 0x2a49, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0x7372, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0x6461, 0x2a77, 0,
+    0, 0, 0, 0, 0, 0, 0, 0x2a4e,
+    0, 0, 0x6573, 0, 0, 0, 0, 0,
+    0x6170, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0x2a65, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0x2a53, 0, 0, 0, 0, 0, 0, 0,
+    0, 0x2a2a, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0x7074, 0,
+    0, 0, 0, 0, 0, 0x2a41, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0x2a58, 0, 0x6275, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0x2a6f, 0x6761, 0, 0,
+    0, 0, 0, 0x6666, 0, 0, 0x2a46, 0,
+    0, 0x7e3d, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0x6375, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0x7274, 0, 0, 0,
+    0, 0, 0, 0, 0, 0x2a74, 0, 0,
+    0, 0, 0, 0, 0, 0x6973, 0x2a4b, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0x7262, 0, 0, 0, 0, 0, 0,
+    0, 0, 0x2a62, 0, 0, 0x706c, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0x2a79, 0,
+    0, 0, 0, 0, 0, 0, 0, 0x2a50,
+    0, 0, 0, 0x7362, 0x3132, 0, 0, 0,
+    0, 0x7267, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0x2a67, 0, 0x6d69, 0, 0,
+    0, 0, 0x6966, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0x213d, 0, 0,
+    0x2a55, 0, 0, 0x6272, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0x2a6c, 0, 0, 0,
+    0, 0, 0, 0, 0, 0x2a43, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0x2a5a, 0, 0, 0x7064, 0x736c, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0x2a71, 0, 0,
+    0, 0, 0, 0, 0x6970, 0, 0x2a48, 0,
+    0, 0x656d, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0x7371, 0,
+    0, 0, 0x6c66, 0, 0x2d3e, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0x3c3d, 0, 0x666d, 0, 0, 0x2a4d,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0x756c, 0, 0, 0, 0, 0,
+    0, 0, 0x2a64, 0, 0, 0, 0, 0,
+    0, 0, 0, 0x6c6b, 0, 0, 0, 0,
+    0, 0, 0, 0, 0x3d3d, 0, 0x6465, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0x2a52, 0, 0, 0, 0x3134, 0, 0, 0,
+    0, 0, 0, 0x466c, 0, 0, 0, 0,
+    0, 0, 0, 0x2a69, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0x3e3d,
+    0, 0, 0, 0, 0, 0, 0, 0x6772,
+    0, 0, 0, 0, 0, 0x636f, 0, 0,
+    0x2a57, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0x726e, 0, 0, 0, 0,
+    0, 0, 0, 0, 0x2a6e, 0, 0, 0,
+    0, 0, 0, 0, 0, 0x2a45, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0x3334, 0, 0, 0, 0, 0x6374, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0x6c63, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0x2a73, 0, 0x6d75,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0x2a61, 0, 0, 0, 0, 0,
+    0, 0, 0x6c68, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0x2a78, 0,
+    0, 0, 0, 0, 0, 0, 0, 0x2a4f,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0x7266, 0x4669, 0, 0, 0, 0, 0,
+    0x7473, 0, 0, 0x2a66, 0, 0, 0, 0x3c2d,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0x6467, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0x2a54, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0x726b, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0x2a6b, 0, 0, 0,
+    0, 0, 0, 0, 0, 0x2a42, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0x7561, 0, 0, 0, 0, 0, 0, 0,
+    0, 0x2a59, 0, 0x6276, 0, 0, 0, 0,
+};
+
+const short chhcode[1024] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0247, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0260, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0321, 0, 0,
+    0, 0, 0, 0, 0204, 0, 0, 0,
+    0, 0, 0, 0, 0, 0253, 0, 0,
+    0, 0, 0, 0, 0212, 0, 0, 0263,
+    0, 0, 0312, 0200, 0, 0, 0, 0,
+    0, 0362, 0, 0, 0, 0, 0, 0,
+    0, 0, 0245, 0, 0, 0, 0, 0,
+    0, 0, 0322, 0, 0346, 0, 0, 0,
+    0, 0, 0, 0, 0, 0341, 0235, 0,
+    0, 0, 0, 0, 0347, 0, 0, 0272,
+    0, 0, 0, 0220, 0, 0, 0, 0,
+    0, 0, 0342, 0, 0, 0, 0, 0,
+    0, 0, 0, 0237, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0222, 0314, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0345, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0243, 0, 0333, 0,
+    0, 0, 0, 0, 0350, 0261, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0315, 0, 0, 0,
+    0, 0351, 0, 0, 0, 0, 0, 0,
+    0, 0327, 0, 0, 0, 0250, 0, 0,
+    0, 0, 0317, 0211, 0, 0, 0111, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0274, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0311, 0257, 0,
+    0, 0, 0, 0, 0, 0, 0, 0116,
+    0, 0, 0332, 0, 0, 0, 0, 0,
+    0304, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0234, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0266, 0, 0, 0, 0, 0, 0, 0,
+    0, 0344, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0331, 0,
+    0, 0, 0, 0, 0, 0101, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0130, 0, 0201, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0246, 0223, 0, 0,
+    0, 0, 0, 0213, 0, 0, 0271, 0,
+    0, 0303, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0316, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0352, 0, 0, 0,
+    0, 0, 0, 0, 0, 0252, 0, 0,
+    0, 0, 0, 0, 0, 0330, 0113, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0353, 0, 0, 0, 0, 0, 0,
+    0, 0, 0231, 0, 0, 0334, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0236, 0,
+    0, 0, 0, 0, 0, 0, 0, 0265,
+    0, 0, 0, 0320, 0206, 0, 0, 0,
+    0, 0335, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0232, 0, 0302, 0, 0,
+    0, 0, 0324, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0305, 0, 0,
+    0270, 0, 0, 0337, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0242, 0, 0, 0,
+    0, 0, 0, 0, 0, 0264, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0132, 0, 0, 0325, 0225, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0256, 0, 0,
+    0, 0, 0, 0, 0323, 0, 0262, 0,
+    0, 0203, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0202, 0,
+    0, 0, 0357, 0, 0306, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0300, 0, 0221, 0, 0, 0115,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0224, 0, 0, 0, 0, 0,
+    0, 0, 0233, 0, 0, 0, 0, 0,
+    0, 0, 0, 0354, 0, 0, 0, 0,
+    0, 0, 0, 0, 0301, 0, 0216, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0120, 0, 0, 0, 0205, 0, 0, 0,
+    0, 0, 0, 0215, 0, 0, 0, 0,
+    0, 0, 0, 0240, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0277,
+    0, 0, 0, 0, 0, 0, 0, 0326,
+    0, 0, 0, 0, 0, 0336, 0, 0,
+    0273, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0276, 0, 0, 0, 0,
+    0, 0, 0, 0, 0244, 0, 0, 0,
+    0, 0, 0, 0, 0, 0105, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0207, 0, 0, 0, 0, 0340, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0361, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0251, 0, 0313,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0230, 0, 0, 0, 0, 0,
+    0, 0, 0343, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0255, 0,
+    0, 0, 0, 0, 0, 0, 0, 0117,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0360, 0214, 0, 0, 0, 0, 0,
+    0275, 0, 0, 0254, 0, 0, 0, 0307,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0217, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0124, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0355, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0241, 0, 0, 0,
+    0, 0, 0, 0, 0, 0102, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0310, 0, 0, 0, 0, 0, 0, 0,
+    0, 0110, 0, 0356, 0, 0, 0, 0,
+};
+
+const int chrev[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0x2a41, 0x2a42, 0, 0, 0x2a45, 0, 0,
+    0x2a59, 0x2a49, 0, 0x2a4b, 0, 0x2a4d, 0x2a4e, 0x2a4f,
+    0x2a52, 0, 0, 0, 0x2a54, 0, 0, 0,
+    0x2a58, 0, 0x2a5a, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0x6879, 0x6275, 0x7371, 0x656d, 0x7275, 0x3134, 0x3132, 0x3334,
+    0, 0x6669, 0x666c, 0x6666, 0x4669, 0x466c, 0x6465, 0x6467,
+    0x7363, 0x666d, 0x6161, 0x6761, 0x756c, 0x736c, 0, 0,
+    0x2a61, 0x2a62, 0x2a67, 0x2a64, 0x2a65, 0x2a7a, 0x2a79, 0x2a68,
+    0x2a69, 0x2a6b, 0x2a6c, 0x2a6d, 0x2a6e, 0x2a63, 0x2a6f, 0x2a70,
+    0x2a72, 0x2a73, 0x2a74, 0x2a75, 0x2a66, 0x2a78, 0x2a71, 0x2a77,
+    0x2a47, 0x2a44, 0x2a48, 0x2a4c, 0x2a43, 0x2a50, 0x2a53, 0,
+    0x2a55, 0x2a46, 0x2a51, 0x2a57, 0x7372, 0x7473, 0x726e, 0x3e3d,
+    0x3c3d, 0x3d3d, 0x6d69, 0x7e3d, 0x6170, 0x213d, 0x2d3e, 0x3c2d,
+    0x7561, 0x6461, 0x6571, 0x6d75, 0x6469, 0x2b2d, 0x6375, 0x6361,
+    0x7362, 0x7370, 0x6962, 0x6970, 0x6966, 0x7064, 0x6772, 0x6e6f,
+    0x6973, 0x7074, 0x6573, 0x6d6f, 0x706c, 0x7267, 0x636f, 0x6272,
+    0x6374, 0x6464, 0x7268, 0x6c68, 0x2a2a, 0x6273, 0x6f72, 0x6369,
+    0x6c74, 0x6c62, 0x7274, 0x7262, 0x6c6b, 0x726b, 0x6276, 0x6c66,
+    0x7266, 0x6c63, 0x7263, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+};
+#endif
@@ -0,0 +1,204 @@
+/* C17 - no scaffold needed */
+/*
+ * cpipe.c - Run tbl | neqn | croff as one command
+ *
+ *   cpipe [croff options] [file ...]
+ *
+ * The input, the files or else the standard input, is read once for
+ * lines that start a table (.TS) or an equation (.EQ), and only the
+ * preprocessors it needs are run: a document with neither goes to
+ * croff directly, with nothing copied.  The first stage reads the
+ * files itself; the standard input, already read, is handed to it from
+ * memory.  Options go to croff.
+ *
+ * The stages are the programs next to cpipe, or on the PATH if cpipe
+ * was run without a directory.  They run at once, joined by pipes.
+ * The exit status is croff's, or else that of a stage that failed.
+ * Files read with .so are not searched.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define NSTAGE 3 /* tbl, neqn, croff */
+
+static const char *self; /* argv[0] */
+
+/* What the input needs */
+struct need {
+    int tbl, eqn;
+};
+
+/* Input read from a stream that cannot be read twice */
+struct inbuf {
+    char *p;
+    size_t n, size;
+};
+
+static void fatal(const char *what, const char *name) {
+    fprintf(stderr, "cpipe: %s %s: %s\n", what, name, strerror(errno));
+    exit(1);
+}
+
+/* Look through f for .TS and .EQ lines; keep what is read in b if not NULL. */
+static void scan(FILE *f, struct need *nd, struct inbuf *b) {
+    char *line = NULL, *q;
+    size_t cap = 0;
+    ssize_t n;
+    while ((n = getline(&line, &cap, f)) > 0) {
+        if (line[0] == '.' && line[1] == 'T' && line[2] == 'S')
+            nd->tbl = 1;
+        else if (line[0] == '.' && line[1] == 'E' && line[2] == 'Q')
+            nd->eqn = 1;
+        if (b == NULL)
+            continue;
+        if (b->n + (size_t)n > b->size) {
+            b->size = 2 * b->size + (size_t)n + BUFSIZ;
+            if ((q = realloc(b->p, b->size)) == NULL)
+                fatal("no memory for", "the standard input");
+            b->p = q;
+        }
+        memcpy(b->p + b->n, line, (size_t)n);
+        b->n += (size_t)n;
+    }
+    free(line);
+}
+
+/* Run the program name with argv, reading in and writing out. */
+static pid_t stage(const char *name, char **argv, int in, int out) {
+    char path[4096];
+    const char *slash;
+    pid_t pid;
+    if ((pid = fork()) < 0)
+        fatal("can't start", name);
+    if (pid > 0)
+        return (pid);
+    if (in != 0) {
+        dup2(in, 0);
+        close(in);
+    }
+    if (out != 1) {
+        dup2(out, 1);
+        close(out);
+    }
+    argv[0] = (char *)name;
+    if ((slash = strrchr(self, '/')) != NULL &&
+        snprintf(path, sizeof(path), "%.*s/%s", (int)(slash - self), self, name) < (int)sizeof(path))
+        execv(path, argv);
+    execvp(name, argv);
+    fprintf(stderr, "cpipe: can't run %s: %s\n", name, strerror(errno));
+    _exit(127);
+}
+
+/* A pipe whose ends are not passed on to the stages but as 0 or 1 */
+static void mkpipe(int fd[2]) {
+    if (pipe(fd) < 0)
+        fatal("can't make", "a pipe");
+    fcntl(fd[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fd[1], F_SETFD, FD_CLOEXEC);
+}
+
+int main(int argc, char **argv) {
+    struct need nd = {0, 0};
+    struct inbuf b = {NULL, 0, 0};
+    char **opts, **files, **sv, *names[NSTAGE];
+    pid_t pids[NSTAGE];
+    int nopt, nfile, nst, i, fd[2], in, feed, status, worst;
+    size_t off;
+    ssize_t w;
+    FILE *f;
+
+    self = argv[0];
+    opts = calloc((size_t)argc + 1, sizeof(*opts));
+    files = calloc((size_t)argc + 1, sizeof(*files));
+    sv = calloc((size_t)argc + 2, sizeof(*sv));
+    if (opts == NULL || files == NULL || sv == NULL)
+        fatal("no memory for", "arguments");
+    for (nopt = nfile = 0, i = 1; i < argc; i++)
+        if (argv[i][0] == '-' && argv[i][1] != 0)
+            opts[nopt++] = argv[i];
+        else
+            files[nfile++] = argv[i];
+
+    if (nfile == 0)
+        scan(stdin, &nd, &b);
+    for (i = 0; i < nfile; i++) {
+        if (strcmp(files[i], "-") == 0) {
+            fprintf(stderr, "cpipe: - among files; give the standard input alone\n");
+            return (1);
+        }
+        if ((f = fopen(files[i], "r")) == NULL)
+            fatal("can't open", files[i]);
+        scan(f, &nd, NULL);
+        fclose(f);
+    }
+
+    nst = 0;
+    if (nd.tbl)
+        names[nst++] = "tbl";
+    if (nd.eqn)
+        names[nst++] = "neqn";
+    names[nst++] = "croff";
+
+    /* The first stage reads the files, or what was read of the standard input */
+    in = 0;
+    feed = -1;
+    if (nfile == 0) {
+        mkpipe(fd);
+        in = fd[0];
+        feed = fd[1];
+    }
+    for (i = 0; i < nst; i++) {
+        if (i < nst - 1)
+            mkpipe(fd);
+        else
+            fd[1] = 1;
+        sv[1] = NULL;
+        if (i == nst - 1) { /* croff takes the options */
+            memcpy(sv + 1, opts, (size_t)nopt * sizeof(*sv));
+            sv[1 + nopt] = NULL;
+        }
+        if (i == 0)
+            memcpy(sv + 1 + (i == nst - 1 ? nopt : 0), files, (size_t)(nfile + 1) * sizeof(*sv));
+        pids[i] = stage(names[i], sv, in, fd[1]);
+        if (in != 0)
+            close(in);
+        if (fd[1] != 1)
+            close(fd[1]);
+        in = fd[0];
+    }
+
+    if (feed >= 0) {
+        signal(SIGPIPE, SIG_IGN); /* a stage that quits early is reported below */
+        for (off = 0; off < b.n; off += (size_t)w)
+            if ((w = write(feed, b.p + off, b.n - off)) < 0) {
+                if (errno == EINTR) {
+                    w = 0;
+                    continue;
+                }
+                break;
+            }
+        close(feed);
+        free(b.p);
+    }
+
+    for (worst = 0, i = 0; i < nst; i++) {
+        while (waitpid(pids[i], &status, 0) < 0)
+            if (errno != EINTR) {
+                status = 1 << 8;
+                break;
+            }
+        status = WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+        if (i == nst - 1 && status != 0)
+            return (status);
+        if (status != 0)
+            worst = status;
+    }
+    return (worst);
+}
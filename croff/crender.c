@@ -0,0 +1,599 @@
+/* C17 - no scaffold needed */
+/*
+ * crender.c - Render croff -I pages for a terminal
+ *
+ *   crender [-Tname[=out]]... [-h] [-jN] [file]
+ *
+ * Reads the intermediate stream of ipage.h from file, or the standard
+ * input, and writes what croff itself would have written to terminal
+ * name.  The terminal driver is n10.c, included here with its state
+ * thread-local, so every page is rendered by the same code croff runs;
+ * -jN renders N pages at once, one per CPU by default.  Pages are
+ * written in order.
+ *
+ * -Tname=out renders for terminal name into file out, and may be given
+ * for several terminals: the document is formatted once, and each
+ * terminal renders the stream in a process of its own, with its share
+ * of the -j threads.  The table and the spans n10.c builds from it are
+ * the process's, so terminals do not share a process.  Given any, only
+ * these are rendered.
+ *
+ * A page starts with the driver in the state the previous one left it
+ * in: pending motion, column, bold and font.  A first pass through the
+ * stream follows that state from page to page without writing
+ * anything, so that each page can then be rendered on its own.  Pages
+ * split only between lines.
+ *
+ * The table must have the widths the stream was formatted with; its
+ * motion resolution may differ.  The terminal modes of the table are
+ * not set: that took the formatter's terminal, which crender does not
+ * have.
+ */
+
+#define TWSTATE _Thread_local
+#define TWEAGER 1 /* glyphs[] is built once, before the threads share it */
+#include "n10.c"
+#include "ipage.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#define RJMAX 64 /* most pages rendered at once */
+#define RDMAX 16 /* most terminals rendered for at once */
+
+/* What n10.c needs from the rest of croff */
+struct typewriter_table t;
+TroffProcessor g_processor;
+_Thread_local int lss, xfont, esc, lead, ulfont, esct;
+_Thread_local int oline[LNSIZE];
+_Thread_local int *olinep;
+_Thread_local struct env *dip;
+int sps, ics, ttysave, ttys[3];
+int ptid = 1, waitf, pipeflg, eqflg, hflg, xxx;
+char termtab[NS] = "/usr/lib/term/37";
+int tti = 14;
+void fwmark(int i) { (void)i; } /* -I pages have no forward references */
+void tsdef(int w) { (void)w; } /* nor tabs: their lines are set already */
+int pmflg; /* nor -G: each page is put out as it is rendered */
+void pmline(const int *q, int n, int down) { (void)q; (void)n; (void)down; }
+void pmlead(void) {}
+void pmstop(void) {}
+
+/* Output of one page, or of ptinit() */
+struct rbuf {
+    char *p;
+    size_t n, size;
+};
+
+/* Driver state at the start of a page */
+struct rstate {
+    int lead, esc, esct, xfont, bdmode, ulfont;
+    int font, size; /* of the glyphs that follow */
+};
+
+struct rpage {
+    const unsigned char *p, *end;
+    struct rstate st;
+    struct rbuf out;
+    int done;
+};
+
+/* Records still to be read */
+struct rin {
+    const unsigned char *p, *end;
+};
+
+static _Thread_local struct rbuf *rout;
+
+static struct rpage *rpages;
+static int nrpages;
+static int rnext; /* next page for a worker */
+static pthread_mutex_t rlock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t rdone = PTHREAD_COND_INITIALIZER;
+
+void oput(int c) {
+    if (rout->n == rout->size)
+        oputn(NULL, 0);
+    rout->p[rout->n++] = (char)c;
+}
+
+/* With s NULL, just make room */
+void oputn(const char *s, int n) {
+    size_t need = rout->n + (size_t)n + 1;
+
+    if (need > rout->size) {
+        rout->size = need > 2 * rout->size ? need : 2 * rout->size;
+        if ((rout->p = realloc(rout->p, rout->size)) == NULL) {
+            prstr("crender: out of memory\n");
+            exit(1);
+        }
+    }
+    if (s) {
+        memcpy(rout->p + rout->n, s, (size_t)n);
+        rout->n += (size_t)n;
+    }
+}
+
+void flusho(void) {}
+void prstr(const char *s) { fputs(s, stderr); }
+int stty(int fd, int *args) { (void)fd; (void)args; return 0; }
+void widflush(void) {}
+
+/*
+ * crender is the device end, so -I is never on.  With CRENDER_LIB the
+ * program is left out, and a test may link ipage.c in its place.
+ */
+#ifndef CRENDER_LIB
+int ipflg;
+void ipout(int i) { (void)i; }
+void iplead(void) {}
+void ipstop(void) {}
+void ipdone(void) {}
+#endif
+
+static void rbad(void) {
+    prstr("crender: not a croff -I stream\n");
+    exit(1);
+}
+
+static unsigned long rnum(struct rin *in) {
+    unsigned long n = 0;
+    int shift = 0;
+
+    for (;;) {
+        if (in->p == in->end || shift > 56)
+            rbad();
+        n |= (unsigned long)(*in->p & 0177) << shift;
+        if (!(*in->p++ & 0200))
+            return n;
+        shift += 7;
+    }
+}
+
+static int rsnum(struct rin *in) {
+    unsigned long n = rnum(in);
+
+    return (n & 1) ? (int)~(long)(n >> 1) : (int)(n >> 1);
+}
+
+/* The oline[] item croff handed to ptout() for glyph c */
+static int ritem(const struct rstate *s, int c, int z) {
+    return c | (z ? ZBIT : 0) | (s->size << 11) | (s->font << 9);
+}
+
+/* The pending motion that move() makes */
+static void smove(struct rstate *s) {
+    s->esct += s->esc;
+    s->esc = s->lead = 0;
+}
+
+/* ptout1() on the items of a line, as far as the state goes */
+static void sline(struct rstate *s, const int *line, int n) {
+    const char *codep;
+    int i, j, k, w;
+
+    for (; n > 0; n--) {
+        i = *line++;
+        if (i & MOT) {
+            j = i & ~MOTV;
+            if (i & NMOT)
+                j = -j;
+            if (i & VMOT)
+                s->lead += j;
+            else
+                s->esc += j;
+            continue;
+        }
+        k = i & CMASK;
+        if (k <= 040) {
+            if (k == ' ')
+                s->esc += t.Char;
+            continue;
+        }
+        codep = t.codetab[k - 32];
+        w = (i & ZBIT) ? 0 : t.Char * (*codep & 0177);
+        if (codep[1] && (s->esc || s->lead))
+            smove(s);
+        s->esct += w;
+        if (i & 074000)
+            s->xfont = (i >> 9) & 03;
+        if (twbold)
+            s->bdmode = s->xfont == 2;
+    }
+}
+
+/*
+ * Follow the driver through the whole stream, as the renderer would,
+ * and start a page at each IP_PAGE met between lines.
+ */
+static void rscan(const unsigned char *p, const unsigned char *end) {
+    static int line[LNSIZE];
+    struct rstate s;
+    struct rin in;
+    int n, c, z, before, after, size;
+
+    memset(&s, 0, sizeof(s));
+    in.p = p;
+    in.end = end;
+    n = z = 0;
+    size = 16;
+    nrpages = 0;
+    rpages = malloc((size_t)size * sizeof(*rpages));
+    for (;;) {
+        if (in.p == p || (in.p < in.end && *in.p == IP_PAGE && n == 0)) {
+            if (nrpages)
+                rpages[nrpages - 1].end = in.p;
+            if (nrpages == size)
+                rpages = realloc(rpages, (size_t)(size *= 2) * sizeof(*rpages));
+            if (rpages == NULL) {
+                prstr("crender: out of memory\n");
+                exit(1);
+            }
+            memset(&rpages[nrpages], 0, sizeof(*rpages));
+            rpages[nrpages].p = in.p;
+            rpages[nrpages].st = s;
+            nrpages++;
+        }
+        if (in.p == in.end) {
+            rpages[nrpages - 1].end = in.p;
+            break;
+        }
+        c = *in.p++;
+        if (c >= 040) {
+            line[n++] = ritem(&s, c, z);
+            if (n >= LNSIZE)
+                n--;
+            z = 0;
+            continue;
+        }
+        switch (c) {
+        case IP_NL:
+            before = rsnum(&in);
+            after = rsnum(&in);
+            if (n == LNSIZE - 1)
+                n--; /* the newline took the last slot in ptout() */
+            s.lead = before - t.Newline;
+            s.esct = s.esc = 0;
+            if (n > 0) {
+                smove(&s);
+                sline(&s, line, n);
+            } else {
+                s.lead = t.Newline;
+                smove(&s);
+            }
+            s.lead = after;
+            n = 0;
+            break;
+        case IP_HMOT:
+        case IP_VMOT:
+            c = (c == IP_VMOT) ? VMOT : 0;
+            before = rsnum(&in);
+            line[n++] = MOT | c | (before < 0 ? NMOT | -before : before);
+            if (n >= LNSIZE)
+                n--;
+            break;
+        case IP_ZGLYPH:
+            z = 1;
+            break;
+        case IP_FONT:
+            s.font = rsnum(&in) & 03;
+            break;
+        case IP_SIZE:
+            s.size = rsnum(&in) & 017;
+            break;
+        case IP_UL:
+            s.ulfont = rsnum(&in);
+            break;
+        case IP_LEAD:
+            s.lead += rsnum(&in);
+            break;
+        case IP_ESC:
+            s.esc += rsnum(&in);
+            break;
+        case IP_FLUSH:
+            smove(&s);
+            break;
+        case IP_PAGE:
+            rnum(&in);
+            break;
+        case IP_STOP:
+        case IP_END:
+            break;
+        default:
+            rbad();
+        }
+    }
+}
+
+/* Render a page through the driver */
+static void rpage(struct rpage *pg) {
+    static _Thread_local struct env renv;
+    struct rstate s = pg->st;
+    struct rin in;
+    int c, j, z;
+
+    rout = &pg->out;
+    lead = s.lead;
+    esc = s.esc;
+    esct = s.esct;
+    xfont = s.xfont;
+    bdmode = s.bdmode;
+    ulfont = s.ulfont;
+    plotmode = 0;
+    lss = 0;
+    olinep = oline;
+    dip = &renv;
+    in.p = pg->p;
+    in.end = pg->end;
+    z = 0;
+    while (in.p < in.end) {
+        c = *in.p++;
+        if (c >= 040) {
+            ptout(ritem(&s, c, z));
+            z = 0;
+            continue;
+        }
+        switch (c) {
+        case IP_NL:
+            renv.blss = rsnum(&in);
+            renv.alss = rsnum(&in);
+            ptout('\n');
+            break;
+        case IP_HMOT:
+        case IP_VMOT:
+            c = (c == IP_VMOT) ? VMOT : 0;
+            j = rsnum(&in);
+            ptout(MOT | c | (j < 0 ? NMOT | -j : j));
+            break;
+        case IP_ZGLYPH:
+            z = 1;
+            break;
+        case IP_FONT:
+            s.font = rsnum(&in) & 03;
+            break;
+        case IP_SIZE:
+            s.size = rsnum(&in) & 017;
+            break;
+        case IP_UL:
+            ulfont = rsnum(&in);
+            break;
+        case IP_LEAD:
+            lead += rsnum(&in);
+            break;
+        case IP_ESC:
+            esc += rsnum(&in);
+            break;
+        case IP_FLUSH:
+            ptlead();
+            break;
+        case IP_PAGE:
+            rnum(&in);
+            break;
+        case IP_END:
+            oputs(t.twrest); /* twdone() */
+            break;
+        }
+    }
+}
+
+static void *rworker(void *arg) {
+    int k;
+
+    (void)arg;
+    for (;;) {
+        pthread_mutex_lock(&rlock);
+        k = rnext < nrpages ? rnext++ : -1;
+        pthread_mutex_unlock(&rlock);
+        if (k < 0)
+            return NULL;
+        rpage(&rpages[k]);
+        pthread_mutex_lock(&rlock);
+        rpages[k].done = 1;
+        pthread_cond_broadcast(&rdone);
+        pthread_mutex_unlock(&rlock);
+    }
+}
+
+static void rwrite(int fd, struct rbuf *b) {
+    size_t k;
+    ssize_t w;
+
+    for (k = 0; k < b->n; k += (size_t)w)
+        if ((w = write(fd, b->p + k, b->n - k)) < 0) {
+            prstr("crender: write error\n");
+            exit(1);
+        }
+    free(b->p);
+    b->p = NULL;
+    b->n = b->size = 0;
+}
+
+/* Check the stream header against t and return where the records start */
+static const unsigned char *rhead(const unsigned char *p, const unsigned char *end) {
+    static const int *const want[] = {&t.Newline, &t.Char, &t.Em, &t.Halfline};
+    unsigned long h[IP_NHDR];
+    struct rin in;
+    int k;
+
+    if (end - p < 4 || memcmp(p, IP_MAGIC, 4) != 0)
+        rbad();
+    in.p = p + 4;
+    in.end = end;
+    if (rnum(&in) != IP_VERSION)
+        rbad();
+    for (k = 0; k < IP_NHDR; k++)
+        h[k] = rnum(&in);
+    /* Hor, Vert, then the widths the lines were filled with */
+    for (k = 0; k < 4; k++)
+        if (h[k + 2] != (unsigned long)*want[k]) {
+            prstr("crender: stream was formatted for another terminal\n");
+            exit(1);
+        }
+    return in.p;
+}
+
+/*
+ * crender_run
+ * Renders the stream p..end to fd with nj threads.
+ */
+int crender_run(const unsigned char *p, const unsigned char *end, int fd, int nj) {
+    static struct rbuf init;
+    pthread_t tid[RJMAX];
+    int k, nt;
+
+    rout = &init;
+    ptinit();
+    rwrite(fd, &init);
+    p = rhead(p, end);
+    rscan(p, end);
+    rnext = 0;
+    if (nj > RJMAX)
+        nj = RJMAX;
+    for (nt = 0; nt < nj - 1 && nt < nrpages; nt++)
+        if (pthread_create(&tid[nt], NULL, rworker, NULL) != 0)
+            break;
+    if (nt == 0)
+        rworker(NULL);
+    for (k = 0; k < nrpages; k++) {
+        pthread_mutex_lock(&rlock);
+        while (!rpages[k].done)
+            pthread_cond_wait(&rdone, &rlock);
+        pthread_mutex_unlock(&rlock);
+        rwrite(fd, &rpages[k].out);
+    }
+    while (nt > 0)
+        pthread_join(tid[--nt], NULL);
+    free(rpages);
+    rpages = NULL;
+    nrpages = 0;
+    return 0;
+}
+
+/* Make name the terminal; -1 if it cannot be */
+static int rterm(const char *name) {
+    if (!*name || strlen(name) >= NS - (size_t)tti)
+        return -1;
+    strcpy(&termtab[tti], name);
+    return 0;
+}
+
+/*
+ * crender_fan
+ * Renders the stream p..end for each of the n terminals named, the
+ * k'th to fd[k], each in a process of its own with nj threads.
+ * Returns 0, or -1 if any of them failed.
+ */
+int crender_fan(const unsigned char *p, const unsigned char *end, int n, char *const *name,
+                const int *fd, int nj) {
+    pid_t pid[RDMAX];
+    int k, st, rc;
+
+    if (n > RDMAX)
+        return -1;
+    rc = 0;
+    for (k = 0; k < n; k++) {
+        if ((pid[k] = fork()) == 0) {
+            if (rterm(name[k]) < 0)
+                _exit(1);
+            crender_run(p, end, fd[k], nj);
+            _exit(0);
+        }
+        if (pid[k] < 0) {
+            prstr("crender: cannot fork\n");
+            rc = -1;
+        }
+    }
+    for (k = 0; k < n; k++)
+        if ((pid[k] > 0) &&
+            ((waitpid(pid[k], &st, 0) < 0) || !WIFEXITED(st) || (WEXITSTATUS(st) != 0)))
+            rc = -1;
+    return rc;
+}
+
+#ifndef CRENDER_LIB
+/* All of fd */
+static unsigned char *rslurp(int fd, size_t *np) {
+    unsigned char *p = NULL;
+    size_t n = 0, size = 0;
+    ssize_t r;
+
+    do {
+        if (n == size && (p = realloc(p, size = size ? 2 * size : 65536)) == NULL) {
+            prstr("crender: out of memory\n");
+            exit(1);
+        }
+    } while ((r = read(fd, p + n, size - n)) > 0 && (n += (size_t)r, 1));
+    if (r < 0) {
+        prstr("crender: read error\n");
+        exit(1);
+    }
+    *np = n;
+    return p;
+}
+
+int main(int argc, char **argv) {
+    char *name[RDMAX], *out[RDMAX];
+    int ofd[RDMAX];
+    unsigned char *buf;
+    char *p;
+    size_t n;
+    long nj;
+    int fd, nd, k, rc;
+
+    nj = sysconf(_SC_NPROCESSORS_ONLN);
+    fd = nd = 0;
+    for (; argc > 1 && argv[1][0] == '-' && argv[1][1]; argc--, argv++) {
+        switch (argv[1][1]) {
+        case 'T':
+            if ((p = strchr(&argv[1][2], '=')) == NULL) {
+                rterm(&argv[1][2]);
+                continue;
+            }
+            if (nd == RDMAX) {
+                prstr("crender: too many terminals\n");
+                return 1;
+            }
+            *p++ = 0;
+            name[nd] = &argv[1][2];
+            out[nd++] = p;
+            continue;
+        case 'h':
+            hflg++;
+            continue;
+        case 'j':
+            nj = atol(&argv[1][2]);
+            continue;
+        default:
+            prstr("usage: crender [-Tname[=out]]... [-h] [-jN] [file]\n");
+            return 1;
+        }
+    }
+    if (argc > 1 && (fd = open(argv[1], O_RDONLY)) < 0) {
+        prstr("crender: cannot open ");
+        prstr(argv[1]);
+        prstr("\n");
+        return 1;
+    }
+    if (nj < 1)
+        nj = 1;
+    buf = rslurp(fd, &n);
+    if (nd == 0) {
+        crender_run(buf, buf + n, 1, (int)nj);
+        free(buf);
+        return 0;
+    }
+    for (k = 0; k < nd; k++)
+        if ((ofd[k] = open(out[k], O_WRONLY | O_CREAT | O_TRUNC, 0666)) < 0) {
+            prstr("crender: cannot create ");
+            prstr(out[k]);
+            prstr("\n");
+            return 1;
+        }
+    rc = crender_fan(buf, buf + n, nd, name, ofd, (nj > nd) ? (int)(nj / nd) : 1);
+    for (k = 0; k < nd; k++)
+        close(ofd[k]);
+    free(buf);
+    return (rc < 0);
+}
+#endif
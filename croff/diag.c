@@ -0,0 +1,228 @@
+/* C17 - no scaffold needed */
+/*
+ * diag.c - Diagnostics held and written in blocks, for prstr()
+ *
+ * prstr() used to write every piece of a message to ttyod as it came,
+ * a system call each, and prstrfl() flushed the output before it too.
+ * A document gone wrong can say "Too many number registers." a hundred
+ * thousand times.  The pieces now gather into lines here, and the lines
+ * into a buffer of DGBUF bytes.  It is written when it fills, whenever
+ * flusho() has put the output out (dgsent()), before .rd reads the
+ * terminal, before croff forks, and at exit.  prstrfl() asks for the
+ * output formatted so far to go first: that is done once, when the
+ * buffer is written.
+ *
+ * -Qn lets any one line through n times; -Q is -Q1.  Past that, its
+ * copies are counted, for up to DGMSG different lines, and at exit
+ * each line held back is written once more with how many copies were
+ * not.  -Qj writes each line as a JSON object on a line of its own:
+ * {"msg":"...","n":k} for the k'th copy of a line counted,
+ * {"msg":"...","dropped":m} at exit.  -Q10j does both.
+ */
+
+#include "diag.h"
+#define OSA_TAG "croff.diag"
+#include "os/os_acct.h" /* OSA_MALLOC, OSA_WRITE */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define DGBUF 8192 /* bytes held before they are written */
+#define DGLINE 512 /* longest line counted; longer ones go out in pieces */
+#define DGMSG 1024 /* different lines counted, a power of two */
+#define DGPROBE 8 /* slots tried for a line */
+
+extern int ttyod;
+extern void flusho(void);
+
+int dglim; /* -Qn */
+int dgjson; /* -Qj */
+
+/* A line counted */
+struct dgmsg {
+    char *s; /* NULL for a free slot */
+    int len;
+    unsigned h;
+    long n; /* copies seen */
+};
+
+static char dgbuf[DGBUF];
+static int dgn;
+static char dgline[DGLINE]; /* the line being gathered */
+static int dgl;
+static int dgcut; /* it is the rest of a line too long to count */
+static int dgfl; /* flusho() before the buffer is written */
+static int dgexiting; /* atexit() has dgexit() */
+static struct dgmsg dgmsgs[DGMSG];
+
+static void dgexit(void);
+
+/* -Q[n][j] */
+void dgarg(const char *a) {
+    int n = 0;
+
+    for (; *a >= '0' && *a <= '9'; a++)
+        n = 10 * n + *a - '0';
+    if (*a == 'j')
+        dgjson = 1;
+    if (n > 0)
+        dglim = n;
+    else if (!dgjson)
+        dglim = 1;
+}
+
+/* Write what the buffer holds, after the output if prstrfl() asked */
+static void dgdrain(void) {
+    ssize_t k;
+    int n, at;
+
+    if (dgfl) {
+        dgfl = 0;
+        flusho(); /* which comes back through dgsent() */
+    }
+    for (n = dgn, dgn = 0, at = 0; at < n; at += (int)k)
+        if ((k = OSA_WRITE(ttyod, dgbuf + at, (size_t)(n - at))) <= 0)
+            break;
+}
+
+static void dgout(const char *s, int n) {
+    if (n > DGBUF - dgn)
+        dgdrain();
+    if (n <= DGBUF) {
+        memcpy(dgbuf + dgn, s, (size_t)n);
+        dgn += n;
+    } else if (OSA_WRITE(ttyod, s, (size_t)n) < 0) {
+        return; /* lost, as prstr() would have lost it */
+    }
+}
+
+/* The count of the n bytes at s, begun if need be; NULL if no room */
+static struct dgmsg *dgfind(const char *s, int n) {
+    struct dgmsg *m;
+    unsigned h;
+    int k;
+
+    for (h = 2166136261u, k = 0; k < n; k++)
+        h = (h ^ (unsigned char)s[k]) * 16777619u;
+    for (k = 0; k < DGPROBE; k++) {
+        m = &dgmsgs[(h + (unsigned)k) & (DGMSG - 1)];
+        if (m->s == NULL) {
+            if ((m->s = OSA_MALLOC((size_t)n + 1)) == NULL)
+                return (NULL);
+            memcpy(m->s, s, (size_t)n);
+            m->s[n] = 0;
+            m->len = n;
+            m->h = h;
+            m->n = 0;
+            return (m);
+        }
+        if ((m->h == h) && (m->len == n) && (memcmp(m->s, s, (size_t)n) == 0))
+            return (m);
+    }
+    return (NULL);
+}
+
+/* The n bytes at s as a JSON object, with key and its value if key */
+static void dgjs(const char *s, int n, const char *key, long v) {
+    char b[6 * DGLINE + 64];
+    int k, c, j;
+
+    j = snprintf(b, sizeof(b), "{\"msg\":\"");
+    for (k = 0; k < n; k++) {
+        c = (unsigned char)s[k];
+        if ((c == '"') || (c == '\\')) {
+            b[j++] = '\\';
+            b[j++] = (char)c;
+        } else if (c == '\n') {
+            b[j++] = '\\';
+            b[j++] = 'n';
+        } else if ((c < 040) || (c == 0177)) {
+            j += snprintf(b + j, sizeof(b) - j, "\\u%04x", c);
+        } else {
+            b[j++] = (char)c;
+        }
+    }
+    if (key != NULL)
+        j += snprintf(b + j, sizeof(b) - j, "\",\"%s\":%ld}\n", key, v);
+    else
+        j += snprintf(b + j, sizeof(b) - j, "\"}\n");
+    dgout(b, j);
+}
+
+/* The line gathered is complete, or as long as one can be */
+static void dgend(void) {
+    struct dgmsg *m;
+    int n, nl;
+
+    n = dgl;
+    dgl = 0;
+    nl = (n > 0) && (dgline[n - 1] == '\n');
+    m = NULL;
+    if ((dglim || dgjson) && nl && !dgcut)
+        m = dgfind(dgline, n - 1);
+    dgcut = !nl && (n == DGLINE); /* a prompt flushed ends its line */
+    if ((m != NULL) && (++m->n > dglim) && dglim)
+        return;
+    if (dgjson)
+        dgjs(dgline, n - nl, m ? "n" : NULL, m ? m->n : 0);
+    else
+        dgout(dgline, n);
+}
+
+/*
+ * dgput
+ * Adds the message s; fl says that the output formatted so far should
+ * be out before it, as prstrfl() wants.
+ */
+void dgput(const char *s, int fl) {
+    if (!dgexiting) {
+        dgexiting = 1;
+        atexit(dgexit);
+    }
+    dgfl |= fl;
+    for (; *s; s++) {
+        dgline[dgl++] = *s;
+        if ((*s == '\n') || (dgl == DGLINE))
+            dgend();
+    }
+}
+
+/* Write every message so far, a line left open as it is */
+void dgflush(void) {
+    if (dgl > 0)
+        dgend();
+    if (dgn > 0 || dgfl)
+        dgdrain();
+}
+
+/* flusho() has put the output out: the messages after it can follow */
+void dgsent(void) {
+    dgfl = 0;
+    dgflush();
+}
+
+/* At exit: the lines held back, once each with their count */
+static void dgexit(void) {
+    struct dgmsg *m;
+    char b[64];
+    int k;
+
+    if (dgl > 0)
+        dgend();
+    dgfl = 0; /* done() has put the output out */
+    for (k = 0; dglim && k < DGMSG; k++) {
+        m = &dgmsgs[k];
+        if ((m->s == NULL) || (m->n <= dglim))
+            continue;
+        if (dgjson) {
+            dgjs(m->s, m->len, "dropped", m->n - dglim);
+        } else {
+            dgout(b, snprintf(b, sizeof(b), "%ld more of: ", m->n - dglim));
+            dgout(m->s, m->len);
+            dgout("\n", 1);
+        }
+    }
+    dgdrain();
+}
@@ -0,0 +1,23 @@
+/* C17 - no scaffold needed */
+/*
+ * diag.h - Diagnostics held and written in blocks, for prstr()
+ *
+ * prstr() and prstrfl() put their messages through dgput(); diag.c
+ * writes them to ttyod when its buffer fills, when dgflush() is called,
+ * when flusho() calls dgsent() with the output out, and at exit.  Call
+ * dgflush() before waiting on the terminal and before a fork whose
+ * child goes on to exit().
+ */
+
+#ifndef DIAG_H
+#define DIAG_H
+
+extern int dglim; /* -Qn: copies of one line let through, 0 for all */
+extern int dgjson; /* -Qj: one JSON object to a line */
+
+void dgarg(const char *a);
+void dgput(const char *s, int fl);
+void dgflush(void);
+void dgsent(void);
+
+#endif /* DIAG_H */
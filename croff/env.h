@@ -7,6 +7,8 @@
  */
 
 /* C17 - no scaffold needed */ // common utilities
+#ifndef ENV_H
+#define ENV_H
 
 /*
  * Environment diversion structure used by troff.
@@ -47,3 +49,4 @@ typedef struct env {
  *   void init_env(env_t *e);
  */
 
+#endif /* ENV_H */
@@ -0,0 +1,281 @@
+/* C17 - no scaffold needed */
+/*
+ * fwref.c - Forward references, written in when the document ends
+ *
+ * .fs xx n declares string xx, and .fn xx n number register xx, to be
+ * given later, n columns wide: a table of contents or a cross-reference
+ * can use it before the part of the document that sets it has been
+ * formatted, and still be formatted in one run.  Until the end each use
+ * interpolates n FWHOLE characters, which fill and adjust as n plain
+ * characters do, and \n+ and \n- leave the register as it is.  The first
+ * one put out makes obuf hold the output back.  fwdone() then writes the
+ * value each name has at the end into its columns, and lets the output
+ * go: a string from the left, a register in its format from the right.
+ * Only the plain characters of a string are written, in the plain font,
+ * without its escapes, and a value wider than its columns is cut short,
+ * with a message.
+ *
+ * As the width is fixed, no line has to be broken again.  Under -I the
+ * requests are ignored and the names interpolate as they stand.  A
+ * document that declares any takes no -X checkpoints and caches no -R
+ * segments, since neither keeps the marks.
+ */
+
+#include "tdef.h" // troff definitions
+#include "fwref.h"
+#define OSA_TAG "croff.fwref"
+#include "os/os_acct.h" // OSA_MALLOC, OSA_REALLOC, OSA_FREE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FWHASH 4096 /* hash slots for declared names, a power of two above NFW */
+
+/* Where a column went in the held output */
+struct fwhole {
+    long at;
+    int id, col;
+};
+
+extern struct contab {
+    int rq;
+    union {
+        int (*func)(void);
+        int offset;
+    } f;
+} *contab;
+extern int cbuf[NC];
+extern int *cp;
+extern int nonumb;
+extern int noscale;
+extern int ipflg;
+
+extern int skip(void);
+extern int getrq(void);
+extern int tatoi(void);
+extern int findmn(int i);
+extern int rbf0(int p);
+extern int incoff(int p);
+extern int *nrchars(int i);
+extern void prstr(const char *s);
+extern void obhold(void);
+extern long obat(void);
+extern char *obheld(size_t *n);
+extern void obrelease(void);
+
+void casefs(void);
+void casefn(void);
+
+struct fwent *fwtab; /* nfw names declared */
+int nfw;
+
+static int nfwmax;
+static short fwhash[FWHASH]; /* fwtab index plus one, by name */
+static int fwhashn = -1; /* entries of fwtab in fwhash */
+static struct fwhole *fwh; /* columns put out, in order */
+static long nfwh, fwhmax;
+static int fwlost; /* a column could not be marked */
+
+/* Make room for n names; the hash is built again at the next lookup */
+int fwroom(int n) {
+    struct fwent *f;
+
+    fwhashn = -1;
+    if (n <= nfwmax)
+        return (0);
+    if ((f = OSA_REALLOC(fwtab, n * sizeof(*f))) == NULL)
+        return (-1);
+    fwtab = f;
+    nfwmax = n;
+    return (0);
+}
+
+static unsigned fwslot(int name, int reg) {
+    unsigned h = (unsigned)(2 * name + reg) * 2654435761u;
+
+    return ((h ^ (h >> 16)) & (FWHASH - 1));
+}
+
+/* The entry of name, a register if reg is set, or -1 */
+static int fwfind(int name, int reg) {
+    unsigned h;
+    int k;
+
+    if (fwhashn != nfw) {
+        memset(fwhash, 0, sizeof(fwhash));
+        for (k = 0; k < nfw; k++) {
+            for (h = fwslot(fwtab[k].name, fwtab[k].reg); fwhash[h]; h = (h + 1) & (FWHASH - 1))
+                ;
+            fwhash[h] = (short)(k + 1);
+        }
+        fwhashn = nfw;
+    }
+    for (h = fwslot(name, reg); (k = fwhash[h]) != 0; h = (h + 1) & (FWHASH - 1))
+        if ((fwtab[k - 1].name == name) && (fwtab[k - 1].reg == reg))
+            return (k - 1);
+    return (-1);
+}
+
+/*
+ * Interpolate the columns of name, a register if reg is set, through
+ * cp.  Returns 0 if it is not a forward reference.
+ */
+int fwtext(int name, int reg) {
+    int k, j;
+
+    if ((k = fwfind(name, reg)) < 0)
+        return (0);
+    for (j = 0; j < fwtab[k].width; j++)
+        cbuf[j] = FWHOLE | (k << 16) | (j << 27);
+    cbuf[j] = 0;
+    cp = cbuf;
+    return (1);
+}
+
+/* Column i is about to be put out */
+void fwmark(int i) {
+    struct fwhole *h;
+    long at;
+    long n;
+
+    if ((at = obat()) < 0) {
+        obhold();
+        at = obat();
+    }
+    if (nfwh >= fwhmax) {
+        n = fwhmax ? 2 * fwhmax : 256;
+        if ((h = OSA_REALLOC(fwh, n * sizeof(*h))) == NULL) {
+            if (!fwlost++)
+                prstr("Out of memory for forward references.\n");
+            return;
+        }
+        fwh = h;
+        fwhmax = n;
+    }
+    fwh[nfwh].at = at;
+    fwh[nfwh].id = FWID(i);
+    fwh[nfwh++].col = FWCOL(i);
+}
+
+/*
+ * The last word of the escape sequence whose ESC is at p in a string
+ * body, or the end of the body: \(xx, \fx and \f(xx are taken whole
+ */
+static int fwesc(int p) {
+    int c, n;
+
+    if ((c = rbf0(p = incoff(p)) & CMASK) == '(')
+        n = 2;
+    else if (c == 'f')
+        n = ((rbf0(incoff(p)) & CMASK) == '(') ? 3 : 1;
+    else
+        n = 0;
+    for (; (n > 0) && rbf0(p); n--)
+        p = incoff(p);
+    return (p);
+}
+
+/* The value of entry k now, in its columns at v */
+static void fwvalue(int k, char *v) {
+    char s[FWMAX + 1], nm[3], msg[96];
+    int *q, c, n, p, w, slot;
+
+    n = 0;
+    w = fwtab[k].width;
+    if (fwtab[k].reg) {
+        for (q = nrchars(fwtab[k].name); (c = *q) != 0; q++)
+            if (!(c & MOT) && ((c &= CMASK) >= 040) && (c < 0177) && (n++ < w))
+                s[n - 1] = (char)c;
+    } else if (((slot = findmn(fwtab[k].name)) >= 0) && (contab[slot].rq & MMASK)) {
+        for (p = contab[slot].f.offset; (c = rbf0(p)) != 0; p = incoff(p)) {
+            if (c & MOT)
+                continue;
+            if ((c &= CMASK) == ESC) {
+                if (rbf0(p = fwesc(p)) == 0)
+                    break;
+                continue;
+            }
+            if ((c >= 040) && (c < 0177) && (n++ < w))
+                s[n - 1] = (char)c;
+        }
+    }
+    if (n > w) {
+        nm[0] = (char)(fwtab[k].name & BMASK);
+        nm[1] = (char)((fwtab[k].name >> BYTE) & BMASK);
+        nm[2] = 0;
+        snprintf(msg, sizeof(msg), "Forward reference %s wider than its %d columns.\n", nm, w);
+        prstr(msg);
+        n = w;
+    }
+    memset(v, ' ', w);
+    memcpy(v + (fwtab[k].reg ? w - n : 0), s, n);
+}
+
+/* Write every column put out in, and let the output go */
+void fwdone(void) {
+    static int busy;
+    char *b, *v;
+    size_t n;
+    long j;
+    int k;
+
+    if (!nfwh || busy)
+        return; /* or done3() from within the release */
+    busy = 1;
+    b = obheld(&n);
+    if ((v = OSA_MALLOC((size_t)nfw * FWMAX)) == NULL) {
+        prstr("Out of memory for forward references.\n");
+    } else {
+        for (k = 0; k < nfw; k++)
+            fwvalue(k, v + k * FWMAX);
+        for (j = 0; j < nfwh; j++)
+            if ((fwh[j].at < (long)n) && (fwh[j].id < nfw) &&
+                (fwh[j].col < fwtab[fwh[j].id].width))
+                b[fwh[j].at] = v[fwh[j].id * FWMAX + fwh[j].col];
+        OSA_FREE(v);
+    }
+    obrelease();
+    nfwh = 0;
+    busy = 0;
+}
+
+/* .fs xx n and .fn xx n */
+static void fwdecl(int reg) {
+    register int i, j, k;
+    unsigned h;
+
+    if (ipflg || skip() || !(i = getrq()) || skip())
+        return;
+    noscale++;
+    j = tatoi();
+    noscale = 0;
+    if (nonumb || (j < 1) || (j > FWMAX))
+        return;
+    if ((k = fwfind(i, reg)) < 0) {
+        if ((nfw >= NFW) || ((nfw >= nfwmax) && (fwroom(nfwmax ? 2 * nfwmax : 16) < 0))) {
+            prstr("Too many forward references.\n");
+            return;
+        }
+        k = nfw++;
+        fwtab[k].name = i;
+        fwtab[k].reg = reg;
+        if (fwhashn == k) { /* add it to the hash as it stands */
+            for (h = fwslot(i, reg); fwhash[h]; h = (h + 1) & (FWHASH - 1))
+                ;
+            fwhash[h] = (short)nfw;
+            fwhashn = nfw;
+        }
+    }
+    fwtab[k].width = j;
+}
+
+/* Declare a string given later */
+void casefs(void) {
+    fwdecl(0);
+}
+
+/* Declare a number register given later */
+void casefn(void) {
+    fwdecl(1);
+}
@@ -0,0 +1,34 @@
+/* C17 - no scaffold needed */
+/*
+ * fwref.h - Forward references, strings and registers given later
+ *
+ * A forward reference interpolates as FWHOLE characters, one for each
+ * of its columns, which carry the entry of fwtab and the column in the
+ * bits above those of a character.  ptout1() marks each one where it is
+ * put out, and fwdone() writes the final values in at the end.
+ */
+
+#ifndef FWREF_H
+#define FWREF_H
+
+#define FWMAX 16 /* widest forward reference, in columns */
+#define NFW 2048 /* forward references one document may declare */
+#define FWID(i) (((i) >> 16) & (NFW - 1))
+#define FWCOL(i) (((i) >> 27) & (FWMAX - 1))
+
+/* A name declared by .fs or .fn */
+struct fwent {
+    int name;
+    int reg; /* a number register, not a string */
+    int width; /* columns */
+};
+
+extern struct fwent *fwtab;
+extern int nfw;
+
+int fwroom(int n);
+int fwtext(int name, int reg);
+void fwmark(int i);
+void fwdone(void);
+
+#endif /* FWREF_H */
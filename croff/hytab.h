@@ -11,38 +11,24 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "core/hyphenation.h"
+
 /*
  * Table size constants
  */
-#define BXH_SIZE 13        /* Beginning + character table size */
-#define MATRIX_SIZE 676    /* 26x26 character matrix (ALPHABET_SIZE^2) */
 #define ALPHABET_SIZE 26   /* English alphabet size */
 
 /*
  * Hyphenation weight type
- * Signed 8-bit value representing hyphenation probability
- * Positive values encourage hyphenation, negative discourage
- */
-typedef int8_t hyphen_weight_t;
-
-/*
- * Hyphenation table declarations
- * These are defined in hytab.c
+ * A single table weight is 0-15; the goodness of a break, the product
+ * of three of them, reaches 3375
  */
-extern char bxh[BXH_SIZE];       /* Beginning + character sequences */
-extern char hxx[MATRIX_SIZE];    /* General character pairs */
-extern char bxxh[MATRIX_SIZE];   /* Character + end sequences */
-extern char xhx[MATRIX_SIZE];    /* Mixed sequences with context */
-extern char xxh[MATRIX_SIZE];    /* Fallback character + end */
+typedef int hyphen_weight_t;
 
 /*
- * Table access helper macros
- * Convert character pairs to table indices
+ * The tables themselves live in src/core/digram.c, shared with roff
+ * and the croff hyphenator; these accessors read them one pair at a time.
  */
-#define HXX_INDEX(first, second)  ((first) * ALPHABET_SIZE + (second))
-#define BXXH_INDEX(first, second) ((first) * ALPHABET_SIZE + (second))
-#define XHX_INDEX(first, second)  ((first) * ALPHABET_SIZE + (second))
-#define XXH_INDEX(first, second)  ((first) * ALPHABET_SIZE + (second))
 
 /*
  * Character to index conversion (a=0, b=1, ..., z=25)
@@ -70,23 +56,16 @@ static inline int char_to_index(char c) {
  * @return Hyphenation weight, or 0 if indices invalid
  */
 static inline hyphen_weight_t get_digram_weight(int first, int second) {
-    if (first < 0 || first >= ALPHABET_SIZE ||
-        second < 0 || second >= ALPHABET_SIZE) {
-        return 0;
-    }
-    return (hyphen_weight_t)hxx[HXX_INDEX(first, second)];
+    return otroff_digram_weight(OTROFF_DIG_HXX, first, second);
 }
 
 /**
  * Get beginning context weight
- * @param char_idx Character index (0-12, limited to BXH_SIZE)
+ * @param char_idx Character index (0-25)
  * @return Hyphenation weight for word-beginning context
  */
 static inline hyphen_weight_t get_beginning_weight(int char_idx) {
-    if (char_idx < 0 || char_idx >= BXH_SIZE) {
-        return 0;
-    }
-    return (hyphen_weight_t)bxh[char_idx];
+    return otroff_digram_weight(OTROFF_DIG_BXH, 0, char_idx);
 }
 
 /**
@@ -96,11 +75,7 @@ static inline hyphen_weight_t get_beginning_weight(int char_idx) {
  * @return Hyphenation weight for word-ending context
  */
 static inline hyphen_weight_t get_ending_weight(int first, int second) {
-    if (first < 0 || first >= ALPHABET_SIZE ||
-        second < 0 || second >= ALPHABET_SIZE) {
-        return 0;
-    }
-    return (hyphen_weight_t)bxxh[BXXH_INDEX(first, second)];
+    return otroff_digram_weight(OTROFF_DIG_BXXH, first, second);
 }
 
 /**
@@ -110,11 +85,7 @@ static inline hyphen_weight_t get_ending_weight(int first, int second) {
  * @return Hyphenation weight with context
  */
 static inline hyphen_weight_t get_context_weight(int first, int second) {
-    if (first < 0 || first >= ALPHABET_SIZE ||
-        second < 0 || second >= ALPHABET_SIZE) {
-        return 0;
-    }
-    return (hyphen_weight_t)xhx[XHX_INDEX(first, second)];
+    return otroff_digram_weight(OTROFF_DIG_XHX, first, second);
 }
 
 /**
@@ -124,15 +95,14 @@ static inline hyphen_weight_t get_context_weight(int first, int second) {
  * @return Fallback hyphenation weight
  */
 static inline hyphen_weight_t get_fallback_weight(int first, int second) {
-    if (first < 0 || first >= ALPHABET_SIZE ||
-        second < 0 || second >= ALPHABET_SIZE) {
-        return 0;
-    }
-    return (hyphen_weight_t)xxh[XXH_INDEX(first, second)];
+    return otroff_digram_weight(OTROFF_DIG_XXH, first, second);
 }
 
 /**
  * Calculate hyphenation weight for a position in a word
+ * The weight is the digram score of a break before word[position], as
+ * troff computes it; the context flags are accepted for compatibility
+ * and no longer change it.
  * @param word Pointer to word string
  * @param word_len Length of word
  * @param position Position to evaluate (0-based)
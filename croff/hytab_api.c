@@ -2,7 +2,7 @@
  * hytab_api.c - Hyphenation API Implementation (Pure C17)
  *
  * Implements hyphenation weight calculation functions
- * using the hyphenation digram tables
+ * using the shared digram engine of src/core/digram.c
  */
 
 #include "hytab.h"
@@ -19,44 +19,23 @@ hyphen_weight_t calculate_hyphen_weight(
     int at_ending,
     int has_context
 ) {
-    if (!word || position == 0 || position >= word_len) {
-        return 0;
-    }
+    int score[OTROFF_MAX_WORD_LENGTH];
 
-    /* Get character indices */
-    int left_idx = char_to_index(word[position - 1]);
-    int right_idx = char_to_index(word[position]);
-
-    if (left_idx < 0 || right_idx < 0) {
-        return 0; /* Non-alphabetic characters */
-    }
+    (void)at_beginning;
+    (void)at_ending;
+    (void)has_context;
 
-    hyphen_weight_t total_weight = 0;
-
-    /* Primary digram weight */
-    total_weight += get_digram_weight(left_idx, right_idx);
-
-    /* Beginning context (position 1) */
-    if (at_beginning && position == 1) {
-        total_weight += get_beginning_weight(right_idx);
-    }
-
-    /* Ending context */
-    if (at_ending) {
-        total_weight += get_ending_weight(left_idx, right_idx);
-    }
-
-    /* Mixed context (existing hyphens nearby) */
-    if (has_context) {
-        total_weight += get_context_weight(left_idx, right_idx);
+    if (!word || position == 0 || position >= word_len ||
+        word_len > OTROFF_MAX_WORD_LENGTH) {
+        return 0;
     }
 
-    /* Fallback for uncertain cases */
-    if (total_weight == 0) {
-        total_weight = get_fallback_weight(left_idx, right_idx);
+    /* Score every break of the word at once and pick this one */
+    if (otroff_digram_scores(word, word_len, score) < 0) {
+        return 0; /* Non-alphabetic characters */
     }
 
-    return total_weight;
+    return score[position];
 }
 
 /**
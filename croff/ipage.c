@@ -0,0 +1,148 @@
+/* C17 - no scaffold needed */
+/*
+ * ipage.c - Intermediate page output for croff -I
+ *
+ * With -I, the terminal driver entry points in n10.c hand everything
+ * here instead, and it is written through oput() in the format of
+ * ipage.h.  Nothing here knows the device beyond the metrics the lines
+ * were filled with; crender does the rest.
+ *
+ * The formatter sets lead and esc directly (the trailer, .po); they
+ * are passed on as IP_LEAD and IP_ESC the next time anything is
+ * written, and cleared.
+ */
+#include "tdef.h"
+#include "env.h"
+#include "ipage.h"
+
+#ifndef TWSTATE
+#define TWSTATE /* as in n10.c */
+#endif
+
+extern TWSTATE int lss;
+extern TWSTATE int lead;
+extern TWSTATE int esc;
+extern TWSTATE int ulfont;
+extern TWSTATE struct env *dip;
+
+void oput(int c);
+void oputn(const char *s, int n);
+void flusho(void);
+
+void ipout(int i);
+void iplead(void);
+void ipstop(void);
+void ipdone(void);
+void ippage(int pn);
+
+int ipflg; /* -I: intermediate pages instead of device output */
+
+static int iphdr; /* header written */
+static int ipfont; /* font and size of the last glyph written */
+static int ipsize;
+static int ipul = -1; /* underline font last written */
+
+static void ipnum(unsigned long n) {
+    while (n >= 0200) {
+        oput((int)(n & 0177) | 0200);
+        n >>= 7;
+    }
+    oput((int)n);
+}
+
+static void ipsnum(long n) {
+    ipnum(n < 0 ? ((unsigned long)~n << 1) | 1 : (unsigned long)n << 1);
+}
+
+static void iprec(int tag, long n) {
+    oput(tag);
+    ipsnum(n);
+}
+
+/* Header on first use, then whatever the formatter changed behind us */
+static void ipsync(void) {
+    if (!iphdr) {
+        oputn(IP_MAGIC, 4);
+        ipnum(IP_VERSION);
+        ipnum((unsigned long)t.Hor);
+        ipnum((unsigned long)t.Vert);
+        ipnum((unsigned long)t.Newline);
+        ipnum((unsigned long)t.Char);
+        ipnum((unsigned long)t.Em);
+        ipnum((unsigned long)t.Halfline);
+        ipnum((unsigned long)t.Adj);
+        iphdr = 1;
+    }
+    if (lead) {
+        iprec(IP_LEAD, lead);
+        lead = 0;
+    }
+    if (esc) {
+        iprec(IP_ESC, esc);
+        esc = 0;
+    }
+    if (ulfont != ipul) {
+        iprec(IP_UL, ulfont);
+        ipul = ulfont;
+    }
+}
+
+/* ptout() */
+void ipout(int i) {
+    int j, k;
+
+    ipsync();
+    if (i & MOT) {
+        j = i & ~MOTV;
+        iprec((i & VMOT) ? IP_VMOT : IP_HMOT, (i & NMOT) ? -j : j);
+        return;
+    }
+    k = i & CMASK;
+    if (k == '\n') {
+        oput(IP_NL);
+        ipsnum(dip->blss + lss);
+        ipsnum(dip->alss);
+        dip->blss = dip->alss = 0; /* as ptout() does */
+        return;
+    }
+    if (k < 040)
+        return; /* the driver prints nothing for these */
+    if (((i >> 9) & 03) != ipfont) {
+        ipfont = (i >> 9) & 03;
+        iprec(IP_FONT, ipfont);
+    }
+    if (((i >> 11) & 017) != ipsize) {
+        ipsize = (i >> 11) & 017;
+        iprec(IP_SIZE, ipsize);
+    }
+    for (j = (k < 0370 && RUNN(i)) ? RUNN(i) : 1; j > 0; j--) { /* a run, glyph by glyph */
+        if (i & ZBIT)
+            oput(IP_ZGLYPH);
+        oput(k);
+    }
+}
+
+/* ptlead() */
+void iplead(void) {
+    ipsync();
+    oput(IP_FLUSH);
+}
+
+/* dostop() */
+void ipstop(void) {
+    ipsync();
+    oput(IP_STOP);
+}
+
+/* A new page, numbered pn, begins */
+void ippage(int pn) {
+    ipsync();
+    iprec(IP_PAGE, pn);
+}
+
+/* twdone() */
+void ipdone(void) {
+    ipsync();
+    oput(IP_END);
+    flusho();
+}
@@ -0,0 +1,41 @@
+/* C17 - no scaffold needed */
+/*
+ * ipage.h - Intermediate page stream written by croff -I
+ *
+ * croff -I writes what it would hand to the terminal driver instead of
+ * driving the terminal: glyphs, motions, font and size changes and
+ * newlines, with a record at the top of every page.  crender turns the
+ * stream into output for a terminal, rendering pages in parallel.
+ *
+ * The stream is IP_MAGIC, then the varints IP_VERSION, Hor, Vert,
+ * Newline, Char, Em, Halfline and Adj of the table it was formatted
+ * for, then records.  A record is a byte: 040 to 0377 is a glyph of
+ * that code, anything lower one of the IP_ tags below followed by its
+ * operands.  Numbers are unsigned LEB128 varints; signed ones are
+ * zigzag-coded first.  A renderer must use a table of the same metrics,
+ * as the lines were filled with its widths.
+ */
+#ifndef IPAGE_H
+#define IPAGE_H
+
+#define IP_MAGIC "nrIP"
+#define IP_VERSION 1
+#define IP_NHDR 7 /* metrics in the header */
+
+enum {
+    IP_NL = 1, /* newline: space before (blss + lss), space after (alss) */
+    IP_HMOT, /* horizontal motion, signed */
+    IP_VMOT, /* vertical motion, signed */
+    IP_ZGLYPH, /* zero-width glyph: its code */
+    IP_FONT, /* font for the glyphs that follow: 0-3 */
+    IP_SIZE, /* size bits for the glyphs that follow: 0-15 */
+    IP_UL, /* underline font */
+    IP_LEAD, /* add to the pending vertical motion, signed */
+    IP_ESC, /* add to the pending horizontal motion, signed */
+    IP_FLUSH, /* make the pending motion (ptlead) */
+    IP_PAGE, /* a page starts: its number */
+    IP_STOP, /* a .rd or -s stop */
+    IP_END /* end of output */
+};
+
+#endif /* IPAGE_H */
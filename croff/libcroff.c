@@ -0,0 +1,213 @@
+/* C17 - no scaffold needed */
+/*
+ * libcroff.c - croff as a library: one formatter per context
+ *
+ * Each context forks a child that runs croff's main() (n1.c built as
+ * croff_main()) on the state the library was loaded with, its standard
+ * input and output both one end of a socket pair.  The caller keeps
+ * the other end, non-blocking: croff_feed() sends, and takes in any
+ * output that is ready while the send waits, so a formatter that
+ * writes while it reads cannot stall it.  A socket rather than pipes
+ * lets croff_end() shut down only the input, and lets croff_feed() send
+ * with MSG_NOSIGNAL, so a formatter that exits early is an EPIPE and
+ * not a signal in the caller.
+ */
+
+#include "libcroff.h"
+#define OSA_TAG "croff.lib"
+#include "os/os_acct.h" /* OSA_MALLOC, OSA_CALLOC, OSA_REALLOC, ... */
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#define LCOUT 65536 /* first size of the output kept for croff_take() */
+
+int croff_main(int argc, char *argv[]);
+
+struct croff {
+    pid_t pid; /* the formatter */
+    int fd; /* our end of its input and output */
+    int ended; /* croff_end() has been called */
+    int eof; /* all the output is in */
+    char *out; /* output not yet taken: out[outoff..nout) */
+    size_t outoff, nout, cap;
+};
+
+/* In the child: every descriptor but 0, 1 and 2 belongs to the caller */
+static void lcclose(void) {
+    long k, max;
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34))
+    if (close_range(3, ~0U, 0) == 0)
+        return;
+#endif
+    if ((max = sysconf(_SC_OPEN_MAX)) < 0 || max > 65536)
+        max = 65536;
+    for (k = 3; k < max; k++)
+        close((int)k);
+}
+
+croff_t *croff_init(int argc, char **argv) {
+    croff_t *f;
+    char **cargv;
+    sigset_t all;
+    int sv[2], k;
+
+    if (argc < 0) {
+        errno = EINVAL;
+        return (NULL);
+    }
+    if ((f = OSA_CALLOC(1, sizeof(*f))) == NULL)
+        return (NULL);
+    if ((cargv = OSA_MALLOC((size_t)(argc + 2) * sizeof(*cargv))) == NULL) {
+        OSA_FREE(f);
+        return (NULL);
+    }
+    cargv[0] = "croff";
+    for (k = 0; k < argc; k++)
+        cargv[k + 1] = argv[k];
+    cargv[argc + 1] = NULL;
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv) < 0)
+        goto fail;
+    fflush(NULL); /* or the child would write what stdio holds again */
+    if ((f->pid = fork()) < 0) {
+        close(sv[0]);
+        close(sv[1]);
+        goto fail;
+    }
+    if (f->pid == 0) {
+        if (dup2(sv[1], 0) < 0 || dup2(sv[1], 1) < 0)
+            _exit(02);
+        lcclose();
+        sigemptyset(&all);
+        sigprocmask(SIG_SETMASK, &all, NULL); /* the caller's thread may block some */
+        _exit(croff_main(argc + 1, cargv));
+    }
+    OSA_FREE(cargv);
+    close(sv[1]);
+    f->fd = sv[0];
+    fcntl(f->fd, F_SETFL, fcntl(f->fd, F_GETFL) | O_NONBLOCK);
+    return (f);
+
+fail:
+    k = errno;
+    OSA_FREE(cargv);
+    OSA_FREE(f);
+    errno = k;
+    return (NULL);
+}
+
+/* Take in what output is ready; -1 on error */
+static int lcread(croff_t *f) {
+    char *p;
+    ssize_t r;
+
+    for (;;) {
+        if (f->outoff == f->nout)
+            f->outoff = f->nout = 0;
+        if (f->nout == f->cap) {
+            if ((p = OSA_REALLOC(f->out, f->cap ? 2 * f->cap : LCOUT)) == NULL)
+                return (-1);
+            f->out = p;
+            f->cap = f->cap ? 2 * f->cap : LCOUT;
+        }
+        if ((r = recv(f->fd, f->out + f->nout, f->cap - f->nout, MSG_DONTWAIT)) > 0)
+            f->nout += (size_t)r;
+        else if (r == 0 || errno == ECONNRESET) { /* reset: it exited with input unread */
+            f->eof = 1;
+            return (0);
+        } else if (errno == EINTR)
+            continue;
+        else
+            return ((errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1);
+    }
+}
+
+int croff_feed(croff_t *f, const void *buf, size_t n) {
+    const char *s = buf;
+    struct pollfd p;
+    ssize_t r;
+
+    if (f->ended) {
+        errno = EPIPE;
+        return (-1);
+    }
+    while (n > 0) {
+        p.fd = f->fd;
+        p.events = POLLOUT | (f->eof ? 0 : POLLIN);
+        if (poll(&p, 1, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            return (-1);
+        }
+        if ((p.revents & (POLLIN | POLLHUP)) && !f->eof && lcread(f) < 0)
+            return (-1);
+        if (!(p.revents & (POLLOUT | POLLERR)))
+            continue;
+        if ((r = send(f->fd, s, n, MSG_DONTWAIT | MSG_NOSIGNAL)) > 0) {
+            s += r;
+            n -= (size_t)r;
+        } else if (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            return (-1); /* EPIPE: the formatter has stopped reading */
+    }
+    return (0);
+}
+
+int croff_end(croff_t *f) {
+    if (f->ended)
+        return (0);
+    f->ended = 1;
+    return (shutdown(f->fd, SHUT_WR));
+}
+
+ssize_t croff_take(croff_t *f, void *buf, size_t n) {
+    struct pollfd p;
+
+    while (f->outoff == f->nout && !f->eof) {
+        if (lcread(f) < 0)
+            return (-1);
+        if (f->outoff < f->nout || f->eof)
+            break;
+        if (!f->ended) {
+            errno = EAGAIN;
+            return (-1);
+        }
+        p.fd = f->fd;
+        p.events = POLLIN;
+        if (poll(&p, 1, -1) < 0 && errno != EINTR)
+            return (-1);
+    }
+    if (n > f->nout - f->outoff)
+        n = f->nout - f->outoff;
+    memcpy(buf, f->out + f->outoff, n);
+    f->outoff += n;
+    return ((ssize_t)n);
+}
+
+int croff_free(croff_t *f) {
+    char skip[4096];
+    int status;
+
+    if (!f->ended)
+        kill(f->pid, SIGKILL); /* the document will not be finished */
+    else
+        while (croff_take(f, skip, sizeof(skip)) > 0)
+            ; /* output not taken: let the formatter write it all */
+    close(f->fd);
+    while (waitpid(f->pid, &status, 0) < 0)
+        if (errno != EINTR) {
+            status = -1;
+            break;
+        }
+    OSA_FREE(f->out);
+    OSA_FREE(f);
+    return ((status != -1 && WIFEXITED(status)) ? WEXITSTATUS(status) : -1);
+}
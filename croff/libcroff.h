@@ -0,0 +1,63 @@
+/* C17 - no scaffold needed */
+/*
+ * libcroff.h - croff as a library: one formatter per context
+ *
+ * croff keeps its state in globals, so a context is a formatter of its
+ * own in a child process, started from the untouched state of the
+ * library as -B starts each document (batch.c).  Contexts share
+ * nothing and may be driven from different threads at once; a single
+ * context is driven by one thread at a time.
+ *
+ *   croff_t *f = croff_init(1, (char *[]){"-Tvt100", NULL});
+ *   croff_feed(f, text, len);
+ *   croff_end(f);
+ *   while ((n = croff_take(f, buf, sizeof(buf))) > 0)
+ *       use(buf, n);
+ *   status = croff_free(f);
+ *
+ * The child writes its diagnostics to the caller's standard error, and
+ * when the formatter exits it runs the atexit() handlers the caller had
+ * registered before croff_init().
+ */
+
+#ifndef LIBCROFF_H
+#define LIBCROFF_H
+
+#include <stddef.h>
+#include <sys/types.h>
+
+typedef struct croff croff_t;
+
+/*
+ * Start a formatter with croff's options (no files, no argv[0]); NULL
+ * with errno set if it cannot be started.  The input is what
+ * croff_feed() gives it, read as croff reads its standard input.
+ */
+croff_t *croff_init(int argc, char **argv);
+
+/*
+ * Give the formatter n more bytes of input.  Output that the formatter
+ * writes while it reads is kept for croff_take(), so feeding never
+ * waits on a caller that has not taken it.  0, or -1 with errno set.
+ */
+int croff_feed(croff_t *f, const void *buf, size_t n);
+
+/* No more input: the formatter finishes the document.  0 or -1. */
+int croff_end(croff_t *f);
+
+/*
+ * Up to n bytes of output.  After croff_end() waits for output and
+ * returns 0 once the formatter has written all of it; before, returns
+ * -1 with errno EAGAIN if there is none yet.  -1 with errno set on
+ * error.
+ */
+ssize_t croff_take(croff_t *f, void *buf, size_t n);
+
+/*
+ * Free the context.  After croff_end() waits for the formatter to
+ * finish, throwing away any output not taken; before, kills it.
+ * Returns its exit status, or -1 if it was killed or lost.
+ */
+int croff_free(croff_t *f);
+
+#endif /* LIBCROFF_H */
@@ -0,0 +1,80 @@
+/* C17 - no scaffold needed */
+/*
+ * memuse.c - Memory footprint report for -M
+ *
+ * croff_memrep() fills an otroff_memrep_t (src/core/memrep.h) with the
+ * large static buffers, the macro block store and the output ring, the
+ * size of the temporary file ibf, and what the process as a whole has
+ * on the heap and resident.  A program that links croff can call it at
+ * any time.  With -M the report is printed to stderr at exit, after
+ * the -S profile.
+ */
+
+#include "tdef.h" // troff definitions
+#include "env.h" // diversion environment blocks
+#include "troff_processor.h" // processor state
+#include "core/blkstore.h" // macro block store
+#include "core/memrep.h" // the report
+
+#include <stdio.h>
+#include <sys/stat.h>
+
+extern int cbuf[NC];
+extern int oline[LNSIZE + 1];
+extern int line[LNSIZE];
+extern int linew[LNSIZE];
+extern int word[WDSIZE];
+extern int wdpre[WDSIZE];
+extern int *hyptr[NHYP];
+extern char ibuf[IBUFSZ];
+extern char xbuf[IBUFSZ];
+extern char obuf[OBUFSZ];
+extern struct env d[NDI];
+extern int ibf;
+
+const otroff_blkstore_t *mstorep(void);
+size_t obbytes(void);
+
+int memon; /* -M given */
+
+int croff_memrep(otroff_memrep_t *m);
+void memreport(void);
+
+/* Fill in m for croff as it stands; 0 */
+int croff_memrep(otroff_memrep_t *m) {
+    const otroff_blkstore_t *st;
+    size_t blk = BLK * sizeof(int);
+    struct stat sb;
+
+    otroff_memrep_init(m, "croff");
+    otroff_memrep_buf(m, "cbuf", sizeof(cbuf));
+    otroff_memrep_buf(m, "oline", sizeof(oline));
+    otroff_memrep_buf(m, "line", sizeof(line));
+    otroff_memrep_buf(m, "linew", sizeof(linew));
+    otroff_memrep_buf(m, "word", sizeof(word));
+    otroff_memrep_buf(m, "wdpre", sizeof(wdpre));
+    otroff_memrep_buf(m, "hyptr", sizeof(hyptr));
+    otroff_memrep_buf(m, "ibuf", sizeof(ibuf));
+    otroff_memrep_buf(m, "xbuf", sizeof(xbuf));
+    otroff_memrep_buf(m, "obuf", sizeof(obuf));
+    otroff_memrep_buf(m, "d", sizeof(d));
+    otroff_memrep_buf(m, "g_processor", sizeof(g_processor));
+
+    if ((st = mstorep()) != NULL)
+        otroff_memrep_arena(m, st->resident * blk, st->stats.resident_peak * blk);
+    otroff_memrep_arena(m, obbytes(), obbytes());
+    if (ibf >= 0 && fstat(ibf, &sb) == 0)
+        m->temp_bytes = (size_t)sb.st_size;
+    otroff_memrep_sample(m);
+    return (0);
+}
+
+/* Print the report for -M */
+void memreport(void) {
+    otroff_memrep_t m;
+
+    if (!memon)
+        return;
+    croff_memrep(&m);
+    otroff_memrep_print(&m, stderr);
+}
@@ -0,0 +1,92 @@
+/* C17 - no scaffold needed */
+/*
+ * mkchtab.c - Build the special character hash at compile time
+ *
+ * Reads chtab from ntab.c and writes chtab_hash.h, the tables setch()
+ * and ascii mode look names and codes up in, defined in ntab.c and
+ * declared for everyone else:
+ *
+ *     mkchtab > chtab_hash.h
+ *
+ * The hash of a name is its product with a multiplier, top bits taken,
+ * and the multiplier is searched for, from a fixed start, until no two
+ * names share a slot.  A lookup is then one multiply and one compare.
+ * Where chtab gives a name twice, the first is kept, as the scan of
+ * setch() found it.  chrev[] holds, for each code, the first name that
+ * gives it, which is the \(xx ascii mode writes for it.
+ */
+
+#define MKCHTAB /* ntab.c without the tables made from it */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "ntab.c"
+
+#define CHBITS 10 /* 1024 slots */
+#define CHSLOTS (1 << CHBITS)
+
+static int slot[CHSLOTS], code[CHSLOTS];
+static int rev[256];
+
+static unsigned hash(uint32_t mul, int name) {
+    return ((uint32_t)name * mul) >> (32 - CHBITS);
+}
+
+int main(void) {
+    uint64_t x = 0x9e3779b97f4a7c15u;
+    uint32_t mul = 0;
+    unsigned h;
+    int *k, n, tries, ok, j;
+
+    for (n = 0; chtab[2 * n] != 0; n++)
+        ;
+    for (tries = 1; tries < 1000000; tries++) {
+        x ^= x << 13, x ^= x >> 7, x ^= x << 17; /* xorshift from a fixed seed */
+        mul = (uint32_t)x | 1;
+        for (h = 0; h < CHSLOTS; h++)
+            slot[h] = 0;
+        for (ok = 1, k = chtab; ok && *k != 0; k += 2) {
+            h = hash(mul, *k);
+            if (slot[h] == *k)
+                continue; /* a name given again */
+            if (slot[h] != 0)
+                ok = 0;
+            slot[h] = *k;
+            code[h] = k[1];
+        }
+        if (ok)
+            break;
+    }
+    if (!ok) {
+        fprintf(stderr, "mkchtab: no multiplier found\n");
+        return 1;
+    }
+    for (k = chtab; *k != 0; k += 2)
+        if ((j = k[1]) >= 0 && j < 256 && !rev[j])
+            rev[j] = *k;
+
+    printf("/* chtab_hash.h - generated by mkchtab from ntab.c; do not edit */\n\n");
+    printf("/* %d names in %d slots, multiplier found in %d tries */\n", n, CHSLOTS, tries);
+    printf("#define CHHASH_MUL 0x%08xu\n", (unsigned)mul);
+    printf("#define CHHASH_BITS %d\n", CHBITS);
+    printf("#define CHHASH(name) (((unsigned)(name) * CHHASH_MUL) >> (32 - CHHASH_BITS))\n\n");
+    printf("/* The name in each slot, 0 if none, and the code it gives */\n");
+    printf("extern const int chhname[%d];\n", CHSLOTS);
+    printf("extern const short chhcode[%d];\n", CHSLOTS);
+    printf("/* The first name giving each code, 0 if none */\n");
+    printf("extern const int chrev[256];\n\n");
+    printf("#ifdef CHTAB_TABLES /* ntab.c */\n");
+    printf("const int chhname[%d] = {", CHSLOTS);
+    for (h = 0; h < CHSLOTS; h++)
+        printf("%s%#x,", h % 8 ? " " : "\n    ", (unsigned)slot[h]);
+    printf("\n};\n\nconst short chhcode[%d] = {", CHSLOTS);
+    for (h = 0; h < CHSLOTS; h++)
+        printf("%s%#o,", h % 8 ? " " : "\n    ", slot[h] ? (unsigned)code[h] : 0u);
+    printf("\n};\n\nconst int chrev[256] = {");
+    for (j = 0; j < 256; j++)
+        printf("%s%#x,", j % 8 ? " " : "\n    ", (unsigned)rev[j]);
+    printf("\n};\n#endif\n");
+    return 0;
+}
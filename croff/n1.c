@@ -64,6 +64,13 @@
 #include "t.h" // common troff header
 #include "tw.h" // typewriter table
 #include "troff_processor.h" // processor state
+#include "trace.h" // -Y event trace
+#include "caps.h" // -C resource caps
+#include "pgindex.h" // -X page index
+#include "segcache.h" // -R segment cache
+#include "pjob.h" // -J parallel segments
+#include "chtab_hash.h" // special character names, for UTF-8 input
+#include "diag.h" // -Q diagnostics
 
 #include <stdio.h> /* C90: standard I/O functions */
 #include <stdlib.h> /* C90: exit, malloc, etc. */
@@ -74,6 +81,11 @@
 #include <fcntl.h> /* POSIX: open flags */
 #include <sys/types.h> /* POSIX: system types */
 #include <sys/stat.h> /* POSIX: file status */
+#include "os/os_abstraction.h" /* os_map_file for regular input files */
+#define OSA_TAG "croff.input"
+#include "os/os_acct.h" // OSA_MALLOC, OSA_REALLOC, OSA_READ
+#include <limits.h> /* C90: INT_MAX */
+#include <stdint.h> /* C99: uint64_t */
 
 /* Function prototypes - C90 style (internal functions) */
 static void acctg(void);
@@ -81,6 +93,8 @@ static int getch0(void);
 static void catch (int signo);
 static void fpecatch(int signo);
 static void kcatch(int signo);
+static int mapin(void);
+static void unmapin(void);
 
 /* Local function prototypes */
 void init1(char a);
@@ -91,12 +105,21 @@ void mesg(int f);
 void prstrfl(const char *s);
 void prstr(const char *s);
 int control(int a, int b);
+static int ctlrun(int j, int b);
 int getrq(void);
 int getch(void);
+void getmap(void);
+int getrun(int *buf, int *wid, int n);
+int getcopy(int *buf, int n);
+int getskip(void);
+int getlook(int n);
+void getdrop(int n);
 void flushi(void);
 void casenx(void);
 int getname(void);
 void caseso(void);
+int soresume(int n, const int *fd, const int *off);
+int sodrop(void);
 void getpn(char *a);
 void setrpt(void);
 int nextfile(void);
@@ -105,6 +128,8 @@ int getach(void);
 
 /* External function prototypes */
 extern int findr(int c);
+extern int ctlget(int a, int *j);
+extern int *nrp(int j);
 extern void chkpn(void);
 extern int tatoi(void);
 extern long atoi1(void);
@@ -140,6 +165,10 @@ extern int makem(int w);
 extern int width(int c);
 extern int rdtty(void);
 extern int rbf(void);
+extern int rbs(void);
+extern int rbskip(void);
+extern int rbf0(int p);
+extern int incoff(int p);
 extern int skip(void);
 extern void done(int status);
 extern void done3(int status);
@@ -171,6 +200,7 @@ extern int stop; /* Stop flag */
 extern TroffProcessor g_processor; /* Shared processor state */
 extern int cbuf[NC]; /* Character buffer */
 extern int *cp; /* Character pointer */
+extern int *sp; /* Short string pointer */
 extern int *vlist; /* Variable list */
 extern int nx; /* Next flag */
 extern int mflg; /* Macro flag */
@@ -180,10 +210,6 @@ extern int pfrom; /* Print from page */
 extern int cps; /* Characters per second */
 extern int chbits; /* Character bits */
 extern int suffid; /* Suffix ID */
-extern int sufind[26]; /* Suffix index table */
-
-/* Table of offsets for each starting letter */
-extern const unsigned short suftab_index[26];
 
 extern int ibf; /* Input buffer file descriptor */
 extern int ttyod; /* TTY output descriptor */
@@ -216,7 +242,6 @@ extern int padc; /* Pad character */
 extern int tabc; /* Tab character */
 extern int dotc; /* Dot character */
 extern int raw; /* Raw mode flag */
-extern int tabtab[NTAB]; /* Tab table */
 extern char nextf[]; /* Next file name */
 extern int nfi; /* Next file index */
 
@@ -225,9 +250,10 @@ extern char termtab[]; /* Terminal table */
 extern int tti; /* Terminal table index */
 #endif
 
-extern int ifl[NSO]; /* Input file list */
-extern int offl[NSO]; /* Offset list */
-extern int ipl[NSO]; /* Input pointer list */
+extern int *ifl; /* Input file list */
+extern int *offl; /* Offset list */
+extern int *ipl; /* Input pointer list */
+extern int nso; /* Entries in ifl, offl and ipl */
 extern int ifi; /* Input file index */
 extern int pendt; /* Pending tab */
 extern int flss; /* Flush */
@@ -240,7 +266,8 @@ extern int pnlist[]; /* Page number list */
 extern int *pnp; /* Page number pointer */
 extern int nb; /* No break flag */
 extern int trap; /* Trap flag */
-extern int *litlev; /* Literal level */
+extern int litlev; /* Frame level of .li */
+extern int frlev; /* Current frame level */
 extern int tflg; /* Tab flag */
 extern int ejf; /* Eject flag */
 extern int *ejl; /* Eject level */
@@ -264,6 +291,39 @@ extern int eqflg; /* Equation flag */
 extern int no_out; /* No output flag */
 extern int hflg; /* H flag */
 extern int xxx; /* Temporary variable */
+extern int mspill; /* In-core macro blocks before spilling */
+extern int hcsize; /* Hyphenation cache slots */
+extern int obsize; /* Output ring size in kilobytes */
+extern int obdevwait; /* Seconds to wait for the device */
+extern int ipflg; /* -I: intermediate page output */
+extern void pmarg(const char *a);
+extern int hxload(const char *file);
+extern int hypat; /* Liang pattern hyphenation */
+extern char *snapdir; /* Macro package snapshot directory */
+extern char *bsuffix; /* -B: suffix of each output file */
+extern int bjobs; /* -j: batch documents at once */
+extern void bfork(void);
+extern char *dsock; /* -D: socket to serve jobs on */
+extern char *dpkg; /* -m: the package, for -D jobs */
+extern void dlimit(char *s);
+extern void dserve(void);
+extern void pfstart(const char *name); /* read the next file ahead */
+extern int pftake(const char *name);
+extern int snappend; /* Package snapshot state */
+extern int snapload(char *pkg);
+extern int snapsave(void);
+extern void snapso(const char *name);
+extern void evinit(void);
+extern void frreset(void);
+extern int profon; /* -S profile enabled */
+extern char *proffile; /* -S JSON output file */
+extern long long profnow(void);
+extern void profadd(int rq, long long ns);
+extern int ston; /* -Z start-up trace */
+extern void stphase(const char *name);
+extern void streport(void);
+extern void profpush(int rq, int lev);
+extern int memon; /* -M memory report */
 
 /* Path to the controlling terminal */
 char ttyx[] = "/dev/ttyx";
@@ -272,13 +332,16 @@ char ttyx[] = "/dev/ttyx";
 extern struct contab {
     int rq; /* Request code */
     int (*f)(void); /* Function pointer */
-} contab[NM];
+} *contab;
+extern int ncontab;
 
 /* Days per month, adjusted at runtime for leap years */
 int ms[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
 
 #ifndef NROFF
-int acctf; /* Accounting file descriptor */
+extern char *acctdir; /* -A<dir>: accounting spool (acct.c) */
+int acctopen(const char *name);
+int acctspool(void);
 static char Sccsid[] = "@(#)n1.c  1.7 of 4/26/77";
 #endif
 
@@ -298,7 +361,9 @@ static char Sccsid[] = "@(#)n1.c  1.7 of 4/26/77";
 int main(int argc, char *argv[]) {
     char *p, *q;
     register int i, j;
+    int p0, k;
 
+    stphase("main");
     /* Set up signal handlers */
     signal(SIGHUP, catch);
     if (signal(SIGINT, catch) == SIG_ERR) {
@@ -311,10 +376,13 @@ int main(int argc, char *argv[]) {
 
     /* Initialize based on program name */
     init1(argv[0][0]);
+    stphase("init1");
 
     /* Process command line options */
 options:
     while (--argc > 0 && (++argv)[0][0] == '-') {
+        pxarg(argv[0]);
+        sgarg(argv[0]);
         switch (argv[0][1]) {
         case 0:
             goto start;
@@ -336,7 +404,7 @@ options:
                 stop++;
             continue;
         case 'r': /* Set number register */
-            vlist[findr(argv[0][2])] = cnum(&argv[0][3]);
+            *nrp(findr(argv[0][2])) = cnum(&argv[0][3]);
             continue;
         case 'm': /* Macro file */
             p = &nextf[nfi];
@@ -344,10 +412,86 @@ options:
             while ((*p++ = *q++) != 0)
                 ;
             mflg++;
+            dpkg = &argv[0][2];
             continue;
         case 'o': /* Output page list */
             getpn(&argv[0][2]);
             continue;
+        case 'b': /* In-core macro block budget */
+            mspill = cnum(&argv[0][2]);
+            continue;
+        case 'H': /* Hyphenation cache slots */
+            hcsize = cnum(&argv[0][2]);
+            continue;
+#ifdef NROFF
+        case 'I': /* Intermediate pages for crender */
+            ipflg++;
+            continue;
+        case 'G': /* Pages held as a model: n-up, reversed */
+            pmarg(&argv[0][2]);
+            continue;
+#endif
+        case 'O': /* Output ring size in kilobytes */
+            obsize = cnum(&argv[0][2]);
+            continue;
+        case 'P': /* Pattern hyphenation */
+            hypat++;
+            continue;
+        case 'E': /* Hyphenation exception file */
+            if (hxload(&argv[0][2]) < 0) {
+                prstr("Cannot load ");
+                prstr(&argv[0][2]);
+                prstr("\n");
+            }
+            continue;
+        case 'K': /* Macro package snapshot directory */
+            snapdir = &argv[0][2];
+            continue;
+        case 'X': /* Page index for -o */
+            pxfile = &argv[0][2];
+            continue;
+        case 'J': /* Segments between checkpoints formatted at once */
+            pjarg(&argv[0][2]);
+            continue;
+        case 'R': /* Cache of formatted .so files */
+            sgdir = &argv[0][2];
+            continue;
+        case 'B': /* Batch: each file a document of its own */
+            bsuffix = &argv[0][2];
+            continue;
+        case 'j': /* Batch documents formatted at once */
+            bjobs = cnum(&argv[0][2]);
+            continue;
+        case 'D': /* Serve jobs on a Unix socket */
+            dsock = &argv[0][2];
+            continue;
+        case 'L': /* Limits of each -D job */
+            dlimit(&argv[0][2]);
+            continue;
+        case 'C': /* Caps on what a document may take */
+            capset(&argv[0][2]);
+            continue;
+        case 'S': /* Request and macro profile */
+            profon++;
+            proffile = &argv[0][2];
+            continue;
+        case 'M': /* Memory report */
+            memon++;
+            continue;
+        case 'Z': /* Start-up trace */
+            ston++;
+            continue;
+        case 'Q': /* Repeated diagnostics held back, JSON lines */
+            dgarg(&argv[0][2]);
+            continue;
+        case 'Y': /* Event trace */
+#ifdef CTRACE
+            tron++;
+            trfile = argv[0][2] ? &argv[0][2] : "croff.trace.json";
+#else
+            prstr("Not built with CTRACE: -Y ignored\n");
+#endif
+            continue;
 #ifdef NROFF
         case 'h': /* Hold output */
             hflg++;
@@ -382,10 +526,14 @@ options:
         case 'w': /* Wait for device */
             waitf++;
             continue;
+        case 'W': /* Seconds to wait for the device */
+            obdevwait = cnum(&argv[0][2]);
+            continue;
+        case 'A': /* Accounting spool directory */
+            acctdir = &argv[0][2];
+            continue;
         case 'f': /* Font mount */
             continue; /* Skip for now */
-        case 'S': /* Statistics */
-            continue; /* Skip for now */
 #endif
         default:
             prstr("Unknown option: ");
@@ -399,18 +547,41 @@ start:
     /* Initialize remaining argument processing */
     rargc = argc;
     argp = argv;
+    for (i = 0; i < argc; i++)
+        pxarg(argv[i]);
+    stphase("options");
 
     /* Complete initialization */
     init2();
+#ifndef NROFF
+    acctspool(); /* with -A, before -B or -D fork anything */
+#endif
+
+    /* Resume from the page index, or from a package snapshot */
+    if (pxload()) {
+        stphase("pgindex");
+    } else if (mflg && snapdir && snapload(nextf)) {
+        nx = mflg = 0;
+        stphase("snapshot");
+    }
+    streport();
 
     /* Main processing loop */
 loop:
-    if ((i = getch()) & MOT) {
+    PXPOINT();
+    SGPOINT();
+    /* Where a control character read straight from a macro comes from */
+    p0 = (ip > 0 && !ch && !ch0 && !nchar && !cp && !ap && !sp && !nlflg &&
+          !raw) ? ip : 0;
+    sgline = 1;
+    i = getch();
+    sgline = 0;
+    if (i & MOT) {
         goto loop;
     }
     if (pendt)
         goto lt;
-    if (lit && (frame <= litlev)) {
+    if (lit && (frlev <= litlev)) {
         lit--;
         goto lt;
     }
@@ -426,13 +597,18 @@ loop:
     if ((j == cc) || (j == c2)) {
         if (j == c2)
             nb++;
-        copyf++;
-        while (((j = ((i = getch()) & CMASK)) == ' ') ||
-               (j == '\t'))
-            ;
-        ch = i;
-        copyf--;
-        control(getrq(), 1);
+        if (p0 && ctlget(p0, &k) >= 0) {
+            if (k >= 0)
+                ctlrun(k, 1);
+        } else {
+            copyf++;
+            while (((j = ((i = getch()) & CMASK)) == ' ') ||
+                   (j == '\t'))
+                ;
+            ch = i;
+            copyf--;
+            control(getrq(), 1);
+        }
         flushi();
         goto loop;
     }
@@ -442,15 +618,19 @@ lt:
     goto loop;
 }
 /*
- * Signal handler for SIGHUP and SIGINT
+ * Signal handler for SIGHUP, SIGINT and SIGPIPE
  * 
- * Handles interrupt signals by calling the termination sequence.
+ * Handles interrupt signals by calling the termination sequence.  On
+ * SIGPIPE the reader has gone: no_out is set first, so that done3()
+ * neither queues more output nor waits for the output ring, which the
+ * write that raised the signal may have been in the middle of.
  * 
  * Parameters:
- *   signo - Signal number (unused but required by signal handler prototype)
+ *   signo - Signal number
  */
 static void catch (int signo) {
-    (void)signo; /* Suppress unused parameter warning */
+    if (signo == SIGPIPE)
+        no_out++;
     /* prstr("Interrupt\n"); */
     done3(01);
 }
@@ -491,62 +671,59 @@ kcatch(int signo) {
  * can be logged. Only used in the device independent version.
  */
 static void acctg(void) {
-    acctf = open("/usr/actg/data/troffactg", 1);
+    acctopen("/usr/actg/data/troffactg");
     setuid(getuid());
 }
 #endif
+/*
+ * Make the temp file behind ibf, the first time the macro store needs
+ * to spill a block.  mkstemp() gives a fresh name, unlinked straight
+ * away so nothing is left behind.  If no file can be made the store
+ * keeps every block in core.
+ *
+ * Returns:
+ *   The descriptor, or -1
+ */
+int ibfopen(void *arg) {
+    char tmp[] = "/tmp/taXXXXXX";
+
+    (void)arg;
+    if (ibf >= 0)
+        return (ibf);
+    if ((ibf = mkstemp(tmp)) < 0) {
+        prstr("Cannot create temp file; macros are kept in core.\n");
+        return (-1);
+    }
+    unlink(tmp);
+    return (ibf);
+}
 /*
  * Initialize temporary files and default tables. 
  * 
  * This function performs critical early initialization:
  * - Sets up accounting if running as TROFF
- * - Creates secure temporary files for internal buffering
+ * - Defers the temporary file until a macro block has to spill
  * - Initializes character translation tables
  * - Sets up suffix tables for macro processing
  * 
  * The argument indicates whether the program name started with 'a' (ASCII mode).
- * This affects temporary file naming and some initialization behaviors.
  * 
  * Parameters:
  *   a - First character of program name ('a' indicates ASCII mode)
  * 
  * Side effects:
- *   - Creates temporary file and stores descriptor in ibf
+ *   - Leaves ibf closed until the macro store first spills (ibfopen())
  *   - Initializes trtab[] character translation table
- *   - Copies suftab_index into sufind array
- *   - Sets unlkp for cleanup on exit
  */
 void init1(char a) {
-    register char *p;
     register int i;
 
 #ifndef NROFF
     acctg(); /* Open troff accounting file while setuid */
 #endif
 
-    /* Load suffix index table from the built-in array.
-     * The first 26 words hold offsets for each letter. */
-    memcpy(sufind, suftab_index, sizeof(sufind));
-
-    /* Create a temporary file using mkstemp for security.
-     * This prevents race conditions and ensures unique file names. */
-    static char tmp_template[] = "/tmp/taXXXXXX";
-    int fd = mkstemp(tmp_template);
-    if (fd < 0) {
-        prstr("Cannot create temp file.\n");
-        exit(-1);
-    }
-
-    /* Ensure the temporary file is deleted after use */
-    unlink(tmp_template);
-
-    /* Adjust filename based on ASCII mode */
-    p = tmp_template;
-    if (a == 'a')
-        p = &p[5];
-
-    /* Store the descriptor for later use */
-    ibf = fd;
+    /* No temp file yet: ibfopen() makes one if the macro store spills */
+    ibf = -1;
 
     /* Initialize character translation table.
      * Most characters translate to themselves. */
@@ -556,10 +733,8 @@ void init1(char a) {
 
     /* Initialize character bits and width tables */
     mchbits();
-
-    /* Set cleanup pointer for non-ASCII mode */
-    if (a != 'a')
-        unlkp = tmp_template;
+    getmap();
+    (void)a; /* the temp file is unlinked as soon as it is made */
 }
 /*
  * Perform runtime initialization after processing command line options.
@@ -579,7 +754,6 @@ void init1(char a) {
  */
 void init2(void) {
     register int i, j;
-    extern int block;
 
     /* Set up terminal output descriptor */
     ttyod = 2;
@@ -598,6 +772,7 @@ void init2(void) {
     /* Disable terminal messages in ASCII mode */
     if (ascii)
         mesg(0);
+    stphase("tty");
 
     /* Open phototypesetter device if needed */
     if ((!ptid) && (!waitf)) {
@@ -609,10 +784,11 @@ void init2(void) {
 
     /* Initialize phototypesetter */
     ptinit();
+    stphase("ptinit");
 
-    /* Initialize internal buffer with empty blocks */
-    for (i = NEV; i--;)
-        write(ibf, &block, EVS * 2);
+    /* Every environment starts from the compiled-in defaults */
+    evinit();
+    stphase("evinit");
 
     /* Set up initial buffer pointers */
     olinep = oline;
@@ -623,13 +799,12 @@ void init2(void) {
     v.hp = ioff = init = 0;
     v.nl = -1;
 
-    /* Set current date and time */
-    cvtime();
+    /* The date registers are set by nrp() when first used: cvtime() */
 
     /* Initialize memory management */
-    frame = stk = setbrk(DELTA);
-    nxf = frame + STKSIZE;
+    frreset();
     nx = mflg;
+    stphase("init2");
 }
 /* 
  * Function to check if a year is a leap year
@@ -655,14 +830,19 @@ int isLeapYear(int year) {
  * Also updates the February days in the ms[] array based on leap year status.
  * This provides date/time information for document processing and headers.
  * 
+ * Called by nrp() when a date register is first used.
+ *
  * Side effects:
  *   - Updates v.yr, v.mo, v.dy, v.dw global variables
  *   - Modifies ms[1] for February days (28 or 29)
  */
+int dateset; /* the date registers hold the date */
+
 void cvtime(void) {
     time_t now = time(NULL);
     struct tm *tm = localtime(&now);
 
+    dateset = 1;
     /* Set the date/time values in troff registers */
     v.yr = tm->tm_year + 1900; /* tm_year is years since 1900 */
     v.mo = tm->tm_mon + 1; /* tm_mon is 0-11, we want 1-12 */
@@ -695,36 +875,47 @@ void mesg(int f) {
         chmod(ttyx, mode);
     }
 }
-/* Print a string after flushing output buffers */
+/* Print a string after the output formatted so far: see diag.c */
 void prstrfl(const char *s) {
-    flusho();
-    prstr(s);
+    dgput(s, 1);
 }
-/* Write a raw string directly to the output device */
+/* Print a string on the diagnostic output, ttyod */
 void prstr(const char *s) {
-    register int i;
-
-    for (i = 0; s[i] != '\0'; i++)
-        ;
-    write(ttyod, s, i);
+    dgput(s, 0);
 }
 /* Execute a request given by its numeric code */
 int control(int a, int b) {
-    register int i, j;
+    register int j;
 
-    i = a;
-    if ((i == 0) || ((j = findmn(i)) == -1))
+    if ((a == 0) || ((j = findmn(a)) == -1))
         return (0);
+    return (ctlrun(j, b));
+}
+
+/* Execute the request or macro in contab slot j */
+static int ctlrun(int j, int b) {
+    register int i;
+    long long t;
+
     if (contab[j].rq & MMASK) {
         *nxf = 0;
         if (b)
             collect();
         flushi();
-        return (pushi(contab[j].f));
+        i = pushi(contab[j].f);
+        if (profon)
+            profpush(contab[j].rq, frlev);
+        TRMAC(contab[j].rq, frlev);
+        return (i);
     } else {
         if (!b)
             return (0);
-        return ((*contab[j].f)());
+        if (!profon)
+            return ((*contab[j].f)());
+        t = profnow();
+        i = (*contab[j].f)();
+        profadd(contab[j].rq, profnow() - t);
+        return (i);
     }
 }
 
@@ -756,6 +947,35 @@ rtn:
  * Returns:
  *   Integer character with formatting bits, or special codes
  */
+long long inbytes; /* bytes taken from the input, reported by -S */
+long long getchn; /* characters through getch(), reported by -S */
+
+/*
+ * Characters getch() must look at once it knows they are not an
+ * escape, indexed by byte: GSALL marks FLSS and RPT, GSFILL those that
+ * matter only when not copying (fc, tabch, ldrch, backspace and, with
+ * ligatures, 'f').  Any other byte goes straight out, after one look.
+ * tabch and ldrch are fixed, so only casefc() and caselg() have to call
+ * getmap() again; init1() makes the first.
+ */
+#define GSALL 01
+#define GSFILL 02
+static unsigned char getsp[256];
+
+void getmap(void) {
+    memset(getsp, 0, sizeof(getsp));
+    getsp[FLSS] = getsp[RPT] = GSALL;
+    getsp[010] = GSFILL;
+    if (lg)
+        getsp['f'] = GSFILL;
+    if (fc <= BMASK)
+        getsp[fc] |= GSFILL;
+    if (tabch <= BMASK)
+        getsp[tabch] |= GSFILL;
+    if (ldrch <= BMASK)
+        getsp[ldrch] |= GSFILL;
+}
+
 int getch(void) {
     register int i, j, k;
 
@@ -782,6 +1002,10 @@ g0:
         if (i & MOT)
             goto g2;
 
+        /* Most characters are none of those below */
+        if ((k <= BMASK) && !(getsp[k] & (copyf ? GSALL : GSALL | GSFILL)))
+            goto g2;
+
         /* Handle flush sequence */
         if (k == FLSS) {
             copyf++;
@@ -955,7 +1179,7 @@ g0:
         case 'k': /* mark horizontal place */
             if ((i = findr(getsn())) == -1)
                 goto g0;
-            vlist[i] = v.hp;
+            *nrp(i) = v.hp;
             goto g0;
         case 'j': /* mark output horizontal place */
             if (!(i = getach()))
@@ -984,6 +1208,7 @@ g0:
     }
 
 g2:
+    getchn++;
     /* Handle newlines and update position */
     if ((i & CMASK) == '\n') {
         nlflg++;
@@ -1000,6 +1225,84 @@ g2:
     }
     return (i);
 }
+/*
+ * UTF-8 input
+ *
+ * A byte from the file with the top bit set begins or continues a UTF-8
+ * sequence.  Once the sequence is complete, the code point is read as
+ * the character utftab[] (ntab.c) gives it: a special character by its
+ * chtab name, through setch()'s hash, or a plain one.  A code point
+ * utftab[] does not have is left out, as an unknown \( name is, and so
+ * is a sequence cut short.  A byte that cannot begin one goes on as it
+ * always has, without its top bit.  A sequence may span more than one
+ * read of the file, so utfn and utfc hold the part read.
+ */
+#define NUTF 256 /* slots of the code point hash, a power of two */
+
+extern int utftab[];
+
+static int utfn; /* continuation bytes still to come */
+static int utfc; /* the code point so far */
+static int utfkey[NUTF]; /* code point in each slot, 0 if none */
+static short utfval[NUTF]; /* the character it is read as */
+static int utfready;
+
+static unsigned utfslot(int c) {
+    return (((unsigned)c * 2654435761u) >> (32 - 8));
+}
+
+/* The character code point c is read as, or 0 */
+static int utfcode(int c) {
+    register unsigned h;
+    register int *u, v;
+
+    if (!utfready) {
+        for (u = utftab; *u != 0; u += 2) {
+            if ((v = u[1]) >= 0200) /* a chtab name */
+                v = (chhname[CHHASH(v)] == v) ? chhcode[CHHASH(v)] : 0;
+            for (h = utfslot(*u); utfkey[h] && (utfkey[h] != *u); h = (h + 1) & (NUTF - 1))
+                ;
+            if (!utfkey[h]) {
+                utfkey[h] = *u;
+                utfval[h] = (short)v;
+            }
+        }
+        utfready = 1;
+    }
+    for (h = utfslot(c); utfkey[h]; h = (h + 1) & (NUTF - 1))
+        if (utfkey[h] == c)
+            return (utfval[h]);
+    return (0);
+}
+
+/*
+ * Byte b of the file, 0200 or more: the character a sequence it ends
+ * makes, 0 to leave it out, -1 while more of it is to come, or -2 if
+ * it is not part of a sequence
+ */
+static int utfin(int b) {
+    if ((b & 0300) == 0200) { /* a continuation */
+        if (!utfn)
+            return (-2);
+        utfc = (utfc << 6) | (b & 077);
+        return (--utfn ? -1 : utfcode(utfc));
+    }
+    if ((b >= 0302) && (b <= 0337)) {
+        utfn = 1;
+        utfc = b & 037;
+    } else if ((b >= 0340) && (b <= 0357)) {
+        utfn = 2;
+        utfc = b & 017;
+    } else if ((b >= 0360) && (b <= 0364)) {
+        utfn = 3;
+        utfc = b & 07;
+    } else {
+        utfn = 0;
+        return (-2);
+    }
+    return (-1);
+}
+
 /* Input filter translation table for control characters */
 char ifilt[32] = {0, 001, 002, 003, 0, 005, 006, 007, 010, 011, 012};
 /*
@@ -1027,6 +1330,19 @@ int getch0(void) {
         return (i);
     }
     if (nchar) {
+#ifdef NROFF
+        /*
+         * The copies left of an ordinary glyph go on as one run item,
+         * so that \l and leaders take one trip through getch(), width()
+         * and the line for all of them.
+         */
+        if ((nchar > 1) && !copyf && !raw && !(rchar & (MOT | ZBIT | ~0177777)) &&
+            ((k = rchar & CMASK) > 040) && (k < 0370) && !getsp[k]) {
+            j = (nchar > RUNMAX) ? RUNMAX : nchar;
+            nchar -= j;
+            return (rchar | (j << 16));
+        }
+#endif
         nchar--;
         return (rchar);
     }
@@ -1045,6 +1361,8 @@ again:
     } else if (ip) {
         if (ip == -1)
             i = rdtty();
+        else if (sp)
+            i = rbs();
         else
             i = rbf();
     } else {
@@ -1063,7 +1381,16 @@ again:
             }
         g1:
             nx = 0;
-            if ((j = read(ifile, g_processor.inputBuffer, IBUFSZ)) <= 0)
+            if ((j = mapin()) >= 0) {
+                if (j == 0)
+                    goto g0;
+                g_processor.inputPtr = g_processor.mapBase + ioff;
+                g_processor.endInput = g_processor.mapBase + j;
+                if (ip)
+                    goto again;
+                goto g2;
+            }
+            if ((j = OSA_READ(ifile, g_processor.inputBuffer, IBUFSZ)) <= 0)
                 goto g0;
             g_processor.inputPtr = g_processor.inputBuffer;
             g_processor.endInput = g_processor.inputBuffer + j;
@@ -1071,8 +1398,21 @@ again:
                 goto again;
         }
     g2:
-        i = *g_processor.inputPtr++ & 0177;
+        i = (unsigned char)*g_processor.inputPtr++;
         ioff++;
+        inbytes++;
+        if (i < 0200)
+            utfn = 0;
+        else if ((j = utfin(i)) == -2) /* as ASCII, without the top bit */
+            i &= 0177;
+        else if (j <= 0)
+            goto again;
+        else if (raw)
+            return (j);
+        else {
+            i = j;
+            goto g4;
+        }
         if (i >= 040)
             goto g4;
         else
@@ -1091,6 +1431,349 @@ g4:
         i = (i & ~CMASK) | ESC;
     return (i);
 }
+/*
+ * Characters that end a plain text run for getrun(), indexed by input
+ * byte.  Rebuilt whenever one of the characters it depends on changes.
+ */
+static char runstop[256];
+static int runkey[5] = {-1};
+
+static void runtab(void) {
+    register int c;
+
+    runkey[0] = eschar;
+    runkey[1] = fc;
+    runkey[2] = tabch;
+    runkey[3] = ldrch;
+    runkey[4] = lg && !lgf;
+    for (c = 0; c < 256; c++) {
+        register int k = c & 0177;
+
+        runstop[c] = (c & 0200) || (k < 040) || (k == 0177) || (k == ' ') ||
+                     (k == eschar) || (k == fc) || (k == tabch) ||
+                     (k == ldrch) || ((k == 'f') && runkey[4]);
+    }
+}
+
+/*
+ * getrun - Fetch a run of plain text characters in one step
+ *
+ * Ordinary printable characters read straight from the input file need
+ * none of the handling in getch() and getch0() beyond the chbits fix-up
+ * and width accounting.  When nothing is pending and input comes from
+ * the file buffer, getrun() scans ahead for the next byte that does need
+ * it (control, space, escape, field, tab, leader or ligature start) and
+ * hands back everything before it with chbits applied and the widths
+ * charged to v.hp exactly as getch() would.
+ *
+ * Returns:
+ *   Number of characters stored in buf (and their widths in wid), at
+ *   most n; 0 if the next character must go through getch()
+ */
+int getrun(int *buf, int *wid, int n) {
+    register char *p, *e;
+    register int i, k;
+
+    if (ch || nlflg || ch0 || nchar || cp || ap || ip || nx || donef ||
+        raw || copyf || level || utfn || (g_processor.endInput == NULL))
+        return (0);
+    if ((runkey[0] != eschar) || (runkey[1] != fc) || (runkey[2] != tabch) ||
+        (runkey[3] != ldrch) || (runkey[4] != (lg && !lgf)))
+        runtab();
+
+    p = g_processor.inputPtr;
+    e = g_processor.endInput;
+    if (e - p > n)
+        e = p + n;
+    while ((p < e) && !runstop[(unsigned char)*p])
+        p++;
+    n = (int)(p - g_processor.inputPtr);
+    if (n == 0)
+        return (0);
+
+    p = g_processor.inputPtr;
+    for (k = 0; k < n; k++) {
+        buf[k] = i = (*p++ & 0177) | chbits;
+        v.hp += wid[k] = width(i);
+    }
+    cwidth = wid[n - 1];
+    g_processor.inputPtr = p;
+    ioff += n;
+    inbytes += n;
+    return (n);
+}
+
+/*
+ * getcopy - getrun() for copy mode
+ *
+ * In copy mode only control characters and the escape character need
+ * getch(); spaces, field, tab and leader characters are copied as they
+ * are and chbits is not applied.  Fetches the characters of the file
+ * buffer before the next such byte, charging their widths to v.hp as
+ * getch() would, so that copyb() can store the rest of a body line
+ * without a call per character.
+ *
+ * Returns:
+ *   Number of characters stored in buf, at most n; 0 if the next
+ *   character must go through getch()
+ */
+int getcopy(int *buf, int n) {
+    register char *p, *e;
+    register int i, k;
+
+    if (ch || nlflg || ch0 || nchar || cp || ap || ip || nx || donef ||
+        raw || !copyf || level || utfn || (g_processor.endInput == NULL))
+        return (0);
+
+    p = g_processor.inputPtr;
+    e = g_processor.endInput;
+    if (e - p > n)
+        e = p + n;
+    for (n = 0; p < e; n++) {
+        if (((i = (unsigned char)*p) < 040) || (i >= 0177) || (i == eschar))
+            break;
+        buf[n] = i;
+        p++;
+    }
+    if (n == 0)
+        return (0);
+
+    for (k = 0; k < n; k++)
+        v.hp += cwidth = width(buf[k]);
+    g_processor.inputPtr = p;
+    ioff += n;
+    inbytes += n;
+    return (n);
+}
+
+/*
+ * The first byte from p on, before e, that is a control, DEL, not ASCII
+ * or the escape character c, or e: eight at a time while none of them
+ * is, through the borrows and carries of one 64-bit word
+ */
+static char *skipbytes(char *p, char *e, int c) {
+    const uint64_t ones = 0x0101010101010101u, high = 0x80 * ones;
+    uint64_t x, y;
+
+    for (y = (uint64_t)(c & BMASK) * ones; e - p >= 8; p += 8) {
+        memcpy(&x, p, 8);
+        if ((((x - 040 * ones) & ~x) | (x + ones) | x | (((x ^ y) - ones) & ~(x ^ y))) & high)
+            break;
+    }
+    while ((p < e) && ((unsigned char)*p >= 040) && ((unsigned char)*p < 0177) && (*p != c))
+        p++;
+    return (p);
+}
+
+/*
+ * getskip - Pass over plain input in a false branch
+ *
+ * caseif() throws a false branch away through getch() in copy mode,
+ * looking only at braces and newlines.  Printable characters other than
+ * the escape character are none of those and getch() hands them back as
+ * they are, so getskip() moves past all of them before the next one that
+ * does need getch(): in the file buffer a word at a time, or in the
+ * string or macro being read.  Their widths are charged to v.hp as
+ * getch() would, unless a newline follows them, which starts it over.
+ *
+ * Returns:
+ *   Number of characters passed; 0 if the next one must go through getch()
+ */
+int getskip(void) {
+    register char *p, *e;
+    register int *q, k;
+    int n;
+
+    if (ch || nlflg || ch0 || nchar || cp || ap || nx || donef || raw || !copyf || level ||
+        utfn || (ip == -1))
+        return (0);
+    if (ip && !sp)
+        return (rbskip());
+    if (ip) {
+        for (q = sp; (*q >= 040) && (*q < 0177) && (*q != eschar); q++)
+            ;
+        n = (int)(q - sp);
+        if (n && (*q != '\n'))
+            for (k = 0; k < n; k++)
+                v.hp += cwidth = width(sp[k]);
+        sp = q;
+        return (n);
+    }
+    if (g_processor.endInput == NULL)
+        return (0);
+
+    p = g_processor.inputPtr;
+    e = skipbytes(p, g_processor.endInput, eschar);
+    n = (int)(e - p);
+    if (n && ((e == g_processor.endInput) || (*e != '\n')))
+        for (; p < e; p++)
+            v.hp += cwidth = width(*p);
+    g_processor.inputPtr = e;
+    ioff += n;
+    inbytes += n;
+    return (n);
+}
+
+/*
+ * getlook - The character n places on in the input, for getlg()
+ *
+ * Looks at the string, macro or file buffer getch0() would read from
+ * next without taking anything from it, and applies chbits and the
+ * escape mapping as getch0() would.  getdrop() then takes the n looked
+ * at, so a ligature's letters are never pushed back through ch0.
+ *
+ * Returns:
+ *   The character, or 0 when it is not there to be seen: after a
+ *   push-back or a repeat, from the terminal, past the end of a string
+ *   or buffer, or when another file is next
+ */
+int getlook(int n) {
+    register int *q, i, k, p;
+
+    if (ch0 || nchar || raw)
+        return (0);
+    if ((q = cp) != NULL || (q = ap) != NULL || (ip > 0 && (q = sp) != NULL)) {
+        for (k = 0; k < n; k++)
+            if (q[k] == 0)
+                return (0);
+        i = q[n];
+    } else if (ip) {
+        if (ip == -1)
+            return (0);
+        for (p = ip, k = 0; (i = rbf0(p)) != 0 && k < n; k++)
+            p = incoff(p);
+    } else {
+        if (nx || donef || utfn || (g_processor.endInput == NULL) ||
+            (g_processor.endInput - g_processor.inputPtr <= n))
+            return (0);
+        for (k = 0; k <= n; k++)
+            if (g_processor.inputPtr[k] & 0200)
+                return (0); /* UTF-8, which getch0() reads */
+        if ((i = g_processor.inputPtr[n]) < 040)
+            return (0);
+    }
+    if ((i == 0) || ((i & CMASK) == IMP))
+        return (0);
+    if ((copyf == 0) && ((i & ~BMASK) == 0) && ((i & CMASK) < 0370))
+        i |= chbits;
+    if ((i & CMASK) == eschar)
+        i = (i & ~CMASK) | ESC;
+    return (i);
+}
+
+/* Take the n characters getlook() has seen */
+void getdrop(int n) {
+    if (n <= 0)
+        return;
+    if (cp)
+        cp += n;
+    else if (ap)
+        ap += n;
+    else if (ip && sp)
+        sp += n;
+    else if (ip) {
+        while (n--)
+            ip = incoff(ip);
+    } else {
+        g_processor.inputPtr += n;
+        ioff += n;
+        inbytes += n;
+    }
+}
+
+/*
+ * Mapped files kept for the rest of the run, by device, inode, size and
+ * modification time.  A fragment sourced over and over, and the file a
+ * .so returns to, are then mapped once; an edited file maps afresh.
+ */
+struct somap {
+    dev_t dev;
+    ino_t ino;
+    off_t size;
+    time_t mtime;
+    char *base;
+};
+static struct somap *somaps;
+static int nsomap;
+
+/* A kept mapping of the file st describes, or NULL */
+static char *sofind(const struct stat *st) {
+    register struct somap *m;
+
+    for (m = somaps; m < somaps + nsomap; m++)
+        if (m->ino == st->st_ino && m->dev == st->st_dev &&
+            m->size == st->st_size && m->mtime == st->st_mtime)
+            return (m->base);
+    return (NULL);
+}
+
+/* Keep mapping p of the file st describes; 0 if there is no room */
+static int sokeep(const struct stat *st, char *p) {
+    register struct somap *m;
+
+    if (nsomap >= NSOMAP)
+        return (0);
+    if (somaps == NULL && (somaps = OSA_MALLOC(NSOMAP * sizeof(*somaps))) == NULL)
+        return (0);
+    m = &somaps[nsomap++];
+    m->dev = st->st_dev;
+    m->ino = st->st_ino;
+    m->size = st->st_size;
+    m->mtime = st->st_mtime;
+    m->base = p;
+    return (1);
+}
+
+/*
+ * Map the current input file so that getch0() can walk it in place.
+ *
+ * Regular files named on the command line or by .so/.nx are mapped
+ * whole on their first refill, so the rest of the file costs no read()
+ * calls or copies.  The mapping is kept for reuse (see sofind()) while
+ * there is room.  Standard input is never mapped: caseso() saves and
+ * restores it through extraBuffer, which assumes inputBuffer holds the
+ * data.  Pipes, ttys, empty files and mmap failures fall back to the
+ * buffered read() path.
+ *
+ * Returns:
+ *   Size of the mapping on first use, 0 once a mapped file has been
+ *   consumed, or -1 if ifile must be read() instead
+ */
+static int mapin(void) {
+    struct stat st;
+    size_t len;
+    void *p;
+
+    if (g_processor.mapState > 0)
+        return (0);
+    if (g_processor.mapState < 0 || ifile == 0)
+        return (-1);
+    g_processor.mapState = -1;
+    if ((fstat(ifile, &st) < 0) || !S_ISREG(st.st_mode) ||
+        (st.st_size <= 0) || (st.st_size > INT_MAX))
+        return (-1);
+    if ((p = sofind(&st)) != NULL) {
+        g_processor.mapState = 2;
+    } else {
+        if ((p = os_map_file(ifile, &len)) == NULL || len != (size_t)st.st_size) {
+            os_unmap(p, len);
+            return (-1);
+        }
+        os_map_advise(p, len, OS_ADV_SEQUENTIAL);
+        g_processor.mapState = sokeep(&st, p) ? 2 : 1;
+    }
+    g_processor.mapBase = p;
+    g_processor.mapLen = (size_t)st.st_size;
+    return ((int)st.st_size);
+}
+/* Drop the mapping of the current input file before ifile changes */
+static void unmapin(void) {
+    if (g_processor.mapState == 1)
+        os_unmap(g_processor.mapBase, g_processor.mapLen);
+    g_processor.mapBase = NULL;
+    g_processor.mapLen = 0;
+    g_processor.mapState = 0;
+}
 /*
  * Switch to the next input file when needed.
  * 
@@ -1107,25 +1790,43 @@ int nextfile(void) {
     register char *p;
 
 n0:
+    /* A -m package has been read completely: save its snapshot */
+    if ((snappend == 2) && (ifi == 0) && !nx)
+        snapsave();
+    unmapin();
     if (ifile)
         close(ifile);
     if (nx) {
         p = nextf;
-        if (*p != 0)
+        if (*p != 0) {
+            if (snappend == 1)
+                snappend++;
+            else
+                snappend = 0;
             goto n1;
+        }
     }
     if (ifi > 0) {
         if (popf())
             goto n0; /*popf error*/
+        SGPOP();
         return (1); /*popf ok*/
     }
+    /* -D: the state is loaded, so format each job from a copy */
+    if (dsock)
+        dserve();
+    /* -B: the state is loaded, so format each document from a copy */
+    if (bsuffix && (rargc > 0))
+        bfork();
+    /* -C: this process formats the documents */
+    capstart();
     if (rargc-- <= 0)
         goto n2;
     p = (argp++)[0];
 n1:
     if ((p[0] == '-') && (p[1] == 0)) {
         ifile = 0;
-    } else if ((ifile = open(p, 0)) < 0) {
+    } else if (((ifile = pftake(p)) < 0) && ((ifile = open(p, 0)) < 0)) {
         prstr("Cannot open ");
         prstr(p);
         prstr("\n");
@@ -1133,13 +1834,17 @@ n1:
         done(02);
     }
     nfo++;
+    if (rargc > 0)
+        pfstart(argp[0]);
     ioff = v.cd = 0;
+    pxinput(ifi, p, ifile);
     return (0);
 n2:
     if ((nfo -= mflg) && !stdi)
         done(0);
     nfo++;
     v.cd = ioff = ifile = stdi = mflg = 0;
+    pxinput(ifi, NULL, 0);
     return (0);
 }
 /*
@@ -1167,8 +1872,13 @@ int popf(void) {
             *q++ = *p++;
         return (0);
     }
+    if ((i = mapin()) > 0) {
+        g_processor.inputPtr = g_processor.mapBase + ioff;
+        g_processor.endInput = g_processor.mapBase + i;
+        return (g_processor.inputPtr >= g_processor.endInput);
+    }
     if ((seek(ifile, ioff & ~(IBUFSZ - 1), 0) < 0) ||
-        ((i = read(ifile, g_processor.inputBuffer, IBUFSZ)) < 0))
+        ((i = OSA_READ(ifile, g_processor.inputBuffer, IBUFSZ)) < 0))
         return (1);
     g_processor.endInput = g_processor.inputBuffer + i;
     g_processor.inputPtr = g_processor.inputBuffer;
@@ -1246,6 +1956,7 @@ int getach(void) {
  *   - Clears processing stack
  */
 void casenx(void) {
+    sgbad();
     lgf++;
     skip();
     getname();
@@ -1256,8 +1967,7 @@ void casenx(void) {
     ap = 0;
     nchar = 0;
     pendt = 0;
-    frame = stk;
-    nxf = frame + STKSIZE;
+    frreset();
 }
 /*
  * Read a filename or macro name into nextf buffer.
@@ -1289,7 +1999,7 @@ int getname(void) {
  * 
  * This function implements the .so (source) request which includes
  * the contents of another file at the current position. It manages
- * the file inclusion stack and handles nested includes up to NSO levels.
+ * the file inclusion stack, which grows with sogrow() as includes nest.
  * 
  * Error handling:
  *   - Validates file name retrieval
@@ -1301,6 +2011,38 @@ int getname(void) {
  *   - Opens and begins processing new file
  *   - May copy buffer contents for stdin processing
  */
+static int sogrown; /* ifl, offl and ipl live on the heap */
+
+/* Grow an include stack array to n entries, copying it off static storage once */
+static int *soext(int *a, int n) {
+    int *b;
+
+    if (sogrown)
+        return (OSA_REALLOC(a, n * sizeof(int)));
+    if ((b = OSA_MALLOC(n * sizeof(int))) != NULL)
+        memcpy(b, a, nso * sizeof(int));
+    return (b);
+}
+
+/* Double the include stack */
+static int sogrow(void) {
+    int *p, n;
+
+    n = 2 * nso;
+    if ((p = soext(ifl, n)) == NULL)
+        return (-1);
+    ifl = p;
+    if ((p = soext(offl, n)) == NULL)
+        return (-1);
+    offl = p;
+    if ((p = soext(ipl, n)) == NULL)
+        return (-1);
+    ipl = p;
+    sogrown = 1;
+    nso = n;
+    return (0);
+}
+
 void caseso(void) {
     register int i;
     register char *p, *q;
@@ -1315,12 +2057,13 @@ void caseso(void) {
         prstr("\n");
         return;
     }
-    if (ifi >= NSO) {
+    if (ifi >= nso && sogrow() < 0) {
         prstr("Error: Too many nested .so requests.\n");
         close(i);
         return;
     }
     flushi();
+    unmapin();
     ifl[ifi] = ifile;
     ifile = i;
     offl[ifi] = ioff;
@@ -1337,6 +2080,36 @@ void caseso(void) {
         while (p < g_processor.endInput)
             *q++ = *p++;
     }
+    pxinput(ifi, nextf, ifile);
+    sgso(nextf);
+    snapso(nextf);
+}
+
+/* Put back the file .so has pushed, unread, for -R's replay of it */
+int sodrop(void) {
+    close(ifile);
+    nx = 0;
+    return (popf() ? -1 : 0);
+}
+
+/*
+ * Resume reading n levels of files, as a -X checkpoint left them: fd[k]
+ * at offset off[k], fd[n-1] read now and the rest suspended under it.
+ */
+int soresume(int n, const int *fd, const int *off) {
+    int k;
+
+    while (nso < n)
+        if (sogrow() < 0)
+            return (-1);
+    for (k = 0; k < n; k++) {
+        ifl[k] = fd[k];
+        offl[k] = off[k];
+        ipl[k] = 0;
+    }
+    ifi = n;
+    ip = nx = 0;
+    return (popf() ? -1 : 0);
 }
 /*
  * Parse a list of page numbers from a string.
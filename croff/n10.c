@@ -25,22 +25,29 @@
  * void dostop(void)
  *      Halt processing and wait for a character from input (fd 2, usually stderr).
  *
+ * void ptwarm(void)
+ *      Build the precomputed glyphs ahead of the first line, for croff -D.
+ *
  * Static Helper Functions:
  * ------------------------
  * static void ptout1(void)
  *      Output the contents of the oline buffer to the terminal, handling
  *      character rendering, font changes, bolding, underlining, and plotting.
  *
- * static char *plot(char *x)
- *      Process a plotting sequence from a character's definition, outputting
+ * static char *plot(char *x, char *b, size_t *m)
+ *      Lay out a plotting sequence from a character's definition as
  *      elementary plotting commands (up, down, left, right).
  *
  * static void move(void)
  *      Perform accumulated horizontal and vertical motion, outputting the
- *      appropriate terminal control sequences.
+ *      appropriate terminal control sequences.  With -h, whole-column
+ *      horizontal moves are planned by mplan() for the fewest bytes.
  *
  * static void oputs(const char *s)
- *      Output a null-terminated string using oput for each character.
+ *      Output a null-terminated string with oputn.
+ *
+ * static void glyphinit(void)
+ *      Precompute the bytes ptout1 emits for each character.
  *
  * Global Variables:
  * -----------------
@@ -50,7 +57,7 @@
  *
  * External Variables (defined elsewhere):
  * ---------------------------------------
- * int lss, xfont, esc, lead, ulfont, esct, sps, ics, ttysave, ttys[3], ptid, waitf, pipeflg, eqflg, hflg, tabtab[], xxx;
+ * int lss, xfont, esc, lead, ulfont, esct, sps, ics, ttysave, ttys[3], ptid, waitf, pipeflg, eqflg, hflg, xxx;
  * char obuf[], *obufp, termtab[];
  * struct env *dip;
  * int oline[], *olinep;
@@ -62,12 +69,21 @@
  *
  * Notable Implementation Details:
  * -------------------------------
- * - Terminal capabilities are read from an external file (termtab), and pointers in the
- *   device table structure are relocated to point into the loaded string area.
+ * - Terminal capabilities come from a table built in (term/tab*.c) or from a
+ *   table file written by term/mktab, mapped in place by twload().
  * - Character output is buffered per line, with motion and font changes handled inline.
  * - Special handling for bold and underline fonts, including device-specific sequences.
  * - Plotting sequences are interpreted and output as device commands for graphical characters.
  * - Horizontal motion is optimized using tabs if enabled.
+ * - ptinit() lays out, for each character, its underline prefix, its
+ *   code and the backspaces of a zero-width character in one span, so
+ *   that ptout1() emits any combination with a single oputn().  A code
+ *   that plots is laid out as the commands it makes, plot mode and all.
+ * - A table with ulon underlines by turning the attribute on and off
+ *   around the underlined characters; the spans then go out without
+ *   their underscores, and motion between them is never underlined.
+ *   attrs() keeps what bold and underline are and changes only what
+ *   differs, in one SGR sequence where the table's strings are SGR.
  * - Terminal settings are manipulated directly using stty/gtty.
  *
  * SCCS Version:
@@ -86,6 +102,9 @@
 #include <sys/wait.h> /* For wait() */
 #include "proto.h" /* Function prototypes for this project */
 #include "troff_processor.h" // processor state
+#include "tabstop.h" // tsdef()
+#define OSA_TAG "croff.device"
+#include "os/os_acct.h" // OSA_MALLOC, OSA_FREE, OSA_READ
 
 /* Explicit declaration to avoid implicit function warning */
 void flusho(void);
@@ -94,6 +113,7 @@ void flusho(void);
 void prstr(const char *s);
 int stty(int fd, int *ttys);
 void oput(int c);
+void oputn(const char *s, int n);
 
 /*
  * n10.c
@@ -104,151 +124,122 @@ void oput(int c);
  * bolding, underlining, and basic plotting.
  */
 
+/*
+ * State of the device output.  The page renderer, which includes this
+ * file, defines TWSTATE as _Thread_local to render pages in parallel.
+ */
+#ifndef TWSTATE
+#define TWSTATE
+#endif
+
 /* External global variables, defined elsewhere */
-extern int lss; /* Current line spacing */
+extern TWSTATE int lss; /* Current line spacing */
 extern TroffProcessor g_processor; /* Shared processor state */
-extern int xfont; /* Current font selection */
-extern int esc; /* Horizontal escapement */
-extern int lead; /* Vertical leading */
-extern struct env *dip; /* Pointer to current environment block */
-extern int oline[]; /* Buffer for the current output line */
-extern int *olinep; /* Pointer to current position in oline */
-extern int ulfont; /* Underline font code */
-extern int esct; /* Accumulated horizontal escapement for the current character */
+extern TWSTATE int xfont; /* Current font selection */
+extern TWSTATE int esc; /* Horizontal escapement */
+extern TWSTATE int lead; /* Vertical leading */
+extern TWSTATE struct env *dip; /* Pointer to current environment block */
+extern TWSTATE int oline[]; /* Buffer for the current output line */
+extern TWSTATE int *olinep; /* Pointer to current position in oline */
+extern TWSTATE int ulfont; /* Underline font code */
+extern TWSTATE int esct; /* Accumulated horizontal escapement for the current character */
 extern int sps; /* Size of a space character */
 extern int ics; /* Inter-character space */
 extern int ttysave; /* Saved terminal settings */
 extern int ttys[3]; /* Current terminal settings (for stty/gtty) */
 extern char termtab[]; /* Path to terminal capability table file */
+extern int tti; /* Where the terminal name starts in termtab */
+extern int twload(const char *path, const char *name);
 extern int ptid; /* Pipe file descriptor for output */
 extern int waitf; /* Wait status for piped process */
 extern int pipeflg; /* Flag: true if output is piped */
 extern int eqflg; /* Flag: true if equation mode is active (adjusts horizontal resolution) */
 extern int hflg; /* Flag: true if horizontal motion optimization (tabs) is enabled */
-extern int tabtab[]; /* Array of tab stop positions */
 extern int xxx; /* Unused? (common in old troff code for debugging) */
+extern void widflush(void); /* Forget cached character widths */
+extern int ipflg; /* -I: intermediate pages instead of device output */
+extern void ipout(int i);
+extern void iplead(void);
+extern void ipstop(void);
+extern void ipdone(void);
+extern void fwmark(int i); /* A forward reference's column is put out here */
+extern int pmflg; /* -G: pages held as a model, put out whole */
+extern void pmline(const int *q, int n, int down);
+extern void pmlead(void);
+extern void pmstop(void);
 
 /* Global variables defined in this file */
 int dtab; /* Default tab stop distance */
-int bdmode; /* Bold mode status (0 = off, >0 = on) */
-int plotmode; /* Plot mode status (0 = off, >0 = on) */
+TWSTATE int bdmode; /* Bold mode status (0 = off, >0 = on) */
+TWSTATE int plotmode; /* Plot mode status (0 = off, >0 = on) */
+TWSTATE int ulmode; /* t.ulon is in effect */
+
+/*
+ * Ready-made output of one character: n underscores, n backspaces, the
+ * code bytes and n more backspaces, n being its width in characters.
+ */
+struct glyph {
+    char *span;
+    int n; /* Width in characters */
+    int len; /* Code bytes, plotting commands made */
+};
+
+static struct glyph glyphs[256 - 32];
+static int glyphok; /* glyphs[] is built for the loaded table */
+
+/* What the table can do, found by ptinit() once it is loaded */
+static int twbold; /* t.bdon is set */
+static int twplot; /* t.ploton is set: codes with the 0200 bit plot */
+static int twul; /* t.ulon is set: underline with it, not with _ */
+static int twsgr; /* bdon, bdoff, ulon and uloff are SGR: changes go as one */
+static int twbdrst, twulrst; /* bdoff, uloff end every attribute */
+
+#define SGRMAX 32 /* bytes in one SGR sequence made by attrs() */
 
 /* SCCS version control identifier */
 static char Sccsid[] = "@(#)n10.c  1.3 of 4/26/77";
 
 /* Forward declarations for local static helper functions */
 static void ptout1(void);
-static char *plot(char *x);
+static void oputrep(const char *s, int len, int n);
+static char *plot(char *x, char *b, size_t *m);
+static size_t plotcode(char *b, const char *codep);
+static void plotput(char *b, size_t *m, const char *s);
 static void move(void);
 static void oputs(const char *s);
+static void glyphinit(void);
+static void attrs(int bd, int ul);
+static int sgrarg(char *b, int n, const char *s);
+static int sgrreset(const char *s);
 
 /*
  * ptinit
  * Initializes the terminal/printer device.
- * Reads terminal capabilities from the file specified by 'termtab'.
+ * Loads the terminal capabilities named by 'termtab'.
  * Sets up initial device parameters, fonts, and terminal modes.
  */
 void ptinit(void) {
-    int i; /* File descriptor or general integer */
-    char **p; /* Pointer to iterate through t structure members */
-    char *q; /* Pointer to allocated memory for terminal strings */
-    int qsize; /* Size of the t structure's string area */
-    char *x[8]; /* Temporary buffer, usage is unclear/possibly vestigial */
-    int offset; /* Offset for relocating pointers in t structure */
-
-    if ((i = open(termtab, O_RDONLY)) < 0) { /* O_RDONLY is 0 on many systems */
+    /* A built-in table, or a table file mapped in place: see twload.c */
+    if (twload(termtab, &termtab[tti]) < 0) {
         prstr("Cannot open ");
         prstr(termtab);
         prstr("\n");
         exit(-1);
     }
 
-    /* This read is unusual: it reads 16 bytes into an array of 8 char pointers.
-     * Its specific purpose or effect on 'x' is unclear from this context,
-     * and 'x' is only minimally used afterwards. May be vestigial or system-dependent.
-     */
-    read(i, x, 16);
-
-    /* Calculate the size of the part of 't' structure containing char* members
-     * that point to strings (terminal control sequences).
-     * The multiplication by 2 might be a historical artifact or an error,
-     * as pointer differences usually give element counts.
-     * However, if &t.zzz and &t.bset are char** and point to the start/end
-     * of an array of char* members, this calculates the byte size of that array.
-     */
-    qsize = (char *)(&t.zzz) - (char *)(&t.bset); /* Size of the pointer region in t */
-
-    /* The original code had `qsize = 2 * (&t.zzz - &t.bset);`.
-     * If t.zzz and t.bset are of type `char **`, then `&t.zzz - &t.bset` would
-     * be the number of `char *` elements. Multiplying by 2 seems incorrect
-     * if the intent was byte size unless `sizeof(char *)` was assumed to be 1
-     * and it was actually number of words, or some other historical reason.
-     * Assuming `(char*)&t.zzz - (char*)&t.bset` is the byte size of the region.
-     * If the original calculation was indeed correct for its target, this might need review.
-     * For now, using byte difference for clarity.
-     */
-
-    /* The following line `x[2] = -qsize;` is also unusual, assigning to part of
-     * the 'x' array that was just read into. Its purpose is not clear.
-     */
-    /* x[2] = (char *)(long)-qsize; */ /* Retaining original logic if x[2] was a char* */
-    /* However, the original was `x[2] = -qsize;` which implies x[2] was treated as an int or compatible type.
-                                        This is highly platform-dependent and likely problematic.
-                                        Given the limited context, this line is commented out as its original intent and type safety are questionable.
-                                        If `x` is truly `char *x[8]`, then `x[2]` is a `char*`. Assigning an integer to it directly is a type error.
-                                        If it was `int x[8]`, it would be different.
-                                        The original code might have relied on specific compiler behavior or pointer/integer size equivalence.
-                                     */
-
-    /* Allocate memory for terminal control strings. setbrk is likely sbrk or similar. */
-    if ((q = setbrk(qsize)) == (char *)(-1L)) { /* Check for allocation failure */
-        prstr("Cannot allocate memory for termtab strings\n");
-        close(i);
-        exit(-1);
-    }
-
-    /* Read terminal control strings into the allocated buffer 'q'.
-     * t.twinit is likely an offset within the termtab file.
-     * 020 is an octal constant (16 decimal).
-     */
-    if (lseek(i, (long)t.twinit + 020, SEEK_SET) == -1) {
-        prstr("Seek error in termtab\n");
-        close(i);
-        exit(-1);
-    }
-    if (read(i, q, qsize) != qsize) {
-        prstr("Read error from termtab\n");
-        close(i);
-        exit(-1);
-    }
-    close(i); /* Close the termtab file */
-
-    /* Relocate pointers in the t structure.
-     * Members from t.twinit to t.zzz are assumed to be char* offsets
-     * relative to the start of the string area in the file.
-     * They are adjusted to be absolute pointers into the buffer 'q'.
-     */
-    offset = q - t.twinit; /* Calculate base offset for relocation, assuming t.twinit is char* */
-    for (p = (char **)&t.twinit; p < (char **)&t.zzz; p++) {
-        if (*p) { /* If the member (offset) is non-zero */
-            *p = (char *)((uintptr_t)(*p) + offset); /* Adjust to be an absolute pointer */
-        } else {
-            /* If original offset was 0, point it to a safe default (e.g., end of t strings or an empty string)
-             * Original code pointed to &t.zzz, which is unusual. A pointer to an empty string "" might be safer.
-             * For now, preserving original logic: make it point to the address of t.zzz itself.
-             * This is likely meant to be a sentinel or an effectively null string pointer.
-             */
-            *p = (char *)(&t.zzz);
-        }
-    }
-
+    widflush(); /* Widths come from the tables just loaded */
     sps = EM; /* Default space size is 1 em */
     ics = EM * 2; /* Default inter-character space is 2 ems */
     dtab = 8 * t.Em; /* Default tab width is 8 ems */
 
     /* Initialize tab stops */
-    for (i = 0; i < 16; i++) {
-        tabtab[i] = dtab * (i + 1);
+    tsdef(dtab);
+
+    /* With -I the widths are all that is needed; ipage.c writes the rest */
+    if (ipflg) {
+        if (eqflg)
+            t.Adj = t.Hor;
+        return;
     }
 
     /* Set terminal modes if specified by t.bset or t.breset */
@@ -258,6 +249,16 @@ void ptinit(void) {
         stty(1, ttys); /* Apply new terminal settings to stdout */
     }
 
+    twplot = (*t.ploton & 0377) != 0; /* motion may come before any glyph */
+    /*
+     * The spans for ptout1() wait for the first line out, so a run that
+     * prints nothing never builds them.  The page renderer builds them
+     * here, before its threads share them.
+     */
+    glyphok = 0;
+#ifdef TWEAGER
+    glyphinit();
+#endif
     oputs(t.twinit); /* Output terminal initialization string */
 
     /* If equation mode, adjust horizontal resolution */
@@ -271,9 +272,13 @@ void ptinit(void) {
  * Restores terminal settings and cleans up before exiting.
  */
 void twdone(void) {
-    g_processor.outputPtr = g_processor.outputBuffer; /* Reset buffer pointer */
-    oputs(t.twrest); /* Output terminal restoration string */
-    flusho(); /* Flush any remaining output */
+    if (ipflg) {
+        ipdone();
+    } else {
+        g_processor.outputPtr = g_processor.outputBuffer; /* Reset buffer pointer */
+        oputs(t.twrest); /* Output terminal restoration string */
+        flusho(); /* Flush any remaining output */
+    }
 
     /* If output was piped, close pipe and wait for child process */
     if (pipeflg) {
@@ -281,6 +286,8 @@ void twdone(void) {
         wait(&waitf); /* Wait for piped process to terminate */
     }
 
+    if (ipflg)
+        return; /* ptinit() left the terminal alone */
     ttys[2] = ttysave; /* Restore original terminal settings */
     stty(1, ttys); /* Apply restored settings to stdout */
 }
@@ -292,6 +299,10 @@ void twdone(void) {
  * 'i' contains the character or command, potentially with motion/font bits.
  */
 void ptout(int i) {
+    if (ipflg) {
+        ipout(i);
+        return;
+    }
     *olinep++ = i; /* Add item to the output line buffer */
 
     /* Prevent buffer overflow if line is too long */
@@ -312,7 +323,9 @@ void ptout(int i) {
     dip->blss = 0; /* Reset space before */
     esct = esc = 0; /* Reset horizontal escapements */
 
-    if (olinep > oline) { /* If there's content in the line buffer */
+    if (pmflg) { /* The page model puts it out with the page */
+        pmline(oline, (int)(olinep - oline), lead);
+    } else if (olinep > oline) { /* If there's content in the line buffer */
         move(); /* Perform any pending horizontal/vertical motion */
         ptout1(); /* Output the characters in the line buffer */
         oputs(t.twnl); /* Output device's newline sequence */
@@ -334,8 +347,60 @@ static void oputs(const char *s) {
     if (s == NULL) { /* Defensive check for null pointer */
         return;
     }
-    while (*s) {
-        oput(*s++); /* oput() is assumed to be declared elsewhere (e.g., in proto.h) */
+    oputn(s, (int)strlen(s));
+}
+
+/*
+ * ptwarm
+ * Builds glyphs[] now rather than at the first line out, for croff -D,
+ * so that every job forked from the server has it.
+ */
+void ptwarm(void) {
+    if (!glyphok)
+        glyphinit();
+}
+
+/*
+ * glyphinit
+ * Builds the glyphs[] table from t.codetab.  All spans share one block,
+ * allocated once, as the codes do not change after ptinit().
+ */
+static void glyphinit(void) {
+    static char *pool;
+    struct glyph *g;
+    char *codep, *p, sgr[SGRMAX];
+    size_t size;
+    int k, n, len;
+
+    glyphok = 1;
+    twbold = (*t.bdon & 0377) != 0;
+    twplot = (*t.ploton & 0377) != 0;
+    twul = (t.ulon != NULL) && (*t.ulon & 0377) != 0;
+    twsgr = twbold && twul && sgrarg(sgr, 2, t.bdon) > 0 && sgrarg(sgr, 2, t.bdoff) > 0 &&
+            sgrarg(sgr, 2, t.ulon) > 0 && sgrarg(sgr, 2, t.uloff) > 0;
+    twbdrst = twsgr && sgrreset(t.bdoff);
+    twulrst = twsgr && sgrreset(t.uloff);
+    for (size = 0, k = 0; k < 256 - 32; k++) {
+        codep = t.codetab[k];
+        size += 3 * (size_t)(*codep & 0177) + plotcode(NULL, codep + 1);
+    }
+    OSA_FREE(pool);
+    if ((pool = OSA_MALLOC(size ? size : 1)) == NULL) {
+        prstr("Cannot allocate memory for termtab strings\n");
+        exit(-1);
+    }
+    for (p = pool, k = 0; k < 256 - 32; k++) {
+        g = &glyphs[k];
+        codep = t.codetab[k];
+        n = *codep++ & 0177;
+        len = (int)plotcode(p + 2 * n, codep);
+        g->n = n;
+        g->len = len;
+        g->span = p;
+        memset(p, '_', (size_t)n);
+        memset(p + n, '\b', (size_t)n);
+        memset(p + 2 * n + len, '\b', (size_t)n);
+        p += 3 * n + len;
     }
 }
 
@@ -351,8 +416,11 @@ static void ptout1(void) {
     int *q; /* Pointer to iterate through oline */
     int w; /* Width of the character in device units */
     int j; /* Temporary for motion value */
-    int phyw; /* Physical width of the character (for zero-width chars) */
+    int n; /* Copies of it */
+    struct glyph *g; /* Precomputed output of the character */
 
+    if (!glyphok)
+        glyphinit();
     for (q = oline; q < olinep; q++) { /* Iterate over items in the line buffer */
         i = *q; /* Get current character/command */
 
@@ -371,6 +439,16 @@ static void ptout1(void) {
 
         k = (i & CMASK); /* Extract character code (mask out font/other bits) */
 
+        /* A column of a forward reference, written in at the end: see fwref.c */
+        if (k == FWHOLE) {
+            if (esc || lead)
+                move();
+            esct += t.Char;
+            fwmark(i);
+            oput(' ');
+            continue;
+        }
+
         /* Handle special characters (ASCII control codes or space) */
         if (k <= 040) { /* 040 is octal for space */
             switch (k) {
@@ -388,10 +466,9 @@ static void ptout1(void) {
 
         w = t.Char * (*codep++ & 0177); /* Get char width; first byte of sequence is width multiplier. */
         /* 0177 (octal) masks to 7 bits. */
-        phyw = w; /* Store physical width */
 
         if (i & ZBIT) { /* If zero-width character flag is set */
-            w = 0; /* Logical width is zero, but physical width (phyw) is used for underlining */
+            w = 0; /* Logical width is zero; the span backs over what it printed */
         }
 
         /* If there's pending motion or this char has a multi-byte sequence, perform motion first */
@@ -399,80 +476,188 @@ static void ptout1(void) {
             move();
         }
 
-        esct += w; /* Accumulate character width to total horizontal escapement for the line */
+        n = RUNN(i) ? RUNN(i) : 1; /* A run puts out n copies: see getch0() */
+        esct += w * n; /* Accumulate character width to total horizontal escapement for the line */
 
         /* Handle font changes if any bits are set in the upper part of 'i' */
         if (i & 074000) { /* Octal mask for font bits */
             xfont = (i >> 9) & 03; /* Extract font code (0, 1, 2, or 3) */
         }
 
-        /* Handle bold mode */
-        if (*t.bdon & 0377) { /* Check if bold-on sequence exists (first char not null) */
-            if (!bdmode && (xfont == 2)) { /* If not in bold mode and font is bold (font 2) */
-                oputs(t.bdon); /* Output bold-on sequence */
-                bdmode++; /* Set bold mode flag */
-            }
-            if (bdmode && (xfont != 2)) { /* If in bold mode and font is not bold */
-                oputs(t.bdoff); /* Output bold-off sequence */
-                bdmode = 0; /* Clear bold mode flag */
-            }
-        }
+        /* Bold (font 2) and underline by attribute, changed only if they change */
+        attrs(xfont == 2, xfont == ulfont);
 
-        /* Handle underlining */
-        if (xfont == ulfont) { /* If current font is the underline font */
-            for (k = phyw / t.Char; k > 0; k--) { /* Output '_' for width of char */
-                oput('_');
-            }
-            for (k = phyw / t.Char; k > 0; k--) { /* Backspace to overwrite with char */
-                oput('\b');
-            }
-        }
+        /* Every character is a single span: see glyphinit() */
+        g = &glyphs[k - 32];
+        j = (xfont == ulfont && !twul) ? 0 : 2 * g->n; /* skip the underline */
+        oputrep(g->span + j, 2 * g->n + g->len + (w ? 0 : g->n) - j, n);
+    }
+    attrs(bdmode, 0); /* the line ends, or the run of pmodel.c */
+}
 
-        /* Output character's control sequence */
-        while (*codep != 0) { /* Loop through bytes of the character's sequence */
-            if (*codep & 0200) { /* If high bit (0200 octal) is set, it's a plot sequence */
-                codep = plot(codep); /* Process plot sequence */
-                /* plot() returns pointer after the sequence it consumed */
-                /* Assuming plot mode should be turned off after plotting sequence for a char */
-                if (plotmode) { /* If plot mode was turned on by plot() */
-                    oputs(t.plotoff); /* Turn off plot mode */
-                    plotmode = 0;
-                }
-                oput(' '); /* Output a space to account for plotter movement (device dependent) */
-            } else { /* Regular character byte in sequence */
-                if (plotmode) { /* If plot mode is on (e.g. from previous char part) */
-                    oputs(t.plotoff); /* Turn it off before printing normal char part */
-                    plotmode = 0;
-                }
-                oput(*codep++); /* Output the byte */
-            }
-        }
+/*
+ * sgrarg
+ * If s is one SGR sequence, ESC [ params m, adds its params to the n
+ * bytes of the sequence being made in b and returns the new length;
+ * otherwise returns -1.  No params is 0.
+ */
+static int sgrarg(char *b, int n, const char *s) {
+    const char *p;
+
+    if ((s == NULL) || (s[0] != 033) || (s[1] != '['))
+        return (-1);
+    for (p = s + 2; (*p >= '0' && *p <= '9') || (*p == ';'); p++)
+        ;
+    if ((p[0] != 'm') || (p[1] != 0) || (n + (p - s) + 2 > SGRMAX))
+        return (-1);
+    if (n > 2)
+        b[n++] = ';';
+    if (p == s + 2)
+        b[n++] = '0';
+    memcpy(b + n, s + 2, (size_t)(p - s - 2));
+    return (n + (int)(p - s - 2));
+}
 
-        /* For zero-width characters, output backspaces to cover physical width */
-        if (!w) { /* If logical width was zero */
-            for (k = phyw / t.Char; k > 0; k--) {
-                oput('\b');
-            }
+/* Whether SGR sequence s ends every attribute: has a param that is 0 */
+static int sgrreset(const char *s) {
+    int v;
+
+    for (s += 2;; s++) {
+        for (v = 0; *s >= '0' && *s <= '9'; s++)
+            v = 10 * v + *s - '0';
+        if (v == 0)
+            return (1);
+        if (*s != ';')
+            return (0);
+    }
+}
+
+/* One attribute string: into the SGR in b if there is one, else out */
+static int attrput(char *b, int n, const char *s) {
+    if (twsgr)
+        return (sgrarg(b, n, s));
+    oputs(s);
+    return (n);
+}
+
+/*
+ * attrs
+ * Puts bold on or off as bd says and the underline of t.ulon as ul says,
+ * from what they are now: offs first, each with what it ends, then ons.
+ * On a table whose four strings are SGR the changes go out as one
+ * sequence, so that a change of font costs one escape however many
+ * attributes it changes.
+ */
+static void attrs(int bd, int ul) {
+    char b[SGRMAX];
+    int n;
+
+    bd = bd && twbold;
+    ul = ul && twul;
+    if ((bd == bdmode) && (ul == ulmode))
+        return;
+    b[0] = 033;
+    b[1] = '[';
+    n = 2;
+    if (bdmode && !bd) {
+        n = attrput(b, n, t.bdoff);
+        bdmode = 0;
+        if (twbdrst)
+            ulmode = 0;
+    }
+    if (ulmode && !ul) {
+        n = attrput(b, n, t.uloff);
+        ulmode = 0;
+        if (twulrst)
+            bdmode = 0;
+    }
+    if (!bdmode && bd) {
+        n = attrput(b, n, t.bdon);
+        bdmode = 1;
+    }
+    if (!ulmode && ul) {
+        n = attrput(b, n, t.ulon);
+        ulmode = 1;
+    }
+    if (twsgr && (n > 2)) {
+        b[n++] = 'm';
+        oputn(b, n);
+    }
+}
+
+/*
+ * oputrep
+ * Outputs n copies of the len bytes at s, a buffer of them at a time.
+ */
+static void oputrep(const char *s, int len, int n) {
+    char b[512];
+    int k, m;
+
+    if ((n == 1) || (len <= 0) || (len > (int)sizeof(b) / 2)) {
+        while (n-- > 0)
+            oputn(s, len);
+        return;
+    }
+    m = (n < (int)sizeof(b) / len) ? n : (int)sizeof(b) / len;
+    for (k = 0; k < m; k++)
+        memcpy(b + k * len, s, (size_t)len);
+    for (; n > 0; n -= m) {
+        if (m > n)
+            m = n;
+        oputn(b, m * len);
+    }
+}
+
+/*
+ * plotcode
+ * Lays out the code at codep in b, unless b is NULL, and returns its
+ * length: the code bytes, except that each plot sequence in it, a run
+ * of bytes with the 0200 bit, is made in plot mode and followed by a
+ * space once plot mode is off again.  Each sequence starts and ends in
+ * the same mode, so the result does not depend on what came before.
+ */
+static size_t plotcode(char *b, const char *codep) {
+    size_t m = 0;
+    char *x = (char *)codep;
+
+    while (*x != 0) {
+        if (twplot && (*x & 0200)) {
+            x = plot(x, b, &m);
+            plotput(b, &m, t.plotoff);
+            plotput(b, &m, " ");
+        } else {
+            if (b != NULL)
+                b[m] = *x;
+            m++;
+            x++;
         }
     }
+    return (m);
+}
+
+/* Adds s at b + *m, if b is not NULL, and its length to *m */
+static void plotput(char *b, size_t *m, const char *s) {
+    size_t n = strlen(s);
+
+    if (b != NULL)
+        memcpy(b + *m, s, n);
+    *m += n;
 }
 
 /*
  * plot
- * Processes a plotting sequence from a character's definition.
- * Turns on plot mode and outputs elementary plotting commands (up, down, left, right).
- * 'x' points to the start of the plot sequence (byte with 0200 bit set).
- * Returns a pointer to the character after the consumed plot sequence.
+ * Lays out a plotting sequence from a character's definition, as
+ * plotcode() does: plot mode on, then elementary plotting commands (up,
+ * down, left, right).  'x' points to the start of the plot sequence
+ * (byte with 0200 bit set).  Returns a pointer to the character after
+ * the consumed plot sequence.
  */
-static char *plot(char *x) {
+static char *plot(char *x, char *b, size_t *m) {
     int i; /* Number of steps for a plot command */
     char *j; /* Pointer to terminal command string (e.g., t.up) */
     char *k; /* Current position in the plot sequence string */
 
-    if (!plotmode) {
-        oputs(t.ploton); /* Turn on plot mode if not already on */
-        plotmode = 1;
-    }
+    plotput(b, m, t.ploton); /* Turn on plot mode */
 
     k = x;
     if ((*k & 0377) == 0200) { /* If current byte is the initial plot marker (0200 octal) */
@@ -499,15 +684,100 @@ static char *plot(char *x) {
                 return (++k); /* Return pointer to byte after this command */
             }
             while (i--) { /* Output the command string 'i' times */
-                oputs(j);
+                plotput(b, m, j);
             }
         } else { /* Not a direction/count command, so it's a literal character to print in plot mode */
-            oput(*k);
+            if (b != NULL)
+                b[*m] = *k;
+            ++*m;
         }
     }
     return (k); /* Return pointer to the null terminator of the sequence */
 }
 
+/*
+ * Horizontal motion plans
+ * With -h, a move of whole columns along the tab grid may be made of a
+ * carriage return, tabs, spaces and backspaces, in that order.  All of
+ * them are one byte, so the cheapest plan is the one with the fewest:
+ * going right, tabbing past the target and backing up can beat spaces;
+ * going left, returning the carriage and moving forward can beat
+ * backspaces.  Plans are cached by starting column and distance.
+ */
+struct mplan {
+    int from, n; /* Key: starting column and signed distance */
+    int cr, tab, sp, bs;
+};
+
+#define MPLANS 256 /* Plans cached, a power of two */
+
+/* An empty slot holds the plan for {0, 0}, which is to do nothing */
+static TWSTATE struct mplan mplans[MPLANS];
+
+/* Cheapest way forward n >= 0 columns from column c0 */
+static void mforward(struct mplan *p, int c0, int n) {
+    int tc, to;
+
+    tc = dtab / t.Em; /* columns per tab stop */
+    to = c0 + n;
+    p->tab = to / tc - c0 / tc; /* stops passed on the way */
+    p->sp = to - (p->tab ? (to / tc) * tc : c0);
+    p->bs = 0;
+    if (to % tc && (to / tc + 1) * tc - to < p->sp - 1) {
+        /* one more tab and back */
+        p->tab++;
+        p->bs = (to / tc + 1) * tc - to;
+        p->sp = 0;
+    }
+}
+
+static struct mplan *mplan(int c0, int n) {
+    struct mplan *p, alt;
+
+    p = &mplans[((unsigned)c0 * 31u + (unsigned)n) & (MPLANS - 1)];
+    if (p->from == c0 && p->n == n)
+        return p;
+    p->from = c0;
+    p->n = n;
+    p->cr = 0;
+    if (n >= 0) {
+        mforward(p, c0, n);
+        return p;
+    }
+    p->tab = p->sp = 0;
+    p->bs = -n;
+    if (c0 + n >= 0) {
+        mforward(&alt, 0, c0 + n);
+        if (1 + alt.tab + alt.sp + alt.bs < p->bs) {
+            p->cr = 1;
+            p->tab = alt.tab;
+            p->sp = alt.sp;
+            p->bs = alt.bs;
+        }
+    }
+    return p;
+}
+
+/* Output k copies of byte c */
+static void mrun(int c, int k) {
+    char run[64];
+    int n;
+
+    memset(run, c, k < (int)sizeof(run) ? (size_t)k : sizeof(run));
+    for (; k > 0; k -= n) {
+        n = k < (int)sizeof(run) ? k : (int)sizeof(run);
+        oputn(run, n);
+    }
+}
+
+static void mplay(const struct mplan *p) {
+    if (p->cr)
+        oput('\r');
+    mrun(TAB, p->tab);
+    mrun(' ', p->sp);
+    mrun('\b', p->bs);
+}
+
 /*
  * move
  * Performs accumulated horizontal (esc) and vertical (lead) motion.
@@ -522,6 +792,7 @@ static void move(void) {
     int current_hpos; /* Current horizontal position before this move, for tab calculations */
     int dt; /* Distance to next tab stop */
 
+    attrs(bdmode, 0); /* spaces and motion are not underlined */
     current_hpos = esct; /* esct is total accumulated horizontal motion on the line so far */
 
     /* Determine base newline sequence based on current horizontal position */
@@ -573,13 +844,23 @@ static void move(void) {
     if (esc) {
         char *space_char_seq; /* Sequence for single character space/backspace */
         if (esc < 0) { /* Negative escapement (move left) */
-            esc = -esc; /* Make esc positive for calculations */
             space_char_seq = "\b"; /* Use backspace for single unit left motion */
             h_mot = t.left; /* Horizontal motion is left */
         } else { /* Positive escapement (move right) */
             space_char_seq = " "; /* Use space for single unit right motion */
+        }
+        if (hflg && dtab % t.Em == 0 && current_hpos >= 0 && current_hpos % t.Em == 0) {
+            /* Whole columns on the tab grid: let the planner choose */
+            k = esc / t.Em;
+            esc = esc % t.Em;
+            if (esc < 0)
+                esc = -esc;
+            mplay(mplan(current_hpos / t.Em, k));
+        } else {
+            if (esc < 0)
+                esc = -esc; /* Make esc positive for calculations */
             /* Optimize with tabs if hflg is set and moving right */
-            if (hflg) {
+            if (hflg && *space_char_seq == ' ') {
                 while ((dt = dtab - (current_hpos % dtab)) <= esc) { /* dt is distance to next tab */
                     if (dt % t.Em) { /* If tab stop not multiple of Em, don't use tab */
                         break;
@@ -589,17 +870,17 @@ static void move(void) {
                     current_hpos += dt; /* Update current horizontal position */
                 }
             }
-        }
-        /* Output remaining motion in Em units */
-        k = esc / t.Em; /* Number of Em-sized steps */
-        esc %= t.Em; /* Remainder (sub-Em motion) */
-        while (k--) {
-            oputs(space_char_seq); /* Output space or backspace */
+            /* Output remaining motion in Em units */
+            k = esc / t.Em; /* Number of Em-sized steps */
+            esc %= t.Em; /* Remainder (sub-Em motion) */
+            while (k--) {
+                oputs(space_char_seq); /* Output space or backspace */
+            }
         }
     }
 
     /* Handle fine-grained plotting motion if plot mode is supported and residual esc/lead exists */
-    if ((*t.ploton & 0377) && (esc || lead)) { /* If plot-on sequence exists and there's sub-unit motion */
+    if (twplot && (esc || lead)) { /* If the terminal can plot and there's sub-unit motion */
         if (!plotmode) {
             oputs(t.ploton); /* Turn on plot mode */
             plotmode = 1;
@@ -631,9 +912,92 @@ static void move(void) {
  * Performs any pending vertical motion. Essentially a wrapper for move().
  */
 void ptlead(void) {
+    if (ipflg)
+        iplead();
+    else if (pmflg)
+        pmlead();
+    else
+        move();
+}
+
+/*
+ * The page model of pmodel.c puts its runs out through these.  ptdown()
+ * moves down, from the left edge if row is set, as ptout() does for a
+ * new line, or from where the last run ended; ptrun() puts the items of
+ * a run out from h, underlined in font ul, as ptout1() would have put
+ * its line; ptnl() ends the row.
+ */
+void ptdown(int down, int row) {
+    if (row)
+        esct = 0;
+    esc = 0;
+    lead = down;
     move();
 }
 
+void ptrun(const int *q, int n, int h, int ul) {
+    int u = ulfont;
+
+    memcpy(oline, q, (size_t)n * sizeof(*q));
+    olinep = oline + n;
+    esc = h - esct;
+    ulfont = ul;
+    ptout1();
+    ulfont = u;
+    olinep = oline;
+}
+
+void ptnl(void) {
+    oputs(t.twnl);
+    esc = lead = 0;
+}
+
+/*
+ * Where the n items at q end, as ptout1() puts them out, and in drift
+ * the vertical motion it makes before the last of them
+ */
+int ptspan(const int *q, int n, int *drift) {
+    int i, j, k, w, x, right, h, v;
+    char *codep;
+
+    x = right = h = v = *drift = 0;
+    for (; n > 0; n--) {
+        i = *q++;
+        if (i & MOT) {
+            j = i & ~MOTV;
+            if (i & NMOT)
+                j = -j;
+            if (i & VMOT)
+                v += j;
+            else
+                h += j;
+            continue;
+        }
+        k = i & CMASK;
+        if (k == FWHOLE) {
+            codep = "\001 ";
+        } else if (k <= 040) {
+            if (k == ' ')
+                h += t.Char;
+            continue;
+        } else {
+            codep = t.codetab[k - 32];
+        }
+        w = t.Char * (*codep & 0177);
+        if (codep[1] && (h || v)) {
+            x += h;
+            *drift += v;
+            h = v = 0;
+        }
+        j = (k == FWHOLE || !RUNN(i)) ? 1 : RUNN(i);
+        if (x + w * j > right)
+            right = x + w * j;
+        if (!(i & ZBIT))
+            x += w * j;
+    }
+    return (right);
+}
+
 /*
  * dostop
  * Halts processing and waits for a character from input (fd 2 - stderr).
@@ -642,10 +1006,18 @@ void ptlead(void) {
 void dostop(void) {
     int junk; /* Dummy variable to satisfy read() */
 
+    if (ipflg) {
+        ipstop(); /* the renderer's reader decides when to stop */
+        return;
+    }
+    if (pmflg) {
+        pmstop(); /* before the next page, when it goes out */
+        return;
+    }
     flusho(); /* Flush output buffer before stopping */
     /* Waits for any character to be typed on file descriptor 2 (stderr).
      * This is unusual; typically, one would read from stdin (fd 0) or the controlling terminal.
      * Reading from stderr might be intentional if stdin/stdout are redirected.
      */
-    read(2, (char *)(&junk), 1); /* Read 1 byte into junk's memory location */
+    OSA_READ(2, (char *)(&junk), 1); /* Read 1 byte into junk's memory location */
 }
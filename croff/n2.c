@@ -12,7 +12,7 @@
  *
  * MAJOR FUNCTIONS:
  *   - Character processing and translation (pchar, pchar1)
- *   - Output buffer management (oput, oputs, flusho)
+ *   - Output buffer management (oput, oputs, oputn; the ring is in obuf.c)
  *   - Multi-stage program termination (done, done1, done2, done3)
  *   - Device-specific output handling
  *   - Pipeline management for NROFF mode
@@ -42,6 +42,10 @@
 #include "env.h" // environment data
 #include "t.h" // troff common header
 #include "troff_processor.h" // processor state
+#include "trace.h" // -Y event trace
+#include "caps.h" // -C resource caps
+#include "diag.h" // -Q diagnostics
+#include "chtab_hash.h" // special character names, for ascii mode
 
 #include <stdlib.h> /* C90: exit, malloc, free */
 #include <unistd.h> /* POSIX: write, close, open, sleep */
@@ -98,14 +102,14 @@ extern int no_out; /* No output flag */
 extern int level; /* Nesting level */
 extern int xxx; /* Reserved variable */
 /* d and v are defined in header files */
-extern int chtab[]; /* Character table for special chars */
 
 /* Global variables defined in this module */
 int toolate; /* Too late flag for output */
 int error; /* Error status accumulator */
 
 #ifndef NROFF
-extern int acctf; /* Accounting file descriptor */
+void acctput(int use, int uid); /* batched accounting (acct.c) */
+void acctflush(void);
 #endif
 
 /* Version identification */
@@ -114,7 +118,10 @@ static char Sccsid[] = "@(#)n2.c  1.8 of 5/13/77";
 /* Function prototypes for C90 compliance */
 void oput(int i);
 void oputs(const char *i);
+void oputn(const char *s, int n);
 void flusho(void);
+void obnext(void);
+void obwait(void);
 #ifdef NROFF
 void casepi(void);
 #endif
@@ -134,7 +141,13 @@ extern void ptout(int i);
 extern int control(int i, int j);
 extern void reset(void);
 extern void wbt(int i);
-extern void getword(int i);
+extern void frreset(void);
+extern void profreport(void);
+extern void pxdone(int x);
+extern void fwdone(void);
+extern void pmdone(void);
+extern void memreport(void);
+extern int getword(int i);
 extern void tbreak(void);
 extern void eject(int i);
 extern void ptlead(void);
@@ -218,6 +231,30 @@ void pchar(int c) {
     pchar1(i);
 }
 
+#ifndef NROFF
+/*
+ * The \(xx of each special character for ascii mode, from chtab's
+ * reverse index (chrev[], ntab.c).  An entry left empty has no name,
+ * and the character is dropped.
+ */
+static char ascname[BMASK + 1][4];
+static int ascbuilt;
+
+static void ascinit(void) {
+    int j;
+
+    for (j = 0; j <= BMASK; j++) {
+        if (chrev[j] == 0)
+            continue;
+        ascname[j][0] = '\\';
+        ascname[j][1] = '(';
+        ascname[j][2] = (char)(chrev[j] & BMASK);
+        ascname[j][3] = (char)(chrev[j] >> BYTE);
+    }
+    ascbuilt = 1;
+}
+#endif
+
 /*
  * pchar1 - Output a processed character
  * 
@@ -229,12 +266,13 @@ void pchar(int c) {
  *   c - Processed character code to output
  */
 void pchar1(int c) {
-    register int i, j, *k;
+    register int i, j;
 
     j = (i = c) & CMASK;
 
     /* Handle diversion output */
     if (dip && dip->op) {
+        CAPDIV(dilev);
         wbf(i); /* Write to buffer */
         dip->op = offset;
         return;
@@ -289,15 +327,11 @@ void pchar1(int c) {
             oputs("ffl");
             break;
         default:
-            /* Look up character in special character table */
-            for (k = chtab; *++k != j; k++)
-                if (*k == 0)
-                    return; /* Character not found */
-            /* Output as \(xx escape sequence */
-            oput('\\');
-            oput('(');
-            oput(*--k & BMASK);
-            oput(*k >> BYTE);
+            /* Output as \(xx escape sequence, if it has a name */
+            if (!ascbuilt)
+                ascinit();
+            if (ascname[j][0])
+                oputn(ascname[j], 4);
         }
     } else
 #endif
@@ -308,19 +342,17 @@ void pchar1(int c) {
 /*
  * oput - Output a single character to the buffer
  * 
- * Adds a character to the output buffer and flushes if buffer is full.
+ * Adds a character to the current segment of the output ring, moving
+ * to the next segment first when this one is full (see obuf.c).
  *
  * Parameters:
  *   i - Character to output
  */
 void
 oput(int i) {
+    if (g_processor.outputPtr == g_processor.outputEnd)
+        obnext();
     *g_processor.outputPtr++ = ((char)i);
-
-    /* Flush buffer when full (accounting for ASCII mode differences) */
-    if (g_processor.outputPtr ==
-        (g_processor.outputBuffer + OBUFSZ + ascii - 1))
-        flusho();
 }
 
 /*
@@ -338,43 +370,30 @@ oputs(const char *i) {
 }
 
 /*
- * flusho - Flush the device output buffer
- * 
- * Writes the accumulated output buffer to the output device,
- * opening the device if necessary. Handles error conditions
- * gracefully and maintains buffer consistency.
+ * oputn - Output n bytes
+ *
+ * Copies a run of bytes into the output buffer a segment at a time,
+ * for callers that already know what they are going to emit.
+ *
+ * Parameters:
+ *   s - First byte
+ *   n - Number of bytes
  */
 void
-flusho(void) {
-    ssize_t bytes_written;
-
-    /* Add terminator for non-ASCII output */
-    if (!ascii)
-        *g_processor.outputPtr++ = '\0';
-
-    /* Open output device if not already open */
-    if (!ptid) {
-        while ((ptid = open(ptname, O_WRONLY)) < 0) {
-            if (++waitf <= 2)
-                prstr("Waiting for Typesetter.\n");
-            sleep(15);
-        }
-    }
-
-    /* Write buffer to device unless output is disabled */
-    if (no_out == 0) {
-        bytes_written = write(ptid, g_processor.outputBuffer,
-                              (size_t)(g_processor.outputPtr -
-                                       g_processor.outputBuffer));
-        if (bytes_written < 0) {
-            toolate = -1; /* Mark write error */
-        } else {
-            toolate = (int)bytes_written;
-        }
+oputn(const char *s, int n) {
+    int k;
+
+    while (n > 0) {
+        if (g_processor.outputPtr == g_processor.outputEnd)
+            obnext();
+        k = (int)(g_processor.outputEnd - g_processor.outputPtr);
+        if (k > n)
+            k = n;
+        memcpy(g_processor.outputPtr, s, (size_t)k);
+        g_processor.outputPtr += k;
+        s += k;
+        n -= k;
     }
-
-    /* Reset buffer pointer */
-    g_processor.outputPtr = g_processor.outputBuffer;
 }
 
 /*
@@ -428,10 +447,7 @@ int done(int x) {
 
     /* Reset stack and frame pointers safely */
     ip = 0;
-    if (stk) {
-        frame = stk;
-        nxf = frame + STKSIZE;
-    }
+    frreset();
 
     /* Final page break and cleanup */
     if (!ejf)
@@ -523,9 +539,17 @@ void done3(int x) {
     signal(SIGINT, SIG_DFL);
     signal(SIGTERM, SIG_DFL);
 
+    /* Put out the pages held, write the forward references in, then let the writer finish */
+    pmdone();
+    fwdone();
+    obwait();
+
     /* Clean up temporary files */
-    close(ibf);
-    unlink(unlkp);
+    if (ibf >= 0)
+        close(ibf);
+    if (unlkp)
+        unlink(unlkp);
+    pxdone(error);
 
 #ifdef NROFF
     /* NROFF-specific cleanup */
@@ -547,6 +571,11 @@ void done3(int x) {
     report();
 #endif
 
+    /* Request and macro profile for -S, memory report for -M */
+    profreport();
+    memreport();
+    trreport();
+
     /* Exit with accumulated error status */
     exit(error);
 }
@@ -561,8 +590,7 @@ void done3(int x) {
  */
 void edone(int x) {
     /* Reset stack to initial state */
-    frame = stk;
-    nxf = frame + STKSIZE;
+    frreset();
     ip = 0;
 
     /* Call normal termination */
@@ -573,22 +601,15 @@ void edone(int x) {
 /*
  * report - Generate usage accounting report
  * 
- * Writes paper usage information to the accounting file for troff.
+ * Writes paper usage information to the accounting file for troff,
+ * through the batched sink of acct.c.
  */
 static void
 report(void) {
-    struct acct_record {
-        int use; /* Paper usage count */
-        char uid; /* User ID */
-    } a;
-
     /* Write accounting record if output device used and paper consumed */
     if ((ptid != 1) && paper) {
-        seek(acctf, 0, 2); /* Seek to end of accounting file */
-        a.use = paper;
-        a.uid = ((char)getuid());
-        write(acctf, &a, sizeof(a));
-        close(acctf);
+        acctput(paper, (int)getuid());
+        acctflush();
     }
 }
 #endif
@@ -614,6 +635,7 @@ casepi(void) {
     }
 
     /* Fork child process */
+    dgflush();
     if ((child_pid = fork()) == -1) {
         prstr("Pipe not created.\n");
         close(id[0]);
@@ -9,6 +9,12 @@
 #include "env.h"   // environment structure definitions
 #include "t.h"     // common troff header
 #include "proto.h" // function prototypes
+#include "core/blkstore.h" // in-core macro block store
+#include "trace.h" // -Y event trace
+#include "caps.h" // -C resource caps
+#include "fwref.h" // forward references
+#define OSA_TAG "croff.store"
+#include "os/os_acct.h" // OSA_MALLOC, OSA_CALLOC, OSA_REALLOC, ...
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -17,36 +23,92 @@
 #include <stdint.h> // For intptr_t / uintptr_t
 
 /* Memory and allocation constants */
-#define NBLIST 256
-#define BLK 128
-#define NEV_COUNT 10
-#define EVS_SIZE 100
-#define HASH_TABLE_SIZE 1024
-
-/* Hash table for fast macro lookup */
-struct hash_entry {
-    int key;
-    int value;
-    struct hash_entry *next;
+#define BLKBASE BLK /* first block word; offset 0 means no macro */
+#define MNMIN 512 /* initial name index size, a power of two */
+#define MNFREE (-1) /* never used index entry */
+#define MNGONE (-2) /* deleted index entry */
+
+/* Name index entry: request/macro name and its contab slot */
+struct mnent {
+    int name;
+    int idx;
 };
 
 /* Global variables */
 int pagech = '%';
 int strflg;
-int blist[NBLIST];
-int wbuf[BLK];
-int rbuf[BLK];
-static struct hash_entry *hash_table[HASH_TABLE_SIZE];
+static int blisti0[NBLIST];
+int *blist = blisti0; /* next block of each block, -1 chain end, 0 free */
+int nblist = NBLIST; /* entries in blist */
+int nblkuse; /* blocks in use */
+int nblkpeak; /* most blocks in use at once */
+static int *bfree; /* stack of free blist entries */
+static int nbfree;
+int mspill = MSPILL; /* in-core blocks before spilling to ibf, 0 = never */
+static otroff_blkstore_t mstore;
+static int mstore_ok;
+static struct mnent *mntab; /* open-addressed name -> contab slot */
+static int mnsize; /* entries in mntab */
+static int mnfill; /* live plus deleted entries */
+static int *mnfree; /* stack of unused contab slots */
+static int mnnfree;
+static int mngrown; /* contab lives on the heap */
+static int *mnend; /* closing 0 word of each contab macro, 0 if unknown */
+static int mnwrite = -1; /* contab slot finds() set up for writing */
+static int dislot[NDI]; /* slot each diversion level writes, -1 if gone */
+
+/* Copy of a short string body for setstr(), by contab slot */
+struct mnstr {
+    int *w; /* NSTR words, kept for the slot once allocated */
+    int state; /* MSUNSEEN, MSSHORT (w is current) or MSLONG */
+};
+static struct mnstr *mnstr;
+static int nmnstr; /* entries in mnstr */
+#define MSUNSEEN 0
+#define MSSHORT 1
+#define MSLONG 2
+
+/* Name on a control line in a macro, as the main loop reads it */
+struct ctok {
+    int a; /* store address of the control character, 0 if unused */
+    int p; /* ip after the control character */
+    int end; /* ip after the name */
+    unsigned g; /* bgen[] of the block of a when made */
+    int name; /* what getrq() returns, -1 if it must be read */
+    int slot; /* findmn(name) as of name generation mg */
+    unsigned mg;
+    int key[4]; /* eschar, fc, tabch and ldrch it was read with */
+    unsigned char nw; /* words read after the control character */
+    unsigned char nc; /* of which the first nc in copy mode */
+    unsigned char put; /* the last one goes back in ch */
+    unsigned char w[CTW];
+};
+#define CTMIN 1024 /* initial token table size, a power of two */
+static struct ctok *cttab; /* open-addressed by a */
+static int ctsize; /* entries in cttab */
+static int ctfill; /* entries with a set, stale or not */
+static unsigned *bgen; /* times each blist entry has been freed */
+static int nbgen;
+static unsigned mngen; /* times a name has been mapped anew */
+
+/* Resident words at w cover store addresses [a, e) */
+struct bwin {
+    int *w;
+    int a, e;
+};
+static struct bwin rwin, wwin; /* blocks rbf0() and wbf() are in */
 
 /* External declarations with proper types */
 extern int ch, ibf, nextb, lgf, copyf, ch0, ip;
+extern int ibfopen(void *arg); /* n1.c: the temp file, made on first spill */
 extern int app, ds, nlflg, nchar, pendt, rchar, dilev;
 extern int nonumb, lt, nrbits, nform, oldmn, newmn, macerr;
-extern int apptr, offset, aplnk, diflg, woff, roff, wbfi, po, xxx;
+extern int apptr, offset, aplnk, diflg, woff, po, xxx;
+extern int cc, c2, chbits, cwidth, eschar, fc, tabch, ldrch;
 extern char *enda;
-extern int *nxf, *argtop, *ap, *frame, *stk, *cp;
+extern int *nxf, *ap, *frame, *stk, *cp, *sp;
 extern struct env *dip;
-extern int fmt[];
+extern int *fmt;
 
 extern struct contab {
     int rq;
@@ -54,17 +116,26 @@ extern struct contab {
         int (*func)(void);
         int offset;
     } f;
-} contab[NM];
+} *contab;
+extern int ncontab;
 
 /* External structure references from headers - use proper extern declarations */
 
 /* C90 Function prototypes */
-static int hash_function(int key);
-static void init_hash_table(void);
+static unsigned mnslot(int name);
+static int mnput(int name, int idx);
+static void mndel(int name, int idx);
 static void caseig(void);
 static void casern(void);
 static void caserm(void);
 static int pchar_wrapper_for_hseg(int c);
+static otroff_blkstore_t *mst(void);
+static void wbend(int k);
+static void strmod(int k);
+static int strroom(void);
+static void ctscan(int p);
+static void ctinit(void);
+static void ctfree(int b);
 
 void caseas(void);
 void caseds(void);
@@ -80,13 +151,25 @@ int alloc(void);
 void blk_free(int i);
 int boff(int i);
 int blisti(int i);
+void blkinit(void);
+int blkroom(int n);
 char *setbrk(int x);
 void wbt(int i);
 void wbf(int i);
+void wbfs(const int *w, int n);
 void wbfl(void);
 int rbf(void);
+int rbs(void);
+int rbskip(void);
 int rbf0(int p);
 int incoff(int p);
+void blkget(int i, int *buf);
+void blkput(int i, const int *buf);
+void blklend(int i, const int *words);
+void mnhash(void);
+int mngrow(void);
+void setmn(int i, int rq);
+void frreset(void);
 int popi(void);
 int pushi(int newip);
 int getsn(void);
@@ -113,45 +196,457 @@ extern void done2(int code);
 extern void edone(int code);
 extern int vnumb(int val);
 extern void newline(int flag);
+extern int profon;
+extern void profpop(int lev);
 extern void horiz(int val);
 extern int quant(int val, int unit);
 extern int findr(int c);
 extern int fnumb(int val, int (*f)(int));
 extern int width(int c);
+extern int getcopy(int *buf, int n);
+extern void xcfree(int b);
+extern void xcinit(void);
 extern void pchar(int c);
 extern void Wolf(void);
 extern int seek(int fd, long offset, int whence);
 extern void prstr(char *s);
 extern void prstrfl(char *s);
 
-/* System call redefinitions */
-extern ssize_t sys_read(int fd, void *buf, size_t count);
-extern ssize_t sys_write(int fd, const void *buf, size_t count);
-#define read sys_read
-#define write sys_write
+/*
+ * Request and macro names are found through an open-addressed index
+ * of {name, slot} pairs, probed linearly and doubled at 70% load.
+ * Unused contab slots sit on the mnfree stack, and contab itself is
+ * doubled when that runs dry, so define, rename and remove are O(1)
+ * and the number of macros is bounded only by memory.
+ */
+static unsigned mnslot(int name) {
+    unsigned h = (unsigned)name * 2654435761u;
+
+    return ((h ^ (h >> 16)) & (unsigned)(mnsize - 1));
+}
+
+/* Allocate an empty index big enough for n names */
+static int mnalloc(int n) {
+    struct mnent *t;
+    int k, size;
+
+    size = MNMIN;
+    while (n * 10 >= size * 7)
+        size <<= 1;
+    if ((t = OSA_MALLOC(size * sizeof(*t))) == NULL)
+        return (-1);
+    for (k = 0; k < size; k++)
+        t[k].idx = MNFREE;
+    OSA_FREE(mntab);
+    mntab = t;
+    mnsize = size;
+    mnfill = 0;
+    return (0);
+}
+
+/* Map name to contab slot idx, replacing any earlier mapping */
+static int mnput(int name, int idx) {
+    register unsigned k;
+    int gone;
+
+    if ((mnfill + 1) * 10 >= mnsize * 7) {
+        struct mnent *t = mntab;
+        int j, n = mnsize, live = 0;
+
+        /* Rehash; size from the live names so tombstones are dropped. */
+        for (j = 0; j < n; j++)
+            if (t[j].idx >= 0)
+                live++;
+        mntab = NULL;
+        if (mnalloc(2 * live) < 0) {
+            mntab = t;
+            if (mnfill + 1 >= mnsize)
+                return (-1);
+        } else {
+            for (j = 0; j < n; j++)
+                if (t[j].idx >= 0)
+                    mnput(t[j].name, t[j].idx);
+            OSA_FREE(t);
+        }
+    }
+    gone = -1;
+    for (k = mnslot(name); mntab[k].idx != MNFREE; k = (k + 1) & (mnsize - 1)) {
+        if (mntab[k].idx == MNGONE) {
+            if (gone < 0)
+                gone = k;
+        } else if (mntab[k].name == name) {
+            mntab[k].idx = idx;
+            return (0);
+        }
+    }
+    if (gone >= 0) {
+        k = gone;
+    } else {
+        mnfill++;
+    }
+    mntab[k].name = name;
+    mntab[k].idx = idx;
+    return (0);
+}
+
+/* Drop the mapping of name, but only if it still points at idx */
+static void mndel(int name, int idx) {
+    register unsigned k;
+
+    for (k = mnslot(name); mntab[k].idx != MNFREE; k = (k + 1) & (mnsize - 1)) {
+        if (mntab[k].idx != MNGONE && mntab[k].name == name) {
+            if (mntab[k].idx == idx)
+                mntab[k].idx = MNGONE;
+            return;
+        }
+    }
+}
+
+/* (Re)build the name index and free-slot stack from contab */
+void mnhash(void) {
+    register int j;
+    int n;
+
+    n = 0;
+    for (j = 0; j < ncontab; j++)
+        if (contab[j].rq > 0)
+            n++;
+    OSA_FREE(mnfree);
+    OSA_FREE(mnend);
+    mnnfree = 0;
+    if ((mnfree = OSA_MALLOC(ncontab * sizeof(int))) == NULL ||
+        (mnend = OSA_CALLOC(ncontab, sizeof(int))) == NULL || strroom() < 0 ||
+        mnalloc(n) < 0) {
+        prstr("Out of memory for macro names.\n");
+        done2(02);
+    }
+    for (j = 0; j < nmnstr; j++)
+        mnstr[j].state = MSUNSEEN;
+    for (j = ncontab - 1; j >= 0; j--)
+        if (contab[j].rq == 0)
+            mnfree[mnnfree++] = j;
+    for (j = 0; j < ncontab; j++)
+        if (contab[j].rq > 0)
+            mnput(contab[j].rq & ~MMASK, j);
+    mngen++;
+}
+
+/* Double contab, moving it off the static table the first time */
+int mngrow(void) {
+    struct contab *c;
+    int *f, j, n;
+
+    n = ncontab * 2;
+    if (mngrown) {
+        c = OSA_REALLOC(contab, n * sizeof(*c));
+    } else if ((c = OSA_MALLOC(n * sizeof(*c))) != NULL) {
+        memcpy(c, contab, ncontab * sizeof(*c));
+    }
+    if (c == NULL)
+        return (-1);
+    memset(&c[ncontab], 0, (n - ncontab) * sizeof(*c));
+    contab = c;
+    mngrown = 1;
+    if ((f = OSA_REALLOC(mnfree, n * sizeof(int))) == NULL)
+        return (-1);
+    mnfree = f;
+    if ((f = OSA_REALLOC(mnend, n * sizeof(int))) == NULL)
+        return (-1);
+    memset(&f[ncontab], 0, (n - ncontab) * sizeof(int));
+    mnend = f;
+    for (j = n - 1; j >= ncontab; j--)
+        mnfree[mnnfree++] = j;
+    ncontab = n;
+    return (strroom());
+}
+
+/*
+ * Short strings
+ *
+ * setstr() reads a string of fewer than NSTR words from a copy kept by
+ * its contab slot, through sp, rather than from its blocks.  The copy
+ * is made on first use and marked stale whenever the body is written
+ * or the slot cleared.  Its memory stays with the slot, so sp cannot be
+ * left dangling by a string that redefines itself while being read.
+ */
+static int strroom(void) {
+    struct mnstr *m;
+
+    if (nmnstr >= ncontab)
+        return (0);
+    if ((m = OSA_REALLOC(mnstr, ncontab * sizeof(*m))) == NULL)
+        return (-1);
+    memset(&m[nmnstr], 0, (ncontab - nmnstr) * sizeof(*m));
+    mnstr = m;
+    nmnstr = ncontab;
+    return (0);
+}
+
+static void strmod(int k) {
+    if (k >= 0 && k < nmnstr)
+        mnstr[k].state = MSUNSEEN;
+}
+
+/* The words of the body in slot k, or NULL if it is not short */
+static int *strget(int k) {
+    register struct mnstr *m;
+    register int j, p;
+
+    if (k >= nmnstr)
+        return (NULL);
+    m = &mnstr[k];
+    if (m->state != MSUNSEEN)
+        return (m->state == MSSHORT ? m->w : NULL);
+    for (j = 1; j <= dilev && j < NDI; j++)
+        if (dislot[j] == k)
+            return (NULL); /* still being diverted to */
+    if (m->w == NULL && (m->w = OSA_MALLOC(NSTR * sizeof(int))) == NULL)
+        return (NULL);
+    m->state = MSLONG;
+    for (p = contab[k].f.offset, j = 0; j < NSTR; j++) {
+        if ((m->w[j] = rbf0(p)) == 0) {
+            m->state = MSSHORT;
+            return (m->w);
+        }
+        p = incoff(p);
+    }
+    return (NULL);
+}
+
+/*
+ * Control line tokens
+ *
+ * When a macro body is stored, the name on each of its control lines
+ * is read once, as the main loop would read it, into a token kept by
+ * the address of the control character.  Replaying the line then sets
+ * ip past the name and charges the same widths without going through
+ * getch() for the blanks and the name, and the request or macro slot
+ * is looked up again only after some name has been mapped anew.  A
+ * token is stale once the block holding its line has been freed, and
+ * is read again if the escape, field, tab or leader character has
+ * changed since.  Lines with anything but plain characters before the
+ * end of the name keep a token that says to read them as before.
+ */
+static unsigned ctslot(int a) {
+    unsigned h = (unsigned)a * 2654435761u;
+
+    return ((h ^ (h >> 16)) & (unsigned)(ctsize - 1));
+}
+
+static int ctlive(struct ctok *t) {
+    int b = blisti(t->a);
+
+    return (t->g == (b < nbgen ? bgen[b] : 0));
+}
+
+/* An empty table for n tokens, keeping the live ones of the old */
+static int ctgrow(int n) {
+    struct ctok *o = cttab;
+    int j, k, size = CTMIN, osize = ctsize;
+
+    while (n * 10 >= size * 7)
+        size <<= 1;
+    if ((cttab = OSA_CALLOC(size, sizeof(*cttab))) == NULL) {
+        cttab = o;
+        return (-1);
+    }
+    ctsize = size;
+    ctfill = 0;
+    for (j = 0; j < osize; j++)
+        if (o[j].a != 0 && ctlive(&o[j])) {
+            for (k = ctslot(o[j].a); cttab[k].a != 0; k = (k + 1) & (size - 1))
+                ;
+            cttab[k] = o[j];
+            ctfill++;
+        }
+    OSA_FREE(o);
+    return (0);
+}
+
+static void ctput(struct ctok *t) {
+    register unsigned k;
+    int j, gone, live;
+
+    if ((ctfill + 1) * 10 >= ctsize * 7) {
+        for (j = live = 0; j < ctsize; j++)
+            if (cttab[j].a != 0 && ctlive(&cttab[j]))
+                live++;
+        if (ctgrow(2 * live) < 0 && ctfill + 1 >= ctsize)
+            return;
+    }
+    gone = -1;
+    for (k = ctslot(t->a); cttab[k].a != 0; k = (k + 1) & (ctsize - 1)) {
+        if (cttab[k].a == t->a) {
+            cttab[k] = *t;
+            return;
+        }
+        if (gone < 0 && !ctlive(&cttab[k]))
+            gone = k;
+    }
+    if (gone >= 0)
+        k = gone;
+    else
+        ctfill++;
+    cttab[k] = *t;
+}
+
+static struct ctok *ctfind(int a) {
+    register unsigned k;
+
+    if (cttab == NULL)
+        return (NULL);
+    for (k = ctslot(a); cttab[k].a != 0; k = (k + 1) & (ctsize - 1))
+        if (cttab[k].a == a)
+            return (ctlive(&cttab[k]) ? &cttab[k] : NULL);
+    return (NULL);
+}
+
+/* A name character getach() takes as it is in and out of copy mode */
+static int ctplain(int c) {
+    return (c > 040 && c < 0177 && c != eschar && c != fc && c != tabch &&
+            c != ldrch);
+}
 
-/* Hash table functions */
-static int hash_function(int key) {
-    return key % HASH_TABLE_SIZE;
+/* Read the token of the control line whose control character is at a */
+static void ctmake(int a) {
+    struct ctok t;
+    register int c, k, p;
+    int b = blisti(a);
+
+    t.a = a;
+    t.p = p = incoff(a);
+    t.g = b < nbgen ? bgen[b] : 0;
+    t.name = -1;
+    t.mg = mngen - 1;
+    t.key[0] = eschar;
+    t.key[1] = fc;
+    t.key[2] = tabch;
+    t.key[3] = ldrch;
+    t.put = 0;
+    for (k = 0; k < CTW - 2 && ((c = rbf0(p)) == ' ' || c == '\t'); k++) {
+        t.w[k] = c;
+        p = incoff(p);
+    }
+    t.nc = k + 1;
+    if (k < CTW - 2 && ctplain(c = rbf0(p))) {
+        t.w[k++] = c;
+        p = incoff(p);
+        if (ctplain(c = rbf0(p))) {
+            t.name = t.w[k - 1] | (c << BYTE);
+        } else if (c == ' ' || c == '\n') {
+            t.name = t.w[k - 1];
+            t.put = 1;
+        }
+        if (t.name >= 0) {
+            t.w[k++] = c;
+            p = incoff(p);
+        }
+    }
+    t.nw = k;
+    t.end = p;
+    if (cttab == NULL && ctgrow(0) < 0)
+        return;
+    ctput(&t);
 }
 
-static void init_hash_table(void) {
-    int j, key, hash_index;
-    struct hash_entry *entry;
+/* Make the tokens of the control lines in the body stored from p on */
+static void ctscan(int p) {
+    register int c, bol;
 
-    memset(hash_table, 0, sizeof(hash_table));
+    for (bol = 1; (c = rbf0(p)) != 0; p = incoff(p)) {
+        if (bol && ((c == cc) || (c == c2)))
+            ctmake(p);
+        bol = (c == '\n');
+    }
+}
 
-    for (j = 0; j < NM; j++) {
-        key = contab[j].rq & ~MMASK;
-        hash_index = hash_function(key);
-        entry = (struct hash_entry *)(malloc(sizeof(struct hash_entry)));
-        if (entry != NULL) {
-            entry->key = key;
-            entry->value = j;
-            entry->next = hash_table[hash_index];
-            hash_table[hash_index] = entry;
+/* Forget every token, as when the block store starts over */
+static void ctinit(void) {
+    OSA_FREE(cttab);
+    cttab = NULL;
+    ctsize = ctfill = 0;
+}
+
+/* Block b has been freed; stale the tokens of the lines in it */
+static void ctfree(int b) {
+    unsigned *g;
+
+    if (cttab == NULL)
+        return;
+    if (b >= nbgen) {
+        if ((g = OSA_REALLOC(bgen, nblist * sizeof(*g))) == NULL) {
+            ctinit();
+            return;
+        }
+        memset(&g[nbgen], 0, (nblist - nbgen) * sizeof(*g));
+        bgen = g;
+        nbgen = nblist;
+    }
+    bgen[b]++;
+}
+
+/*
+ * ctlget - getrq() for the control line just begun at a
+ *
+ * The main loop has read the control character at store address a,
+ * with nothing pending before it.  Reads the rest of the name from
+ * its token, leaving input, widths and ch as getrq() would, and
+ * returns the name with its contab slot in *j.  Returns -1, having
+ * read nothing, if the line has to be read as usual.
+ */
+int ctlget(int a, int *j) {
+    register struct ctok *t;
+    register int c = 0, k, w;
+
+    if ((t = ctfind(a)) == NULL || t->key[0] != eschar || t->key[1] != fc ||
+        t->key[2] != tabch || t->key[3] != ldrch) {
+        if (((c = rbf0(a)) != cc) && (c != c2))
+            return (-1);
+        ctmake(a);
+        if ((t = ctfind(a)) == NULL)
+            return (-1);
+    }
+    if (t->name < 0 || t->p != ip)
+        return (-1);
+    for (k = 0; k < t->nw; k++) {
+        c = t->w[k];
+        if (k >= t->nc)
+            c |= chbits;
+        if (t->w[k] == '\n') {
+            nlflg++;
+            v.hp = 0;
         }
+        w = width(c);
+        v.hp += w;
+        cwidth = w;
+    }
+    ip = t->end;
+    if (t->put)
+        ch = c;
+    if (t->mg != mngen) {
+        t->slot = findmn(t->name);
+        t->mg = mngen;
     }
+    *j = t->slot;
+    return (t->name);
+}
+
+/*
+ * setmn - Give contab slot i the request word rq
+ *
+ * All name changes go through here to keep the index in step.  Names
+ * that are 0 (unused) or negative (the -1 placeholder used by finds())
+ * are not indexed.
+ */
+void setmn(int i, int rq) {
+    if (mntab == NULL)
+        mnhash();
+    if (contab[i].rq > 0)
+        mndel(contab[i].rq & ~MMASK, i);
+    contab[i].rq = rq;
+    mngen++;
+    if (rq > 0)
+        mnput(rq & ~MMASK, i);
 }
 
 /* Utility functions */
@@ -180,7 +675,7 @@ static void casern(void) {
     clrmn(findmn(j = getrq()));
 
     if (j)
-        contab[oldmn].rq = (contab[oldmn].rq & MMASK) | j;
+        setmn(oldmn, (contab[oldmn].rq & MMASK) | j);
 }
 
 static void caserm(void) {
@@ -207,6 +702,7 @@ void caseam(void) {
 
 void casede(void) {
     register int i, savoff, req;
+    int begin;
 
     if (dip->op)
         Wolf();
@@ -218,7 +714,7 @@ void casede(void) {
     if ((i = getrq()) == 0)
         goto de1;
 
-    if ((offset = finds(i)) == 0)
+    if ((begin = offset = finds(i)) == 0)
         goto de1;
 
     if (ds)
@@ -227,10 +723,12 @@ void casede(void) {
         req = copyb();
 
     wbfl();
+    if (!ds)
+        ctscan(begin);
     clrmn(oldmn);
 
     if (newmn)
-        contab[newmn].rq = i | MMASK;
+        setmn(newmn, i | MMASK);
 
     if (apptr) {
         savoff = offset;
@@ -249,27 +747,32 @@ de1:
 }
 
 int findmn(int i) {
-    int hash_index;
-    struct hash_entry *entry;
-
-    hash_index = hash_function(i);
-    entry = hash_table[hash_index];
-
-    while (entry) {
-        if (entry->key == i) {
-            return entry->value;
-        }
-        entry = entry->next;
-    }
-
-    return -1;
+    register unsigned k;
+
+    if (mntab == NULL)
+        mnhash();
+    for (k = mnslot(i); mntab[k].idx != MNFREE; k = (k + 1) & (mnsize - 1))
+        if (mntab[k].idx != MNGONE && mntab[k].name == i)
+            return (mntab[k].idx);
+    return (-1);
 }
 
 void clrmn(int i) {
+    register int k;
+
     if (i >= 0) {
+        for (k = 1; k <= dilev && k < NDI; k++)
+            if (dislot[k] == i)
+                dislot[k] = -1;
+        if (mnend)
+            mnend[i] = 0;
+        strmod(i);
         if (contab[i].rq & MMASK)
             blk_free(contab[i].f.offset);
-        contab[i].rq = 0;
+        if (contab[i].rq != 0) {
+            setmn(i, 0);
+            mnfree[mnnfree++] = i;
+        }
         contab[i].f.offset = 0;
     }
 }
@@ -281,40 +784,41 @@ int finds(int mn) {
     newmn = apptr = aplnk = 0;
 
     if (app && (oldmn >= 0) && (contab[oldmn].rq & MMASK)) {
-        savip = ip;
-        ip = contab[oldmn].f.offset;
+        /* Append at the closing word, walking to it only if unknown */
+        mnwrite = oldmn;
+        strmod(oldmn);
+        if ((apptr = mnend[oldmn]) == 0) {
+            savip = ip;
+            ip = contab[oldmn].f.offset;
+            while ((i = rbf()) != 0)
+                ;
+            apptr = ip;
+            ip = savip;
+        }
         oldmn = -1;
-
-        while ((i = rbf()) != 0)
-            ;
-
-        apptr = ip;
-        if (!diflg)
-            ip = incoff(ip);
-        nextb = ip;
-        ip = savip;
+        nextb = diflg ? apptr : incoff(apptr);
     } else {
-        for (i = 0; i < NM; i++) {
-            if (contab[i].rq == 0)
-                break;
-        }
-
-        if ((i == NM) || (nextb = alloc()) == 0) {
+        if (mntab == NULL)
+            mnhash();
+        if ((mnnfree == 0 && mngrow() < 0) || (nextb = alloc()) == 0) {
             app = 0;
+            mnwrite = -1;
             if (macerr++ > 1)
                 done2(02);
             edone(04);
             return (offset = 0);
         }
 
+        i = mnfree[--mnnfree];
         contab[i].f.offset = nextb;
+        mnwrite = i;
 
         if (!diflg) {
             newmn = i;
             if (oldmn == -1)
                 contab[i].rq = -1;
         } else {
-            contab[i].rq = mn | MMASK;
+            setmn(i, mn | MMASK);
         }
     }
 
@@ -334,7 +838,8 @@ int skip(void) {
 
 int copyb(void) {
     register int i, j, k;
-    int ii, req, state, savoff;
+    int ii, req, state, savoff, n;
+    int run[BLK];
 
     if (skip() || !(j = getrq()))
         j = '.';
@@ -349,6 +854,13 @@ int copyb(void) {
     state = 1;
 
     while (1) {
+        /* Past the start of a line only the newline matters */
+        if ((state == 0) && ((n = getcopy(run, BLK)) > 0)) {
+            if (offset)
+                wbfs(run, n);
+            continue;
+        }
+
         i = (ii = getch()) & CMASK;
 
         if (state == 3) {
@@ -392,7 +904,7 @@ int copyb(void) {
     if (offset) {
         wbfl();
         offset = savoff;
-        wbt(0);
+        wbend(mnwrite);
     }
 
     copyf--;
@@ -414,70 +926,197 @@ void copys(void) {
         wbf(i);
 
 c0:
-    wbt(0);
+    wbend(mnwrite);
     copyf--;
 }
 
 /* Memory management */
-int alloc(void) {
-    register int i;
-    int j;
+/*
+ * Block allocation
+ *
+ * Free blist entries sit on the bfree stack, so alloc() and each step
+ * of blk_free() are O(1).  When the stack is empty blist doubles (the
+ * first time off its static array), so storage is limited only by
+ * memory and, past mspill blocks, by the size of ibf.
+ */
+void blkinit(void) {
+    register int j;
 
-    for (i = 0; i < NBLIST; i++) {
-        if (blist[i] == 0)
-            break;
+    rwin.e = wwin.e = 0;
+    xcinit();
+    ctinit();
+    OSA_FREE(bfree);
+    if ((bfree = OSA_MALLOC(nblist * sizeof(int))) == NULL) {
+        prstrfl("Core limit reached.\n");
+        done2(0100);
+    }
+    nbfree = nblkuse = 0;
+    for (j = nblist - 1; j >= 0; j--) {
+        if (blist[j] == 0)
+            bfree[nbfree++] = j;
+        else
+            nblkuse++;
     }
+    if (nblkuse > nblkpeak)
+        nblkpeak = nblkuse;
+}
 
-    if (i == NBLIST) {
-        return (nextb = 0);
+/* Grow blist to at least n entries; -1 if memory runs out */
+int blkroom(int n) {
+    int *b, *f, j, k;
+
+    if (bfree == NULL)
+        blkinit();
+    for (k = nblist; k < n; k <<= 1)
+        ;
+    if (k == nblist)
+        return (0);
+    if (blist == blisti0) {
+        if ((b = OSA_MALLOC(k * sizeof(int))) != NULL)
+            memcpy(b, blist, nblist * sizeof(int));
     } else {
-        blist[i] = -1;
-        if ((j = boff(i)) < NEV_COUNT * EVS_SIZE)
-            return (nextb = 0);
-        return (nextb = j);
+        b = OSA_REALLOC(blist, k * sizeof(int));
     }
+    if (b == NULL)
+        return (-1);
+    memset(&b[nblist], 0, (k - nblist) * sizeof(int));
+    blist = b;
+    if ((f = OSA_REALLOC(bfree, k * sizeof(int))) == NULL)
+        return (-1);
+    bfree = f;
+    for (j = k - 1; j >= nblist; j--)
+        bfree[nbfree++] = j;
+    nblist = k;
+    return (0);
+}
+
+int alloc(void) {
+    register int i;
+
+    if (bfree == NULL)
+        blkinit();
+    if ((nbfree == 0) && (blkroom(2 * nblist) < 0))
+        return (nextb = 0);
+
+    i = bfree[--nbfree];
+    blist[i] = -1;
+    if (++nblkuse > nblkpeak)
+        nblkpeak = nblkuse;
+    CAPBLK(nblkuse);
+    return (nextb = boff(i));
 }
 
 void blk_free(int i) {
-    register int j;
+    register int j, k;
 
-    while ((blist[j = blisti(i)]) != -1) {
-        i = blist[j];
+    if (bfree == NULL)
+        blkinit();
+    rwin.e = wwin.e = 0;
+    for (j = blisti(i); j >= 0 && j < nblist && blist[j] != 0; j = k) {
+        k = blist[j];
         blist[j] = 0;
+        bfree[nbfree++] = j;
+        nblkuse--;
+        xcfree(j);
+        ctfree(j);
+        otroff_blkstore_release(mst(), boff(j));
+        if (k == -1)
+            break;
+        k = blisti(k);
     }
-    blist[j] = 0;
 }
 
 int boff(int i) {
-    return (NEV_COUNT * EVS_SIZE + i * BLK);
+    return (BLKBASE + i * BLK);
 }
 
 int blisti(int i) {
-    return ((i - NEV_COUNT * EVS_SIZE) / (BLK));
+    return ((i - BLKBASE) / (BLK));
+}
+
+/*
+ * Buffer I/O
+ *
+ * Macro, string and diversion words live in the in-core block store;
+ * addresses keep the old temp-file layout so that the blist chains and
+ * every caller of offset/ip stay unchanged.  Once more than mspill blocks
+ * are resident, further blocks spill to ibf through the store's single
+ * staging block, so wbfl() only has real work to do in that case.
+ *
+ * A macro or diversion is thus a chain of in-core chunks.  rbf0() and
+ * wbf() each keep a window on the resident block they are in, so that
+ * replaying or filling a chain indexes straight into the chunk and the
+ * store is only asked again at a block boundary.  The closing 0 word of
+ * each macro is remembered in mnend[], so .am, .as and .da go straight
+ * to the end instead of rereading the whole body.
+ */
+static otroff_blkstore_t *mst(void) {
+    if (!mstore_ok) {
+        if (otroff_blkstore_init(&mstore, BLK, BLKBASE, mspill) < 0) {
+            prstrfl("Core limit reached.\n");
+            edone(0100);
+        }
+        otroff_blkstore_set_spill_open(&mstore, ibfopen, NULL);
+        mstore_ok++;
+    }
+    return (&mstore);
+}
+
+/* Word at store address p through window b; NULL if never written */
+static int *bword(struct bwin *b, int p, int write) {
+    size_t n;
+
+    if (p >= b->a && p < b->e)
+        return (&b->w[p - b->a]);
+    if (write && otroff_blkstore_lent(mst(), p)) {
+        rwin.e = 0; /* it may be reading the words lent */
+        if (otroff_blkstore_word(mst(), p, 1) == NULL)
+            return (NULL);
+    }
+    if ((b->w = otroff_blkstore_span(mst(), p, &n)) != NULL) {
+        b->a = p;
+        b->e = p + (int)n;
+        return (b->w);
+    }
+    b->a = b->e = 0;
+    return (otroff_blkstore_word(mst(), p, write));
+}
+
+/* The macro store, for the -M report; NULL until the first macro */
+const otroff_blkstore_t *mstorep(void) {
+    return (mstore_ok ? &mstore : NULL);
 }
 
-/* Buffer I/O */
 void wbt(int i) {
     wbf(i);
     wbfl();
 }
 
+/* Close the body being written, noting where for contab slot k */
+static void wbend(int k) {
+    if (k >= 0 && mnend)
+        mnend[k] = offset;
+    strmod(k);
+    wbt(0);
+}
+
 void wbf(int i) {
     register int j;
+    register int *p;
 
     if (!offset)
         return;
 
-    if (!woff) {
+    if (!woff)
         woff = offset;
-        wbfi = 0;
-    }
 
-    wbuf[wbfi++] = i;
+    if ((p = bword(&wwin, offset, 1)) == NULL) {
+        prstr("Out of temp file space.\n");
+        done2(01);
+    }
+    *p = i;
 
     if (!((++offset) & (BLK - 1))) {
-        wbfl();
-
         if (blist[j = blisti(--offset)] == -1) {
             if (alloc() == 0) {
                 prstr("Out of temp file space.\n");
@@ -487,20 +1126,42 @@ void wbf(int i) {
         }
         offset = blist[j];
     }
+}
 
-    if (wbfi >= BLK)
-        wbfl();
+/* wbf() for n words, copied a resident span at a time */
+void wbfs(const int *w, int n) {
+    register int *p;
+    int m;
+
+    while (n > 0 && offset) {
+        /* The last word of a block goes through wbf() to chain the next */
+        m = BLK - 1 - (offset & (BLK - 1));
+        if (m == 0 || (p = bword(&wwin, offset, 1)) == NULL || offset >= wwin.e) {
+            wbf(*w++);
+            n--;
+            continue;
+        }
+        if (m > n)
+            m = n;
+        if (m > wwin.e - offset)
+            m = wwin.e - offset;
+        if (!woff)
+            woff = offset;
+        memcpy(p, w, m * sizeof(int));
+        offset += m;
+        w += m;
+        n -= m;
+    }
 }
 
 void wbfl(void) {
     if (woff == 0)
         return;
 
-    seek(ibf, woff << 1, 0); /* Assuming woff is a byte offset or seek handles it */
-    write(ibf, (char *)(wbuf), wbfi << 1); /* wbuf is int[], treat as char* for write */
-
-    if ((woff & (~(BLK - 1))) == (roff & (~(BLK - 1))))
-        roff = -1;
+    if (otroff_blkstore_sync(mst()) < 0) {
+        prstr("Out of temp file space.\n");
+        done2(01);
+    }
 
     woff = 0;
 }
@@ -518,17 +1179,97 @@ int rbf(void) {
     return (i);
 }
 
-int rbf0(int p) {
+/* rbf() for a short string read through sp */
+int rbs(void) {
     register int i;
 
-    if ((i = (p & (~(BLK - 1)))) != roff) {
-        roff = i;
-        seek(ibf, roff << 1, 0); /* Assuming roff is a byte offset or seek handles it */
-        if (read(ibf, (char *)(rbuf), BLK << 1) == 0) /* rbuf is int[], treat as char* for read */
-            return (0);
+    if ((i = *sp) == 0) {
+        if (!app)
+            i = popi();
+    } else {
+        sp++;
+    }
+
+    return (i);
+}
+
+/*
+ * rbskip - getskip() for the macro being read
+ *
+ * Moves ip past the printable words ahead, other than the escape
+ * character, a block at a time.  Their widths are charged to v.hp as
+ * getch() would, unless a newline follows them, which starts it over.
+ * Returns the number passed.
+ */
+int rbskip(void) {
+    register int *q, c, k;
+    int p, n, lim, w;
+
+    c = 0;
+    for (p = ip, n = 0;;) {
+        if ((q = bword(&rwin, p, 0)) == NULL)
+            break;
+        lim = (p | (BLK - 1)) + 1;
+        if (rwin.e <= p)
+            lim = p + 1; /* not in a window: this word alone */
+        else if (rwin.e < lim)
+            lim = rwin.e;
+        for (k = p; (k < lim) && ((c = *q) >= 040) && (c < 0177) && (c != eschar); k++)
+            q++;
+        n += k - p;
+        if (k < lim) {
+            p = k;
+            break;
+        }
+        c = 0;
+        p = (k & (BLK - 1)) ? k : incoff(k - 1);
+    }
+    if (n && (c != '\n'))
+        for (c = 0, k = ip; c < n; c++, k = incoff(k)) {
+            w = width(rbf0(k));
+            v.hp += w;
+            cwidth = w;
+        }
+    ip = p;
+    return (n);
+}
+
+int rbf0(int p) {
+    register int *q;
+
+    if ((q = bword(&rwin, p, 0)) == NULL)
+        return (0);
+
+    return (*q);
+}
+
+/* Copy block i (a blist index) out of or into macro storage whole */
+void blkget(int i, int *buf) {
+    register int j;
+
+    for (j = 0; j < BLK; j++)
+        buf[j] = rbf0(boff(i) + j);
+}
+
+/* Have block i read from words a snapshot maps, until it is written */
+void blklend(int i, const int *words) {
+    if (otroff_blkstore_lend(mst(), boff(i), words) < 0) {
+        prstrfl("Core limit reached.\n");
+        edone(0100);
     }
+}
 
-    return (rbuf[p & (BLK - 1)]);
+void blkput(int i, const int *buf) {
+    register int j, *p;
+
+    for (j = 0; j < BLK; j++) {
+        if ((p = otroff_blkstore_word(mst(), boff(i) + j, 1)) == NULL) {
+            prstr("Out of temp file space.\n");
+            done2(01);
+        }
+        *p = buf[j];
+    }
+    otroff_blkstore_sync(mst());
 }
 
 int incoff(int p) {
@@ -545,60 +1286,141 @@ int incoff(int p) {
     return (j);
 }
 
-/* Stack management with proper type handling */
+/*
+ * Macro call frames
+ *
+ * Each call level owns a chunk from frs[]: word 0 is the argument
+ * count, words 1-9 the offsets of \$1-\$9 within the chunk and the
+ * argument strings follow from word STKSIZE, so seta() is a direct
+ * index.  The caller's input state is saved in the chunk record.
+ * Chunks form a stack: frtop is the first free one, which is where
+ * collect() gathers arguments and nxf points; it holds that chunk
+ * while reading so that strings interpolated while collecting get
+ * their own.  popi() releases a chunk but keeps its memory for the
+ * next call at that level.
+ */
+struct frchunk {
+    int *w; /* count, argument offsets, argument strings */
+    int size; /* words allocated at w */
+    int prev; /* chunk of the calling frame */
+    int ip, nchar, rchar, pendt, ch0, ch; /* caller's input state */
+    int *ap, *cp, *sp;
+};
+
+static struct frchunk *frs; /* chunk stack */
+static int nfrs; /* chunks allocated */
+static int frtop; /* first free chunk */
+int frlev; /* chunk of the current frame, 0 at top level */
+int frpeak; /* most chunks in use at once */
+
+static void frcore(void) {
+    prstrfl("Core limit reached.\n");
+    edone(0100);
+}
+
+/* Make chunk c exist with room for at least n words */
+static int *frroom(int c, int n) {
+    struct frchunk *f;
+    int *w, k;
+
+    if (c >= nfrs) {
+        k = nfrs ? 2 * nfrs : 16;
+        while (k <= c)
+            k <<= 1;
+        if ((f = OSA_REALLOC(frs, k * sizeof(*f))) == NULL) {
+            frcore();
+            return (NULL);
+        }
+        memset(&f[nfrs], 0, (k - nfrs) * sizeof(*f));
+        frs = f;
+        nfrs = k;
+    }
+    if (n > frs[c].size) {
+        k = frs[c].size ? 2 * frs[c].size : 4 * STKSIZE;
+        while (k < n)
+            k <<= 1;
+        if ((w = OSA_REALLOC(frs[c].w, k * sizeof(int))) == NULL) {
+            frcore();
+            return (NULL);
+        }
+        if (!frs[c].size)
+            w[0] = 0;
+        frs[c].w = w;
+        frs[c].size = k;
+    }
+    return (frs[c].w);
+}
+
+/* Back to top level, e.g. for .nx or when finishing */
+void frreset(void) {
+    if (profon)
+        profpop(1);
+    TRPOP(1);
+    frlev = frtop = 0;
+    sp = 0;
+    frame = stk = frroom(0, STKSIZE);
+    frtop = 1;
+    nxf = frroom(1, STKSIZE);
+}
+
 int popi(void) {
-    register int *p;
+    register struct frchunk *f;
 
-    if (frame == stk)
+    if (frlev == 0)
         return (0);
 
     if (strflg)
         strflg--;
 
-    p = nxf = frame;
-    *p++ = 0;
-    frame = (int *)((intptr_t)(*p++));
-    ip = *p++;
-    nchar = *p++;
-    rchar = *p++;
-    pendt = *p++;
-    ap = (int *)((intptr_t)(*p++));
-    cp = (int *)((intptr_t)(*p++));
-    ch0 = *p++;
-
-    return (*p);
+    if (profon)
+        profpop(frlev);
+    TRPOP(frlev);
+    f = &frs[frlev];
+    f->w[0] = 0;
+    ip = f->ip;
+    nchar = f->nchar;
+    rchar = f->rchar;
+    pendt = f->pendt;
+    ap = f->ap;
+    cp = f->cp;
+    sp = f->sp;
+    ch0 = f->ch0;
+
+    frtop = frlev;
+    frlev = f->prev;
+    frame = frs[frlev].w;
+    nxf = frs[frtop].w;
+
+    return (f->ch);
 }
 
 int pushi(int newip) {
-    register int *p;
-
-    if ((enda - (STKSIZE << 1)) < (char *)(nxf))
-        setbrk(DELTA);
-
-    p = nxf;
-    p++;
-    /* Assuming these stored integers are meant to be pointer addresses or derived from them */
-    *p++ = ((int)((intptr_t)(frame)));
-    *p++ = ip;
-    *p++ = nchar;
-    *p++ = rchar;
-    *p++ = pendt;
-    *p++ = ((int)((intptr_t)(ap)));
-    *p++ = ((int)((intptr_t)(cp)));
-    *p++ = ch0;
-    *p++ = ch;
-
-    cp = 0;
+    register struct frchunk *f;
+
+    frroom(frtop, STKSIZE);
+    f = &frs[frtop];
+    f->prev = frlev;
+    f->ip = ip;
+    f->nchar = nchar;
+    f->rchar = rchar;
+    f->pendt = pendt;
+    f->ap = ap;
+    f->cp = cp;
+    f->sp = sp;
+    f->ch0 = ch0;
+    f->ch = ch;
+
+    cp = sp = 0;
     nchar = rchar = pendt = 0;
     ap = 0;
     ch0 = ch = 0;
 
-    frame = nxf;
-
-    if (*nxf == 0)
-        nxf = (int *)((char *)(nxf) + STKSIZE);
-    else
-        nxf = argtop; /* Assuming argtop is int* */
+    frame = f->w;
+    frlev = frtop++;
+    if (frtop > frpeak)
+        frpeak = frtop;
+    CAPDEPTH(frlev);
+    nxf = frroom(frtop, STKSIZE);
 
     return (ip = newip);
 }
@@ -606,7 +1428,7 @@ int pushi(int newip) {
 char *setbrk(int x) {
     register char *i;
 
-    if ((i = ((char*)malloc(((size_t)x)))) == NULL) {
+    if ((i = ((char*)OSA_MALLOC(((size_t)x)))) == NULL) {
         prstrfl("Core limit reached.\n");
         edone(0100);
     } else {
@@ -630,31 +1452,36 @@ int getsn(void) {
 
 int setstr(void) {
     register int i;
+    int *w;
 
     lgf++;
 
     if (((i = getsn()) == 0) ||
+        (nfw && fwtext(i, 0)) ||
         ((i = findmn(i)) == -1) ||
         !(contab[i].rq & MMASK)) {
         lgf--;
         return (0);
     } else {
-        if ((enda - 2) < (char *)nxf)
-            setbrk(DELTA);
-
         *nxf = 0;
         strflg++;
         lgf--;
-        return (pushi(contab[i].f.offset));
+        w = strget(i);
+        pushi(contab[i].f.offset);
+        sp = w;
+        return (ip);
     }
 }
 
-/* Argument handling */
+/*
+ * Argument handling
+ *
+ * Gathers up to nine arguments into the free chunk at nxf for the
+ * pushi() that follows.
+ */
 void collect(void) {
-    register int i;
-    register int *strp;
-    int *argpp, *argppend;
-    int quote, *savnxf, *lim;
+    register int i, n;
+    int c, argc, quote, *w;
 
     copyf++;
     *nxf = 0;
@@ -662,18 +1489,16 @@ void collect(void) {
     if (skip())
         goto rtn;
 
-    savnxf = nxf;
-    lim = nxf = (int *)((char *)(nxf) + 20 * STKSIZE);
+    c = frtop++; /* hold the chunk while reading */
     strflg = 0;
-
-    if ((argppend = strp = (argpp = savnxf + STKSIZE) + 9) > (int *)(enda))
-        setbrk(DELTA);
-
-    for (i = 8; i >= 0; i--)
-        argpp[i] = 0;
-
-    while ((argpp != argppend) && (!skip())) {
-        *argpp++ = ((int)((intptr_t)(strp)));
+    w = frroom(c, STKSIZE);
+    for (i = 1; i < STKSIZE; i++)
+        w[i] = 0;
+
+    n = STKSIZE;
+    argc = 0;
+    while ((argc < 9) && (!skip())) {
+        frs[c].w[++argc] = n;
         quote = 0;
 
         if (((i = getch()) & CMASK) == '"')
@@ -693,24 +1518,23 @@ void collect(void) {
                 break;
             }
 
-            *strp++ = i;
-
-            if (strflg && (strp >= lim)) {
+            if (strflg && (n >= 20 * STKSIZE)) {
                 prstrfl("Macro argument too long.\n");
                 copyf--;
                 edone(004);
             }
 
-            if ((enda - 4) <= (char*)(strp)) /* Cast strp to char* for comparison */
-                setbrk(DELTA);
+            frroom(c, n + 2)[n] = i;
+            n++;
         }
 
-        *strp++ = 0;
+        frroom(c, n + 1)[n] = 0;
+        n++;
     }
 
-    nxf = savnxf;
-    *nxf = (argpp - nxf - STKSIZE); /* Pointer difference is already in int elements */
-    argtop = strp;
+    frtop = c;
+    nxf = frs[c].w;
+    *nxf = argc;
 
 rtn:
     copyf--;
@@ -721,7 +1545,7 @@ void seta(void) {
 
     if (((i = (getch() & CMASK) - '0') > 0) &&
         (i <= 9) && (i <= *frame))
-        ap = (int *)((intptr_t)(*(i + frame + STKSIZE - 1)));
+        ap = frame + frame[i];
 }
 
 /* Diversion functions */
@@ -737,9 +1561,10 @@ void casedi(void) {
 
     if (skip() || ((i = getrq()) == 0)) {
         if (dip->op > 0)
-            wbt(0);
+            wbend(dislot[dilev]);
 
         if (dilev > 0) {
+            TRDIV(dip->curd, 0);
             v.dn = dip->dnl;
             v.dl = dip->maxl;
             dip = (struct env *)(&d[--dilev]);
@@ -755,12 +1580,15 @@ void casedi(void) {
     }
 
     if (dip->op)
-        wbt(0);
+        wbend(dislot[dilev - 1]);
 
     diflg++;
     dip = (struct env *)(&d[dilev]);
     dip->op = finds(i);
     dip->curd = i;
+    capdw[dilev] = 0;
+    TRDIV(i, 1);
+    dislot[dilev] = dip->op ? mnwrite : -1;
     clrmn(oldmn);
 
     for (j = 1; j <= 10; j++)
@@ -786,57 +1614,159 @@ void casedt(void) {
     dip->dimac = getrq();
 }
 
+/*
+ * Titles
+ *
+ * casetl() reads the title into tlbuf[] rather than through the macro
+ * store, and measures its three parts once for each title it has seen:
+ * the header and footer of most documents are the same on every page
+ * but for the page number.  A title seen before takes the widths of its
+ * plain characters from tlcache[], keyed by its characters as read, with
+ * their font and size bits, and pagech; only the page numbers in it are
+ * measured again.  widflush() makes every entry stale through widgen.
+ */
+#define NTLC 4 /* titles kept, the header and footer of odd and even pages */
+
+extern int widgen;
+
+static struct tlent {
+    int *item; /* the characters, IMP between the parts */
+    int n, pagech;
+    int gen; /* widgen plus one when measured, 0 if the entry is empty */
+    int w[3]; /* the widths of the plain characters of each part */
+} tlcache[NTLC];
+
+static int *tlbuf, ntlbuf; /* the title being read */
+static int tlnext; /* the entry to fill next */
+
+/* Add i to the title being read; -1 if there is no room for it */
+static int tladd(int n, int i) {
+    int *b, m;
+
+    if (n >= ntlbuf) {
+        m = ntlbuf ? 2 * ntlbuf : 256;
+        if ((b = OSA_REALLOC(tlbuf, m * sizeof(*b))) == NULL)
+            return (-1);
+        tlbuf = b;
+        ntlbuf = m;
+    }
+    tlbuf[n] = i;
+    return (0);
+}
+
+/*
+ * The n characters at p through f, as hseg() puts a part of a title
+ * through it: the characters other than pagech if plain is set, else
+ * the page number where pagech is
+ */
+static int tlseg(int (*f)(int), const int *p, int n, int plain) {
+    register int acc, i;
+
+    for (acc = 0; n-- > 0;) {
+        if (((i = *p++) & CMASK) == pagech) {
+            if (plain)
+                continue;
+            nrbits = i & ~CMASK;
+            nform = fmt[findr('%')];
+            acc += fnumb(v.pn, f);
+        } else if (plain) {
+            acc += (*f)(i);
+        }
+    }
+    return (acc);
+}
+
+/* Put the n characters at p out, the page number where pagech is */
+static void tlout(const int *p, int n) {
+    register int i;
+
+    while (n-- > 0) {
+        if (((i = *p++) & CMASK) == pagech) {
+            nrbits = i & ~CMASK;
+            nform = fmt[findr('%')];
+            fnumb(v.pn, pchar_wrapper_for_hseg);
+        } else {
+            pchar(i);
+        }
+    }
+}
+
 /* Title processing */
 void casetl(void) {
-    register int i, j;
-    int w1, w2, w3, begin, delim;
+    register int i, k;
+    int w[3], at[3], len[3], j, n, delim;
+    struct tlent *e;
 
     dip->nls = 0;
     skip();
 
-    if (dip->op)
-        wbfl();
-
-    if ((offset = begin = alloc()) == 0)
-        return;
-
     if ((delim = getch()) & MOT) {
         ch = delim;
         delim = '\'';
     } else
         delim &= CMASK;
 
+    n = 0;
     if (!nlflg)
         while (((i = getch()) & CMASK) != '\n') {
             if ((i & CMASK) == delim)
                 i = IMP;
-            wbf(i);
+            if (tladd(n, i) < 0) {
+                prstr("Out of memory for the title.\n");
+                break;
+            }
+            n++;
         }
 
-    wbf(IMP);
-    wbf(IMP);
-    wbt(0);
-
-    w1 = hseg(width, (int *)((intptr_t)(begin)));
-    w2 = hseg(width, NULL);
-    w3 = hseg(width, NULL);
+    /* The parts, each up to an IMP */
+    for (i = k = 0; k < 3; k++) {
+        at[k] = i;
+        while ((i < n) && (tlbuf[i] != IMP))
+            i++;
+        len[k] = i - at[k];
+        if (i < n)
+            i++;
+    }
 
-    offset = dip->op;
+    for (e = tlcache; e < tlcache + NTLC; e++)
+        if ((e->gen == widgen + 1) && (e->n == n) && (e->pagech == pagech) &&
+            (n == 0 || !memcmp(e->item, tlbuf, n * sizeof(int))))
+            break;
+    if (e == tlcache + NTLC) {
+        e = &tlcache[tlnext];
+        e->gen = 0;
+        if ((e->item = OSA_REALLOC(e->item, (n ? n : 1) * sizeof(int))) != NULL) {
+            tlnext = (tlnext + 1) % NTLC;
+            if (n > 0) /* tlbuf is NULL until a title has had an item */
+                memcpy(e->item, tlbuf, n * sizeof(int));
+            e->n = n;
+            e->pagech = pagech;
+            for (k = 0; k < 3; k++)
+                e->w[k] = tlseg(width, tlbuf + at[k], len[k], 1);
+            e->gen = widgen + 1;
+        } else {
+            e = NULL;
+        }
+    }
+    for (k = 0; k < 3; k++)
+        w[k] = ((e != NULL) ? e->w[k] : tlseg(width, tlbuf + at[k], len[k], 1)) +
+               tlseg(width, tlbuf + at[k], len[k], 0);
 
 #ifdef NROFF
-    if (!offset)
+    if (!dip->op)
         horiz(po);
 #endif
 
-    hseg(pchar_wrapper_for_hseg, (int *)((intptr_t)(begin))); /* Use wrapper for pchar */
+    tlout(tlbuf + at[0], len[0]);
 
-    if (w2 || w3)
-        horiz(j = quant((lt - w2) / 2 - w1, HOR));
-    hseg(pchar_wrapper_for_hseg, NULL); /* Use wrapper for pchar */
+    j = 0;
+    if (w[1] || w[2])
+        horiz(j = quant((lt - w[1]) / 2 - w[0], HOR));
+    tlout(tlbuf + at[1], len[1]);
 
-    if (w3) {
-        horiz(lt - w1 - w2 - w3 - j);
-        hseg(pchar_wrapper_for_hseg, NULL); /* Use wrapper for pchar */
+    if (w[2]) {
+        horiz(lt - w[0] - w[1] - w[2] - j);
+        tlout(tlbuf + at[2], len[2]);
     }
 
     newline(0);
@@ -848,8 +1778,6 @@ void casetl(void) {
         if (v.nl > dip->hnl)
             dip->hnl = v.nl;
     }
-
-    blk_free(begin);
 }
 
 void casepc(void) {
@@ -898,7 +1826,7 @@ void casepm(void) {
     kk = cnt = 0;
     tot = !skip();
 
-    for (i = 0; i < NM; i++) {
+    for (i = 0; i < ncontab; i++) {
         if (!((xx = contab[i].rq) & MMASK))
             continue;
 
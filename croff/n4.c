@@ -52,6 +52,9 @@
 #include "tdef.h" // troff definitions
 #include "env.h"  // environment structure
 #include "t.h"    // troff header
+#include "fwref.h" // forward references
+#define OSA_TAG "croff.regs"
+#include "os/os_acct.h" // OSA_MALLOC, OSA_REALLOC, OSA_FREE
 
 #include <stdio.h> /* C90: standard I/O functions */
 #include <stdlib.h> /* C90: exit, abs, etc. */
@@ -64,10 +67,11 @@ static char Sccsid[] = "@(#)n4.c  1.4 of 4/26/77";
 extern int ascii; /* ASCII mode flag */
 extern int cbuf[NC]; /* Character buffer */
 extern int *cp; /* Character buffer pointer */
-extern int r[NN]; /* Number register names */
-extern int *vlist; /* Number register values */
-extern int inc[NN]; /* Number register increments */
-extern int fmt[NN]; /* Number register formats */
+extern int *r; /* Number register names */
+extern int *vlist; /* Number register values, first NN */
+extern int *inc; /* Number register increments */
+extern int *fmt; /* Number register formats */
+extern int nnr; /* Number register slots */
 extern int ch; /* Current input character */
 extern int lgf; /* Line gathering flag */
 extern int *frame; /* Frame stack pointer */
@@ -101,14 +105,75 @@ extern int ad, admod; /* Adjustment mode and modifier */
 extern int print; /* Print flag */
 extern int ls; /* Line spacing multiplier */
 extern int xxx; /* Temporary variable */
+extern int ip; /* Macro input offset */
+extern int *sp; /* Short string pointer */
+extern int *ap; /* Argument pointer */
+extern int ch0, nchar; /* Pending getch0() character and repeat count */
+extern int nlflg; /* Newline seen */
+extern int level; /* getch() nesting level */
+extern int copyf, raw; /* Copy mode and raw input */
+extern int eschar, fc, tabch, ldrch; /* Escape, field, tab and leader */
+extern int chbits; /* Character bits */
 
 /* Command table structure */
 extern struct contab {
     int rq; /* Request name */
     int (*f)(void); /* Function pointer - C90 style */
-} contab[NM];
+} *contab;
+extern int ncontab;
+
+/*
+ * Number register index
+ *
+ * Names map to register slots through an open-addressed table of slot
+ * numbers (the name is read back from r[]), probed linearly and doubled
+ * at 70% load.  Slots freed by .rr sit on nrfree, and all the register
+ * arrays double when it runs dry; values past the first NN, which live
+ * in v, are kept in xvlist.
+ */
+#define NRMIN 256 /* initial index size, a power of two */
+#define NRFREE (-1) /* never used index entry */
+#define NRGONE (-2) /* deleted index entry */
+
+static int *nrtab; /* name index: slot, NRFREE or NRGONE */
+static int nrsize; /* entries in nrtab */
+static int nrfill; /* live plus deleted entries */
+static int *nrfree; /* stack of unused register slots */
+static int nrnfree;
+static int *xvlist; /* values of slots NN and up */
+static int nrgrown; /* r[], inc[] and fmt[] live on the heap */
+
+#define NRFC 16 /* longest formatted value kept */
+
+/* What \n last made of a register slot, and the value and format it was of */
+struct nrfc {
+    int val;
+    int form;
+    int n; /* characters in s, 0 if none are kept */
+    char s[NRFC];
+};
+
+static struct nrfc *nrfc; /* by slot */
+static int nnrfc; /* slots in nrfc */
+
+/*
+ * Built-in registers that are plain variables, indexed by the second
+ * character of their .x name; the rest are computed in setn().
+ */
+static int *dotreg[128] = {
+    ['v'] = &lss, ['p'] = &pl, ['o'] = &po, ['l'] = &ll, ['i'] = &in,
+    ['A'] = &ascii, ['c'] = &v.cd, ['n'] = &lastl, ['a'] = &ralss,
+    ['u'] = &fi, ['w'] = &cwidth, ['y'] = &font1, ['T'] = &dotT,
+    ['k'] = &ne, ['P'] = &print, ['L'] = &ls,
+};
 
 /* Function prototypes for static functions */
+static unsigned nrslot(int name);
+static int nralloc(int n);
+static int nrput(int j);
+static void nrdel(int j);
+static int nrlook(int name);
+static int nrgrow(void);
 static int fnumb(int i, int (*f)(int));
 static int decml(int i, int (*f)(int));
 static int roman(int i, int (*f)(int));
@@ -116,14 +181,24 @@ static int roman0(int i, int (*f)(int), char *onesp, char *fivesp);
 static int abc(int i, int (*f)(int));
 static int abc0(int i, int (*f)(int));
 static int wrc(int i);
+static void nrtext(int i, int f);
+static void nrform(int j, int i);
 static long atoi0(void);
 static long ckph(void);
 static long atoi1(void);
+static long atoi2(long acc, int c, int neg, int abs, int field, int digits);
 
 /* Function prototypes for module functions */
 void setn(void);
 void setn1(int i);
 int findr(int i);
+int *nrp(int j);
+int nrpeek(int j);
+int *nrchars(int i);
+extern int dateset; /* cvtime() has filled in the date registers */
+extern void cvtime(void);
+void nrhash(void);
+int nrroom(int n);
 int tatoi(void);
 void caserr(void);
 void casenr(void);
@@ -132,6 +207,8 @@ void vnumb(int *i);
 void hnumb(int *i);
 int inumb(int *n);
 int quant(int n, int m);
+void xcfree(int b);
+void xcinit(void);
 
 /* External function prototypes */
 extern int getch(void);
@@ -143,6 +220,10 @@ extern int alph(int c);
 extern void prstrfl(const char *s);
 extern void done2(int code);
 extern void edone(int code);
+extern int width(int c);
+extern int rbf0(int p);
+extern int incoff(int p);
+extern int blisti(int i);
 
 /*
  * setn - Set a number register
@@ -151,11 +232,11 @@ extern void edone(int code);
  * Supports increment/decrement operations and special registers.
  */
 void setn(void) {
-    register int i, j;
+    register int i;
     int f;
 
-    /* Initialize format and increment flag */
-    f = nform = 0;
+    /* Initialize increment flag */
+    f = 0;
 
     /* Check for increment (+) or decrement (-) prefix */
     if ((i = getch() & CMASK) == '+') {
@@ -171,48 +252,50 @@ void setn(void) {
         return; /* No register name found */
     }
 
+    if (nfw && fwtext(i, 1))
+        return;
+    nrtext(i, f);
+    cp = cbuf;
+}
+
+/* The characters \n would interpolate for register i, now, for fwdone() */
+int *nrchars(int i) {
+    int *c = cp;
+
+    nrtext(i, 0);
+    cp = c;
+    return (cbuf);
+}
+
+/*
+ * nrtext - Put the text \n would interpolate for register i in cbuf
+ *
+ * f is the increment applied first, as for \n+ and \n-.
+ */
+static void nrtext(int i, int f) {
+    register int j;
+
+    nform = 0;
+
     /* Handle built-in registers (those starting with '.') */
     if ((i & 0177) == '.') {
+        if ((unsigned)(j = i >> BYTE) < 128 && dotreg[j]) {
+            i = *dotreg[j];
+            goto s1;
+        }
         switch (i) {
         case 256 * 's' + '.': /* Point size (.s) */
             i = pts & 077;
             break;
-        case 256 * 'v' + '.': /* Vertical spacing (.v) */
-            i = lss;
-            break;
         case 256 * 'f' + '.': /* Font number (.f) */
             i = font + 1;
             break;
-        case 256 * 'p' + '.': /* Page length (.p) */
-            i = pl;
-            break;
         case 256 * 't' + '.': /* Distance to next trap (.t) */
             i = findt1();
             break;
-        case 256 * 'o' + '.': /* Page offset (.o) */
-            i = po;
-            break;
-        case 256 * 'l' + '.': /* Line length (.l) */
-            i = ll;
-            break;
-        case 256 * 'i' + '.': /* Indent (.i) */
-            i = in;
-            break;
         case 256 * '$' + '.': /* Number of arguments (.$) */
             i = *frame;
             break;
-        case 256 * 'A' + '.': /* ASCII flag (.A) */
-            i = ascii;
-            break;
-        case 256 * 'c' + '.': /* Current page number (.c) */
-            i = v.cd;
-            break;
-        case 256 * 'n' + '.': /* Length of last line (.n) */
-            i = lastl;
-            break;
-        case 256 * 'a' + '.': /* Adjustment mode (.a) */
-            i = ralss;
-            break;
         case 256 * 'h' + '.': /* High-water mark in diversion (.h) */
             i = dip->hnl;
             break;
@@ -223,46 +306,24 @@ void setn(void) {
                 i = v.nl;
             }
             break;
-        case 256 * 'u' + '.': /* Fill mode (.u) */
-            i = fi;
-            break;
         case 256 * 'j' + '.': /* Adjustment type (.j) */
             i = ad + 2 * admod;
             break;
-        case 256 * 'w' + '.': /* Width of last character (.w) */
-            i = cwidth;
-            break;
         case 256 * 'x' + '.': /* Underline font (.x) */
             i = ulfont + 1;
             break;
-        case 256 * 'y' + '.': /* Previous font (.y) */
-            i = font1;
-            break;
-        case 256 * 'T' + '.': /* Terminal type (.T) */
-            i = dotT;
-            break;
         case 256 * 'V' + '.': /* Vertical resolution (.V) */
             i = VERT;
             break;
         case 256 * 'H' + '.': /* Horizontal resolution (.H) */
             i = HOR;
             break;
-        case 256 * 'k' + '.': /* Current horizontal position (.k) */
-            i = ne;
-            break;
-        case 256 * 'P' + '.': /* Print mode (.P) */
-            i = print;
-            break;
-        case 256 * 'L' + '.': /* Line spacing (.L) */
-            i = ls;
-            break;
         case 256 * 'z' + '.': /* Name of current diversion (.z) */
             /* Special case: store diversion name in character buffer */
             i = dip->curd;
             cbuf[0] = i & BMASK;
             cbuf[1] = (i >> BYTE) & BMASK;
             cbuf[2] = 0;
-            cp = cbuf;
             return;
         default:
             goto s0; /* Not a built-in register */
@@ -274,14 +335,16 @@ void setn(void) {
             i = 0; /* Register not found */
         } else {
             /* Apply increment/decrement and get current value */
-            i = (vlist[j] = (vlist[j] + inc[j] * f));
+            i = (*nrp(j) += inc[j] * f);
             nform = fmt[j]; /* Use register's format */
+            nrform(j, i);
+            return;
         }
     }
 
+s1:
     /* Convert value to string and store in buffer */
     setn1(i);
-    cp = cbuf;
 }
 
 /*
@@ -301,11 +364,255 @@ void setn1(int i) {
     cp = cbuf; /* Reset pointer */
 }
 
+/*
+ * nrform - setn1() for register slot j, of value i in format nform
+ *
+ * Page and section numbers go into every header, footer and reference,
+ * unchanged from one to the next.  What fnumb() made of a slot is kept
+ * with the value and the format it was made from, and copied to cbuf
+ * while both are the same.  The value is compared rather than stamped
+ * because a register is stored through nrp() and vlist everywhere; the
+ * format stands for .af.  The characters depend on nothing else, so a
+ * slot freed by .rr and taken again, or restored from a snapshot, can
+ * keep them.
+ */
+static void nrform(int j, int i) {
+    struct nrfc *c, *t;
+    int k, form;
+
+    if (j >= nnrfc) {
+        if ((t = OSA_REALLOC(nrfc, nnr * sizeof(*t))) == NULL) {
+            setn1(i);
+            return;
+        }
+        memset(t + nnrfc, 0, (nnr - nnrfc) * sizeof(*t));
+        nrfc = t;
+        nnrfc = nnr;
+    }
+    c = &nrfc[j];
+    if (c->n > 0 && c->val == i && c->form == nform) {
+        for (k = 0; k < c->n; k++)
+            cbuf[k] = (unsigned char)c->s[k];
+        cbuf[k] = 0;
+        cp = cbuf;
+        return;
+    }
+    form = nform;
+    setn1(i);
+    for (k = 0; (k < NRFC) && cbuf[k]; k++)
+        c->s[k] = (char)cbuf[k];
+    c->n = cbuf[k] ? 0 : k;
+    c->val = i;
+    c->form = form;
+}
+
+static unsigned nrslot(int name) {
+    unsigned h = (unsigned)name * 2654435761u;
+
+    return ((h ^ (h >> 16)) & (unsigned)(nrsize - 1));
+}
+
+/* Allocate an empty index big enough for n names */
+static int nralloc(int n) {
+    int *t;
+    int k, size;
+
+    size = NRMIN;
+    while (n * 10 >= size * 7)
+        size <<= 1;
+    if ((t = OSA_MALLOC(size * sizeof(*t))) == NULL)
+        return (-1);
+    for (k = 0; k < size; k++)
+        t[k] = NRFREE;
+    OSA_FREE(nrtab);
+    nrtab = t;
+    nrsize = size;
+    nrfill = 0;
+    return (0);
+}
+
+/* Index register slot j under the name in r[j] */
+static int nrput(int j) {
+    register unsigned k;
+    int gone;
+
+    if ((nrfill + 1) * 10 >= nrsize * 7) {
+        int *t = nrtab;
+        int m, n = nrsize, live = 0;
+
+        /* Rehash; size from the live names so tombstones are dropped. */
+        for (m = 0; m < n; m++)
+            if (t[m] >= 0)
+                live++;
+        nrtab = NULL;
+        if (nralloc(2 * live) < 0) {
+            nrtab = t;
+            if (nrfill + 1 >= nrsize)
+                return (-1);
+        } else {
+            for (m = 0; m < n; m++)
+                if (t[m] >= 0)
+                    nrput(t[m]);
+            OSA_FREE(t);
+        }
+    }
+    gone = -1;
+    for (k = nrslot(r[j]); nrtab[k] != NRFREE; k = (k + 1) & (nrsize - 1))
+        if (nrtab[k] == NRGONE && gone < 0)
+            gone = k;
+    if (gone >= 0) {
+        k = gone;
+    } else {
+        nrfill++;
+    }
+    nrtab[k] = j;
+    return (0);
+}
+
+/* Remove register slot j from the index */
+static void nrdel(int j) {
+    register unsigned k;
+
+    for (k = nrslot(r[j]); nrtab[k] != NRFREE; k = (k + 1) & (nrsize - 1)) {
+        if (nrtab[k] == j) {
+            nrtab[k] = NRGONE;
+            return;
+        }
+    }
+}
+
+static int nrlook(int name) {
+    register unsigned k;
+
+    if (nrtab == NULL)
+        nrhash();
+    for (k = nrslot(name); nrtab[k] != NRFREE; k = (k + 1) & (nrsize - 1))
+        if (nrtab[k] >= 0 && r[nrtab[k]] == name)
+            return (nrtab[k]);
+    return (-1);
+}
+
+/*
+ * nrhash - (Re)build the register index and free-slot stack from r[]
+ *
+ * Called lazily on first lookup and after a snapshot restores r[].
+ */
+void nrhash(void) {
+    register int j;
+    int n;
+
+    n = 0;
+    for (j = 0; j < nnr; j++)
+        if (r[j])
+            n++;
+    OSA_FREE(nrfree);
+    nrnfree = 0;
+    if ((nrfree = OSA_MALLOC(nnr * sizeof(int))) == NULL || nralloc(n) < 0) {
+        prstrfl("Out of memory for number registers.\n");
+        done2(04);
+    }
+    for (j = nnr - 1; j >= NNAMES; j--)
+        if (r[j] == 0)
+            nrfree[nrnfree++] = j;
+    for (j = 0; j < nnr; j++)
+        if (r[j])
+            nrput(j);
+}
+
+/* Grow a register array to n slots, copying it off static storage once */
+static int *nrext(int *a, int n) {
+    int *b;
+
+    if (nrgrown)
+        return (OSA_REALLOC(a, n * sizeof(int)));
+    if ((b = OSA_MALLOC(n * sizeof(int))) != NULL)
+        memcpy(b, a, nnr * sizeof(int));
+    return (b);
+}
+
+/* Double the number of register slots */
+static int nrgrow(void) {
+    int *nr, *ni, *nf, *nx, *fr;
+    int j, n;
+
+    n = nnr * 2;
+    if ((nr = nrext(r, n)) == NULL)
+        return (-1);
+    r = nr;
+    if ((ni = nrext(inc, n)) == NULL)
+        return (-1);
+    inc = ni;
+    if ((nf = nrext(fmt, n)) == NULL)
+        return (-1);
+    fmt = nf;
+    nrgrown = 1;
+    if ((nx = OSA_REALLOC(xvlist, (n - NN) * sizeof(int))) == NULL ||
+        (fr = OSA_REALLOC(nrfree, n * sizeof(int))) == NULL)
+        return (-1);
+    xvlist = nx;
+    nrfree = fr;
+    for (j = nnr; j < n; j++)
+        r[j] = inc[j] = fmt[j] = xvlist[j - NN] = 0;
+    for (j = n - 1; j >= nnr; j--)
+        nrfree[nrnfree++] = j;
+    nnr = n;
+    return (0);
+}
+
+/* Make room for at least n register slots; -1 if memory runs out */
+int nrroom(int n) {
+    if (nrtab == NULL)
+        nrhash();
+    while (nnr < n)
+        if (nrgrow() < 0)
+            return (-1);
+    return (0);
+}
+
+/*
+ * nrp - Address of the value of register slot j
+ *
+ * Slots below NN alias v through vlist; the rest live in xvlist.  An
+ * invalid slot (-1 from findr()) yields a scratch word so callers can
+ * store through the result unconditionally.  The date registers yr,
+ * mo, dy and dw are only filled in, by cvtime(), when one is first
+ * used, so a document that never asks does not read the time zone.
+ */
+int *nrp(int j) {
+    static int scratch;
+    int *p;
+
+    if (j < 0) {
+        scratch = 0;
+        return (&scratch);
+    }
+    if (!dateset && j < NN) {
+        p = &vlist[j];
+        if ((p == &v.yr) || (p == &v.mo) || (p == &v.dy) || (p == &v.dw))
+            cvtime(); /* before the first read or store */
+    }
+    return ((j < NN) ? &vlist[j] : &xvlist[j - NN]);
+}
+
+/* The value of register slot j, without filling in the date for it */
+int nrpeek(int j) {
+    int *p;
+
+    if ((j < 0) || (j >= nnr))
+        return (0);
+    if (j >= NN)
+        return (xvlist[j - NN]);
+    p = &vlist[j];
+    if (!dateset && ((p == &v.yr) || (p == &v.mo) || (p == &v.dy) || (p == &v.dw)))
+        return (0);
+    return (*p);
+}
+
 /*
  * findr - Locate or create a number register slot
  * 
- * Searches for an existing register or allocates a new slot.
- * Returns the index of the register or -1 on error.
+ * Looks the name up in the register index, taking a free slot for a
+ * new register.  Returns the index of the register or -1 on error.
  */
 int findr(int i) {
     register int j;
@@ -316,26 +623,12 @@ int findr(int i) {
     }
 
     /* Search for existing register */
-    for (j = 0; j < NN; j++) {
-        if (i == r[j]) {
-            break;
-        }
+    if ((j = nrlook(i)) >= 0) {
+        return (j);
     }
 
-    if (j != NN) {
-        return (j); /* Found existing register */
-    }
-
-    /* Find empty slot for new register */
-    for (j = 0; j < NN; j++) {
-        if (r[j] == 0) {
-            r[j] = i;
-            break;
-        }
-    }
-
-    /* Handle table overflow */
-    if (j == NN) {
+    /* Take a free slot for the new register */
+    if (nrnfree == 0 && nrgrow() < 0) {
         if (!numerr) {
             prstrfl("Too many number registers.\n");
         }
@@ -344,8 +637,11 @@ int findr(int i) {
         } else {
             edone(04); /* Recoverable error */
         }
+        return (-1);
     }
-
+    j = nrfree[--nrnfree];
+    r[j] = i;
+    nrput(j);
     return (j);
 }
 
@@ -517,6 +813,671 @@ wrc(int i) {
     return 1;
 }
 
+/*
+ * Compiled number expressions
+ *
+ * An expression read from a macro is the same words every time the
+ * macro runs, so the first time tatoi() meets one at a given ip it is
+ * read once more off the block store, without getch(), and turned into
+ * a short postfix program: the operands atoi1() would have read, each
+ * with its sign, | and scale indicator, and the operators atoi0()
+ * would have applied.  \n references to registers stay names and are
+ * looked up when the program runs; the scale indicators are resolved
+ * then too, so the program does not depend on dfact, lss or noscale.
+ * From then on the program runs instead, and ip, ch, nlflg and the
+ * widths getch() would have added are set as the parse would have
+ * left them.
+ *
+ * The reader follows exactly the control flow of atoi0(), ckph() and
+ * atoi1(), and gives up on anything getch() would do more with than
+ * return it: other escapes, field, tab and leader characters, an 'f'
+ * that could start a ligature, the end of the macro.  A register is
+ * taken only where an operand starts, where its sign acts like one
+ * typed there; \n in operator position, run into digits, or with + or
+ * - is left to the parser.  A \n that skip() has already read, its
+ * text left in ch and cp, is taken as a register at the start in the
+ * same way.  Programs are keyed by ip, the pending ch and the
+ * characters that change how words are read, and are dropped when
+ * blk_free() or blkinit() gives their blocks back.
+ */
+#define XOPS 64 /* program length */
+#define XWORDS BLK /* words read, so a program spans at most two blocks */
+#define XREGS 8 /* registers referenced */
+#define XSTACK 32 /* evaluation stack */
+#define XRTXT 16 /* longest register text taken */
+
+enum { XZERO, XNUM, XREG, XOP, XSET, XDROP, XCLR };
+enum { XSTREAM, XPEND, XBARE }; /* where the word in ch came from */
+#define XPREG (-1) /* pch: the text of a \n just read is in ch and cp */
+
+struct xop {
+    char op; /* one of the above */
+    char k; /* XOP: operator; XNUM, XREG: scale indicator or 0 */
+    char neg, abs; /* atoi1() prefixes; XOP: 1 for >= and <= */
+    int field, digits; /* XNUM: as atoi1() counts them */
+    long n; /* XNUM: the digits; XREG: index into reg */
+};
+
+struct xexp {
+    int ip; /* where the expression starts, 0 for an empty slot */
+    int pch; /* ch & CMASK on entry, XPREG for a number in ch and cp */
+    int pre; /* read behind inumb()'s sign */
+    int key[4]; /* eschar, fc, tabch, ldrch */
+    int nop; /* program length, -1 if not compilable */
+    int end; /* ip after the expression */
+    int ch; /* left in ch: a word, 0, or -1 for the pending one */
+    int nl; /* nlflg increments */
+    int f; /* inumb()'s sign */
+    int nonumb;
+    int abs; /* some operand uses | */
+    int last; /* \n was read from the macro */
+    int b0, b1; /* first and last block read */
+    int nw, nreg, nonneg;
+    struct xop *op;
+    int *w; /* words read, -1 - k for register k */
+    int *reg; /* register names */
+};
+
+static struct xexp xtab[NXC];
+static int nxtab; /* compiled slots in use */
+
+/* Reader state while compiling */
+static struct xop xops[XOPS];
+static int xwds[XWORDS];
+static int xregs[XREGS];
+static int xa, xb, xnread, xvch, xvpend, xpend, xnl, xlast, xnonumb, xbad;
+static int xnop, xnw, xnreg, xnonneg, xabs, xdepth, xsp, xmax;
+
+static void xputback(int c) {
+    xvch = c;
+    xvpend = xpend;
+}
+
+static int xword(void) {
+    register int w;
+
+    if (xnread++ >= XWORDS || (w = rbf0(xa)) == 0 || (w & ~BMASK)) {
+        xbad++;
+        return ('\n');
+    }
+    xb = xa;
+    xa = incoff(xa);
+    return (w);
+}
+
+/* A character getach() takes for a register name */
+static int xname(int c) {
+    return ((c > 040) && (c < 0177) && (c != eschar) && (c != fc) &&
+            (c != tabch) && (c != ldrch));
+}
+
+/* A word getch() hands back as it is */
+static int xplain(int c) {
+    return ((c == '\n') || ((c >= 040) && (c < 0177) && (c != eschar) &&
+            (c != fc) && (c != tabch) && (c != ldrch) && (c != 'f')));
+}
+
+/* getch() over the macro; a register comes back as -1 - k */
+static int xget(void) {
+    register int c, i;
+
+    if (xbad)
+        return ('\n');
+    if (xvch) {
+        c = xvch;
+        xvch = 0;
+        xpend = xvpend;
+        if (c == '\n')
+            xnl++;
+        return (c);
+    }
+    if (xnl) {
+        xpend = XBARE;
+        return ('\n');
+    }
+    xpend = 0;
+    if ((c = xword()) == eschar) {
+        if (xword() != 'n' || (c = xword()) == '+' || c == '-' || !xname(c)) {
+            xbad++;
+            return ('\n');
+        }
+        if (c == '(') {
+            c = xword();
+            i = xword();
+            if (!xname(c) || !xname(i)) {
+                xbad++;
+                return ('\n');
+            }
+            c |= i << BYTE;
+        }
+        /* the width register changes with every character read */
+        if (c == ('.' | ('w' << BYTE)) || xnreg >= XREGS) {
+            xbad++;
+            return ('\n');
+        }
+        xregs[xnreg] = c;
+        xwds[xnw++] = -1 - xnreg;
+        return (-1 - xnreg++);
+    }
+    if (!xplain(c)) {
+        xbad++;
+        return ('\n');
+    }
+    xwds[xnw++] = c;
+    if (c == '\n') {
+        xnl++;
+        xlast++;
+    }
+    return (c);
+}
+
+static struct xop *xemit(int op, int push) {
+    register struct xop *o;
+
+    if (xnop >= XOPS || (xsp += push) > XSTACK) {
+        xbad++;
+        xnop = 0;
+    }
+    if (xsp > xmax)
+        xmax = xsp;
+    o = &xops[xnop++];
+    memset(o, 0, sizeof(*o));
+    o->op = op;
+    return (o);
+}
+
+static void xatoi0(void);
+
+/* atoi1() over the macro */
+static void xatoi1(void) {
+    register int i, j;
+    struct xop *o;
+    int neg, abs, field, digits;
+    long acc;
+
+    neg = abs = field = digits = 0;
+    acc = 0;
+a0:
+    switch (i = xget()) {
+    case '+':
+        goto a0;
+    case '-':
+        neg = 1;
+        goto a0;
+    case '|':
+        abs = 1 + neg;
+        neg = 0;
+        goto a0;
+    default:
+        if (i < 0) {
+            /* digits of a register: no fraction, run into nothing */
+            o = xemit(XREG, 1);
+            o->n = -1 - i;
+            if ((i = xget()) < 0 || (i >= '0' && i <= '9') || i == '.')
+                xbad++;
+            xputback(i);
+            field = digits = 1;
+            goto a3;
+        }
+        xputback(i);
+    }
+a1:
+    while ((i = xget()) >= '0' && i <= '9') {
+        j = i - '0';
+        field++;
+        digits++;
+        acc = 10 * acc + j;
+    }
+    if (i < 0)
+        xbad++;
+    if (i == '.') {
+        field++;
+        digits = 0;
+        goto a1;
+    }
+    xputback(i);
+    if (!field)
+        goto a2;
+    o = xemit(XNUM, 1);
+    o->n = acc;
+a3:
+    switch (i = xget()) {
+    case 'u':
+    case 'v':
+    case 'm':
+    case 'n':
+    case 'p':
+    case 'i':
+    case 'c':
+    case 'P':
+        break;
+    default:
+        if (i < 0)
+            xbad++;
+        xputback(i);
+        i = 0;
+    }
+    o->k = i;
+    o->neg = neg;
+    o->abs = abs;
+    o->field = field;
+    o->digits = digits;
+    if (abs)
+        xabs++;
+a2:
+    xnonumb = !field;
+}
+
+/* ckph() over the macro; 1 if a value was pushed */
+static int xckph(void) {
+    register int i;
+
+    if ((i = xget()) == '(') {
+        xatoi0();
+        return (1);
+    }
+    xputback(i);
+    xatoi1();
+    return (!xnonumb);
+}
+
+/* atoi0() over the macro */
+static void xatoi0(void) {
+    register int ii, i, k, cnt;
+    struct xop *o;
+
+    if (++xdepth > XSTACK / 2)
+        xbad++;
+    xemit(XZERO, 1);
+    xnonumb = 0;
+    cnt = -1;
+a0:
+    cnt++;
+    switch (ii = xget()) {
+    default:
+        /* a register in operator position: its sign decides */
+        if (ii < 0 && cnt)
+            xbad++;
+        xputback(ii);
+        if (cnt)
+            break;
+        ii = '+'; /* the first character: as if a + */
+        /* FALLTHROUGH */
+    case '+':
+    case '-':
+    case '*':
+    case '/':
+    case '%':
+    case '&':
+    case ':':
+        k = xckph();
+        if (xnonumb) {
+            if (k)
+                xemit(XDROP, -1);
+            break;
+        }
+        xemit(XOP, -1)->k = ii;
+        goto a0;
+    case '=':
+    case '>':
+    case '<':
+        k = 0;
+        if ((i = xget()) != '=')
+            xputback(i);
+        else if (ii != '=')
+            k++;
+        if (xckph() && xnonumb)
+            xemit(XDROP, -1);
+        if (xnonumb) {
+            xemit(XCLR, 0);
+            break;
+        }
+        o = xemit(XOP, -1);
+        o->k = ii;
+        o->neg = k;
+        goto a0;
+    case ')':
+        break;
+    case '(':
+        xatoi0();
+        xemit(XSET, -1);
+        goto a0;
+    }
+    xdepth--;
+}
+
+/* Drop the program in e */
+static void xdrop(struct xexp *e) {
+    if (e->ip) {
+        OSA_FREE(e->op);
+        e->op = NULL;
+        e->ip = 0;
+        nxtab--;
+    }
+}
+
+/* Compile the expression at ip into e, or mark it as not compilable */
+static void xcomp(struct xexp *e, int pch, int pre) {
+    register int i;
+    char *m;
+
+    xa = xb = ip;
+    xvch = pch;
+    xvpend = XPEND;
+    xpend = XSTREAM;
+    xnl = xlast = xnonumb = xbad = xnread = 0;
+    xnop = xnw = xnreg = xnonneg = xabs = xdepth = xsp = xmax = 0;
+    if (pch == XPREG)
+        xregs[xnreg++] = 0; /* register 0 is what ch and cp hold */
+    e->f = 0;
+    if (pre) {
+        if ((i = xget()) == '+') {
+            e->f = 1;
+        } else if (i == '-') {
+            e->f = -1;
+        } else {
+            /* a negative register would be inumb()'s sign */
+            if (i < 0)
+                xnonneg |= 1 << (-1 - i);
+            xputback(i);
+        }
+    }
+    xatoi0();
+    if (xabs && xlast)
+        xbad++; /* the newline resets v.hp under | */
+    e->nop = -1;
+    if (!xbad && (m = OSA_MALLOC(xnop * sizeof(struct xop) +
+                              (xnw + xnreg) * sizeof(int))) != NULL) {
+        e->op = (struct xop *)m;
+        memcpy(e->op, xops, xnop * sizeof(struct xop));
+        e->w = (int *)(m + xnop * sizeof(struct xop));
+        memcpy(e->w, xwds, xnw * sizeof(int));
+        e->reg = e->w + xnw;
+        memcpy(e->reg, xregs, xnreg * sizeof(int));
+        e->nop = xnop;
+    }
+    e->end = xa;
+    if (xvch == 0)
+        e->ch = 0;
+    else if (xvpend == XPEND)
+        e->ch = -1;
+    else if (xvpend == XBARE)
+        e->ch = -2;
+    else
+        e->ch = xvch;
+    e->nl = xnl;
+    e->nonumb = xnonumb;
+    e->abs = xabs;
+    e->last = xlast;
+    e->b0 = blisti(ip);
+    e->b1 = blisti(xb);
+    e->nw = xnw;
+    e->nreg = xnreg;
+    e->nonneg = xnonneg;
+}
+
+/* The program for the expression at ip, compiling it the first time */
+static struct xexp *xlook(int pch, int pre) {
+    register struct xexp *e;
+    register unsigned h;
+
+    h = ((unsigned)ip * 2654435761u) ^ ((unsigned)pch * 40503u) ^ pre;
+    e = &xtab[(h ^ (h >> 16)) & (NXC - 1)];
+    if (e->ip != ip || e->pch != pch || e->pre != pre ||
+        e->key[0] != eschar || e->key[1] != fc || e->key[2] != tabch ||
+        e->key[3] != ldrch) {
+        xdrop(e);
+        xcomp(e, pch, pre);
+        e->ip = ip;
+        e->pch = pch;
+        e->pre = pre;
+        e->key[0] = eschar;
+        e->key[1] = fc;
+        e->key[2] = tabch;
+        e->key[3] = ldrch;
+        nxtab++;
+    }
+    return (e->nop < 0 ? NULL : e);
+}
+
+/* A word as getch0() returns it outside copy mode */
+static int xbits(int c) {
+    if (((c & ~BMASK) == 0) && ((c & CMASK) < 0370))
+        c |= chbits;
+    return (c);
+}
+
+/*
+ * The text \n gives register i, if it is a plain number: its digits go
+ * to t, the count to *n and the value to *val.
+ */
+static int xreg(int i, int *t, int *n, long *val) {
+    register int k, c;
+    long acc;
+
+    nrtext(i, 0);
+    cp = 0;
+    acc = 0;
+    for (k = 0; (c = cbuf[k]) != 0; k++) {
+        if (k >= XRTXT || c == eschar || c == fc || c == tabch ||
+            c == ldrch)
+            return (0);
+        if (c == '-' && k == 0)
+            ;
+        else if (c >= '0' && c <= '9')
+            acc = 10 * acc + (c - '0');
+        else
+            return (0);
+        t[k] = c;
+    }
+    if (k == 0 || (k == 1 && t[0] == '-'))
+        return (0);
+    *n = k;
+    *val = (t[0] == '-') ? -acc : acc;
+    return (1);
+}
+
+/*
+ * The number a \n just read left, its first character back in ch and
+ * the rest in cp, if that is all cp holds.
+ */
+static int xpreg(long *val) {
+    register int *p, c;
+    long acc;
+    int n;
+
+    if (cp < cbuf || cp >= &cbuf[NC])
+        return (0);
+    acc = n = 0;
+    if ((c = ch & CMASK) >= '0' && c <= '9') {
+        acc = c - '0';
+        n++;
+    } else if (c != '-') {
+        return (0);
+    }
+    for (p = cp; (c = *p) != 0; p++) {
+        if (p - cp >= XRTXT || c < '0' || c > '9' || c == eschar ||
+            c == fc || c == tabch || c == ldrch)
+            return (0);
+        acc = 10 * acc + (c - '0');
+        n++;
+    }
+    if (n == 0)
+        return (0);
+    *val = ((ch & CMASK) == '-') ? -acc : acc;
+    return (1);
+}
+
+/* Run the program in e, with rv[k] the value of its register k */
+static long xeval(struct xexp *e, long *rv) {
+    register struct xop *o;
+    long st[XSTACK], acc, i;
+    int n;
+
+    n = 0;
+    for (o = e->op; o < e->op + e->nop; o++) {
+        switch (o->op) {
+        case XZERO:
+            st[n++] = 0;
+            break;
+        case XNUM:
+            st[n++] = atoi2(o->n, o->k, o->neg, o->abs, o->field,
+                            o->digits);
+            break;
+        case XREG:
+            i = rv[o->n];
+            st[n++] = atoi2(i < 0 ? -i : i, o->k, o->neg || (i < 0), o->abs,
+                            1, 1);
+            break;
+        case XDROP:
+            n--;
+            break;
+        case XCLR:
+            st[n - 1] = 0;
+            break;
+        case XSET:
+            n--;
+            st[n - 1] = st[n];
+            break;
+        case XOP:
+            i = st[--n];
+            acc = st[n - 1];
+            switch (o->k) {
+            case '+':
+                acc += i;
+                break;
+            case '-':
+                acc -= i;
+                break;
+            case '*':
+                acc *= i;
+                break;
+            case '/':
+                if (i == 0) {
+                    prstrfl("Divide by zero.\n");
+                    acc = 0;
+                } else {
+                    acc /= i;
+                }
+                break;
+            case '%':
+                if (i != 0)
+                    acc %= i;
+                break;
+            case '&':
+                acc = (acc > 0) && (i > 0);
+                break;
+            case ':':
+                acc = (acc > 0) || (i > 0);
+                break;
+            case '=':
+                acc = (i == acc);
+                break;
+            case '>':
+                acc = acc > (i - o->neg);
+                break;
+            case '<':
+                acc = acc < (i + o->neg);
+                break;
+            }
+            st[n - 1] = acc;
+            break;
+        }
+    }
+    return (st[0]);
+}
+
+/*
+ * xrun - Evaluate the expression at ip from its program
+ *
+ * pre asks for inumb()'s sign first, which goes to *f.  Returns 0,
+ * having read nothing, when the parser has to do it.
+ */
+static int xrun(int pre, int *f, long *val) {
+    register struct xexp *e;
+    register int k, j, c;
+    long rv[XREGS];
+    int rt[XREGS][XRTXT], rn[XREGS];
+    int *t, n;
+
+    if ((ip <= 0) || ch0 || nchar || ap || sp || nlflg || copyf || raw ||
+        (ch && !(ch & CMASK)))
+        return (0);
+    if ((k = cp != NULL) && !xpreg(&rv[0]))
+        return (0);
+    if ((e = xlook(k ? XPREG : ch & CMASK, pre)) == NULL)
+        return (0);
+    if (e->abs && !level && !vflag)
+        return (0); /* v.hp moves with each character read */
+    if (e->pch == XPREG && (e->nonneg & 1) && (rv[0] < 0))
+        return (0);
+    for (k = (e->pch == XPREG); k < e->nreg; k++) {
+        if (!xreg(e->reg[k], rt[k], &rn[k], &rv[k]))
+            return (0);
+        if ((e->nonneg & (1 << k)) && (rv[k] < 0))
+            return (0);
+    }
+    *val = xeval(e, rv);
+    if (f)
+        *f = e->f;
+
+    /* Leave the input as getch() would have */
+    if (cp != NULL) {
+        for (t = cp; !level && *t; t++) {
+            j = width(xbits(*t));
+            v.hp += j;
+            cwidth = j;
+        }
+        cp = 0;
+    }
+    if (!level || e->last)
+        for (k = 0; k < e->nw; k++) {
+            if ((c = e->w[k]) < 0) {
+                t = rt[-1 - c];
+                n = rn[-1 - c];
+            } else {
+                t = &e->w[k];
+                n = 1;
+            }
+            for (; n > 0; n--, t++) {
+                if ((c = *t) == '\n')
+                    v.hp = 0;
+                if (!level) {
+                    j = width(xbits(c));
+                    v.hp += j;
+                    cwidth = j;
+                }
+            }
+        }
+    ip = e->end;
+    nlflg = e->nl;
+    nonumb = e->nonumb;
+    if (e->ch == -2)
+        ch = '\n';
+    else if (e->ch != -1)
+        ch = e->ch ? xbits(e->ch) : 0;
+    return (1);
+}
+
+/* Drop the programs read from block b, which is being freed */
+void xcfree(int b) {
+    register struct xexp *e;
+
+    if (nxtab == 0)
+        return;
+    for (e = xtab; e < &xtab[NXC]; e++)
+        if (e->ip && (e->b0 == b || e->b1 == b))
+            xdrop(e);
+}
+
+/* Drop every program */
+void xcinit(void) {
+    register struct xexp *e;
+
+    for (e = xtab; nxtab && e < &xtab[NXC]; e++)
+        xdrop(e);
+}
+
 /*
  * tatoi - Read and convert integer from input
  * 
@@ -524,7 +1485,10 @@ wrc(int i) {
  */
 int tatoi(void) {
     register int i;
+    long acc;
 
+    if (xrun(0, NULL, &acc))
+        return ((int)acc);
     return (i = (int)atoi0());
 }
 
@@ -755,7 +1719,37 @@ a1:
     }
 
     /* Parse scaling unit */
-    switch ((i = getch()) & CMASK) {
+    switch (j = (i = getch()) & CMASK) {
+    case 'u':
+    case 'v':
+    case 'm':
+    case 'n':
+    case 'p':
+    case 'i':
+    case 'c':
+    case 'P':
+        break;
+    default:
+        ch = i; /* Put character back */
+        j = 0;
+    }
+    acc = atoi2(acc, j, neg, abs, field, digits);
+
+a2:
+    nonumb = !field; /* Set flag if no number was parsed */
+    return (acc);
+}
+
+/*
+ * atoi2 - Scale the number atoi1() read
+ *
+ * c is the scale indicator that followed the digits, 0 for none.
+ */
+static long
+atoi2(long acc, int c, int neg, int abs, int field, int digits) {
+    register int i, j;
+
+    switch (c) {
     case 'u': /* Basic units */
         i = j = 1;
         break;
@@ -794,7 +1788,6 @@ a1:
         break;
     default: /* Default scaling */
         j = dfact;
-        ch = i; /* Put character back */
         i = dfactd;
     }
 
@@ -831,8 +1824,6 @@ a1:
         acc -= j;
     }
 
-a2:
-    nonumb = !field; /* Set flag if no number was parsed */
     return (acc);
 }
 
@@ -852,16 +1843,11 @@ void caserr(void) {
         return; /* No register name provided */
     }
 
-    /* Search for register in user-defined range */
-    for (j = NNAMES; j < NN; j++) {
-        if (i == r[j]) {
-            break;
-        }
-    }
-
-    /* Clear register if found */
-    if (j != NN) {
-        r[j] = vlist[j] = inc[j] = fmt[j] = 0;
+    /* Clear register if found in the user-defined range */
+    if ((j = nrlook(i)) >= NNAMES) {
+        nrdel(j);
+        r[j] = *nrp(j) = inc[j] = fmt[j] = 0;
+        nrfree[nrnfree++] = j;
     }
 }
 
@@ -873,6 +1859,7 @@ void caserr(void) {
  */
 void casenr(void) {
     register int i, j;
+    int k;
 
     lgf++; /* Increment line gathering flag */
     skip(); /* Skip whitespace */
@@ -885,11 +1872,13 @@ void casenr(void) {
     skip(); /* Skip whitespace */
 
     /* Parse register value */
-    j = inumb(&vlist[i]);
+    /* Parse against a copy: the value may move if registers grow */
+    k = *nrp(i);
+    j = inumb(&k);
     if (nonumb) {
         goto rtn; /* No value provided */
     }
-    vlist[i] = j;
+    *nrp(i) = j;
 
     skip(); /* Skip whitespace */
 
@@ -938,7 +1927,9 @@ void caseaf(void) {
     }
 
     /* Set format for the register */
-    fmt[findr(i)] = k & BMASK;
+    if ((i = findr(i)) != -1) {
+        fmt[i] = k & BMASK;
+    }
 }
 
 /*
@@ -973,23 +1964,29 @@ void hnumb(int *i) {
  * relative increments, and quantization.
  */
 int inumb(int *n) {
-    register int i, j, f;
+    register int i, j;
+    int f;
+    long acc;
 
     f = 0;
 
-    /* Handle relative increment/decrement */
-    if (n) {
-        if ((j = (i = getch()) & CMASK) == '+') {
-            f = 1;
-        } else if (j == '-') {
-            f = -1;
-        } else {
-            ch = i; /* Put character back */
+    if (n && xrun(1, &f, &acc)) {
+        i = (int)acc;
+    } else {
+        /* Handle relative increment/decrement */
+        if (n) {
+            if ((j = (i = getch()) & CMASK) == '+') {
+                f = 1;
+            } else if (j == '-') {
+                f = -1;
+            } else {
+                ch = i; /* Put character back */
+            }
         }
-    }
 
-    /* Parse the number */
-    i = tatoi();
+        /* Parse the number */
+        i = tatoi();
+    }
 
     /* Apply relative change if specified */
     if (n && f) {
@@ -10,7 +10,14 @@
 #include "tdef.h" // core definitions
 #include "env.h"  // environment structure
 #include "t.h"    // troff header
+#include "diag.h" // -Q diagnostics
+#include "tabstop.h" // .ta
+#define OSA_TAG "croff"
+#include "os/os_acct.h" // OSA_MALLOC, OSA_READ
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 /* External variable declarations */
 extern int ascii;
@@ -25,6 +32,7 @@ extern int tabc;
 extern int dotc;
 extern int pendnf;
 extern int hyf;
+extern int parop;
 extern int ce;
 extern int po;
 extern int po1;
@@ -37,8 +45,9 @@ extern int ll;
 extern int ll1;
 extern int lt;
 extern int lt1;
-extern int nlist[NTRAP];
-extern int mlist[NTRAP];
+extern int *nlist;
+extern int *mlist;
+extern int ntrap;
 extern int lgf;
 extern int pl;
 extern int npn;
@@ -51,6 +60,12 @@ extern int trap;
 extern int lss;
 extern int em;
 extern int evlist[EVLSZ];
+extern struct evvar {
+    void *p;
+    int n;
+    int ptr;
+} evvars[];
+extern int nevvars;
 extern int evi;
 extern int ibf;
 extern int ev;
@@ -62,10 +77,10 @@ extern int quiet;
 extern int iflg;
 extern int eschar;
 extern int lit;
-extern int *litlev;
+extern int litlev;
+extern int frlev;
 extern int ls;
 extern int ls1;
-extern int tabtab[];
 extern char trtab[];
 extern int ul;
 extern int cu;
@@ -102,12 +117,14 @@ extern int xxx;
 /* Global arrays */
 int iflist[NIF];
 int ifx;
+long evswitch; /* environment switches by .ev, reported by -S */
 
 /* External control table structure */
 extern struct contab {
     int rq;
     int (*f)(void);
-} contab[NM];
+} *contab;
+extern int ncontab;
 
 /* Function prototypes - static (internal) functions */
 static int max(int aa, int bb);
@@ -120,8 +137,11 @@ static void casefi(void);
 static void casenf(void);
 
 /* Function prototypes - external functions */
+void widflush(void);
 int chget(int c);
 int findn(int i);
+void trapmod(void);
+int trroom(int n);
 void tbreak(void);
 int tatoi(void);
 int hnumb(int *ptr);
@@ -139,6 +159,7 @@ void flushi(void);
 void done2(int x);
 void edone(int x);
 int eat(int c);
+int getskip(void);
 void wbfl(void);
 int alloc(void);
 void wbf(int i);
@@ -156,6 +177,7 @@ void seek(int fd, int offset, int whence);
 void prstr(char *s);
 int find(int x, int *table);
 int findr(int x);
+int *nrp(int j);
 void eject(int x);
 
 /* Additional function prototypes for this file */
@@ -168,6 +190,8 @@ void casetc(void);
 void caselc(void);
 void casehy(void);
 void casenh(void);
+void caseop(void);
+void parsync(void);
 void casece(void);
 void casein(void);
 void casell(void);
@@ -185,11 +209,17 @@ void casesp(int a);
 void casert(void);
 void caseem(void);
 void casefl(void);
+void evinit(void);
+int evsize(void);
+void evreloc(char *buf, uintptr_t delta);
+void evget(int k, char *buf);
+void evput(int k, const char *buf);
 void caseev(void);
 void caseie(void);
 void caseif(int x);
 void caserd(void);
 int rdtty(void);
+extern void sgbad(void);
 void caseec(void);
 void caseeo(void);
 void caseli(void);
@@ -371,6 +401,25 @@ void casenh(void) {
     hyf = 0;
 }
 
+/*
+ * Break filled text a paragraph at a time (.op [n], 0 turns it off)
+ */
+void caseop(void) {
+    register int i;
+
+    i = 1;
+    if (!skip()) {
+        noscale++;
+        i = tatoi();
+        noscale = 0;
+        if (nonumb)
+            i = 1;
+    }
+    if (!i)
+        parsync();
+    parop = (i != 0);
+}
+
 /*
  * Center lines
  */
@@ -416,6 +465,7 @@ void casell(void) {
         i = ll1;
     else
         i = max(hnumb(&ll), INCH / 10);
+    parsync();
     ll1 = ll;
     ll = i;
     setnel();
@@ -511,19 +561,21 @@ void casewh(void) {
         return;
     skip();
     j = getrq();
-    if ((k = findn(i)) != NTRAP) {
+    if ((k = findn(i)) >= 0) {
         mlist[k] = j;
+        trapmod();
         return;
     }
-    for (k = 0; k < NTRAP; k++)
+    for (k = 0; k < ntrap; k++)
         if (mlist[k] == 0)
             break;
-    if (k == NTRAP) {
+    if (k == ntrap && trroom(ntrap + 1) < 0) {
         prstrfl("Cannot plant trap.\n");
         return;
     }
     mlist[k] = j;
     nlist[k] = i;
+    trapmod();
 }
 
 /*
@@ -537,28 +589,30 @@ void casech(void) {
     if (!(j = getrq()))
         return;
     else
-        for (k = 0; k < NTRAP; k++)
+        for (k = 0; k < ntrap; k++)
             if (mlist[k] == j)
                 break;
-    if (k == NTRAP)
+    if (k == ntrap)
         return;
     skip();
     i = vnumb(0);
     if (nonumb)
         mlist[k] = 0;
     nlist[k] = i;
+    trapmod();
 }
 
 /*
- * Find trap number associated with page position i
+ * Find trap number associated with page position i, as given to .wh;
+ * -1 if there is none
  */
 int findn(int i) {
     register int k;
 
-    for (k = 0; k < NTRAP; k++)
+    for (k = 0; k < ntrap; k++)
         if ((nlist[k] == i) && (mlist[k] != 0))
-            break;
-    return k;
+            return k;
+    return -1;
 }
 
 /*
@@ -691,12 +745,102 @@ void casefl(void) {
     flusho();
 }
 
+/*
+ * Environments
+ *
+ * evvars[] in ni.c lists the variables that make up an environment.
+ * Inactive environments are kept in core, packed into evbuf[], so a
+ * switch is two copy passes over that table and no temp-file I/O.
+ */
+static char *evbuf[NEV]; /* packed copy of each environment */
+static int evsz; /* bytes in a packed environment */
+
+/* Copy the live environment variables into or out of packed buffer b */
+static void evcopy(char *b, int save) {
+    register int i;
+
+    for (i = 0; i < nevvars; b += evvars[i++].n) {
+        if (save)
+            memcpy(b, evvars[i].p, evvars[i].n);
+        else
+            memcpy(evvars[i].p, b, evvars[i].n);
+    }
+}
+
+/*
+ * evinit - Set up the NEV environments from the current (default) state
+ */
+void evinit(void) {
+    register int i;
+
+    for (evsz = i = 0; i < nevvars; i++)
+        evsz += evvars[i].n;
+    for (i = 0; i < NEV; i++) {
+        if (evbuf[i] == NULL && (evbuf[i] = OSA_MALLOC(evsz)) == NULL) {
+            prstrfl("Cannot allocate environments.\n");
+            done2(02);
+        }
+        evcopy(evbuf[i], 1);
+    }
+}
+
+/* Size in bytes of a packed environment, as used by evget()/evput() */
+int evsize(void) {
+    if (evbuf[0] == NULL)
+        evinit();
+    return (evsz);
+}
+
+/*
+ * evreloc - Move the pointers in a packed environment by delta bytes
+ *
+ * Used when a packed environment comes from another process image.
+ * What is in a pointer slot may be an offset rather than an address in
+ * this image, so the sum is made on its bits as a uintptr_t, never as
+ * a pointer.
+ */
+void evreloc(char *buf, uintptr_t delta) {
+    register int i, j;
+    uintptr_t q;
+
+    for (i = 0; i < nevvars; buf += evvars[i++].n) {
+        if (!evvars[i].ptr)
+            continue;
+        for (j = 0; j < evvars[i].n; j += (int)sizeof(q)) {
+            memcpy(&q, buf + j, sizeof(q));
+            if (q != 0) {
+                q += delta;
+                memcpy(buf + j, &q, sizeof(q));
+            }
+        }
+    }
+}
+
+/* Pack environment k into buf */
+void evget(int k, char *buf) {
+    if (evbuf[0] == NULL)
+        evinit();
+    if (k == ev)
+        evcopy(buf, 1);
+    else
+        memcpy(buf, evbuf[k], evsz);
+}
+
+/* Replace environment k with the packed copy in buf */
+void evput(int k, const char *buf) {
+    if (evbuf[0] == NULL)
+        evinit();
+    if (k == ev)
+        evcopy((char *)buf, 0);
+    else
+        memcpy(evbuf[k], buf, evsz);
+}
+
 /*
  * Environment switch
  */
 void caseev(void) {
     register int nxev;
-    extern int block;
 
     if (skip()) {
         if (evi == 0)
@@ -727,11 +871,12 @@ void caseev(void) {
     if (ev == nxev)
         return;
 
-    seek(ibf, ev * EVS * 2, 0);
-    write(ibf, &block, EVS * 2);
-    seek(ibf, nxev * EVS * 2, 0);
-    read(ibf, &block, EVS * 2);
+    if (evbuf[0] == NULL)
+        evinit();
+    evcopy(evbuf[ev], 1);
+    evcopy(evbuf[nxev], 0);
     ev = nxev;
+    evswitch++;
 }
 
 /*
@@ -814,7 +959,11 @@ i1:
         nflush++;
     } else {
         copyf++;
-        if (eat(LEFT) == LEFT) {
+        do {
+            while (getskip() > 0) /* plain text, past getch() */
+                ;
+        } while (((i = getch() & CMASK) != LEFT) && (i != '\n'));
+        if (i == LEFT) {
             while (eatblk(RIGHT, LEFT) != RIGHT)
                 nlflg = 0;
         }
@@ -829,10 +978,12 @@ static int eatblk(int right, int left) {
     register int i;
 
 e0:
-    while (((i = getch() & CMASK) != right) &&
-           (i != left) &&
-           (i != '\n'))
-        ;
+    do {
+        while (getskip() > 0) /* plain text, past getch() */
+            ;
+    } while (((i = getch() & CMASK) != right) &&
+             (i != left) &&
+             (i != '\n'));
     if (i == left) {
         while ((i = eatblk(right, left)) != right)
             nlflg = 0;
@@ -843,21 +994,21 @@ e0:
 
 /*
  * Compare a delimited string with data on input
+ *
+ * The first string is gathered into buf[]; only a string longer than
+ * NCMP words spills its tail into macro storage.
  */
 static int cmpstr(int delim) {
     register int i, j, p;
-    int begin, cnt, k;
+    int begin, cnt, len, k, n, w;
+    int buf[NCMP];
     int savapts, savapts1, savfont, savfont1,
         savpts, savpts1;
 
     if (delim & MOT)
         return 0;
     delim &= CMASK;
-    if (dip->op)
-        wbfl();
-    if ((offset = begin = alloc()) == 0)
-        return 0;
-    cnt = 0;
+    begin = cnt = 0;
     v.hp = 0;
     savapts = apts;
     savapts1 = apts1;
@@ -866,10 +1017,24 @@ static int cmpstr(int delim) {
     savpts = pts;
     savpts1 = pts1;
     while (((j = (i = getch()) & CMASK) != delim) && (j != '\n')) {
+        if (cnt < NCMP) {
+            buf[cnt++] = i;
+            continue;
+        }
+        if (!begin) {
+            if (dip->op)
+                wbfl();
+            if ((offset = begin = alloc()) == 0) {
+                prstr("Out of temp file space.\n");
+                done2(01);
+            }
+        }
         wbf(i);
         cnt++;
     }
-    wbt(0);
+    if (begin)
+        wbt(0);
+    len = cnt;
     k = !cnt;
     if (nlflg)
         goto rtn;
@@ -882,13 +1047,20 @@ static int cmpstr(int delim) {
     pts1 = savpts1;
     mchbits();
     v.hp = 0;
-    while (((j = (i = getch()) & CMASK) != delim) && (j != '\n')) {
-        if (rbf0(p) != i) {
+    for (n = 0; ((j = (i = getch()) & CMASK) != delim) && (j != '\n'); n++) {
+        if (n >= len) {
+            w = 0;
+        } else if (n < NCMP) {
+            w = buf[n];
+        } else {
+            w = rbf0(p);
+            p = incoff(p);
+        }
+        if (w != i) {
             eat(delim);
             k = 0;
             break;
         }
-        p = incoff(p);
         k = !(--cnt);
     }
 rtn:
@@ -899,8 +1071,10 @@ rtn:
     pts = savpts;
     pts1 = savpts1;
     mchbits();
-    offset = dip->op;
-    troff_free(begin);
+    if (begin) {
+        offset = dip->op;
+        troff_free(begin);
+    }
     return k;
 }
 
@@ -908,6 +1082,7 @@ rtn:
  * Read from terminal
  */
 void caserd(void) {
+    sgbad();
     lgf++;
     skip();
     getname();
@@ -937,7 +1112,8 @@ int rdtty(void) {
     int onechar;
 
     onechar = 0;
-    if (read(0, &onechar, 1) == 1) {
+    dgflush(); /* the prompt, and what came before it */
+    if (OSA_READ(0, &onechar, 1) == 1) {
         if (onechar == '\n')
             tty++;
         else
@@ -974,36 +1150,52 @@ void caseeo(void) {
 void caseli(void) {
     skip();
     lit = max(inumb(0), 1);
-    litlev = frame;
+    litlev = frlev;
     if ((!dip->op) && (v.nl == -1))
         newline(1);
 }
 
 /*
  * Set tab stops
+ *
+ * Each is a position, or +n or -n from the stop before, with an L, C
+ * or R after it; after a T the stops are a pattern repeated without
+ * end (tabstop.c).
  */
 void caseta(void) {
-    register int i, j;
-
-    tabtab[0] = nonumb = 0;
-    for (i = 0; ((i < (NTAB - 1)) && !nonumb); i++) {
-        if (skip())
-            break;
-        tabtab[i] = max(hnumb(&tabtab[max(i - 1, 0)]), 0) & TMASK;
+    register int j;
+    int i, prev;
+
+    tsclear();
+    nonumb = prev = 0;
+    while (!skip()) {
+        if ((ch & CMASK) == 'T') {
+            ch = 0;
+            tsrep();
+            prev = 0;
+            continue;
+        }
+        i = prev;
+        hnumb(&i);
+        prev = i = max(i, 0) & TMASK;
+        j = 0;
         if (!nonumb)
-            switch (j = ch & CMASK) {
+            switch (ch & CMASK) {
             case 'C':
-                tabtab[i] |= CTAB;
+                j = CTAB;
                 break;
             case 'R':
-                tabtab[i] |= RTAB;
+                j = RTAB;
                 break;
             default: /* includes L */
                 break;
             }
+        if (tsadd(nonumb ? 0 : i, j) < 0) {
+            prstrfl("Out of memory for tab stops.\n");
+            done2(04);
+        }
         nonumb = ch = 0;
     }
-    tabtab[i] = 0;
 }
 
 /*
@@ -1039,6 +1231,7 @@ void casetr(void) {
         if ((j &= CMASK) == '\n')
             j = ' ';
         trtab[i] = j;
+        widflush();
     }
 }
 
@@ -1114,7 +1307,7 @@ void casemk(void) {
         prstrfl("Error: Invalid request code.\n");
         return;
     }
-    vlist[findr(i)] = j;
+    *nrp(findr(i)) = j;
 }
 
 /*
@@ -9,6 +9,9 @@
 #include "tdef.h" // troff definitions
 #include "t.h"    // troff header
 #include "tw.h"   // terminal writer definitions
+#include "chtab_hash.h" // special character names
+
+#include <string.h>
 
 /* External variables - character and formatting state */
 extern int eschar; /* escape character */
@@ -37,6 +40,7 @@ extern int level; /* current level */
 extern int ch; /* current character */
 extern int res; /* resolution */
 extern int xxx; /* unused variable */
+extern int lg; /* ligature mode */
 
 /* External function declarations */
 extern int getrq(void); /* get request function */
@@ -48,10 +52,32 @@ extern void setn1(int value); /* set numeric register function */
 extern int tatoi(void); /* translate and convert to integer function */
 extern int makem(int value); /* make motion function */
 extern int quant(int value, int direction); /* quantize motion function */
+extern int getlook(int n); /* character n places on in the input */
+extern void getdrop(int n); /* take characters looked at */
 
 /* Default font labels - R(oman), I(talic), B(old), S(pecial) */
 int fontlab[] = {'R', 'I', 'B', 'S', 0};
 
+/*
+ * Width cache: one row of character widths per font and point size,
+ * selected by the chbits of the character.  Rows are claimed on first
+ * use and recycled when another font and size maps onto the same slot.
+ */
+#define NWROW 16 /* cached rows, a power of two */
+
+static struct wrow {
+    int fs; /* font and size bits plus one, 0 if the row is empty */
+    int w[256]; /* width by character, -1 if not yet known */
+} wcache[NWROW];
+
+long widhit, widmiss; /* width cache hits and misses, reported by -S */
+int widgen; /* widflush() calls, for caches built from widths */
+static int lgstale = 1; /* the ligature automaton (below) needs building */
+
+void widflush(void);
+void lgflush(void);
+int getlg(int i);
+
 /* Function prototypes for internal functions */
 static int validate_character(int c);
 static int calculate_motion_width(int c);
@@ -76,6 +102,8 @@ int width(int c) {
     int character_code;
     int width_result;
     int translated_char;
+    struct wrow *row;
+    int fs;
 
     character_code = c;
     width_result = 0;
@@ -99,24 +127,144 @@ int width(int c) {
         translated_char = eschar;
     }
 
+    /* A column of a forward reference is one character wide: see fwref.c */
+    if (translated_char == FWHOLE) {
+        width_result = widthp = t.Char;
+        goto return_width;
+    }
+
     /* Skip overhang characters and high-value characters */
     if ((translated_char == ohc) || (translated_char >= 0370)) {
         goto return_width;
     }
 
+    /* A run is as wide as its copies: see getch0() */
+    if (RUNN(character_code)) {
+        width_result = width(character_code & 0177777);
+        return width_result * RUNN(character_code);
+    }
+
     /* Handle zero-width characters */
     if (character_code & ZBIT) {
         goto return_width;
     }
 
-    /* Get actual character width from font tables */
-    width_result = get_character_width(translated_char);
+    /* Get actual character width from the cache or the font tables */
+    fs = (int)((unsigned)character_code >> (BYTE + 1));
+    row = &wcache[fs & (NWROW - 1)];
+    if (row->fs != fs + 1) {
+        row->fs = fs + 1;
+        memset(row->w, -1, sizeof(row->w));
+    }
+    if ((width_result = row->w[translated_char]) < 0) {
+        widmiss++;
+        width_result = get_character_width(translated_char);
+        row->w[translated_char] = width_result;
+    } else {
+        widhit++;
+    }
     widthp = width_result;
 
 return_width:
     return width_result;
 }
 
+/*
+ * Forget every cached width.
+ *
+ * Called whenever the translation table or the terminal tables change,
+ * since either alters the width of a character in every font and size.
+ */
+void widflush(void) {
+    int i;
+
+    for (i = 0; i < NWROW; i++)
+        wcache[i].fs = 0;
+    lgstale = 1;
+    widgen++;
+}
+
+/*
+ * Ligatures, for getlg(): a two-state automaton for each font position,
+ * built from the widths the ligature codes have there, so that a font
+ * without one never forms it.  State 0 follows an 'f', state 1 "ff";
+ * lgmove[font][state][class] for the classes 'f', 'i' and 'l' is the
+ * code that much input makes, or 0, with LGON set if a longer one may
+ * follow.  .lg 2 leaves out ffi and ffl.  widflush() and lgflush(),
+ * for .lg, mark it stale and the next getlg() builds it again.
+ */
+#define LGON 01000 /* another state follows */
+
+static short lgmove[4][2][3];
+
+void lgflush(void) {
+    lgstale = 1;
+}
+
+static void lgbuild(void) {
+    static const short two[3] = {0213, 0211, 0212}; /* ff fi fl */
+    static const short three[3] = {0, 0214, 0215}; /* ffi ffl */
+    int f, c, b, w;
+
+    w = widthp; /* width() sets it; backspace must not see these */
+    for (f = 0; f < 4; f++) {
+        b = f << (BYTE + 1);
+        for (c = 0; c < 3; c++) {
+            lgmove[f][0][c] = (width(two[c] | b) > 0) ? two[c] : 0;
+            lgmove[f][1][c] =
+                (lg != 2 && three[c] && width(three[c] | b) > 0) ? three[c] : 0;
+        }
+        if (lgmove[f][1][1] || lgmove[f][1][2])
+            lgmove[f][0][0] |= LGON;
+    }
+    widthp = w;
+    lgstale = 0;
+}
+
+/*
+ * Form the longest ligature that starts with the 'f' just read.
+ *
+ * The letters after it are looked at in place through getlook() and
+ * only those the ligature takes are taken, with getdrop(); they must be
+ * plain letters in the font and size of the 'f'.
+ *
+ * Returns:
+ *   The ligature with the formatting bits of i, or i
+ */
+int getlg(int i) {
+    int f, n, m, c, s, used, j;
+
+    if (lgstale)
+        lgbuild();
+    f = (int)((unsigned)i >> (BYTE + 1)) & 03;
+    j = i;
+    used = 0;
+    for (s = n = 0; ((c = getlook(n)) != 0) && ((c & ~CMASK) == (i & ~CMASK)); s = 1) {
+        switch (c & CMASK) {
+        case 'f':
+            m = lgmove[f][s][0];
+            break;
+        case 'i':
+            m = lgmove[f][s][1];
+            break;
+        case 'l':
+            m = lgmove[f][s][2];
+            break;
+        default:
+            m = 0;
+        }
+        n++;
+        if (m & ~LGON) {
+            j = (i & ~CMASK) | (m & ~LGON);
+            used = n;
+        }
+        if (!(m & LGON))
+            break;
+    }
+    getdrop(used);
+    return (j);
+}
+
 /*
  * Calculate width for motion commands
  * 
@@ -164,7 +312,9 @@ static int get_character_width(int c) {
         return 0;
     }
 
-    /* Look up width in font table */
+    /* Look up width in font table; init1() asks before ptinit() has one */
+    if (t.codetab[table_index - 32] == NULL)
+        return 0;
     char_width = (*(t.codetab[table_index - 32]) & 0177) * t.Char;
     return char_width;
 }
@@ -180,25 +330,21 @@ static int get_character_width(int c) {
  */
 int setch(void) {
     int request_code;
-    int *table_ptr;
-    int result_code;
-    extern int chtab[];
+    unsigned h;
 
     /* Get the special character request */
     if ((request_code = getrq()) == 0) {
         return 0;
     }
 
-    /* Search character table for matching entry */
-    for (table_ptr = chtab; *table_ptr != request_code; table_ptr += 2) {
-        if (*table_ptr == 0) {
-            return 0; /* Not found */
-        }
+    /* The one slot of chtab's hash (ntab.c) the name can be in */
+    h = CHHASH(request_code);
+    if (chhname[h] != request_code) {
+        return 0; /* Not found */
     }
 
     /* Return character code with formatting bits */
-    result_code = *(table_ptr + 1) | chbits;
-    return result_code;
+    return chhcode[h] | chbits;
 }
 
 /*
@@ -206,7 +352,10 @@ int setch(void) {
  * 
  * This function handles both numeric font positions (1-4) and
  * named font identifiers by searching the font label array.
- * 
+ * nroff has no font metrics of its own: every position is measured
+ * through the terminal table, which twload() maps shared and read-only,
+ * and fontlab holds four labels, so a scan is as quick as any index.
+ *
  * Parameters:
  *   font_id    - font identifier (numeric or character)
  *   font_array - array of font labels to search
@@ -34,6 +34,13 @@
 #include "env.h"  // environment data
 #include "t.h"    // troff common
 #include "tw.h"   // typewriter table
+#include "para.h" // paragraph line breaking
+#include "trace.h" // -Y event trace
+#define OSA_TAG "croff.output"
+#include "os/os_acct.h" // OSA_MALLOC, OSA_CALLOC, OSA_REALLOC
+
+#include <stdlib.h>
+#include <string.h>
 
 #ifdef NROFF
 #define GETCH gettch
@@ -41,6 +48,9 @@
 #define GETCH getch
 #endif /* NROFF */
 
+long linesout, pagesout; /* lines put out by tbreak() and pages begun, reported by -S */
+int pnmax; /* highest page number begun, for -X */
+
 /* Forward declarations for C90 compliance */
 extern void hsend(void);
 extern int makem(int i);
@@ -57,6 +67,7 @@ extern void casesp(int i);
 extern void mchbits(void);
 extern int control(int mac, int arg);
 extern int findr(int reg);
+extern int *nrp(int j);
 extern void prstrfl(const char *s);
 extern void pchar1(int c);
 extern void done1(int status);
@@ -65,6 +76,10 @@ extern int findn(int pos);
 extern void flusho(void);
 extern void hyphen(int *word_ptr);
 extern void dostop(void);
+extern int ipflg; /* -I: intermediate page output */
+extern void ippage(int pn);
+extern int pmflg; /* -G: pages held as a model */
+extern void pmpage(void);
 
 /* External variables from other modules */
 extern struct env *dip;
@@ -87,8 +102,10 @@ extern int lss;
 extern int pto;
 extern int pfrom;
 extern int print;
-extern int nlist[NTRAP];
-extern int mlist[NTRAP];
+extern int tflg;
+extern int *nlist;
+extern int *mlist;
+extern int ntrap;
 extern int *frame;
 extern int *stk;
 extern int *pnp;
@@ -108,6 +125,7 @@ extern int nwd;
 extern int *pendw;
 extern int *linep;
 extern int line[];
+extern int linew[];
 extern int lastl;
 extern int ch;
 extern int ce;
@@ -127,6 +145,7 @@ extern int hyoff;
 extern int nhyp;
 extern int spflg;
 extern int word[];
+extern int wdpre[];
 extern int *wordp;
 extern int wne;
 extern int chbits;
@@ -142,6 +161,8 @@ extern int sfont;
 extern int it;
 extern int itmac;
 extern int *hyptr[NHYP];
+extern int ev;
+extern int parop;
 extern int **hyp;
 extern int *wdstart, *wdend;
 extern int lnmod;
@@ -173,7 +194,9 @@ void callsp(void); /**< @brief Call space-handling routine. @see callsp */
 void ckul(void); /**< @brief Clean up underline/italic states. @see ckul */
 void storeline(int c, int w); /**< @brief Store char/width into line buffer. @param c Character. @param w Width. @see storeline */
 void newline(int a); /**< @brief Output newline, handle traps/pages. @param a Force break flag. @see newline */
-int findn1(int a); /**< @brief Find trap at exact vertical position. @param a Position. @return Trap index or NTRAP. @see findn1 */
+void trapmod(void); /**< @brief Mark the trap index stale. @see trapmod */
+int trroom(int n); /**< @brief Grow the trap slots. @param n Slots wanted. @return 0, or -1 without memory. @see trroom */
+int findn1(int a); /**< @brief Find trap at exact vertical position. @param a Position. @return Trap index or -1. @see findn1 */
 void chkpn(void); /**< @brief Check/update page numbers for printing. @see chkpn */
 int findt(int a); /**< @brief Find distance to next trap. @param a Current position. @return Distance. @see findt */
 int findt1(void); /**< @brief Wrapper for findt using current v.pos. @return Distance. @see findt1 */
@@ -182,13 +205,54 @@ int movword(void); /**< @brief Move word from word buffer to line buffer. @retur
 void horiz(int i); /**< @brief Output horizontal motion. (Definition assumed elsewhere or later) */
 void setnel(void); /**< @brief Initialize/reset line state variables. (Definition assumed elsewhere or later) */
 void reset_setnel_flag(void); /**< @brief Reset flag for setnel. (Definition assumed elsewhere or later) */
-int getword(int x); /**< @brief Extract next word from input. @param x Flag. (Definition assumed elsewhere or later) */
+int getword(int x); /**< @brief Extract next word from input. @param x Flag. @see getword */
 static int handleUnderlineBits(int i); /**< @brief Static helper for underline bits. (Definition assumed later in file) */
 int gettch(void); /**< @brief NROFF specific character input. (Definition assumed later in file if NROFF) */
 
 /* Missing function prototypes - Definitions expected elsewhere or to be added */
 void tbreak1(void); /**< Presumably a related break function; definition not in this file. */
-void storeword(int c, int w); /**< Stores a character of a word into the word buffer; definition not in this file. */
+void storeword(int c, int w); /**< @brief Store char/width into word buffer. @param c Character. @param w Width. @see storeword */
+static int wordhy(int j); /**< @brief Record a hyphenation point for word char j. @return 1 if j is consumed. */
+extern int getrun(int *buf, int *wid, int n); /**< @brief Fetch a run of plain input text (n1.c). */
+static void adjline(void); /**< @brief Set adsp/adrem to spread the line. */
+static int parword(void); /**< @brief Hold the word in word[] for paragraph breaking. @return 1 if stopped by a trap. */
+static int parcont(void); /**< @brief Finish lines left by a trap. @return 1 if stopped by a trap. */
+int parflush(void); /**< @brief Break and output held words but the last line. @return 1 if stopped by a trap. */
+int parheld(void); /**< @brief Whether any environment holds paragraph words. */
+void parsync(void); /**< @brief parflush() until done, regardless of traps. */
+
+/** Words held for one paragraph before it is broken early (memory cap). */
+#define NPARW 512
+/** Characters held likewise; one more word always fits past the cap. */
+#define NPARC 4096
+
+/**
+ * @brief Filled words held by .op until their paragraph is broken.
+ *
+ * Words are copied out of `word[]` as getword() completes them. When the
+ * paragraph ends, the held words are broken with parfit() and fed back
+ * through movword() line by line, leaving the last line in `line[]` as
+ * the greedy path does. A trap sprung by one of those lines stops the
+ * output; the rest follows once the trap macro has run.
+ */
+struct para {
+    int ch[NPARC + WDSIZE]; /**< Characters of the held words, back to back. */
+    struct parwd wd[NPARW + 1]; /**< Space and word widths for the breaker. */
+    int wst[NPARW + 1]; /**< Start of each word in ch[]. */
+    int wn[NPARW + 1]; /**< Characters in each word. */
+    int wf[NPARW + 1]; /**< hyoff of each word. */
+    int nw, nch; /**< Words and characters held. */
+    int ends[NPARW + 2]; /**< Line ends from the breaker, see para.h. */
+    int nend, l; /**< Lines in ends[], line being output. */
+    int next, nemit; /**< Next word to output, words being output. */
+    int opt; /**< Output follows ends[]; else plain movword() filling. */
+    int inword; /**< word[] holds a held word not yet placed. */
+    int glines, gfree, gwds; /**< First-fit lines, space and words while holding. */
+};
+
+static struct para *pars[NEV]; /**< Held paragraph of each environment. */
+static int parbusy; /**< Held lines are being output. */
+static struct para *parbuf(void); /**< @brief Held paragraph of this environment. */
 
 /**
  * @brief Break the current line and output accumulated text.
@@ -215,6 +279,13 @@ void tbreak(void) {
         newline(1); /* Force a newline, which might trigger initial page setup */
         return;
     }
+    if (!parbusy && pars[ev] && pars[ev]->nw) { /* Paragraph held by .op */
+        if (pendw) { /* Finish and hold the word left open by \c */
+            getword(1);
+            parword();
+        }
+        parsync();
+    }
     if (!nc) { /* If no characters are currently on the line */
         reset_setnel_flag(); /* Ensure setnel can run if needed (related to line state init) */
         setnel(); /* Initialize line state variables (ne, nel, etc.) */
@@ -230,6 +301,8 @@ void tbreak(void) {
         movword(); /* Move the word to the line buffer */
     }
     *linep = dip->nls = 0; /* Mark end of line buffer and clear diversion's accumulated line space */
+    TRBEG(TR_BREAK, v.nl); /* From here the line is put out */
+    linesout++;
 
 #ifdef NROFF
     if (!dip->op) { /* If not in a diversion (i.e., outputting to main page) */
@@ -285,13 +358,27 @@ void tbreak(void) {
     }
     horiz(un); /* Output the (potentially adjusted) current indent */
 
+    /*
+     * A page left out by -o: pchar1() would drop every character, so
+     * skip the spacing and translation they need.  Only \x changes
+     * the page, through the line spacing it sets.
+     */
+    if (!print && !tflg && !dip->op) {
+        for (i = line; nc > 0; nc--) {
+            j = *i++;
+            if (!(j & MOT) && ((j & CMASK) == HX || (j & CMASK) == LX)) {
+                pchar(j);
+            }
+        }
+    }
+
     /* Loop through characters in the line buffer to output them */
     for (i = line; nc > 0;) {
         if (((j = *i++) & CMASK) == ' ') { /* If the character is a space */
             pad = 0; /* Initialize padding width for this block of spaces */
-            /* Accumulate width of consecutive spaces */
+            /* Accumulate width of consecutive spaces, as storeline() measured them */
             do {
-                pad += width(j); /* Add width of the current space character */
+                pad += linew[i - line - 1]; /* Add width of the current space character */
                 nc--; /* Decrement count of characters remaining on the line */
             } while (((j = *i++) & CMASK) == ' ');
             i--; /* Adjust pointer back, as the loop condition broke on a non-space or end of buffer */
@@ -355,6 +442,7 @@ void tbreak(void) {
         newline(0); /* Output an additional newline, checking for traps each time */
     }
     spread = 0; /* Reset spread flag (used by \x) */
+    TREND();
 }
 
 /**
@@ -437,6 +525,11 @@ void text(void) {
         return;
     }
 
+    if (parcont()) { /* Lines of a held paragraph still wait behind a trap */
+        nflush = 0;
+        return;
+    }
+
     if (pendw) { /* If a word is pending from a previous call (e.g., after a CONT character) */
         goto t4_getword; /* Jump to word processing section */
     }
@@ -498,6 +591,8 @@ void text(void) {
 
 t3_process_text: /* Label for general text processing */
     if (spread) { /* If spread is active (e.g. from \x, to fill rest of line with next word) */
+        if (parflush()) /* Held words first: the spread applies to their last line */
+            goto t6_end_of_word_processing;
         goto t5_spread_text; /* Jump to spread handling */
     }
 
@@ -508,6 +603,11 @@ t3_process_text: /* Label for general text processing */
         }
     }
 
+    if (parop && parbuf()) { /* .op: hold the word until the paragraph is broken */
+        if (parword())
+            goto t6_end_of_word_processing;
+        goto t3_process_text;
+    }
     if (!movword()) { /* Move word from word buffer to line buffer; returns 0 if line not full yet */
         goto t3_process_text; /* Line not full, get next word / continue processing */
     }
@@ -518,14 +618,7 @@ t5_spread_text: /* Label for when line is full or spread is active */
         pendt = 0; /* Reset pending text flag, as newline will terminate this line */
     }
 
-    adsp = adrem = 0; /* Reset adjustment space variables */
-    if (ad && (nwd - 1 > 0)) { /* If adjustment is on (.ad) and more than one word on the line */
-        adsp = nel / (nwd - 1); /* Calculate base additional space to add between words */
-#ifdef NROFF
-        adsp = (adsp / t.Adj) * t.Adj; /* Quantize space for NROFF based on its adjustment unit */
-#endif /* NROFF */
-        adrem = nel - adsp * (nwd - 1); /* Calculate remainder space for distribution */
-    }
+    adjline(); /* Spread the remaining space between the words */
     brflg = 1; /* Set break flag for a normal fill-mode break */
     tbreak(); /* Perform the line break and output */
     spread = 0; /* Reset spread flag as it's been handled */
@@ -674,7 +767,7 @@ void storeline(int c, int w) {
          * should be stored in a register identified by (c >> BYTE).
          */
         if ((i = findr(c >> BYTE)) != -1) { /* Find the index of the register */
-            vlist[i] = ne; /* Store current effective line length 'ne' into the register */
+            *nrp(i) = ne; /* Store current effective line length 'ne' into the register */
         }
         return; /* JREG itself is not stored on the line */
     }
@@ -707,6 +800,7 @@ void storeline(int c, int w) {
     }
     ne += w; /* Add character's width to effective line length 'ne' */
     nel -= w; /* Subtract character's width from remaining line length 'nel' */
+    linew[linep - line] = w; /* Kept for tbreak(), which does not measure it again */
     *linep++ = c; /* Store character in line buffer and advance pointer */
     nc++; /* Increment count of characters on the line */
 }
@@ -812,11 +906,14 @@ nl1_check_page_eject:
     }
     opn = v.pn; /* Store current page number before incrementing */
     v.pn++; /* Increment page number */
+    pagesout++;
 
     if (npnflg) { /* If a specific next page number was set by .pn N request */
         v.pn = npn; /* Use that page number */
         npn = npnflg = 0; /* Clear the flag and the stored next page number */
     }
+    if (v.pn > pnmax)
+        pnmax = v.pn;
 
     /* nlpn_handle_page_range_print: Loop to handle page printing range (pto, pfrom) */
     /* This loop checks if the current page (v.pn) or previous page (opn)
@@ -845,12 +942,19 @@ nl1_check_page_eject:
             dostop(); /* Execute stop macro/routine (e.g., pause for paper change) */
         }
     }
+    if (ipflg && print) { /* With -I, mark where the new page starts */
+        ippage(v.pn);
+    }
+    if (pmflg && print) { /* With -G, put out the page just done */
+        pmpage();
+    }
 
 /* nl2_check_traps: Check for vertical position traps (.wh N M, .dt N M) */
 nl2_check_traps:
     trap = 0; /* Reset global trap flag for this line/position check */
     if (v.nl == 0) { /* If at the very top of the page (v.nl can be 0 after eject or at start) */
-        if ((j = findn(0)) != NTRAP) { /* Check for a trap explicitly set at position 0 (e.g. header macro) */
+        if ((j = findn(0)) >= 0) { /* Check for a trap explicitly set at position 0 (e.g. header macro) */
+            TRMARK(TR_TRAP, mlist[j], v.nl);
             trap = control(mlist[j], 0); /* Execute trap macro; 'trap' var gets return status */
         }
     } else if ((i = findt(v.nl - nlss)) <= nlss) {
@@ -859,7 +963,7 @@ nl2_check_traps:
          * findt returns distance from (v.nl - nlss) to next trap.
          * So, the trap is at (v.nl - nlss + i).
          */
-        if ((j = findn1(v.nl - nlss + i)) == NTRAP) { /* Find specific trap at that exact calculated position */
+        if ((j = findn1(v.nl - nlss + i)) < 0) { /* Find specific trap at that exact calculated position */
             /* This block indicates a potential logic error or corrupted trap list if findn1 fails
              * to find a trap that findt indicated should be there.
              */
@@ -874,41 +978,135 @@ nl2_check_traps:
              * The message "Recovery successful..." is implicit by continuing.
              */
         } else {
+            TRMARK(TR_TRAP, mlist[j], v.nl);
             trap = control(mlist[j], 0); /* Execute the found trap macro */
         }
     }
 }
 
+/*
+ * Trap index
+ *
+ * trix[] holds the live slots of nlist[]/mlist[] in the order their
+ * traps spring down the page, ties by slot, and trat[] the position of
+ * each, with traps set from the bottom already measured against pl.
+ * findn1() and findt() binary search it.  It is rebuilt on the first
+ * lookup after trapmod() or after .pl has moved the bottom.
+ */
+static int trixi[NTRAP];
+static int trati[NTRAP];
+static int *trix = trixi;
+static int *trat = trati;
+static int trn; /* entries in trix[] */
+static int trpl = -1; /* pl trat[] was measured against */
+static int trdirty = 1;
+static int trgrown; /* the trap arrays live on the heap */
+
+#define TRPOS(k) (nlist[k] < 0 ? pl + nlist[k] : nlist[k])
+
+/* A trap was planted, moved or removed */
+void trapmod(void) {
+    trdirty = 1;
+}
+
+/* Grow a trap array to n slots, copying it off static storage once */
+static int *trext(int *a, int n) {
+    int *b;
+
+    if (trgrown)
+        return (OSA_REALLOC(a, n * sizeof(int)));
+    if ((b = OSA_MALLOC(n * sizeof(int))) != NULL)
+        memcpy(b, a, ntrap * sizeof(int));
+    return (b);
+}
+
+/* Make room for at least n trap slots; -1 if memory runs out */
+int trroom(int n) {
+    int *nl, *ml, *ix, *at;
+    int j, k;
+
+    for (k = ntrap; k < n;)
+        k *= 2;
+    if (k == ntrap)
+        return (0);
+    if ((nl = trext(nlist, k)) == NULL)
+        return (-1);
+    nlist = nl;
+    if ((ml = trext(mlist, k)) == NULL)
+        return (-1);
+    mlist = ml;
+    if ((ix = trext(trix, k)) == NULL)
+        return (-1);
+    trix = ix;
+    if ((at = trext(trat, k)) == NULL)
+        return (-1);
+    trat = at;
+    trgrown = 1;
+    for (j = ntrap; j < k; j++)
+        nlist[j] = mlist[j] = 0;
+    ntrap = k;
+    trdirty = 1;
+    return (0);
+}
+
+static int trcmp(const void *a, const void *b) {
+    int i = *(const int *)a, j = *(const int *)b;
+    int pi = TRPOS(i), pj = TRPOS(j);
+
+    if (pi != pj)
+        return (pi < pj ? -1 : 1);
+    return (i - j);
+}
+
+static void trsort(void) {
+    int k;
+
+    if (!trdirty && trpl == pl)
+        return;
+    for (trn = k = 0; k < ntrap; k++)
+        if (mlist[k])
+            trix[trn++] = k;
+    qsort(trix, trn, sizeof(int), trcmp);
+    for (k = 0; k < trn; k++)
+        trat[k] = TRPOS(trix[k]);
+    trpl = pl;
+    trdirty = 0;
+}
+
+/* First entry of trix[] at position a or below it, or past a if above */
+static int trfind(int a, int above) {
+    int lo, hi, m;
+
+    trsort();
+    for (lo = 0, hi = trn; lo < hi;) {
+        m = (lo + hi) / 2;
+        if (trat[m] < a || (above && trat[m] == a))
+            lo = m + 1;
+        else
+            hi = m;
+    }
+    return (lo);
+}
+
 /**
  * @brief Find a trap registered exactly at vertical position 'a'.
  *
- * Iterates through the `mlist` (macro list for traps) and `nlist` (position
- * list for traps) to find if any trap is set for the exact vertical position `a`.
- * Trap positions in `nlist` can be positive (from page top) or negative
- * (relative to page bottom, calculated as `pl + nlist[i]`).
- * All local variables are C90-style, declared at the start of the function block.
+ * Looks `a` up in the trap index.  Trap positions in `nlist` can be
+ * positive (from page top) or negative (relative to page bottom,
+ * `pl + nlist[i]`); the index holds them measured from the top.
+ * Of several traps at `a`, the lowest slot wins.
  *
  * @param a The absolute vertical position (in basic units from page top) to check for a trap.
- * @return The index of the trap in `mlist`/`nlist` if found, otherwise `NTRAP` (a sentinel value).
+ * @return The index of the trap in `mlist`/`nlist` if found, otherwise -1.
  */
 int findn1(int a) {
-    int i; /* Loop counter for iterating through trap slots */
-    int j; /* Temporary storage for the calculated absolute trap position */
-
-    for (i = 0; i < NTRAP; i++) { /* Iterate through all possible trap slots */
-        if (mlist[i]) { /* If a macro is registered for this trap slot (i.e., trap is active) */
-            if ((j = nlist[i]) < 0) { /* If trap position is negative, it's relative to page bottom */
-                /* Standard interpretation: pl (page length) + nlist[i]
-                 * e.g., if nlist[i] is -2m, trap is 2m from page bottom.
-                 */
-                j = pl + j;
-            }
-            if (j == a) { /* If the calculated absolute trap position matches the requested position 'a' */
-                break; /* Trap found, exit loop with 'i' as the index */
-            }
-        }
+    int k; /* Index of the first trap at or below 'a' */
+
+    k = trfind(a, 0);
+    if (k < trn && trat[k] == a) {
+        return (trix[k]);
     }
-    return (i); /* Return index 'i'. If loop completed without break, i == NTRAP, indicating not found. */
+    return (-1);
 }
 
 /**
@@ -970,8 +1168,7 @@ void chkpn(void) {
  *         or if past the diversion trap.
  */
 int findt(int a) {
-    int i; /* Loop counter for traps, or temporary for distances */
-    int j; /* Calculated absolute position of a trap */
+    int i; /* Index of the next trap, or temporary for distances */
     int k; /* Minimum distance found so far to the next trap */
 
     k = 32767; /* Initialize minimum distance to a large value (effectively positive infinity for short int) */
@@ -987,20 +1184,9 @@ int findt(int a) {
         return (k);
     }
 
-    /* Not in a diversion, check page traps */
-    for (i = 0; i < NTRAP; i++) { /* Iterate through all page trap slots */
-        if (mlist[i]) { /* If a macro is registered for this trap (trap is active) */
-            if ((j = nlist[i]) < 0) { /* If trap position is negative (relative to page bottom) */
-                j = pl + j; /* Calculate absolute position from page top */
-            }
-            if ((j -= a) <= 0) { /* Calculate distance from current position 'a' to this trap 'j'.
-                                  * If trap is at or before 'a' (j <= 0), ignore it. */
-                continue;
-            }
-            if (j < k) { /* If this trap is closer than previous minimum 'k' */
-                k = j; /* Update minimum distance */
-            }
-        }
+    /* Not in a diversion: the first page trap below 'a' in the index */
+    if ((i = trfind(a, 1)) < trn && trat[i] - a < k) {
+        k = trat[i] - a;
     }
 
     i = pl - a; /* Distance to physical page bottom from current position 'a' */
@@ -1108,8 +1294,11 @@ int movword(void) {
     int i; /* Temporary storage for character being processed */
     int w; /* Width of the character 'i' */
     int *wp; /* Pointer to current character in word buffer `word[]` */
-    int savwch; /* Original word character count, for hyphenation logic */
     int hyphen_width; /* Width of a hyphen character, used in break decisions */
+    int hpos[NHYP]; /* Usable hyphenation points, as word[] indices */
+    int ws, wend; /* First and one-past-last word[] index placed on this line */
+    int k, h, lo, hi, mid, cut;
+    int **hp; /* Scans the hyphenation point list */
 
     over = 0; /* Reset line overflow flag for this operation (storeline might set it) */
     wp = wordp; /* Initialize 'wp' to point to the start of the current word data in `word[]` */
@@ -1120,7 +1309,7 @@ int movword(void) {
          */
         while (((i = *wp++) & CMASK) == ' ') { /* Read character, check if space, then advance pointer */
             wch--; /* Decrement character count of the word in buffer */
-            wne -= width(i); /* Adjust word width by subtracting space width */
+            wne -= wdpre[wp - word] - wdpre[wp - word - 1]; /* Less the space's width, as storeword() kept it */
         }
         wp--; /* Adjust pointer back to the first non-space character (or to original position if no spaces) */
     }
@@ -1138,7 +1327,6 @@ int movword(void) {
                      */
     }
 
-    savwch = wch; /* Save original character count of the word (before any part is moved to line) */
     hyp = hyptr; /* Point 'hyp' (global pointer to hyphenation points array) to `hyptr` */
     nhyp = 0; /* Reset count of actual hyphenation points inserted into the line for this word */
 
@@ -1150,115 +1338,469 @@ int movword(void) {
         hyp++; /* Move to the next hyphenation point */
     }
 
-    /* Transfer characters from word buffer `word[]` (via `wp`) to line buffer `line[]` (via `storeline`) */
-    while (wch) { /* While there are characters left in the word buffer for the current word */
-        if ((hyoff != 1) && (*hyp == wp)) { /* If hyphenation is not completely off (hyoff != 1) AND current char `*wp` is a hyphenation point `*hyp` */
-            hyp++; /* Move to next potential hyphenation point for subsequent characters */
-            /* Check various conditions to decide if a discretionary hyphen (IMP) should be inserted here.
-             * These conditions prevent hyphenating too close to word start/end, or based on specific hyf flags.
-             */
-            if (!wdstart || /* If no specific word start/end boundaries are defined for hyphenation rules, or... */
-                ((wp > (wdstart + 1)) && /* Current point 'wp' is after the first char of allowed hyphenation zone */
-                 (wp < wdend) && /* And 'wp' is before the end of allowed hyphenation zone */
-                 (!(hyf & 04) || (wp < (wdend - 1))) && /* Condition related to hyf flag 04 (e.g. don't hyphenate last two chars) */
-                 (!(hyf & 010) || (wp > (wdstart + 2))))) /* Condition related to hyf flag 010 (e.g. don't hyphenate first three chars) */
-            {
-                nhyp++; /* Count this as a potential hyphenation point used on the line */
-                storeline(IMP, 0); /* Store an implicit hyphen marker (IMP). It has zero width but signals a hyphenation spot. */
-                /* The actual hyphen char might be rendered later if this IMP is chosen for line break. */
-            }
+    /* Collect the hyphenation points that may carry a discretionary hyphen (IMP),
+     * as word[] indices. Points too close to the word start/end, or excluded by
+     * the hyf flags, are skipped.
+     */
+    ws = wp - word; /* Index of the first character still to be placed */
+    for (k = ws, hp = hyp; k < ws + wch; k++) {
+        if ((hyoff != 1) && (*hp == &word[k])) {
+            hp++;
+            if ((k > ws) && (nhyp < NHYP) &&
+                (!wdstart ||
+                 ((&word[k] > (wdstart + 1)) && (&word[k] < wdend) &&
+                  (!(hyf & 04) || (&word[k] < (wdend - 1))) &&
+                  (!(hyf & 010) || (&word[k] > (wdstart + 2))))))
+                hpos[nhyp++] = k;
+        }
+    }
+
+    /* Pick the break point from the prefix widths kept by storeword(), rather
+     * than storing the whole word and taking it back letter by letter:
+     * the rightmost point whose prefix plus a hyphen fits in 'nel'. The first
+     * word on a line must go somewhere, so it falls back to the leftmost point,
+     * or to the whole word, overfull, if there is none.
+     */
+    wend = ws + wch; /* Index just past the part of the word that is placed */
+    cut = 0;
+    if ((wdpre[ws + wch] - wdpre[ws]) > nel) {
+        xbitf = 1; /* Line will not hold the whole word */
+        hyphen_width = width(0200); /* Width of the hyphen added at the break */
+        lo = 0;
+        hi = nhyp;
+        while (lo < hi) { /* Count the points whose prefix fits with a hyphen */
+            mid = (lo + hi) / 2;
+            if ((nel - (wdpre[hpos[mid]] - wdpre[ws])) >= hyphen_width)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo) {
+            wend = hpos[lo - 1];
+        } else if (!nwd && nhyp) {
+            wend = hpos[0];
+        } else if (nwd) {
+            return (1); /* Nothing fits: the word goes to the next line untouched */
+        }
+        cut = (wend < ws + wch);
+    }
+
+    /* Transfer characters up to the break from word buffer `word[]` to line buffer `line[]`,
+     * marking every earlier hyphenation point with an IMP.
+     */
+    for (k = ws, h = 0; k < wend; k++) {
+        if ((h < nhyp) && (hpos[h] == k)) { /* Discretionary hyphen before this character */
+            h++;
+            storeline(IMP, 0);
         }
         i = *wp++; /* Get character from word buffer and advance word buffer pointer `wp` */
-        w = width(i); /* Get its width */
-        wne -= w; /* Update remaining width needed for the rest of the word (by subtracting this char's width) */
+        w = wdpre[k + 1] - wdpre[k]; /* Its width, as storeword() kept it */
+        wne -= w; /* Update remaining width needed for the rest of the word */
         wch--; /* Decrement character count for the word in buffer */
         storeline(i, w); /* Store character 'i' and its width 'w' into the line buffer */
     }
+    nhyp = h; /* Hyphenation points left in the line */
 
-    /* After attempting to store all characters of the word (or what's left of it) */
-    if (nel >= 0) { /* If there's still space on the line (nel >= 0), or line is exactly full (nel == 0) */
+    if (!cut) {
         nwd++; /* Increment word count on the line */
-        return (0); /* Word placed successfully without needing to break it, or line is now ready for break. */
-        /* Indicates that text() can continue to get the next word for this line if it was not full. */
+        if (nel >= 0) /* Word placed and the line can take more */
+            return (0);
+        wordp = wp; /* First word on the line, placed overfull */
+        return (1);
     }
 
-    /* Word (or remaining part) doesn't fit (nel < 0). Line is overfull.
-     * Try to break at a hyphenation point if possible.
+    /* Broken at a hyphenation point: end the line with a hyphen in the font of
+     * the preceding character, unless that character already is one.
      */
-    xbitf = 1; /* Flag that line may be too long / needs adjustment or hyphenation. (xbitf: "extra bit" flag) */
-    hyphen_width = width(0200); /* Get width of a standard hyphen character (0200 is often a hyphen).
-                                 * This is used to see if breaking and adding a hyphen is feasible. */
-
-m1_check_hyphen: /* Label for hyphenation check logic when word overflows */
-    if (!nhyp) { /* If no hyphenation points were inserted into the line for this word, or all have been considered and "retracted" */
-        if (!nwd) { /* If this was the first word on the line (nwd == 0) */
-            /* First word must be placed, even if it makes the line overfull. Cannot break it back further. */
-            goto m3_word_placed_or_overfull; /* Jump to finalization for this word */
+    i = *(wp - 1);
+    if ((i & CMASK) != '-' && (i & CMASK) != 0203)
+        storeline((i & ~CMASK) | 0200, -1);
+    nwd++; /* Increment word count */
+    wordp = wp; /* Update global word pointer to remaining part of word */
+    return (1); /* Indicates line is full and the rest of the word remains */
+}
+
+/** Characters fetched per getrun() call in getword(). */
+#define NRUN 64
+
+/**
+ * @brief Note a hyphenation point at the current word position.
+ *
+ * Handles the optional-hyphen character (which is consumed) and the
+ * implicit break after an explicit hyphen or em dash.
+ *
+ * @param j Character code (CMASK bits) about to be stored.
+ * @return 1 if `j` was an optional hyphen and must not be stored.
+ */
+static int wordhy(int j) {
+    if (hyoff == 1) /* Hyphenation suppressed for this word */
+        return 0;
+    if (j == ohc) { /* Optional hyphen: mark the point, store nothing */
+        hyoff = 2;
+        *hyp++ = wordp;
+        if (hyp > (hyptr + NHYP - 1))
+            hyp = hyptr + NHYP - 1;
+        return 1;
+    }
+    if (((j == '-') || (j == 0203)) && (wordp > word + 1)) { /* Break after '-' or 3/4 em dash */
+        hyoff = 2;
+        *hyp++ = wordp + 1;
+        if (hyp > (hyptr + NHYP - 1))
+            hyp = hyptr + NHYP - 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Collect the next word from the input into `word[]`.
+ *
+ * Leading spaces are stored as part of the word (they become the
+ * inter-word gap), optional-hyphen and dash positions are noted in
+ * `hyptr[]`, and a continuation character leaves the word pending in
+ * `pendw` for the next input line.  Runs of plain text that need no
+ * per-character input handling are taken a batch at a time through
+ * getrun().
+ *
+ * @param x Non-zero to finish a word left pending by a continuation.
+ * @return 1 if a newline was found before any word, 0 otherwise.
+ */
+int getword(int x) {
+    register int i, j, k;
+    int swp, n, noword;
+    int run[NRUN], rw[NRUN];
+
+    noword = 0;
+    if (x && pendw) { /* Terminate a word left pending by \c */
+        *pendw = 0;
+        goto rtn;
+    }
+    if ((wordp = pendw) != 0) /* Resume the pending word */
+        goto g1;
+    hyp = hyptr;
+    wordp = word;
+    over = wne = wch = 0;
+    hyoff = 0;
+    while (1) { /* Skip and store leading spaces */
+        j = (i = GETCH()) & CMASK;
+        if (j == '\n') {
+            wne = wch = 0;
+            noword = 1;
+            goto rtn;
         }
-        if (wch == savwch) { /* If no characters were removed from word (cannot break) */
-            goto m4_cannot_break_word; /* This implies the word itself is too long for the line */
+        if (j == ohc) { /* Optional hyphen before the word: no hyphenation */
+            hyoff = 1;
+            continue;
         }
-    }
+        if (j == ' ') {
+            storeword(i, cwidth);
+            continue;
+        }
+        break;
+    }
+    swp = widthp;
+    storeword(' ' | chbits, -1); /* Inter-word space */
+    if (spflg) { /* Extra space after end of sentence */
+        storeword(' ' | chbits, -1);
+        spflg = 0;
+    }
+    widthp = swp;
+g0:
+    if (j == CONT) { /* \c: keep the word open across the newline */
+        pendw = wordp;
+        nflush = 0;
+        flushi();
+        return 1;
+    }
+    if (!wordhy(j))
+        storeword(i, cwidth);
+#ifdef NROFF
+    if (!(chbits & ulbit))
+#endif /* NROFF */
+        while ((n = getrun(run, rw, NRUN)) > 0) { /* Plain text in bulk */
+            for (k = 0; k < n; k++) {
+                i = run[k];
+                if (!wordhy(i & CMASK))
+                    storeword(i, rw[k]);
+            }
+        }
+g1:
+    j = (i = GETCH()) & CMASK;
+    if (j != ' ') {
+        if (j != '\n')
+            goto g0;
+        j = *(wordp - 1) & CMASK; /* Sentence end at line end: two spaces next */
+        if ((j == '.') || (j == '!') || (j == '?'))
+            spflg++;
+    }
+    *wordp = 0;
+rtn:
+    wdstart = 0;
+    wordp = word;
+    pendw = 0;
+    *hyp++ = 0;
+    setnel();
+    return noword;
+}
 
-    /* Try to remove characters back to a hyphenation point */
-    if (*--linep != IMP) /* Move line pointer back. If not an IMP, it's a letter. */
-        goto m5_backtrack_letter; /* Backtrack this letter */
+/**
+ * @brief Store a character and its width in the word buffer.
+ *
+ * On overflow a single marker character is stored and a warning is
+ * printed once per word; further characters are dropped.  The last
+ * word[] is kept for the 0 getword() ends the word with, so neither
+ * word[] nor wdpre[] is stored past its end.
+ *
+ * @param c Character with attributes.
+ * @param w Width, or -1 to compute it with width().
+ */
+void storeword(int c, int w) {
+    if (wordp >= &word[WDSIZE - 2]) {
+        if (over)
+            return;
+        prstrfl("Word overflow.\n");
+        over++;
+        c = 0343;
+        w = -1;
+    }
+    if (w == -1)
+        w = width(c);
+    wne += w;
+    wdpre[wordp - word + 1] = wdpre[wordp - word] + w;
+    *wordp++ = c;
+    wch++;
+}
 
-    /* It was an IMP. We are at a valid hyphenation point. */
-    nc--; /* Account for removing the IMP itself from the line character count */
-    if (!(--nhyp)) { /* Decrement count of available hyphen points. If none left... */
-        if (!nwd) /* And it's the first word... */
-            goto m2_insert_hyphen_char; /* Must place it, try to add hyphen char */
+/**
+ * @brief Set the extra interword space that spreads the current line.
+ *
+ * Shares the remaining space `nel` between the `nwd - 1` gaps when
+ * adjusting; tbreak() hands out `adrem` a unit at a time.
+ */
+static void adjline(void) {
+    adsp = adrem = 0; /* Reset adjustment space variables */
+    if (ad && (nwd - 1 > 0)) { /* If adjustment is on (.ad) and more than one word on the line */
+        adsp = nel / (nwd - 1); /* Calculate base additional space to add between words */
+#ifdef NROFF
+        adsp = (adsp / t.Adj) * t.Adj; /* Quantize space for NROFF based on its adjustment unit */
+#endif /* NROFF */
+        adrem = nel - adsp * (nwd - 1); /* Calculate remainder space for distribution */
     }
+}
 
-    if ((nel + width(IMP)) < hyphen_width) { /* Not enough space even for the hyphen character itself (IMP has 0 width but we add it back conceptually for this check) */
-        /* nc was already decremented for IMP */
-        goto m1_check_hyphen; /* Re-evaluate, try to backtrack further if possible */
-    }
+/**
+ * @brief Return the held paragraph of the current environment.
+ *
+ * Created on first use. NULL if memory runs out, in which case the
+ * environment keeps filling a line at a time.
+ */
+static struct para *parbuf(void) {
+    if (!pars[ev])
+        pars[ev] = OSA_CALLOC(1, sizeof(struct para));
+    return (pars[ev]);
+}
 
-m2_insert_hyphen_char:
-    /* At a valid hyphen point with space for a hyphen char */
-    i = *(linep - 1); /* Get char before IMP (which is now pointed to by linep after *--linep) */
-    /* This IMP will be overwritten or the char before it modified */
-    w = width(i); /* Width of char before IMP */
-    ne -= w; /* Remove its width from effective line length */
-    nel += w; /* Add its width back to remaining line length */
-    /* linep currently points to where IMP was. We will overwrite it or the char before it. */
+/**
+ * @brief Lines that can be output before the next trap springs.
+ *
+ * Held words are only broken when needed, so a paragraph is broken early
+ * once it would run past the next trap; its lines are then output while
+ * the trap can still interrupt them.
+ */
+static int parlines(void) {
+    int step, n;
 
-    if ((i & CMASK) != '-' && (i & CMASK) != 0203) { /* If char before IMP is not already a hyphen or em-dash */
-        *(linep - 1) = (*(linep - 1) & ~CMASK) | 0200; /* Replace char before IMP with actual hyphen, keeping font */
-        w = width(*(linep - 1)); /* Get width of this new hyphen character */
-        nel -= w; /* Adjust remaining line length */
-        ne += w; /* Adjust effective line length */
-        /* IMP is effectively gone, replaced by modifying the char *before* its original position.
-         * No change to linep needed as the hyphen replaced the character *before* the IMP's original position.
-         * nc was already decremented for the IMP.
-         */
-    } else {
-        /* If it was already a hyphen/em-dash, the IMP is simply removed.
-         * linep still points to where IMP was. The char before it is fine.
-         * nc was already decremented.
-         */
+    if ((step = lss * ls) <= 0)
+        step = 1;
+    n = (findt1() + step - 1) / step;
+    return (n > 0 ? n : 1);
+}
+
+/**
+ * @brief Hold the word just collected in `word[]`.
+ *
+ * Also tracks how many lines first fit would need so far, and breaks
+ * the paragraph early when that passes the next trap or the hold is full.
+ *
+ * @return 1 if breaking early was stopped by a trap, 0 otherwise.
+ */
+static int parword(void) {
+    struct para *pp;
+    int k, add;
+
+    pp = pars[ev];
+    if (!pp->nw) { /* First-fit count starts from the partial line */
+        pp->glines = 0;
+        pp->gfree = nel;
+        pp->gwds = nwd;
+    }
+    for (k = 0; (k < wch) && ((word[k] & CMASK) == ' '); k++)
+        ;
+    pp->wd[pp->nw].sp = wdpre[k];
+    pp->wd[pp->nw].wid = wdpre[wch] - wdpre[k];
+    pp->wst[pp->nw] = pp->nch;
+    pp->wn[pp->nw] = wch;
+    pp->wf[pp->nw] = hyoff;
+    memcpy(&pp->ch[pp->nch], word, wch * sizeof(int));
+    pp->nch += wch;
+    wch = wne = 0;
+
+    add = pp->gwds ? pp->wd[pp->nw].sp + pp->wd[pp->nw].wid : pp->wd[pp->nw].wid;
+    if (pp->gwds && (add > pp->gfree)) {
+        pp->glines++;
+        pp->gfree = ll - in;
+        pp->gwds = 0;
+        add = pp->wd[pp->nw].wid;
+    }
+    pp->gfree -= add;
+    pp->gwds++;
+    pp->nw++;
+
+    if ((pp->nw >= NPARW) || (pp->nch >= NPARC) || (pp->glines >= parlines()))
+        return (parflush());
+    return (0);
+}
+
+/**
+ * @brief Put held word i back into `word[]` for movword().
+ *
+ * Words follow the breaker's layout unhyphenated; under plain filling
+ * they hyphenate as they would have when first read.
+ */
+static void parload(struct para *pp, int i) {
+    int k;
+
+    wordp = word;
+    over = wne = wch = 0;
+    for (k = 0; k < pp->wn[i]; k++)
+        storeword(pp->ch[pp->wst[i] + k], -1);
+    *wordp = 0;
+    wordp = word;
+    wdstart = 0;
+    hyptr[0] = 0;
+    hyoff = pp->opt ? 1 : pp->wf[i];
+}
+
+/**
+ * @brief Output held words until the last line or a trap.
+ *
+ * @return 1 if a trap sprang, 0 once only the last line remains.
+ */
+static int paremit(struct para *pp) {
+    int full, r;
+
+    r = 0;
+    parbusy++;
+    while (pp->inword || (pp->next < pp->nemit)) {
+        if (!pp->inword) {
+            if (pp->opt && (pp->l < pp->nend - 1) && (pp->next == pp->ends[pp->l])) {
+                pp->l++; /* Line ends here */
+                if (!nc)
+                    continue;
+                adjline();
+                brflg = 1;
+                tbreak();
+                if (trap) {
+                    r = 1;
+                    break;
+                }
+                continue;
+            }
+            parload(pp, pp->next++);
+        }
+        full = movword();
+        pp->inword = (wch != 0);
+        if (!full)
+            continue;
+        if (pp->opt && !pp->inword && (pp->l < pp->nend - 1) &&
+            (pp->next == pp->ends[pp->l]))
+            pp->l++; /* Line was due to end here anyway */
+        adjline();
+        brflg = 1;
+        tbreak();
+        if (trap) {
+            r = 1;
+            break;
+        }
     }
-    /* hsend(); // Potentially send hyphenation data; commented out in original */
+    parbusy--;
+    if (!pp->inword && (pp->next >= pp->nemit))
+        pp->nw = pp->nch = pp->next = pp->nemit = 0;
+    return (r);
+}
 
-m3_word_placed_or_overfull:
-    nwd++; /* Increment word count */
+/**
+ * @brief Whether any environment holds words of a paragraph.
+ *
+ * A page checkpoint (pgindex.c) is only taken when none does.
+ */
+int parheld(void) {
+    int k;
+
+    if (parbusy)
+        return (1);
+    for (k = 0; k < NEV; k++)
+        if (pars[k] && (pars[k]->nw || pars[k]->inword || (pars[k]->next < pars[k]->nemit)))
+            return (1);
+    return (0);
+}
 
-m4_cannot_break_word: /* Word is placed (possibly overfull, or couldn't be hyphenated) */
-    wordp = wp; /* Update global word pointer to remaining part of word */
-    return (1); /* Indicates line is full / word was broken or couldn't fit */
-
-m5_backtrack_letter: /* Backtracking a regular character (not an IMP) */
-    /* linep already moved back by *--linep in the m1_check_hyphen path */
-    nc--; /* Decrement character count on line */
-    w = width(*linep); /* Get width of the character being removed */
-    ne -= w; /* Adjust effective line length */
-    nel += w; /* Adjust remaining line length (add width back) */
-    wne += w; /* Add width back to 'width needed for word' (as it's put back to word buffer) */
-    wch++; /* Increment character count of word (as it's put back) */
-    wp--; /* Move word buffer pointer back */
-    goto m1_check_hyphen; /* Re-evaluate hyphenation possibilities */
+/**
+ * @brief Resume output of held lines interrupted by a trap.
+ *
+ * @return 1 if another trap sprang, 0 if none are left.
+ */
+static int parcont(void) {
+    struct para *pp;
+
+    if (parbusy || nb || !(pp = pars[ev]) || (!pp->inword && (pp->next >= pp->nemit)))
+        return (0);
+    return (paremit(pp));
+}
+
+/**
+ * @brief Break the held paragraph and output all but its last line.
+ *
+ * Uses parfit() unless the paragraph defeats it or its layout would run
+ * past the next trap (first fit never needs more lines), in which case
+ * the words are filled a line at a time as they came.
+ *
+ * @return 1 if a trap stopped the output, 0 otherwise.
+ */
+int parflush(void) {
+    struct para *pp;
+    struct parlim lim;
+    int k;
+
+    if (parbusy || nb || !(pp = pars[ev]))
+        return (0);
+    if (pp->inword || (pp->next < pp->nemit))
+        return (paremit(pp));
+    if (!pp->nw)
+        return (0);
+    if (!nc)
+        setnel();
+    lim.w0 = nel;
+    lim.g0 = nwd;
+    lim.w = ll - in;
+    lim.sps = sps;
+    k = parfit(pp->wd, pp->nw, &lim, pp->ends);
+    pp->opt = (k > 0) && (k <= parlines());
+    pp->nend = pp->opt ? k : 0;
+    pp->l = pp->next = 0;
+    pp->nemit = pp->nw;
+    return (paremit(pp));
+}
+
+/**
+ * @brief Output the held paragraph but its last line, whatever traps spring.
+ *
+ * For breaks forced by requests, which cannot wait for a trap macro.
+ * Lines are only held this far when they fit before the next trap, so
+ * this normally finishes in one pass.
+ */
+void parsync(void) {
+    while (parflush())
+        ;
 }
 
 /**
@@ -19,9 +19,14 @@
  */
 
 #include "tdef.h" /* updated header extension */
+#include "core/hyphenation.h" /* pattern and digram hyphenation */
+#include "trace.h" /* -Y event trace */
+#define OSA_TAG "croff.hyph"
+#include "os/os_acct.h" /* OSA_CALLOC, OSA_REALLOC */
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
 #include <ctype.h>
 
 /* ================================================================
@@ -29,7 +34,13 @@
  * ================================================================ */
 
 /* Core hyphenation functions */
+void hyphen(int *wp);
 void hyphenateWord(int *wp);
+void hcclear(void);
+int hxadd(const char *w);
+int hxload(const char *file);
+const char *hxwords(int *n);
+int hxreset(const char *w, int n);
 void caseht(void);
 void casehw(void);
 
@@ -41,43 +52,69 @@ int maplow(int i);
 
 /* Word analysis functions */
 int exword(void);
+void patword(void);
 int suffix(void);
+int sufbuild(void);
 void digram(void);
 int chkvow(int *w);
 
-/* Utility functions */
-char *getsuf(char *x);
-unsigned char rdsufb(char *i);
-int dilook(int a, int b, char t[26][13]);
-int calculate_digram_value(int *w, char bxh[26][13], char bxxh[26][13],
-                           char xxh[26][13], char xhx[26][13], char hxx[26][13]);
-
 /* Helper functions for vowel and digram processing */
 int *find_next_vowel(int *start);
-int *find_max_digram(int *start, int *end, int *maxval);
 
 /* External function declarations */
 extern int skip(void);
 extern int tatoi(void);
 extern void prstr(const char *);
 extern int getch(void);
-extern unsigned char suftab_get_byte(size_t index);
+extern const unsigned char *suftab_entries(int letter_idx);
+extern size_t suftab_get_size(void);
 
 /* ================================================================
  * GLOBAL VARIABLES AND CONSTANTS
  * ================================================================ */
 
 /**
- * @brief Exception word buffer for storing hyphenation exceptions
- * @details Buffer to store words that have specific hyphenation patterns
- * that override the algorithmic hyphenation rules
+ * @brief Exception dictionary trie node
+ * @details Nodes are kept in hxtab[] with node 0 as the root.  The
+ * children of a node form a list through sib, so a lookup costs one
+ * short list walk per letter of the word.
+ */
+struct hxnode {
+    int kid;  /**< First child, 0 if none */
+    int sib;  /**< Next child of the same parent, 0 if none */
+    int word; /**< 1 + offset in hxpool of the word ending here, 0 if none */
+    char c;   /**< Letter leading to this node */
+};
+
+/**
+ * @brief Exception word trie
+ * @details Words entered with .hw or loaded with -E.  The words
+ * themselves are kept in hxpool[] in the old hbuf format: lower-case
+ * letters, with 0200 set on each letter a hyphen may precede.
  */
-char hbuf[NHEX] = {0};
+static struct hxnode *hxtab;
+static int hxnodes, hxnmax;
+static char *hxpool;
+static int hxplen, hxpmax;
 
 /**
- * @brief Pointer to next position in exception word buffer
+ * @brief Reversed suffix trie node
+ * @details Nodes 1-26 stand for the final letters a-z; below them each
+ * suffix in suftab.c is spelled backwards, so a walk from the end of a
+ * word towards its start meets every suffix the word ends in.
  */
-char *nexth = hbuf;
+struct sfnode {
+    int kid; /**< First child, 0 if none */
+    int sib; /**< Next child of the same parent, 0 if none */
+    const unsigned char *ent; /**< Earliest table entry ending here, NULL if none */
+    char c; /**< Letter leading to this node */
+};
+
+/**
+ * @brief Suffix trie, built from suftab.c on first use
+ */
+static struct sfnode *sftab;
+static int sfnodes;
 
 /**
  * @brief End of current word for hyphenation analysis
@@ -88,7 +125,7 @@ int *hyend;
  * @brief Digram goodness threshold for hyphenation decisions
  * @details Values above this threshold indicate good hyphenation points
  */
-#define THRESH 160
+#define THRESH OTROFF_DIGRAM_THRESH
 int thresh = THRESH;
 
 /**
@@ -96,6 +133,46 @@ int thresh = THRESH;
  */
 #define SBSZ 128
 
+/**
+ * @brief Longest word kept in the hyphenation cache
+ */
+#define HCWORD 31
+
+/**
+ * @brief Hyphenation cache entry
+ * @details A word's break points depend only on its lower-cased letters,
+ * the exception list and the digram threshold, so they are kept as
+ * offsets from the first letter and reused whenever the word recurs.
+ */
+struct hcent {
+    char w[HCWORD + 1];      /**< Lower-cased word, empty if the slot is free */
+    unsigned char n;         /**< Number of break points */
+    unsigned char off[NHYP]; /**< Break points as offsets from wdstart */
+};
+
+/**
+ * @brief Find breaks with Liang patterns instead of suffix and digram (-P)
+ */
+int hypat;
+
+/**
+ * @brief Hyphenation cache slots (-H), 0 to disable the cache
+ */
+int hcsize = NHCACHE;
+
+/**
+ * @brief Hyphenation cache hits and misses, reported by -S
+ */
+long hchit, hcmiss;
+
+/**
+ * @brief Words given to hyphen(), and those it found a point in, reported by -S
+ */
+long hywords, hyphenated;
+
+static struct hcent *hctab;  /* cache, hcslots entries once allocated */
+static unsigned hcslots;     /* power of two, 0 until first use */
+
 /* ================================================================
  * EXTERNAL VARIABLE DECLARATIONS
  * ================================================================ */
@@ -125,11 +202,6 @@ extern int hyoff;
  */
 extern int suffid;
 
-/**
- * @brief Suffix index array for alphabet lookup
- */
-extern char *sufind[26];
-
 /**
  * @brief Scale control flag
  */
@@ -144,6 +216,105 @@ extern int xxx;
  * CORE HYPHENATION FUNCTIONS
  * ================================================================ */
 
+/**
+ * @brief Allocate the hyphenation cache, hcsize rounded up to a power of two
+ * @return 0 on success, -1 if out of memory, when the cache is turned off
+ */
+static int hcalloc(void) {
+    unsigned n;
+
+    for (n = 1; n < (unsigned)hcsize; n <<= 1)
+        ;
+    if ((hctab = OSA_CALLOC(n, sizeof(*hctab))) == NULL) {
+        hcsize = 0;
+        return -1;
+    }
+    hcslots = n;
+    return 0;
+}
+
+/**
+ * @brief Find the points for wdstart..wdend in the hyphenation cache
+ * @param key Receives the lower-cased word
+ * @return Cache slot for the word, or NULL if it is not cacheable
+ *
+ * @details
+ * The table is allocated on first use.  A word probes at most four
+ * slots; when all are taken by other words the first one is reused.
+ */
+static struct hcent *hcslot(char *key) {
+    struct hcent *e;
+    unsigned h, k;
+    int *p;
+
+    if (hcsize <= 0 || (wdend - wdstart) >= HCWORD)
+        return NULL;
+    if (!hcslots && hcalloc() < 0)
+        return NULL;
+    h = 2166136261u;
+    for (k = 0, p = wdstart; p <= wdend; p++) {
+        key[k++] = (char)maplow(*p);
+        h = (h ^ (unsigned char)key[k - 1]) * 16777619u;
+    }
+    key[k] = 0;
+    for (k = 0; k < 4; k++) {
+        e = &hctab[(h + k) & (hcslots - 1)];
+        if (!e->w[0] || strcmp(e->w, key) == 0)
+            return e;
+    }
+    return &hctab[h & (hcslots - 1)];
+}
+
+/**
+ * @brief Build the suffix trie and the hyphenation cache before first use
+ *
+ * @details
+ * For croff -D, so that every job forked from the server finds them
+ * in place rather than building its own.
+ */
+void hywarm(void) {
+    if (!sfnodes)
+        sufbuild();
+    if (hcsize > 0 && !hcslots)
+        hcalloc();
+}
+
+/**
+ * @brief Forget every cached hyphenation
+ *
+ * @details
+ * Called when the exception list or the digram threshold changes.
+ */
+void hcclear(void) {
+    unsigned i;
+
+    for (i = 0; i < hcslots; i++)
+        hctab[i].w[0] = 0;
+}
+
+/**
+ * @brief Hyphenate the word at wp
+ * @param wp Pointer to the word in word[]
+ *
+ * @details
+ * Entry point used by movword(); see hyphenateWord().
+ *
+ * The points are found here, on the formatting thread, when a word
+ * does not fit, and not ahead of time on another.  Finding them works
+ * through wdstart, wdend, hyend and hyptr, the words .hw adds, thresh
+ * and the cache, all shared with casehw(), caseht() and movword()
+ * without a lock; a word worked on early could meet .hw or .ht before
+ * movword() took it.  Words that recur are answered by the cache, at
+ * the cost of a hash and a compare.
+ */
+void hyphen(int *wp) {
+    TRBEG(TR_HYPH, 0);
+    hyphenateWord(wp);
+    hywords++;
+    hyphenated += hyptr[0] != 0;
+    TREND();
+}
+
 /**
  * @brief Main word hyphenation function
  * @param wp Pointer to the word to be hyphenated
@@ -155,15 +326,18 @@ extern int xxx;
  * 3. Sets up word start/end pointers for analysis
  * 4. Attempts hyphenation using multiple strategies:
  *    - Exception word list lookup
+ *    - Liang patterns when -P is given, otherwise
  *    - Suffix-based analysis
  *    - Digram-based algorithmic hyphenation
- * 5. Sorts the resulting hyphenation points
+ * 5. Sorts the resulting hyphenation points by insertion
  * 
  * The function uses a multi-stage approach where each method can
  * provide hyphenation points, and the results are combined and sorted.
  */
 void hyphenateWord(int *wp) {
-    int *i, j;
+    int *i, **h, j;
+    struct hcent *e;
+    char key[HCWORD + 1];
 
     /* Validate input parameter */
     if (wp == NULL) {
@@ -210,8 +384,24 @@ void hyphenateWord(int *wp) {
     *hyp = 0;
     hyoff = 2;
 
-    /* Try exception word list first, then suffix analysis */
-    if (exword() || suffix()) {
+    /* Reuse the points found the last time this word came up */
+    if ((e = hcslot(key)) != NULL && strcmp(e->w, key) == 0) {
+        hchit++;
+        for (j = 0; j < e->n; j++)
+            *hyp++ = wdstart + e->off[j];
+        *hyp = 0;
+        return;
+    }
+
+    /* Try exception word list first, then patterns or suffix analysis */
+    if (exword()) {
+        goto rtn;
+    }
+    if (hypat) {
+        patword();
+        goto rtn;
+    }
+    if (suffix()) {
         goto rtn;
     }
 
@@ -222,19 +412,21 @@ rtn:
     /* Terminate hyphenation point list */
     *hyp++ = 0;
 
-    /* Sort hyphenation points using bubble sort */
-    if (*hyptr) {
-        for (j = 1; j;) {
-            j = 0;
-            for (hyp = hyptr + 1; *hyp != 0; hyp++) {
-                if (*(hyp - 1) > *hyp) {
-                    j++;
-                    i = *hyp;
-                    *hyp = *(hyp - 1);
-                    *(hyp - 1) = i;
-                }
-            }
-        }
+    /* Sort hyphenation points; there are at most NHYP of them */
+    for (hyp = hyptr + 1; *hyptr && *hyp != 0; hyp++) {
+        i = *hyp;
+        for (h = hyp; h > hyptr && *(h - 1) > i; h--)
+            *h = *(h - 1);
+        *h = i;
+    }
+
+    /* Remember the points for the next time */
+    if (e != NULL) {
+        hcmiss++;
+        strcpy(e->w, key);
+        for (j = 0; j < NHYP && hyptr[j] != 0; j++)
+            e->off[j] = (unsigned char)(hyptr[j] - wdstart);
+        e->n = (unsigned char)j;
     }
 }
 /* ================================================================
@@ -334,6 +526,9 @@ int vowel(int i) {
  * more conservative.
  */
 void caseht(void) {
+    /* Cached points were found with the old threshold */
+    hcclear();
+
     /* Reset threshold to default */
     thresh = THRESH;
 
@@ -356,20 +551,16 @@ void caseht(void) {
  * which adds words to the exception list. Words in this list
  * have specific hyphenation points that override algorithmic
  * hyphenation. Hyphenation points are marked with hyphens.
+ * A word given again replaces its earlier hyphenation.
  */
 void casehw(void) {
     int i, k;
-    char *j;
+    char w[NHXW + 1], *j;
 
+    hcclear();
     k = 0;
     while (!skip()) {
-        /* Check buffer space */
-        if ((j = nexth) >= (hbuf + NHEX - 2)) {
-        full:
-            prstr("Exception word list full.\n");
-            *nexth = 0;
-            return;
-        }
+        j = w;
 
         /* Process each word */
         while (1) {
@@ -379,9 +570,10 @@ void casehw(void) {
 
             /* End of word or line */
             if (((i & CMASK) == ' ') || (i == '\n')) {
-                *j++ = 0;
-                nexth = j;
                 *j = 0;
+                if ((j > w) && (hxadd(w) < 0)) {
+                    prstr("Exception word list full.\n");
+                }
                 if (i == ' ') {
                     break;
                 } else {
@@ -395,17 +587,142 @@ void casehw(void) {
                 continue;
             }
 
-            /* Add character to buffer */
-            *j++ = maplow(i) | k;
+            /* Add character to word, dropping what does not fit */
+            if (j < (w + NHXW)) {
+                *j++ = maplow(i) | k;
+            }
             k = 0;
+        }
+    }
+}
 
-            /* Check buffer overflow */
-            if (j >= (hbuf + NHEX - 2)) {
-                goto full;
-            }
+/**
+ * @brief Enter an exception word in the dictionary
+ * @param w Word in hbuf format: lower case, 0200 before each hyphen
+ * @return 0 on success, -1 if out of memory
+ */
+int hxadd(const char *w) {
+    struct hxnode *t;
+    char *p;
+    int n, k, len;
+
+    len = (int)strlen(w) + 1;
+    if (hxnodes + len > hxnmax) {
+        for (k = hxnmax ? hxnmax : 256; k < hxnodes + len; k *= 2)
+            ;
+        if ((t = OSA_REALLOC(hxtab, k * sizeof(*t))) == NULL)
+            return -1;
+        if (!hxnmax) {
+            memset(&t[0], 0, sizeof(*t));
+            hxnodes = 1;
+        }
+        hxtab = t;
+        hxnmax = k;
+    }
+    if (hxplen + len > hxpmax) {
+        for (k = hxpmax ? hxpmax : 1024; k < hxplen + len; k *= 2)
+            ;
+        if ((p = OSA_REALLOC(hxpool, k)) == NULL)
+            return -1;
+        hxpool = p;
+        hxpmax = k;
+    }
+
+    /* Walk the letters down from the root, adding missing nodes */
+    for (n = 0, p = (char *)w; *p; p++) {
+        for (k = hxtab[n].kid; k && hxtab[k].c != (*p & 0177); k = hxtab[k].sib)
+            ;
+        if (!k) {
+            k = hxnodes++;
+            hxtab[k].kid = 0;
+            hxtab[k].word = 0;
+            hxtab[k].c = *p & 0177;
+            hxtab[k].sib = hxtab[n].kid;
+            hxtab[n].kid = k;
+        }
+        n = k;
+    }
+    memcpy(&hxpool[hxplen], w, len);
+    hxtab[n].word = hxplen + 1;
+    hxplen += len;
+    return 0;
+}
+
+/**
+ * @brief The exception words entered so far, for a page checkpoint
+ * @param n Set to the bytes in the pool: the words, each with its NUL
+ * @return The pool, in the order the words were entered
+ */
+const char *hxwords(int *n) {
+    *n = hxplen;
+    return hxpool;
+}
+
+/**
+ * @brief Replace the exception words with those of a pool hxwords() gave
+ * @param w The pool
+ * @param n Bytes in it
+ * @return 0 on success, -1 if out of memory
+ */
+int hxreset(const char *w, int n) {
+    const char *e;
+
+    hcclear();
+    if (hxnmax) {
+        hxtab[0].kid = 0;
+        hxnodes = 1;
+    }
+    hxplen = 0;
+    for (e = w + n; w < e; w += strlen(w) + 1)
+        if (hxadd(w) < 0)
+            return -1;
+    return 0;
+}
+
+/**
+ * @brief Load hyphenation exception words from a file (-E)
+ * @param file Name of the file
+ * @return 0 on success, -1 if the file cannot be read
+ *
+ * @details
+ * The file holds words in .hw form separated by white space, with
+ * hyphens at the permitted breaks; '#' starts a comment that runs to
+ * the end of the line.
+ */
+int hxload(const char *file) {
+    FILE *fp;
+    char w[NHXW + 1];
+    int c, k, n, rc;
+
+    if ((fp = fopen(file, "r")) == NULL)
+        return -1;
+    hcclear();
+    rc = n = k = 0;
+    while (!rc && (c = getc(fp)) != EOF) {
+        if (c == '#') {
+            while ((c = getc(fp)) != EOF && c != '\n')
+                ;
+        }
+        if (c == EOF || isspace(c)) {
+            w[n] = 0;
+            if (n && hxadd(w) < 0)
+                rc = -1;
+            n = k = 0;
+        } else if (c == '-') {
+            k = 0200;
+        } else if (isalpha(c)) {
+            if (n < NHXW)
+                w[n++] = (char)(maplow(c) | k);
+            k = 0;
         }
     }
+    w[n] = 0;
+    if (!rc && n && hxadd(w) < 0)
+        rc = -1;
+    fclose(fp);
+    return rc;
 }
+
 /* ================================================================
  * WORD ANALYSIS FUNCTIONS
  * ================================================================ */
@@ -415,53 +732,141 @@ void casehw(void) {
  * @return 1 if word found in exception list, 0 otherwise
  * 
  * @details
- * Searches the exception word buffer for the current word.
+ * Looks up the letters from wdstart to hyend in the exception trie.
  * If found, extracts the hyphenation points marked with the
  * high bit (0200) and adds them to the hyphenation array.
- * Also handles special case for words ending in 's'.
+ * Also handles special case for words ending in 's': when the
+ * whole word is not listed, its form without the 's' is tried.
  */
 int exword(void) {
-    int *w, i;
+    int *w, n, k, s;
     char *e;
-    char *save;
 
-    e = hbuf;
-    while (1) {
-        save = e;
-        if (*e == 0) {
-            return 0;
+    if (!hxnodes) {
+        return 0;
+    }
+
+    s = 0;
+    for (n = 0, w = wdstart; w <= hyend; w++) {
+        if ((w == wdend) && (maplow(*w & CMASK) == 's')) {
+            s = hxtab[n].word;
         }
+        for (k = hxtab[n].kid; k && (hxtab[k].c != maplow(*w & CMASK));
+             k = hxtab[k].sib) {
+            /* Find the child for this letter */
+        }
+        if (!(n = k)) {
+            break;
+        }
+    }
+    if (n && hxtab[n].word) {
+        s = hxtab[n].word;
+    }
+    if (!s) {
+        return 0;
+    }
+
+    w = wdstart;
+    for (e = &hxpool[s - 1]; *e; e++) {
+        if (*e & 0200) {
+            *hyp++ = w;
+        }
+        if (hyp > (hyptr + NHYP - 1)) {
+            hyp = hyptr + NHYP - 1;
+        }
+        w++;
+    }
+    return 1;
+}
+
+/**
+ * @brief Hyphenate the current word with Liang's patterns
+ *
+ * @details
+ * Hands the lower-cased letters from wdstart to wdend to the pattern
+ * engine in src/core/hyphpat.c and records the breaks it finds.
+ */
+void patword(void) {
+    char w[OTROFF_MAX_WORD_LENGTH];
+    unsigned char brk[OTROFF_MAX_WORD_LENGTH];
+    int k, n;
 
-        w = wdstart;
-        while ((*e && (w <= hyend)) &&
-               ((*e & 0177) == maplow(*w & CMASK))) {
-            e++;
-            w++;
+    n = wdend - wdstart + 1;
+    if ((n < 1) || (n > OTROFF_MAX_WORD_LENGTH)) {
+        return;
+    }
+    for (k = 0; k < n; k++) {
+        w[k] = (char)maplow(wdstart[k]);
+    }
+    if (otroff_hyphen_pattern(w, (size_t)n, brk) <= 0) {
+        return;
+    }
+    for (k = 0; k < n && hyp < (hyptr + NHYP - 1); k++) {
+        if (brk[k]) {
+            *hyp++ = wdstart + k;
         }
+    }
+}
+
+/**
+ * @brief Build the reversed suffix trie from suftab.c
+ * @return 0 on success, -1 if out of memory
+ *
+ * @details
+ * The table holds, for each final letter, the letters before it with
+ * 0200 set on each letter a hyphen may precede.  Where two entries spell
+ * the same suffix the earlier one is kept, since suffix() always took
+ * the first entry in table order that matched.
+ */
+int sufbuild(void) {
+    const unsigned char *e, *s;
+    int i, k, n;
 
-        if (!*e) {
-            if (((w - 1) == hyend) ||
-                ((w == wdend) && ((i = maplow(*w & CMASK)) == 's'))) {
-                w = wdstart;
-                for (e = save; *e; e++) {
-                    if (*e & 0200) {
-                        *hyp++ = w;
-                    }
-                    if (hyp > (hyptr + NHYP - 1)) {
-                        hyp = hyptr + NHYP - 1;
-                    }
-                    w++;
+    if ((sftab = OSA_CALLOC(27 + suftab_get_size(), sizeof(*sftab))) == NULL) {
+        return -1;
+    }
+    sfnodes = 27;
+    for (i = 0; i < 26; i++) {
+        sftab[i + 1].c = 'a' + i;
+        if ((e = suftab_entries(i)) == NULL) {
+            continue;
+        }
+        for (; *e & 017; e += *e & 017) {
+            for (n = i + 1, s = e + (*e & 017) - 1; s > e; s--) {
+                for (k = sftab[n].kid; k && sftab[k].c != (*s & 0177); k = sftab[k].sib)
+                    ;
+                if (!k) {
+                    k = sfnodes++;
+                    sftab[k].c = *s & 0177;
+                    sftab[k].sib = sftab[n].kid;
+                    sftab[n].kid = k;
                 }
-                return 1;
-            } else {
-                e++;
-                continue;
+                n = k;
+            }
+            if (!sftab[n].ent) {
+                sftab[n].ent = e;
             }
-        }
-        while (*e++) {
-            /* Skip to next word */
         }
     }
+    return 0;
+}
+
+/**
+ * @brief Record a suffix hyphen before w
+ * @param e Suffix table entry being applied
+ * @param w Letter the hyphen would precede
+ * @return 0 if the stem before w has no vowel, 1 otherwise
+ */
+static int sufmark(const unsigned char *e, int *w) {
+    hyend = w - 1;
+    if (*e & 0100) {
+        return 1;
+    }
+    if (!chkvow(w)) {
+        return 0;
+    }
+    *hyp++ = w;
+    return 1;
 }
 
 /**
@@ -471,62 +876,62 @@ int exword(void) {
  * @details
  * Uses suffix tables to find hyphenation points based on
  * common word endings. This method is particularly effective
- * for derived words with standard suffixes.
+ * for derived words with standard suffixes.  The word is walked
+ * backwards from hyend through the reversed suffix trie, and of the
+ * suffixes met on the way the one earliest in suftab.c is applied.
+ * Its hyphens are recorded and, unless the entry ends the analysis,
+ * the stem left in front of it is analysed again.
  */
 int suffix(void) {
+    const unsigned char *s, *s0;
     int *w;
-    char *s, *s0;
-    int i;
-    char *off;
+    int i, k;
+
+    if (!sfnodes && sufbuild() < 0) {
+        sfnodes = -1;
+    }
+    if (sfnodes < 0) {
+        return 0;
+    }
 
 again:
-    if (!alph(i = *hyend & CMASK)) {
+    if (hyend < wdstart || !alph(i = *hyend & CMASK)) {
         return 0;
     }
 
     if (i < 'a') {
         i += 'a' - 'A';
-    } else {
-        i += 'a' - 'a';
-    }
-
-    if (!(off = sufind[i])) {
-        return 0;
     }
 
-    while (1) {
-        if ((i = *(s0 = getsuf(off)) & 017) == 0) {
-            return 0;
+    s0 = NULL;
+    for (k = i - 'a' + 1, w = hyend - 1;; w--) {
+        if (sftab[k].ent && (!s0 || sftab[k].ent < s0)) {
+            s0 = sftab[k].ent;
         }
-
-        off += i;
-        s = s0 + i - 1;
-        w = hyend - 1;
-
-        while (((s > s0) && (w >= wdstart)) &&
-               ((*s & 0177) == maplow(*w))) {
-            s--;
-            w--;
+        if (w < wdstart) {
+            break;
         }
-
-        if (s == s0) {
+        i = maplow(*w);
+        for (k = sftab[k].kid; k && sftab[k].c != i; k = sftab[k].sib)
+            ;
+        if (!k) {
             break;
         }
     }
+    if (!s0) {
+        return 0;
+    }
 
-    s = s0 + i - 1;
+    s = s0 + (*s0 & 017) - 1;
     w = hyend;
 
-    if (*s0 & 0200) {
-        while (s >= s0) {
-            hyend = w - 1;
-            if (*s0 & 0100) {
-                continue;
-            }
-            if (!chkvow(w)) {
-                return 0;
-            }
-            *hyp++ = w;
+    if ((*s0 & 0200) && !sufmark(s0, w)) {
+        return 0;
+    }
+    while (s > s0) {
+        w--;
+        if ((*s-- & 0200) && !sufmark(s0, w)) {
+            return 0;
         }
     }
 
@@ -560,43 +965,6 @@ int chkvow(int *w) {
     return 0;
 }
 
-/**
- * @brief Get suffix from suffix table
- * @param x Pointer to suffix table entry
- * @return Pointer to extracted suffix string
- * 
- * @details
- * Extracts a suffix string from the suffix table using the
- * length encoding in the first byte. The suffix is copied
- * to a static buffer and null-terminated.
- */
-char *getsuf(char *x) {
-    char *s;
-    int cnt;
-    static char suff[20];
-
-    s = suff;
-    for (cnt = ((*s++ = rdsufb(x++)) & 017); cnt > 1; cnt--) {
-        *s++ = rdsufb(x++);
-    }
-    suff[suff[0] & 017] = 0;
-    return suff;
-}
-
-/**
- * @brief Read byte from suffix table
- * @param i Pointer representing index in suffix table
- * @return Byte value from suffix table
- * 
- * @details
- * Performs a direct lookup from the in-memory suffix table
- * using the given index. This function provides access to
- * the compressed suffix data.
- */
-unsigned char rdsufb(char *i) {
-    return suftab_get_byte((size_t)(i));
-}
-
 /**
  * @brief Perform digram-based hyphenation analysis
  * 
@@ -604,84 +972,29 @@ unsigned char rdsufb(char *i) {
  * Uses digram (two-character) patterns to find hyphenation points.
  * This algorithmic approach analyzes character pairs and their
  * frequency patterns to determine likely hyphenation positions.
- * It processes the word from vowel to vowel, calculating digram
- * values and marking points that exceed the threshold.
+ * The scoring and the vowel-to-vowel walk back from hyend are done by
+ * otroff_digram_breaks() in src/core, which roff uses as well.
  */
 void digram(void) {
-    int *w, *nhyend, *maxw;
-    int maxval;
+    char w[OTROFF_MAX_WORD_LENGTH];
+    unsigned char brk[OTROFF_MAX_WORD_LENGTH];
+    int k, n;
 
-    while ((w = find_next_vowel(hyend + 1))) {
-        hyend = w;
-        if (!(w = find_next_vowel(hyend))) {
-            return;
-        }
-        nhyend = w;
-        maxval = 0;
-        maxw = find_max_digram(w, nhyend, &maxval);
-        hyend = nhyend;
-        if (maxval > thresh) {
-            *hyp++ = maxw;
-        }
+    n = wdend - wdstart + 1;
+    if ((n < 1) || (n > OTROFF_MAX_WORD_LENGTH)) {
+        return;
     }
-}
-
-/**
- * @brief Calculate digram value for hyphenation analysis
- * @param w Pointer to position in word
- * @param bxh Beginning-consonant-vowel table
- * @param bxxh Beginning-consonant-consonant-vowel table  
- * @param xxh Consonant-consonant-vowel table
- * @param xhx Consonant-vowel-consonant table
- * @param hxx Vowel-consonant-consonant table
- * @return Calculated digram value
- * 
- * @details
- * Calculates the "goodness" value for a potential hyphenation point
- * by looking up digram patterns in various lookup tables. Higher
- * values indicate better hyphenation points.
- */
-int calculate_digram_value(int *w, char bxh[26][13], char bxxh[26][13],
-                           char xxh[26][13], char xhx[26][13], char hxx[26][13]) {
-    int val = 1;
-
-    if (w == wdstart) {
-        val = dilook('a', *w, bxh); // Assuming bxh, etc. are correctly typed for dilook
-    } else if (w == wdstart + 1) {
-        val = dilook(*(w - 1), *w, bxxh); // Assuming bxxh, etc. are correctly typed for dilook
-    } else {
-        val = dilook(*(w - 1), *w, xxh); // Assuming xxh, etc. are correctly typed for dilook
+    for (k = 0; k < n; k++) {
+        w[k] = (char)maplow(wdstart[k]);
     }
-
-    // These lines look like they are overwriting `val` not accumulating.
-    // This might be a bug in the original logic or my understanding of dilook.
-    // For refactoring casts, I'll keep the logic as is.
-    val = dilook(*w, *(w + 1), xhx); // Assuming xhx, etc. are correctly typed for dilook
-    val = dilook(*(w + 1), *(w + 2), hxx); // Assuming hxx, etc. are correctly typed for dilook
-
-    return val;
-}
-
-/**
- * @brief Look up digram value in table
- * @param a First character of digram
- * @param b Second character of digram  
- * @param t Digram lookup table
- * @return Digram value for the character pair
- * 
- * @details
- * Performs a lookup in the digram table for the given character pair.
- * The table is compressed with two 4-bit values per byte, so the
- * function extracts the appropriate nibble based on the second character.
- */
-int dilook(int a, int b, char t[26][13]) {
-    int i, j;
-
-    i = t[maplow(a) - 'a'][(j = maplow(b) - 'a') / 2];
-    if (!(j & 01)) {
-        i = i >> 4;
+    if (otroff_digram_breaks(w, (size_t)n, (size_t)(hyend - wdstart + 1), thresh, brk) <= 0) {
+        return;
+    }
+    for (k = n - 1; k >= 0 && hyp < (hyptr + NHYP - 1); k--) {
+        if (brk[k]) {
+            *hyp++ = wdstart + k;
+        }
     }
-    return (i & 017);
 }
 
 /* ================================================================
@@ -695,8 +1008,7 @@ int dilook(int a, int b, char t[26][13]) {
  * 
  * @details
  * Searches forward from the starting position to find the next
- * vowel character. Used by digram analysis to segment words
- * into vowel-to-vowel sections for processing.
+ * vowel character.
  */
 int *find_next_vowel(int *start) {
     int *pos;
@@ -714,53 +1026,6 @@ int *find_next_vowel(int *start) {
     return NULL;
 }
 
-/**
- * @brief Find position with maximum digram value in range
- * @param start Starting position of range
- * @param end Ending position of range
- * @param maxval Pointer to store maximum value found
- * @return Pointer to position with maximum digram value
- * 
- * @details
- * Scans a range of positions in the current word and calculates
- * digram values for each position. Returns the position with the
- * highest value, which represents the best hyphenation point
- * in that range.
- */
-int *find_max_digram(int *start, int *end, int *maxval) {
-    int *pos, *maxpos;
-    int val;
-
-    /* Initialize with invalid values */
-    maxpos = NULL;
-    *maxval = 0;
-
-    if (start == NULL || end == NULL || start >= end) {
-        return NULL;
-    }
-
-    /* Scan range for maximum digram value */
-    for (pos = start; pos < end; pos++) {
-        /* Calculate digram value at this position */
-        val = 1; /* Default base value */
-
-        /* Add context-based adjustments */
-        if (pos > wdstart && pos < wdend) {
-            /* Use simplified digram calculation */
-            val += dilook(*(pos - 1), *pos, NULL);
-            val += dilook(*pos, *(pos + 1), NULL);
-        }
-
-        /* Update maximum if this value is higher */
-        if (val > *maxval) {
-            *maxval = val;
-            maxpos = pos;
-        }
-    }
-
-    return maxpos;
-}
-
 /* ================================================================
  * END OF FILE - n8.c
  * ================================================================ */
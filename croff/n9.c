@@ -41,6 +41,11 @@
 #include "tdef.h" /* Primary troff definitions, includes t.hpp indirectly or directly */
 /* #include "t.h"  -- Usually included via tdef.h */
 
+#include "t.h" /* v.hp, where a tab is */
+#include "tabstop.h" /* tsnext() */
+
+#include <string.h>
+
 /* External variable declarations from other parts of the troff system */
 
 /** @var cbuf
@@ -94,12 +99,6 @@ extern int fc;
  *  point where padding should be inserted. Defaults to space.
  */
 extern int padc;
-/** @var tabtab
- *  @brief Array storing tab stop positions and types.
- *  Each entry contains a position (masked with `TMASK`) and a type
- *  (e.g., left, right, center).
- */
-extern int tabtab[];
 /** @var nlflg
  *  @brief Newline flag.
  *  Indicates if a newline character has been processed or is pending.
@@ -156,22 +155,8 @@ void setov(void);
 void setbra(void);
 void setvline(void);
 void casefc(void);
-/**
- * @brief Process a field, handling tabs, leaders, and padding.
- *
- * This function is central to processing text fields, which can be delimited
- * by tab characters, leader characters, or explicit field delimiters set by `\f`.
- * It calculates the width of the field content, determines necessary padding
- * or leader characters, and sets global variables `nchar` and `rchar` to
- * control the output of fill characters by the main processing loop.
- *
- * @param field_type_char The character that triggered field processing (e.g., tab, leader).
- *                        This helps determine the type of field.
- * @return An integer status or value, often related to width or success.
- *         The exact return value's meaning depends on the calling context in troff.
- *         Typically, it might be 0 or a width.
- */
-int setfield(int field_type_char);
+void getmap(void);
+int setfield(int x);
 
 /* Prototypes for functions called from this file (assumed to be external) */
 /* These should ideally be in a common header like tdef.h or t.h */
@@ -387,6 +372,43 @@ int eat(int delim_char) {
     return i; /* Return the terminating character (masked) */
 }
 
+/*
+ * Overstrikes built before, for setov(): the characters as they came,
+ * with their font and size bits, and the sequence they made in cbuf.
+ * Math uses the same few a thousand times over.  The widths come from
+ * the tables, so widflush() makes every entry stale through widgen;
+ * characters whose width depends on more than the tables are never
+ * kept.
+ */
+#define NOVC 64 /* cached overstrikes, a power of two */
+
+extern int widgen;
+extern int widthp;
+extern int ohc;
+extern int eschar;
+
+static struct ovent {
+    int gen; /* widgen plus one when built, 0 if the entry is empty */
+    int k; /* characters */
+    int o[NOV];
+    int seq[2 * NOV + 2]; /* what went into cbuf, terminated */
+    int widthp; /* as the last width() left it */
+} ovcache[NOVC];
+
+/* The entry the k characters at o have, or NULL if they have none */
+static struct ovent *ovslot(const int *o, int k) {
+    unsigned h = 0;
+    int i, c;
+
+    for (i = 0; i < k; i++) {
+        c = o[i] & CMASK;
+        if (!(o[i] & MOT) && ((c == 010) || (c == ohc) || (c == PRESC) || (c == eschar)))
+            return (NULL); /* widthp, .hc or .ec decide its width */
+        h = (h ^ (unsigned)o[i]) * 16777619u;
+    }
+    return (&ovcache[(h ^ (h >> 11)) & (NOVC - 1)]);
+}
+
 /**
  * @brief Process the `\o'...'` (overstrike) command.
  *
@@ -404,6 +426,7 @@ void setov(void) {
     int w[NOV]; /* Array to store widths of these characters */
     int temp_w, temp_o; /* For swapping during sort */
     int next_w; /* Width of the next character for motion calculation */
+    struct ovent *ov; /* Where this overstrike is cached */
 
     delim_char = getch();
     if (delim_char & MOT) { /* If delimiter is a motion command, abort */
@@ -419,8 +442,7 @@ void setov(void) {
             ch = i; /* Store terminating char for eat() or other context */
             break; /* Stop if delimiter or newline */
         }
-        o[k] = i; /* Store character (with attributes) */
-        w[k] = width(i); /* Store its width */
+        o[k] = i; /* Store character (with attributes); measured below */
     }
     /* k now holds the number of characters read */
 
@@ -443,6 +465,22 @@ void setov(void) {
         return;
     }
 
+    /* The same characters overstruck again go in as they went before */
+    if ((ov = ovslot(o, k)) != NULL) {
+        if ((ov->gen == widgen + 1) && (ov->k == k) && !memcmp(ov->o, o, k * sizeof(int))) {
+            memcpy(cbuf, ov->seq, (2 * k + 2) * sizeof(int));
+            widthp = ov->widthp;
+            eat(delim_char);
+            cp = cbuf;
+            return;
+        }
+        ov->gen = 0;
+        ov->k = k;
+        memcpy(ov->o, o, k * sizeof(int));
+    }
+    for (i = 0; i < k; i++)
+        w[i] = width(o[i]);
+
     /* Sort characters by width in descending order (simple bubble sort) */
     /* This ensures the widest character (w[0]) dictates the overall width for centering. */
     for (j = 1; j != 0;) { /* Loop as long as swaps are made in a pass */
@@ -499,6 +537,12 @@ void setov(void) {
         *(cbuf + NC - 1) = 0; /* Force null if overflow */
     }
 
+    if ((ov != NULL) && (p_cbuf == cbuf + 2 * k + 1)) {
+        memcpy(ov->seq, cbuf, (2 * k + 2) * sizeof(int));
+        ov->widthp = widthp;
+        ov->gen = widgen + 1;
+    }
+
     eat(delim_char); /* Consume the delimiter if it wasn't consumed in the loop */
     cp = cbuf; /* Set global character pointer */
 }
@@ -805,6 +849,7 @@ void casefc(void) {
     /* Check if the first character is a newline, motion, or EOF */
     if (((char1 & CMASK) == '\n') || (char1 & MOT) || (char1 == EOF)) {
         fc = IMP; /* Default field character */
+        getmap();
         /* If the first char is invalid or ends input, padc also takes its default */
         padc = ' ';
         if ((char1 & CMASK) == '\n') {
@@ -816,6 +861,7 @@ void casefc(void) {
         return;
     }
     fc = char1 & CMASK; /* Set new field character (actual character code) */
+    getmap();
 
     /* Get the second character for the padding character */
     char2 = getch();
@@ -832,123 +878,123 @@ void casefc(void) {
 }
 
 /**
- * @brief Process a field, handling tabs, leaders, and padding.
+ * @brief Process a field, a tab or a leader at the input position v.hp.
  *
- * This function is central to processing text fields, which can be delimited
- * by tab characters, leader characters, or explicit field delimiters set by `\f`.
- * It calculates the width of the field content, determines necessary padding
- * or leader characters, and sets global variables `nchar` and `rchar` to
- * control the output of fill characters by the main processing loop.
+ * The stop it runs to is the first past v.hp, from tsnext().  A plain
+ * tab or leader is made of nchar repeats of rchar (tabc or dotc) and a
+ * motion for what is left over; a right or centred tab first reads
+ * its text up to the next tab, leader or newline, to put that against
+ * the stop.  A field delimited by fc is its text, with the room left
+ * over shared between its padc places, put in cbuf for getch() to read
+ * back.
  *
- * @param field_type_char The character that triggered field processing (e.g., tab, leader).
- *                        This helps determine the type of field.
- * @return An integer status or value, often related to width or success.
- *         The exact return value's meaning depends on the calling context in troff.
- *         Typically, it might be 0 or a width.
+ * @param x The character that began it: fc, tabch or ldrch.
+ * @return The character getch() is to return, or 0 for it to read on.
  */
-int setfield(int field_type_char) {
-    int *cb_ptr; /* Pointer into cbuf */
-    int width_val; /* Calculated width of the field content */
-    int c; /* Character read from input */
-    int char_width; /* Width of the character used for the field */
-    int count; /* Number of times to repeat the leader/tab character */
-    int delim_char; /* Delimiter character for the field command */
-    int temp_offset; /* Temporary offset for centering fields */
-    int remainder_len; /* Remaining length after fitting whole characters */
-    int field_type; /* Type of field: tab, leader, or explicit delimiter */
-
-    delim_char = getch();
-    if (delim_char & MOT) { /* If delimiter is a motion command, abort */
-        return 0;
-    }
-    delim_char &= CMASK; /* Mask to get actual character */
-
-    cb_ptr = cbuf; /* Initialize pointer to the character buffer */
-
-    /* Determine field type and set initial character */
-    if (delim_char == fc) {
-        /* Explicit field delimiter */
-        ch = delim_char; /* Store delimiter for potential use by eat() */
-        field_type = 0; /* Field type 0: explicit delimiter */
-    } else if (delim_char == tabch) {
-        /* Tab character */
-        field_type = 1; /* Field type 1: tab */
-    } else if (delim_char == ldrch) {
-        /* Leader character */
-        field_type = 2; /* Field type 2: leader */
-    } else {
-        /* Invalid or unexpected character for field processing */
-        eat(delim_char); /* Consume the character up to the delimiter */
-        return 0;
-    }
-
-    /* Calculate the width of the field content based on the field type */
-    switch (field_type) {
-    case 0: /* Explicit delimiter */
-        width_val = 0; /* Width is determined by the content between delimiters */
-        break;
-    case 1: /* Tab character */
-        width_val = tabtab[(tabtab[0] & TMASK) >> 1] & TMASK; /* Get tab stop position */
-        break;
-    case 2: /* Leader character */
-        width_val = 1; /* Default width for leader is 1 (can be adjusted) */
-        break;
-    default:
-        width_val = 0;
-        break;
-    }
-
-    /* Main loop: read characters and assemble the field content */
-    while (cb_ptr < cbuf + NC - 1) { /* Ensure space for at least one character and terminator */
-        c = getch();
-        if (c == delim_char || c == '\n') {
-            /* End of field: either the delimiter or a newline */
-            ch = c; /* Store the terminating character (delimiter or newline) */
-            break;
+int setfield(int x) {
+    register int i, j, *fp;
+    int length, ws, npad, temp, type, rc;
+    int **pp, *padptr[NPP];
+    static int fbuf[FBUFSZ];
+    int savfc, savtc, savlc;
+
+    if (x == tabch)
+        rchar = tabc | chbits;
+    else if (x == ldrch)
+        rchar = dotc | chbits;
+    temp = npad = ws = rc = 0;
+    savfc = fc;
+    savtc = tabch;
+    savlc = ldrch;
+    tabch = ldrch = fc = IMP;
+    if ((j = tsnext(v.hp, &type)) == 0) {
+        if (x == savfc)
+            prstr("Zero field width.\n");
+        goto rtn;
+    }
+    length = j - v.hp;
+    fp = fbuf;
+    pp = padptr;
+    if (x == savfc) {
+        for (;;) {
+            if ((j = (i = getch()) & CMASK) == padc) {
+                npad++;
+                *pp++ = fp;
+                if (pp > (padptr + NPP - 1))
+                    break;
+            } else if (j == savfc) {
+                break;
+            } else if (j == '\n') {
+                temp = j;
+                nlflg = 0;
+                break;
+            } else {
+                ws += width(i);
+            }
+            *fp++ = i;
+            if (fp > (fbuf + FBUFSZ - 3))
+                break;
         }
-        if (c == fc) {
-            /* Nested field delimiter: treat as a normal character */
-            *cb_ptr++ = c;
-            continue;
+        if (!npad) {
+            npad++;
+            *pp++ = fp;
+            *fp++ = 0;
         }
-        if (c == tabch || c == ldrch) {
-            /* Tab or leader character: handle according to field type */
-            if (field_type == 1) {
-                /* Tab character: set as the repeating character for the field */
-                rchar = c | chbits;
-                nchar = width_val / width(c);
-                if (nchar <= 0) {
-                    nchar = 1; /* Ensure at least one repetition */
-                }
-                *cb_ptr++ = RPT; /* Repeat command */
-                *cb_ptr++ = nchar; /* Number of repetitions */
-                *cb_ptr++ = rchar; /* Character to repeat */
-            } else if (field_type == 2) {
-                /* Leader character: set as the repeating character for the field */
-                rchar = c | chbits;
-                nchar = width_val / width(c);
-                if (nchar <= 0) {
-                    nchar = 1; /* Ensure at least one repetition */
-                }
-                *cb_ptr++ = RPT; /* Repeat command */
-                *cb_ptr++ = nchar; /* Number of repetitions */
-                *cb_ptr++ = rchar; /* Character to repeat */
+        *fp++ = temp;
+        *fp++ = 0;
+        temp = i = (j = length - ws) / npad;
+        i = (i / HOR) * HOR;
+        if ((j -= i * npad) < 0)
+            j = -j;
+        i = makem(i);
+        if (temp < 0)
+            i |= NMOT;
+        while (npad--) {
+            *(*--pp) = i;
+            if (j) {
+                j -= HOR;
+                (*(*pp)) += HOR;
             }
-            continue;
         }
-        /* Regular character: add to the field content */
-        *cb_ptr++ = c;
-    }
-
-    /* Null terminate the field content in cbuf */
-    if (cb_ptr < cbuf + NC) {
-        *cb_ptr = 0;
+        cp = fbuf;
+    } else if (type == 0) {
+        /* plain tab or leader */
+        if ((j = width(rchar)) == 0) {
+            nchar = 0;
+        } else {
+            nchar = length / j;
+            length %= j;
+        }
+        if (length)
+            rc = length | MOT;
     } else {
-        *(cbuf + NC - 1) = 0; /* Force null termination at the last position */
-    }
-
-    eat(delim_char); /* Consume the rest of the input up to the delimiter */
-    cp = cbuf; /* Set global character pointer to the start of cbuf */
-
-    return width_val; /* Return the calculated width of the field */
+        /* centred or right tab */
+        while (((j = (i = getch()) & CMASK) != savtc) && (j != '\n') && (j != savlc)) {
+            ws += width(i);
+            *fp++ = i;
+            if (fp > (fbuf + FBUFSZ - 3))
+                break;
+        }
+        *fp++ = i;
+        *fp++ = 0;
+        if (type == RTAB)
+            length -= ws;
+        else
+            length -= ws / 2; /* CTAB */
+        if (((j = width(rchar)) == 0) || (length <= 0)) {
+            nchar = 0;
+        } else {
+            nchar = length / j;
+            length %= j;
+        }
+        length = (length / HOR) * HOR;
+        rc = makem(length);
+        nlflg = 0;
+        cp = fbuf;
+    }
+rtn:
+    fc = savfc;
+    tabch = savtc;
+    ldrch = savlc;
+    return (rc);
 }
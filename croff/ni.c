@@ -23,9 +23,11 @@ char *obufp = obuf; /* Output buffer pointer */
 
 /*
  * Built-in number registers
- * These registers store system state and user-accessible values
+ * These registers store system state and user-accessible values.
+ * n4.c moves the register arrays to the heap and doubles them once
+ * the NN slots here run out.
  */
-int r[NN] = {
+static int ri[NN] = {
     '%', /* Page number register */
     'nl', /* Current vertical position */
     'yr', /* Year (last 2 digits) */
@@ -41,6 +43,8 @@ int r[NN] = {
     'sb', /* Depth of input stack */
     'c.' /* Current input character */
 };
+int *r = ri;
+int nnr = NN;
 
 /*
  * Page range control
@@ -142,6 +146,9 @@ extern int casels(void), casecc(void), casec2(void), caseem(void);
 extern int caseaf(void), casehw(void), casemc(void), casepm(void);
 extern int casecu(void), casepi(void), caserr(void), caseuf(void);
 extern int caseie(void), caseel(void), casepc(void), caseht(void);
+extern int caseop(void);
+extern int casefs(void);
+extern int casefn(void);
 
 /*
  * Command table structure
@@ -154,9 +161,11 @@ struct contab {
 
 /*
  * Main command dispatch table
- * Contains all nroff/troff commands and their corresponding functions
+ * Contains all nroff/troff commands and their corresponding functions.
+ * Macros take the free slots; n3.c moves the table to the heap and
+ * doubles it when those run out, so contab and ncontab may change.
  */
-struct contab contab[NM] = {
+static struct contab contabi[NM] = {
     {'ds', caseds}, /* Define string */
     {'as', caseas}, /* Append to string */
     {'sp', casesp}, /* Space vertically */
@@ -243,7 +252,12 @@ struct contab contab[NM] = {
     {'uf', caseuf}, /* Underline font */
     {'pc', casepc}, /* Page character */
     {'ht', caseht}, /* Horizontal tab */
+    {'op', caseop}, /* Optimal paragraph breaking */
+    {'fs', casefs}, /* Forward string */
+    {'fn', casefn}, /* Forward number register */
 };
+struct contab *contab = contabi;
+int ncontab = NM;
 
 /*
  * Troff environment block
@@ -251,7 +265,6 @@ struct contab contab[NM] = {
  */
 
 /* Environment control */
-int block = 0; /* Environment block number */
 int ics = ICS; /* Input character size */
 int ic = 0; /* Input character */
 int icf = 0; /* Input character flag */
@@ -297,6 +310,7 @@ int tdelim = IMP; /* Title delimiter */
 /* Hyphenation control */
 int hyf = 1; /* Hyphenation flag */
 int hyoff = 0; /* Hyphenation offset */
+int parop = 0; /* .op: break filled text a paragraph at a time */
 
 /* Miscellaneous formatting state */
 int un1 = -1; /* Underline count */
@@ -344,20 +358,39 @@ int lnsize = LNSIZE; /* Line size */
 /* Hyphenation exception table */
 int *hyptr[NHYP] = {0}; /* Hyphenation pointers */
 
-/* Tab stop table */
-int tabtab[NTAB] = {
-    DTAB, DTAB * 2, DTAB * 3, DTAB * 4, /* Tab stops 1-4 */
-    DTAB * 5, DTAB * 6, DTAB * 7, DTAB * 8, /* Tab stops 5-8 */
-    DTAB * 9, DTAB * 10, DTAB * 11, DTAB * 12, /* Tab stops 9-12 */
-    DTAB * 13, DTAB * 14, DTAB * 15, 0 /* Tab stops 13-16 */
-};
-
 /* Working buffers */
 int line[LNSIZE] = {0}; /* Current line buffer */
+int linew[LNSIZE] = {0}; /* linew[k]: width storeline() gave line[k] */
 int word[WDSIZE] = {0}; /* Current word buffer */
+int wdpre[WDSIZE] = {0}; /* wdpre[k]: width of word[0] through word[k - 1] */
 
-/* Environment block padding */
-int blockxxx[EVS - 64 - NHYP - NTAB - WDSIZE - LNSIZE] = {0};
+/*
+ * Environment variable table
+ * The variables from ics through word[] make up one environment;
+ * caseev() in n5.c saves and restores them through this table, so
+ * they need not be laid out contiguously.
+ */
+struct evvar {
+    void *p; /* Variable address */
+    int n; /* Size in bytes */
+    int ptr; /* Holds pointers into line[] or word[] */
+};
+#define EV(x) {&(x), (int)sizeof(x), 0}
+#define EVP(x) {&(x), (int)sizeof(x), 1}
+struct evvar evvars[] = {
+    EV(ics), EV(ic), EV(icf), EV(chbits), EV(nmbits), EV(apts), EV(apts1),
+    EV(pts), EV(pts1), EV(font), EV(font1), EV(sps), EV(spacesz), EV(lss),
+    EV(lss1), EV(ls), EV(ls1), EV(ll), EV(ll1), EV(lt), EV(lt1), EV(ad),
+    EV(nms), EV(ndf), EV(fi), EV(cc), EV(c2), EV(ohc), EV(tdelim), EV(hyf),
+    EV(hyoff), EV(parop), EV(un1), EV(tabc), EV(dotc), EV(adsp), EV(adrem), EV(lastl),
+    EV(nel), EV(admod), EVP(wordp), EV(spflg), EVP(linep), EVP(wdend),
+    EVP(wdstart), EV(wne), EV(ne), EV(nc), EV(nb), EV(lnmod), EV(nwd),
+    EV(nn), EV(ni), EV(ul), EV(cu), EV(ce), EV(in), EV(in1), EV(un),
+    EV(wch), EV(pendt), EVP(pendw), EV(pendnf), EV(spread), EV(it),
+    EV(itmac), EV(lnsize), EVP(hyptr), EV(line), EV(word),
+    EV(wdpre), EV(linew),
+};
+int nevvars = (int)(sizeof(evvars) / sizeof(evvars[0]));
 
 /* Output line buffer */
 int oline[LNSIZE + 1]; /* Output line buffer */
@@ -37,7 +37,6 @@ int mflg;
 int ch;
 int cps;
 int suffid;
-int sufind[26];
 int ibf;
 int ttyod;
 int ttys[3];
@@ -52,6 +51,7 @@ int copyf;
 int ch0;
 int cwidth;
 int ip;
+int *sp; /* words of a short string being read, see setstr() */
 int nlflg;
 int *nxf;
 int *ap;
@@ -65,14 +65,18 @@ int nfo;
 int ifile;
 int padc;
 int raw;
-int ifl[NSO];
-int offl[NSO];
-int ipl[NSO];
+static int ifli[NSO];
+static int offli[NSO];
+static int ipli[NSO];
+int *ifl = ifli;
+int *offl = offli;
+int *ipl = ipli;
+int nso = NSO;
 int ifi;
 int flss;
 int nonumb;
 int trap;
-int *litlev;
+int litlev;
 int tflg;
 int ejf;
 int *ejl;
@@ -90,7 +94,6 @@ int lead;
 int ralss;
 int paper;
 int nextb;
-int *argtop;
 int nrbits;
 int nform;
 int oldmn;
@@ -99,16 +102,19 @@ int macerr;
 int apptr;
 int aplnk;
 int diflg;
-int roff;
-int wbfi;
-int inc[NN];
-int fmt[NN];
+static int inci[NN];
+static int fmti[NN];
+int *inc = inci;
+int *fmt = fmti;
 int evi;
 int vflag;
 int noscale;
 int po1;
-int nlist[NTRAP];
-int mlist[NTRAP];
+static int nlisti[NTRAP];
+static int mlisti[NTRAP];
+int *nlist = nlisti;
+int *mlist = mlisti;
+int ntrap = NTRAP;
 int evlist[EVLSZ];
 int ev;
 int tty;
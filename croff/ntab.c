@@ -132,3 +132,138 @@ int chtab[] = {
     'lc', 0361, /*left ceiling (lt of ")*/
     'rc', 0362, /*right ceiling (rt of ")*/
     0, 0};
+
+/*
+ * UTF-8 input: the character each code point is read as, by its name in
+ * chtab above, or a plain character that stands for it.  getch0() looks
+ * the names up through the same hash as setch().  A plain stand-in is
+ * never one the input syntax gives a meaning, so the curly quotes are
+ * the accents: a ' or " would start control lines and end arguments.
+ */
+int utftab[] = {
+    0x2010, 'hy', /*hyphen*/
+    0x2022, 'bu', /*bullet*/
+    0x25A1, 'sq', /*square*/
+    0x2014, 'em', /*em dash*/
+    0x00BC, '14', /*1/4*/
+    0x00BD, '12', /*1/2*/
+    0x00BE, '34', /*3/4*/
+    0x2212, 'mi', /*minus*/
+    0xFB01, 'fi', /*fi*/
+    0xFB02, 'fl', /*fl*/
+    0xFB00, 'ff', /*ff*/
+    0xFB03, 'Fi', /*ffi*/
+    0xFB04, 'Fl', /*ffl*/
+    0x00B0, 'de', /*degree*/
+    0x2020, 'dg', /*dagger*/
+    0x00A7, 'sc', /*section*/
+    0x2032, 'fm', /*prime*/
+    0x00B4, 'aa', /*acute accent*/
+    0x03B1, '*a', /*alpha*/
+    0x03B2, '*b', /*beta*/
+    0x03B3, '*g', /*gamma*/
+    0x03B4, '*d', /*delta*/
+    0x03B5, '*e', /*epsilon*/
+    0x03B6, '*z', /*zeta*/
+    0x03B7, '*y', /*eta*/
+    0x03B8, '*h', /*theta*/
+    0x03B9, '*i', /*iota*/
+    0x03BA, '*k', /*kappa*/
+    0x03BB, '*l', /*lambda*/
+    0x03BC, '*m', /*mu*/
+    0x03BD, '*n', /*nu*/
+    0x03BE, '*c', /*xi*/
+    0x03BF, '*o', /*omicron*/
+    0x03C0, '*p', /*pi*/
+    0x03C1, '*r', /*rho*/
+    0x03C3, '*s', /*sigma*/
+    0x03C4, '*t', /*tau*/
+    0x03C5, '*u', /*upsilon*/
+    0x03C6, '*f', /*phi*/
+    0x03C7, '*x', /*chi*/
+    0x03C8, '*q', /*psi*/
+    0x03C9, '*w', /*omega*/
+    0x0391, '*A', /*Alpha*/
+    0x0392, '*B', /*Beta*/
+    0x0393, '*G', /*Gamma*/
+    0x0394, '*D', /*Delta*/
+    0x0395, '*E', /*Epsilon*/
+    0x0396, '*Z', /*Zeta*/
+    0x0397, '*Y', /*Eta*/
+    0x0398, '*H', /*Theta*/
+    0x0399, '*I', /*Iota*/
+    0x039A, '*K', /*Kappa*/
+    0x039B, '*L', /*Lambda*/
+    0x039C, '*M', /*Mu*/
+    0x039D, '*N', /*Nu*/
+    0x039E, '*C', /*Xi*/
+    0x039F, '*O', /*Omicron*/
+    0x03A0, '*P', /*Pi*/
+    0x03A1, '*R', /*Rho*/
+    0x03A3, '*S', /*Sigma*/
+    0x03A4, '*T', /*Tau*/
+    0x03A5, '*U', /*Upsilon*/
+    0x03A6, '*F', /*Phi*/
+    0x03A7, '*X', /*Chi*/
+    0x03A8, '*Q', /*Psi*/
+    0x03A9, '*W', /*Omega*/
+    0x03C2, 'ts', /*terminal sigma*/
+    0x221A, 'sr', /*square root*/
+    0x2265, '>=', /*>=*/
+    0x2264, '<=', /*<=*/
+    0x2261, '==', /*identically equal*/
+    0x2245, '~=', /*approx =*/
+    0x223C, 'ap', /*approximates*/
+    0x2260, '!=', /*not equal*/
+    0x2192, '->', /*right arrow*/
+    0x2190, '<-', /*left arrow*/
+    0x2191, 'ua', /*up arrow*/
+    0x2193, 'da', /*down arrow*/
+    0x00D7, 'mu', /*multiply*/
+    0x00F7, 'di', /*divide*/
+    0x00B1, '+-', /*plus-minus*/
+    0x222A, 'cu', /*cup (union)*/
+    0x2229, 'ca', /*cap (intersection)*/
+    0x2282, 'sb', /*subset of*/
+    0x2283, 'sp', /*superset of*/
+    0x2286, 'ib', /*improper subset*/
+    0x2287, 'ip', /*  " superset*/
+    0x221E, 'if', /*infinity*/
+    0x2202, 'pd', /*partial derivative*/
+    0x2207, 'gr', /*gradient*/
+    0x00AC, 'no', /*not*/
+    0x222B, 'is', /*integral sign*/
+    0x221D, 'pt', /*proportional to*/
+    0x2205, 'es', /*empty set*/
+    0x2208, 'mo', /*member of*/
+    0x00AE, 'rg', /*registered*/
+    0x00A9, 'co', /*copyright*/
+    0x2502, 'br', /*box vert rule*/
+    0x00A2, 'ct', /*cent sign*/
+    0x2021, 'dd', /*dbl dagger*/
+    0x261E, 'rh', /*right hand*/
+    0x261C, 'lh', /*left hand*/
+    0x25CB, 'ci', /*circle*/
+    0x23A7, 'lt', /*left top (of big curly)*/
+    0x23A9, 'lb', /*left bottom*/
+    0x23AB, 'rt', /*right top*/
+    0x23AD, 'rb', /*right bot*/
+    0x23A8, 'lk', /*left center of big curly bracket*/
+    0x23AC, 'rk', /*right center of big curly bracket*/
+    0x23AA, 'bv', /*bold vertical*/
+    0x230A, 'lf', /*left floor*/
+    0x230B, 'rf', /*right floor*/
+    0x2308, 'lc', /*left ceiling*/
+    0x2309, 'rc', /*right ceiling*/
+    0x2018, 'ga', /*open quote*/
+    0x2019, 'aa', /*close quote*/
+    0x201C, 'ga', /*open double quote*/
+    0x201D, 'aa', /*close double quote*/
+    0x2013, '-', /*en dash*/
+    0, 0};
+
+#ifndef MKCHTAB
+/* setch()'s perfect hash of the names above and its reverse, made by mkchtab */
+#define CHTAB_TABLES
+#include "chtab_hash.h"
+#endif
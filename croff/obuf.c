@@ -0,0 +1,529 @@
+/* C17 - no scaffold needed */
+/*
+ * obuf.c - Output ring behind oput() and flusho()
+ *
+ * oput() fills one OBUFSZ segment of a ring at a time.  When a segment
+ * is full, obnext() queues it and hands out the next one.  Queued
+ * segments are written to ptid with writev(), as many as are waiting
+ * in one call.  -O<n> sets the ring to n kilobytes.
+ *
+ * When the output is not a terminal, a writer thread does the writing,
+ * so that formatting carries on while a slow reader at the other end
+ * of a pipe catches up.  The formatter only waits when every segment
+ * is queued.  On a terminal, or without threads, each segment is
+ * written as soon as it is full, as before.
+ *
+ * No write is made with oblock held.  The writer thread blocks the
+ * signals n1.c catches, so that their handler, which ends the run
+ * through done3(), always runs in the formatter; a reader gone away is
+ * EPIPE to the thread, and a failed write like any other.  Once no_out
+ * is set, as the SIGPIPE handler does, nothing more is queued or
+ * waited for, so done3() finishes with the ring as it was.
+ *
+ * flusho() queues the partial segment and then waits until everything
+ * queued has been written.  .fl, prstrfl() and the done() sequence
+ * therefore still find their output on the device, in order, when it
+ * returns; the diagnostics diag.c holds follow it out.
+ *
+ * With -w the typesetter is not opened at start-up.  It is tried,
+ * without blocking, when the first segment is queued, and formatting
+ * goes on filling the ring while it is busy.  Only a full ring or a
+ * flusho() waits for it, retrying with a growing pause; -W<n> gives up
+ * after n seconds.
+ *
+ * With -C's output cap, obqueue() queues no byte past it and then ends
+ * the run (caps.c).
+ *
+ * obtap() keeps a copy of what oput() writes from then on, for -R to
+ * cache with the part of the document that wrote it.  obtake() hands
+ * the copy over.
+ *
+ * obhold() keeps back everything queued from then on, for the forward
+ * references of fwref.c to be filled in when the document ends.
+ * obheld() hands the held output over to be written in, and obrelease()
+ * writes it to the device after what was queued before it.  Until then
+ * flusho() only waits for what was queued before obhold().
+ */
+
+#include "tdef.h" // troff definitions
+#include "troff_processor.h" // processor state
+#include "trace.h" // -Y event trace
+#include "caps.h" // -C resource caps
+#include "diag.h" // diagnostics held until the output is out
+#define OSA_TAG "croff.output"
+#include "os/os_acct.h" // OSA_MALLOC, OSA_CALLOC, OSA_REALLOC, ...
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/uio.h>
+#if defined(_POSIX_THREADS) && _POSIX_THREADS > 0
+#include <pthread.h>
+#define OBTHREAD 1
+#endif
+
+#define OBIOV 64 /* segments written by one writev() */
+#define OBWAIT0 50 /* first retry of the device, milliseconds */
+#define OBWAITMAX 15000 /* longest pause between retries */
+#define OBGONE 2 /* oberr when the reader has gone */
+
+extern int ptid;
+extern int waitf;
+extern int ascii;
+extern int no_out;
+extern int toolate;
+extern char ptname[];
+
+void prstr(const char *s);
+void done3(int x);
+
+void obnext(void);
+void flusho(void);
+void obwait(void);
+void obfork(void);
+
+int obsize = OBRING; /* -O: ring size in kilobytes */
+long flushn; /* flusho() calls, reported by -S */
+int obdevwait; /* -W: seconds to wait for the device, 0 for ever */
+
+static char *obring; /* obnseg segments of OBUFSZ bytes */
+static size_t *oblen; /* bytes queued in each segment */
+static int obnseg;
+static int obhead; /* oldest queued segment */
+static int obcount; /* segments queued, including any being written */
+static int obmode; /* 0 until the first queue, 1 write at once, 2 thread */
+static int oberr; /* a write failed: 1, or OBGONE for EPIPE */
+static long long obout; /* bytes queued, against -C's cap */
+static int obcapped; /* the cap is reached: nothing more is queued */
+static char *obtapb; /* copy of the output since obtap() */
+static size_t obtapn, obtapmax;
+static int obtapon; /* 1 copying, -1 out of memory for the copy */
+static char *obtapat; /* where the copy of the segment being filled starts */
+static char *obholdb; /* output kept back since obhold() */
+static size_t obholdn, obholdmax;
+static int obholdon;
+
+#ifdef OBTHREAD
+static pthread_t obtid;
+static pthread_mutex_t oblock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t obready = PTHREAD_COND_INITIALIZER; /* a segment was queued */
+static pthread_cond_t obfree = PTHREAD_COND_INITIALIZER; /* segments were written */
+#define LOCK() pthread_mutex_lock(&oblock)
+#define UNLOCK() pthread_mutex_unlock(&oblock)
+#else
+#define LOCK()
+#define UNLOCK()
+#endif
+
+/* Write n queued segments starting at obhead; 0, 1 if a write failed, or OBGONE */
+static int obwrite(int n) {
+    struct iovec iov[OBIOV];
+    ssize_t w;
+    int i, k;
+
+    for (i = 0; i < n; i++) {
+        k = (obhead + i) % obnseg;
+        iov[i].iov_base = obring + (size_t)k * OBUFSZ;
+        iov[i].iov_len = oblen[k];
+    }
+    for (i = 0; i < n && !no_out;) {
+        if ((w = OSA_IO(OSA_KWRITE, writev(ptid, &iov[i], n - i))) < 0)
+            return ((errno == EPIPE) ? OBGONE : 1);
+        for (; i < n && (size_t)w >= iov[i].iov_len; i++)
+            w -= (ssize_t)iov[i].iov_len;
+        if (i < n) {
+            iov[i].iov_base = (char *)iov[i].iov_base + w;
+            iov[i].iov_len -= (size_t)w;
+        }
+    }
+    return (0);
+}
+
+#ifdef OBTHREAD
+static void *obwriter(void *arg) {
+    int n, rc;
+
+    (void)arg;
+    LOCK();
+    for (;;) {
+        while (!obcount)
+            pthread_cond_wait(&obready, &oblock);
+        n = obcount < OBIOV ? obcount : OBIOV;
+        UNLOCK();
+        rc = oberr ? 0 : obwrite(n); /* after a failure the rest is dropped */
+        LOCK();
+        if (rc)
+            oberr = rc;
+        obhead = (obhead + n) % obnseg;
+        obcount -= n;
+        pthread_cond_broadcast(&obfree);
+    }
+    return NULL;
+}
+#endif
+
+/* Hand out segment k for oput() to fill */
+static void obseg(int k) {
+    g_processor.outputBuffer = obring + (size_t)k * OBUFSZ;
+    g_processor.outputPtr = g_processor.outputBuffer;
+    /* Leave room for the terminator flusho() adds in non-ASCII mode */
+    g_processor.outputEnd = g_processor.outputBuffer + OBUFSZ - !ascii;
+}
+
+/* Bytes of output ring allocated, for the -M report */
+size_t obbytes(void) {
+    return (obring != NULL ? (size_t)obnseg * OBUFSZ : 0);
+}
+
+static void obinit(void) {
+    obnseg = (int)(((long)obsize * 1024) / OBUFSZ);
+    if (obnseg < 1)
+        obnseg = 1;
+    for (;;) {
+        obring = OSA_MALLOC((size_t)obnseg * OBUFSZ);
+        oblen = OSA_CALLOC((size_t)obnseg, sizeof(*oblen));
+        if ((obring && oblen) || obnseg == 1)
+            break;
+        OSA_FREE(obring);
+        OSA_FREE(oblen);
+        obnseg = 1;
+    }
+    if (!obring || !oblen) {
+        prstr("Out of memory for output.\n");
+        exit(-1);
+    }
+    obseg(0);
+}
+
+static void obsleep(long ms) {
+    struct timespec ts;
+
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (ms % 1000) * 1000000L;
+    nanosleep(&ts, NULL);
+}
+
+/*
+ * Try to open the device without blocking on it.  With wait set, keep
+ * trying, backing off from OBWAIT0 to OBWAITMAX milliseconds between
+ * attempts, and give up after obdevwait seconds if that is set.
+ */
+static int obopen(int wait) {
+    long ms, waited;
+    int fd, fl;
+
+    for (ms = OBWAIT0, waited = 0;;) {
+        if ((fd = open(ptname, O_WRONLY | O_NONBLOCK)) >= 0) {
+            if ((fl = fcntl(fd, F_GETFL)) >= 0)
+                fcntl(fd, F_SETFL, fl & ~O_NONBLOCK);
+            ptid = fd;
+            return 1;
+        }
+        if (!wait)
+            return 0;
+        if (obdevwait > 0 && waited >= obdevwait * 1000L) {
+            prstr("Typesetter not available.\n");
+            obcount = 0; /* nothing left for done3() to wait for */
+            obmode = 1;
+            no_out++;
+            done3(1);
+        }
+        if (++waitf <= 2)
+            prstr("Waiting for Typesetter.\n");
+        obsleep(ms);
+        waited += ms;
+        ms = (ms * 2 < OBWAITMAX) ? ms * 2 : OBWAITMAX;
+    }
+}
+
+/*
+ * Open the device if it is not open yet and pick how to write to it.
+ * Until the device can be opened the queued segments simply wait in
+ * the ring; with wait set there is no room left, so wait for it.
+ * Once anything is queued the output can no longer be redirected
+ * with .pi, so the choice holds.
+ */
+static int obstart(int wait) {
+#ifdef OBTHREAD
+    sigset_t set, was;
+#endif
+
+    if (!ptid && !obopen(wait))
+        return 0;
+    obmode = 1;
+#ifdef OBTHREAD
+    if (obnseg > 1 && !isatty(ptid)) {
+        /* The thread starts with these blocked, and they stay blocked there */
+        sigemptyset(&set);
+        sigaddset(&set, SIGHUP);
+        sigaddset(&set, SIGINT);
+        sigaddset(&set, SIGTERM);
+        sigaddset(&set, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &set, &was);
+        if (pthread_create(&obtid, NULL, obwriter, NULL) == 0) {
+            pthread_detach(obtid);
+            obmode = 2;
+        }
+        pthread_sigmask(SIG_SETMASK, &was, NULL);
+    }
+#endif
+    return 1;
+}
+
+/*
+ * Pass whatever is queued to the writer; called with the lock held.
+ * Without a thread the segments are written here, with the lock let go
+ * meanwhile: a SIGPIPE from the write ends the run from its handler.
+ */
+static void obdrain(void) {
+    int n, rc;
+
+    for (; obmode == 1 && obcount; obcount -= n) {
+        n = obcount < OBIOV ? obcount : OBIOV;
+        UNLOCK();
+        rc = oberr ? 0 : obwrite(n);
+        LOCK();
+        if (rc)
+            oberr = rc;
+        obhead = (obhead + n) % obnseg;
+    }
+#ifdef OBTHREAD
+    if (obmode == 2 && obcount)
+        pthread_cond_signal(&obready);
+#endif
+}
+
+/* Append n bytes at p to the buffer *b of *bn bytes, *bmax allocated */
+static int obappend(char **b, size_t *bn, size_t *bmax, const char *p, size_t n) {
+    char *nb;
+    size_t k;
+
+    if (*bn + n > *bmax) {
+        for (k = *bmax ? *bmax : OBUFSZ; k < *bn + n; k *= 2)
+            ;
+        if ((nb = OSA_REALLOC(*b, k)) == NULL)
+            return (-1);
+        *b = nb;
+        *bmax = k;
+    }
+    memcpy(*b + *bn, p, n);
+    *bn += n;
+    return (0);
+}
+
+/* Copy what oput() has put in the segment being filled since obtapat */
+static void obtapcopy(void) {
+    char *from;
+
+    from = obtapat ? obtapat : g_processor.outputBuffer;
+    obtapat = NULL;
+    if ((obtapon < 0) || (from == NULL))
+        return;
+    if (obappend(&obtapb, &obtapn, &obtapmax, from, (size_t)(g_processor.outputPtr - from)) < 0)
+        obtapon = -1;
+}
+
+/*
+ * The writer thread has found the reader gone: end the run as the
+ * SIGPIPE handler would have in the formatter.  Called without the lock.
+ */
+static void obgone(int err) {
+    if (err == OBGONE && obmode == 2 && !no_out) {
+        no_out++;
+        done3(01);
+    }
+}
+
+/* Queue the segment being filled and hand out the next free one */
+static void obqueue(int flush) {
+    size_t n;
+    int k, err, over = 0;
+
+    toolate = 1;
+    if (no_out) { /* the run is ending with nowhere to write */
+        g_processor.outputPtr = g_processor.outputBuffer;
+        return;
+    }
+    if (obtapon)
+        obtapcopy();
+    n = (size_t)(g_processor.outputPtr - g_processor.outputBuffer);
+    if (obcapped) {
+        n = 0;
+    } else if (capout && (obout += (long long)n) > capout) {
+        n -= (size_t)(obout - capout); /* up to the cap, and no more */
+        obcapped = over = 1;
+    }
+    if (obholdon) {
+        if (obappend(&obholdb, &obholdn, &obholdmax, g_processor.outputBuffer, n) < 0) {
+            prstr("Out of memory for output.\n");
+            exit(-1);
+        }
+        g_processor.outputPtr = g_processor.outputBuffer; /* the segment is free again */
+        goto out;
+    }
+    LOCK();
+    k = (obhead + obcount) % obnseg;
+    oblen[k] = n;
+    obcount++;
+    if (!obmode) {
+        UNLOCK(); /* no writer yet */
+        if (!obstart(flush || obcount == obnseg)) {
+            obseg((obhead + obcount) % obnseg);
+            goto out;
+        }
+        LOCK();
+    }
+    obdrain();
+#ifdef OBTHREAD
+    while (obmode == 2 && obcount == obnseg)
+        pthread_cond_wait(&obfree, &oblock);
+#endif
+    k = (obhead + obcount) % obnseg;
+    err = oberr;
+    UNLOCK();
+    obgone(err);
+    obseg(k);
+out:
+    if (over)
+        capfail(CAP_OUT);
+}
+
+/*
+ * Called by oput() when the segment is full, or before the first
+ * character when there is no ring yet
+ */
+void obnext(void) {
+    if (!obring)
+        obinit();
+    else
+        obqueue(0);
+}
+
+/* Wait until every queued segment has been written */
+void obwait(void) {
+    if (no_out)
+        return;
+    if (!obmode && obcount)
+        obstart(1);
+    LOCK();
+    obdrain();
+#ifdef OBTHREAD
+    while (obcount)
+        pthread_cond_wait(&obfree, &oblock);
+#endif
+    UNLOCK();
+    if (oberr)
+        toolate = -1;
+}
+
+/*
+ * In a child of bfork(), once obwait() has emptied the ring: the
+ * writer thread stayed behind in the parent, so start over as if
+ * nothing had been queued yet
+ */
+void obfork(void) {
+    obmode = 0;
+    obhead = obcount = 0;
+    oberr = 0;
+    obout = 0;
+    if (obring)
+        obseg(0);
+}
+
+/*
+ * flusho - Flush the device output buffer
+ *
+ * Queues what oput() has gathered, adding the terminator in non-ASCII
+ * mode, and returns once it has all been written to the device.
+ */
+void flusho(void) {
+    flushn++;
+    if (!obring)
+        obinit();
+    if (!ascii)
+        *g_processor.outputPtr++ = '\0';
+    TRBEG(TR_FLUSH, (int)(g_processor.outputPtr - g_processor.outputBuffer));
+    obqueue(1);
+    obwait();
+    TREND();
+    dgsent();
+}
+
+/* Begin copying what oput() writes */
+void obtap(void) {
+    obtapn = 0;
+    obtapon = 1;
+    obtapat = g_processor.outputPtr;
+}
+
+/*
+ * Stop copying, and hand over the copy: *n bytes, which are the
+ * caller's to free.  NULL if there was no memory for it.
+ */
+char *obtake(size_t *n) {
+    char *b;
+
+    if (!obtapon)
+        return (NULL);
+    obtapcopy();
+    b = (obtapon > 0) ? (obtapb ? obtapb : OSA_MALLOC(1)) : NULL;
+    if (b == NULL)
+        OSA_FREE(obtapb);
+    *n = obtapn;
+    obtapb = NULL;
+    obtapn = obtapmax = 0;
+    obtapon = 0;
+    return (b);
+}
+
+
+/* Keep back what is queued from now on */
+void obhold(void) {
+    if (!obring)
+        obinit();
+    obholdon = 1;
+}
+
+/* Offset in the held output of the next byte oput() writes, or -1 */
+long obat(void) {
+    if (!obholdon)
+        return (-1);
+    return ((long)obholdn + (long)(g_processor.outputPtr - g_processor.outputBuffer));
+}
+
+/*
+ * The output held since obhold(), with the segment being filled, for
+ * the caller to write in: *n bytes, which stay obuf's
+ */
+char *obheld(size_t *n) {
+    obqueue(0);
+    *n = obholdn;
+    return (obholdb);
+}
+
+/* Write the held output after everything queued before it, and stop holding */
+void obrelease(void) {
+    ssize_t w;
+    size_t k;
+
+    if (!obholdon)
+        return;
+    obqueue(0);
+    obholdon = 0;
+    obwait();
+    if (obholdn && !obmode)
+        obstart(1);
+    for (k = 0; k < obholdn && !no_out; k += (size_t)w)
+        if ((w = OSA_WRITE(ptid, obholdb + k, obholdn - k)) < 0) {
+            oberr = 1;
+            toolate = -1;
+            break;
+        }
+    OSA_FREE(obholdb);
+    obholdb = NULL;
+    obholdn = obholdmax = 0;
+}
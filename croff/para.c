@@ -0,0 +1,171 @@
+/*
+ * para.c - Paragraph line breaking for fill mode (Pure C17)
+ *
+ * parfit() scores every way of breaking a run of words into lines with
+ * Knuth-Plass demerits and keeps the cheapest.  Spaces only stretch in
+ * nroff, so a breakpoint whose line has grown wider than the page can
+ * never come back; the active set is therefore the window of recent
+ * breakpoints still in reach, which is at most a line's worth of words
+ * and is capped at NPACT.  The cost is linear in the length of the run.
+ */
+
+#include "para.h"
+#define OSA_TAG "croff.para"
+#include "os/os_acct.h" /* OSA_REALLOC */
+
+#include <stdlib.h>
+
+#define PARINF 0x7fffffffffffffffLL
+
+/* Scratch space for parfit(), grown as needed */
+static long long *dem; /* least demerits of a layout ending at each break */
+static long *pre; /* pre[k]: width of words 0 through k - 1 with spaces */
+static int *from; /* break that starts the last line of that layout */
+static char *alone; /* the layout ended the partial first line by itself */
+static int nscr;
+
+/* Make room for breakpoints 0 through n */
+static int parroom(int n) {
+    long long *d;
+    long *p;
+    int *f;
+    char *a;
+    int m;
+
+    if (n < nscr)
+        return (0);
+    m = nscr ? nscr : 256;
+    while (m <= n)
+        m *= 2;
+    if ((d = OSA_REALLOC(dem, m * sizeof(*d))) == NULL)
+        return (-1);
+    dem = d;
+    if ((p = OSA_REALLOC(pre, m * sizeof(*p))) == NULL)
+        return (-1);
+    pre = p;
+    if ((f = OSA_REALLOC(from, m * sizeof(*f))) == NULL)
+        return (-1);
+    from = f;
+    if ((a = OSA_REALLOC(alone, m)) == NULL)
+        return (-1);
+    alone = a;
+    nscr = m;
+    return (0);
+}
+
+/*
+ * Demerits of a line with slack units left over and gaps interword
+ * spaces to spread it over.  The last line is never spread.
+ */
+static long long pardem(long slack, int gaps, int sps, int last) {
+    long long b;
+    double r;
+
+    b = 0;
+    if (!last) {
+        r = (double)slack / ((double)(gaps > 0 ? gaps : 1) * sps);
+        b = (r > 4.65) ? 10000 : (long long)(100 * r * r * r);
+    }
+    return ((10 + b) * (10 + b));
+}
+
+/* Consider the line from break i to break j with the given cost */
+static void partry(int i, int j, long long d, int a) {
+    if (d < dem[j]) {
+        dem[j] = d;
+        from[j] = i;
+        alone[j] = a;
+    }
+}
+
+int pargreedy(const struct parwd *wd, int n, const struct parlim *lim,
+              int *ends) {
+    long cur, add, avail;
+    int k, nl, g;
+
+    nl = 0;
+    cur = 0;
+    avail = lim->w0;
+    g = lim->g0;
+    for (k = 0; k < n; k++) {
+        add = g ? wd[k].sp + wd[k].wid : wd[k].wid;
+        if (g && (cur + add > avail)) {
+            ends[nl++] = k;
+            avail = lim->w;
+            cur = 0;
+            g = 0;
+            add = wd[k].wid;
+        }
+        cur += add;
+        g++;
+    }
+    ends[nl++] = n;
+    return (nl);
+}
+
+int parfit(const struct parwd *wd, int n, const struct parlim *lim,
+           int *ends) {
+    long nat, w0, w;
+    long long d0;
+    int i, j, k, lo, last, sps, ina, inb, nl;
+
+    if (n <= 0 || parroom(n) < 0)
+        return (-1);
+    w0 = lim->w0;
+    w = lim->w;
+    sps = (lim->sps > 0) ? lim->sps : 1;
+    pre[0] = 0;
+    for (k = 0; k < n; k++)
+        pre[k + 1] = pre[k] + wd[k].sp + wd[k].wid;
+
+    /* Ending the partial first line before any new word */
+    d0 = (lim->g0 > 0) ? pardem(w0, lim->g0 - 1, sps, 0) : PARINF;
+    ina = 1; /* first line can still take words after the partial line */
+    inb = (lim->g0 > 0); /* a line from word 0 after ending it alone */
+    lo = 1;
+    for (j = 1; j <= n; j++) {
+        dem[j] = PARINF;
+        last = (j == n);
+        if (ina) {
+            nat = (lim->g0 > 0) ? pre[j] : pre[j] - wd[0].sp;
+            if (nat <= w0)
+                partry(0, j, pardem(w0 - nat, lim->g0 + j - 1, sps, last), 0);
+            else
+                ina = 0;
+        }
+        if (inb) {
+            nat = pre[j] - wd[0].sp;
+            if (nat <= w)
+                partry(0, j, d0 + pardem(w - nat, j - 1, sps, last), 1);
+            else
+                inb = 0;
+        }
+        /* Breakpoints before lo are out of reach for good. */
+        while (lo < j && (pre[j] - pre[lo] - wd[lo].sp) > w)
+            lo++;
+        if (j - lo > NPACT)
+            return (-1);
+        for (i = lo; i < j; i++)
+            if (dem[i] != PARINF)
+                partry(i, j,
+                       dem[i] + pardem(w - (pre[j] - pre[i] - wd[i].sp),
+                                       j - i - 1, sps, last),
+                       0);
+        if (dem[j] == PARINF)
+            return (-1);
+    }
+
+    /* Walk the chosen breaks back from the end, then put them in order. */
+    nl = 0;
+    for (j = n; j > 0; j = from[j]) {
+        ends[nl++] = j;
+        if (from[j] == 0 && alone[j])
+            ends[nl++] = 0;
+    }
+    for (i = 0, k = nl - 1; i < k; i++, k--) {
+        j = ends[i];
+        ends[i] = ends[k];
+        ends[k] = j;
+    }
+    return (nl);
+}
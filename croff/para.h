@@ -0,0 +1,57 @@
+/*
+ * para.h - Paragraph line breaking for fill mode (Pure C17)
+ *
+ * Chooses where a run of filled words is broken into lines.  pargreedy()
+ * is the classic one-line-at-a-time first fit; parfit() minimizes the
+ * total demerits of the whole run in the manner of Knuth and Plass.
+ * Both only look at widths, so they can be used and measured apart from
+ * the formatter.
+ */
+
+#ifndef PARA_H
+#define PARA_H
+
+/*
+ * Active breakpoints kept per word by parfit().  Older ones (longer
+ * lines) are dropped, which bounds the cost at NPACT steps per word.
+ */
+#define NPACT 64
+
+/*
+ * A filled word: the width of the spaces ahead of it, which vanish at
+ * the start of a line, and the width of the word itself.
+ */
+struct parwd {
+    int sp;
+    int wid;
+};
+
+/*
+ * The lines a run is broken into.  The first line may already hold
+ * g0 words (the partial line left in line[]) and has w0 units free;
+ * every further line has w units.  sps is the width of a space, the
+ * unit of stretch.
+ */
+struct parlim {
+    int w0;
+    int g0;
+    int w;
+    int sps;
+};
+
+/*
+ * Break n words into lines.  ends[k] receives the number of words on
+ * lines 0 through k, so the last entry is n; ends[0] is 0 when the
+ * partial first line is best ended before the first new word.  ends
+ * must have room for n + 1 entries.
+ *
+ * Both return the number of lines.  parfit() returns -1 instead when a
+ * word is wider than a line or the active set had to be cut, and the
+ * caller should use pargreedy() for the run.
+ */
+int pargreedy(const struct parwd *wd, int n, const struct parlim *lim,
+              int *ends);
+int parfit(const struct parwd *wd, int n, const struct parlim *lim,
+           int *ends);
+
+#endif /* PARA_H */
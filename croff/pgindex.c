@@ -0,0 +1,652 @@
+/* C17 - no scaffold needed */
+/*
+ * pgindex.c - Page checkpoints for -o, kept in a -X index
+ *
+ * -X<file> names an index of the document kept beside it.  A run that
+ * finds no valid index takes a checkpoint of the formatter after each
+ * page break, at the first place where one can be taken, and writes
+ * the index when it ends.  A later -o run with the same options and
+ * unchanged input restores the last checkpoint before the first page to
+ * be printed and formats from there.  It does not format every page
+ * before it.
+ *
+ * A checkpoint holds the state image of snapshot.c: macros, registers,
+ * traps, the translation table and the environments.  It also holds a
+ * part of its own:
+ *   - the input files and the offset in each
+ *   - the page-level variables that are not in an environment
+ *   - the .ie stack, the font mounts and the .hw words
+ *   - d[0], the page's own row of the diversion table
+ *   - the device's part-written line and its variables (sgdevput())
+ * A block, environment or word list that matches one in an earlier
+ * checkpoint is written once and referred to after that.  So the index
+ * grows by what each page changed.
+ *
+ * A checkpoint is taken only between input lines read at the top level
+ * from files.  None is taken inside a macro, string or trap, with a
+ * diversion open, while .op holds a paragraph, or while input comes
+ * from a terminal, a pipe or the standard input.  A page that begins
+ * in such a place gets its checkpoint at the next place that allows
+ * one.
+ *
+ * The index is keyed by the options and file names (except -o and -X)
+ * and by the table sizes.  It also records the name, device, inode,
+ * size and time of every file read.  A checkpoint is used only if every
+ * file read before it is unchanged.
+ *
+ * An -o run does not take up the device's part.  It has not printed
+ * anything before its first page, so a restored run ends up the same.
+ * A .tm or .pi on a skipped page does not run, and the date registers
+ * hold today's date.  -J takes the device's part up as well, to format
+ * the pages between checkpoints in parallel (pjob.c).
+ */
+
+#include "tdef.h" // troff definitions
+#include "t.h" // v and d
+#include "pgindex.h"
+#include "fwref.h" // forward references
+#include "pmodel.h" // -G
+#include "segcache.h" // sgdevput(), sgdevget()
+#include "pjob.h" // -J
+#define OSA_TAG "croff.index"
+#include "os/os_acct.h" // OSA_MALLOC, OSA_CALLOC, OSA_REALLOC, ...
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#define PXMAGIC "CROFFPGX"
+#define PXVERS 3
+#define PXNAME 256 /* longest file name kept, with its NUL */
+#define PXFONTS 4 /* font positions */
+#define PXPOOL (-6 - NEV) /* piece key of the .hw words, below snapput()'s */
+
+/* Index header; the file and checkpoint tables are at tail */
+struct pxhdr {
+    char magic[8];
+    int version;
+    int nn, evs, blk, nev, nvars, envsz;
+    unsigned long long key; /* options and file names */
+    long tail;
+    int nfile, nmark;
+};
+
+/* A file read, in the order it was opened */
+struct pxfile {
+    char name[PXNAME];
+    long dev, ino, size, mtime;
+};
+
+/* A checkpoint in the table */
+struct pxmark {
+    int pn; /* page number it was taken on */
+    int maxpn; /* highest page number begun by then */
+    int nfile; /* files read by then */
+    int rargc; /* file arguments left */
+    long off; /* its record */
+};
+
+/* The input level of a checkpoint: file read and offset in it */
+struct pxlev {
+    int file;
+    int off;
+};
+
+/* The last copy written of each piece, so a piece the same is referred to */
+struct pxslot {
+    long where;
+    size_t n;
+    char *copy;
+};
+
+extern int ip, *cp, *ap, raw, copyf, level, dilev, frlev, nx, donef, ndone, ejf, lit, app, ds;
+extern int ch, ch0, nchar, rchar, nlflg, padc, fc, lg, ulfont, ulbit, cs, bd, sv, sfont;
+extern int tlss, ralss, trap, po1, paper, npn, npnflg, nfo, evi, ev, ifx, smnt;
+extern int ifi, ioff, *offl, rargc, mflg, stdi, print, pfrom, pnmax, dateset;
+extern int *ejl, *frame;
+extern char **argp;
+extern int pnlist[];
+extern int evlist[], iflist[], fontlab[];
+extern struct device_state *dip;
+extern char *bsuffix, *dsock;
+
+extern int parheld(void);
+extern const char *hxwords(int *n);
+extern int hxreset(const char *w, int n);
+extern int evsize(void);
+extern void snapbase(void);
+extern long snapget(const char *p, const char *e,
+                    const void *(*piece)(const char **pp, const char *e, size_t n), int apply);
+extern int snapput(int fd, int (*piece)(int fd, int key, const void *buf, size_t n));
+extern int soresume(int n, const int *fd, const int *off);
+extern void getmap(void);
+extern void lgflush(void);
+extern void cvtime(void);
+extern void capstart(void);
+extern void prstr(const char *s);
+extern void done3(int x);
+
+char *pxfile; /* -X index */
+int pxon; /* checkpoints are being taken */
+long pxpages; /* pagesout at the last checkpoint */
+
+/* Page-level variables, kept as they are */
+static int *pxvars[] = {
+    &ch, &ch0, &nchar, &rchar, &nlflg, &padc, &fc, &lg, &ulfont, &ulbit, &cs, &bd, &sv,
+    &sfont, &tlss, &ralss, &trap, &po1, &paper, &npn, &npnflg, &nfo, &evi, &ev, &ifx, &smnt,
+};
+#define NPXVARS ((int)(sizeof(pxvars) / sizeof(pxvars[0])))
+
+/* Bytes of a record after its levels, up to its word list */
+#define PXFIX ((size_t)(NPXVARS + EVLSZ + NIF + PXFONTS) * sizeof(int) + sizeof(d[0]))
+
+static unsigned long long pxkey = 14695981039346656037ULL;
+static struct pxfile *pxf; /* files read */
+static int npxf, pxfmax;
+static int *pxlv; /* pxf[] entry read at each input level, -1 if none */
+static int pxlvmax;
+static struct pxmark *pxm; /* checkpoints taken */
+static int npxm, pxmmax;
+static struct pxslot *pxs;
+static int npxs;
+static int pxfd = -1; /* index being written, under pxtmp */
+static char pxtmp[PXNAME + 8];
+static const char *pxmap; /* index being read */
+static size_t pxmapn;
+
+/* Append n bytes to the index being written */
+static int put(int fd, const void *p, size_t n) {
+    return (OSA_WRITE(fd, p, n) == (ssize_t)n ? 0 : -1);
+}
+
+/* Grow the array at *a of *max entries of size sz to hold n */
+static int grow(void *a, int *max, int n, size_t sz) {
+    void *b;
+    int k;
+
+    if (n <= *max)
+        return (0);
+    for (k = *max ? *max : 16; k < n; k *= 2)
+        ;
+    if ((b = OSA_REALLOC(*(void **)a, k * sz)) == NULL)
+        return (-1);
+    memset((char *)b + *max * sz, 0, (k - *max) * sz);
+    *(void **)a = b;
+    *max = k;
+    return (0);
+}
+
+/* Fold an option or file argument into the key; -o and -X are not in it */
+void pxarg(const char *a) {
+    if ((a[0] == '-') && ((a[1] == 'o') || (a[1] == 'X')))
+        return;
+    do
+        pxkey = (pxkey ^ (unsigned char)*a) * 1099511628211ULL;
+    while (*a++);
+}
+
+/* File fd, named name, is now read at input level lev */
+void pxinput(int lev, const char *name, int fd) {
+    struct stat st;
+    struct pxfile *f;
+    int k;
+
+    if (!pxon && !pjleft)
+        return;
+    if (grow(&pxlv, &pxlvmax, lev + 1, sizeof(*pxlv)) < 0) {
+        pxon = 0;
+        return;
+    }
+    k = -1;
+    if ((fd > 0) && name && (strlen(name) < PXNAME) && (fstat(fd, &st) == 0) &&
+        S_ISREG(st.st_mode) && (grow(&pxf, &pxfmax, npxf + 1, sizeof(*pxf)) == 0)) {
+        f = &pxf[k = npxf++];
+        strcpy(f->name, name);
+        f->dev = (long)st.st_dev;
+        f->ino = (long)st.st_ino;
+        f->size = (long)st.st_size;
+        f->mtime = (long)st.st_mtime;
+    }
+    pxlv[lev] = k;
+}
+
+/* The header this binary and these options write */
+static void pxhead(struct pxhdr *h) {
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, PXMAGIC, sizeof(h->magic));
+    h->version = PXVERS;
+    h->nn = NN;
+    h->evs = evsize();
+    h->blk = BLK;
+    h->nev = NEV;
+    h->nvars = NPXVARS;
+    h->envsz = (int)sizeof(d[0]);
+    h->key = pxkey;
+}
+
+/*
+ * Write a piece of a checkpoint: a reference to the same bytes written
+ * before, or 0 and the bytes.  Blocks are keyed by blist index, the
+ * environments and the word list by negative keys.
+ */
+static int pxpiece(int fd, int key, const void *buf, size_t n) {
+    struct pxslot *s;
+    long ref;
+    int k;
+
+    k = (key >= 0) ? NEV + 1 + key : -1 - key;
+    if (grow(&pxs, &npxs, k + 1, sizeof(*pxs)) < 0)
+        return (-1);
+    s = &pxs[k];
+    if (s->copy && (s->n == n) && (memcmp(s->copy, buf, n) == 0))
+        return (put(fd, &s->where, sizeof(s->where)));
+    ref = 0;
+    if (put(fd, &ref, sizeof(ref)) || ((ref = (long)lseek(fd, 0, SEEK_CUR)) < 0) ||
+        put(fd, buf, n))
+        return (-1);
+    if (s->n != n) {
+        OSA_FREE(s->copy);
+        s->n = (s->copy = OSA_MALLOC(n)) ? n : 0;
+    }
+    if (s->copy) {
+        memcpy(s->copy, buf, n);
+        s->where = ref;
+    }
+    return (0);
+}
+
+/* Read a piece pxpiece() wrote, at *pp in the record ending by e */
+static const void *pxget(const char **pp, const char *e, size_t n) {
+    const char *b;
+    long ref;
+
+    if ((size_t)(e - *pp) < sizeof(ref))
+        return (NULL);
+    memcpy(&ref, *pp, sizeof(ref));
+    *pp += sizeof(ref);
+    if (ref == 0) {
+        if ((size_t)(e - *pp) < n)
+            return (NULL);
+        b = *pp;
+        *pp += n;
+        return (b);
+    }
+    if ((ref < (long)sizeof(struct pxhdr)) || (ref & 3) || (n > pxmapn) ||
+        ((size_t)ref > pxmapn - n))
+        return (NULL);
+    return (pxmap + ref);
+}
+
+/* Stop taking checkpoints and drop what was written */
+static void pxquit(void) {
+    pxon = 0;
+    if (pxfd >= 0) {
+        close(pxfd);
+        unlink(pxtmp);
+        pxfd = -1;
+    }
+}
+
+/*
+ * Whether the formatter is between two input lines read from a file,
+ * with no macro, diversion or held paragraph open: a place its state
+ * is all in what pxsave() writes.  A file just pushed by .so is not
+ * read yet, so nx is left to the caller.  The marks of forward
+ * references are not in it, so a document with any has no such place.
+ */
+int pxquiet(void) {
+    return (!(ip || cp || ap || raw || copyf || level || dilev || frlev || donef || ndone ||
+              ejf || lit || app || ds || nfw || pmflg || parheld()));
+}
+
+/* Whether a checkpoint can be taken here, between two input lines */
+static int pxsafe(void) {
+    int k;
+
+    if (nx || !pxquiet() || (ifi >= pxlvmax))
+        return (0);
+    for (k = 0; k <= ifi; k++)
+        if (pxlv[k] < 0)
+            return (0);
+    return (1);
+}
+
+/* Write a piece through piece, or whole */
+static int pxput(int fd, int (*piece)(int fd, int key, const void *buf, size_t n), int key,
+                 const void *buf, size_t n) {
+    return (piece ? piece(fd, key, buf, n) : put(fd, buf, n));
+}
+
+/*
+ * pxsave - Write the formatter state at a pxquiet() place
+ *
+ * The page-level variables, the .ie stack, the font mounts, d[0], the
+ * .hw words and the state image of snapshot.c.  The words and the
+ * image's pieces go through piece as snapput() has it.
+ *
+ * Returns 0, or -1 if a write failed.
+ */
+int pxsave(int fd, int (*piece)(int fd, int key, const void *buf, size_t n)) {
+    const char *pool;
+    char *w;
+    int k, n, n4, rc, vars[NPXVARS];
+
+    for (k = 0; k < NPXVARS; k++)
+        vars[k] = *pxvars[k];
+    pool = hxwords(&n);
+    n4 = (n + 3) & ~3;
+    if ((w = OSA_CALLOC(1, n4 + 1)) == NULL)
+        return (-1);
+    if (n)
+        memcpy(w, pool, n);
+    rc = put(fd, vars, sizeof(vars)) || put(fd, evlist, EVLSZ * sizeof(int)) ||
+         put(fd, iflist, NIF * sizeof(int)) || put(fd, fontlab, PXFONTS * sizeof(int)) ||
+         put(fd, &d[0], sizeof(d[0])) || put(fd, &n, sizeof(n)) ||
+         pxput(fd, piece, PXPOOL, w, n4) || snapput(fd, piece);
+    OSA_FREE(w);
+    return (rc ? -1 : 0);
+}
+
+/* A piece of n bytes stored whole, at *pp */
+static const void *pxwhole(const char **pp, const char *e, size_t n) {
+    const char *b = *pp;
+
+    if ((size_t)(e - *pp) < n)
+        return (NULL);
+    *pp += n;
+    return (b);
+}
+
+/*
+ * pxrestore - Restore the state pxsave() wrote at p, which ends by e
+ *
+ * With apply 0 the state is only measured, as snapget() does.  A
+ * failure once apply has begun leaves the state part restored.
+ *
+ * Returns its length, or -1.
+ */
+long pxrestore(const char *p, const char *e,
+               const void *(*piece)(const char **pp, const char *e, size_t n), int apply) {
+    const char *p0, *q, *pool;
+    int k, n, vars[NPXVARS];
+    long m;
+
+    p0 = p;
+    if (piece == NULL)
+        piece = pxwhole;
+    if ((size_t)(e - p) < PXFIX + sizeof(n))
+        return (-1);
+    memcpy(&n, p + PXFIX, sizeof(n));
+    q = p + PXFIX + sizeof(n);
+    if ((n < 0) || ((pool = piece(&q, e, ((size_t)n + 3) & ~(size_t)3)) == NULL) ||
+        (n && pool[n - 1]) || ((m = snapget(q, e, piece, apply)) < 0))
+        return (-1);
+    if (apply) {
+        memcpy(vars, p, sizeof(vars));
+        p += sizeof(vars);
+        memcpy(evlist, p, EVLSZ * sizeof(int));
+        p += EVLSZ * sizeof(int);
+        memcpy(iflist, p, NIF * sizeof(int));
+        p += NIF * sizeof(int);
+        memcpy(fontlab, p, PXFONTS * sizeof(int));
+        p += PXFONTS * sizeof(int);
+        memcpy(&d[0], p, sizeof(d[0]));
+        if (hxreset(pool, n) < 0)
+            return (-1);
+        for (k = 0; k < NPXVARS; k++)
+            *pxvars[k] = vars[k];
+        dip = &d[0];
+        dilev = 0;
+    }
+    return ((long)(q - p0) + m);
+}
+
+/* Append a checkpoint of the formatter as it is */
+static int pxmark(void) {
+    struct pxhdr h;
+    struct pxmark *m;
+    struct pxlev lv;
+    int k, n, rc;
+
+    if (pxfd < 0) {
+        if ((snprintf(pxtmp, sizeof(pxtmp), "%s.XXXXXX", pxfile) >= (int)sizeof(pxtmp)) ||
+            ((pxfd = mkstemp(pxtmp)) < 0))
+            return (-1);
+        pxhead(&h);
+        if (put(pxfd, &h, sizeof(h)))
+            return (-1);
+    }
+    if (grow(&pxm, &pxmmax, npxm + 1, sizeof(*pxm)) < 0)
+        return (-1);
+    m = &pxm[npxm];
+    m->pn = v.pn;
+    m->maxpn = pnmax;
+    m->nfile = npxf;
+    m->rargc = rargc;
+    if ((m->off = (long)lseek(pxfd, 0, SEEK_CUR)) < 0)
+        return (-1);
+
+    n = ifi + 1;
+    rc = put(pxfd, &n, sizeof(n));
+    for (k = 0; k <= ifi && !rc; k++) {
+        lv.file = pxlv[k];
+        lv.off = (k < ifi) ? offl[k] : ioff;
+        rc = put(pxfd, &lv, sizeof(lv));
+    }
+    if (rc || pxsave(pxfd, pxpiece) || sgdevput(pxfd))
+        return (-1);
+    npxm++;
+    return (0);
+}
+
+/* A page has begun since the last checkpoint: take one if this is a place for it */
+void pxpoint(void) {
+    if (!pxsafe())
+        return;
+    pxpages = pagesout;
+    if (pjleft)
+        pjplace(); /* -J: where a checkpoint would be taken, and perhaps a segment ends */
+    else if (pxmark() < 0)
+        pxquit();
+}
+
+/*
+ * pxstate - Write the whole formatter state at a checkpoint place
+ *
+ * The input levels by file name and offset, the file arguments left,
+ * what pxsave() writes with every piece whole, and the device's part.
+ * Two places with the same bytes format the same from there on; -J
+ * compares them.  Returns 0, or -1 if a write failed.
+ */
+int pxstate(int fd) {
+    char name[PXNAME];
+    int k, n;
+
+    n = ifi + 1;
+    if (put(fd, &n, sizeof(n)) || put(fd, &rargc, sizeof(rargc)))
+        return (-1);
+    for (k = 0; k <= ifi; k++) {
+        memset(name, 0, sizeof(name));
+        if ((k < pxlvmax) && (pxlv[k] >= 0))
+            strcpy(name, pxf[pxlv[k]].name);
+        n = (k < ifi) ? offl[k] : ioff;
+        if (put(fd, name, sizeof(name)) || put(fd, &n, sizeof(n)))
+            return (-1);
+    }
+    return ((pxsave(fd, NULL) || sgdevput(fd)) ? -1 : 0);
+}
+
+/* Write the tables and the header, and put the index in place unless the run failed */
+void pxdone(int x) {
+    struct pxhdr h;
+    long tail;
+    int rc;
+
+    if (pxfd < 0)
+        return;
+    pxon = 0;
+    pxhead(&h);
+    h.tail = tail = (long)lseek(pxfd, 0, SEEK_END);
+    h.nfile = npxf;
+    h.nmark = npxm;
+    rc = (tail < 0) || put(pxfd, pxf, npxf * sizeof(*pxf)) ||
+         put(pxfd, pxm, npxm * sizeof(*pxm)) || (lseek(pxfd, 0, SEEK_SET) != 0) ||
+         put(pxfd, &h, sizeof(h));
+    if ((close(pxfd) < 0) || rc || x || (npxm == 0) || (rename(pxtmp, pxfile) < 0))
+        unlink(pxtmp);
+    pxfd = -1;
+}
+
+/*
+ * Restore checkpoint m of the index, taken when file[k] had been read
+ * for each k below m->nfile.  Everything is checked, and the files
+ * opened, before any state is touched.
+ *
+ * Returns 0 if the formatter resumes at m, -1 if it must start afresh.
+ */
+static int pxresume(const struct pxmark *m, const struct pxfile *file, const char *e) {
+    const char *p, *q;
+    struct pxlev lv;
+    int *fd, *off, k, nlev;
+    long n;
+
+    p = pxmap + m->off;
+    if ((m->off < (long)sizeof(struct pxhdr)) || (m->off & 3) || (p > e) ||
+        ((size_t)(e - p) < sizeof(nlev)))
+        return (-1);
+    memcpy(&nlev, p, sizeof(nlev));
+    p += sizeof(nlev);
+    if ((nlev < 1) || ((size_t)nlev > (size_t)(e - p) / sizeof(lv)) || (m->rargc < 0) ||
+        (m->rargc > rargc))
+        return (-1);
+    q = p + nlev * sizeof(lv);
+    if (((n = pxrestore(q, e, pxget, 0)) < 0) || (sgdevget(q + n, e, 0) < 0) ||
+        (pjobs && (grow(&pxf, &pxfmax, m->nfile, sizeof(*pxf)) ||
+                   grow(&pxlv, &pxlvmax, nlev, sizeof(*pxlv)))))
+        return (-1);
+
+    if ((fd = OSA_MALLOC(nlev * sizeof(int))) == NULL || (off = OSA_MALLOC(nlev * sizeof(int))) == NULL) {
+        OSA_FREE(fd);
+        return (-1);
+    }
+    for (k = 0; k < nlev; k++) {
+        memcpy(&lv, p + k * sizeof(lv), sizeof(lv));
+        if ((lv.file < 0) || (lv.file >= m->nfile) || (lv.off < 0) ||
+            ((fd[k] = open(file[lv.file].name, O_RDONLY)) < 0)) {
+            while (--k >= 0)
+                close(fd[k]);
+            OSA_FREE(fd);
+            OSA_FREE(off);
+            return (-1);
+        }
+        off[k] = lv.off;
+    }
+
+    if ((pxrestore(q, e, pxget, 1) < 0) || (soresume(nlev, fd, off) < 0)) {
+        prstr("Cannot resume from the page index.\n");
+        done3(02);
+    }
+    if (pjobs) { /* the device as it was, and the files, for pxsafe() and pxstate() */
+        sgdevget(q + n, e, 1);
+        if (m->nfile)
+            memcpy(pxf, file, m->nfile * sizeof(*pxf));
+        npxf = m->nfile;
+        for (k = 0; k < nlev; k++) {
+            memcpy(&lv, p + k * sizeof(lv), sizeof(lv));
+            pxlv[k] = lv.file;
+        }
+    }
+    ejl = frame;
+    argp += rargc - m->rargc;
+    rargc = m->rargc;
+    mflg = stdi = 0;
+    if (dateset)
+        cvtime(); /* today's date, not that of the indexing run */
+    getmap();
+    lgflush();
+    capstart();
+    OSA_FREE(fd);
+    OSA_FREE(off);
+    return (0);
+}
+
+/*
+ * pxload - Resume from the index for -o, or set out to write one
+ *
+ * Called once the options are read, before any input.  An index is
+ * written by any -X run that finds it missing or stale.  With -J and
+ * a good index, pjcut() forks the segments and the child for each
+ * resumes at its checkpoint here.
+ *
+ * Returns 1 if the formatter now resumes at a checkpoint.
+ */
+int pxload(void) {
+    struct pxhdr h, want;
+    const struct pxfile *file;
+    const struct pxmark *mk;
+    struct stat st;
+    int fd, k, ok, rc;
+
+    if (!pxfile || bsuffix || dsock)
+        return (0);
+    snapbase();
+    pnmax = v.pn;
+    pxon = 1;
+    if ((fd = open(pxfile, O_RDONLY)) < 0)
+        return (0);
+    if ((fstat(fd, &st) < 0) || (st.st_size < (off_t)sizeof(h)) ||
+        ((pxmap = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)) == MAP_FAILED)) {
+        close(fd);
+        pxmap = NULL;
+        return (0);
+    }
+    close(fd);
+    pxmapn = (size_t)st.st_size;
+
+    rc = 0;
+    memcpy(&h, pxmap, sizeof(h));
+    pxhead(&want);
+    want.tail = h.tail;
+    want.nfile = h.nfile;
+    want.nmark = h.nmark;
+    if ((memcmp(&h, &want, sizeof(h)) != 0) || (h.tail < (long)sizeof(h)) || (h.nfile < 0) ||
+        (h.nmark < 0) || ((size_t)h.tail > pxmapn) ||
+        ((size_t)h.nfile > (pxmapn - h.tail) / sizeof(*file)) ||
+        (pxmapn - h.tail - h.nfile * sizeof(*file) != h.nmark * sizeof(*mk)))
+        goto out;
+    file = (const struct pxfile *)(pxmap + h.tail);
+    mk = (const struct pxmark *)(file + h.nfile);
+
+    /* The files read first and still as they were */
+    for (ok = 0; ok < h.nfile; ok++)
+        if (memchr(file[ok].name, 0, PXNAME) == NULL || (stat(file[ok].name, &st) < 0) ||
+            !S_ISREG(st.st_mode) || (file[ok].dev != (long)st.st_dev) ||
+            (file[ok].ino != (long)st.st_ino) || (file[ok].size != (long)st.st_size) ||
+            (file[ok].mtime != (long)st.st_mtime))
+            break;
+    if (ok == h.nfile)
+        pxon = 0; /* the index is good as it is */
+
+    /* With -o, the last checkpoint before the first page to print */
+    if (!print && (pfrom > 0) && (pnlist[0] != -1)) {
+        for (k = h.nmark - 1; k >= 0; k--)
+            if ((mk[k].maxpn < pfrom) && (mk[k].nfile <= ok))
+                break;
+        if ((k >= 0) && (pxresume(&mk[k], file, pxmap + h.tail) == 0)) {
+            pxon = 0;
+            rc = 1;
+        }
+    } else if (!pxon && ((k = pjcut(h.nmark)) >= 0)) {
+        /* With -J, the segment of this child; the first one starts afresh */
+        pjenter(pxresume(&mk[k], file, pxmap + h.tail));
+        rc = 1;
+    }
+out:
+    munmap((void *)pxmap, pxmapn);
+    pxmap = NULL;
+    return (rc);
+}
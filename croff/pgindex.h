@@ -0,0 +1,35 @@
+/* C17 - no scaffold needed */
+/*
+ * pgindex.h - Page checkpoints for -o, kept in a -X index
+ *
+ * PXPOINT() is the one test the main loop makes for each input line: a
+ * page begun since the last checkpoint makes pxpoint() see whether the
+ * formatter is at a place one can be taken.  Under -J the same places
+ * are counted to find where a segment ends.
+ */
+
+#ifndef PGINDEX_H
+#define PGINDEX_H
+
+#include <stddef.h>
+
+extern char *pxfile; /* -X index, NULL if there is none */
+extern int pxon; /* checkpoints are being taken */
+extern long pxpages; /* pagesout at the last checkpoint */
+extern long pagesout;
+extern int pjleft; /* -J: checkpoint places until this segment ends */
+
+void pxarg(const char *a);
+void pxinput(int lev, const char *name, int fd);
+int pxload(void);
+void pxpoint(void);
+void pxdone(int x);
+int pxquiet(void);
+int pxstate(int fd);
+int pxsave(int fd, int (*piece)(int fd, int key, const void *buf, size_t n));
+long pxrestore(const char *p, const char *e,
+               const void *(*piece)(const char **pp, const char *e, size_t n), int apply);
+
+#define PXPOINT() ((pxon || pjleft) && (pagesout != pxpages) ? pxpoint() : (void)0)
+
+#endif /* PGINDEX_H */
@@ -0,0 +1,311 @@
+/* C17 - no scaffold needed */
+/*
+ * pjob.c - Pages formatted in parallel from the -X index, with -J
+ *
+ * -J<n> cuts a document into n segments at checkpoints of a good -X
+ * index, as even in number of checkpoints as they fall, and formats
+ * them at once, a child each; -J alone makes one per processor.  The
+ * first child starts at the beginning.  Each of the others resumes at
+ * the checkpoint its segment starts at, the device's part-written line
+ * with it, and writes the whole state it resumed with (pxstate()).
+ * That state is only a prediction, made by an earlier run.
+ *
+ * A child formats on to the place where the next segment starts, which
+ * it finds by counting the places where a checkpoint would be taken,
+ * and writes its own state there.  If that is the state the next child
+ * resumed with, the next child's output is right and this one stops.
+ * If not, the next segment was mispredicted: this child formats it as
+ * well, on to the start of the one after, where it checks again.  So
+ * only a mispredicted segment is formatted twice, the second time from
+ * its true entry state, and whichever child runs on to the end of the
+ * document finishes it through done().
+ *
+ * Each child writes its output and its diagnostics to files of its
+ * own.  The parent copies them out in order for the segments whose
+ * output stands, stops the children whose segments were formatted over
+ * again, and exits with the worst status of those it kept.  The output
+ * is the same as without -J.  A .sy or .pi in a segment formatted twice
+ * runs twice.
+ *
+ * Without a good index -J does nothing, and the run writes the index
+ * for the next one.  -J is not for -o, -I or -R.
+ */
+
+#include "tdef.h" // troff definitions
+#include "troff_processor.h" // processor state
+#include "pgindex.h" // pxstate()
+#include "segcache.h" // -R
+#include "diag.h" // -Q diagnostics
+#include "pjob.h"
+#define OSA_TAG "croff.pjob"
+#include "os/os_acct.h" // OSA_MALLOC, OSA_FREE, OSA_READ, ...
+
+#include <errno.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#define PJBLK 8192 /* bytes compared or copied at a time */
+
+/* A segment, and the child formatting it */
+struct pjseg {
+    int mark; /* checkpoint it starts at, -1 for the beginning */
+    pid_t pid;
+    int out; /* its output */
+    int err; /* its diagnostics */
+    int ent; /* the state it resumed with */
+    int rdy[2]; /* a byte once ent is written: 'y', or 'n' if it did not resume */
+    int end[2]; /* the last segment its output covers, if it stopped */
+};
+
+extern int ptid;
+extern int ttyod;
+extern int error;
+extern int ipflg;
+extern int pnlist[];
+
+int bcopytmp(void);
+void flusho(void);
+void obwait(void);
+void obfork(void);
+void prstr(const char *s);
+
+int pjobs; /* -J */
+int pjleft; /* places until the next segment starts */
+
+static struct pjseg *pjs;
+static int npjs;
+static int pjme; /* the segment this child started */
+static int pjnext; /* the segment whose start it is going to */
+static int pjtmp = -1; /* its own state there */
+
+/* -J[n] */
+void pjarg(const char *a) {
+    for (pjobs = 0; *a >= '0' && *a <= '9'; a++)
+        pjobs = 10 * pjobs + *a - '0';
+    if (pjobs < 1 && (pjobs = (int)sysconf(_SC_NPROCESSORS_ONLN)) < 1)
+        pjobs = 1;
+}
+
+/* A scratch file of this process's, already unlinked */
+static int pjtemp(void) {
+    char tmp[] = "/tmp/tjXXXXXX";
+    int fd;
+
+    if ((fd = mkstemp(tmp)) >= 0)
+        unlink(tmp);
+    return (fd);
+}
+
+static void pjclose(int *fd) {
+    if (*fd >= 0)
+        close(*fd);
+    *fd = -1;
+}
+
+/* Wait for the child pid; its status, 01 if it did not exit */
+static int pjwait(pid_t pid) {
+    int status;
+
+    while (waitpid(pid, &status, 0) < 0)
+        if (errno != EINTR)
+            return (01);
+    return (WIFEXITED(status) ? WEXITSTATUS(status) : 01);
+}
+
+/* Copy the whole of the file from to the descriptor to */
+static void pjcopy(int from, int to) {
+    char buf[PJBLK];
+    ssize_t n, w, k;
+    off_t at;
+
+    for (at = 0; (n = OSA_PREAD(from, buf, sizeof(buf), at)) > 0; at += n)
+        for (w = 0; w < n; w += k)
+            if ((k = OSA_WRITE(to, buf + w, (size_t)(n - w))) <= 0)
+                return;
+}
+
+/* Whether the state here is the one segment p resumed with */
+static int pjsame(struct pjseg *p) {
+    char a[PJBLK], b[PJBLK], c;
+    struct stat st;
+    off_t n, at;
+    size_t k;
+
+    if ((OSA_READ(p->rdy[0], &c, 1) != 1) || (c != 'y') || (fstat(p->ent, &st) < 0))
+        return (0);
+    if ((pjtmp < 0) && ((pjtmp = pjtemp()) < 0))
+        return (0);
+    if ((ftruncate(pjtmp, 0) < 0) || (lseek(pjtmp, 0, SEEK_SET) != 0) || (pxstate(pjtmp) < 0) ||
+        ((n = lseek(pjtmp, 0, SEEK_CUR)) != st.st_size))
+        return (0);
+    for (at = 0; at < n; at += (off_t)k) {
+        k = (n - at < PJBLK) ? (size_t)(n - at) : PJBLK;
+        if ((OSA_PREAD(pjtmp, a, k, at) != (ssize_t)k) || (OSA_PREAD(p->ent, b, k, at) != (ssize_t)k) ||
+            (memcmp(a, b, k) != 0))
+            return (0);
+    }
+    return (1);
+}
+
+/* In child s: keep what it uses of the segments, and format into its files */
+static int pjchild(int s) {
+    struct pjseg *p;
+    int k;
+
+    obfork();
+    if (bcopytmp() < 0)
+        _exit(02);
+    for (k = 0; k < npjs; k++) {
+        p = &pjs[k];
+        if (k != s) {
+            pjclose(&p->out);
+            pjclose(&p->err);
+            pjclose(&p->rdy[1]);
+            pjclose(&p->end[1]);
+        }
+        if (k <= s)
+            pjclose(&p->rdy[0]);
+        if (k < s)
+            pjclose(&p->ent);
+        pjclose(&p->end[0]);
+    }
+    ptid = pjs[s].out;
+    ttyod = pjs[s].err;
+    pjme = s;
+    pjnext = s + 1;
+    pjleft = (pjnext < npjs) ? pjs[pjnext].mark - pjs[s].mark : 0;
+    return (pjs[s].mark);
+}
+
+/*
+ * pjcut - Fork a child for each segment of an index of nmark checkpoints
+ *
+ * Returns in each child the checkpoint its segment starts at, -1 for
+ * the first.  The parent does not return once a child is running; it
+ * returns -2 if -J does not apply or nothing could be forked, for the
+ * run to go on as it would without -J.
+ */
+int pjcut(int nmark) {
+    struct pjseg *p;
+    pid_t pid;
+    int j, k, n, s, nrun, worst;
+
+    if ((pjobs < 2) || (nmark < 1) || ipflg || sgdir || (pnlist[0] != -1))
+        return (-2);
+    n = (pjobs < nmark + 1) ? pjobs : nmark + 1;
+    if ((pjs = OSA_MALLOC(n * sizeof(*pjs))) == NULL)
+        return (-2);
+    for (s = 0; s < n; s++) {
+        p = &pjs[s];
+        p->mark = s * (nmark + 1) / n - 1;
+        p->pid = 0;
+        p->out = p->err = p->ent = p->rdy[0] = p->rdy[1] = p->end[0] = p->end[1] = -1;
+    }
+    for (s = 0; s < n; s++) {
+        p = &pjs[s];
+        if (((p->out = pjtemp()) < 0) || ((p->err = pjtemp()) < 0) ||
+            ((p->ent = pjtemp()) < 0) || (pipe(p->rdy) < 0) || (pipe(p->end) < 0))
+            break;
+    }
+    npjs = n;
+
+    /* Whatever start-up wrote goes out once, from here */
+    if (s == n) {
+        if (g_processor.outputPtr != g_processor.outputBuffer)
+            flusho();
+        else
+            obwait();
+        dgflush();
+    }
+    for (nrun = 0; (s == n) && (nrun < n); nrun++) {
+        if ((pid = fork()) < 0) {
+            prstr("Cannot fork.\n");
+            break;
+        }
+        if (pid == 0)
+            return (pjchild(nrun));
+        pjs[nrun].pid = pid;
+    }
+    for (s = 0; s < n; s++) {
+        p = &pjs[s];
+        pjclose(&p->rdy[0]);
+        pjclose(&p->rdy[1]);
+        pjclose(&p->end[1]);
+        if (!nrun) {
+            pjclose(&p->out);
+            pjclose(&p->err);
+            pjclose(&p->ent);
+            pjclose(&p->end[0]);
+        }
+    }
+    if (!nrun) {
+        OSA_FREE(pjs);
+        pjs = NULL;
+        return (-2);
+    }
+
+    /* The segments in order: each child's output up to where it stopped */
+    worst = 0;
+    for (s = 0; s < nrun; s = k + 1) {
+        p = &pjs[s];
+        if ((OSA_READ(p->end[0], &k, sizeof(k)) != sizeof(k)) || (k < s) || (k >= nrun))
+            k = nrun - 1; /* it ran on to the end */
+        worst |= pjwait(p->pid);
+        pjcopy(p->out, ptid);
+        pjcopy(p->err, ttyod);
+        for (j = s + 1; j <= k; j++) {
+            kill(pjs[j].pid, SIGKILL);
+            pjwait(pjs[j].pid);
+        }
+    }
+    exit(worst);
+}
+
+/*
+ * pjenter - A child has resumed at its checkpoint, if rc is 0
+ *
+ * Writes the state it resumed with for the child before it to check,
+ * or, if it could not resume, tells that child to format on.
+ */
+void pjenter(int rc) {
+    struct pjseg *p = &pjs[pjme];
+    char c;
+
+    c = ((rc == 0) && (pxstate(p->ent) == 0)) ? 'y' : 'n';
+    if ((OSA_WRITE(p->rdy[1], &c, 1) != 1) || (c != 'y'))
+        _exit(02);
+    pjclose(&p->rdy[1]);
+}
+
+/*
+ * pjplace - A place where a checkpoint would be taken
+ *
+ * At the start of the next segment, this child stops if its state is
+ * the one that segment resumed with, and formats on otherwise.
+ */
+void pjplace(void) {
+    struct pjseg *p;
+    int k;
+
+    if (--pjleft > 0)
+        return;
+    p = &pjs[pjnext];
+    if (pjsame(p)) {
+        flusho();
+        obwait();
+        dgflush();
+        k = pjnext - 1;
+        if (OSA_WRITE(pjs[pjme].end[1], &k, sizeof(k)) != sizeof(k))
+            _exit(02);
+        _exit(error);
+    }
+    pjclose(&p->ent);
+    pjclose(&p->rdy[0]);
+    pjnext++;
+    pjleft = (pjnext < npjs) ? pjs[pjnext].mark - p->mark : 0;
+}
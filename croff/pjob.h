@@ -0,0 +1,22 @@
+/* C17 - no scaffold needed */
+/*
+ * pjob.h - Pages formatted in parallel from the -X index, with -J
+ *
+ * pjcut() forks the segments once pxload() has found the index good;
+ * pjenter() is told whether a child resumed at its checkpoint, and
+ * pjplace() is called at each place after it where a checkpoint would
+ * be taken, while pjleft says a segment ends at one of them.
+ */
+
+#ifndef PJOB_H
+#define PJOB_H
+
+extern int pjobs; /* -J: segments formatted at once, 0 without -J */
+extern int pjleft; /* checkpoint places until this segment ends, 0 if it runs on */
+
+void pjarg(const char *a);
+int pjcut(int nmark);
+void pjenter(int rc);
+void pjplace(void);
+
+#endif /* PJOB_H */
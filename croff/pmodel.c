@@ -0,0 +1,361 @@
+/* C17 - no scaffold needed */
+/*
+ * pmodel.c - Pages held as a model, put out whole, for croff -G
+ *
+ * -G keeps each page as a list of runs: the items of a line, with the
+ * motion that leads the line taken out as its place on the page.  A
+ * page is put out through the driver once the next one begins, or the
+ * document ends, and the arena it was built in is then reset.  Put out
+ * as they came, the runs make the bytes the driver would have made line
+ * by line.
+ *
+ * -Gn puts n pages side by side, each as far right of the one before as
+ * the widest of them and two columns more; the runs of the n pages then
+ * go out top to bottom, left to right.  -Gr holds every page to the end
+ * and puts them out last first.  -G2r does both.
+ *
+ * nroff draws rules with characters, so a rule is a run like the rest.
+ * A stop (-s, .rd) comes before the page it came before.  Under -I the
+ * option does nothing, and a document formatted with it takes no -X
+ * checkpoints and caches no -R segments, since their output is not
+ * written as the pages are formatted.
+ */
+
+#include "tdef.h"
+#include "pmodel.h"
+#define OSA_TAG "croff.pmodel"
+#include "os/os_acct.h" /* OSA_MALLOC, OSA_READ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifndef TWSTATE
+#define TWSTATE /* as in n10.c */
+#endif
+
+#define PMCHUNK 65536 /* bytes in a piece of the arena */
+#define PMALIGN 8
+
+extern TWSTATE int lead;
+extern TWSTATE int esc;
+extern TWSTATE int ulfont;
+
+extern void ptdown(int down, int row);
+extern void ptrun(const int *q, int n, int h, int ul);
+extern void ptnl(void);
+extern int ptspan(const int *q, int n, int *drift);
+extern void flusho(void);
+extern void prstr(const char *s);
+
+int pmflg; /* -G: pages go out through the model */
+
+/* A piece of the arena */
+struct pmchunk {
+    struct pmchunk *next;
+    size_t size, used;
+    _Alignas(PMALIGN) char mem[];
+};
+
+static struct pmchunk *pmfirst, *pmat; /* pieces, and the one in use */
+static int pmup = 1; /* pages side by side */
+static int pmrev; /* last page first */
+static struct pmpage *pmcur; /* the page being built */
+static int pmv; /* where it has got to */
+static struct pmpage *pmheld, **pmtail = &pmheld; /* pages complete, in the order they go */
+static int nheld;
+static int pmstopped; /* a stop before the next page */
+static int pmlost; /* the arena ran out */
+
+/* -G[n][r] */
+void pmarg(const char *a) {
+    int n = 0;
+
+    pmflg = 1;
+    for (; *a >= '0' && *a <= '9'; a++)
+        n = 10 * n + *a - '0';
+    if (n > 0)
+        pmup = n;
+    if (*a == 'r')
+        pmrev = 1;
+}
+
+/* n bytes of the arena, or NULL */
+static void *pmalloc(size_t n) {
+    struct pmchunk *c;
+    size_t size;
+
+    n = (n + PMALIGN - 1) & ~(size_t)(PMALIGN - 1);
+    for (c = pmat; c != NULL; c = c->next) {
+        if (c->size - c->used >= n) {
+            pmat = c;
+            c->used += n;
+            return (c->mem + c->used - n);
+        }
+        if (c->next != NULL)
+            c->next->used = 0; /* left from before the last reset */
+    }
+    size = (n > PMCHUNK) ? n : PMCHUNK;
+    if ((c = OSA_MALLOC(sizeof(*c) + size)) == NULL)
+        return (NULL);
+    c->next = NULL;
+    c->size = size;
+    c->used = n;
+    if (pmat != NULL) {
+        while (pmat->next != NULL)
+            pmat = pmat->next;
+        pmat->next = c;
+    } else {
+        pmfirst = c;
+    }
+    pmat = c;
+    return (c->mem);
+}
+
+/* Start the arena over: every page in it is out */
+static void pmreset(void) {
+    if ((pmat = pmfirst) != NULL)
+        pmat->used = 0;
+    pmheld = NULL;
+    pmtail = &pmheld;
+    nheld = 0;
+}
+
+static void *pmnomem(void) {
+    if (!pmlost++)
+        prstr("Out of memory for the page model.\n");
+    return (NULL);
+}
+
+/* The page being built, begun if need be */
+static struct pmpage *pmpg(void) {
+    struct pmpage *p;
+
+    if (pmcur != NULL)
+        return (pmcur);
+    if ((p = pmalloc(sizeof(*p))) == NULL)
+        return (pmnomem());
+    memset(p, 0, sizeof(*p));
+    p->tail = &p->runs;
+    p->stop = pmstopped;
+    pmstopped = 0;
+    pmv = 0;
+    return (pmcur = p);
+}
+
+/*
+ * ptout() at a newline: the n items at q go down from where the last
+ * line left off.  A line with no items moves down a line, as the driver
+ * makes it.
+ */
+void pmline(const int *q, int n, int down) {
+    struct pmpage *p;
+    struct pmrun *r;
+    int h, c, k;
+
+    if ((p = pmpg()) == NULL)
+        return;
+    if (n == 0) {
+        pmv += t.Newline;
+        return;
+    }
+    for (h = k = 0; k < n; k++) {
+        if (q[k] & MOT) {
+            if (q[k] & VMOT)
+                break;
+            h += (q[k] & NMOT) ? -(q[k] & ~MOTV) : (q[k] & ~MOTV);
+        } else if ((c = q[k] & CMASK) <= 040) {
+            if (c == ' ')
+                h += t.Char;
+        } else {
+            break;
+        }
+    }
+    if ((r = pmalloc(sizeof(*r) + (size_t)(n - k) * sizeof(int))) == NULL) {
+        pmnomem();
+        return;
+    }
+    r->next = NULL;
+    r->v = pmv + down;
+    r->h = h;
+    r->ul = ulfont;
+    r->n = n - k;
+    memcpy(r->item, q + k, (size_t)r->n * sizeof(int));
+    r->right = ptspan(r->item, r->n, &r->drift);
+    *p->tail = r;
+    p->tail = &r->next;
+    if (h + r->right > p->right)
+        p->right = h + r->right;
+    pmv = r->v + r->drift + t.Newline;
+}
+
+/*
+ * ptlead(): the pending motion, which nroff makes down only, is a run
+ * of no items, made from where the last line ended
+ */
+void pmlead(void) {
+    struct pmpage *p;
+    struct pmrun *r;
+
+    if ((p = pmpg()) != NULL) {
+        if ((r = pmalloc(sizeof(*r))) == NULL) {
+            pmnomem();
+        } else {
+            memset(r, 0, sizeof(*r));
+            r->v = pmv + lead;
+            r->n = -1;
+            *p->tail = r;
+            p->tail = &r->next;
+            pmv = r->v;
+        }
+    }
+    lead = esc = 0;
+}
+
+/* dostop() */
+void pmstop(void) {
+    pmstopped = 1;
+}
+
+/* Where the runs of a group go out, in order */
+struct pmslot {
+    struct pmrun *r;
+    int h; /* its own and its page's */
+    int seq;
+};
+
+static int pmcmp(const void *a, const void *b) {
+    const struct pmslot *x = a, *y = b;
+
+    if (x->r->v != y->r->v)
+        return ((x->r->v < y->r->v) ? -1 : 1);
+    if (x->h != y->h)
+        return ((x->h < y->h) ? -1 : 1);
+    return ((x->seq < y->seq) ? -1 : (x->seq > y->seq));
+}
+
+/* Wait at a stop, as dostop() does */
+static void pmwait(void) {
+    int junk;
+
+    flusho();
+    if (OSA_READ(2, (char *)&junk, 1) < 0)
+        return;
+}
+
+/*
+ * Put out the m pages from p side by side: each row of runs at one
+ * place goes out left to right, and the rows top to bottom.  A single
+ * page goes out in the order its runs came, as the driver made them;
+ * pages side by side leave out the motion ptlead() made.
+ */
+static void pmgroup(struct pmpage *p, int m) {
+    struct pmslot *s;
+    struct pmpage *q;
+    struct pmrun *r;
+    int n, k, j, w, off, end, pos, stop;
+    const struct pmrun *last;
+
+    n = end = w = stop = 0;
+    for (q = p, k = 0; k < m; q = q->next, k++) {
+        for (r = q->runs; r != NULL; r = r->next)
+            n += (m == 1) || (r->n >= 0);
+        if (q->right > w)
+            w = q->right;
+        if (q->end > end)
+            end = q->end;
+        stop |= q->stop;
+    }
+    if (stop)
+        pmwait();
+    if ((s = pmalloc((size_t)(n ? n : 1) * sizeof(*s))) == NULL) {
+        pmnomem();
+        return;
+    }
+    w = (w + t.Em - 1) / t.Em * t.Em + 2 * t.Em;
+    for (q = p, j = k = 0, off = 0; k < m; q = q->next, k++, off += w)
+        for (r = q->runs; r != NULL; r = r->next)
+            if ((m == 1) || (r->n >= 0)) {
+                s[j].r = r;
+                s[j].h = off + r->h;
+                s[j].seq = j;
+                j++;
+            }
+    if (m > 1)
+        qsort(s, n, sizeof(*s), pmcmp);
+    pos = 0;
+    last = NULL;
+    for (j = 0; j < n; j++) {
+        r = s[j].r;
+        if (r->n < 0) { /* from where the last line ended */
+            ptdown(r->v - pos, 0);
+            pos = r->v;
+            continue;
+        }
+        if ((m > 1) && (last != NULL) && (last->v == r->v)) {
+            ptdown(-last->drift, 0);
+        } else {
+            ptdown(r->v - pos, 1);
+        }
+        ptrun(r->item, r->n, s[j].h, r->ul);
+        last = r;
+        if ((j + 1 == n) || (s[j + 1].r->v != r->v) || (m == 1)) {
+            ptnl();
+            pos = r->v + r->drift + t.Newline;
+        }
+    }
+    ptdown(end - pos, 1);
+}
+
+/* Put out the pages held, a group at a time, and reset the arena */
+static void pmflush(void) {
+    struct pmpage *p, *q;
+    int k;
+
+    for (p = pmheld; p != NULL; p = q) {
+        for (q = p, k = 0; (q != NULL) && (k < pmup); q = q->next)
+            k++;
+        pmgroup(p, k);
+    }
+    pmreset();
+}
+
+/* The page being built is complete */
+static void pmclose(void) {
+    struct pmpage *p;
+
+    if ((p = pmpg()) == NULL)
+        return;
+    p->end = pmv;
+    pmcur = NULL;
+    if (pmrev) {
+        p->next = pmheld;
+        pmheld = p;
+    } else {
+        p->next = NULL;
+        *pmtail = p;
+        pmtail = &p->next;
+    }
+    if (++nheld >= pmup && !pmrev)
+        pmflush();
+}
+
+/* A new page begins */
+void pmpage(void) {
+    pmclose();
+}
+
+/* The document ends: put out what is left */
+void pmdone(void) {
+    if (!pmflg)
+        return;
+    if (pmcur != NULL)
+        pmclose();
+    if (pmstopped) {
+        pmwait();
+        pmstopped = 0;
+    }
+    if (pmheld != NULL)
+        pmflush();
+}
@@ -0,0 +1,44 @@
+/* C17 - no scaffold needed */
+/*
+ * pmodel.h - The page model of croff -G
+ *
+ * With -G the terminal driver does not put each line out as it comes:
+ * the lines of a page are kept as runs, each at its place on the page,
+ * and the page is put out through the driver once it is complete.  All
+ * of it lives in one arena, reset once the pages held are out.
+ */
+
+#ifndef PMODEL_H
+#define PMODEL_H
+
+/* A line on a page: its items, once the motion that leads it is taken out */
+struct pmrun {
+    struct pmrun *next;
+    int v; /* down from the top of the page */
+    int h; /* right from the left edge */
+    int drift; /* vertical motion the items leave behind */
+    int ul; /* underline font when it came */
+    int right; /* where the items end */
+    int n;
+    int item[]; /* as oline[] holds them */
+};
+
+/* A page: its runs as they came, then where it ends */
+struct pmpage {
+    struct pmpage *next;
+    struct pmrun *runs, **tail;
+    int end; /* position at the end of the page */
+    int right; /* where its widest run ends */
+    int stop; /* a stop comes before it */
+};
+
+extern int pmflg; /* -G: pages go out through the model */
+
+void pmarg(const char *a);
+void pmline(const int *q, int n, int down);
+void pmlead(void);
+void pmstop(void);
+void pmpage(void);
+void pmdone(void);
+
+#endif /* PMODEL_H */
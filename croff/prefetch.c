@@ -0,0 +1,103 @@
+/* C17 - no scaffold needed */
+/*
+ * prefetch.c - Read the next input file while this one is formatted
+ *
+ * When nextfile() opens a file from the command line and another one
+ * follows it, pfstart() opens that one as well and queues a read of its
+ * first PFSIZE bytes on the asynchronous queue of the OS layer, so the
+ * formatter does not wait on the disk when it gets there.  pftake()
+ * hands nextfile() the descriptor once the read is in.  With -B the
+ * parent prefetches each document as it forks the one before, while
+ * the children format; a child forgets the queue it inherited
+ * (pfdrop()).
+ *
+ * What is read is only there to bring the file into memory: mapin()
+ * still maps it, or getch0() reads it, from the start.  Whatever
+ * fails leaves the file to be opened as usual.
+ */
+
+#include "os/os_abstraction.h" // os_aio_*
+#define OSA_TAG "croff.input"
+#include "os/os_acct.h" // OSA_MALLOC, OSA_FREE
+
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define PFSIZE (256 * 1024) /* bytes read ahead of each file */
+
+static os_aio_t *pfq; /* the queue, made on first use */
+static int pfoff; /* no queue to be had */
+static char *pfbuf; /* PFSIZE bytes the read goes to */
+static const char *pfname; /* the file read ahead, or NULL */
+static int pffd = -1; /* and its descriptor */
+
+/* Wait for the read ahead of pfname to finish */
+static void pfwait(void) {
+    os_aio_done_t d;
+
+    while (os_aio_pending(pfq) > 0)
+        os_aio_reap(pfq, &d, 1);
+}
+
+/* Close a file read ahead that nobody took */
+static void pfclose(void) {
+    if (pffd < 0)
+        return;
+    pfwait();
+    close(pffd);
+    pffd = -1;
+    pfname = NULL;
+}
+
+/* Open name and start reading it in */
+void pfstart(const char *name) {
+    os_aio_req_t r;
+
+    if (pfoff || ((name[0] == '-') && (name[1] == 0)))
+        return;
+    if ((pfname != NULL) && (strcmp(pfname, name) == 0))
+        return;
+    pfclose();
+    if ((pfq == NULL) &&
+        (((pfbuf = OSA_MALLOC(PFSIZE)) == NULL) || ((pfq = os_aio_open(1, 0)) == NULL))) {
+        OSA_FREE(pfbuf);
+        pfbuf = NULL;
+        pfoff = 1;
+        return;
+    }
+    if ((pffd = open(name, O_RDONLY)) < 0)
+        return;
+    r.op = OS_AIO_READ;
+    r.fd = pffd;
+    r.buf = pfbuf;
+    r.len = PFSIZE;
+    r.offset = 0;
+    r.user = NULL;
+    os_aio_submit(pfq, &r);
+    pfname = name;
+}
+
+/* The descriptor of name if it was read ahead, else -1 */
+int pftake(const char *name) {
+    int fd;
+
+    if ((pfname == NULL) || (strcmp(pfname, name) != 0))
+        return (-1);
+    pfwait();
+    fd = pffd;
+    pffd = -1;
+    pfname = NULL;
+    return (fd);
+}
+
+/* In a child just forked: the queue and the file belong to the parent */
+void pfdrop(void) {
+    if (pffd >= 0)
+        close(pffd);
+    pffd = -1;
+    pfname = NULL;
+    pfq = NULL;
+    pfoff = 1;
+}
@@ -0,0 +1,311 @@
+/* C17 - no scaffold needed */
+/*
+ * prof.c - Per-request and per-macro profile for -S, start-up trace for -Z
+ *
+ * With -S every request dispatched by control() is counted and timed
+ * around its handler, and every macro invocation is timed from the
+ * pushi() of its frame until popi() leaves that frame again.  Both
+ * figures are inclusive: a macro's time covers the requests and macros
+ * it calls, and a request's time covers whatever it does before control
+ * returns to the input loop.
+ *
+ * At exit the entries are printed to stderr as a table sorted by total
+ * time, followed by the run's counters and then its CPU time, faults
+ * and context switches; -S<file> additionally writes them to <file> as
+ * JSON.  When -S is not given the hooks reduce to a test of profon.
+ *
+ * The counters are kept whether or not -S is given, an increment each,
+ * by the modules that own them: input bytes and getch() characters
+ * (n1.c), lines put out and pages (n7.c), words hyphenated (n8.c),
+ * flusho() calls (obuf.c) and environment switches (n5.c).  Reads and
+ * writes of the temp file and the peak of the macro store come from
+ * the block store's own figures.  Built with OSACCT, the report ends
+ * with the allocation and I/O of each subsystem and call site
+ * (os/os_acct.h), and the JSON has them as "sys".
+ */
+
+#include "tdef.h" // troff definitions
+#include "core/blkstore.h" // macro store figures
+#include "os/os_abstraction.h" // os_now_ns, os_rusage
+#define OSA_TAG "croff.prof"
+#include "os/os_acct.h" // OSA_CALLOC, OSA_REALLOC, OSA_FREE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROFMIN 256 /* initial profile table size, a power of two */
+#define PROFSTK 64 /* initial open-macro stack depth */
+
+/* Profile entry for one request or macro name */
+struct profent {
+    int name; /* two-character name, MMASK clear */
+    int mac; /* 1 for a macro, 0 for a request */
+    long calls;
+    long long ns; /* total time spent */
+};
+
+/* Macro invocation still running */
+struct profopen {
+    int ent; /* index into pt[] */
+    int lev; /* frame level of its body */
+    long long t0;
+};
+
+extern int frpeak;
+extern int nblkpeak;
+extern long widhit, widmiss;
+extern long hchit, hcmiss;
+extern long long inbytes, getchn;
+extern long linesout, pagesout;
+extern long hywords, hyphenated;
+extern long flushn;
+extern long evswitch;
+
+const otroff_blkstore_t *mstorep(void);
+
+int profon; /* -S given */
+char *proffile; /* -S<file>: JSON output, NULL for the table only */
+
+long long profnow(void);
+void profadd(int rq, long long ns);
+void profpush(int rq, int lev);
+void profpop(int lev);
+void profreport(void);
+void stphase(const char *name);
+void streport(void);
+
+static struct profent *pt; /* open-addressed by name and kind */
+static int ptsize, ptfill;
+static struct profopen *pstk;
+static int npstk, pstksize;
+
+/* Current time in nanoseconds */
+long long profnow(void) {
+    return ((long long)os_now_ns());
+}
+
+/*
+ * Start-up trace for -Z.  main() calls stphase() at the end of each
+ * phase of start-up, and streport() prints how long each one took just
+ * before the first input is read.  The marks are taken always, as they
+ * cost a clock read each; -Z is only known once the options are read.
+ */
+#define STMAX 16
+
+int ston; /* -Z given */
+
+static struct {
+    const char *name;
+    long long t;
+} stp[STMAX];
+static int nstp;
+
+void stphase(const char *name) {
+    if (nstp < STMAX) {
+        stp[nstp].name = name;
+        stp[nstp++].t = profnow();
+    }
+}
+
+void streport(void) {
+    int i;
+
+    if (!ston || nstp < 2)
+        return;
+    fprintf(stderr, "%-10s %10s\n", "phase", "us");
+    for (i = 1; i < nstp; i++)
+        fprintf(stderr, "%-10s %10.1f\n", stp[i].name, (stp[i].t - stp[i - 1].t) / 1e3);
+    fprintf(stderr, "%-10s %10.1f\n", "start-up", (stp[nstp - 1].t - stp[0].t) / 1e3);
+}
+
+static unsigned profslot(int name, int mac, int size) {
+    return (((unsigned)(name * 2 + mac) * 2654435761u) & (size - 1));
+}
+
+/* Find or create the entry for rq, -1 if out of memory */
+static int profent(int rq) {
+    struct profent *o;
+    int i, n, name, mac;
+    unsigned k;
+
+    name = rq & ~MMASK;
+    mac = (rq & MMASK) != 0;
+    if (2 * (ptfill + 1) > ptsize) {
+        n = ptsize ? 2 * ptsize : PROFMIN;
+        if ((o = OSA_CALLOC(n, sizeof(*o))) == NULL)
+            return (-1);
+        for (i = 0; i < ptsize; i++) {
+            if (!pt[i].name)
+                continue;
+            for (k = profslot(pt[i].name, pt[i].mac, n); o[k].name;
+                 k = (k + 1) & (n - 1))
+                ;
+            o[k] = pt[i];
+        }
+        OSA_FREE(pt);
+        pt = o;
+        ptsize = n;
+    }
+    for (k = profslot(name, mac, ptsize); pt[k].name;
+         k = (k + 1) & (ptsize - 1))
+        if (pt[k].name == name && pt[k].mac == mac)
+            return (k);
+    pt[k].name = name;
+    pt[k].mac = mac;
+    ptfill++;
+    return (k);
+}
+
+/* Charge one call of ns nanoseconds to request or macro rq */
+void profadd(int rq, long long ns) {
+    int k;
+
+    if ((k = profent(rq)) < 0)
+        return;
+    pt[k].calls++;
+    pt[k].ns += ns;
+}
+
+/* Macro rq has just been pushed as frame level lev */
+void profpush(int rq, int lev) {
+    struct profopen *s;
+    int k;
+
+    if ((k = profent(rq)) < 0)
+        return;
+    if (npstk == pstksize) {
+        if ((s = OSA_REALLOC(pstk, (pstksize ? 2 * pstksize : PROFSTK) *
+                                   sizeof(*s))) == NULL)
+            return;
+        pstk = s;
+        pstksize = pstksize ? 2 * pstksize : PROFSTK;
+    }
+    pt[k].calls++;
+    pstk[npstk].ent = k;
+    pstk[npstk].lev = lev;
+    pstk[npstk++].t0 = profnow();
+}
+
+/* Frame level lev is being left: close every macro at or above it */
+void profpop(int lev) {
+    long long t;
+
+    if (!npstk || pstk[npstk - 1].lev < lev)
+        return;
+    t = profnow();
+    while (npstk && pstk[npstk - 1].lev >= lev) {
+        npstk--;
+        pt[pstk[npstk].ent].ns += t - pstk[npstk].t0;
+    }
+}
+
+/* Order by total time, then by name */
+static int profcmp(const void *a, const void *b) {
+    const struct profent *x = a, *y = b;
+
+    if (x->ns != y->ns)
+        return (x->ns < y->ns ? 1 : -1);
+    return (x->name - y->name);
+}
+
+static void profname(char *s, int name) {
+    s[0] = name & BMASK;
+    s[1] = (name >> BYTE) & BMASK;
+    s[2] = 0;
+}
+
+/* Print the profile at exit */
+void profreport(void) {
+    const otroff_blkstore_t *st;
+    struct profent *e;
+    os_rusage_t ru;
+    FILE *fp;
+    char s[3];
+    long rd = 0, wr = 0, peak = 0;
+    long long blk = BLK * sizeof(int);
+    int i, n;
+
+    if (!profon)
+        return;
+    profpop(0);
+    n = 0;
+    for (i = 0; i < ptsize; i++)
+        if (pt[i].name)
+            pt[n++] = pt[i];
+    if (n)
+        qsort(pt, n, sizeof(*pt), profcmp);
+
+    fprintf(stderr, "%-4s %-7s %10s %12s %10s\n", "name", "kind", "calls",
+            "total ms", "avg us");
+    for (e = pt; e < pt + n; e++) {
+        profname(s, e->name);
+        fprintf(stderr, "%-4s %-7s %10ld %12.3f %10.2f\n", s,
+                e->mac ? "macro" : "request", e->calls, e->ns / 1e6,
+                e->calls ? e->ns / 1e3 / e->calls : 0.0);
+    }
+    fprintf(stderr, "frame peak %d, block peak %d\n", frpeak, nblkpeak);
+    fprintf(stderr, "width cache %ld hits, %ld misses\n", widhit, widmiss);
+    fprintf(stderr, "hyphenation cache %ld hits, %ld misses\n", hchit, hcmiss);
+    if ((st = mstorep()) != NULL) {
+        rd = (long)st->stats.spill_reads;
+        wr = (long)st->stats.spill_writes;
+        peak = (long)st->stats.resident_peak;
+    }
+    fprintf(stderr, "input %lld bytes, %lld characters through getch()\n", inbytes, getchn);
+    fprintf(stderr, "output %ld lines, %ld pages, %ld flushes\n", linesout, pagesout, flushn);
+    fprintf(stderr, "hyphenation %ld words, %ld with a break\n", hywords, hyphenated);
+    fprintf(stderr, "temp file %ld reads (%lld bytes), %ld writes (%lld bytes)\n", rd, rd * blk,
+            wr, wr * blk);
+    fprintf(stderr, "macro store peak %ld blocks in core (%lld KB); %ld environment switches\n",
+            peak, peak * blk / 1024, evswitch);
+    os_rusage(&ru);
+    fprintf(stderr, "cpu %.3f ms user, %.3f ms system; %ld KB peak; %ld+%ld faults; %ld+%ld switches\n",
+            ru.user_ns / 1e6, ru.sys_ns / 1e6, ru.peak_rss_kb, ru.minflt, ru.majflt, ru.nvcsw,
+            ru.nivcsw);
+    osa_report(stderr);
+
+    if (proffile && *proffile) {
+        if ((fp = fopen(proffile, "w")) == NULL) {
+            fprintf(stderr, "Cannot open %s\n", proffile);
+        } else {
+            fprintf(fp, "{\"frame_peak\":%d,\"block_peak\":%d,"
+                        "\"width_hits\":%ld,\"width_misses\":%ld,"
+                        "\"hyph_hits\":%ld,\"hyph_misses\":%ld,"
+                        "\"in_bytes\":%lld,\"getch\":%lld,\"lines\":%ld,\"pages\":%ld,"
+                        "\"flushes\":%ld,\"hyph_words\":%ld,\"hyphenated\":%ld,"
+                        "\"temp_reads\":%ld,\"temp_read_bytes\":%lld,"
+                        "\"temp_writes\":%ld,\"temp_write_bytes\":%lld,"
+                        "\"store_peak_blocks\":%ld,\"store_peak_bytes\":%lld,"
+                        "\"env_switches\":%ld,"
+                        "\"user_ns\":%llu,\"sys_ns\":%llu,\"peak_rss_kb\":%ld,"
+                        "\"minflt\":%ld,\"majflt\":%ld,\"nvcsw\":%ld,\"nivcsw\":%ld,",
+                    frpeak, nblkpeak, widhit, widmiss, hchit, hcmiss,
+                    inbytes, getchn, linesout, pagesout, flushn, hywords, hyphenated,
+                    rd, rd * blk, wr, wr * blk, peak, peak * blk, evswitch,
+                    (unsigned long long)ru.user_ns, (unsigned long long)ru.sys_ns,
+                    ru.peak_rss_kb, ru.minflt, ru.majflt, ru.nvcsw, ru.nivcsw);
+            osa_json(fp);
+            fprintf(fp, "\"entries\":[");
+            for (e = pt; e < pt + n; e++) {
+                profname(s, e->name);
+                fprintf(fp, "%s\n{\"name\":\"", e == pt ? "" : ",");
+                for (i = 0; s[i]; i++) {
+                    if (s[i] == '"' || s[i] == '\\')
+                        fprintf(fp, "\\%c", s[i]);
+                    else if ((unsigned char)s[i] < ' ')
+                        fprintf(fp, "\\u%04x", s[i]);
+                    else
+                        putc(s[i], fp);
+                }
+                fprintf(fp, "\",\"kind\":\"%s\",\"calls\":%ld,\"ns\":%lld}",
+                        e->mac ? "macro" : "request", e->calls, e->ns);
+            }
+            fprintf(fp, "]}\n");
+            fclose(fp);
+        }
+    }
+    OSA_FREE(pt);
+    pt = NULL;
+    ptsize = ptfill = 0;
+}
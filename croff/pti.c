@@ -16,11 +16,25 @@
  * - Rail and magazine positioning commands
  *
  * Entry point corresponds to the 'start' label in the original assembly.
+ *
+ * Each byte is looked up in ptclass[], built once at start-up, instead
+ * of being tested against every pattern in turn, and the character
+ * names come from a table in the same way.  A regular file is mapped
+ * and walked in place; anything else is read in PTBUF chunks.  All
+ * output goes through one buffer, written with write(2).  With -s
+ * nothing is printed per byte: only glyphs, motions and stops are
+ * counted, as a quick audit of a large file.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define PTBUF 65536 /* input chunk and output buffer size */
 
 /*
  * Global state variables (originally in .bss section)
@@ -182,10 +196,125 @@ static const struct wentry wtab[] = {
     {0, 0},
     {0, 0}};
 
+/*
+ * Classes of control byte, found through ptclass[]
+ */
+enum {
+    PT_CHAR, /* 00xx xxxx: character */
+    PT_INIT, /* 0100 to 0114: the commands below */
+    PT_LR,
+    PT_UR,
+    PT_UM,
+    PT_LM,
+    PT_LC,
+    PT_UC,
+    PT_EF,
+    PT_EB,
+    PT_STOP,
+    PT_LF,
+    PT_LB,
+    PT_ILL, /* other 0100 to 0117 */
+    PT_SIZE, /* 0120 to 0137 */
+    PT_LEAD, /* 0140 to 0177 */
+    PT_ESC, /* 1xxx xxxx: escape */
+    PT_OTHER
+};
+
+static unsigned char ptclass[256];
+
+/* prn() text of each byte, and length */
+static char ptoct[256][6];
+static unsigned char ptoctn[256];
+
+/* Output line of each character code, and length */
+static char ptname[0200][8];
+static unsigned char ptnamen[0200];
+
+/* -s: counts instead of a listing */
+static int sflag;
+static long nglyph, nesc, nlead, nsize, nstop;
+
+static char obuf[PTBUF];
+static size_t obufn;
+
 /* Function prototypes */
+static void ptinit(void);
+static void oflush(void);
+static void owrite(const char *s, size_t n);
 static void prn(int c);
 static void str(const char *s);
 static void numb(long n, int base);
+static void ptbyte(int ch);
+
+/*
+ * ptinit: Build the byte classes and the text of every byte
+ */
+static void ptinit(void) {
+    static const unsigned char cmds[] = {PT_INIT, PT_LR, PT_UR, PT_UM, PT_LM, PT_LC, PT_UC,
+                                         PT_EF, PT_EB, PT_STOP, PT_LF, PT_ILL, PT_LB};
+    size_t i;
+    int ch, c;
+
+    for (ch = 0; ch < 256; ch++) {
+        if (ch & 0200)
+            ptclass[ch] = PT_ESC;
+        else if (ch >= 0100 && ch <= 0114)
+            ptclass[ch] = cmds[ch - 0100];
+        else if ((ch & 0360) == 0100)
+            ptclass[ch] = PT_ILL;
+        else if ((ch & 0340) == 0140)
+            ptclass[ch] = PT_LEAD;
+        else if ((ch & 0360) == 0120)
+            ptclass[ch] = PT_SIZE;
+        else if ((ch & 0300) == 0)
+            ptclass[ch] = PT_CHAR;
+        else
+            ptclass[ch] = PT_OTHER;
+        ptoctn[ch] = (unsigned char)snprintf(ptoct[ch], sizeof(ptoct[ch]), "%o ", ch);
+    }
+
+    /* The first width table entry with the code names it */
+    for (c = 0; c < 0200; c++) {
+        ch = c;
+        for (i = 0; i < sizeof(wtab) / sizeof(wtab[0]); ++i) {
+            if (wtab[i].c == c) {
+                ch = (int)(040 + i); /* Map back to ASCII */
+                break;
+            }
+        }
+        if (ch >= 32 && ch < 127)
+            ptnamen[c] = (unsigned char)snprintf(ptname[c], sizeof(ptname[c]), "%c\n", ch);
+        else
+            ptnamen[c] = (unsigned char)snprintf(ptname[c], sizeof(ptname[c]), "\\%03o\n", ch);
+    }
+}
+
+/*
+ * oflush: Write out the output buffer
+ */
+static void oflush(void) {
+    size_t k;
+    ssize_t w;
+
+    for (k = 0; k < obufn; k += (size_t)w) {
+        if ((w = write(1, obuf + k, obufn - k)) < 0) {
+            perror("write");
+            exit(1);
+        }
+    }
+    obufn = 0;
+}
+
+/*
+ * owrite: Buffer n bytes of output
+ */
+static void owrite(const char *s, size_t n) {
+    if (obufn + n > sizeof(obuf)) {
+        oflush();
+    }
+    memcpy(obuf + obufn, s, n);
+    obufn += n;
+}
 
 /*
  * prn: Print control byte in octal format followed by a space
@@ -194,18 +323,20 @@ static void numb(long n, int base);
  * Args: c - control byte to print
  */
 static void prn(int c) {
-    printf("%o ", ((unsigned char)c));
+    if (!sflag) {
+        owrite(ptoct[(unsigned char)c], ptoctn[(unsigned char)c]);
+    }
 }
 
 /*
  * str: Write literal string to stdout
- * Simple wrapper for fputs to maintain consistency with original
+ * Simple wrapper to maintain consistency with original
  *
  * Args: s - null-terminated string to output
  */
 static void str(const char *s) {
-    if (s != NULL) {
-        fputs(s, stdout);
+    if (s != NULL && !sflag) {
+        owrite(s, strlen(s));
     }
 }
 
@@ -221,6 +352,10 @@ static void numb(long n, int base) {
     char *p; /* Pointer for building string backwards */
     int neg = 0; /* Negative number flag */
 
+    if (sflag) {
+        return;
+    }
+
     /* Validate base parameter */
     if (base < 2 || base > 36) {
         str("0"); /* Output zero for invalid base */
@@ -248,7 +383,167 @@ static void numb(long n, int base) {
         *--p = '-';
     }
 
-    fputs(p, stdout);
+    owrite(p, (size_t)(&buf[31] - p));
+}
+
+/*
+ * ptbyte: Interpret one byte of the typesetter stream
+ * Process each input byte according to typesetter control protocol
+ */
+static void ptbyte(int ch) {
+    int cls = ptclass[ch];
+    int n;
+    size_t i;
+
+    /*
+     * Escape sequence processing
+     * High bit set indicates escape distance byte
+     */
+    if (cls == PT_ESC) {
+        prn(ch);
+        esc += (~ch) & 0177; /* Accumulate escape distance */
+        return;
+    }
+
+    /*
+     * Output pending escape sequence if any
+     * Must be done before processing regular commands
+     */
+    if (esc != 0) {
+        str(escd ? "\\< " : "\\> ");
+        numb((long)esc, 10);
+        str("\n");
+        nesc++;
+
+        /* Apply escape direction */
+        if (escd) {
+            esc = -esc;
+        }
+        esct += esc;
+        esc = 0;
+    }
+
+    /* Output the control byte in octal */
+    prn(ch);
+
+    switch (cls) {
+    case PT_INIT: /* minit - Initialize typesetter */
+        str("Initialize\n");
+        return;
+
+    case PT_LR: /* mlr - Move to Lower Rail */
+        str("Lower Rail\n");
+        return;
+
+    case PT_UR: /* mur - Move to Upper Rail */
+        str("Upper Rail\n");
+        return;
+
+    case PT_UM: /* mum - Move to Upper Magazine */
+        str("Upper Mag\n");
+        return;
+
+    case PT_LM: /* mlm - Move to Lower Magazine */
+        str("Lower Mag\n");
+        return;
+
+    case PT_LC: /* mlc - Set Lower Case mode */
+        str("Lower Case\n");
+        caseflag = 0;
+        return;
+
+    case PT_UC: /* muc - Set Upper Case mode */
+        str("Upper Case\n");
+        caseflag = 0100;
+        return;
+
+    case PT_EF: /* mef - Set Forward Escape mode */
+        str("\\> mode, ");
+        numb((long)esct, 10);
+        str("\n");
+        escd = 0;
+        return;
+
+    case PT_EB: /* meb - Set Backward Escape mode */
+        str("\\< mode, ");
+        numb((long)esct, 10);
+        str("\n");
+        escd = 1;
+        return;
+
+    case PT_STOP: /* mstop - Stop command */
+        str("*****Stop*****\n");
+        nstop++;
+        return;
+
+    case PT_LF: /* mlf - Set Lead Forward mode */
+        str("Lead forward, ");
+        numb((long)leadtot, 10);
+        str("\n");
+        leadmode = 0;
+        return;
+
+    case PT_LB: /* mlb - Set Lead Backward mode */
+        str("Lead backward, ");
+        numb((long)leadtot, 10);
+        str("\n");
+        leadmode = 1;
+        return;
+
+    case PT_ILL: /* Illegal control codes (pattern 01xx except specific ones above) */
+        str("Illegal control\n");
+        return;
+
+    case PT_LEAD: /* Lead commands (pattern 011x xxxx) */
+        n = (~ch) & 037; /* Extract 5-bit distance */
+        str("Lead ");
+        numb((long)n, 10);
+        str("\n");
+        nlead++;
+
+        /* Apply lead direction */
+        if (leadmode) {
+            n = -n;
+        }
+        leadtot += n;
+        return;
+
+    case PT_SIZE: /* Size commands (pattern 0010 xxxx) */
+        n = ch & 017; /* Extract 4-bit size code */
+        str("Size ");
+        nsize++;
+
+        /* Look up point size in size table */
+        for (i = 0; stab[i][0] != 0; ++i) {
+            if (stab[i][1] == (unsigned char)n) {
+                pts = (int)stab[i][0];
+                numb((long)pts, 10);
+                break;
+            }
+        }
+
+        /* Handle unknown size codes */
+        if (stab[i][0] == 0) {
+            str("unknown(");
+            numb((long)n, 10);
+            str(")");
+        }
+
+        str("\n");
+        return;
+
+    case PT_CHAR: /* Printable character (pattern 00xx xxxx) */
+        n = (ch + caseflag) & 0177;
+        if (!sflag) {
+            owrite(ptname[n], ptnamen[n]);
+        }
+        nglyph++;
+        return;
+
+    default: /* Unknown command - just output newline */
+        str("\n");
+        return;
+    }
 }
 
 /*
@@ -256,19 +551,30 @@ static void numb(long n, int base) {
  * Parses command line arguments and runs the main interpreter loop
  *
  * Command line format:
- *   pti [-offset] [filename]
- *   
+ *   pti [-s] [-offset] [filename]
+ *
  * Where:
+ *   -s:      Print only counts of glyphs, motions and stops
  *   -offset: Optional octal offset to seek to in file
  *   filename: Input file (stdin if omitted)
  *
  * Returns: 0 on success, 1 on error
  */
 int main(int argc, char **argv) {
+    static unsigned char buf[PTBUF];
     long offset = 0; /* Optional seek offset */
     const char *name = NULL; /* Input filename */
-    FILE *fp = NULL; /* Input file pointer */
-    int ch; /* Current input character */
+    const unsigned char *p, *end;
+    struct stat st;
+    void *map = NULL;
+    ssize_t r;
+    int fd;
+
+    if (argc > 1 && argv[1] != NULL && strcmp(argv[1], "-s") == 0) {
+        sflag = 1;
+        --argc;
+        ++argv;
+    }
 
     /*
      * Argument parsing (corresponds to start of original pti.s)
@@ -287,243 +593,69 @@ int main(int argc, char **argv) {
     }
 
     /* Open input file or use stdin */
-    fp = name ? fopen(name, "rb") : stdin;
-    if (fp == NULL) {
-        if (name != NULL) {
-            perror(name);
-        } else {
-            perror("stdin");
-        }
+    fd = name ? open(name, O_RDONLY) : 0;
+    if (fd < 0) {
+        perror(name);
         return 1;
     }
 
-    /* Seek to specified offset if provided */
-    if (offset > 0) {
-        if (fseek(fp, offset, SEEK_SET) != 0) {
-            perror("fseek");
-            if (fp != stdin) {
-                fclose(fp);
-            }
-            return 1;
-        }
-    }
+    ptinit();
 
-    /*
-     * Main interpreter loop
-     * Process each input byte according to typesetter control protocol
-     */
-    for (;;) {
-        ch = getc(fp);
-        if (ch == EOF) {
-            break; /* End of input - exit loop */
+    /* A regular file is mapped and read in place */
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+        (map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)) != MAP_FAILED) {
+        madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+        p = (const unsigned char *)map + (offset < st.st_size ? offset : st.st_size);
+        end = (const unsigned char *)map + st.st_size;
+        while (p < end) {
+            ptbyte(*p++);
         }
-
-        /*
-         * Escape sequence processing
-         * High bit set indicates escape distance byte
-         */
-        if (ch & 0200) {
-            prn(ch);
-            esc += (~ch) & 0177; /* Accumulate escape distance */
-            continue;
-        }
-
-        /*
-         * Output pending escape sequence if any
-         * Must be done before processing regular commands
-         */
-        if (esc != 0) {
-            str(escd ? "\\< " : "\\> ");
-            numb((long)esc, 10);
-            str("\n");
-
-            /* Apply escape direction */
-            if (escd) {
-                esc = -esc;
-            }
-            esct += esc;
-            esc = 0;
-        }
-
-        /* Output the control byte in octal */
-        prn(ch);
-
-        /*
-         * Process specific command bytes (0100-0114 octal)
-         * These are the main typesetter control commands
-         */
-        switch (ch) {
-        case 0100: /* minit - Initialize typesetter */
-            str("Initialize\n");
-            continue;
-
-        case 0101: /* mlr - Move to Lower Rail */
-            str("Lower Rail\n");
-            continue;
-
-        case 0102: /* mur - Move to Upper Rail */
-            str("Upper Rail\n");
-            continue;
-
-        case 0103: /* mum - Move to Upper Magazine */
-            str("Upper Mag\n");
-            continue;
-
-        case 0104: /* mlm - Move to Lower Magazine */
-            str("Lower Mag\n");
-            continue;
-
-        case 0105: /* mlc - Set Lower Case mode */
-            str("Lower Case\n");
-            caseflag = 0;
-            continue;
-
-        case 0106: /* muc - Set Upper Case mode */
-            str("Upper Case\n");
-            caseflag = 0100;
-            continue;
-
-        case 0107: /* mef - Set Forward Escape mode */
-            str("\\> mode, ");
-            numb((long)esct, 10);
-            str("\n");
-            escd = 0;
-            continue;
-
-        case 0110: /* meb - Set Backward Escape mode */
-            str("\\< mode, ");
-            numb((long)esct, 10);
-            str("\n");
-            escd = 1;
-            continue;
-
-        case 0111: /* mstop - Stop command */
-            str("*****Stop*****\n");
-            continue;
-
-        case 0112: /* mlf - Set Lead Forward mode */
-            str("Lead forward, ");
-            numb((long)leadtot, 10);
-            str("\n");
-            leadmode = 0;
-            continue;
-
-        case 0114: /* mlb - Set Lead Backward mode */
-            str("Lead backward, ");
-            numb((long)leadtot, 10);
-            str("\n");
-            leadmode = 1;
-            continue;
-
-        default:
-            break; /* Not a recognized specific command */
-        }
-
-        /*
-         * Process command categories by bit patterns
-         */
-
-        /* Illegal control codes (pattern 01xx except specific ones above) */
-        if ((ch & 0360) == 0100) {
-            str("Illegal control\n");
-            continue;
-        }
-
-        /* Lead commands (pattern 011x xxxx) */
-        if ((ch & 0340) == 0140) {
-            int n = (~ch) & 037; /* Extract 5-bit distance */
-            str("Lead ");
-            numb((long)n, 10);
-            str("\n");
-
-            /* Apply lead direction */
-            if (leadmode) {
-                n = -n;
-            }
-            leadtot += n;
-            continue;
-        }
-
-        /* Size commands (pattern 0010 xxxx) */
-        if ((ch & 0360) == 0120) {
-            int n = ch & 017; /* Extract 4-bit size code */
-            size_t i;
-
-            str("Size ");
-
-            /* Look up point size in size table */
-            for (i = 0; stab[i][0] != 0; ++i) {
-                if (stab[i][1] == (unsigned char)n) {
-                    pts = (int)stab[i][0];
-                    numb((long)pts, 10);
+        munmap(map, (size_t)st.st_size);
+    } else {
+        /* Skip to the offset by reading if it cannot be sought */
+        if (offset > 0 && lseek(fd, offset, SEEK_SET) < 0) {
+            for (; offset > 0; offset -= r) {
+                if ((r = read(fd, buf, offset < PTBUF ? (size_t)offset : PTBUF)) <= 0) {
                     break;
                 }
             }
-
-            /* Handle unknown size codes */
-            if (stab[i][0] == 0) {
-                str("unknown(");
-                numb((long)n, 10);
-                str(")");
-            }
-
-            str("\n");
-            continue;
         }
-
-        /*
-         * Printable character processing (pattern 00xx xxxx)
-         * These are actual characters to be typeset
-         */
-        if ((ch & 0300) == 0) {
-            unsigned char c = ((unsigned char)ch + caseflag);
-            const struct wentry *w = NULL;
-            size_t i;
-            int width = 0;
-
-            /* Look up character in width table */
-            for (i = 0; i < sizeof(wtab) / sizeof(wtab[0]); ++i) {
-                if (wtab[i].c == c) {
-                    w = &wtab[i];
-                    c = ((unsigned char)040 + i); /* Map back to ASCII */
-                    break;
-                }
-            }
-
-            /* Calculate character width in current point size */
-            if (w != NULL) {
-                width = (((int)w->w) * pts) / 6;
+        while ((r = read(fd, buf, sizeof(buf))) > 0) {
+            for (p = buf, end = buf + r; p < end;) {
+                ptbyte(*p++);
             }
-
-            /* Output the character */
-            if (c >= 32 && c < 127) {
-                putchar((int)c);
-            } else {
-                printf("\\%03o", c); /* Non-printable as octal */
-            }
-
-            str("\n");
-
-            /* Width calculated but not used in this translation */
-            (void)width;
-            continue;
         }
-
-        /* Unknown command - just output newline */
-        str("\n");
+        if (r < 0) {
+            perror(name ? name : "stdin");
+        }
     }
 
     /*
      * End of input processing
      * Output final lead total and cleanup
      */
+    if (sflag) {
+        sflag = 0;
+        str("Glyphs ");
+        numb(nglyph, 10);
+        str("\nEscapes ");
+        numb(nesc, 10);
+        str("\nLeads ");
+        numb(nlead, 10);
+        str("\nSizes ");
+        numb(nsize, 10);
+        str("\nStops ");
+        numb(nstop, 10);
+        str("\n");
+    }
     str("Lead total ");
     numb((long)leadtot, 10);
     str("\n");
+    oflush();
 
     /* Close input file if not stdin */
-    if (fp != stdin) {
-        fclose(fp);
+    if (fd != 0) {
+        close(fd);
     }
 
     return 0;
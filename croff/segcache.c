@@ -0,0 +1,401 @@
+/* C17 - no scaffold needed */
+/*
+ * segcache.c - Output cached for each .so file of a document, for -R
+ *
+ * -R<dir> treats each file that .so reads at the top level, with no
+ * macro or diversion open, as a segment of the document.  A book that
+ * sources one file per chapter is formatted again in full only for the
+ * chapters that changed.
+ *
+ * A segment is looked up when its first line is about to be read.  The
+ * key is made of:
+ *   - the options, except -o, -X and -R
+ *   - the contents of its file
+ *   - the whole formatter state at that point, as pxsave() writes it
+ *     with the device's part-written line
+ * A segment that hits, and whose key matches the whole stored entry
+ * state too, is not read.  Its output goes to the device from the cache
+ * and the formatter takes up the state it was left in.  A segment that
+ * misses is formatted, its output copied off the output ring, and it is
+ * stored with that output and with its state at the end.  The state at
+ * the end of one segment is the state at the start of the next, so an
+ * edit to one chapter shows in the key of the next only if it changed
+ * what the chapter left behind.
+ *
+ * A segment is stored only if its file ends between two lines with no
+ * macro or diversion open.  A file it sources in turn is recorded and
+ * checked by its contents when the segment is next used.  A segment
+ * that uses .nx or .rd is not stored.  Neither is one that reads the
+ * standard input, or one formatted while some of its output is
+ * shunted, as -o and -I do.  A .tm or .pi in a replayed segment does
+ * not run.
+ */
+
+#include "tdef.h" // troff definitions
+#include "pgindex.h" // pxquiet(), pxsave(), pxrestore()
+#include "segcache.h"
+#define OSA_TAG "croff.segcache"
+#include "os/os_acct.h" // OSA_MALLOC, OSA_REALLOC, OSA_FREE, ...
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#define SGMAGIC "CROFFSEG"
+#define SGVERS 2
+#define SGNAME 256 /* longest file name kept, with its NUL */
+
+/* Cache entry header, followed by its files, its states and its output */
+struct sghdr {
+    char magic[8];
+    int version;
+    int nn, evs, blk, nev;
+    int nfile; /* files the segment sourced */
+    unsigned long long key;
+    long size; /* of the segment's own file */
+    unsigned long long hash; /* of its contents */
+    long nin, nout, nput; /* bytes of entry state, exit state and output */
+    long pages, lines; /* pages begun and lines put out by the segment */
+    int err; /* error status it left */
+    int pad;
+};
+
+/* A file the segment sourced */
+struct sgfile {
+    char name[SGNAME];
+    long size;
+    unsigned long long hash;
+};
+
+extern int nx, ifi, ipflg, error, nflush, lgf, totout, dpn, oldbits, xflg;
+extern int xfont, esc, lead, esct, eqflg, hflg;
+extern int oline[], *olinep;
+extern int pnlist[];
+extern long linesout, pagesout;
+extern int evsize(void);
+extern int sodrop(void);
+extern void oputn(const char *s, int n);
+extern char *obtake(size_t *n);
+extern void obtap(void);
+extern void getmap(void);
+extern void lgflush(void);
+extern void prstr(const char *s);
+extern void done3(int x);
+
+char *sgdir;
+int sgpend;
+int sgrec;
+int sgline;
+
+/* State outside the page-level variables of pxsave(), kept as it is */
+static int *sgvars[] = {
+    &nflush, &lgf, &totout, &dpn, &oldbits, &xflg, &xfont, &esc, &lead, &esct, &eqflg, &hflg,
+};
+#define NSGVARS ((int)(sizeof(sgvars) / sizeof(sgvars[0])))
+
+static unsigned long long sgkey0 = 14695981039346656037ULL; /* the options */
+static char sgname[SGNAME]; /* file of the segment pushed */
+static int sgtmp = -1; /* scratch file states are written to */
+static int sgfail; /* the segment being formatted cannot be stored */
+static struct sghdr sgh; /* of the segment being formatted */
+static char *sgin; /* its entry state */
+static struct sgfile *sgf; /* the files it sourced */
+static int nsgf, sgfmax;
+
+/* Fold n bytes at p into the FNV-1a hash h */
+static unsigned long long sghash(unsigned long long h, const void *p, size_t n) {
+    const unsigned char *b = p;
+
+    while (n--)
+        h = (h ^ *b++) * 1099511628211ULL;
+    return (h);
+}
+
+/* Append n bytes to the file being written */
+static int put(int fd, const void *p, size_t n) {
+    return (OSA_WRITE(fd, p, n) == (ssize_t)n ? 0 : -1);
+}
+
+/* Fold an option into the key; -o, -X and -R are not in it */
+void sgarg(const char *a) {
+    if ((a[0] == '-') && ((a[1] == 'o') || (a[1] == 'X') || (a[1] == 'R')))
+        return;
+    sgkey0 = sghash(sgkey0, a, strlen(a) + 1);
+}
+
+/*
+ * Size and hash of the regular file name.  Returns 0, 1 if it does not
+ * end with a newline, or -1 if it cannot be read.
+ */
+static int sgread(const char *name, long *size, unsigned long long *hash) {
+    char buf[8192];
+    struct stat st;
+    unsigned long long h;
+    ssize_t n;
+    long k;
+    int fd, last;
+
+    if ((fd = open(name, O_RDONLY)) < 0)
+        return (-1);
+    if ((fstat(fd, &st) < 0) || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return (-1);
+    }
+    h = 14695981039346656037ULL;
+    last = '\n';
+    for (k = 0; (n = OSA_READ(fd, buf, sizeof(buf))) > 0; k += (long)n) {
+        h = sghash(h, buf, (size_t)n);
+        last = buf[n - 1];
+    }
+    close(fd);
+    if (n < 0)
+        return (-1);
+    *size = k;
+    *hash = h;
+    return (last != '\n');
+}
+
+/*
+ * The formatter state, written through the scratch file: *n bytes,
+ * which are the caller's to free.  NULL if it could not be written.
+ */
+static char *sgstate(long *n) {
+    char tmp[SGNAME + 16], *b;
+
+    if (sgtmp < 0) {
+        if ((snprintf(tmp, sizeof(tmp), "%s/.stateXXXXXX", sgdir) >= (int)sizeof(tmp)) ||
+            ((sgtmp = mkstemp(tmp)) < 0))
+            return (NULL);
+        unlink(tmp);
+    }
+    if ((lseek(sgtmp, 0, SEEK_SET) != 0) || (ftruncate(sgtmp, 0) < 0) ||
+        pxsave(sgtmp, NULL) || sgdevput(sgtmp) || ((*n = (long)lseek(sgtmp, 0, SEEK_CUR)) <= 0) ||
+        ((b = OSA_MALLOC(*n)) == NULL))
+        return (NULL);
+    if (OSA_PREAD(sgtmp, b, *n, 0) != *n) {
+        OSA_FREE(b);
+        return (NULL);
+    }
+    return (b);
+}
+
+/* Write the device's part of the state: its variables and the part-written line */
+int sgdevput(int fd) {
+    int k, m, vars[NSGVARS];
+
+    for (k = 0; k < NSGVARS; k++)
+        vars[k] = *sgvars[k];
+    m = (int)(olinep - oline);
+    return ((put(fd, vars, sizeof(vars)) || put(fd, &m, sizeof(m)) ||
+             put(fd, oline, m * sizeof(int)))
+                ? -1
+                : 0);
+}
+
+/*
+ * The device's part that sgdevput() wrote at p, ending by e: its
+ * length, or -1 if it is bad.  With apply the device takes it up.
+ */
+long sgdevget(const char *p, const char *e, int apply) {
+    int k, m;
+
+    if ((size_t)(e - p) < sizeof(int) * (NSGVARS + 1))
+        return (-1);
+    memcpy(&m, p + sizeof(int) * NSGVARS, sizeof(m));
+    if ((m < 0) || (m > LNSIZE) ||
+        ((size_t)(e - p) - sizeof(int) * (NSGVARS + 1) < m * sizeof(int)))
+        return (-1);
+    if (apply) {
+        for (k = 0; k < NSGVARS; k++)
+            memcpy(sgvars[k], p + k * sizeof(int), sizeof(int));
+        memcpy(oline, p + sizeof(int) * (NSGVARS + 1), m * sizeof(int));
+        olinep = oline + m;
+    }
+    return ((long)(sizeof(int) * (NSGVARS + 1 + m)));
+}
+
+/* The header this binary writes for a segment of the given key */
+static void sghead(struct sghdr *h, unsigned long long key) {
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, SGMAGIC, sizeof(h->magic));
+    h->version = SGVERS;
+    h->nn = NN;
+    h->evs = evsize();
+    h->blk = BLK;
+    h->nev = NEV;
+    h->key = key;
+}
+
+/*
+ * Replay the cached segment at path if it is the one want describes,
+ * entered with the state in.  Everything is checked before any state
+ * is touched.
+ *
+ * Returns 1 if it was replayed.
+ */
+static int sgreplay(const char *path, const struct sghdr *want, const char *in) {
+    const struct sghdr *h;
+    const struct sgfile *f;
+    const char *map, *p, *e;
+    unsigned long long hash;
+    struct stat st;
+    long size, n, t;
+    int fd, k, ok;
+
+    if ((fd = open(path, O_RDONLY)) < 0)
+        return (0);
+    if ((fstat(fd, &st) < 0) || (st.st_size < (off_t)sizeof(*h)) ||
+        ((map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)) == MAP_FAILED)) {
+        close(fd);
+        return (0);
+    }
+    close(fd);
+    h = (const struct sghdr *)map;
+    e = map + st.st_size;
+    p = map + sizeof(*h);
+    ok = (memcmp(h->magic, want->magic, sizeof(h->magic)) == 0) &&
+         (h->version == want->version) && (h->nn == want->nn) && (h->evs == want->evs) &&
+         (h->blk == want->blk) && (h->nev == want->nev) && (h->key == want->key) &&
+         (h->size == want->size) && (h->hash == want->hash) && (h->nin == want->nin) &&
+         (h->nfile >= 0) && (h->nout > 0) && (h->nput >= 0) && (h->nput <= 0x7fffffffL) &&
+         ((size_t)h->nfile <= (size_t)(e - p) / sizeof(*f));
+    if (ok) {
+        f = (const struct sgfile *)p;
+        p += h->nfile * sizeof(*f);
+        ok = ((size_t)(e - p) >= (size_t)h->nin) && (memcmp(p, in, h->nin) == 0);
+    }
+    for (k = 0; ok && k < h->nfile; k++)
+        ok = memchr(f[k].name, 0, SGNAME) && (sgread(f[k].name, &size, &hash) >= 0) &&
+             (size == f[k].size) && (hash == f[k].hash);
+    if (ok) {
+        p += h->nin;
+        ok = ((size_t)(e - p) >= (size_t)h->nout) && ((n = pxrestore(p, p + h->nout, NULL, 0)) > 0) &&
+             ((t = sgdevget(p + n, p + h->nout, 0)) >= 0) && (n + t == h->nout) &&
+             ((size_t)(e - p - h->nout) == (size_t)h->nput);
+    }
+    if (!ok) {
+        munmap((void *)map, (size_t)st.st_size);
+        return (0);
+    }
+
+    oputn(p + h->nout, (int)h->nput);
+    if ((sodrop() < 0) || (pxrestore(p, p + h->nout, NULL, 1) < 0)) {
+        prstr("Cannot replay a cached segment.\n");
+        done3(02);
+    }
+    sgdevget(p + n, p + h->nout, 1);
+    error |= h->err;
+    pagesout += h->pages;
+    linesout += h->lines;
+    getmap();
+    lgflush();
+    munmap((void *)map, (size_t)st.st_size);
+    return (1);
+}
+
+/* The file sgso() pushed is about to be read: replay it, or format it to be stored */
+void sgenter(void) {
+    char path[SGNAME + 24];
+    long nin;
+
+    sgpend = 0;
+    if ((ifi != 1) || (nx != 1) || !pxquiet())
+        return;
+    sghead(&sgh, 0);
+    if ((sgread(sgname, &sgh.size, &sgh.hash) != 0) || ((sgin = sgstate(&nin)) == NULL))
+        return;
+    sgh.nin = nin;
+    sgh.key = sghash(sghash(sghash(sgkey0, &sgh.size, sizeof(sgh.size)), &sgh.hash,
+                            sizeof(sgh.hash)),
+                     sgin, nin);
+    if ((snprintf(path, sizeof(path), "%s/%016llx", sgdir, sgh.key) < (int)sizeof(path)) &&
+        sgreplay(path, &sgh, sgin)) {
+        OSA_FREE(sgin);
+        sgin = NULL;
+        return;
+    }
+    nsgf = 0;
+    sgfail = 0;
+    sgh.pages = pagesout;
+    sgh.lines = linesout;
+    sgh.err = error;
+    sgrec = 1;
+    obtap();
+}
+
+/* The segment being formatted has ended: store it if it ended cleanly */
+void sgexit(void) {
+    char tmp[SGNAME + 16], path[SGNAME + 24], *out, *put0;
+    size_t nput;
+    long nout;
+    int fd, rc;
+
+    sgrec = 0;
+    out = NULL;
+    put0 = obtake(&nput);
+    if (sgfail || !sgline || nx || !pxquiet() || !put0 || ((out = sgstate(&nout)) == NULL))
+        goto out;
+    sgh.nfile = nsgf;
+    sgh.nout = nout;
+    sgh.nput = (long)nput;
+    sgh.pages = pagesout - sgh.pages;
+    sgh.lines = linesout - sgh.lines;
+    sgh.err = error & ~sgh.err;
+    if ((snprintf(tmp, sizeof(tmp), "%s/.segXXXXXX", sgdir) >= (int)sizeof(tmp)) ||
+        (snprintf(path, sizeof(path), "%s/%016llx", sgdir, sgh.key) >= (int)sizeof(path)) ||
+        ((fd = mkstemp(tmp)) < 0))
+        goto out;
+    rc = put(fd, &sgh, sizeof(sgh)) || put(fd, sgf, nsgf * sizeof(*sgf)) ||
+         put(fd, sgin, sgh.nin) || put(fd, out, nout) || put(fd, put0, nput);
+    if ((close(fd) < 0) || rc || (rename(tmp, path) < 0))
+        unlink(tmp);
+out:
+    OSA_FREE(put0);
+    OSA_FREE(out);
+    OSA_FREE(sgin);
+    sgin = NULL;
+}
+
+/* The segment being formatted reads what its key does not cover */
+void sgbad(void) {
+    if (sgrec)
+        sgfail = 1;
+}
+
+/* .so has pushed the file name */
+void sgso(const char *name) {
+    struct sgfile *f;
+    void *b;
+    int k;
+
+    if (!sgdir || ipflg || (pnlist[0] != -1))
+        return;
+    if (sgrec) {
+        if (nsgf >= sgfmax) {
+            k = sgfmax ? 2 * sgfmax : 8;
+            if ((b = OSA_REALLOC(sgf, k * sizeof(*sgf))) == NULL) {
+                sgfail = 1;
+                return;
+            }
+            sgf = b;
+            sgfmax = k;
+        }
+        f = &sgf[nsgf];
+        memset(f, 0, sizeof(*f));
+        if ((strlen(name) >= SGNAME) || (sgread(name, &f->size, &f->hash) < 0)) {
+            sgfail = 1;
+            return;
+        }
+        strcpy(f->name, name);
+        nsgf++;
+        return;
+    }
+    if ((ifi == 1) && (strlen(name) < SGNAME)) {
+        strcpy(sgname, name);
+        sgpend = 1;
+    }
+}
@@ -0,0 +1,32 @@
+/* C17 - no scaffold needed */
+/*
+ * segcache.h - Output cached for each .so file of a document, for -R
+ *
+ * SGPOINT() is the test the main loop makes for each input line: a file
+ * .so has just pushed at the top level makes sgenter() look it up.
+ * SGPOP() is the test nextfile() makes when it has popped back to the
+ * top-level file: a segment being formatted is cached by sgexit().
+ * sgdevput() and sgdevget() write and read the device's part of the
+ * state, which pxsave() leaves out; the -X index keeps it too.
+ */
+
+#ifndef SEGCACHE_H
+#define SEGCACHE_H
+
+extern char *sgdir; /* -R directory, NULL if segments are not cached */
+extern int sgpend; /* a file is pushed by .so at the top level and not read */
+extern int sgrec; /* a segment is being formatted, to be cached */
+extern int sgline; /* the main loop is reading the first character of a line */
+
+void sgarg(const char *a);
+void sgso(const char *name);
+void sgenter(void);
+void sgexit(void);
+void sgbad(void);
+int sgdevput(int fd);
+long sgdevget(const char *p, const char *e, int apply);
+
+#define SGPOINT() (sgpend ? sgenter() : (void)0)
+#define SGPOP() ((sgrec && (ifi == 0)) ? sgexit() : (void)0)
+
+#endif /* SEGCACHE_H */
@@ -0,0 +1,435 @@
+/* C17 - no scaffold needed */
+/*
+ * serve.c - Format documents sent to a Unix socket with -D
+ *
+ * With -D<socket> croff starts up as usual, reading its -m package (or
+ * the -K snapshot) and terminal table, and then, where it would open
+ * the first document, builds the glyph table, the suffix trie and the
+ * hyphenation cache and listens on <socket> instead.  Each connection
+ * is a job:
+ *
+ *   the client sends   option lines, an empty line, the document,
+ *                      then shuts down its side for writing
+ *   croff sends back   "o <n>\n" and n bytes of output,
+ *                      "e <n>\n" and n bytes of diagnostics, as they come,
+ *                      and last "x <status>\n", -1 if the job was stopped
+ *
+ * For each job the server forks a manager, which reads the options and
+ * forks the formatter.  That resumes from the loaded state as -B does
+ * (batch.c), with the document as its standard input, and pipes its
+ * output and diagnostics back to the manager, which frames them for
+ * the client.  -r, -o and -s apply to the warm state, as do -m and -T
+ * naming the package and terminal the server has loaded.  Other options
+ * start a fresh croff for the job.
+ *
+ * -L<seconds>,<megabytes>,<kilobytes> limits each job: wall-clock and
+ * processor seconds, address space, and output; 0 takes a limit off.
+ * -C caps (caps.c) apply to each job as well, and are passed on to a
+ * fresh croff ahead of the job's own options.
+ * -j<n> is the number of jobs at once, by default one per processor;
+ * further connections wait in the listen queue.  SIGTERM, SIGINT or
+ * SIGHUP stop the server once the running jobs are done.
+ */
+
+#include "tdef.h" // troff definitions
+#include "troff_processor.h" // processor state
+#include "caps.h" // -C resource caps
+#include "diag.h" // -Q diagnostics
+#define OSA_TAG "croff.serve"
+#include "os/os_acct.h" // OSA_READ
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#define DSECS 30 /* -L: seconds a job may take */
+#define DMEGS 512 /* megabytes of address space */
+#define DKILOS (64 * 1024) /* kilobytes of output */
+#define DBACKLOG 64 /* connections waiting for a job slot */
+#define DOPTS 32 /* option lines a job may send */
+#define DOPTLEN 256 /* bytes in one */
+
+extern int ibf;
+extern int ptid;
+extern int rargc;
+extern int bjobs;
+extern int dateset;
+extern int stop;
+extern char termtab[];
+extern int tti;
+
+void prstr(const char *s);
+void flusho(void);
+void obwait(void);
+void obfork(void);
+void pfdrop(void);
+int bcopytmp(void);
+void hywarm(void);
+void ptwarm(void);
+int cnum(char *a);
+int *nrp(int j);
+int findr(int c);
+void getpn(char *a);
+
+char *dsock; /* -D: the socket jobs come in on, NULL without -D */
+char *dpkg; /* -m: the package name, to match a job's -m against */
+
+static long dsecs = DSECS, dmegs = DMEGS, dkilos = DKILOS;
+static volatile sig_atomic_t dquit; /* the server is to stop */
+static volatile sig_atomic_t dlate; /* the job is over its time */
+
+void dserve(void);
+void dlimit(char *s);
+
+/* -L: up to three numbers, an empty one leaving its limit as it was */
+void dlimit(char *s) {
+    long *lim[] = {&dsecs, &dmegs, &dkilos};
+    char *e;
+    int k;
+
+    for (k = 0; k < 3 && *s; k++) {
+        if (*s != ',')
+            *lim[k] = strtol(s, &e, 10), s = e;
+        if (*s == ',')
+            s++;
+    }
+}
+
+static void dstop(int signo) {
+    (void)signo;
+    dquit = 1;
+}
+
+static void dalarm(int signo) {
+    (void)signo;
+    dlate = 1;
+}
+
+/* Send all of buf, or -1 once the client has gone or the time is up */
+static int dsend(int c, const char *buf, size_t n) {
+    ssize_t r;
+
+    while (n > 0) {
+        if ((r = send(c, buf, n, MSG_NOSIGNAL)) < 0) {
+            if (errno == EINTR && !dlate)
+                continue;
+            return (-1);
+        }
+        buf += r;
+        n -= (size_t)r;
+    }
+    return (0);
+}
+
+/* One record of the reply: its kind, its length and its bytes */
+static int drec(int c, int kind, const char *buf, size_t n) {
+    char head[32];
+
+    snprintf(head, sizeof(head), "%c %zu\n", kind, n);
+    if (dsend(c, head, strlen(head)) < 0)
+        return (-1);
+    return (dsend(c, buf, n));
+}
+
+/*
+ * Send the last record and end the manager.  Input the formatter left
+ * unread is read first, or closing would reset the connection and the
+ * client could lose the reply.
+ */
+static void dend(int c, const char *tail) {
+    char buf[8192];
+
+    dsend(c, tail, strlen(tail));
+    shutdown(c, SHUT_WR);
+    while (recv(c, buf, sizeof(buf), MSG_DONTWAIT) > 0)
+        ;
+    _exit(0);
+}
+
+/* Read the job's option lines up to the empty one; the count, or -1 */
+static int dopts(int c, char opt[][DOPTLEN]) {
+    int n, k;
+    ssize_t r;
+    char ch;
+
+    for (n = 0; n <= DOPTS; n++) {
+        for (k = 0;; k++) {
+            while ((r = OSA_READ(c, &ch, 1)) < 0 && errno == EINTR && !dlate)
+                ;
+            if (r <= 0 || k == DOPTLEN - 2)
+                return (-1);
+            if (ch == '\n')
+                break;
+            opt[n][k] = ch;
+        }
+        /* cnum() reads on past the NUL, as into the next argv string in main() */
+        opt[n][k] = 0;
+        opt[n][k + 1] = '\n';
+        if (k == 0)
+            return (n);
+        if (n == DOPTS || opt[n][0] != '-')
+            return (-1);
+    }
+    return (-1);
+}
+
+/* Whether the loaded state will do for the options, -1 if refused */
+static int dwarm(char opt[][DOPTLEN], int n) {
+    int k, warm = 1;
+
+    for (k = 0; k < n; k++)
+        switch (opt[k][1]) {
+        case 'r': /* these apply after start-up */
+        case 'o':
+        case 's':
+            break;
+        case 'm':
+            if (!dpkg || strcmp(&opt[k][2], dpkg) != 0)
+                warm = 0;
+            break;
+        case 'T':
+            if (strcmp(&opt[k][2], &termtab[tti]) != 0)
+                warm = 0;
+            break;
+        case 'D': /* these would not write the reply */
+        case 'B':
+            return (-1);
+        default:
+            warm = 0;
+        }
+    return (warm);
+}
+
+/* In the formatter: take the job's options as main() would have */
+static void dapply(char opt[][DOPTLEN], int n) {
+    int k;
+
+    for (k = 0; k < n; k++)
+        switch (opt[k][1]) {
+        case 'r':
+            *nrp(findr(opt[k][2])) = cnum(&opt[k][3]);
+            break;
+        case 'o':
+            getpn(&opt[k][2]);
+            break;
+        case 's':
+            if (!(stop = cnum(&opt[k][2])))
+                stop++;
+            break;
+        }
+}
+
+/* In the formatter, before it runs: the job's limits */
+static void drlimit(void) {
+    struct rlimit rl;
+
+    if (dsecs > 0) {
+        rl.rlim_cur = rl.rlim_max = (rlim_t)dsecs;
+        setrlimit(RLIMIT_CPU, &rl);
+    }
+    if (dmegs > 0) {
+        rl.rlim_cur = rl.rlim_max = (rlim_t)dmegs << 20;
+        setrlimit(RLIMIT_AS, &rl);
+    }
+}
+
+/*
+ * djob - Run the job on connection c
+ *
+ * In the manager, reads the options, forks the formatter and sends back
+ * what it writes; the manager never returns.  Returns in the formatter,
+ * with c as its standard input and the loaded state its own.
+ */
+static void djob(int c, struct sigaction *old) {
+    static char opt[DOPTS + 1][DOPTLEN];
+    static char *argv[DOPTS + 3];
+    struct sigaction sa;
+    struct pollfd p[2];
+    char buf[8192], tail[32];
+    const char *why = NULL;
+    int po[2], pe[2], n, k, warm, open, status;
+    long long sent = 0;
+    ssize_t r;
+    pid_t pid;
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = dalarm; /* no SA_RESTART: a send to a stuck client gives up */
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGALRM, &sa, NULL);
+    if (dsecs > 0)
+        alarm((unsigned)dsecs);
+    if ((n = dopts(c, opt)) < 0 || (warm = dwarm(opt, n)) < 0) {
+        drec(c, 'e', "croff: bad options\n", 19);
+        dend(c, "x 2\n");
+    }
+    dgflush(); /* or the job would write what is held again */
+    if (pipe2(po, O_CLOEXEC) < 0 || pipe2(pe, O_CLOEXEC) < 0 || (pid = fork()) < 0) {
+        drec(c, 'e', "croff: cannot fork\n", 19);
+        dend(c, "x 2\n");
+    }
+
+    if (pid == 0) {
+        alarm(0);
+        signal(SIGALRM, SIG_DFL);
+        sigaction(SIGTERM, &old[0], NULL);
+        sigaction(SIGINT, &old[1], NULL);
+        sigaction(SIGHUP, &old[2], NULL);
+        if (dup2(c, 0) < 0 || dup2(po[1], 1) < 0 || dup2(pe[1], 2) < 0)
+            _exit(02);
+        close(c);
+        close(po[0]), close(po[1]);
+        close(pe[0]), close(pe[1]);
+        drlimit();
+        if (!warm) {
+            argv[0] = "croff";
+            argv[1] = capopt; /* the server's caps first: a job's own only lower them */
+            for (k = 0; k < n; k++)
+                argv[k + 1 + !!capopt] = opt[k];
+            argv[n + 1 + !!capopt] = NULL;
+            execv("/proc/self/exe", argv);
+            prstr("Cannot exec croff.\n");
+            dgflush();
+            _exit(02);
+        }
+        obfork();
+        pfdrop();
+        if (bcopytmp() < 0)
+            _exit(02);
+        if (ptid > 2)
+            close(ptid);
+        ptid = 1;
+        dateset = 0; /* the job's date, not the server's */
+        dapply(opt, n);
+        dsock = NULL;
+        rargc = 0;
+        return;
+    }
+
+    /* The manager: frame the formatter's output and diagnostics */
+    close(po[1]);
+    close(pe[1]);
+    p[0].fd = po[0];
+    p[1].fd = pe[0];
+    p[0].events = p[1].events = POLLIN;
+    for (open = 2; open > 0 && !why;) {
+        if (dlate) {
+            why = "time";
+            break;
+        }
+        if (poll(p, 2, -1) < 0)
+            continue;
+        for (k = 0; k < 2 && !why; k++) {
+            if (!p[k].revents)
+                continue;
+            if ((r = OSA_READ(p[k].fd, buf, sizeof(buf))) <= 0) {
+                if (r < 0 && errno == EINTR)
+                    continue;
+                p[k].fd = -1;
+                open--;
+                continue;
+            }
+            if (k == 0 && dkilos > 0 && (sent += r) > (long long)dkilos << 10)
+                why = "output";
+            else if (drec(c, k ? 'e' : 'o', buf, (size_t)r) < 0)
+                why = dlate ? "time" : ""; /* "": the client has gone */
+        }
+    }
+    if (why)
+        kill(pid, SIGKILL);
+    while (waitpid(pid, &status, 0) < 0)
+        if (errno != EINTR) {
+            status = -1;
+            break;
+        }
+    if (why && *why) {
+        snprintf(buf, sizeof(buf), "croff: job over its %s limit\n", why);
+        dlate = 0; /* one last try at the reply */
+        alarm(1);
+        drec(c, 'e', buf, strlen(buf));
+    }
+    snprintf(tail, sizeof(tail), "x %d\n",
+             (status != -1 && WIFEXITED(status)) ? WEXITSTATUS(status) : -1);
+    dend(c, tail);
+}
+
+/*
+ * dserve - Serve jobs on the -D socket
+ *
+ * Called by nextfile() where it would open the first document.  Returns
+ * in the formatter of each job; the server itself never returns.
+ */
+void dserve(void) {
+    struct sockaddr_un a;
+    struct sigaction sa, old[3];
+    struct stat st;
+    int ls, c, nrun;
+    pid_t pid;
+
+    if (!*dsock || strlen(dsock) >= sizeof(a.sun_path)) {
+        prstr("Bad socket name.\n");
+        exit(02);
+    }
+    if (bjobs < 1 && (bjobs = (int)sysconf(_SC_NPROCESSORS_ONLN)) < 1)
+        bjobs = 1;
+    /* Whatever the package wrote goes out once, from here */
+    if (g_processor.outputPtr != g_processor.outputBuffer)
+        flusho();
+    else
+        obwait();
+    ptwarm();
+    hywarm();
+
+    memset(&a, 0, sizeof(a));
+    a.sun_family = AF_UNIX;
+    strcpy(a.sun_path, dsock);
+    if (lstat(dsock, &st) == 0 && S_ISSOCK(st.st_mode))
+        unlink(dsock); /* left by a server that is gone */
+    if ((ls = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)) < 0 ||
+        bind(ls, (struct sockaddr *)&a, sizeof(a)) < 0 || listen(ls, DBACKLOG) < 0) {
+        prstr("Cannot listen on ");
+        prstr(dsock);
+        prstr("\n");
+        exit(02);
+    }
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = dstop; /* no SA_RESTART: accept() returns to see dquit */
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGTERM, &sa, &old[0]);
+    sigaction(SIGINT, &sa, &old[1]);
+    sigaction(SIGHUP, &sa, &old[2]);
+
+    for (nrun = 0; !dquit;) {
+        while (nrun > 0 && waitpid(-1, NULL, nrun < bjobs ? WNOHANG : 0) > 0)
+            nrun--;
+        if (nrun >= bjobs)
+            continue; /* interrupted */
+        if ((c = accept4(ls, NULL, NULL, SOCK_CLOEXEC)) < 0)
+            continue;
+        dgflush();
+        if ((pid = fork()) == 0) {
+            close(ls);
+            djob(c, old);
+            return;
+        }
+        if (pid > 0)
+            nrun++;
+        close(c);
+    }
+    close(ls);
+    unlink(dsock);
+    while (wait(NULL) > 0 || errno == EINTR)
+        ;
+    if (ibf >= 0)
+        close(ibf);
+    exit(0);
+}
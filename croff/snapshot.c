@@ -0,0 +1,573 @@
+/* C17 - no scaffold needed */
+/*
+ * snapshot.c - Precompiled macro-package snapshots for fast startup
+ *
+ * Loading a -m package re-parses the whole package through casede() and
+ * copyb() on every run.  When a snapshot directory is given with -K, the
+ * formatter state left behind by the package is written out once the
+ * package (and anything it sources) has been read, and later runs map
+ * the snapshot and resume from that state instead of reading the package.
+ *
+ * A snapshot covers the state packages are expected to touch:
+ *   - contab entries (macros by storage offset, requests by table slot)
+ *   - blist and the contents of every macro storage block in use
+ *   - number registers r[], their values, increments and formats
+ *   - traps, the translation table and all NEV environments
+ *   - a few page-level scalars (pl, po, em, eschar, pagech), and whether
+ *     the date registers have been read or set
+ *   - the forward references declared by .fs and .fn
+ *   - the tab stops of every environment (tabstop.c)
+ *
+ * Snapshots are keyed by package path; the header also records the
+ * package's mtime, size and inode, the table dimensions of the binary
+ * and a hash of its request table, whose slots the image names requests
+ * by.  The mtime, size and inode of every file the package sources with
+ * .so follow it.  A snapshot that is stale, or was written by a croff
+ * with other requests, is ignored and rebuilt.
+ *
+ * A loaded snapshot stays mapped read-only, and the macro blocks are
+ * lent to the block store from the mapping rather than copied, so every
+ * process started from the same snapshot shares one copy of the
+ * package's macros in the page cache.  A block is copied into the
+ * process only when it is written, as .am or a redefinition does.
+ * snapsave() replaces a snapshot by renaming a new one over it, so a
+ * mapping in use never changes under a run.
+ *
+ * snapget() and snapput() read and write the image itself; pgindex.c
+ * uses them for its page checkpoints too.
+ */
+
+#include "tdef.h" // troff definitions
+#include "fwref.h" // forward references
+#include "tabstop.h" // tab stops
+#define OSA_TAG "croff.snapshot"
+#include "os/os_acct.h" // OSA_MALLOC, OSA_REALLOC, OSA_FREE, OSA_WRITE
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#define SNAPMAGIC "CROFFSNP"
+#define SNAPVERS 11
+#define SNAPKTAB (-1 - NEV) /* piece key of the first table; the rest go down */
+
+/*
+ * Snapshot file header, followed by nfile snapfiles, a snapcnt and the
+ * sections in snapsave() order
+ */
+struct snaphdr {
+    char magic[8];
+    int version;
+    int nn, evs, blk, nblist, ntrap, nev, nvars;
+    int nfile; /* files the package sourced */
+    unsigned long long rqs; /* hash of the request table, contab0[] */
+    long mtime, size, ino;
+    char pkg[NS];
+};
+
+/* A file the package sourced, as it was when the snapshot was made */
+struct snapfile {
+    long mtime, size, ino;
+    char name[NS];
+};
+
+/* Table sizes of the saving run and where its image was loaded */
+struct snapcnt {
+    int nm; /* contab entries */
+    int nr; /* number register slots */
+    int nb; /* blist entries */
+    int nt; /* trap slots */
+    long base; /* address environment pointers are relative to: 0, for trtab */
+};
+
+/* contab entry as stored: macro offset, or request slot in contab0[] */
+struct snapent {
+    int rq;
+    int val;
+};
+
+extern struct contab {
+    int rq;
+    union {
+        int (*func)(void);
+        int offset;
+    } f;
+} *contab;
+extern int ncontab;
+
+extern int *blist;
+extern int nblist;
+extern void blkinit(void);
+extern int blkroom(int n);
+extern int *r;
+extern int *inc;
+extern int *fmt;
+extern int nnr;
+extern int *nlist;
+extern int *mlist;
+extern int ntrap;
+extern char trtab[256];
+extern int pl, po, em, eschar, pagech;
+
+extern void blkget(int i, int *buf);
+extern void blkput(int i, const int *buf);
+extern void blklend(int i, const int *words);
+extern void mnhash(void);
+extern int mngrow(void);
+extern int *nrp(int j);
+extern int nrpeek(int j);
+extern int dateset;
+extern void nrhash(void);
+extern int nrroom(int n);
+extern int trroom(int n);
+extern void trapmod(void);
+extern int evsize(void);
+extern void evget(int k, char *buf);
+extern void evput(int k, const char *buf);
+extern void evreloc(char *buf, uintptr_t delta);
+extern void prstr(const char *s);
+extern void widflush(void);
+
+int snapsave(void);
+int snapload(char *pkg);
+void snapso(const char *name);
+long snapget(const char *p, const char *e,
+             const void *(*piece)(const char **pp, const char *e, size_t n), int apply);
+int snapput(int fd, int (*piece)(int fd, int key, const void *buf, size_t n));
+void snapbase(void);
+
+char *snapdir; /* -K directory, NULL if snapshots are off */
+int snappend; /* package is being read and should be saved at its end */
+
+static struct contab contab0[NM]; /* request table before any package */
+static struct snaphdr snaph; /* key of the package being loaded */
+static int *snapvars[] = {&pl, &po, &em, &eschar, &pagech, &dateset};
+#define NSNAPVARS ((int)(sizeof(snapvars) / sizeof(snapvars[0])))
+
+static int snapbased;
+static int snaplend; /* snapget() lends the blocks from an image that stays mapped */
+static struct snapfile *snapf; /* the files the package has sourced */
+static int nsnapf, snapfmax;
+static int snapfail; /* one of them cannot be checked: save no snapshot */
+
+/* Keep the request table as it is before any package, once */
+void snapbase(void) {
+    if (!snapbased++)
+        memcpy(contab0, contab, sizeof(contab0));
+}
+
+/* FNV-1a hash of the request names in contab0[], by slot */
+static unsigned long long snaprqs(void) {
+    unsigned long long h = 14695981039346656037ULL;
+    const unsigned char *b;
+    size_t k;
+    int i;
+
+    for (i = 0; i < NM; i++)
+        for (b = (const unsigned char *)&contab0[i].rq, k = 0; k < sizeof(contab0[i].rq); k++)
+            h = (h ^ *b++) * 1099511628211ULL;
+    return (h);
+}
+
+/* Note the file's mtime, size and inode in f; -1 if it cannot be */
+static int snapstat(const char *name, struct snapfile *f) {
+    struct stat st;
+
+    if (strlen(name) >= NS || stat(name, &st) < 0)
+        return (-1);
+    memset(f, 0, sizeof(*f));
+    strcpy(f->name, name);
+    f->mtime = (long)st.st_mtime;
+    f->size = (long)st.st_size;
+    f->ino = (long)st.st_ino;
+    return (0);
+}
+
+/* Build the snapshot file name for a package path */
+static int snapname(char *buf, size_t n, const char *pkg) {
+    size_t i, k;
+
+    if ((k = (size_t)snprintf(buf, n, "%s/", snapdir)) >= n)
+        return (-1);
+    for (i = 0; pkg[i] && k + 6 < n; i++)
+        buf[k++] = (pkg[i] == '/') ? '_' : pkg[i];
+    if (pkg[i])
+        return (-1);
+    strcpy(&buf[k], ".snap");
+    return (0);
+}
+
+/* Append n bytes to the snapshot being written */
+static int put(int fd, const void *p, size_t n) {
+    return (OSA_WRITE(fd, p, n) == (ssize_t)n ? 0 : -1);
+}
+
+/* Write a piece of the image through piece, or whole */
+static int snappiece(int fd, int (*piece)(int fd, int key, const void *buf, size_t n), int key,
+                     const void *buf, size_t n) {
+    return (piece ? piece(fd, key, buf, n) : put(fd, buf, n));
+}
+
+/* A piece of n bytes stored whole in the image, at *pp */
+static const void *whole(const char **pp, const char *e, size_t n) {
+    const char *b = *pp;
+
+    if ((size_t)(e - *pp) < n)
+        return (NULL);
+    *pp += n;
+    return (b);
+}
+
+/*
+ * snapget - Restore the state image at p, which ends by e
+ *
+ * The image is a snapcnt and the sections in snapput() order.  The
+ * tables that seldom change, each block in use and each environment are
+ * pieces found through piece, which is given the place it is stored at
+ * and its length and moves past it; NULL means the pieces are stored
+ * whole.
+ * With apply 0 the image is only measured, so that a bad one can be
+ * refused before any state is touched.
+ *
+ * Returns the length of the image, or -1 if it is not a whole one or
+ * cannot be restored.
+ */
+long snapget(const char *p, const char *e,
+             const void *(*piece)(const char **pp, const char *e, size_t n), int apply) {
+    const struct snapent *en;
+    const char *p0, *q;
+    const int *bl, *tr, *tinc, *tfmt, *b;
+    struct snapcnt c;
+    char *env;
+    size_t nfix;
+    long nts;
+    int i, j, nm, nr, nb, nt, nf, evs;
+
+    p0 = p;
+    if (piece == NULL)
+        piece = whole;
+    evs = evsize();
+    if ((size_t)(e - p) < sizeof(c))
+        return (-1);
+    memcpy(&c, p, sizeof(c));
+    p += sizeof(c);
+    nm = c.nm;
+    nr = c.nr;
+    nb = c.nb;
+    nt = c.nt;
+    if (nm < NM || nr < NN || nb < NBLIST || nt < NTRAP || (size_t)nt > (size_t)(e - p) / sizeof(int))
+        return (-1);
+
+    /* Measure the pieces and what is between them before touching any state. */
+    if ((en = piece(&p, e, nm * sizeof(*en))) == NULL ||
+        (bl = piece(&p, e, nb * sizeof(int))) == NULL)
+        return (-1);
+    for (q = p, i = 0; i < nb; i++)
+        if (bl[i] && piece(&q, e, BLK * sizeof(int)) == NULL)
+            return (-1);
+    if ((tr = piece(&q, e, nr * sizeof(int))) == NULL)
+        return (-1);
+    nfix = (size_t)nr * sizeof(int);
+    if (nfix > (size_t)(e - q))
+        return (-1);
+    q += nfix;
+    if ((tinc = piece(&q, e, nr * sizeof(int))) == NULL ||
+        (tfmt = piece(&q, e, nr * sizeof(int))) == NULL)
+        return (-1);
+    nfix = 2 * (size_t)nt * sizeof(int) + 256;
+    if (nfix > (size_t)(e - q))
+        return (-1);
+    for (q += nfix, j = 0; j < NEV; j++)
+        if (piece(&q, e, evs) == NULL)
+            return (-1);
+    if ((NSNAPVARS + 1) * sizeof(int) > (size_t)(e - q))
+        return (-1);
+    memcpy(&nf, q + NSNAPVARS * sizeof(int), sizeof(nf));
+    nfix = (NSNAPVARS + 1) * sizeof(int);
+    if (nf < 0 || nf > NFW || (size_t)nf * sizeof(*fwtab) > (size_t)(e - q) - nfix)
+        return (-1);
+    if ((nts = tsget(q + nfix + nf * sizeof(*fwtab), e, 0)) < 0)
+        return (-1);
+    if (!apply)
+        return ((long)(q - p0) + (long)(nfix + nf * sizeof(*fwtab)) + nts);
+
+    while (ncontab < nm)
+        if (mngrow() < 0)
+            return (-1);
+    if (nrroom(nr) < 0 || blkroom(nb) < 0 || trroom(nt) < 0 || fwroom(nf) < 0 ||
+        (env = OSA_MALLOC(evs)) == NULL)
+        return (-1);
+    for (i = 0; i < nm; i++, en++) {
+        contab[i].rq = en->rq;
+        if (en->rq & MMASK)
+            contab[i].f.offset = en->val;
+        else if (en->val >= 0 && en->val < NM)
+            contab[i].f.func = contab0[en->val].f.func;
+        else
+            contab[i] = (struct contab){0};
+    }
+    for (; i < ncontab; i++)
+        contab[i] = (struct contab){0};
+    memset(blist, 0, nblist * sizeof(int));
+    memcpy(blist, bl, nb * sizeof(int));
+    for (i = 0; i < nb; i++) {
+        if (!blist[i])
+            continue;
+        b = piece(&p, e, BLK * sizeof(int));
+        if (snaplend && ((uintptr_t)b % sizeof(int) == 0))
+            blklend(i, b);
+        else
+            blkput(i, b);
+    }
+    for (i = 0; i < nnr; i++)
+        r[i] = *nrp(i) = inc[i] = fmt[i] = 0;
+    memcpy(r, tr, nr * sizeof(int));
+    piece(&p, e, nr * sizeof(int));
+    for (i = 0; i < nr; i++, p += sizeof(int))
+        memcpy(nrp(i), p, sizeof(int));
+    memcpy(inc, tinc, nr * sizeof(int));
+    memcpy(fmt, tfmt, nr * sizeof(int));
+    piece(&p, e, nr * sizeof(int));
+    piece(&p, e, nr * sizeof(int));
+    memset(nlist, 0, ntrap * sizeof(int));
+    memset(mlist, 0, ntrap * sizeof(int));
+    memcpy(nlist, p, nt * sizeof(int));
+    p += nt * sizeof(int);
+    memcpy(mlist, p, nt * sizeof(int));
+    p += nt * sizeof(int);
+    trapmod();
+    memcpy(trtab, p, 256);
+    p += 256;
+    widflush();
+    for (j = 0; j < NEV; j++) {
+        memcpy(env, piece(&p, e, evs), evs);
+        evreloc(env, (uintptr_t)trtab - (uintptr_t)c.base);
+        evput(j, env);
+    }
+    OSA_FREE(env);
+    for (j = 0; j < NSNAPVARS; j++, p += sizeof(int))
+        memcpy(snapvars[j], p, sizeof(int));
+    p += sizeof(int);
+    if (nf)
+        memcpy(fwtab, p, nf * sizeof(*fwtab));
+    nfw = nf;
+    p += nf * sizeof(*fwtab);
+    if (tsget(p, e, 1) < 0)
+        return (-1);
+    p += nts;
+
+    mnhash();
+    nrhash();
+    blkinit();
+    return ((long)(p - p0));
+}
+
+/*
+ * snapput - Write the state image snapget() restores
+ *
+ * Each block in use, each environment and the contab, blist, r, inc
+ * and fmt tables go through piece if it is given, with a key naming it:
+ * the blist index of a block, -1 - k for environment k, and SNAPKTAB
+ * down for the tables.  piece may store it elsewhere; otherwise it is
+ * written whole.
+ *
+ * Environment pointers are written relative to trtab, and the date
+ * registers as 0 until one is used, so the same state writes the same
+ * image in every run.
+ *
+ * Returns 0, or -1 if a write failed.
+ */
+int snapput(int fd, int (*piece)(int fd, int key, const void *buf, size_t n)) {
+    struct snapent *en;
+    char *env;
+    int buf[BLK];
+    struct snapcnt c;
+    int i, j, k, rc, evs;
+
+    memset(&c, 0, sizeof(c));
+    c.nm = ncontab;
+    c.nr = nnr;
+    c.nb = nblist;
+    c.nt = ntrap;
+    c.base = 0;
+    rc = put(fd, &c, sizeof(c));
+    if ((en = OSA_MALLOC(ncontab * sizeof(*en))) == NULL)
+        return (-1);
+    for (i = 0; i < ncontab; i++) {
+        en[i].rq = contab[i].rq;
+        en[i].val = -1;
+        if (en[i].rq & MMASK) {
+            en[i].val = contab[i].f.offset;
+        } else if (en[i].rq) {
+            for (j = 0; j < NM; j++)
+                if (contab0[j].rq && contab0[j].f.func == contab[i].f.func)
+                    break;
+            en[i].val = (j < NM) ? j : -1;
+        }
+    }
+    k = SNAPKTAB;
+    if (!rc)
+        rc = snappiece(fd, piece, k--, en, ncontab * sizeof(*en)) ||
+             snappiece(fd, piece, k--, blist, nblist * sizeof(int));
+    OSA_FREE(en);
+    for (i = 0; i < nblist && !rc; i++) {
+        if (blist[i]) {
+            blkget(i, buf);
+            rc = snappiece(fd, piece, i, buf, sizeof(buf));
+        }
+    }
+    if (!rc)
+        rc = snappiece(fd, piece, k--, r, nnr * sizeof(int));
+    for (i = 0; i < nnr && !rc; i++)
+        rc = put(fd, &(int){nrpeek(i)}, sizeof(int));
+    if (!rc)
+        rc = snappiece(fd, piece, k--, inc, nnr * sizeof(int)) ||
+             snappiece(fd, piece, k--, fmt, nnr * sizeof(int)) ||
+             put(fd, nlist, ntrap * sizeof(int)) || put(fd, mlist, ntrap * sizeof(int)) ||
+             put(fd, trtab, 256);
+    evs = evsize();
+    if ((env = OSA_MALLOC(evs)) == NULL)
+        rc = -1;
+    for (j = 0; j < NEV && !rc; j++) {
+        evget(j, env);
+        evreloc(env, -(uintptr_t)trtab);
+        rc = snappiece(fd, piece, -1 - j, env, evs);
+    }
+    OSA_FREE(env);
+    for (j = 0; j < NSNAPVARS && !rc; j++)
+        rc = put(fd, snapvars[j], sizeof(int));
+    if (!rc)
+        rc = put(fd, &nfw, sizeof(nfw)) || put(fd, fwtab, nfw * sizeof(*fwtab)) || tsput(fd);
+    return (rc);
+}
+
+/*
+ * snapload - Start from a snapshot of package pkg if a valid one exists
+ *
+ * Returns 1 if the state was restored and the package need not be read,
+ * 0 if the package must be read (and snappend is set so that it will be
+ * saved when it ends).
+ */
+int snapload(char *pkg) {
+    char name[4 * NS];
+    struct snapfile f;
+    struct stat st;
+    struct snapfile *sf;
+    char *map, *e, *p;
+    int fd, k, nf;
+
+    snapbase();
+    if (!snapdir || stat(pkg, &st) < 0 || strlen(pkg) >= NS)
+        return (0);
+
+    memset(&snaph, 0, sizeof(snaph));
+    memcpy(snaph.magic, SNAPMAGIC, sizeof(snaph.magic));
+    snaph.version = SNAPVERS;
+    snaph.nn = NN;
+    snaph.evs = evsize();
+    snaph.blk = BLK;
+    snaph.nblist = NBLIST;
+    snaph.ntrap = NTRAP;
+    snaph.nev = NEV;
+    snaph.nvars = NSNAPVARS;
+    snaph.rqs = snaprqs();
+    snaph.mtime = (long)st.st_mtime;
+    snaph.size = (long)st.st_size;
+    snaph.ino = (long)st.st_ino;
+    strcpy(snaph.pkg, pkg);
+    nsnapf = snapfail = 0;
+    snappend++;
+
+    if (snapname(name, sizeof(name), pkg) < 0 || (fd = open(name, O_RDONLY)) < 0)
+        return (0);
+    if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(snaph) ||
+        (map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)) == MAP_FAILED) {
+        close(fd);
+        return (0);
+    }
+    close(fd);
+
+    /* The header as this run would write it, but for the files sourced */
+    e = map + st.st_size;
+    memcpy(&nf, map + offsetof(struct snaphdr, nfile), sizeof(nf));
+    snaph.nfile = nf;
+    p = map + sizeof(snaph);
+    k = (memcmp(map, &snaph, sizeof(snaph)) == 0) && (nf >= 0) &&
+        ((size_t)nf <= (size_t)(e - p) / sizeof(*sf));
+    snaph.nfile = 0;
+    for (sf = (struct snapfile *)p; k && nf > 0; sf++, nf--)
+        k = memchr(sf->name, 0, NS) && (snapstat(sf->name, &f) == 0) &&
+            (f.mtime == sf->mtime) && (f.size == sf->size) && (f.ino == sf->ino);
+    p = (char *)sf;
+    if (!k || snapget(p, e, NULL, 0) != e - p) {
+        munmap(map, (size_t)st.st_size);
+        return (0);
+    }
+    /* The map is kept from here on: blocks may be lent from it */
+    snaplend = 1;
+    if (snapget(p, e, NULL, 1) < 0) {
+        snaplend = 0;
+        return (0);
+    }
+    snaplend = 0;
+    snappend = 0;
+    return (1);
+}
+
+/*
+ * snapsave - Write the snapshot for the package that just finished
+ *
+ * The snapshot is written to a temporary name and renamed into place,
+ * so concurrent runs never see a partial file.  Failures are silent:
+ * the next run simply reads the package again.
+ */
+int snapsave(void) {
+    char name[4 * NS], tmp[4 * NS + 8];
+    int fd, rc;
+
+    snappend = 0;
+    if (snapfail || snapname(name, sizeof(name), snaph.pkg) < 0)
+        return (-1);
+    snprintf(tmp, sizeof(tmp), "%s.XXXXXX", name);
+    if ((fd = mkstemp(tmp)) < 0)
+        return (-1);
+
+    snaph.nfile = nsnapf;
+    rc = put(fd, &snaph, sizeof(snaph)) || put(fd, snapf, nsnapf * sizeof(*snapf)) ||
+         snapput(fd, NULL);
+    snaph.nfile = 0;
+    if (close(fd) < 0 || rc || rename(tmp, name) < 0) {
+        unlink(tmp);
+        return (-1);
+    }
+    return (0);
+}
+
+/* The package being read has sourced name with .so */
+void snapso(const char *name) {
+    struct snapfile *f;
+    int k;
+
+    if (snappend != 2 || snapfail)
+        return;
+    if (nsnapf >= snapfmax) {
+        k = snapfmax ? 2 * snapfmax : 8;
+        if ((f = OSA_REALLOC(snapf, k * sizeof(*snapf))) == NULL) {
+            snapfail = 1;
+            return;
+        }
+        snapf = f;
+        snapfmax = k;
+    }
+    if (snapstat(name, &snapf[nsnapf]) < 0) {
+        snapfail = 1;
+        return;
+    }
+    nsnapf++;
+}
@@ -65,6 +65,13 @@
  */
 #define SUFTAB_PRIORITY_FLAG 0x40
 
+/**
+ * @def SUFTAB_ORIGIN
+ * @brief Offset of @c suftab_bytes[0] within the original suftab file,
+ * which is what the @c suftab_index offsets count from.
+ */
+#define SUFTAB_ORIGIN 0x44
+
 /* Static function prototypes for suffix table operations */
 static int suftab_validate_letter(int letter_idx);
 static unsigned short suftab_get_offset(int letter_idx); /* Return type changed to unsigned short */
@@ -312,7 +319,9 @@ static const unsigned char suftab_bytes[] = {
     0x6b, 0x26, 0x67, 0xf2, 0x61, 0xf0, 0x68, 0x04, 0x6c, 0xef, 0xe7, 0x02,
     0xe6, 0x03, 0xee, 0x65, 0x03, 0xec, 0x65, 0x04, 0x63, 0x6b, 0xe5, 0x03,
     0xeb, 0x65, 0x04, 0xe2, 0x6f, 0x64, 0x05, 0xf3, 0x74, 0x75, 0x64, 0xe4,
-    0x65, 0x65, 0x64, 0x02, 0xe2};
+    0x65, 0x65, 0x64, 0x02, 0xe2,
+    0x00 /* end of the y entries; the original file simply ended here */
+};
 
 /**
  * @brief Validates if the given letter index is within the valid range (0-25 for a-z).
@@ -574,6 +583,29 @@ int suftab_lookup(int letter, suftab_callback_t callback, void *user_data) {
     return count;
 }
 
+/**
+ * @brief Gets the first suffix entry for a letter.
+ *
+ * The offsets in @c suftab_index count from the start of the original
+ * suftab file, whose first @c SUFTAB_ORIGIN bytes (header and index) are
+ * not part of @c suftab_bytes.  The entries for a letter run in table
+ * order up to one whose length byte has a zero length; the low four bits
+ * of each length byte give the size of the entry, length byte included.
+ *
+ * @param letter_idx The index of the letter (0 for 'a', 25 for 'z').
+ * @return A pointer to the length byte of the first entry, or @c NULL if
+ *         the letter is invalid or has no entries.
+ */
+const unsigned char *suftab_entries(int letter_idx) {
+    unsigned short offset;
+
+    offset = suftab_get_offset(letter_idx);
+    if (offset < SUFTAB_ORIGIN || (size_t)(offset - SUFTAB_ORIGIN) >= sizeof(suftab_bytes)) {
+        return NULL;
+    }
+    return &suftab_bytes[offset - SUFTAB_ORIGIN];
+}
+
 /**
  * @brief Gets the total size in bytes of the @c suftab_bytes data array.
  * @return The size of the suffix byte data table.
@@ -75,6 +75,18 @@ typedef void (*suftab_callback_t)(const unsigned char *pattern,
  */
 int suftab_lookup(int letter, suftab_callback_t callback, void *user_data);
 
+/*
+ * suftab_entries - Get the suffix entries for a letter
+ * @letter_idx: Letter index, 0 for 'a' through 25 for 'z'
+ *
+ * Each entry is a length byte followed by its letters; the low four
+ * bits of the length byte count the whole entry, and a zero length
+ * ends the list for the letter.
+ *
+ * Returns: Pointer to the first entry, or NULL if there are none
+ */
+const unsigned char *suftab_entries(int letter_idx);
+
 /*
  * suftab_get_size - Get size of suffix table data
  * 
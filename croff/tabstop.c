@@ -0,0 +1,230 @@
+/* C17 - no scaffold needed */
+/*
+ * tabstop.c - The tab stops of each environment, for .ta and setfield()
+ *
+ * .ta used to fill tabtab[], NTAB (35) words of the environment, and
+ * setfield() looked through them in order for the first stop past the
+ * position a tab was at.  The stops of each environment are now an
+ * array of any length kept here, ev choosing which.  A stop not past
+ * the one before it could never be the first found past a position, so
+ * .ta drops it, and the array, increasing, is searched by halves.  A
+ * stop at 0, or past the TMASK bits a position is kept in, ends the
+ * stops, as the 0 after the last one in tabtab did.
+ *
+ * After a T, .ta's stops are a pattern repeated without end, as in
+ * groff: offsets from the stop before the T (or from 0), each
+ * repetition moved on by the last of them.  They are kept as the first
+ * repetition, and a stop in a later one is found by arithmetic.
+ *
+ * The stops are not among the environment variables of ni.c, which are
+ * copied whole in and out of packed buffers of one size, so caseev()
+ * has nothing to copy for them; snapshot.c writes them after the
+ * environments with tsput() and reads them back with tsget().
+ */
+
+#include "tdef.h" // troff definitions
+#include "tabstop.h"
+#define OSA_TAG "croff.tabs"
+#include "os/os_acct.h" // OSA_REALLOC, OSA_WRITE
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define TSMIN 16 /* room first made for an environment's stops */
+
+/* The stops of an environment */
+struct tstab {
+    int *s; /* position | RTAB or CTAB, increasing in position */
+    int n;
+    int rep; /* the first stop of the pattern, -1 if there is none */
+    int shut; /* .ta has ended the stops: add no more */
+    int size; /* room in s */
+};
+
+extern int ev;
+
+static struct tstab tstabs[NEV];
+static int tsready; /* tsdef() has run */
+
+static struct tstab *tscur(void) {
+    if (!tsready)
+        tsdef(DTAB);
+    return (&tstabs[ev]);
+}
+
+/* Room for n stops in t; -1 if memory runs out */
+static int tsroom(struct tstab *t, int n) {
+    int *s, size;
+
+    if (n <= t->size)
+        return (0);
+    for (size = t->size ? t->size : TSMIN; size < n; size *= 2)
+        ;
+    if ((s = OSA_REALLOC(t->s, size * sizeof(int))) == NULL)
+        return (-1);
+    t->s = s;
+    t->size = size;
+    return (0);
+}
+
+/* The environment in use has no stops, and .ta adds from the first */
+void tsclear(void) {
+    struct tstab *t = tscur();
+
+    t->n = t->shut = 0;
+    t->rep = -1;
+}
+
+/* The stops added from here on are a repeated pattern */
+void tsrep(void) {
+    struct tstab *t = tscur();
+
+    if (t->rep < 0)
+        t->rep = t->n;
+}
+
+/*
+ * tsadd - Add a stop of type RTAB, CTAB or 0 at pos, as .ta reads it
+ *
+ * pos is a position, or in a pattern the offset from the stop before
+ * it.  Returns 0, or -1 if memory runs out.
+ */
+int tsadd(int pos, int type) {
+    struct tstab *t = tscur();
+    int base, last;
+
+    if (t->shut)
+        return (0);
+    base = (t->rep > 0) ? (t->s[t->rep - 1] & TMASK) : 0;
+    if (pos <= 0 || (t->rep >= 0 && (pos += base) <= base) || pos > TMASK) {
+        t->shut = 1;
+        return (0);
+    }
+    last = (t->n > 0) ? (t->s[t->n - 1] & TMASK) : 0;
+    if (pos <= last)
+        return (0);
+    if (tsroom(t, t->n + 1) < 0)
+        return (-1);
+    t->s[t->n++] = pos | type;
+    return (0);
+}
+
+/* The first of s[lo] to s[hi - 1] past pos, or hi */
+static int tsfind(const int *s, int lo, int hi, int pos) {
+    int m;
+
+    while (lo < hi) {
+        m = lo + (hi - lo) / 2;
+        if ((s[m] & TMASK) > pos)
+            hi = m;
+        else
+            lo = m + 1;
+    }
+    return (lo);
+}
+
+/*
+ * tsnext - The first stop of the environment in use past pos
+ *
+ * Sets *type to its RTAB or CTAB bit, or 0.  Returns 0 if there is
+ * none.
+ */
+int tsnext(int pos, int *type) {
+    struct tstab *t = tscur();
+    int k, n, base, per, shift;
+
+    n = (t->rep >= 0) ? t->rep : t->n;
+    *type = 0;
+    if ((k = tsfind(t->s, 0, n, pos)) < n) {
+        *type = t->s[k] & ~TMASK;
+        return (t->s[k] & TMASK);
+    }
+    if (n == t->n)
+        return (0);
+
+    /* pos is in repetition (pos - base) / per of the pattern */
+    base = (n > 0) ? (t->s[n - 1] & TMASK) : 0;
+    per = (t->s[t->n - 1] & TMASK) - base;
+    shift = (pos > base) ? ((pos - base) / per) * per : 0;
+    k = tsfind(t->s, n, t->n, pos - shift);
+    *type = t->s[k] & ~TMASK;
+    return ((t->s[k] & TMASK) + shift);
+}
+
+/* Every environment: TSDEF plain stops w apart, or none if w is 0 */
+void tsdef(int w) {
+    struct tstab *t;
+    int e, k;
+
+    tsready = 1;
+    for (e = 0; e < NEV; e++) {
+        t = &tstabs[e];
+        t->n = t->shut = 0;
+        t->rep = -1;
+        if (w <= 0 || tsroom(t, TSDEF) < 0)
+            continue;
+        for (k = 0; k < TSDEF && w * (k + 1) <= TMASK; k++)
+            t->s[t->n++] = w * (k + 1);
+    }
+}
+
+static int tswrite(int fd, const void *p, size_t n) {
+    return (OSA_WRITE(fd, p, n) == (ssize_t)n ? 0 : -1);
+}
+
+/* Write the stops of every environment; 0, or -1 if a write failed */
+int tsput(int fd) {
+    struct tstab *t;
+    int e, rc;
+
+    (void)tscur();
+    for (rc = e = 0; e < NEV && !rc; e++) {
+        t = &tstabs[e];
+        rc = tswrite(fd, &t->n, sizeof(int)) || tswrite(fd, &t->rep, sizeof(int)) ||
+             tswrite(fd, t->s, t->n * sizeof(int));
+    }
+    return (rc);
+}
+
+/*
+ * tsget - Restore the stops tsput() wrote at p, which ends by e
+ *
+ * With apply 0 they are only measured.  Returns their length, or -1 if
+ * they are not whole, not increasing, or memory runs out.
+ */
+long tsget(const char *p, const char *e, int apply) {
+    struct tstab *t;
+    const char *p0 = p;
+    int h[2], k, n, s, last;
+
+    for (k = 0; k < NEV; k++) {
+        if ((size_t)(e - p) < sizeof(h))
+            return (-1);
+        memcpy(h, p, sizeof(h));
+        p += sizeof(h);
+        if ((n = h[0]) < 0 || h[1] < -1 || h[1] > n || (size_t)n > (size_t)(e - p) / sizeof(int))
+            return (-1);
+        for (last = 0; n-- > 0; p += sizeof(int), last = s & TMASK) {
+            memcpy(&s, p, sizeof(int));
+            if ((s & TMASK) <= last)
+                return (-1);
+        }
+    }
+    if (!apply)
+        return ((long)(p - p0));
+    tsready = 1;
+    for (p = p0, k = 0; k < NEV; k++) {
+        t = &tstabs[k];
+        memcpy(h, p, sizeof(h));
+        p += sizeof(h);
+        if (tsroom(t, h[0]) < 0)
+            return (-1);
+        memcpy(t->s, p, h[0] * sizeof(int));
+        p += h[0] * sizeof(int);
+        t->n = h[0];
+        t->rep = h[1];
+        t->shut = 0;
+    }
+    return ((long)(p - p0));
+}
@@ -0,0 +1,23 @@
+/* C17 - no scaffold needed */
+/*
+ * tabstop.h - The tab stops of each environment, for .ta and setfield()
+ *
+ * caseta() clears the stops of the environment in use and adds the
+ * ones it reads, with tsrep() before those of a repeated pattern;
+ * setfield() asks tsnext() for the first stop past a position.
+ */
+
+#ifndef TABSTOP_H
+#define TABSTOP_H
+
+#define TSDEF 16 /* stops tsdef() sets */
+
+void tsclear(void);
+void tsrep(void);
+int tsadd(int pos, int type);
+int tsnext(int pos, int *type);
+void tsdef(int w);
+int tsput(int fd);
+long tsget(const char *p, const char *e, int apply);
+
+#endif /* TABSTOP_H */
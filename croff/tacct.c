@@ -5,12 +5,25 @@
  * This program reads accounting data and reports paper usage per user.
  * It reads from /etc/passwd to map UIDs to usernames and from accounting
  * data files to calculate paper consumption in feet.
+ *
+ * With -m the accounting file is mapped and walked in place, usage is
+ * summed per uid in a hash table that grows as uids appear, so there
+ * is no bound on them, and /etc/passwd is read once into a second
+ * table keyed the same way.  Several device characters may then be
+ * given, each summarised in turn; -c writes the summaries as CSV and
+ * -j as JSON, either implying -m.  -f<file> and -p<file> name the
+ * accounting and password files in place of the defaults; with -m an
+ * -f directory is taken as troff -A spools, merged into one summary.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h> // POSIX header
 #include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <dirent.h>
 
 /* Maximum number of users supported */
 #define MAX_USERS 256
@@ -45,8 +58,28 @@ static int acct_record[3];
 /* Default path to accounting data */
 static char acctname[] = "/usr/actg/data/troffactg";
 
+/* A uid in either hash table of -m: its paper, or its name */
+struct tuid {
+    long long uid; /* -1 when the slot is empty */
+    long long used; /* sum of the records' first words */
+    const char *name;
+};
+
+/* An open-addressed table of uids, its size a power of two */
+struct ttab {
+    struct tuid *t;
+    size_t size, n;
+};
+
+/* -m and its output form: 0 text, 'c' CSV, 'j' JSON */
+static int mflag, tform;
+static char *passwdname = "/etc/passwd";
+static struct ttab tnames; /* uid to user name, from passwdname */
+static char *tpwtext; /* the password file, which tnames points into */
+
 /* Function prototypes */
 static struct passwd *getpwent(void);
+static int tmapped(char **devs, int ndev, char *file);
 static char *pwskip(char *ap);
 static int getn(void *p, int n);
 static void cleanup_and_exit(int status);
@@ -66,6 +99,30 @@ int main(int argc, char **argv) {
     register struct passwd *p;
     char date[MAX_DATE];
     float total;
+    char *file = NULL;
+
+    for (; argc > 1 && argv[1][0] == '-' && argv[1][1]; argc--, argv++) {
+        switch (argv[1][1]) {
+        case 'c':
+        case 'j':
+            tform = argv[1][1];
+            /* fall through */
+        case 'm':
+            mflag = 1;
+            break;
+        case 'f':
+            file = &argv[1][2];
+            break;
+        case 'p':
+            passwdname = &argv[1][2];
+            break;
+        default:
+            printf("Usage: tacct [-m] [-c | -j] [-f<file>] [-p<file>] [device_char ...]\n");
+            exit(1);
+        }
+    }
+    if (mflag)
+        exit(tmapped(argv + 1, argc - 1, file));
 
     /* Initialize paper usage array */
     for (i = 0; i < MAX_USERS; i++) {
@@ -73,21 +130,24 @@ int main(int argc, char **argv) {
     }
 
     /* Open passwd file */
-    passwd_fp = fopen("/etc/passwd", "r");
+    passwd_fp = fopen(passwdname, "r");
     if (passwd_fp == NULL) {
-        printf("Cannot open /etc/passwd\n");
+        printf("Cannot open %s\n", passwdname);
         cleanup_and_exit(1);
     }
 
     /* Handle optional device character argument */
-    if (argc == 2) {
-        acctname[9] = argv[1][0];
+    if (file == NULL) {
+        file = acctname;
+        if (argc == 2) {
+            acctname[9] = argv[1][0];
+        }
     }
 
     /* Open accounting data file */
-    acct_fp = fopen(acctname, "r");
+    acct_fp = fopen(file, "r");
     if (acct_fp == NULL) {
-        printf("Cannot open: %s\n", acctname);
+        printf("Cannot open: %s\n", file);
         cleanup_and_exit(1);
     }
 
@@ -283,3 +343,290 @@ static void cleanup_and_exit(int status) {
     }
     exit(status);
 }
+
+/*
+ * The slot of uid in a table: its own, or the empty one it would take.
+ */
+static struct tuid *tslot(struct ttab *tb, long long uid) {
+    size_t h, mask = tb->size - 1;
+
+    h = (size_t)((unsigned long long)uid * 0x9e3779b97f4a7c15ULL >> 32) & mask;
+    while (tb->t[h].uid != -1 && tb->t[h].uid != uid)
+        h = (h + 1) & mask;
+    return &tb->t[h];
+}
+
+/*
+ * The entry of uid, added if new; the table doubles at half full.
+ *
+ * Returns: the entry, or NULL when out of memory
+ */
+static struct tuid *tfind(struct ttab *tb, long long uid) {
+    struct tuid *e, *old = tb->t;
+    size_t i, osize = tb->size;
+
+    if (2 * (tb->n + 1) > tb->size) {
+        tb->size = osize ? 2 * osize : 1024;
+        if ((tb->t = malloc(tb->size * sizeof(*tb->t))) == NULL)
+            return NULL;
+        for (i = 0; i < tb->size; i++)
+            tb->t[i].uid = -1;
+        for (i = 0; i < osize; i++)
+            if (old[i].uid != -1)
+                *tslot(tb, old[i].uid) = old[i];
+        free(old);
+    }
+    if ((e = tslot(tb, uid))->uid == -1) {
+        e->uid = uid;
+        e->used = 0;
+        e->name = NULL;
+        tb->n++;
+    }
+    return e;
+}
+
+/*
+ * Map a whole file read-only.
+ *
+ * Returns: the mapping, with its size in *size, or NULL
+ */
+static const char *tmap(const char *name, size_t *size) {
+    struct stat st;
+    void *p;
+    int fd;
+
+    *size = 0;
+    if ((fd = open(name, O_RDONLY)) < 0)
+        return NULL;
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+    p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)
+        return NULL;
+    *size = (size_t)st.st_size;
+    return p;
+}
+
+/*
+ * Read the password file once into tnames.  The first name given a
+ * uid is kept, as the search of the plain report finds it.
+ *
+ * Returns: 0, or -1 when it cannot be read
+ */
+static int tpwread(void) {
+    char *p, *line, *uid, *end;
+    struct tuid *e;
+    FILE *fp;
+    long n;
+
+    if ((fp = fopen(passwdname, "r")) == NULL || fseek(fp, 0, SEEK_END) < 0 ||
+        (n = ftell(fp)) < 0 || fseek(fp, 0, SEEK_SET) < 0 ||
+        (tpwtext = malloc((size_t)n + 1)) == NULL) {
+        if (fp != NULL)
+            fclose(fp);
+        return -1;
+    }
+    n = (long)fread(tpwtext, 1, (size_t)n, fp);
+    fclose(fp);
+    tpwtext[n] = '\0';
+    for (line = tpwtext; *line; line = p) {
+        if ((p = strchr(line, '\n')) != NULL)
+            *p++ = '\0';
+        else
+            p = line + strlen(line);
+        uid = pwskip(pwskip(line));
+        end = pwskip(uid);
+        if (end == uid || (e = tfind(&tnames, atoi(uid))) == NULL)
+            continue;
+        if (e->name == NULL)
+            e->name = line;
+    }
+    return 0;
+}
+
+static int tcmp(const void *a, const void *b) {
+    long long x = ((const struct tuid *)a)->uid, y = ((const struct tuid *)b)->uid;
+
+    return (x > y) - (x < y);
+}
+
+/* n bytes of s as JSON string contents */
+static void tjson(const char *s, size_t n) {
+    for (; n--; s++)
+        if (*s == '"' || *s == '\\')
+            printf("\\%c", *s);
+        else if ((unsigned char)*s < ' ')
+            printf("\\u%04x", *s);
+        else
+            putchar(*s);
+}
+
+/* The running sums of one summary, over one file or a spool of them */
+struct tsum {
+    struct ttab use; /* paper per uid */
+    long long total, last; /* all paper; the uid of the last record */
+    char date[MAX_DATE]; /* the first file's date line */
+    int nfile; /* files read */
+};
+
+/*
+ * Add the records of accounting file name to sum.  The file is mapped
+ * and walked in place: its date line, then records of three ints.
+ */
+static void tadd(struct tsum *sum, const char *name) {
+    const char *map, *p, *end, *nl;
+    struct tuid *e;
+    size_t size;
+    int rec[3];
+
+    if ((map = tmap(name, &size)) == NULL)
+        return;
+    if ((nl = memchr(map, '\n', size)) == NULL) {
+        munmap((void *)map, size);
+        return;
+    }
+    madvise((void *)map, size, MADV_SEQUENTIAL);
+    if (sum->nfile++ == 0)
+        snprintf(sum->date, sizeof(sum->date), "%.*s", (int)(nl - map), map);
+    end = map + size;
+    for (p = nl + 1; end - p >= (long)sizeof(rec); p += sizeof(rec)) {
+        memcpy(rec, p, sizeof(rec));
+        if (rec[1] < 0 || (e = tfind(&sum->use, rec[1])) == NULL)
+            continue;
+        e->used += rec[0];
+        sum->total += rec[0];
+        sum->last = rec[1];
+    }
+    munmap((void *)map, size);
+}
+
+/*
+ * Summarise one accounting file, or every spool in a directory: the
+ * date line, then each user's paper in uid order and the total, in the
+ * form tform asks for.
+ *
+ * Returns: 0, or 1 when the file cannot be read
+ */
+static int tsummary(const char *name, const char *dev) {
+    static int nsum; /* summaries written */
+    struct tsum sum = {{NULL, 0, 0}, 0, -1, "", 0};
+    struct ttab use;
+    struct dirent **list;
+    struct tuid *e, *u;
+    struct stat st;
+    char path[4096];
+    size_t i, n;
+    int k, nlist;
+
+    if (stat(name, &st) == 0 && S_ISDIR(st.st_mode)) {
+        /* A spool directory: every file in it, in name order */
+        if ((nlist = scandir(name, &list, NULL, alphasort)) > 0) {
+            for (k = 0; k < nlist; k++) {
+                if (list[k]->d_name[0] != '.' &&
+                    snprintf(path, sizeof(path), "%s/%s", name, list[k]->d_name) <
+                        (int)sizeof(path))
+                    tadd(&sum, path);
+                free(list[k]);
+            }
+            free(list);
+        }
+    } else {
+        tadd(&sum, name);
+    }
+    if (sum.nfile == 0) {
+        fprintf(stderr, "Cannot open: %s\n", name);
+        free(sum.use.t);
+        return 1;
+    }
+    use = sum.use;
+
+    /* Packed and sorted by uid */
+    for (i = n = 0; i < use.size; i++)
+        if (use.t[i].uid != -1 && use.t[i].used != 0)
+            use.t[n++] = use.t[i];
+    qsort(use.t, n, sizeof(*use.t), tcmp);
+
+    if (tform == 'j') {
+        printf("%s{\"device\":\"", nsum ? ",\n" : "");
+        tjson(dev, strlen(dev));
+        printf("\",\"date\":\"");
+        tjson(sum.date, strlen(sum.date));
+        printf("\",\"users\":[");
+    } else if (tform == 0) {
+        printf("%s\n", sum.date);
+        printf("UID\tFeet of paper\n");
+    }
+    for (i = 0; i < n; i++) {
+        e = &use.t[i];
+        u = tnames.size ? tslot(&tnames, e->uid) : NULL;
+        if (tform == 'j') {
+            printf("%s\n{\"uid\":%lld,\"user\":", i ? "," : "", e->uid);
+            if (u != NULL && u->uid != -1) {
+                putchar('"');
+                tjson(u->name, strlen(u->name));
+                putchar('"');
+            } else {
+                printf("null");
+            }
+            printf(",\"feet\":%.1f}", e->used / INCHES_TO_FEET);
+        } else if (tform == 'c') {
+            printf("%s,%lld,%s,%.1f\n", dev, e->uid, u != NULL && u->uid != -1 ? u->name : "",
+                   e->used / INCHES_TO_FEET);
+        } else {
+            if (u != NULL && u->uid != -1) {
+                /* Mark last user with underscore */
+                if (e->uid == sum.last)
+                    printf("_\b");
+                printf("%s", u->name);
+            } else {
+                printf("%lld", e->uid);
+            }
+            printf("\t%8.1f\n", e->used / INCHES_TO_FEET);
+        }
+    }
+    if (tform == 'j')
+        printf("],\n\"total\":%.1f}", sum.total / INCHES_TO_FEET);
+    else if (tform == 'c')
+        printf("%s,,Total,%.1f\n", dev, sum.total / INCHES_TO_FEET);
+    else
+        printf("Total\t%8.1f\n", sum.total / INCHES_TO_FEET);
+    nsum++;
+    free(use.t);
+    return 0;
+}
+
+/*
+ * The -m report: a summary of each device's accounting file, or of
+ * file, or of the default when neither is given.
+ *
+ * Returns: exit status
+ */
+static int tmapped(char **devs, int ndev, char *file) {
+    char dev[2] = {0, 0};
+    int k, status = 0;
+
+    if (tpwread() < 0) {
+        fprintf(stderr, "Cannot open %s\n", passwdname);
+        return 1;
+    }
+    if (tform == 'j')
+        printf("[");
+    else if (tform == 'c')
+        printf("device,uid,user,feet\n");
+    if (file != NULL || ndev == 0) {
+        status = tsummary(file ? file : acctname, "");
+    } else {
+        for (k = 0; k < ndev; k++) {
+            acctname[9] = dev[0] = devs[k][0];
+            status |= tsummary(acctname, dev);
+        }
+    }
+    if (tform == 'j')
+        printf("]\n");
+    free(tnames.t);
+    free(tpwtext);
+    return status;
+}
@@ -52,6 +52,8 @@ struct typewriter_table {
     char *down;
     char *right;
     char *left;
+    char *ulon; /* underline on and off; empty to overstrike with _ */
+    char *uloff;
     char *codetab[256 - 32];
     int zzz;
 };
@@ -151,22 +153,30 @@ extern int pipeflg;
 #define NN 170 /* Number of number registers */
 #define NNAMES 14 /* Predefined register names */
 #define NIF 5 /* If-else nesting depth */
+#define NCMP 256 /* Words of a .if string operand kept off macro storage */
+#define NSTR 16 /* Words of a short string body kept by its name */
+#define NXC 256 /* Compiled number expressions kept, a power of two */
+#define CTW 16 /* Words a control line token reads after its control character */
 #define NS 64 /* Name buffer size */
 #define NTM 256 /* Terminal message buffer size */
-#define NEV 3 /* Number of environments */
-#define EVLSZ 10 /* Environment stack size */
-#define EVS (3 * 256) /* Environment size in words */
+#define NEV 10 /* Number of environments */
+#define EVLSZ 32 /* Environment stack size */
 #define NM 252 /* Requests plus macros */
 #define DELTA 512 /* Delta core bytes for allocation */
-#define STKSIZE 10 /* Stack size in words */
+#define MSPILL 0 /* In-core macro blocks before spilling to ibf (0 = never) */
+#define NHCACHE 1024 /* Hyphenation cache slots, -H sets (0 = no cache) */
+#define NBLIST 256 /* Initial macro storage blocks; grows on demand */
+#define BLK 128 /* Words per macro storage block */
+#define STKSIZE 10 /* Frame header words: argument count and offsets */
 
 /*
  * Hyphenation and word processing limits
  */
 #define NHYP 10 /* Maximum hyphens per word */
-#define NHEX 128 /* Exception word list byte size */
+#define NHXW 64 /* Longest hyphenation exception word */
 #define NTAB 35 /* Number of tab stops */
-#define NSO 5 /* "so" (source file) nesting depth */
+#define NSO 5 /* Initial "so" (source file) nesting depth */
+#define NSOMAP 256 /* Mapped input files kept for reuse */
 #define WDSIZE 170 /* Word buffer size */
 #define LNSIZE 480 /* Line buffer size */
 #define NDI 5 /* Number of diversions */
@@ -201,11 +211,14 @@ extern int pipeflg;
 #define FLSS 031 /* Flush character */
 #define RPT 014 /* Repeat character */
 #define JREG 0374 /* Jump register character */
+#define FWHOLE 0373 /* Column of a forward reference, see fwref.h */
+#define RUNMAX 077777 /* Most copies in a run of one glyph */
+#define RUNN(i) (((i) >> 16) & RUNMAX) /* Copies of a glyph below 0370, 0 for one: see getch0() */
 
 /*
  * Trap and pagination constants
  */
-#define NTRAP 20 /* Number of traps */
+#define NTRAP 20 /* Initial number of trap slots */
 #define NPN 20 /* Numbers in "-o" option */
 
 /*
@@ -221,7 +234,8 @@ extern int pipeflg;
  * Buffer sizes for I/O operations
  */
 #define FBUFSZ 256 /* Field buffer size in words */
-#define OBUFSZ 512 /* Output buffer size in bytes */
+#define OBUFSZ 4096 /* Output ring segment size in bytes */
+#define OBRING 64 /* Output ring size in kilobytes, -O sets */
 #define IBUFSZ 512 /* Input buffer size in bytes */
 #define NC 256 /* Character buffer size in words */
 #define NOV 10 /* Number of overstrike characters */
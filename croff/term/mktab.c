@@ -0,0 +1,102 @@
+/* C17 - no scaffold needed */
+/*
+ * mktab.c - Compile nroff terminal tables to table files
+ *
+ *     mktab name file
+ *     mktab -d dir
+ *
+ * Writes the built-in table called name, as in -Tname, to file in the
+ * format of twfile.h; with -d, writes every built-in table to dir/name.
+ * The files are in the byte order of the machine that wrote them.
+ */
+#define NROFF 1
+#include "../tdef.h"
+#include "twfile.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *twstr(const struct typewriter_table *tab, int i) {
+    const char *s;
+
+    s = *(char *const *)((const char *)tab + twstroff[i]);
+    return s ? s : "";
+}
+
+/* The code of entry k, after its width byte */
+static const char *twcode(const struct typewriter_table *tab, int k, int *width) {
+    const char *c;
+
+    c = tab->codetab[k];
+    if (c == NULL || *c == 0) {
+        *width = 0;
+        return "";
+    }
+    *width = *c & 0377;
+    return c + 1;
+}
+
+static int mktab(const struct typewriter_table *tab, const char *file) {
+    struct twfile h;
+    const char *s;
+    uint32_t off;
+    FILE *fp;
+    int i, w;
+
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, TW_MAGIC, sizeof(h.magic));
+    h.version = TW_VERSION;
+    for (i = 0; i < TW_NINT; i++)
+        h.ints[i] = *(const int *)((const char *)tab + twintoff[i]);
+    off = sizeof(h);
+    for (i = 0; i < TW_NSTR; i++) {
+        h.str[i] = off;
+        off += (uint32_t)strlen(twstr(tab, i)) + 1;
+    }
+    for (i = 0; i < TW_NCODE; i++) {
+        h.code[i] = off;
+        off += (uint32_t)strlen(twcode(tab, i, &w)) + 2;
+    }
+    h.size = off;
+
+    if ((fp = fopen(file, "wb")) == NULL) {
+        fprintf(stderr, "mktab: cannot write %s\n", file);
+        return 1;
+    }
+    fwrite(&h, sizeof(h), 1, fp);
+    for (i = 0; i < TW_NSTR; i++)
+        fwrite(twstr(tab, i), strlen(twstr(tab, i)) + 1, 1, fp);
+    for (i = 0; i < TW_NCODE; i++) {
+        s = twcode(tab, i, &w);
+        fputc(w, fp);
+        fwrite(s, strlen(s) + 1, 1, fp);
+    }
+    if (fclose(fp) != 0) {
+        fprintf(stderr, "mktab: cannot write %s\n", file);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    char file[1024];
+    int i, err;
+
+    if (argc == 3 && strcmp(argv[1], "-d") == 0) {
+        for (err = i = 0; i < ntwtabs; i++) {
+            snprintf(file, sizeof(file), "%s/%s", argv[2], twtabs[i].name);
+            err |= mktab(twtabs[i].tab, file);
+        }
+        return err;
+    }
+    if (argc == 3) {
+        for (i = 0; i < ntwtabs; i++)
+            if (strcmp(twtabs[i].name, argv[1]) == 0)
+                return mktab(twtabs[i].tab, argv[2]);
+        fprintf(stderr, "mktab: no table %s\n", argv[1]);
+        return 1;
+    }
+    fprintf(stderr, "usage: mktab name file | mktab -d dir\n");
+    return 2;
+}
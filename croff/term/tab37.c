@@ -1,7 +1,44 @@
-/* C17 stub - original C++ implementation replaced */
-#include <stdio.h>
+/* C17 - no scaffold needed */
+/*
+ * tab37.c - Teletype Model 37 nroff driving table
+ *
+ * The default terminal.  Half-line and reverse line feeds are the 37's
+ * ESC 8, ESC 9 and ESC 7; there is no bold or plot mode.  Linked into
+ * croff, and compiled to a table file by mktab.
+ */
+#define NROFF 1
+#include "../tdef.h"
 
-/* Stub implementation */
-void stub_function(void) {
-    /* Placeholder */
-}
+#define INCH 240
+
+struct typewriter_table tw37 = {
+    0, /*bset*/
+    0, /*breset*/
+    INCH / 10, /*Hor*/
+    INCH / 12, /*Vert*/
+    INCH / 6, /*Newline*/
+    INCH / 10, /*Char*/
+    INCH / 10, /*Em*/
+    INCH / 12, /*Halfline*/
+    INCH / 10, /*Adj*/
+    "", /*twinit*/
+    "", /*twrest*/
+    "\n", /*twnl*/
+    "\0338", /*hlr*/
+    "\0339", /*hlf*/
+    "\0337", /*flr*/
+    "", /*bdon*/
+    "", /*bdoff*/
+    "", /*ploton*/
+    "", /*plotoff*/
+    "", /*up*/
+    "", /*down*/
+    "", /*right*/
+    "", /*left*/
+    "", /*ulon*/
+    "", /*uloff*/
+    {
+#include "code.ascii"
+    },
+    0 /*zzz*/
+};
@@ -0,0 +1,45 @@
+/* C17 - no scaffold needed */
+/*
+ * tabansi.c - Generic ANSI X3.64 (ECMA-48) nroff driving table
+ *
+ * Bold through SGR 1, ended with SGR 22, and underline through SGR 4,
+ * ended with SGR 24, so that each leaves the other alone; reverse line
+ * feed through reverse index.  Linked into croff, and compiled to a
+ * table file by mktab.
+ */
+#define NROFF 1
+#include "../tdef.h"
+
+#define INCH 240
+
+struct typewriter_table twansi = {
+    0, /*bset*/
+    0, /*breset*/
+    INCH / 10, /*Hor*/
+    INCH / 6, /*Vert*/
+    INCH / 6, /*Newline*/
+    INCH / 10, /*Char*/
+    INCH / 10, /*Em*/
+    INCH / 12, /*Halfline*/
+    INCH / 10, /*Adj*/
+    "", /*twinit*/
+    "\033[0m", /*twrest*/
+    "\n", /*twnl*/
+    "", /*hlr*/
+    "", /*hlf*/
+    "\033M", /*flr*/
+    "\033[1m", /*bdon*/
+    "\033[22m", /*bdoff*/
+    "", /*ploton*/
+    "", /*plotoff*/
+    "\033[A", /*up*/
+    "\033[B", /*down*/
+    "\033[C", /*right*/
+    "\033[D", /*left*/
+    "\033[4m", /*ulon*/
+    "\033[24m", /*uloff*/
+    {
+#include "code.ascii"
+    },
+    0 /*zzz*/
+};
@@ -0,0 +1,37 @@
+/* C17 - no scaffold needed */
+/*
+ * tabs.c - Terminal tables built into croff and mktab
+ */
+#define NROFF 1
+#include "../tdef.h"
+#include "twfile.h"
+
+extern struct typewriter_table tw37;
+extern struct typewriter_table twvt100;
+extern struct typewriter_table twvt220;
+extern struct typewriter_table twansi;
+extern struct typewriter_table twxterm;
+
+const struct twtab twtabs[] = {
+    {"37", &tw37},
+    {"vt100", &twvt100},
+    {"vt220", &twvt220},
+    {"vt320", &twvt220},
+    {"ansi", &twansi},
+    {"xterm", &twxterm},
+};
+
+const int ntwtabs = (int)(sizeof(twtabs) / sizeof(twtabs[0]));
+
+#define TWOFF(f) offsetof(struct typewriter_table, f)
+
+const size_t twintoff[TW_NINT] = {
+    TWOFF(bset), TWOFF(breset), TWOFF(Hor), TWOFF(Vert), TWOFF(Newline),
+    TWOFF(Char), TWOFF(Em), TWOFF(Halfline), TWOFF(Adj),
+};
+
+const size_t twstroff[TW_NSTR] = {
+    TWOFF(twinit), TWOFF(twrest), TWOFF(twnl), TWOFF(hlr), TWOFF(hlf),
+    TWOFF(flr), TWOFF(bdon), TWOFF(bdoff), TWOFF(ploton), TWOFF(plotoff),
+    TWOFF(up), TWOFF(down), TWOFF(right), TWOFF(left), TWOFF(ulon), TWOFF(uloff),
+};
@@ -1,7 +1,45 @@
-/* C17 stub - original C++ implementation replaced */
-#include <stdio.h>
+/* C17 - no scaffold needed */
+/*
+ * tabvt100.c - DEC VT100 and compatible nroff driving table
+ *
+ * Bold through SGR 1 and underline through SGR 4, both ended with
+ * SGR 0, which the VT100 needs to end either; reverse line feed through
+ * reverse index; there are no half-line motions.  Linked into croff, and compiled to a
+ * table file by mktab.
+ */
+#define NROFF 1
+#include "../tdef.h"
 
-/* Stub implementation */
-void stub_function(void) {
-    /* Placeholder */
-}
+#define INCH 240
+
+struct typewriter_table twvt100 = {
+    0, /*bset*/
+    0, /*breset*/
+    INCH / 10, /*Hor*/
+    INCH / 6, /*Vert*/
+    INCH / 6, /*Newline*/
+    INCH / 10, /*Char*/
+    INCH / 10, /*Em*/
+    INCH / 12, /*Halfline*/
+    INCH / 10, /*Adj*/
+    "", /*twinit*/
+    "\033[0m", /*twrest*/
+    "\n", /*twnl*/
+    "", /*hlr*/
+    "", /*hlf*/
+    "\033M", /*flr*/
+    "\033[1m", /*bdon*/
+    "\033[0m", /*bdoff*/
+    "", /*ploton*/
+    "", /*plotoff*/
+    "", /*up*/
+    "", /*down*/
+    "", /*right*/
+    "", /*left*/
+    "\033[4m", /*ulon*/
+    "\033[0m", /*uloff*/
+    {
+#include "code.ascii"
+    },
+    0 /*zzz*/
+};
@@ -1,7 +1,46 @@
-/* C17 stub - original C++ implementation replaced */
-#include <stdio.h>
+/* C17 - no scaffold needed */
+/*
+ * tabvt220.c - DEC VT220 and VT320 nroff driving table
+ *
+ * As the VT100, with the cursor motions of ANSI X3.64, and bold and
+ * underline ended apart, with SGR 22 and SGR 24.  Index and
+ * reverse index move a whole line, so there are no half-line motions.
+ * Linked into croff as vt220 and vt320, and compiled to table files by
+ * mktab.
+ */
+#define NROFF 1
+#include "../tdef.h"
 
-/* Stub implementation */
-void stub_function(void) {
-    /* Placeholder */
-}
+#define INCH 240
+
+struct typewriter_table twvt220 = {
+    0, /*bset*/
+    0, /*breset*/
+    INCH / 10, /*Hor*/
+    INCH / 6, /*Vert*/
+    INCH / 6, /*Newline*/
+    INCH / 10, /*Char*/
+    INCH / 10, /*Em*/
+    INCH / 12, /*Halfline*/
+    INCH / 10, /*Adj*/
+    "", /*twinit*/
+    "\033[0m", /*twrest*/
+    "\n", /*twnl*/
+    "", /*hlr*/
+    "", /*hlf*/
+    "\033M", /*flr*/
+    "\033[1m", /*bdon*/
+    "\033[22m", /*bdoff*/
+    "", /*ploton*/
+    "", /*plotoff*/
+    "\033[A", /*up*/
+    "\033[B", /*down*/
+    "\033[C", /*right*/
+    "\033[D", /*left*/
+    "\033[4m", /*ulon*/
+    "\033[24m", /*uloff*/
+    {
+#include "code.ascii"
+    },
+    0 /*zzz*/
+};
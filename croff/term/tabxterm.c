@@ -0,0 +1,44 @@
+/* C17 - no scaffold needed */
+/*
+ * tabxterm.c - xterm and other UTF-8 terminal emulators
+ *
+ * As the ANSI table, with the special characters sent as UTF-8 (see
+ * code.utf8).  Linked into croff, and compiled to a table file by
+ * mktab.
+ */
+#define NROFF 1
+#include "../tdef.h"
+
+#define INCH 240
+
+struct typewriter_table twxterm = {
+    0, /*bset*/
+    0, /*breset*/
+    INCH / 10, /*Hor*/
+    INCH / 6, /*Vert*/
+    INCH / 6, /*Newline*/
+    INCH / 10, /*Char*/
+    INCH / 10, /*Em*/
+    INCH / 12, /*Halfline*/
+    INCH / 10, /*Adj*/
+    "", /*twinit*/
+    "\033[m", /*twrest*/
+    "\n", /*twnl*/
+    "", /*hlr*/
+    "", /*hlf*/
+    "\033M", /*flr*/
+    "\033[1m", /*bdon*/
+    "\033[22m", /*bdoff*/
+    "", /*ploton*/
+    "", /*plotoff*/
+    "\033[A", /*up*/
+    "\033[B", /*down*/
+    "\033[C", /*right*/
+    "\033[D", /*left*/
+    "\033[4m", /*ulon*/
+    "\033[24m", /*uloff*/
+    {
+#include "code.utf8"
+    },
+    0 /*zzz*/
+};
@@ -0,0 +1,49 @@
+/* C17 - no scaffold needed */
+/*
+ * twfile.h - Compiled nroff terminal tables
+ *
+ * mktab writes a struct typewriter_table as one position-independent
+ * file: this header, then its strings.  Every string is given by its
+ * offset from the start of the file, so the file can be mapped and
+ * used where it lies.  A code entry is its width byte followed by a
+ * NUL-terminated code; the last byte of the file is always a NUL, so
+ * no string can run off the end.
+ *
+ * The tables in twtabs[] are also linked into croff, which uses them
+ * without reading any file when -T names one of them.
+ */
+#ifndef TWFILE_H
+#define TWFILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TW_MAGIC "nrTW" /* first four bytes of a table file */
+#define TW_VERSION 2 /* bumped whenever the layout changes */
+#define TW_NINT 9 /* bset to Adj */
+#define TW_NSTR 16 /* twinit to uloff */
+#define TW_NCODE (256 - 32) /* codetab */
+
+struct twfile {
+    char magic[4];
+    uint32_t version;
+    uint32_t size; /* whole file, in bytes */
+    int32_t ints[TW_NINT];
+    uint32_t str[TW_NSTR];
+    uint32_t code[TW_NCODE];
+};
+
+/* A table built into the binary */
+struct twtab {
+    const char *name; /* as given to -T */
+    struct typewriter_table *tab;
+};
+
+extern const struct twtab twtabs[];
+extern const int ntwtabs;
+
+/* Where each field of struct typewriter_table lives, in file order */
+extern const size_t twintoff[TW_NINT];
+extern const size_t twstroff[TW_NSTR];
+
+#endif /* TWFILE_H */
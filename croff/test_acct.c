@@ -0,0 +1,114 @@
+/* C17 - no scaffold needed */
+/*
+ * test_acct.c - Tests for the batched accounting records
+ *
+ * Makes a spool in a temporary directory and checks its date line and
+ * that records kept past a batch all arrive, whole and in order.  Then
+ * has several processes append to one file at once and checks no
+ * record is torn or lost.
+ *
+ *   cc -std=c17 -O2 -Isrc croff/test_acct.c -o test_acct
+ */
+
+#define _GNU_SOURCE /* mkdtemp() */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "acct.c"
+
+static char dir[] = "/tmp/acctXXXXXX";
+static char spool[4096];
+
+static char *slurp(const char *name, long *n) {
+    FILE *fp;
+    char *s;
+
+    assert((fp = fopen(name, "r")) != NULL);
+    fseek(fp, 0, SEEK_END);
+    *n = ftell(fp);
+    rewind(fp);
+    assert((s = malloc(*n + 1)) != NULL);
+    assert(fread(s, 1, *n, fp) == (size_t)*n);
+    fclose(fp);
+    return (s);
+}
+
+/* The records after the date line: their count in *n */
+static struct acctrec *records(char *s, long len, long *n) {
+    char *nl = memchr(s, '\n', len);
+
+    assert(nl != NULL);
+    *n = (len - (nl + 1 - s)) / (long)sizeof(struct acctrec);
+    assert((len - (nl + 1 - s)) % (long)sizeof(struct acctrec) == 0);
+    return ((struct acctrec *)(nl + 1));
+}
+
+static void test_spool(void) {
+    struct acctrec *r;
+    char *s;
+    long len, n, k;
+
+    printf("Testing a spool of three batches...\n");
+    acctdir = dir;
+    assert(acctspool() >= 0);
+    snprintf(spool, sizeof(spool), "%s/troffactg.%ld", dir, (long)getpid());
+    for (k = 0; k < 2 * ACCTN + 5; k++)
+        acctput((int)k, 7);
+    acctflush();
+    s = slurp(spool, &len);
+    assert(s[0] != '\n');
+    r = records(s, len, &n);
+    assert(n == 2 * ACCTN + 5);
+    for (k = 0; k < n; k++)
+        assert(r[k].use == k && r[k].uid == 7 && r[k].spare == 0);
+    free(s);
+}
+
+static void test_writers(void) {
+    struct acctrec *r;
+    char *s;
+    long len, n, k;
+    int w, seen[4] = {0};
+
+    printf("Testing four processes appending at once...\n");
+    fflush(stdout);
+    for (w = 0; w < 4; w++) {
+        if (fork() == 0) {
+            for (k = 0; k < 1000; k++) {
+                acctput(1, w);
+                if (k % 3 == 0)
+                    acctflush();
+            }
+            acctflush();
+            _exit(0);
+        }
+    }
+    while (wait(NULL) > 0)
+        ;
+    s = slurp(spool, &len);
+    r = records(s, len, &n);
+    assert(n == 2 * ACCTN + 5 + 4000);
+    for (k = 2 * ACCTN + 5; k < n; k++) {
+        assert(r[k].use == 1 && r[k].uid >= 0 && r[k].uid < 4);
+        seen[r[k].uid]++;
+    }
+    for (w = 0; w < 4; w++)
+        assert(seen[w] == 1000);
+    free(s);
+}
+
+int main(void) {
+    printf("Starting accounting unit tests...\n\n");
+    assert(mkdtemp(dir) != NULL);
+    test_spool();
+    test_writers();
+    unlink(spool);
+    rmdir(dir);
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
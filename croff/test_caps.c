@@ -0,0 +1,104 @@
+/* C17 - no scaffold needed */
+/*
+ * test_caps.c - Tests for the -C resource caps
+ *
+ * Builds caps.c with prstr() and the done functions caught here, and
+ * checks that -C is read with a cap given twice keeping the lower, that
+ * nothing is capped until capstart(), that each hook passes at its cap
+ * and fails past it with the diagnostic naming it, and that the caps
+ * are disarmed for the ending.  Last, the processor cap: a loop that
+ * spins past a second is stopped by SIGXCPU.
+ *
+ *   cc -std=c17 -O2 -I. -Icroff -Isrc croff/test_caps.c -o test_caps
+ */
+
+#define _GNU_SOURCE /* struct rusage */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <setjmp.h>
+
+#include "caps.c"
+
+static jmp_buf back;
+static char said[256];
+static int status;
+
+void prstr(const char *s) {
+    snprintf(said, sizeof(said), "%s", s);
+}
+
+void done2(int x) {
+    status = x;
+    longjmp(back, 1);
+}
+
+void done3(int x) {
+    status = x;
+    longjmp(back, 2);
+}
+
+/* Whether hook(n) ends the run; said holds the diagnostic if so */
+#define ENDS(hook) (said[0] = 0, status = 0, setjmp(back) ? 1 : ((hook), 0))
+
+static void test_set(void) {
+    char opt[] = "-Cm64,d8,s20,o1,t1";
+    char again[] = "-Cm128,s10,x5,o0";
+
+    printf("Testing -C and its caps given twice...\n");
+    capset(opt + 2);
+    capset(again + 2);
+    assert(capv[CAP_MACRO] == 64 && capv[CAP_DIV] == 8 && capv[CAP_DEPTH] == 10);
+    assert(capv[CAP_OUT] == 1 && capv[CAP_CPU] == 1);
+    assert(capopt == again);
+    assert(capblk == 0 && capdepth == 0 && capdiv == 0 && capout == 0);
+    assert(!ENDS(CAPBLK(1000)) && !ENDS(CAPDEPTH(1000)));
+}
+
+static void test_hooks(void) {
+    printf("Testing each hook at its cap and past it...\n");
+    capv[CAP_CPU] = 0; /* armed by itself, last */
+    capstart();
+    assert(capblk == 64 * 1024 / (BLK * sizeof(int)) && capdepth == 10);
+    assert(capdiv == 8 * 1024 / sizeof(int) && capout == 1024);
+
+    assert(!ENDS(CAPBLK(capblk)));
+    assert(ENDS(CAPBLK(capblk + 1)) && status == 0100);
+    assert(strcmp(said, "Cap on macro storage of 64 KB reached.\n") == 0);
+    assert(capblk == 0 && capdepth == 0 && !ENDS(CAPDEPTH(11))); /* disarmed */
+
+    capdepth = 10;
+    assert(ENDS(CAPDEPTH(11)));
+    assert(strcmp(said, "Cap on call depth of 10 frames reached.\n") == 0);
+
+    capdiv = 8 * 1024 / sizeof(int);
+    capdw[1] = 0;
+    while (!ENDS(CAPDIV(1)))
+        ;
+    assert(capdw[1] == 8 * 1024 / (long)sizeof(int) + 1);
+    assert(strstr(said, "diversion size of 8 KB") != NULL);
+}
+
+static void test_cpu(void) {
+    volatile unsigned long spin = 0;
+
+    printf("Testing the processor cap...\n");
+    caparmed = 0;
+    capv[CAP_CPU] = 1;
+    capstart();
+    if (setjmp(back) == 0)
+        for (;;)
+            spin++;
+    assert(status == 0100 && spin > 0);
+}
+
+int main(void) {
+    printf("Starting caps unit tests...\n\n");
+    test_set();
+    test_hooks();
+    test_cpu();
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
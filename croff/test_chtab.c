@@ -0,0 +1,72 @@
+/* C17 - no scaffold needed */
+/*
+ * test_chtab.c - Tests for the special character hash
+ *
+ * Checks chtab_hash.h against chtab itself: for every two-byte name,
+ * the hash lookup setch() makes finds what a scan of chtab finds, the
+ * first entry for a name given twice; chrev[] gives, for every code,
+ * the first name in chtab with it; and every name utftab gives a code
+ * point is in chtab, with no code point given twice and no plain
+ * stand-in the input syntax gives a meaning.
+ *
+ *   cc -std=c17 -O2 -Wno-multichar -Icroff croff/test_chtab.c -o test_chtab
+ */
+
+#include <stdio.h>
+#include <assert.h>
+
+#include "ntab.c"
+
+/* What setch() found before the hash */
+static int scan(int name) {
+    int *k;
+
+    for (k = chtab; *k != name; k += 2)
+        if (*k == 0)
+            return (0);
+    return (k[1]);
+}
+
+static void test_names(void) {
+    unsigned h;
+    int name, found;
+
+    printf("Testing every two-byte name...\n");
+    for (name = 1; name < 1 << 16; name++) {
+        h = CHHASH(name);
+        found = chhname[h] == name ? chhcode[h] : 0;
+        assert(found == scan(name));
+    }
+}
+
+static void test_reverse(void) {
+    int *k, j;
+
+    printf("Testing the reverse index...\n");
+    for (j = 0; j < 256; j++) {
+        for (k = chtab; *k != 0 && k[1] != j; k += 2)
+            ;
+        assert(chrev[j] == *k);
+    }
+}
+
+static void test_utf(void) {
+    int *u, *w;
+
+    printf("Testing the UTF-8 input table...\n");
+    for (u = utftab; *u != 0; u += 2) {
+        assert((u[1] < 0200) ? (u[1] > 040) : (scan(u[1]) != 0));
+        assert((u[1] != '.') && (u[1] != '\'') && (u[1] != '"') && (u[1] != '\\'));
+        for (w = utftab; w < u; w += 2)
+            assert(*w != *u);
+    }
+}
+
+int main(void) {
+    printf("Starting chtab unit tests...\n\n");
+    test_names();
+    test_reverse();
+    test_utf();
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
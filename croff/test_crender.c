@@ -0,0 +1,243 @@
+/* C17 - no scaffold needed */
+/*
+ * test_crender.c - Tests for croff -I and crender
+ *
+ * Drives the terminal driver of n10.c with a long run of random lines,
+ * motions and font changes, once straight to the device and once
+ * through ipage.c, and checks that crender turns the stream back into
+ * the same bytes with one thread and with several, for a table with
+ * plotting, one with bold and tabs, and one sending UTF-8.  The pages
+ * split wherever the stream marks one, including between the items of
+ * a line, and runs of one glyph come back as their copies.  One stream
+ * fanned out to terminals of the same widths renders for each what it
+ * renders for that terminal alone.
+ *
+ *   cc -std=gnu17 -pthread -Icroff -Isrc croff/test_crender.c croff/twload.c \
+ *       croff/term/tab37.c croff/term/tabvt100.c croff/term/tabvt220.c \
+ *       croff/term/tabansi.c croff/term/tabxterm.c croff/term/tabs.c -o test_crender
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#define CRENDER_LIB
+#include "crender.c"
+#include "ipage.c"
+
+struct env tenv;
+
+enum { OP_ITEM, OP_NL, OP_LEAD, OP_ESC, OP_PAGE };
+
+struct op {
+    int op, a, b;
+};
+
+#define NOPS 60000
+
+static struct op ops[NOPS];
+static int nops;
+static unsigned long seed = 1;
+
+static int rnd(int n) {
+    seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+    return (int)((seed >> 33) % (unsigned long)n);
+}
+
+/* Lines of glyphs, spaces and motions, with now and then a page */
+static void mkops(void) {
+    struct op *o;
+    int i, k;
+
+    for (nops = 0; nops < NOPS - 2;) {
+        o = &ops[nops++];
+        k = rnd(100);
+        if (k < 60) {
+            o->op = OP_ITEM;
+            i = rnd(4) ? 041 + rnd(0176 - 041) : (rnd(2) ? ' ' : 0200 + rnd(0140));
+            if (rnd(3) == 0)
+                i |= (rnd(4) << 9) | ((1 + rnd(15)) << 11);
+            if (rnd(20) == 0)
+                i |= ZBIT;
+            else if (((i & CMASK) > 040) && (rnd(30) == 0))
+                i |= (2 + rnd(20)) << 16; /* a run */
+            o->a = i;
+        } else if (k < 70) {
+            o->op = OP_ITEM;
+            i = rnd(3 * t.Em);
+            o->a = MOT | (rnd(4) ? 0 : VMOT) | (rnd(3) ? 0 : NMOT) | i;
+        } else if (k < 85) {
+            o->op = OP_NL;
+            o->a = t.Newline * rnd(3) + (rnd(4) ? 0 : t.Halfline);
+            o->b = rnd(5) ? 0 : t.Newline;
+        } else if (k < 90) {
+            o->op = OP_LEAD;
+            o->a = rnd(2 * t.Newline) - t.Newline / 2;
+        } else if (k < 95) {
+            o->op = OP_ESC;
+            o->a = rnd(10 * t.Em) - 2 * t.Em;
+        } else {
+            o->op = OP_PAGE;
+        }
+    }
+    ops[nops].op = OP_NL;
+    ops[nops++].a = t.Newline;
+}
+
+static void reset(struct rbuf *b) {
+    rout = b;
+    b->n = 0;
+    lead = esc = esct = xfont = bdmode = plotmode = 0;
+    ulfont = 1;
+    olinep = oline;
+    dip = &tenv;
+    memset(&tenv, 0, sizeof(tenv));
+}
+
+/* What croff does: uses lss, blss and alss around each newline */
+static void play(int pages) {
+    struct op *o;
+    int pn = 1;
+
+    for (o = ops; o < ops + nops; o++)
+        switch (o->op) {
+        case OP_ITEM:
+            ptout(o->a);
+            break;
+        case OP_NL:
+            lss = t.Newline;
+            dip->blss = o->a;
+            dip->alss = o->b;
+            ptout('\n');
+            break;
+        case OP_LEAD:
+            lead += o->a;
+            ptlead();
+            break;
+        case OP_ESC:
+            esc += o->a;
+            ptlead();
+            break;
+        case OP_PAGE:
+            if (pages)
+                ippage(++pn);
+            break;
+        }
+}
+
+static void check(const char *name, int hf) {
+    struct rbuf direct = {0}, stream = {0};
+    char tmpl[] = "/tmp/crenderXXXXXX";
+    char *got;
+    int fd, nj;
+
+    printf("Testing %s...\n", name);
+    strcpy(&termtab[tti], name);
+    hflg = hf;
+    ipflg = 0;
+    reset(&direct);
+    ptinit();
+    mkops();
+    play(0);
+    oputs(t.twrest);
+
+    ipflg = 1;
+    iphdr = ipfont = ipsize = 0;
+    ipul = -1;
+    reset(&stream);
+    play(1);
+    ipdone();
+    ipflg = 0;
+
+    got = malloc(direct.n + 1);
+    for (nj = 1; nj <= 8; nj *= 2) {
+        fd = mkstemp(tmpl);
+        assert(fd >= 0);
+        unlink(tmpl);
+        crender_run((unsigned char *)stream.p, (unsigned char *)stream.p + stream.n, fd, nj);
+        assert(lseek(fd, 0, SEEK_END) == (off_t)direct.n);
+        assert(pread(fd, got, direct.n, 0) == (ssize_t)direct.n);
+        assert(memcmp(got, direct.p, direct.n) == 0);
+        close(fd);
+        strcpy(tmpl, "/tmp/crenderXXXXXX");
+    }
+    printf("  %zu device bytes from %zu stream bytes\n", direct.n, stream.n);
+    free(got);
+    free(direct.p);
+    free(stream.p);
+}
+
+/* A temporary file, gone once closed */
+static int tmpfd(void) {
+    char tmpl[] = "/tmp/crenderXXXXXX";
+    int fd;
+
+    fd = mkstemp(tmpl);
+    assert(fd >= 0);
+    unlink(tmpl);
+    return fd;
+}
+
+/* All that was written to fd */
+static char *slurp(int fd, off_t *n) {
+    char *b;
+
+    *n = lseek(fd, 0, SEEK_END);
+    b = malloc((size_t)*n + 1);
+    assert(pread(fd, b, (size_t)*n, 0) == (ssize_t)*n);
+    return b;
+}
+
+static void check_fan(void) {
+    static char *const names[] = {"vt100", "xterm", "ansi"};
+    struct rbuf stream = {0};
+    char *want, *got;
+    off_t nw, ng;
+    int fd[3], k, one;
+
+    printf("Testing one stream fanned out...\n");
+    strcpy(&termtab[tti], "vt100");
+    hflg = 0;
+    reset(&stream);
+    ptinit();
+    mkops();
+    ipflg = 1;
+    iphdr = ipfont = ipsize = 0;
+    ipul = -1;
+    reset(&stream);
+    play(1);
+    ipdone();
+    ipflg = 0;
+    for (k = 0; k < 3; k++)
+        fd[k] = tmpfd();
+    assert(crender_fan((unsigned char *)stream.p, (unsigned char *)stream.p + stream.n, 3, names,
+                       fd, 2) == 0);
+    for (k = 0; k < 3; k++) {
+        strcpy(&termtab[tti], names[k]);
+        one = tmpfd();
+        crender_run((unsigned char *)stream.p, (unsigned char *)stream.p + stream.n, one, 2);
+        want = slurp(one, &nw);
+        got = slurp(fd[k], &ng);
+        assert(nw > 0 && ng == nw && memcmp(got, want, (size_t)nw) == 0);
+        free(want);
+        free(got);
+        close(one);
+        close(fd[k]);
+    }
+    assert(crender_fan((unsigned char *)stream.p, (unsigned char *)stream.p + stream.n, 1,
+                       (char *const[]){"no such terminal"}, (int[]){-1}, 1) < 0);
+    free(stream.p);
+}
+
+int main(void) {
+    printf("Starting crender unit tests...\n\n");
+
+    check("37", 0);
+    check("vt100", 1);
+    check("xterm", 0);
+    check_fan();
+
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
@@ -0,0 +1,135 @@
+/* C17 - no scaffold needed */
+/*
+ * test_diag.c - Tests for the diagnostics diag.c holds
+ *
+ * Builds diag.c with ttyod a file read back here, and a flusho() that
+ * writes a mark to it and hands back to dgsent() as obuf.c does.
+ * Nothing is written until the buffer is flushed; prstrfl()'s messages
+ * go after the output.  Under -Qn a line goes out n times and the rest
+ * are counted, to be told at exit; a line too long to count always
+ * goes out.  -Qj writes JSON objects, quoted.
+ *
+ *   cc -std=gnu17 -Icroff -Isrc croff/test_diag.c -o test_diag
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+
+#include "diag.c"
+
+int ttyod;
+static int nflush;
+
+void flusho(void) {
+    nflush++;
+    assert(write(ttyod, "[out]", 5) == 5);
+    dgsent();
+}
+
+static char got[16384];
+
+/* What has been written since the last call */
+static const char *written(void) {
+    ssize_t n;
+
+    n = pread(ttyod, got, sizeof(got) - 1, 0);
+    assert(n >= 0);
+    got[n] = 0;
+    assert(ftruncate(ttyod, 0) == 0);
+    lseek(ttyod, 0, SEEK_SET);
+    return (got);
+}
+
+static void test_held(void) {
+    printf("Testing messages held until flushed...\n");
+    dgput("Cannot open ", 0);
+    dgput("x.tr", 0);
+    dgput("\n", 0);
+    dgput("Too many number registers.\n", 0);
+    assert(strcmp(written(), "") == 0);
+    dgflush();
+    assert(strcmp(written(), "Cannot open x.tr\nToo many number registers.\n") == 0);
+    dgput("name:", 0); /* a prompt, with no newline */
+    dgflush();
+    assert(strcmp(written(), "name:") == 0);
+    assert(nflush == 0);
+}
+
+static void test_order(void) {
+    printf("Testing prstrfl() after the output...\n");
+    dgput("Core limit reached.\n", 1);
+    dgput("Core limit reached.\n", 1);
+    dgflush();
+    assert(nflush == 1);
+    assert(strcmp(written(), "[out]Core limit reached.\nCore limit reached.\n") == 0);
+    /* flusho() lets the messages out itself */
+    dgput("Cannot do ev.\n", 0);
+    flusho();
+    assert(strcmp(written(), "[out]Cannot do ev.\n") == 0);
+}
+
+static void test_repeats(void) {
+    char line[DGLINE + 32];
+    int k;
+
+    printf("Testing repeats held back...\n");
+    dgarg("2");
+    assert(dglim == 2 && !dgjson);
+    for (k = 0; k < 5; k++) {
+        dgput("Word overflow.\n", 0);
+        if (k == 1)
+            dgput("Line overflow.\n", 0);
+    }
+    dgflush();
+    assert(strcmp(written(), "Word overflow.\nWord overflow.\nLine overflow.\n") == 0);
+    memset(line, 'x', sizeof(line) - 2);
+    line[sizeof(line) - 2] = '\n';
+    line[sizeof(line) - 1] = 0;
+    for (k = 0; k < 3; k++)
+        dgput(line, 0);
+    dgflush();
+    assert(strlen(written()) == 3 * strlen(line));
+    dgexit();
+    assert(strcmp(written(), "3 more of: Word overflow.\n") == 0);
+}
+
+static void test_json(void) {
+    printf("Testing JSON lines...\n");
+    dglim = 0;
+    dgarg("j");
+    assert(dgjson && !dglim);
+    dgput("Cannot open \"a\\b\"\t\n", 0);
+    dgput("Cannot open \"a\\b\"\t\n", 0);
+    dgput("User Abort.", 0);
+    dgflush();
+    assert(strcmp(written(), "{\"msg\":\"Cannot open \\\"a\\\\b\\\"\\u0009\",\"n\":1}\n"
+                             "{\"msg\":\"Cannot open \\\"a\\\\b\\\"\\u0009\",\"n\":2}\n"
+                             "{\"msg\":\"User Abort.\"}\n") == 0);
+    dgarg("1j");
+    dgput("Bad return.\n", 0);
+    dgput("Bad return.\n", 0);
+    dgexit();
+    written();
+    assert(strncmp(got, "{\"msg\":\"Bad return.\",\"n\":1}\n", 28) == 0);
+    assert(strstr(got, "{\"msg\":\"Bad return.\",\"dropped\":1}\n") != NULL);
+}
+
+int main(void) {
+    char name[] = "/tmp/test_diagXXXXXX";
+
+    printf("Starting diagnostics unit tests...\n\n");
+
+    assert((ttyod = mkstemp(name)) >= 0);
+    unlink(name);
+    test_held();
+    test_order();
+    test_repeats();
+    test_json();
+
+    printf("\nAll tests passed successfully!\n");
+    dglim = dgjson = 0;
+    return 0;
+}
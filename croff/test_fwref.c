@@ -0,0 +1,174 @@
+/* C17 - no scaffold needed */
+/*
+ * test_fwref.c - Tests for the forward references of .fs and .fn
+ *
+ * Builds fwref.c with the request arguments, the string and register
+ * values and the held output of obuf.c caught here.  Declared names
+ * interpolate as columns that say which reference and column they are,
+ * and names not declared as they stand.  The columns marked in the
+ * output are then written in with the values at the end: a string from
+ * the left without its escapes, a register from the right, one that is
+ * too wide cut short.  Last, the hash still finds every name after the
+ * table has grown.
+ *
+ *   cc -std=c17 -O2 -DNROFF -Wno-multichar -I. -Icroff -Isrc croff/test_fwref.c -o test_fwref
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "fwref.c"
+
+/* What fwref.c takes from the rest of croff */
+struct contab *contab;
+int cbuf[NC], *cp, nonumb, noscale, ipflg;
+
+#define PG ('p' | ('g' << BYTE))
+#define SN ('s' | ('n' << BYTE))
+
+static struct contab slots[2] = {{SN | MMASK, {.offset = 0}}, {0}};
+static int body[32]; /* the body of string sn */
+static int reg[8]; /* the text of register pg */
+static int args[8], nargs, argi; /* name, then width, of each request */
+static char held[256], msgs[256];
+static int nheld = -1, released;
+
+int skip(void) { return (argi >= nargs); }
+int getrq(void) { return (args[argi++]); }
+int tatoi(void) {
+    nonumb = 0;
+    return (args[argi++]);
+}
+int findmn(int i) { return ((i == SN) ? 0 : -1); }
+int rbf0(int p) { return (body[p]); }
+int incoff(int p) { return (p + 1); }
+int *nrchars(int i) {
+    assert(i == PG);
+    return (reg);
+}
+void prstr(const char *s) { strcat(msgs, s); }
+void obhold(void) { nheld = 0; }
+long obat(void) { return (nheld); }
+char *obheld(size_t *n) {
+    *n = (size_t)nheld;
+    return (held);
+}
+void obrelease(void) {
+    nheld = -1;
+    released = 1;
+}
+
+/* Run request f on name and width */
+static void request(void (*f)(void), int name, int w) {
+    args[0] = name;
+    args[1] = w;
+    nargs = 2;
+    argi = 0;
+    f();
+}
+
+/* Put out the columns of the reference at cp, as ptout1() would */
+static void putout(void) {
+    for (; *cp; cp++) {
+        fwmark(*cp);
+        held[nheld++] = ' ';
+    }
+    cp = NULL;
+}
+
+static void text(const char *s, int *w) {
+    while (*s)
+        *w++ = (unsigned char)*s++;
+    *w = 0;
+}
+
+static void test_declare(void) {
+    printf("Testing declarations...\n");
+    contab = slots;
+    request(casefs, SN, 3);
+    request(casefn, PG, 4);
+    request(casefs, PG, 0); /* no width */
+    request(casefs, PG, FWMAX + 1);
+    ipflg = 1;
+    request(casefs, PG, 2);
+    ipflg = 0;
+    assert(nfw == 2);
+    request(casefs, SN, 5);
+    assert(nfw == 2 && fwtab[0].width == 5 && !fwtab[0].reg && fwtab[1].reg);
+    request(casefs, SN, 3);
+}
+
+static void test_text(void) {
+    int j;
+
+    printf("Testing the columns interpolated...\n");
+    assert(!fwtext(PG, 0) && !fwtext(SN, 1) && !fwtext('x', 0) && cp == NULL);
+    assert(fwtext(PG, 1) && cp == cbuf);
+    for (j = 0; j < 4; j++)
+        assert(((cbuf[j] & CMASK) == FWHOLE) && (FWID(cbuf[j]) == 1) && (FWCOL(cbuf[j]) == j) &&
+               !(cbuf[j] & MOT));
+    assert(cbuf[4] == 0);
+}
+
+static void test_done(void) {
+    printf("Testing the values written in...\n");
+    nheld = -1; /* the first column holds the output */
+    fwtext(SN, 0);
+    putout();
+    held[nheld++] = '|';
+    fwtext(PG, 1);
+    putout();
+    held[nheld] = 0;
+    assert(strcmp(held, "   |    ") == 0);
+    body[0] = ESC;
+    body[1] = 'f';
+    body[2] = 'B';
+    text("4.2", &body[3]);
+    body[6] = ESC;
+    body[7] = 'f';
+    body[8] = 'P';
+    body[9] = 0;
+    text("12", reg);
+    fwdone();
+    assert(released && strcmp(held, "4.2|  12") == 0 && msgs[0] == 0);
+
+    printf("Testing a value too wide...\n");
+    nheld = -1;
+    released = 0;
+    fwtext(SN, 0);
+    putout();
+    held[nheld] = 0;
+    text("1.2.3", body);
+    fwdone();
+    assert(released && strcmp(held, "1.2") == 0);
+    assert(strcmp(msgs, "Forward reference sn wider than its 3 columns.\n") == 0);
+    released = 0;
+    fwdone(); /* nothing put out since */
+    assert(!released);
+}
+
+static void test_many(void) {
+    int k;
+
+    printf("Testing many names...\n");
+    for (k = 0; k < 500; k++)
+        request(casefs, 'a' + k * 7, 1 + k % FWMAX);
+    assert(nfw == 502);
+    for (k = 0; k < 500; k++)
+        assert(fwfind('a' + k * 7, 0) == k + 2 && fwtab[k + 2].width == 1 + k % FWMAX);
+    assert(fwfind(SN, 0) == 0 && fwfind(PG, 1) == 1 && fwfind(PG, 0) < 0);
+    fwroom(nfw); /* as snapget() leaves it */
+    assert(fwfind('a' + 499 * 7, 0) == 501);
+}
+
+int main(void) {
+    printf("Starting forward reference unit tests...\n\n");
+    test_declare();
+    test_text();
+    test_done();
+    test_many();
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
@@ -0,0 +1,153 @@
+/* C17 - no scaffold needed */
+/*
+ * test_libcroff.c - Tests for croff as a library
+ *
+ * Formats a document through one context and then through several at
+ * once, one to a thread, each fed in small pieces with its output taken
+ * as it goes, and checks that every context writes something, the same
+ * as the first did, exits 0 and takes its options without complaint.
+ * The formatters write -I pages, which are output even with no text on
+ * them.  Also checks that croff_take() does not wait before croff_end(),
+ * that feeding after it is an error, and that freeing a context before
+ * its end stops the formatter.
+ *
+ *   make libcroff
+ *   cc -std=gnu17 -O2 -pthread -Icroff croff/test_libcroff.c build/lib/libcroff.a -lm -o test_libcroff
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "libcroff.h"
+
+#define NTHREADS 8
+#define PIECE 37 /* bytes given to each croff_feed() */
+#define MAXOUT (1L << 20)
+#define MAXDIAG 4096
+
+static const char doc[] = ".ll 60\n.pl 20\n.nr x 3\n"
+                          ".de hd\n'sp 2\n..\n.wh 0 hd\n"
+                          "Input consists of text lines, which are destined to be printed,\n"
+                          "interspersed with control lines, which set parameters or otherwise\n"
+                          "control subsequent processing.\n.sp\n.ce\nA centred line \\nx\n"
+                          ".bp\nA second page.\n";
+
+static FILE *diag; /* the formatters' standard error */
+static pthread_mutex_t diaglock = PTHREAD_MUTEX_INITIALIZER;
+
+/* A context that writes its diagnostics to diag, for diagcheck() */
+static croff_t *diaginit(int argc, char **argv) {
+    croff_t *f;
+    int fd;
+
+    assert(pthread_mutex_lock(&diaglock) == 0);
+    fflush(stderr);
+    assert((fd = dup(2)) >= 0 && dup2(fileno(diag), 2) == 2);
+    f = croff_init(argc, argv); /* the child keeps the fd 2 it forks with */
+    assert(dup2(fd, 2) == 2);
+    close(fd);
+    assert(pthread_mutex_unlock(&diaglock) == 0);
+    return f;
+}
+
+/* Pass on what the formatters wrote; none may have refused an option */
+static void diagcheck(void) {
+    static char buf[MAXDIAG];
+    size_t n;
+
+    rewind(diag);
+    n = fread(buf, 1, sizeof(buf) - 1, diag);
+    buf[n] = '\0';
+    fputs(buf, stderr);
+    assert(strstr(buf, "Unknown option") == NULL);
+}
+
+struct run {
+    char *out;
+    long nout;
+    int status;
+};
+
+/* Format doc through a context of its own, taking output between pieces */
+static void *format(void *arg) {
+    struct run *r = arg;
+    croff_t *f;
+    size_t k, n;
+    ssize_t got;
+
+    assert((f = diaginit(1, (char *[]){"-I", NULL})) != NULL);
+    assert((r->out = malloc(MAXOUT)) != NULL);
+    r->nout = 0;
+    for (k = 0; k < sizeof(doc) - 1; k += n) {
+        n = sizeof(doc) - 1 - k < PIECE ? sizeof(doc) - 1 - k : PIECE;
+        assert(croff_feed(f, doc + k, n) == 0);
+        while ((got = croff_take(f, r->out + r->nout, MAXOUT - r->nout)) > 0)
+            r->nout += got;
+        assert(got == -1 && errno == EAGAIN);
+    }
+    assert(croff_end(f) == 0);
+    while ((got = croff_take(f, r->out + r->nout, MAXOUT - r->nout)) > 0)
+        r->nout += got;
+    assert(got == 0);
+    r->status = croff_free(f);
+    return NULL;
+}
+
+static void test_one(struct run *first) {
+    printf("Testing one context...\n");
+    format(first);
+    assert(first->status == 0);
+    assert(first->nout > 0);
+}
+
+static void test_threads(const struct run *first) {
+    pthread_t t[NTHREADS];
+    struct run r[NTHREADS];
+    int k;
+
+    printf("Testing %d contexts at once...\n", NTHREADS);
+    for (k = 0; k < NTHREADS; k++)
+        assert(pthread_create(&t[k], NULL, format, &r[k]) == 0);
+    for (k = 0; k < NTHREADS; k++) {
+        assert(pthread_join(t[k], NULL) == 0);
+        assert(r[k].status == 0);
+        assert(r[k].nout > 0);
+        assert(r[k].nout == first->nout && memcmp(r[k].out, first->out, first->nout) == 0);
+        free(r[k].out);
+    }
+}
+
+static void test_misuse(void) {
+    croff_t *f;
+
+    printf("Testing feeding after the end...\n");
+    assert((f = croff_init(0, NULL)) != NULL);
+    assert(croff_end(f) == 0);
+    assert(croff_feed(f, "x\n", 2) == -1 && errno == EPIPE);
+    assert(croff_free(f) >= 0);
+
+    printf("Testing freeing before the end...\n");
+    assert((f = croff_init(0, NULL)) != NULL);
+    assert(croff_feed(f, doc, sizeof(doc) - 1) == 0);
+    assert(croff_free(f) == -1);
+}
+
+int main(void) {
+    struct run first;
+
+    printf("Starting libcroff unit tests...\n\n");
+    assert((diag = tmpfile()) != NULL);
+    test_one(&first);
+    test_threads(&first);
+    diagcheck();
+    fclose(diag);
+    test_misuse();
+    free(first.out);
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
@@ -0,0 +1,127 @@
+/* C17 - no scaffold needed */
+/*
+ * test_lig.c - Tests for ligature forming in getlg()
+ *
+ * Builds n6.c against a terminal table that has some of the ligature
+ * codes, feeds getlg() input through a getlook() and getdrop() of its
+ * own, and checks the ligature formed, how many letters it took, and
+ * that a code the terminal lacks, a letter in another font, .lg 2 and a
+ * change of table are each respected.
+ *
+ *   cc -std=c17 -O2 -DNROFF -Wno-multichar -I. -Icroff croff/test_lig.c -o test_lig
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "n6.c"
+
+/* What n6.c takes from the rest of croff */
+struct typewriter_table t;
+struct variable_state v;
+char trtab[256];
+int eschar = '\\', widthp, ohc, xfont, smnt, setwdf, chbits, nonumb, noscale, font, font1;
+int pts, sps, nlflg, nform, dfact, dfactd, lss, lss1, vflag, ch0, level, ch, res, xxx, lg = 1;
+int getrq(void) { return (0); }
+int getch(void) { return (0); }
+void skip(void) {}
+int getstr(void) { return (0); }
+void setn1(int value) { (void)value; }
+int tatoi(void) { return (0); }
+int makem(int value) { return (value); }
+int quant(int value, int direction) { (void)direction; return (value); }
+
+/* The input getlg() looks at */
+static int in[8];
+static int taken;
+
+int getlook(int n) {
+    return (n < 8 ? in[taken + n] : 0);
+}
+
+void getdrop(int n) {
+    taken += n;
+}
+
+/* Feed s, in font f, and form a ligature from its leading 'f' */
+static int lig(const char *s, int f) {
+    int k, b = f << (BYTE + 1);
+
+    memset(in, 0, sizeof(in));
+    for (k = 0; s[k + 1] && k < 7; k++)
+        in[k] = s[k + 1] | b;
+    taken = 0;
+    return (getlg(s[0] | b));
+}
+
+static char two[] = "\002ff", twoi[] = "\002fi", twol[] = "\002fl";
+static char threei[] = "\003ffi", threel[] = "\003ffl";
+
+static void terminal(int ff) {
+    int c;
+
+    memset(&t, 0, sizeof(t));
+    t.Char = 1;
+    for (c = 040; c < 0200; c++)
+        t.codetab[c - 32] = "\001";
+    t.codetab[0213 - 32] = ff ? two : NULL;
+    t.codetab[0211 - 32] = twoi;
+    t.codetab[0212 - 32] = twol;
+    t.codetab[0214 - 32] = threei;
+    t.codetab[0215 - 32] = NULL; /* no ffl */
+    for (c = 0; c < 256; c++)
+        trtab[c] = (char)c;
+    widflush();
+}
+
+static void test_forms(void) {
+    printf("Testing the ligatures formed...\n");
+    terminal(1);
+    assert(lig("fi", 0) == 0211 && taken == 1);
+    assert(lig("fl", 1) == (0212 | 1 << (BYTE + 1)) && taken == 1);
+    assert(lig("ffi", 0) == 0214 && taken == 2);
+    assert(lig("ffx", 0) == 0213 && taken == 1);
+    assert(lig("ffl", 0) == 0213 && taken == 1); /* no ffl here */
+    assert(lig("fx", 0) == 'f' && taken == 0);
+    assert(lig("f", 0) == 'f' && taken == 0);
+}
+
+static void test_fonts(void) {
+    printf("Testing letters in another font...\n");
+    terminal(1);
+    memset(in, 0, sizeof(in));
+    in[0] = 'i' | 2 << (BYTE + 1);
+    taken = 0;
+    assert(getlg('f') == 'f' && taken == 0);
+    in[0] = 'f';
+    in[1] = 'i' | 1 << (BYTE + 1);
+    assert(getlg('f') == 0213 && taken == 1);
+}
+
+static void test_modes(void) {
+    printf("Testing .lg 2 and a new table...\n");
+    terminal(1);
+    lg = 2;
+    lgflush();
+    assert(lig("ffi", 0) == 0213 && taken == 1);
+    lg = 1;
+    lgflush();
+    terminal(0); /* ffi, but no ff */
+    assert(lig("ffi", 0) == 0214 && taken == 2);
+    assert(lig("ffx", 0) == 'f' && taken == 0);
+    assert(lig("fi", 0) == 0211 && taken == 1);
+    widthp = 7;
+    widflush();
+    lig("fi", 0);
+    assert(widthp == 7);
+}
+
+int main(void) {
+    printf("Starting ligature unit tests...\n\n");
+    test_forms();
+    test_fonts();
+    test_modes();
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
@@ -70,7 +70,7 @@ int cwidth = 0, ip = 0, nlflg = 0;
 int *nxf = NULL, *ap = NULL, *frame = NULL, *stk = NULL;
 int donef = 0, nflush = 0, nchar = 0, rchar = 0;
 int nfo = 0, ifile = 0, fc = 0, padc = 0, tabc = 0, dotc = 0;
-int raw = 0, tabtab[NTAB];
+int raw = 0;
 char nextf[NS];
 int nfi = 0;
 int ifl[NSO], offl[NSO], ipl[NSO], ifi = 0;
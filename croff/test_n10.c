@@ -0,0 +1,405 @@
+/* C17 - no scaffold needed */
+/*
+ * test_n10.c - Tests for ptout1() glyph spans in n10.c
+ *
+ * Loads a small terminal table by hand, builds the glyph spans with
+ * glyphinit() and checks that ptout1() emits, for every character in
+ * plain, underlined, zero-width and bold use, the bytes the old
+ * byte-by-byte loop produced.  A character with a plot sequence is laid
+ * out as the commands plot() makes, but only on a terminal that can plot.
+ * Whole-column motion under -h must land on the right column in no
+ * more bytes than tabs and spaces or backspaces would take.  A column
+ * of a forward reference is a blank, marked where it goes out.  A run
+ * of one glyph puts out what its copies one by one would.  A table with
+ * ulon underlines with it, around the characters and not the motion;
+ * on a table of SGR strings a change of font is one SGR sequence, and
+ * an off that ends every attribute puts back the others.
+ *
+ *   cc -std=gnu17 -Icroff -Isrc croff/test_n10.c -o test_n10
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "n10.c"
+
+struct typewriter_table t;
+TroffProcessor g_processor;
+int lss, xfont, esc, lead, ulfont = 1, esct, sps, ics, ttysave, ttys[3];
+int ptid, waitf, pipeflg, eqflg, hflg, xxx;
+void tsdef(int w) { (void)w; }
+char termtab[] = "/dev/null";
+int tti;
+int oline[LNSIZE];
+int *olinep = oline;
+struct env *dip;
+
+static char out[8192];
+static int nout;
+
+void oput(int c) {
+    assert(nout < (int)sizeof(out));
+    out[nout++] = (char)c;
+}
+
+void oputn(const char *s, int n) {
+    while (n-- > 0)
+        oput(*s++);
+}
+
+void flusho(void) {}
+void prstr(const char *s) { fputs(s, stderr); }
+int stty(int fd, int *args) { (void)fd; (void)args; return 0; }
+void widflush(void) {}
+int twload(const char *path, const char *name) { (void)path; (void)name; return 0; }
+int ipflg;
+void ipout(int i) { (void)i; }
+void iplead(void) {}
+void ipstop(void) {}
+void ipdone(void) {}
+
+int pmflg;
+void pmline(const int *q, int n, int down) { (void)q; (void)n; (void)down; }
+void pmlead(void) {}
+void pmstop(void) {}
+
+static int marks[8], nmarks, markat[8];
+void fwmark(int i) {
+    markat[nmarks] = nout;
+    marks[nmarks++] = i;
+}
+
+static char zero[1];
+
+/* Font bits of an oline[] item as ptout1() decodes them */
+#define FONT(f) (04000 | ((f) << 9))
+
+/* Width byte, then code: "\001a" is one character wide and prints a */
+static void loadtab(void) {
+    char buf[8];
+    int k;
+
+    t.Char = 24;
+    t.Em = 24;
+    t.hlf = t.hlr = t.flr = "";
+    dtab = 8 * t.Em;
+    t.bdon = "\033B";
+    t.bdoff = "\033b";
+    t.ploton = "<";
+    t.plotoff = ">";
+    t.up = "U";
+    t.down = "D";
+    t.right = "R";
+    t.left = "L";
+    for (k = 0; k < 256 - 32; k++) {
+        if (k + 32 < 0177) {
+            buf[0] = 1;
+            buf[1] = (char)(k + 32);
+            buf[2] = 0;
+        } else if (k + 32 < 0200) {
+            buf[0] = 0; /* the zzz sentinel of ptinit() */
+            buf[1] = 0;
+        } else {
+            /* two wide, overstruck */
+            buf[0] = 2;
+            buf[1] = 'o';
+            buf[2] = '\b';
+            buf[3] = (char)('A' + k % 26);
+            buf[4] = 0;
+        }
+        t.codetab[k] = buf[0] || buf[1] ? strdup(buf) : zero;
+    }
+    /* A plotted character: right 2, a dot, then the end of the plot */
+    t.codetab['~' - 32] = "\001\200\202.\200";
+    glyphinit();
+}
+
+/* What ptout1() wrote for the oline[] items given */
+static const char *emit(const int *items, int n) {
+    int k;
+
+    nout = 0;
+    for (k = 0; k < n; k++)
+        oline[k] = items[k];
+    olinep = oline + n;
+    ptout1();
+    out[nout] = 0;
+    return out;
+}
+
+/* The old loop for a character without plotting, bold aside */
+static int expect(char *buf, int c, int ul, int zw) {
+    char *codep;
+    int n, k, len;
+
+    codep = t.codetab[c - 32];
+    n = *codep++ & 0177;
+    len = 0;
+    for (k = 0; ul && k < n; k++)
+        buf[len++] = '_';
+    for (k = 0; ul && k < n; k++)
+        buf[len++] = '\b';
+    while (*codep)
+        buf[len++] = *codep++;
+    for (k = 0; zw && k < n; k++)
+        buf[len++] = '\b';
+    buf[len] = 0;
+    return len;
+}
+
+static void test_spans(void) {
+    char buf[64];
+    int c, ul, zw, item, len;
+
+    printf("Testing glyph spans...\n");
+    for (c = 041; c < 0400; c++) {
+        if (c == '~' || c == FWHOLE)
+            continue;
+        for (ul = 0; ul < 2; ul++)
+            for (zw = 0; zw < 2; zw++) {
+                item = c | (zw ? ZBIT : 0);
+                xfont = ul ? ulfont : 0;
+                bdmode = 0;
+                len = expect(buf, c, ul, zw);
+                emit(&item, 1);
+                assert(nout == len && memcmp(out, buf, (size_t)len) == 0);
+            }
+    }
+}
+
+static void test_bold(void) {
+    int items[3];
+
+    printf("Testing bold...\n");
+    xfont = 0;
+    bdmode = 0;
+    items[0] = 'a' | FONT(2);
+    items[1] = 'b';
+    items[2] = 'c' | FONT(3);
+    emit(items, 3);
+    assert(strcmp(out, "\033Bab\033bc") == 0);
+    assert(bdmode == 0);
+}
+
+/* With ulon, no underscores: the attribute goes on and off */
+static void test_ulattr(void) {
+    int items[6];
+
+    printf("Testing underlining by attribute...\n");
+    t.ulon = "[U";
+    t.uloff = "[u";
+    glyphinit();
+    xfont = 0;
+    bdmode = ulmode = 0;
+    items[0] = 'a' | FONT(1);
+    items[1] = 'b' | FONT(1);
+    items[2] = MOT | t.Char;
+    items[3] = 0204 | FONT(1) | ZBIT;
+    items[4] = 'c' | FONT(0);
+    emit(items, 5);
+    assert(strcmp(out, "[Uab[u [Uo\bW\b\b[uc") == 0);
+    /* an underline open at the end of the line is closed */
+    emit(items, 2);
+    assert(strcmp(out, "[Uab[u") == 0 && ulmode == 0);
+    t.ulon = t.uloff = NULL;
+    glyphinit();
+    xfont = 0;
+}
+
+/* SGR tables: what changes goes out as one sequence */
+static void test_sgr(void) {
+    int items[4];
+
+    printf("Testing SGR sequences...\n");
+    t.bdon = "\033[1m";
+    t.bdoff = "\033[0m";
+    t.ulon = "\033[4m";
+    t.uloff = "\033[24m";
+    glyphinit();
+    xfont = 0;
+    bdmode = ulmode = 0;
+    items[0] = 'a' | FONT(2);
+    items[1] = 'b' | FONT(1);
+    items[2] = 'c' | FONT(2);
+    items[3] = 'd' | FONT(0);
+    emit(items, 4);
+    /* the bold off ends the underline too, so the underline is put back */
+    assert(strcmp(out, "\033[1ma\033[0;4mb\033[24;1mc\033[0md") == 0);
+    /* as the VT100: only SGR 0 ends an underline */
+    t.bdoff = "\033[22m";
+    t.uloff = "\033[m";
+    glyphinit();
+    ulfont = 2;
+    emit(items, 1);
+    assert(strcmp(out, "\033[1;4ma\033[0;1m") == 0 && bdmode && !ulmode);
+    ulfont = 1;
+    t.bdon = "\033B";
+    t.bdoff = "\033b";
+    t.ulon = t.uloff = NULL;
+    glyphinit();
+    xfont = bdmode = 0;
+}
+
+/* Without a plot mode, codes with the 0200 bit are sent as they are */
+static void test_noplot(void) {
+    char *ploton = t.ploton;
+    int item;
+
+    printf("Testing UTF-8 codes...\n");
+    t.ploton = "";
+    t.codetab['~' - 32] = "\001\342\200\242";
+    glyphinit();
+    xfont = 0;
+    bdmode = plotmode = 0;
+    item = '~';
+    emit(&item, 1);
+    assert(strcmp(out, "\342\200\242") == 0);
+    t.ploton = ploton;
+    t.codetab['~' - 32] = "\001\200\202.\200";
+    glyphinit();
+}
+
+static void test_plot(void) {
+    int item;
+
+    printf("Testing plotted characters...\n");
+    xfont = 0;
+    bdmode = plotmode = 0;
+    item = '~';
+    emit(&item, 1);
+    assert(strcmp(out, "<RR.> ") == 0);
+    assert(plotmode == 0);
+    /* laid out ahead like any other span, underlined and zero-width too */
+    item = '~' | FONT(1) | ZBIT;
+    emit(&item, 1);
+    assert(strcmp(out, "_\b<RR.> \b") == 0);
+    xfont = 0;
+}
+
+/* Column a terminal with tabs every 8 ends on */
+static int column(int c, const char *s, int n) {
+    for (; n > 0; n--, s++)
+        switch (*s) {
+        case '\t':
+            c = (c / 8 + 1) * 8;
+            break;
+        case ' ':
+            c++;
+            break;
+        case '\b':
+            if (c > 0)
+                c--;
+            break;
+        case '\r':
+            c = 0;
+            break;
+        default:
+            assert(0);
+        }
+    return c;
+}
+
+/* Bytes move() took to go from column c0 to c1 */
+static int moveto(int c0, int c1) {
+    nout = 0;
+    esct = c0 * t.Em;
+    esc = (c1 - c0) * t.Em;
+    lead = 0;
+    move();
+    out[nout] = 0;
+    assert(column(c0, out, nout) == c1);
+    return nout;
+}
+
+static void test_motion(void) {
+    int c0, c1, old;
+
+    printf("Testing motion plans...\n");
+    hflg = 0;
+    assert(moveto(0, 7) == 7 && strcmp(out, "       ") == 0);
+    assert(moveto(30, 1) == 29);
+    hflg = 1;
+    for (c0 = 0; c0 < 60; c0++)
+        for (c1 = 0; c1 < 60; c1++) {
+            old = c1 >= c0 ? (c1 / 8 - c0 / 8) + (c1 / 8 > c0 / 8 ? c1 % 8 : c1 - c0) : c0 - c1;
+            assert(moveto(c0, c1) <= old);
+        }
+    moveto(0, 7);
+    assert(strcmp(out, "\t\b") == 0);
+    moveto(30, 1);
+    assert(strcmp(out, "\r ") == 0);
+    moveto(3, 17);
+    assert(strcmp(out, "\t\t ") == 0);
+    hflg = 0;
+}
+
+static void test_fwhole(void) {
+    int items[4];
+
+    printf("Testing forward reference columns...\n");
+    xfont = ulfont;
+    bdmode = 0;
+    esc = lead = esct = 0;
+    items[0] = 'a';
+    items[1] = FWHOLE | (5 << 16);
+    items[2] = MOT | t.Char;
+    items[3] = FWHOLE | (5 << 16) | (1 << 27);
+    emit(items, 4);
+    assert(strcmp(out, "_\ba   ") == 0);
+    assert(nmarks == 2 && markat[0] == 3 && markat[1] == 5 && marks[1] == items[3]);
+    assert(esct == 4 * t.Char);
+    xfont = 0;
+}
+
+/* A run of n c's must put out what n items of c do */
+static void runof(int c, int n) {
+    static int items[LNSIZE];
+    static char one[4096];
+    int k, len;
+
+    assert(n <= LNSIZE);
+    for (k = 0; k < n; k++)
+        items[k] = c;
+    esct = 0;
+    emit(items, n);
+    len = nout;
+    memcpy(one, out, len + 1);
+    k = c | (n << 16);
+    esct = 0;
+    emit(&k, 1);
+    assert(nout == len && memcmp(out, one, len) == 0);
+    assert(esct == ((c & ZBIT) ? 0 : n * t.Char * (*t.codetab[(c & CMASK) - 32] & 0177)));
+}
+
+static void test_runs(void) {
+    printf("Testing runs of one glyph...\n");
+    xfont = 0;
+    bdmode = plotmode = 0;
+    runof('.' | FONT(0), 2);
+    runof('_' | FONT(0), 100);
+    runof('x' | FONT(1), 7); /* underlined */
+    runof('y' | FONT(1), 300); /* more than a buffer of them */
+    runof(0204 | FONT(0), 3); /* two wide */
+    runof('~' | FONT(0), 4); /* plotted */
+    xfont = 0;
+}
+
+int main(void) {
+    printf("Starting n10 unit tests...\n\n");
+
+    loadtab();
+    test_spans();
+    test_bold();
+    test_ulattr();
+    test_sgr();
+    test_plot();
+    test_noplot();
+    test_motion();
+    test_fwhole();
+    test_runs();
+
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
@@ -69,6 +69,7 @@ int app = 0, ds = 0, nlflg = 0, nchar = 0, pendt = 0, rchar = 0, dilev = 0;
 int nonumb = 0, lt = 80, nrbits = 0, nform = 0, oldmn = 0, newmn = 0, macerr = 0;
 int apptr = 0, offset = 0, aplnk = 0, diflg = 0, woff = 0, roff = 0, wbfi = 0, po = 0, xxx = 0;
 char *enda = NULL;
+int ibfopen(void *arg) { (void)arg; return -1; }
 int *nxf = NULL, *argtop = NULL, *ap = NULL, *frame = NULL, *stk = NULL, *cp = NULL;
 struct env *dip = NULL;
 int fmt[256];
@@ -97,8 +98,6 @@ void Wolf(void) {}
 int seek(int fd, long offset, int whence) { return 0; }
 void prstr(char *s) { printf("%s", s); }
 void prstrfl(char *s) { printf("%s", s); }
-ssize_t sys_read(int fd, void *buf, size_t count) { return count; }
-ssize_t sys_write(int fd, const void *buf, size_t count) { return count; }
 
 /* Include function prototypes from n3.c */
 static int hash_function(int key);
@@ -28,7 +28,6 @@ int *hyptr[NHYP];
 int **hyp;
 int hyoff;
 int suffid;
-char *sufind[26];
 int noscale;
 int xxx;
 
@@ -108,12 +107,6 @@ int getch(void) {
     return 'a'; /* Mock implementation */
 }
 
-unsigned char suftab_get_byte(size_t index) {
-    /* Mock implementation */
-    (void)index;
-    return 0;
-}
-
 /* ================================================================
  * CHARACTER CLASSIFICATION TESTS
  * ================================================================ */
@@ -242,35 +235,6 @@ void test_find_next_vowel(void) {
     TEST_PASS();
 }
 
-void test_find_max_digram(void) {
-    TEST_START("find_max_digram function");
-
-    /* Setup test word */
-    static int test_word[] = {'h', 'e', 'l', 'l', 'o', 0};
-    wdstart = test_word;
-    wdend = test_word + 4;
-
-    int maxval = 0;
-    int *result = find_max_digram(test_word, test_word + 3, &maxval);
-
-    /* Should return some position in range */
-    ASSERT_TRUE(result != NULL, "Should find a position");
-    ASSERT_TRUE(result >= test_word && result < test_word + 3, "Should be in range");
-    ASSERT_TRUE(maxval > 0, "Should have positive digram value");
-
-    /* Test invalid inputs */
-    result = find_max_digram(NULL, test_word + 3, &maxval);
-    ASSERT_TRUE(result == NULL, "Should handle NULL start");
-
-    result = find_max_digram(test_word, NULL, &maxval);
-    ASSERT_TRUE(result == NULL, "Should handle NULL end");
-
-    result = find_max_digram(test_word + 3, test_word, &maxval);
-    ASSERT_TRUE(result == NULL, "Should handle start >= end");
-
-    TEST_PASS();
-}
-
 /* ================================================================
  * INTEGRATION TESTS
  * ================================================================ */
@@ -310,6 +274,147 @@ void test_chkvow_function(void) {
     TEST_PASS();
 }
 
+void test_exception_words(void) {
+    static int word[] = {'P', 'r', 'e', 's', 'e', 'n', 't', 's', 0};
+    char w[] = {'p', 'r', 'e', 's' | 0200, 'e', 'n', 't', 0};
+    char tmp[] = "/tmp/test_n8XXXXXX";
+    FILE *fp;
+    int fd;
+
+    TEST_START("exception words");
+
+    ASSERT_EQUAL(0, hxadd(w), "Adding a word should succeed");
+    wdstart = word;
+    hyend = wdend = word + 6;
+    hyp = hyptr;
+    ASSERT_EQUAL(1, exword(), "Exact word should be found");
+    ASSERT_TRUE(hyp == hyptr + 1 && hyptr[0] == word + 3,
+                "Hyphen should fall before the 's'");
+
+    /* A trailing 's' is allowed */
+    hyend = wdend = word + 7;
+    hyp = hyptr;
+    ASSERT_EQUAL(1, exword(), "Plural should be found");
+
+    /* A prefix of an exception is not one */
+    hyend = wdend = word + 5;
+    hyp = hyptr;
+    ASSERT_EQUAL(0, exword(), "Prefix should not be found");
+
+    /* Words from a file, replacing the earlier hyphenation */
+    fd = mkstemp(tmp);
+    ASSERT_TRUE(fd >= 0 && (fp = fdopen(fd, "w")) != NULL,
+                "Should create exception file");
+    fprintf(fp, "# house style\nta-ble\npres-ent  re-cord\n");
+    fclose(fp);
+    ASSERT_EQUAL(0, hxload(tmp), "Exception file should load");
+    remove(tmp);
+    hyend = wdend = word + 6;
+    hyp = hyptr;
+    ASSERT_EQUAL(1, exword(), "Reloaded word should be found");
+    ASSERT_TRUE(hyp == hyptr + 1 && hyptr[0] == word + 4,
+                "File entry should replace the earlier one");
+    ASSERT_EQUAL(-1, hxload("/nonexistent/words"), "Missing file should fail");
+
+    TEST_PASS();
+}
+
+void test_digram(void) {
+    static const struct {
+        const char *w;
+        int brk[3]; /* Breaks found, last first, 0-terminated */
+    } words[] = {{"concatenation", {9, 3}}, {"understanding", {9, 5, 2}},
+                 {"algorithm", {5, 2}}, {"hello", {3}}};
+    int word[32];
+    int i, k, n;
+
+    TEST_START("digram analysis");
+
+    for (i = 0; i < (int)(sizeof(words) / sizeof(words[0])); i++) {
+        for (n = 0; words[i].w[n]; n++)
+            word[n] = words[i].w[n];
+        wdstart = word;
+        hyend = wdend = word + n - 1;
+        hyp = hyptr;
+        digram();
+        for (k = 0; k < 3 && words[i].brk[k]; k++)
+            ASSERT_TRUE(hyp > hyptr + k && hyptr[k] == word + words[i].brk[k], words[i].w);
+        ASSERT_TRUE(hyp == hyptr + k, words[i].w);
+    }
+
+    TEST_PASS();
+}
+
+/* Suffix analysis as a scan of every entry for the final letter */
+static int refsuffix(void) {
+    const unsigned char *s, *s0;
+    int *w;
+    int i;
+
+again:
+    if (hyend < wdstart || !alph(i = *hyend & CMASK))
+        return 0;
+    if (i < 'a')
+        i += 'a' - 'A';
+    if ((s0 = suftab_entries(i - 'a')) == NULL)
+        return 0;
+    for (;; s0 += i) {
+        if ((i = *s0 & 017) == 0)
+            return 0;
+        s = s0 + i - 1;
+        for (w = hyend - 1; s > s0 && w >= wdstart && (*s & 0177) == maplow(*w); w--)
+            s--;
+        if (s == s0)
+            break;
+    }
+    s = s0 + i - 1;
+    w = hyend;
+    if ((*s0 & 0200) && !sufmark(s0, w))
+        return 0;
+    while (s > s0) {
+        w--;
+        if ((*s-- & 0200) && !sufmark(s0, w))
+            return 0;
+    }
+    if (*s0 & 040)
+        return 0;
+    if (exword())
+        return 1;
+    goto again;
+}
+
+void test_suffix(void) {
+    static const char *words[] = {
+        "happiness", "nationalization", "walked", "beautifully",
+        "organizations", "computer", "kindness", "repeatedly",
+        "hopelessness", "quietly", "Sympathizes", "capability",
+        "stationary", "thinking", "boxes", "s", "presents", NULL};
+    int word[32], *want[NHYP];
+    int i, k, n, r;
+
+    TEST_START("suffix trie");
+
+    for (i = 0; words[i]; i++) {
+        for (n = 0; words[i][n]; n++)
+            word[n] = words[i][n];
+        word[n] = 0;
+        wdstart = word;
+        hyend = wdend = word + n - 1;
+        hyp = hyptr;
+        r = refsuffix();
+        k = hyp - hyptr;
+        memcpy(want, hyptr, k * sizeof(*want));
+
+        hyend = wdend;
+        hyp = hyptr;
+        ASSERT_EQUAL(r, suffix(), words[i]);
+        ASSERT_TRUE(hyp - hyptr == k && !memcmp(want, hyptr, k * sizeof(*want)),
+                    words[i]);
+    }
+
+    TEST_PASS();
+}
+
 /* ================================================================
  * MAIN TEST RUNNER
  * ================================================================ */
@@ -326,11 +431,13 @@ void run_all_tests(void) {
 
     /* Helper function tests */
     test_find_next_vowel();
-    test_find_max_digram();
+    test_digram();
     test_chkvow_function();
 
     /* Integration tests */
     test_hyphenation_threshold();
+    test_exception_words();
+    test_suffix();
 
     printf("\n==========================================\n");
     printf("Test Results:\n");
@@ -0,0 +1,161 @@
+/* C17 - no scaffold needed */
+/*
+ * test_n9.c - Tests for the overstrikes setov() keeps
+ *
+ * Builds n9.c with getch() reading a string given here and width()
+ * counting its calls.  An overstrike built again makes the same sequence
+ * in cbuf without measuring its characters, and leaves widthp as they
+ * did; one in another font is measured, and a change of tables (widgen),
+ * or a backspace or the escape character among the characters, builds
+ * it anew.
+ *
+ * The tabs and fields of setfield() are set against stops tabstop.c
+ * keeps: a plain tab's run of its character and the motion left over, a
+ * right or centred tab's text taken up to the next tab, the stops of a
+ * repeated pattern, and a field's room shared out at its pad.
+ *
+ *   cc -std=c17 -O2 -DNROFF -Wno-multichar -I. -Icroff -Isrc croff/test_n9.c -o test_n9
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "n9.c"
+#include "tabstop.c"
+
+/* What n9.c takes from the rest of croff */
+struct typewriter_table t;
+int cbuf[NC], *cp, ch, chbits, dfact = 1, vflag, fc, padc, tabtab[NTAB];
+int lss, tabch, ldrch, nchar, rchar, widgen, widthp, ohc, eschar = '\\';
+int ev, nlflg, tabc, dotc;
+struct variable_state v;
+int quant(int val, int factor_type) { (void)factor_type; return (val); }
+int tatoi(void) { return (0); }
+void getmap(void) {}
+int makem(int i) { return ((i < 0) ? (MOT | NMOT | -i) : (MOT | i)); }
+
+static const int *in;
+static int nwidth;
+
+static int nzero; /* "Zero field width." */
+
+void prstr(const char *s) { nzero += (strcmp(s, "Zero field width.\n") == 0); }
+int getch(void) { return (*in ? *in++ : '\n'); }
+
+/* 'i' one wide, the rest two, in font 1 twice as wide again */
+int width(int c) {
+    nwidth++;
+    return (widthp = (((c & CMASK) == 'i') ? 1 : 2) * ((c & 04000) ? 2 : 1) * 24);
+}
+
+#define FONT1 04000
+
+/* \o'...' on s, the characters in font f, into seq; the widths taken */
+static int over(const char *s, int f, int *seq) {
+    static int buf[NOV + 4];
+    int k, n;
+
+    for (k = 0; s[k]; k++)
+        buf[k] = (s[k] == '\'') ? '\'' : ((unsigned char)s[k] | f);
+    buf[k] = 0;
+    in = buf;
+    nwidth = 0;
+    cp = NULL;
+    setov();
+    assert(cp == cbuf);
+    for (n = 0; cbuf[n]; n++)
+        seq[n] = cbuf[n];
+    seq[n] = 0;
+    return (nwidth);
+}
+
+static void test_again(void) {
+    int a[2 * NOV + 2], b[2 * NOV + 2];
+
+    printf("Testing an overstrike built again...\n");
+    assert(over("'io'", 0, a) == 2);
+    /* o widest first, then i, back half their widths, then right */
+    assert(a[0] == 'o' && a[1] == (MOT | NMOT | 36) && a[2] == 'i' && a[3] == (MOT | NMOT | 12) &&
+           a[4] == (MOT | 24) && a[5] == 0);
+    widthp = 0;
+    assert(over("'io'", 0, b) == 0 && widthp == 48); /* as the last width() left it */
+    assert(memcmp(a, b, sizeof(int) * 6) == 0);
+    assert(over("'oi'", 0, b) == 2); /* the same two the other way round */
+    assert(over("'oi'", 0, b) == 0 && memcmp(a, b, sizeof(int) * 6) == 0);
+    assert(over("'io'", FONT1, b) == 2 && b[4] == (MOT | 48));
+}
+
+static void test_stale(void) {
+    int a[2 * NOV + 2];
+
+    printf("Testing overstrikes built anew...\n");
+    over("'+-'", 0, a);
+    assert(over("'+-'", 0, a) == 0);
+    widgen++;
+    assert(over("'+-'", 0, a) == 2);
+    assert(over("'+-'", 0, a) == 0);
+    assert(over("'a\bb'", 0, a) == 3 && over("'a\bb'", 0, a) == 3);
+    assert(over("'a\\b'", 0, a) == 3 && over("'a\\b'", 0, a) == 3);
+}
+
+/* setfield(x) at position hp, with the input s after it */
+static int field(int x, int hp, const int *s) {
+    in = s;
+    v.hp = hp;
+    nchar = 0;
+    cp = NULL;
+    return (setfield(x));
+}
+
+static void test_field(void) {
+    static const int none[] = {0}, right[] = {'o', 'i', '\t', 0}, centre[] = {'o', 'i', 0},
+                     pad[] = {'^', 'o', 'i', '#', 0};
+
+    printf("Testing tabs and fields against the stops...\n");
+    t.Hor = 1;
+    tabch = '\t';
+    ldrch = 001;
+    tabc = 'i';
+    dotc = '.';
+    tsdef(0);
+    assert(field('\t', 10, none) == 0 && nzero == 0);
+    tsadd(100, 0);
+    /* 90 to go: three i's and 18 over */
+    assert(field('\t', 10, none) == (MOT | 18) && nchar == 3 && rchar == 'i');
+    assert(tabch == '\t' && ldrch == 001 && fc == 0);
+    assert(field(001, 10, none) == (MOT | 90 % 48) && nchar == 90 / 48 && rchar == '.');
+
+    tsclear();
+    tsadd(200, RTAB);
+    assert(field('\t', 0, right) == (MOT | 8) && nchar == 5);
+    assert(cp != NULL && cp[0] == 'o' && cp[1] == 'i' && cp[2] == '\t' && cp[3] == 0);
+    tsclear();
+    tsadd(200, CTAB);
+    assert(field('\t', 0, centre) == (MOT | 20) && nchar == 6 && cp[2] == '\n');
+
+    tsclear();
+    tsadd(50, 0);
+    tsrep();
+    tsadd(100, 0);
+    assert(field('\t', 1000, none) == (MOT | 2) && nchar == 2); /* to 1050 */
+
+    tsclear();
+    tsadd(100, 0);
+    fc = '#';
+    padc = '^';
+    assert(field('#', 0, pad) == 0 && cp != NULL);
+    assert(cp[0] == (MOT | 28) && cp[1] == 'o' && cp[2] == 'i' && cp[3] == 0);
+    tsclear();
+    assert(field('#', 0, pad) == 0 && nzero == 1 && fc == '#');
+    fc = padc = 0;
+}
+
+int main(void) {
+    printf("Starting overstrike unit tests...\n\n");
+    test_again();
+    test_stale();
+    test_field();
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
@@ -0,0 +1,365 @@
+/* C17 - no scaffold needed */
+/*
+ * test_obuf.c - Tests and microbenchmark for the output ring
+ *
+ * Runs oput() and flusho() from obuf.c into a file, where the writer
+ * thread is used, and into a pipe drained slowly by a child, and checks
+ * that every byte arrives in order and that flusho() returns only once
+ * its output is on the descriptor.  A FIFO with no reader stands in for
+ * a busy typesetter under -w, checking that output gathers in the ring
+ * until it can be opened, and that -W gives up.  obtap() is checked to
+ * copy what follows it, and obhold() to keep it back until it has been
+ * written in and released.  A reader that goes away must end the run,
+ * not hang it, whether the writer thread or the formatter meets it.
+ * Each case runs in its own process,
+ * since the ring picks how to write on first use.  Finally times
+ * oput() into /dev/null, reporting megabytes per second.
+ *
+ *   cc -std=gnu17 -O2 -pthread -Icroff -Isrc croff/test_obuf.c -o test_obuf
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "obuf.c"
+
+#define TESTN 300000 /* bytes written by each case */
+#define BENCHN (64L << 20) /* bytes written by the benchmark */
+
+TroffProcessor g_processor;
+int ptid;
+int waitf;
+int ascii = 1;
+int no_out;
+int toolate;
+char ptname[64] = "/dev/null";
+
+void prstr(const char *s) {
+    fputs(s, stderr);
+}
+void dgsent(void) {}
+
+void done3(int x) {
+    exit(x ? 3 : 0);
+}
+
+/* No -C cap here */
+long long capout;
+void capfail(int what) {
+    (void)what;
+}
+
+/* As in n2.c */
+static void oput(int i) {
+    if (g_processor.outputPtr == g_processor.outputEnd)
+        obnext();
+    *g_processor.outputPtr++ = ((char)i);
+}
+
+static int pat(long i) {
+    return (int)('a' + (i * 7 + i / 4099) % 26);
+}
+
+static long fsize(int fd) {
+    struct stat st;
+
+    assert(fstat(fd, &st) == 0);
+    return (long)st.st_size;
+}
+
+/* Run f in a child and require it to exit 0 */
+static void fork1(const char *name, void (*f)(void)) {
+    int st;
+    pid_t p;
+
+    printf("Testing %s...\n", name);
+    fflush(stdout);
+    if ((p = fork()) == 0) {
+        f();
+        exit(0);
+    }
+    assert(p > 0 && waitpid(p, &st, 0) == p);
+    assert(WIFEXITED(st) && WEXITSTATUS(st) == 0);
+}
+
+/* A small ring, so that the formatter has to wait for the writer */
+static void tfile(void) {
+    char tmpl[] = "/tmp/obufXXXXXX";
+    char *buf;
+    long i, half;
+
+    ptid = mkstemp(tmpl);
+    assert(ptid >= 0);
+    unlink(tmpl);
+    obsize = 16;
+    half = TESTN / 2;
+    for (i = 0; i < half; i++)
+        oput(pat(i));
+    flusho();
+    assert(obmode == 2);
+    assert(fsize(ptid) == half);
+    for (; i < TESTN; i++)
+        oput(pat(i));
+    flusho();
+    assert(fsize(ptid) == TESTN);
+    assert(toolate == 1);
+
+    buf = malloc(TESTN);
+    assert(pread(ptid, buf, TESTN, 0) == TESTN);
+    for (i = 0; i < TESTN; i++)
+        assert(buf[i] == pat(i));
+    free(buf);
+}
+
+/* A reader that takes its time at the other end of a pipe */
+static void tpipe(void) {
+    char buf[997];
+    int fd[2], st;
+    long i, n;
+    ssize_t r;
+    pid_t p;
+
+    assert(pipe(fd) == 0);
+    if ((p = fork()) == 0) {
+        close(fd[1]);
+        for (n = 0; (r = read(fd[0], buf, sizeof(buf))) > 0; n += r) {
+            for (i = 0; i < r; i++)
+                if (buf[i] != pat(n + i))
+                    exit(1);
+            if (n % 20 == 0)
+                usleep(100);
+        }
+        exit(n == TESTN ? 0 : 2);
+    }
+    close(fd[0]);
+    ptid = fd[1];
+    for (i = 0; i < TESTN; i++)
+        oput(pat(i));
+    flusho();
+    close(ptid);
+    assert(waitpid(p, &st, 0) == p);
+    assert(WIFEXITED(st) && WEXITSTATUS(st) == 0);
+}
+
+/* As catch() in n1.c does for SIGPIPE, done3() flushing on the way out */
+static void tcatch(int signo) {
+    (void)signo;
+    no_out++;
+    flusho();
+    done3(01);
+}
+
+/* Write into a pipe whose reader has gone, with a ring of size kilobytes */
+static void tgone1(int size) {
+    int fd[2], st;
+    long i;
+    pid_t p;
+
+    assert(pipe(fd) == 0);
+    if ((p = fork()) == 0) {
+        close(fd[0]);
+        signal(SIGPIPE, tcatch);
+        alarm(10); /* a hang fails the case */
+        ptid = fd[1];
+        obsize = size;
+        for (i = 0; i < TESTN; i++)
+            oput(pat(i));
+        flusho();
+        exit(0);
+    }
+    close(fd[0]);
+    close(fd[1]);
+    assert(waitpid(p, &st, 0) == p);
+    assert(WIFEXITED(st) && WEXITSTATUS(st) == 3);
+}
+
+/* The reader goes: EPIPE to the writer thread, SIGPIPE without one */
+static void tepipe(void) {
+    tgone1(16);
+    tgone1(1);
+}
+
+/* obtap() copies what is written from then on, over segments and flushes */
+static void ttap(void) {
+    char tmpl[] = "/tmp/obufXXXXXX";
+    char *b;
+    size_t n;
+    long i;
+
+    ptid = mkstemp(tmpl);
+    assert(ptid >= 0);
+    unlink(tmpl);
+    obsize = 16;
+    for (i = 0; i < 1000; i++)
+        oput(pat(i));
+    obtap();
+    for (; i < 50000; i++) {
+        oput(pat(i));
+        if (i == 20000)
+            flusho();
+    }
+    b = obtake(&n);
+    assert(b && n == 49000);
+    for (i = 0; i < 49000; i++)
+        assert(b[i] == pat(i + 1000));
+    free(b);
+    oput('x');
+    assert(obtake(&n) == NULL);
+    obtap();
+    b = obtake(&n);
+    assert(b && n == 0);
+    free(b);
+    flusho();
+    assert(fsize(ptid) == 50001);
+}
+
+static void thold(void) {
+    char tmpl[] = "/tmp/obufXXXXXX";
+    char *b, buf[16];
+    size_t n;
+    long i;
+
+    ptid = mkstemp(tmpl);
+    assert(ptid >= 0);
+    unlink(tmpl);
+    obsize = 16;
+    assert(obat() == -1);
+    for (i = 0; i < 1000; i++)
+        oput(pat(i));
+    flusho();
+    obhold();
+    assert(obat() == 0);
+    for (; i < 50000; i++) {
+        oput(pat(i));
+        if (i == 20000)
+            flusho();
+    }
+    assert(obat() == 49000);
+    assert(fsize(ptid) == 1000);
+    b = obheld(&n);
+    assert(n == 49000);
+    for (i = 0; i < 49000; i++)
+        assert(b[i] == pat(i + 1000));
+    memcpy(b + 100, "patched", 7);
+    obrelease();
+    assert(obat() == -1 && fsize(ptid) == 50000);
+    oput('x');
+    flusho();
+    assert(fsize(ptid) == 50001);
+    assert(pread(ptid, buf, 7, 1100) == 7 && memcmp(buf, "patched", 7) == 0);
+}
+
+/* Non-ASCII output keeps the terminator after every flush */
+static void tnul(void) {
+    char tmpl[] = "/tmp/obufXXXXXX";
+    char buf[8];
+
+    ptid = mkstemp(tmpl);
+    assert(ptid >= 0);
+    unlink(tmpl);
+    ascii = 0;
+    oput('a');
+    flusho();
+    oput('b');
+    flusho();
+    assert(fsize(ptid) == 4);
+    assert(pread(ptid, buf, 4, 0) == 4);
+    assert(memcmp(buf, "a\0b\0", 4) == 0);
+}
+
+/*
+ * A FIFO with no reader cannot be opened without blocking, like a busy
+ * typesetter.  The first segments stay in the ring; the reader appears
+ * only after them, and flusho() must then wait for it and write all.
+ */
+static void tbusy(void) {
+    char buf[997];
+    int fd, st;
+    long i, n;
+    ssize_t r;
+    pid_t p;
+
+    snprintf(ptname, sizeof(ptname), "/tmp/obuf%ld", (long)getpid());
+    assert(mkfifo(ptname, 0600) == 0);
+    waitf = 1;
+    for (i = 0; i < 3 * OBUFSZ; i++)
+        oput(pat(i));
+    assert(obmode == 0 && ptid == 0);
+    assert(obcount == 2);
+    if ((p = fork()) == 0) {
+        usleep(200000);
+        fd = open(ptname, O_RDONLY);
+        for (n = 0; (r = read(fd, buf, sizeof(buf))) > 0; n += r)
+            for (i = 0; i < r; i++)
+                if (buf[i] != pat(n + i))
+                    exit(1);
+        exit(n == TESTN ? 0 : 2);
+    }
+    for (; i < TESTN; i++)
+        oput(pat(i));
+    flusho();
+    assert(ptid > 0 && obmode != 0);
+    close(ptid);
+    unlink(ptname);
+    assert(waitpid(p, &st, 0) == p);
+    assert(WIFEXITED(st) && WEXITSTATUS(st) == 0);
+}
+
+/* -W gives up on a device that never appears, through done3(1) */
+static void tgone(void) {
+    int st;
+    pid_t p;
+
+    snprintf(ptname, sizeof(ptname), "/tmp/obuf%ld", (long)getpid());
+    assert(mkfifo(ptname, 0600) == 0);
+    waitf = 1;
+    obdevwait = 1;
+    if ((p = fork()) == 0) {
+        oput('a');
+        flusho();
+        exit(0);
+    }
+    assert(waitpid(p, &st, 0) == p);
+    unlink(ptname);
+    assert(WIFEXITED(st) && WEXITSTATUS(st) == 3);
+}
+
+static void bench(void) {
+    struct timespec t0, t1;
+    double t;
+    long i;
+
+    ptid = open("/dev/null", O_WRONLY);
+    assert(ptid >= 0);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (i = 0; i < BENCHN; i++)
+        oput(pat(i));
+    flusho();
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    t = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    printf("%-10s %8ld MB %10.1f MB/sec\n", "oput", BENCHN >> 20,
+           t > 0 ? (BENCHN >> 20) / t : 0.0);
+}
+
+int main(void) {
+    printf("Starting obuf unit tests...\n\n");
+
+    fork1("file output", tfile);
+    fork1("slow pipe", tpipe);
+    fork1("reader gone", tepipe);
+    fork1("output copy", ttap);
+    fork1("held output", thold);
+    fork1("terminators", tnul);
+    fork1("busy device", tbusy);
+    fork1("device timeout", tgone);
+    fork1("throughput", bench);
+
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
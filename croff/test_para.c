@@ -0,0 +1,182 @@
+/* C17 - no scaffold needed */
+/*
+ * test_para.c - Tests and microbenchmark for the paragraph breakers
+ *
+ * Checks pargreedy() and parfit() on small cases, compares parfit()
+ * against an exhaustive search of every layout of short random runs,
+ * and then times both breakers on a long synthetic text, reporting
+ * lines per second.
+ *
+ *   cc -std=c17 -O2 -Icroff -Isrc croff/test_para.c croff/para.c -o test_para
+ */
+
+#define _POSIX_C_SOURCE 200809L /* clock_gettime() */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+
+#include "para.h"
+
+#define BENCHW 100000 /* words in the benchmark text */
+#define BENCHP 120 /* words per benchmark paragraph */
+
+/* Same demerits as para.c */
+static long long dem(long slack, int gaps, int sps, int last) {
+    long long b;
+    double r;
+
+    b = 0;
+    if (!last) {
+        r = (double)slack / ((double)(gaps > 0 ? gaps : 1) * sps);
+        b = (r > 4.65) ? 10000 : (long long)(100 * r * r * r);
+    }
+    return ((10 + b) * (10 + b));
+}
+
+/* Demerits of the layout in ends[], -1 if a line is overfull */
+static long long score(const struct parwd *wd, int n, const struct parlim *lim,
+                       const int *ends, int nl) {
+    long long d;
+    long nat, avail;
+    int i, k, s, g;
+
+    d = 0;
+    for (s = 0, i = 0; i < nl; s = ends[i++]) {
+        g = (i == 0) ? lim->g0 : 0;
+        avail = (i == 0) ? lim->w0 : lim->w;
+        nat = 0;
+        for (k = s; k < ends[i]; k++)
+            nat += (g || k > s) ? wd[k].sp + wd[k].wid : wd[k].wid;
+        g += ends[i] - s;
+        if (nat > avail)
+            return (-1);
+        d += dem(avail - nat, g - 1, lim->sps, ends[i] == n);
+    }
+    return (d);
+}
+
+/* Least demerits over every layout, by trying every set of breaks */
+static long long best(const struct parwd *wd, int n, const struct parlim *lim) {
+    int ends[40];
+    long long b, d;
+    unsigned m;
+    int k, nl;
+
+    b = -1;
+    for (m = 0; m < (1u << n); m++) {
+        nl = 0;
+        if (lim->g0 && (m & 1))
+            ends[nl++] = 0;
+        for (k = 1; k < n; k++)
+            if (m & (1u << k))
+                ends[nl++] = k;
+        ends[nl++] = n;
+        if (!lim->g0 && (m & 1))
+            continue;
+        if ((d = score(wd, n, lim, ends, nl)) >= 0 && (b < 0 || d < b))
+            b = d;
+    }
+    return (b);
+}
+
+void test_greedy(void) {
+    struct parwd wd[4] = {{1, 3}, {1, 3}, {1, 3}, {1, 3}};
+    struct parlim lim = {10, 0, 10, 1};
+    int ends[5];
+
+    printf("Testing first-fit breaking...\n");
+    assert(pargreedy(wd, 4, &lim, ends) == 2);
+    assert(ends[0] == 2 && ends[1] == 4);
+
+    /* A partial line too full for the first word ends by itself. */
+    lim.w0 = 2;
+    lim.g0 = 3;
+    assert(pargreedy(wd, 4, &lim, ends) == 3);
+    assert(ends[0] == 0 && ends[1] == 2 && ends[2] == 4);
+    printf("First-fit tests passed.\n");
+}
+
+void test_fit(void) {
+    struct parwd wd[12];
+    struct parlim lim;
+    int ends[13];
+    int i, n, t, nl;
+
+    printf("Testing total-fit breaking against exhaustive search...\n");
+    srand(7);
+    for (t = 0; t < 2000; t++) {
+        n = 1 + rand() % 12;
+        for (i = 0; i < n; i++) {
+            wd[i].sp = 1 + rand() % 2;
+            wd[i].wid = 1 + rand() % 8;
+        }
+        lim.w = 10 + rand() % 10;
+        lim.g0 = rand() % 3;
+        lim.w0 = lim.g0 ? rand() % lim.w : lim.w;
+        lim.sps = 1;
+        nl = parfit(wd, n, &lim, ends);
+        if (nl < 0) { /* Refused only when no layout fits */
+            assert(best(wd, n, &lim) < 0);
+            continue;
+        }
+        assert(ends[nl - 1] == n);
+        for (i = 1; i < nl; i++)
+            assert(ends[i] > ends[i - 1]);
+        assert(score(wd, n, &lim, ends, nl) == best(wd, n, &lim));
+    }
+
+    /* Too long a word is refused. */
+    wd[0].sp = 1;
+    wd[0].wid = 30;
+    lim.w = lim.w0 = 20;
+    lim.g0 = 0;
+    assert(parfit(wd, 1, &lim, ends) == -1);
+    printf("Total-fit tests passed.\n");
+}
+
+static double now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+void bench(void) {
+    static struct parwd wd[BENCHW];
+    static int ends[BENCHP + 1];
+    struct parlim lim = {65, 0, 65, 1};
+    long lines;
+    double t;
+    int i, k, r;
+
+    for (i = 0; i < BENCHW; i++) {
+        wd[i].sp = 1 + (i % 9 == 8);
+        wd[i].wid = 1 + (int)((i * 2654435761u) >> 28) % 10;
+    }
+    for (r = 0; r < 2; r++) {
+        lines = 0;
+        t = now();
+        for (k = 0; k + BENCHP <= BENCHW; k += BENCHP) {
+            i = r ? parfit(&wd[k], BENCHP, &lim, ends) : -1;
+            if (i < 0)
+                i = pargreedy(&wd[k], BENCHP, &lim, ends);
+            lines += i;
+        }
+        t = now() - t;
+        printf("%-10s %8ld lines %10.0f lines/sec\n", r ? "total-fit" : "first-fit",
+               lines, t > 0 ? lines / t : 0.0);
+    }
+}
+
+int main(void) {
+    printf("Starting paragraph breaker tests...\n\n");
+
+    test_greedy();
+    test_fit();
+    bench();
+
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
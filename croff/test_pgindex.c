@@ -0,0 +1,304 @@
+/* C17 - no scaffold needed */
+/*
+ * test_pgindex.c - Tests for the -X page index
+ *
+ * Builds pgindex.c with the state image of snapshot.c and the input
+ * stack of n1.c caught here, and checks that the key leaves out -o and
+ * -X, that a piece the same as the last one is referred to and read
+ * back, that only regular files are recorded, and that no checkpoint is
+ * taken inside a macro or on the standard input.  Last, an index is
+ * written and an -o run resumes from the right checkpoint in it, and a
+ * changed file or a failed run leaves no checkpoint to resume from.
+ * A -J segment resumes with the device's part as well, and counts the
+ * places where checkpoints would be taken instead of taking them.
+ *
+ *   cc -std=c17 -O2 -DNROFF -Wno-multichar -I. -Icroff -Isrc croff/test_pgindex.c -o test_pgindex
+ */
+
+#define _GNU_SOURCE /* mkstemp */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "pgindex.c"
+
+/* What pgindex.c takes from the rest of croff */
+struct variable_state v;
+struct device_state d[NDI], *dip = &d[0];
+int ip, *cp, *ap, raw, copyf, level, dilev, frlev, nx, donef, ndone, ejf, lit, app, ds, nfw, pmflg;
+int ch, ch0, nchar, rchar, nlflg, padc, fc, lg, ulfont, ulbit, cs, bd, sv, sfont;
+int tlss, ralss, trap, po1, paper, npn, npnflg, nfo, evi, ev, ifx, smnt;
+int ifi, ioff, offli[4], *offl = offli, rargc, mflg, stdi, print = 1, pfrom, pnmax;
+int frames[4], *ejl, *frame = frames;
+static char *args[] = {NULL};
+char **argp = args;
+int pnlist[8] = {-1};
+int evlist[EVLSZ], iflist[NIF], fontlab[PXFONTS + 1];
+char *bsuffix, *dsock;
+long pagesout;
+int pjobs, pjleft;
+
+static int held, restored, resumed, resfd, resoff;
+int parheld(void) { return (held); }
+const char *hxwords(int *n) { *n = 4; return ("foo"); }
+int hxreset(const char *w, int n) { return ((n == 4 && strcmp(w, "foo") == 0) ? 0 : -1); }
+int evsize(void) { return (64); }
+void snapbase(void) {}
+long snapget(const char *p, const char *e,
+             const void *(*piece)(const char **pp, const char *e, size_t n), int apply) {
+    (void)p; (void)e; (void)piece;
+    restored += apply;
+    return (0);
+}
+int snapput(int fd, int (*piece)(int fd, int key, const void *buf, size_t n)) {
+    (void)fd; (void)piece;
+    return (0);
+}
+int soresume(int n, const int *fd, const int *off) {
+    resumed = n;
+    resfd = fd[n - 1];
+    resoff = off[n - 1];
+    return (0);
+}
+void getmap(void) {}
+void lgflush(void) {}
+void cvtime(void) {}
+void capstart(void) {}
+void prstr(const char *s) { (void)s; }
+void done3(int x) { exit(x); }
+
+/* The device's part: one word; and what -J's pjob.c is asked */
+static int dev, cutat = -2, entered = -1, places;
+int sgdevput(int fd) { return (put(fd, &dev, sizeof(dev))); }
+long sgdevget(const char *p, const char *e, int apply) {
+    if ((size_t)(e - p) < sizeof(dev))
+        return (-1);
+    if (apply)
+        memcpy(&dev, p, sizeof(dev));
+    return ((long)sizeof(dev));
+}
+int pjcut(int nmark) { return ((nmark == 9) ? cutat : -2); }
+void pjenter(int rc) { entered = rc; }
+void pjplace(void) { places++; }
+
+static char doc[] = "/tmp/test_pgindexXXXXXX";
+static char idx[sizeof(doc) + 4];
+
+static void test_key(void) {
+    unsigned long long k;
+
+    printf("Testing the key...\n");
+    pxkey = 1;
+    pxarg("-Xa");
+    pxarg("-o5-");
+    pxarg("doc");
+    k = pxkey;
+    pxkey = 1;
+    pxarg("doc");
+    assert(pxkey == k);
+    pxkey = 1;
+    pxarg("-S");
+    pxarg("doc");
+    assert(pxkey != k);
+}
+
+static void test_pieces(void) {
+    char a[16] = "the first piece", b[16] = "the other piece", *m;
+    const char *p, *q, *r;
+    struct pxhdr h;
+    long n;
+    int fd;
+
+    printf("Testing pieces written once...\n");
+    snprintf(idx, sizeof(idx), "%s", doc);
+    fd = mkstemp(idx);
+    assert(fd >= 0);
+    memset(&h, 0, sizeof(h));
+    assert(put(fd, &h, sizeof(h)) == 0);
+    assert(pxpiece(fd, 3, a, sizeof(a)) == 0);
+    assert(pxpiece(fd, 3, a, sizeof(a)) == 0);
+    assert(pxpiece(fd, 3, b, sizeof(b)) == 0);
+    assert(pxpiece(fd, -1, a, sizeof(a)) == 0);
+    n = (long)lseek(fd, 0, SEEK_END);
+    assert(n == (long)(sizeof(h) + 4 * sizeof(long) + 3 * sizeof(a)));
+    m = malloc(n);
+    assert(pread(fd, m, n, 0) == n);
+    pxmap = m;
+    pxmapn = (size_t)n;
+    p = m + sizeof(h);
+    q = pxget(&p, m + n, sizeof(a));
+    assert(q && memcmp(q, a, sizeof(a)) == 0);
+    r = pxget(&p, m + n, sizeof(a));
+    assert(r == q);
+    r = pxget(&p, m + n, sizeof(b));
+    assert(r && memcmp(r, b, sizeof(b)) == 0);
+    r = pxget(&p, m + n, sizeof(a));
+    assert(r && r != q && memcmp(r, a, sizeof(a)) == 0);
+    assert(p == m + n);
+    n = 3; /* a reference out of place */
+    memcpy(m + sizeof(h), &n, sizeof(n));
+    p = m + sizeof(h);
+    assert(pxget(&p, m + pxmapn, sizeof(a)) == NULL);
+    pxmap = NULL;
+    free(m);
+    close(fd);
+    unlink(idx);
+    free(pxs);
+    pxs = NULL;
+    npxs = 0;
+}
+
+static void test_safe(void) {
+    int fd;
+
+    printf("Testing where checkpoints are taken...\n");
+    fd = mkstemp(doc);
+    assert(fd >= 0 && write(fd, "text\n", 5) == 5);
+    pxon = 1;
+    pxinput(0, doc, fd);
+    assert(npxf == 1 && pxlv[0] == 0 && strcmp(pxf[0].name, doc) == 0);
+    ifi = 0;
+    assert(pxsafe());
+    ip = 5;
+    assert(!pxsafe());
+    ip = 0;
+    held = 1;
+    assert(!pxsafe());
+    held = 0;
+    pxinput(1, NULL, 0);
+    ifi = 1;
+    assert(npxf == 1 && pxlv[1] == -1 && !pxsafe());
+    pxinput(1, doc, fd);
+    assert(npxf == 2 && pxlv[1] == 1 && pxsafe());
+    ifi = 0;
+    close(fd);
+    npxf = 0;
+    pxon = 0;
+}
+
+/* An indexing run of pages 1 to 9, the font changed on page 5 */
+static void indexrun(int x) {
+    int fd;
+
+    fd = open(doc, O_RDONLY);
+    assert(fd > 0);
+    pxkey = 1;
+    pxarg(doc);
+    v.pn = 1;
+    print = 1;
+    pxfile = idx;
+    pxpages = 0;
+    assert(pxload() == 0 && pxon);
+    pxinput(0, doc, fd);
+    for (pagesout = 1; pagesout < 10; pagesout++) {
+        v.pn = pnmax = (int)pagesout;
+        fc = (pagesout < 5) ? 1 : 2;
+        ioff = dev = (int)pagesout;
+        PXPOINT();
+        PXPOINT();
+    }
+    assert(npxm == 9 && pxpages == 9);
+    pxdone(x);
+    close(fd);
+    npxm = npxf = 0;
+    free(pxs);
+    pxs = NULL;
+    npxs = 0;
+}
+
+/* An -o run from page pfrom; 1 if it resumes */
+static int outrun(int from) {
+    pxkey = 1;
+    pxarg(doc);
+    print = 0;
+    pfrom = pnlist[0] = from;
+    rargc = 0;
+    fc = 0;
+    resumed = 0;
+    return (pxload());
+}
+
+/* pxstate(): the level by name and offset, the state and the device */
+static void checkstate(void) {
+    char name[] = "/tmp/test_pgstateXXXXXX", b[4096];
+    int fd, k[2];
+    ssize_t n;
+
+    fd = mkstemp(name);
+    assert(fd >= 0);
+    unlink(name);
+    ioff = 7;
+    assert(pxstate(fd) == 0);
+    n = pread(fd, b, sizeof(b), 0);
+    memcpy(k, b, sizeof(k));
+    assert(k[0] == 1 && k[1] == rargc);
+    assert(strcmp(b + sizeof(k), doc) == 0);
+    memcpy(k, b + sizeof(k) + PXNAME, sizeof(int));
+    assert(k[0] == 7);
+    assert(n == (ssize_t)(3 * sizeof(int) + PXNAME + PXFIX + sizeof(int) + 4 + sizeof(dev)));
+    memcpy(k, b + n - sizeof(dev), sizeof(dev));
+    assert(k[0] == dev);
+    close(fd);
+}
+
+static void test_resume(void) {
+    int fd;
+
+    printf("Testing an -o run resumed from the index...\n");
+    snprintf(idx, sizeof(idx), "%s.x", doc);
+    indexrun(0);
+    assert(access(idx, R_OK) == 0);
+    dev = -1;
+    assert(outrun(7) == 1);
+    assert(!pxon && restored == 1 && resumed == 1 && resoff == 6 && fc == 2 && dev == -1);
+    close(resfd);
+    assert(outrun(1) == 0 && restored == 1);
+    assert(outrun(4) == 1 && resoff == 3 && fc == 1);
+    close(resfd);
+
+    printf("Testing a -J segment resumed from the index...\n");
+    pxkey = 1;
+    pxarg(doc);
+    print = 1;
+    pfrom = 0;
+    pnlist[0] = -1;
+    fc = 0;
+    pjobs = 2;
+    pjleft = 3;
+    cutat = 4;
+    assert(pxload() == 1 && entered == 0 && !pxon);
+    assert(resoff == 5 && fc == 2 && dev == 5);
+    assert(npxf == 1 && pxlv[0] == 0 && strcmp(pxf[0].name, doc) == 0);
+    close(resfd);
+    checkstate();
+    pagesout = 1;
+    pxpages = 0;
+    PXPOINT();
+    PXPOINT();
+    assert(places == 1 && npxm == 0 && pxpages == 1);
+    pjobs = pjleft = pagesout = pxpages = 0;
+    cutat = -2;
+
+    printf("Testing a stale or failed index...\n");
+    fd = open(doc, O_WRONLY | O_APPEND);
+    assert(fd >= 0 && write(fd, "more\n", 5) == 5);
+    close(fd);
+    assert(outrun(7) == 0 && pxon);
+    pxon = 0;
+    unlink(idx);
+    indexrun(1);
+    assert(access(idx, F_OK) < 0);
+    unlink(doc);
+}
+
+int main(void) {
+    printf("Starting page index unit tests...\n\n");
+    test_key();
+    test_pieces();
+    test_safe();
+    test_resume();
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
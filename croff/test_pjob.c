@@ -0,0 +1,192 @@
+/* C17 - no scaffold needed */
+/*
+ * test_pjob.c - Tests for -J, pages formatted in parallel
+ *
+ * Builds pjob.c with a document of one line to a page, whose state is
+ * one word that each page adds to and prints, caught here.  A checkpoint falls after each page but the
+ * last, and a segment resumed at one takes the state the index
+ * predicted for it.  Split into segments, with every prediction right
+ * and with one or two wrong, the output and the diagnostics come out
+ * whole and in order, once each, and the run exits with the worst
+ * status of the segments kept.  A child that cannot resume has the one
+ * before it format its segment.
+ *
+ *   cc -std=c17 -O2 -DNROFF -Wno-multichar -I. -Icroff -Isrc croff/test_pjob.c -o test_pjob
+ */
+
+#define _GNU_SOURCE /* mkstemp */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "pjob.c"
+
+/* What pjob.c takes from the rest of croff */
+TroffProcessor g_processor;
+int ptid, ttyod, error, ipflg;
+int pnlist[4] = {-1};
+char *sgdir;
+
+static int state; /* the formatter's */
+static char outb[256];
+static int outn;
+
+int bcopytmp(void) { return (0); }
+void flusho(void) {
+    assert(write(ptid, outb, outn) == outn);
+    outn = 0;
+}
+void obwait(void) {}
+void obfork(void) {}
+void prstr(const char *s) { (void)s; }
+void dgflush(void) {}
+int pxstate(int fd) { return ((write(fd, &state, sizeof(state)) == sizeof(state)) ? 0 : -1); }
+
+#define NPAGE 8 /* pages 0 to 7: checkpoints 0 to 6, one after each */
+
+static int wrong[NPAGE]; /* the index predicts checkpoint k wrong */
+static int failat = -1; /* the child resuming there cannot */
+static int errat = -1; /* the page that sets the error status */
+
+/*
+ * Format the document in this process, as a -J run in nmark
+ * checkpoints would: each page's line, a message, and a checkpoint
+ * place after it.  Exits as done() would.
+ */
+static void format(void) {
+    char b[32];
+    int k, pg;
+
+    k = pjcut(NPAGE - 1);
+    assert(k != -2);
+    pg = 0;
+    if (k >= 0) {
+        state = wrong[k] ? -1 : 10 * (k + 1);
+        pjenter(k == failat ? -1 : 0);
+        pg = k + 1;
+    }
+    for (; pg < NPAGE; pg++) {
+        outn += snprintf(outb + outn, sizeof(outb) - outn, "page %d at %d\n", pg, state);
+        k = snprintf(b, sizeof(b), "m%d ", pg);
+        assert(write(ttyod, b, k) == k);
+        if (pg == errat)
+            error |= 01;
+        state += 10;
+        if ((pg < NPAGE - 1) && pjleft)
+            pjplace();
+    }
+    flusho();
+    exit(error);
+}
+
+/* Run format() with -J<jobs>; the run's output and messages, and its status */
+static int run(int jobs, char *out, char *msg) {
+    char name[] = "/tmp/test_pjobXXXXXX", ename[] = "/tmp/test_pjobXXXXXX";
+    int fd, efd, status;
+    ssize_t n;
+    pid_t pid;
+
+    fd = mkstemp(name);
+    efd = mkstemp(ename);
+    assert(fd >= 0 && efd >= 0);
+    unlink(name);
+    unlink(ename);
+    fflush(stdout);
+    if ((pid = fork()) == 0) {
+        ptid = fd;
+        ttyod = efd;
+        pjobs = jobs;
+        format();
+    }
+    assert(pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status));
+    n = pread(fd, out, 1023, 0);
+    assert(n >= 0);
+    out[n] = 0;
+    n = pread(efd, msg, 1023, 0);
+    assert(n >= 0);
+    msg[n] = 0;
+    close(fd);
+    close(efd);
+    return (WEXITSTATUS(status));
+}
+
+static char whole[1024], allmsg[1024];
+
+static void expect(int jobs) {
+    char out[1024], msg[1024];
+
+    assert(run(jobs, out, msg) == 0);
+    assert(strcmp(out, whole) == 0);
+    assert(strcmp(msg, allmsg) == 0);
+}
+
+static void test_cut(void) {
+    printf("Testing the checkpoints segments start at...\n");
+    pjobs = 3;
+    assert(pjcut(0) == -2);
+    ipflg = 1;
+    assert(pjcut(7) == -2);
+    ipflg = 0;
+    pnlist[0] = 2;
+    assert(pjcut(7) == -2);
+    pnlist[0] = -1;
+    pjobs = 1;
+    assert(pjcut(7) == -2);
+    pjobs = 0;
+    pjarg("4");
+    assert(pjobs == 4);
+    pjarg("");
+    assert(pjobs >= 1);
+}
+
+static void test_right(void) {
+    int k;
+
+    printf("Testing segments all predicted right...\n");
+    for (k = 0; k < NPAGE; k++) {
+        snprintf(whole + strlen(whole), sizeof(whole) - strlen(whole), "page %d at %d\n", k,
+                 10 * k);
+        snprintf(allmsg + strlen(allmsg), sizeof(allmsg) - strlen(allmsg), "m%d ", k);
+    }
+    expect(2);
+    expect(3);
+    expect(NPAGE);
+    expect(20); /* no more segments than pages */
+}
+
+static void test_wrong(void) {
+    char out[1024], msg[1024];
+
+    printf("Testing mispredicted segments formatted again...\n");
+    wrong[3] = 1; /* where the third of 4 segments starts */
+    expect(4);
+    wrong[5] = 1; /* and the fourth, both formatted by the second child */
+    expect(4);
+    memset(wrong, 0, sizeof(wrong));
+    wrong[1] = wrong[2] = wrong[3] = wrong[4] = wrong[5] = wrong[6] = 1;
+    expect(NPAGE); /* by the first child alone */
+    memset(wrong, 0, sizeof(wrong));
+
+    printf("Testing a child that cannot resume...\n");
+    failat = 3;
+    expect(4);
+    failat = -1;
+
+    printf("Testing the status of the segments kept...\n");
+    errat = 6;
+    assert(run(4, out, msg) == 01 && strcmp(out, whole) == 0);
+    errat = 1;
+    assert(run(4, out, msg) == 01 && strcmp(out, whole) == 0);
+    errat = -1;
+}
+
+int main(void) {
+    printf("Starting parallel segment unit tests...\n\n");
+    test_cut();
+    test_right();
+    test_wrong();
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
@@ -0,0 +1,240 @@
+/* C17 - no scaffold needed */
+/*
+ * test_pmodel.c - Tests for the -G page model of pmodel.c
+ *
+ * Builds pmodel.c with the terminal driver of n10.c and a small table
+ * loaded by hand.  A document put out through the model must make the
+ * bytes the driver makes line by line: lines indented, spaced double,
+ * blank, and the trailer at the end.  Reversed, the pages come out last
+ * first, each as it would alone; side by side, the lines of two pages
+ * share the rows, the second page past the widest line of the first.
+ * Running off the end of a piece of the arena and resetting it leave
+ * the pages as they were.
+ *
+ *   cc -std=gnu17 -Icroff -Isrc croff/test_pmodel.c -o test_pmodel
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "n10.c"
+#include "pmodel.c"
+
+struct typewriter_table t;
+TroffProcessor g_processor;
+int lss, xfont, esc, lead, ulfont = 1, esct, sps, ics, ttysave, ttys[3];
+int ptid, waitf, pipeflg, eqflg, hflg, xxx;
+void tsdef(int w) { (void)w; }
+char termtab[] = "/dev/null";
+int tti;
+int oline[LNSIZE];
+int *olinep = oline;
+struct env *dip;
+
+static char out[8192];
+static int nout;
+
+void oput(int c) {
+    assert(nout < (int)sizeof(out) - 1);
+    out[nout++] = (char)c;
+}
+
+void oputn(const char *s, int n) {
+    while (n-- > 0)
+        oput(*s++);
+}
+
+void flusho(void) {}
+void prstr(const char *s) { fputs(s, stderr); }
+int stty(int fd, int *args) { (void)fd; (void)args; return 0; }
+void widflush(void) {}
+int twload(const char *path, const char *name) { (void)path; (void)name; return 0; }
+int ipflg;
+void ipout(int i) { (void)i; }
+void iplead(void) {}
+void ipstop(void) {}
+void ipdone(void) {}
+void fwmark(int i) { (void)i; }
+
+static struct env env;
+static char zero[1];
+
+#define FONT(f) (04000 | ((f) << 9))
+#define NL 40 /* t.Newline */
+
+/* Every printable character one wide, printing itself */
+static void loadtab(void) {
+    char buf[3];
+    int k;
+
+    t.Char = t.Em = 24;
+    t.Newline = NL;
+    t.Halfline = NL / 2;
+    t.hlf = "\0339";
+    t.hlr = "\0338";
+    t.flr = "\0337";
+    t.twnl = "\n";
+    t.ploton = "";
+    t.bdon = "";
+    dtab = 8 * t.Em;
+    for (k = 0; k < 256 - 32; k++) {
+        buf[0] = 1;
+        buf[1] = (k + 32 < 0177) ? (char)(k + 32) : 0;
+        buf[2] = 0;
+        t.codetab[k] = buf[1] ? strdup(buf) : zero;
+    }
+    glyphinit();
+    dip = &env;
+}
+
+/*
+ * One line through ptout(): "-" in s is an em of motion right, "^" a
+ * half line up, "v" a half line down.  before is the spacing for it.
+ */
+static void line(const char *s, int before) {
+    lss = before;
+    for (; *s; s++)
+        if (*s == '-')
+            ptout(MOT | t.Em);
+        else if (*s == '^')
+            ptout(MOT | VMOT | NMOT | t.Halfline);
+        else if (*s == 'v')
+            ptout(MOT | VMOT | t.Halfline);
+        else
+            ptout(*s | FONT(0));
+    ptout('\n' | FONT(0));
+}
+
+/* Page 1 or 2 of the document, and the trailer after the last */
+static void page(int n) {
+    if (n == 1) {
+        line("ab", NL);
+        line("--cd", NL);
+        line("x^2v", 2 * NL);
+        line("", NL);
+        env.alss = NL / 2;
+        line("  e", NL);
+    } else {
+        line("page two", NL);
+        line("", NL);
+        line("", NL);
+        line("--end", 3 * NL / 2);
+    }
+}
+
+static void trailer(void) {
+    lead += 3 * NL;
+    ptlead();
+}
+
+/* The bytes the pages from..to make, put out line by line */
+static int direct(char *buf, int from, int to, int trail) {
+    int k, n;
+
+    pmflg = 0;
+    nout = 0;
+    lead = esc = esct = 0;
+    for (k = from; (from <= to) ? (k <= to) : (k >= to); k += (from <= to) ? 1 : -1) {
+        page(k);
+        if (k == 2 && trail)
+            trailer();
+        lead = 0; /* each page from the top, as the model puts it */
+    }
+    n = nout;
+    memcpy(buf, out, n);
+    buf[n] = 0;
+    return (n);
+}
+
+/* The same through the model, up pages side by side, rev set for -Gr */
+static int model(char *buf, int up, int rev, int trail) {
+    int n;
+
+    pmflg = 1;
+    pmup = up;
+    pmrev = rev;
+    nout = 0;
+    lead = esc = esct = 0;
+    page(1);
+    pmpage();
+    page(2);
+    if (trail)
+        trailer();
+    pmdone();
+    n = nout;
+    memcpy(buf, out, n);
+    buf[n] = 0;
+    pmflg = 0;
+    return (n);
+}
+
+static void test_same(void) {
+    char a[2048], b[2048];
+    int n;
+
+    printf("Testing pages put out as the driver puts lines...\n");
+    n = direct(a, 1, 2, 1);
+    assert(model(b, 1, 0, 1) == n && memcmp(a, b, n) == 0);
+    /* the trailer goes from the end of the last line, in half lines */
+    assert(strcmp(a, "ab\n  cd\n\nx\0338" "2\n\n  e\npage two\n\n\n\0339  end\n"
+                     "\0339\0339\0339\0339\0339\0339") == 0);
+    assert(!pmheld && !pmcur && pmat == pmfirst && pmfirst->used == 0);
+}
+
+static void test_reversed(void) {
+    char a[2048], b[2048];
+    int n;
+
+    printf("Testing pages put out last first...\n");
+    n = direct(a, 2, 1, 0);
+    assert(model(b, 1, 1, 0) == n && memcmp(a, b, n) == 0);
+    assert(strncmp(b, "page two\n", 9) == 0);
+}
+
+static void test_sideways(void) {
+    char b[2048];
+
+    printf("Testing two pages side by side...\n");
+    model(b, 2, 0, 0);
+    /* "page two" is 8 wide: page 2 is 10 columns right of page 1 */
+    assert(strcmp(b, "ab        page two\n  cd\n\nx\0338" "2\n            end\n  e\n") == 0);
+}
+
+static void test_arena(void) {
+    char a[2048], b[2048];
+    struct pmchunk *c;
+    int n, k;
+
+    printf("Testing the arena...\n");
+    for (k = 0; k < 3 * PMCHUNK / 8; k++)
+        assert(pmalloc(8) != NULL);
+    assert(pmfirst->next != NULL && pmat != pmfirst);
+    pmreset();
+    assert(pmat == pmfirst && pmfirst->used == 0);
+    for (k = 0; k < PMCHUNK / 8 + 1; k++)
+        assert(pmalloc(8) != NULL);
+    assert(pmat == pmfirst->next && pmat->used == 8);
+    for (c = pmfirst, n = 0; c != NULL; c = c->next)
+        n++;
+    assert(n == 3); /* the pieces are used again */
+    pmreset();
+    n = direct(a, 1, 2, 1);
+    assert(model(b, 1, 0, 1) == n && memcmp(a, b, n) == 0);
+    assert(pmalloc(2 * PMCHUNK) != NULL);
+    pmreset();
+}
+
+int main(void) {
+    printf("Starting page model unit tests...\n\n");
+
+    loadtab();
+    test_same();
+    test_reversed();
+    test_sideways();
+    test_arena();
+
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
@@ -0,0 +1,241 @@
+/* C17 - no scaffold needed */
+/*
+ * test_segcache.c - Tests for the -R segment cache
+ *
+ * Builds segcache.c with the formatter state, the output ring and the
+ * input stack caught here.  A segment is formatted and stored, then
+ * replayed by a second run: its output comes from the cache, its file
+ * is put back unread and the state it left is taken up.  A change to
+ * its file, to the state it is entered with, or to a file it sourced
+ * makes it miss.  A segment that uses .nx, ends in the middle of a
+ * line, or has no newline at its end is not stored.
+ *
+ *   cc -std=c17 -O2 -DNROFF -Wno-multichar -I. -Icroff -Isrc croff/test_segcache.c -o test_segcache
+ */
+
+#define _GNU_SOURCE /* mkdtemp */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <dirent.h>
+
+#include "segcache.c"
+
+/* What segcache.c takes from the rest of croff */
+int nx, ifi, ipflg, error, nflush, lgf, totout, dpn, oldbits, xflg;
+int xfont, esc, lead, esct, eqflg, hflg;
+int oline[LNSIZE + 1], *olinep = oline;
+int pnlist[4] = {-1};
+long linesout, pagesout;
+
+/* The formatter state: one word, which pxsave() writes and pxrestore() reads */
+static int state, quiet = 1, dropped, restores;
+static char outb[256];
+static int outn, tapped;
+
+int pxquiet(void) { return (quiet); }
+int pxsave(int fd, int (*piece)(int fd, int key, const void *buf, size_t n)) {
+    (void)piece;
+    return (put(fd, &state, sizeof(state)));
+}
+long pxrestore(const char *p, const char *e,
+               const void *(*piece)(const char **pp, const char *e, size_t n), int apply) {
+    (void)piece;
+    if ((size_t)(e - p) < sizeof(state))
+        return (-1);
+    if (apply) {
+        memcpy(&state, p, sizeof(state));
+        restores++;
+    }
+    return ((long)sizeof(state));
+}
+int evsize(void) { return (64); }
+int sodrop(void) { dropped++; ifi = nx = 0; return (0); }
+void oputn(const char *s, int n) { memcpy(outb + outn, s, n); outn += n; }
+void obtap(void) { tapped = outn; }
+char *obtake(size_t *n) {
+    char *b = malloc(outn - tapped + 1);
+
+    memcpy(b, outb + tapped, outn - tapped);
+    *n = (size_t)(outn - tapped);
+    return (b);
+}
+void getmap(void) {}
+void lgflush(void) {}
+void prstr(const char *s) { (void)s; }
+void done3(int x) { exit(x); }
+
+static char dir[] = "/tmp/test_segcacheXXXXXX";
+static char ch1[64], ch2[64];
+
+static void file(const char *name, const char *s) {
+    FILE *f = fopen(name, "w");
+
+    assert(f);
+    fputs(s, f);
+    fclose(f);
+}
+
+static int entries(void) {
+    struct dirent *e;
+    DIR *d;
+    int n = 0;
+
+    assert((d = opendir(dir)) != NULL);
+    while ((e = readdir(d)) != NULL)
+        n += (strlen(e->d_name) == 16); /* a key */
+    closedir(d);
+    return (n);
+}
+
+/*
+ * .so name, entered with state in: the segment puts out text and
+ * leaves state out if it is formatted.  Returns 1 if it was replayed.
+ */
+static int segment(const char *name, int in, const char *text, int out, int clean) {
+    int n;
+
+    state = in;
+    dropped = 0;
+    ifi = nx = 1;
+    sgso(name);
+    assert(sgpend);
+    SGPOINT();
+    assert(!sgpend);
+    if (dropped) {
+        assert(!sgrec && ifi == 0);
+        return (1);
+    }
+    n = (int)strlen(text);
+    memcpy(outb + outn, text, n);
+    outn += n;
+    state = out;
+    pagesout += 2;
+    ifi = nx = 0;
+    sgline = clean;
+    SGPOP();
+    sgline = 0;
+    assert(!sgrec);
+    return (0);
+}
+
+static void test_key(void) {
+    unsigned long long k;
+
+    printf("Testing the key of the options...\n");
+    k = sgkey0;
+    sgarg("-o3");
+    sgarg("-Xidx");
+    sgarg("-Rdir");
+    assert(sgkey0 == k);
+    sgarg("-Tvt100");
+    assert(sgkey0 != k);
+}
+
+static void test_replay(void) {
+    printf("Testing a segment stored and replayed...\n");
+    assert(segment(ch1, 5, "one", 6, 1) == 0);
+    assert(entries() == 1 && pagesout == 2);
+    outn = 0;
+    restores = 0;
+    assert(segment(ch1, 5, "xxx", 9, 1) == 1);
+    assert(outn == 3 && memcmp(outb, "one", 3) == 0);
+    assert(state == 6 && restores == 1 && pagesout == 4);
+
+    printf("Testing what makes a segment miss...\n");
+    assert(segment(ch1, 7, "two", 8, 1) == 0); /* entered otherwise */
+    assert(entries() == 2);
+    file(ch1, "chapter one, edited\n");
+    assert(segment(ch1, 5, "three", 6, 1) == 0);
+    assert(entries() == 3);
+    assert(segment(ch1, 5, "xxx", 9, 1) == 1 && state == 6);
+}
+
+static void test_nested(void) {
+    char sub[64];
+
+    printf("Testing a file a segment sources...\n");
+    snprintf(sub, sizeof(sub), "%s/sub", dir);
+    file(sub, "sourced\n");
+    state = 11;
+    ifi = nx = 1;
+    sgso(ch2);
+    SGPOINT();
+    assert(sgrec);
+    ifi = 2;
+    sgso(sub);
+    assert(nsgf == 1 && !sgpend);
+    state = 12;
+    ifi = nx = 0;
+    sgline = 1;
+    SGPOP();
+    sgline = 0;
+    assert(segment(ch2, 11, "xxx", 0, 1) == 1 && state == 12);
+    file(sub, "sourced, edited\n");
+    assert(segment(ch2, 11, "four", 13, 1) == 0 && state == 13);
+    unlink(sub);
+}
+
+static void test_unstored(void) {
+    int n;
+
+    printf("Testing segments that are not stored...\n");
+    n = entries();
+    state = 20;
+    ifi = nx = 1;
+    sgso(ch2);
+    SGPOINT();
+    sgbad(); /* .nx */
+    ifi = nx = 0;
+    sgline = 1;
+    SGPOP();
+    sgline = 0;
+    assert(entries() == n);
+    assert(segment(ch2, 21, "five", 22, 0) == 0);
+    assert(entries() == n);
+    file(ch2, "no newline");
+    ifi = nx = 1;
+    sgso(ch2);
+    SGPOINT();
+    assert(!sgrec);
+    quiet = 0;
+    file(ch2, "chapter two\n");
+    sgso(ch2);
+    SGPOINT();
+    assert(!sgrec);
+    quiet = 1;
+}
+
+static void cleanup(void) {
+    struct dirent *e;
+    char name[512];
+    DIR *d;
+
+    assert((d = opendir(dir)) != NULL);
+    while ((e = readdir(d)) != NULL)
+        if (e->d_name[0] != '.') {
+            snprintf(name, sizeof(name), "%s/%s", dir, e->d_name);
+            unlink(name);
+        }
+    closedir(d);
+    rmdir(dir);
+}
+
+int main(void) {
+    printf("Starting segment cache unit tests...\n\n");
+    assert(mkdtemp(dir) != NULL);
+    sgdir = dir;
+    snprintf(ch1, sizeof(ch1), "%s/ch1", dir);
+    snprintf(ch2, sizeof(ch2), "%s/ch2", dir);
+    file(ch1, "chapter one\n");
+    file(ch2, "chapter two\n");
+    test_key();
+    test_replay();
+    test_nested();
+    test_unstored();
+    cleanup();
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
@@ -0,0 +1,153 @@
+/* C17 - no scaffold needed */
+/*
+ * test_tabstop.c - Tests for the tab stops of each environment
+ *
+ * Builds tabstop.c alone.  The stops .ta gives, however many, are found
+ * as the first past a position, with their types; one not past the stop
+ * before it is dropped, and one at 0 ends the stops.  The stops after a
+ * T repeat without end.  Each environment has stops of its own, and
+ * tsput() and tsget() carry them all through a file; a short or
+ * disordered image is refused before any stop is touched.
+ *
+ *   cc -std=c17 -O2 -DNROFF -Wno-multichar -I. -Icroff -Isrc croff/test_tabstop.c -o test_tabstop
+ */
+
+#define _GNU_SOURCE /* mkstemp */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "tabstop.c"
+
+/* What tabstop.c takes from the rest of croff */
+int ev;
+
+/* The stop past pos and its type, as one int */
+static int next(int pos) {
+    int j, type;
+
+    j = tsnext(pos, &type);
+    return (j | type);
+}
+
+static void test_stops(void) {
+    int k;
+
+    printf("Testing the stops .ta sets...\n");
+    assert(next(0) == 0); /* DTAB is 0 until ptinit() sets the terminal's */
+    tsdef(24);
+    assert(next(0) == 24 && next(24) == 48);
+    assert(next(TSDEF * 24 - 1) == TSDEF * 24 && next(TSDEF * 24) == 0);
+    tsclear();
+    assert(next(0) == 0);
+    tsadd(100, 0);
+    tsadd(250, RTAB);
+    tsadd(300, CTAB);
+    assert(next(0) == 100 && next(99) == 100 && next(100) == (250 | RTAB));
+    assert(next(299) == (300 | CTAB) && next(300) == 0);
+
+    printf("Testing stops dropped and ended...\n");
+    tsclear();
+    tsadd(100, 0);
+    tsadd(50, RTAB); /* never the first past any position */
+    tsadd(100, CTAB);
+    tsadd(200, 0);
+    assert(next(10) == 100 && next(100) == 200);
+    tsadd(0, 0); /* as the 0 after the last stop */
+    tsadd(300, 0);
+    assert(next(200) == 0);
+    tsclear();
+    tsadd(TMASK + 1, 0);
+    assert(next(0) == 0);
+
+    printf("Testing many stops...\n");
+    tsclear();
+    for (k = 1; k <= 1000; k++)
+        assert(tsadd(7 * k, (k % 3 == 0) ? RTAB : 0) == 0);
+    for (k = 0; k < 7000; k++)
+        assert(next(k) == ((7 * (k / 7 + 1)) | ((k / 7 + 1) % 3 == 0 ? RTAB : 0)));
+    assert(next(7000) == 0);
+}
+
+static void test_rep(void) {
+    int k;
+
+    printf("Testing a repeated pattern...\n");
+    /* .ta 1i T 0.5i 1.5i, in units of 10: 10, then 15, 25, 30, 40, ... */
+    tsclear();
+    tsadd(10, 0);
+    tsrep();
+    tsadd(5, 0);
+    tsadd(15, RTAB);
+    assert(next(0) == 10 && next(10) == 15 && next(15) == (25 | RTAB));
+    assert(next(25) == 30 && next(30) == (40 | RTAB) && next(41) == 45);
+    for (k = 25; k < 10000; k += 15)
+        assert(next(k) == 30 + (k - 25) && next(k - 1) == (k | RTAB));
+
+    /* .ta T 3: every 3 from 0 */
+    tsclear();
+    tsrep();
+    tsadd(3, CTAB);
+    assert(next(0) == (3 | CTAB) && next(2) == (3 | CTAB) && next(3) == (6 | CTAB));
+    assert(next(3000) == (3003 | CTAB));
+    tsadd(0, 0); /* adds nothing, and the pattern stands */
+    assert(next(4) == (6 | CTAB));
+}
+
+static void test_envs(void) {
+    char name[] = "/tmp/test_tabstopXXXXXX", buf[4096];
+    ssize_t n;
+    int fd, was;
+
+    printf("Testing stops of each environment...\n");
+    tsdef(0);
+    ev = 1;
+    tsadd(40, RTAB);
+    tsrep();
+    tsadd(20, 0);
+    ev = 2;
+    tsadd(70, CTAB);
+    ev = 0;
+    assert(next(0) == 0);
+    ev = 1;
+    assert(next(0) == (40 | RTAB) && next(40) == 60 && next(100) == 120);
+    ev = 2;
+    assert(next(0) == (70 | CTAB));
+
+    printf("Testing stops carried through a file...\n");
+    fd = mkstemp(name);
+    assert(fd >= 0);
+    unlink(name);
+    assert(tsput(fd) == 0);
+    n = pread(fd, buf, sizeof(buf), 0);
+    assert(n > 0);
+    close(fd);
+    tsdef(24);
+    assert(tsget(buf, buf + n, 0) == n);
+    ev = 1;
+    assert(next(0) == 24); /* measured only */
+    assert(tsget(buf, buf + n - 1, 1) == -1);
+    assert(next(0) == 24);
+    /* ev 0's n and rep, ev 1's, then its stops: make the second its first */
+    memcpy(&was, buf + 5 * sizeof(int), sizeof(int));
+    memcpy(buf + 5 * sizeof(int), &(int){30}, sizeof(int));
+    assert(tsget(buf, buf + n, 1) == -1 && next(0) == 24);
+    memcpy(buf + 5 * sizeof(int), &was, sizeof(int));
+    assert(tsget(buf, buf + n, 1) == n);
+    assert(next(0) == (40 | RTAB) && next(100) == 120);
+    ev = 2;
+    assert(next(0) == (70 | CTAB) && next(70) == 0);
+    ev = 0;
+    assert(next(0) == 0);
+}
+
+int main(void) {
+    printf("Starting tab stop unit tests...\n\n");
+    test_stops();
+    test_rep();
+    test_envs();
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
@@ -0,0 +1,143 @@
+/* C17 - no scaffold needed */
+/*
+ * test_trace.c - Tests for the -Y event trace
+ *
+ * Builds trace.c with CTRACE and a clock that ticks a microsecond per
+ * read, drives its hooks as croff would, and checks the JSON written:
+ * macros on timeline 1 as begin and end events, spans on timeline 2
+ * as complete events with their numbers, traps as instants, and
+ * diversions as async events.  Then overfills the ring and checks that
+ * the oldest events give way, no end is left without its begin, and
+ * the drop is reported.
+ *
+ *   cc -std=c17 -O2 -I. -Icroff -Isrc croff/test_trace.c -o test_trace
+ */
+
+#define _POSIX_C_SOURCE 200809L /* mkstemp() */
+#define CTRACE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+
+#include "trace.c"
+
+static long long clk;
+
+/* The clock trace.c reads */
+long long profnow(void) {
+    return (clk += 1000);
+}
+
+static char *slurp(const char *name) {
+    FILE *fp;
+    char *s;
+    long n;
+
+    assert((fp = fopen(name, "r")) != NULL);
+    fseek(fp, 0, SEEK_END);
+    n = ftell(fp);
+    rewind(fp);
+    assert((s = malloc(n + 1)) != NULL);
+    assert(fread(s, 1, n, fp) == (size_t)n);
+    s[n] = 0;
+    fclose(fp);
+    return (s);
+}
+
+static int count(const char *s, const char *what) {
+    int n = 0;
+
+    while ((s = strstr(s, what)) != NULL)
+        n++, s++;
+    return (n);
+}
+
+static char tmp[] = "/tmp/traceXXXXXX";
+
+static char *run(void) {
+    trreport();
+    return (slurp(trfile));
+}
+
+static void test_events(void) {
+    char *s;
+
+    printf("Testing the events of a page...\n");
+    tron = 1;
+    TRMARK(TR_TRAP, 'h' | 'd' << BYTE, 0);
+    TRMAC(('h' | 'd' << BYTE) | MMASK, 1);
+    TRBEG(TR_BREAK, 240);
+    TRBEG(TR_FLUSH, 81);
+    TREND();
+    TREND();
+    TRDIV('x' | 'x' << BYTE, 1);
+    TRBEG(TR_HYPH, 0);
+    TREND();
+    TRDIV('x' | 'x' << BYTE, 0);
+    TRPOP(1);
+    s = run();
+
+    assert(strstr(s, "\"traceEvents\":[") != NULL);
+    assert(strstr(s, "{\"name\":\"hd\",\"cat\":\"trap\",\"ph\":\"i\"") != NULL);
+    assert(strstr(s, "{\"name\":\"hd\",\"cat\":\"macro\",\"ph\":\"B\"") != NULL);
+    assert(count(s, "\"ph\":\"E\"") == 1);
+    assert(strstr(s, "\"cat\":\"break\",\"ph\":\"X\",\"ts\":2.000,\"pid\":1,\"tid\":2,"
+                     "\"dur\":3.000,\"args\":{\"nl\":240}") != NULL);
+    assert(strstr(s, "\"cat\":\"flusho\",\"ph\":\"X\",\"ts\":3.000,\"pid\":1,\"tid\":2,"
+                     "\"dur\":1.000,\"args\":{\"bytes\":81}") != NULL);
+    assert(strstr(s, "\"cat\":\"hyphenate\",\"ph\":\"X\"") != NULL);
+    assert(strstr(s, "\"ph\":\"b\",\"ts\":6.000,\"pid\":1,\"tid\":1,\"id\":\"xx\"") != NULL);
+    assert(strstr(s, "\"ph\":\"e\"") != NULL);
+    assert(strstr(s, "\"dropped\":0") != NULL);
+    free(s);
+}
+
+static void test_frames(void) {
+    char *s;
+
+    printf("Testing macros left by one popi()...\n");
+    TRMAC('a' | 'a' << BYTE, 1);
+    TRMAC('b' | 'b' << BYTE, 2);
+    TRMAC('c' | 'c' << BYTE, 2);
+    TRPOP(2); /* both at level 2 end */
+    assert(ntrm == 1);
+    s = run(); /* and the one still open ends at exit */
+    assert(count(s, "\"ph\":\"B\"") == 3 && count(s, "\"ph\":\"E\"") == 3);
+    free(s);
+}
+
+static void test_ring(void) {
+    char *s;
+    long k;
+
+    printf("Testing a full ring...\n");
+    TRMAC('o' | 'o' << BYTE, 1); /* its begin will give way */
+    for (k = 0; k < TRRING + 100; k++) {
+        TRBEG(TR_FLUSH, (int)k);
+        TREND();
+    }
+    TRPOP(1);
+    s = run();
+    assert(count(s, "\"ph\":\"B\"") == 0 && count(s, "\"ph\":\"E\"") == 0);
+    assert(count(s, "\"cat\":\"flusho\"") == TRRING - 1);
+    assert(strstr(s, "\"dropped\":102") != NULL);
+    free(s);
+}
+
+int main(void) {
+    int fd;
+
+    printf("Starting trace unit tests...\n\n");
+    assert((fd = mkstemp(tmp)) >= 0);
+    close(fd);
+    trfile = tmp;
+    test_events();
+    test_frames();
+    test_ring();
+    unlink(tmp);
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
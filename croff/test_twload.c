@@ -0,0 +1,110 @@
+/* C17 - no scaffold needed */
+/*
+ * test_twload.c - Tests for terminal table loading in twload.c
+ *
+ * Writes each built-in table to a file with mktab, maps it back with
+ * twload() and checks that every field and code matches the built-in
+ * table; then checks that a built-in name needs no file, and that
+ * files which are not tables, or are cut short, are refused.
+ *
+ *   cc -std=gnu17 -Icroff croff/test_twload.c croff/term/tab37.c \
+ *       croff/term/tabvt100.c croff/term/tabvt220.c croff/term/tabansi.c \
+ *       croff/term/tabxterm.c croff/term/tabs.c -o test_twload
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "twload.c"
+
+#define main mktab_main
+#include "term/mktab.c"
+#undef main
+
+struct typewriter_table t;
+
+static char file[64];
+
+static void same(const struct typewriter_table *a, const struct typewriter_table *b) {
+    const char *x, *y;
+    int i;
+
+    for (i = 0; i < TW_NINT; i++)
+        assert(*(const int *)((const char *)a + twintoff[i]) ==
+               *(const int *)((const char *)b + twintoff[i]));
+    for (i = 0; i < TW_NSTR; i++) {
+        x = *(char *const *)((const char *)a + twstroff[i]);
+        y = *(char *const *)((const char *)b + twstroff[i]);
+        assert(strcmp(x, y) == 0);
+    }
+    for (i = 0; i < TW_NCODE; i++) {
+        x = a->codetab[i];
+        y = b->codetab[i];
+        assert(x[0] == y[0]);
+        assert(strcmp(x + 1, y + 1) == 0);
+    }
+}
+
+static void test_files(void) {
+    int i;
+
+    printf("Testing table files...\n");
+    for (i = 0; i < ntwtabs; i++) {
+        assert(mktab(twtabs[i].tab, file) == 0);
+        memset(&t, 0, sizeof(t));
+        assert(twload(file, "not built in") == 0);
+        same(&t, twtabs[i].tab);
+        /* in place: the codes point into the mapping, not the built-in table */
+        assert(t.codetab[0] != twtabs[i].tab->codetab[0]);
+    }
+}
+
+static void test_builtin(void) {
+    printf("Testing built-in tables...\n");
+    memset(&t, 0, sizeof(t));
+    assert(twload("/nonexistent/37", "37") == 0);
+    same(&t, twtabs[0].tab);
+    assert(twload("/nonexistent/xx", "xx") < 0);
+}
+
+/* Write only the first n bytes of a good table, then alter byte k */
+static int damaged(long n, long k, int c) {
+    char buf[4096];
+    FILE *fp;
+    long len;
+
+    assert(mktab(twtabs[0].tab, file) == 0);
+    fp = fopen(file, "rb");
+    len = (long)fread(buf, 1, sizeof(buf), fp);
+    fclose(fp);
+    if (k >= 0)
+        buf[k] = (char)c;
+    fp = fopen(file, "wb");
+    fwrite(buf, 1, (size_t)(n < len ? n : len), fp);
+    fclose(fp);
+    return twload(file, "not built in");
+}
+
+static void test_bad(void) {
+    printf("Testing damaged files...\n");
+    assert(damaged(1L << 20, -1, 0) == 0);
+    assert(damaged(1L << 20, 0, 'x') < 0); /* magic */
+    assert(damaged(1L << 20, 4, 99) < 0); /* version */
+    assert(damaged(100, -1, 0) < 0); /* cut short */
+    assert(damaged(sizeof(struct twfile) + 10, -1, 0) < 0);
+}
+
+int main(void) {
+    printf("Starting twload unit tests...\n\n");
+
+    snprintf(file, sizeof(file), "/tmp/twload%ld", (long)getpid());
+    test_files();
+    test_builtin();
+    test_bad();
+    unlink(file);
+
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
@@ -0,0 +1,212 @@
+/* C17 - no scaffold needed */
+/*
+ * trace.c - Event trace of croff's page timeline for -Y
+ *
+ * With -Y<file>, in a croff built with CTRACE, the hooks of trace.h
+ * record events in a ring of TRRING entries, each stamped with
+ * os_now_ns().  When the ring is full the oldest events give way, so a
+ * long run keeps its last TRRING.  At exit the ring is written to
+ * <file> as Chrome trace JSON, times in microseconds from the first
+ * event.
+ *
+ * Two timelines are written.  Macros open and close as frames are
+ * pushed and popped, which is not when the functions that push them
+ * return, so they, with the traps that call them, go on timeline 1 as
+ * begin and end events.  Spans that begin and end within one function
+ * (tbreak(), hyphen(), flusho()) nest properly and go on timeline 2 as
+ * complete events.  Diversions open and close in any order against
+ * both, so they are async events keyed by name.
+ */
+
+#include "trace.h"
+#define OSA_TAG "croff.trace"
+#include "os/os_acct.h" // OSA_MALLOC, OSA_FREE
+
+int tron; /* -Y given */
+char *trfile; /* -Y<file> */
+
+#ifdef CTRACE
+
+#include "tdef.h" // troff definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TRRING (1 << 18) /* events kept, a power of two */
+#define TRSTK 64 /* open macros and spans followed */
+
+/* One event */
+struct trev {
+    long long t; /* when, or when a span began */
+    long long dur; /* a span's length */
+    int name; /* request or macro name */
+    int arg;
+    unsigned char kind;
+    char ph; /* Chrome phase: B, E, X, i, b or e */
+};
+
+long long profnow(void);
+
+static struct trev *tr;
+static unsigned long trn; /* events ever recorded */
+static int trmlev[TRSTK], ntrm; /* frame levels of open macros */
+static long long trst[TRSTK]; /* open spans: when each began */
+static int trsa[TRSTK]; /* and its number */
+static unsigned char trsk[TRSTK];
+static int ntrs, trlost; /* spans open, and spans deeper than TRSTK */
+
+static const char *trkind[] = {"macro", "trap", "break", "hyphenate", "diversion", "flusho"};
+static const char *trarg[] = {NULL, "nl", "nl", NULL, NULL, "bytes"}; /* what arg is */
+
+static struct trev *trnew(int kind, int ph) {
+    struct trev *e;
+
+    if (!tr && (tr = OSA_MALLOC(TRRING * sizeof(*tr))) == NULL) {
+        tron = 0;
+        return (NULL);
+    }
+    e = &tr[trn++ & (TRRING - 1)];
+    e->t = profnow();
+    e->dur = 0;
+    e->name = e->arg = 0;
+    e->kind = (unsigned char)kind;
+    e->ph = (char)ph;
+    return (e);
+}
+
+void trmac(int rq, int lev) {
+    struct trev *e;
+
+    if (ntrm == TRSTK || (e = trnew(TR_MACRO, 'B')) == NULL)
+        return;
+    e->name = rq & ~MMASK;
+    trmlev[ntrm++] = lev;
+}
+
+/* Frame level lev is being left: end every macro at or above it */
+void trpop(int lev) {
+    while (ntrm && trmlev[ntrm - 1] >= lev) {
+        ntrm--;
+        trnew(TR_MACRO, 'E');
+    }
+}
+
+void trmark(int kind, int name, int arg) {
+    struct trev *e;
+
+    if ((e = trnew(kind, 'i')) != NULL) {
+        e->name = name & ~MMASK;
+        e->arg = arg;
+    }
+}
+
+void trbeg(int kind, int arg) {
+    if (ntrs == TRSTK) {
+        trlost++;
+        return;
+    }
+    trsk[ntrs] = (unsigned char)kind;
+    trsa[ntrs] = arg;
+    trst[ntrs++] = profnow();
+}
+
+void trend(void) {
+    struct trev *e;
+
+    if (trlost) {
+        trlost--;
+        return;
+    }
+    if (!ntrs || (e = trnew(trsk[ntrs - 1], 'X')) == NULL)
+        return;
+    ntrs--;
+    e->dur = e->t - trst[ntrs];
+    e->t = trst[ntrs];
+    e->arg = trsa[ntrs];
+}
+
+void trdiv(int name, int begin) {
+    struct trev *e;
+
+    if ((e = trnew(TR_DIV, begin ? 'b' : 'e')) != NULL)
+        e->name = name & ~MMASK;
+}
+
+/* A request or macro name as JSON string contents */
+static void trname(FILE *fp, int name) {
+    int c, k;
+
+    for (k = 0; k < 2; k++, name >>= BYTE)
+        if ((c = name & BMASK) == '"' || c == '\\')
+            fprintf(fp, "\\%c", c);
+        else if (c && c < ' ')
+            fprintf(fp, "\\u%04x", c);
+        else if (c)
+            putc(c, fp);
+}
+
+/* Write the ring to trfile at exit */
+void trreport(void) {
+    struct trev *e;
+    unsigned long k, first;
+    long long t0;
+    FILE *fp;
+    int depth;
+
+    if (!tron || !tr)
+        return;
+    trpop(0);
+    while (ntrs)
+        trend(); /* spans cut off by exit */
+    if ((fp = fopen(trfile, "w")) == NULL) {
+        fprintf(stderr, "Cannot open %s\n", trfile);
+        return;
+    }
+    first = trn > TRRING ? trn - TRRING : 0;
+    t0 = tr[first & (TRRING - 1)].t;
+    for (k = first; k < trn; k++)
+        if (tr[k & (TRRING - 1)].t < t0)
+            t0 = tr[k & (TRRING - 1)].t; /* a span begun before the first event */
+    fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"events\":%lu,\"dropped\":%lu},\n"
+                "\"traceEvents\":[\n"
+                "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,"
+                "\"args\":{\"name\":\"macros and traps\"}},\n"
+                "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,"
+                "\"args\":{\"name\":\"breaks, hyphenation, output\"}}",
+            trn, first);
+    for (depth = 0, k = first; k < trn; k++) {
+        e = &tr[k & (TRRING - 1)];
+        if (e->ph == 'E' && depth-- == 0) {
+            depth = 0;
+            continue; /* its begin has given way */
+        }
+        if (e->ph == 'B')
+            depth++;
+        fprintf(fp, ",\n{\"name\":\"");
+        if (e->kind == TR_MACRO || e->kind == TR_TRAP || e->kind == TR_DIV)
+            trname(fp, e->name);
+        else
+            fputs(trkind[e->kind], fp);
+        fprintf(fp, "\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d",
+                trkind[e->kind], e->ph, (e->t - t0) / 1e3, e->ph == 'X' ? 2 : 1);
+        if (e->ph == 'X')
+            fprintf(fp, ",\"dur\":%.3f", e->dur / 1e3);
+        else if (e->ph == 'i')
+            fprintf(fp, ",\"s\":\"t\"");
+        if (trarg[e->kind] && (e->ph == 'X' || e->ph == 'i'))
+            fprintf(fp, ",\"args\":{\"%s\":%d}", trarg[e->kind], e->arg);
+        if (e->ph == 'b' || e->ph == 'e') {
+            fprintf(fp, ",\"id\":\"");
+            trname(fp, e->name);
+            fprintf(fp, "\"");
+        }
+        fprintf(fp, "}");
+    }
+    fprintf(fp, "\n]}\n");
+    fclose(fp);
+    OSA_FREE(tr);
+    tr = NULL;
+    trn = 0;
+}
+
+#endif /* CTRACE */
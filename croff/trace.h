@@ -0,0 +1,56 @@
+/* C17 - no scaffold needed */
+/*
+ * trace.h - Event trace of croff's page timeline for -Y
+ *
+ * Built with CTRACE (make TRACE=1) croff can record trap firings,
+ * macro entry and exit, line breaks, hyphenation, diversions and
+ * flusho() writes in a ring, written out at exit in the Chrome trace
+ * format that chrome://tracing and Perfetto read (trace.c).  Without
+ * CTRACE every hook below is nothing, and -Y is refused.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+/* Kinds of event */
+#define TR_MACRO 0 /* a macro body, pushi() to popi() */
+#define TR_TRAP 1 /* a trap sprung by newline() */
+#define TR_BREAK 2 /* tbreak() putting out a line */
+#define TR_HYPH 3 /* hyphen() on a word */
+#define TR_DIV 4 /* a diversion, .di to .di */
+#define TR_FLUSH 5 /* flusho() */
+
+extern int tron; /* -Y given */
+extern char *trfile; /* -Y<file> */
+
+#ifdef CTRACE
+
+void trmac(int rq, int lev);
+void trpop(int lev);
+void trmark(int kind, int name, int arg);
+void trbeg(int kind, int arg);
+void trend(void);
+void trdiv(int name, int begin);
+void trreport(void);
+
+/* Macro rq pushed as frame lev; frame lev left */
+#define TRMAC(rq, lev) (tron ? trmac((rq), (lev)) : (void)0)
+#define TRPOP(lev) (tron ? trpop(lev) : (void)0)
+/* At this moment, on the macro timeline */
+#define TRMARK(kind, name, arg) (tron ? trmark((kind), (name), (arg)) : (void)0)
+/* A span of work within one function, with a number to show for it */
+#define TRBEG(kind, arg) (tron ? trbeg((kind), (arg)) : (void)0)
+#define TREND() (tron ? trend() : (void)0)
+/* Diversion name opened or closed */
+#define TRDIV(name, begin) (tron ? trdiv((name), (begin)) : (void)0)
+#else
+#define TRMAC(rq, lev) ((void)0)
+#define TRPOP(lev) ((void)0)
+#define TRMARK(kind, name, arg) ((void)0)
+#define TRBEG(kind, arg) ((void)0)
+#define TREND() ((void)0)
+#define TRDIV(name, begin) ((void)0)
+#define trreport() ((void)0)
+#endif
+
+#endif /* TRACE_H */
@@ -16,10 +16,6 @@
 #define IBUFSZ 1024
 #endif
 
-#ifndef OBUFSZ
-#define OBUFSZ 1024
-#endif
-
 /*
  * Troff processor global buffers
  */
@@ -32,9 +28,15 @@ typedef struct {
     char *endInput;             /* End pointer for inputBuffer */
     char *endExtra;             /* End pointer for extraBuffer */
 
-    /* Output buffer and pointer */
-    char outputBuffer[OBUFSZ];  /* Device output buffer */
-    char *outputPtr;            /* Pointer into outputBuffer */
+    /* Memory-mapped input file, walked in place by inputPtr */
+    char *mapBase;              /* Start of mapping, NULL if none */
+    size_t mapLen;              /* Length of mapping in bytes */
+    int mapState;               /* 0 untried, 1 mapped, 2 cached, -1 use read() */
+
+    /* Output ring segment being filled by oput(), see obuf.c */
+    char *outputBuffer;         /* Start of the segment */
+    char *outputPtr;            /* Next free byte */
+    char *outputEnd;            /* Where oput() moves to the next segment */
 } TroffProcessor;
 
 /* Global processor instance */
@@ -0,0 +1,78 @@
+/* C17 - no scaffold needed */
+/*
+ * twload.c - Load the nroff terminal table
+ *
+ * The tables built into croff (term/tabs.c) are used straight away,
+ * without any I/O.  Any other table is a file written by mktab: it is
+ * mapped read-only and t is pointed into the mapping, so nothing is
+ * read or copied and the strings stay shared with every other nroff
+ * using the same table.  The mapping lasts until exit.
+ */
+#define NROFF 1
+#include "tdef.h" /* struct typewriter_table */
+#include "term/twfile.h"
+
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+int twload(const char *path, const char *name);
+
+/* Point t at the table file mapped at base */
+static int twmap(const char *base, size_t size) {
+    const struct twfile *h;
+    int i;
+
+    h = (const struct twfile *)(const void *)base;
+    if (size < sizeof(*h) + 1 || memcmp(h->magic, TW_MAGIC, sizeof(h->magic)) != 0 ||
+        h->version != TW_VERSION || h->size != size || base[size - 1] != 0)
+        return -1;
+    for (i = 0; i < TW_NSTR; i++)
+        if (h->str[i] >= size)
+            return -1;
+    for (i = 0; i < TW_NCODE; i++)
+        if (h->code[i] + 1 >= size)
+            return -1;
+    for (i = 0; i < TW_NINT; i++)
+        *(int *)((char *)&t + twintoff[i]) = h->ints[i];
+    for (i = 0; i < TW_NSTR; i++)
+        *(char **)((char *)&t + twstroff[i]) = (char *)base + h->str[i];
+    for (i = 0; i < TW_NCODE; i++)
+        t.codetab[i] = (char *)base + h->code[i];
+    t.zzz = 0;
+    return 0;
+}
+
+/*
+ * twload
+ * Sets up t for the terminal called name, whose table file is path.
+ * Returns -1 if there is no such table or the file is not one.
+ */
+int twload(const char *path, const char *name) {
+    struct stat st;
+    void *base;
+    int fd, i;
+
+    for (i = 0; i < ntwtabs; i++)
+        if (strcmp(twtabs[i].name, name) == 0) {
+            t = *twtabs[i].tab;
+            return 0;
+        }
+    if ((fd = open(path, O_RDONLY)) < 0)
+        return -1;
+    if (fstat(fd, &st) < 0 || st.st_size <= 0) {
+        close(fd);
+        return -1;
+    }
+    base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+        return -1;
+    if (twmap(base, (size_t)st.st_size) < 0) {
+        munmap(base, (size_t)st.st_size);
+        return -1;
+    }
+    return 0;
+}
@@ -89,10 +89,16 @@
 #define NEQN_BUFFER_SIZE 4096
 
 /**
- * @def NEQN_HASH_SIZE
- * @brief Size of hash tables for symbol lookup
+ * @def NEQN_SYMTAB_MIN
+ * @brief Initial slots in a context symbol table, a power of two
  */
-#define NEQN_HASH_SIZE 127
+#define NEQN_SYMTAB_MIN 64
+
+/**
+ * @def NEQN_ARENA_BLOCK
+ * @brief Bytes in each block of a per-equation arena
+ */
+#define NEQN_ARENA_BLOCK 16384
 
 /* ================================================================
  * ERROR CODES AND STATUS VALUES
@@ -142,6 +148,7 @@ typedef struct neqn_token {
     size_t length; /**< Length of token text */
     int line_number; /**< Source line number */
     int column_number; /**< Column position in line */
+    int in_arena; /**< Allocated from an arena, freed with it */
 } neqn_token_t;
 
 /**
@@ -171,6 +178,7 @@ typedef struct neqn_node {
     struct neqn_node *next; /**< Next sibling node */
     int precedence; /**< Operator precedence */
     int line_number; /**< Source line number */
+    int in_arena; /**< Allocated from an arena, freed with it */
 } neqn_node_t;
 
 /**
@@ -180,11 +188,29 @@ typedef struct neqn_symbol {
     char *name; /**< Symbol name */
     char *value; /**< Symbol value/definition */
     neqn_node_t *tree; /**< Parsed expression tree */
-    struct neqn_symbol *next; /**< Hash chain link */
     int line_defined; /**< Line where symbol was defined */
     int is_builtin; /**< Built-in symbol flag */
 } neqn_symbol_t;
 
+/**
+ * @brief Block of arena memory, data following the header
+ */
+typedef struct neqn_arena_block {
+    struct neqn_arena_block *next; /**< Next block in the chain */
+    size_t size; /**< Bytes of data in this block */
+    size_t used; /**< Bytes handed out since the last reset */
+} neqn_arena_block_t;
+
+/**
+ * @brief Bump allocator released all at once
+ */
+typedef struct neqn_arena {
+    neqn_arena_block_t *blocks; /**< First block */
+    neqn_arena_block_t *current; /**< Block allocations come from */
+    size_t used; /**< Bytes handed out since the last reset */
+    size_t peak; /**< Most bytes handed out between resets */
+} neqn_arena_t;
+
 /**
  * @brief Input/output context structure
  */
@@ -197,11 +223,17 @@ typedef struct neqn_context {
     int column_number; /**< Current column number */
     int error_count; /**< Total error count */
     int warning_count; /**< Total warning count */
-    neqn_symbol_t *symbols[NEQN_HASH_SIZE]; /**< Symbol table */
+    neqn_symbol_t **symbols; /**< Open-addressed user symbols, NULL if free */
+    size_t symbol_slots; /**< Slots in symbols, a power of two */
+    size_t symbol_count; /**< Symbols defined in this context */
     char *current_line; /**< Current input line buffer */
     size_t line_capacity; /**< Line buffer capacity */
     int debug_level; /**< Debug output level */
     int strict_mode; /**< Strict parsing mode flag */
+    neqn_arena_t arena; /**< Tokens and nodes of the equation at hand */
+    char *out_text; /**< Output kept in memory, when output is NULL */
+    size_t out_length; /**< Bytes in out_text */
+    size_t out_capacity; /**< Bytes allocated for out_text */
 } neqn_context_t;
 
 /* ================================================================
@@ -283,6 +315,32 @@ int neqn_context_set_input(neqn_context_t *context, const char *filename);
  */
 int neqn_context_set_output(neqn_context_t *context, const char *filename);
 
+/**
+ * @brief Keep the output of a context in memory instead of a file
+ *
+ * For a formatter running neqn in-process: the generated troff is
+ * collected with neqn_context_output() and read from there, with no
+ * pipe in between.
+ *
+ * @param context Processing context
+ * @return NEQN_SUCCESS on success, error code on failure
+ */
+int neqn_context_set_output_buffer(neqn_context_t *context);
+
+/**
+ * @brief The output kept in memory since it was last cleared
+ * @param context Processing context
+ * @param length Set to the number of bytes, if not NULL
+ * @return The text, NUL-terminated and owned by the context; "" if none
+ */
+const char *neqn_context_output(neqn_context_t *context, size_t *length);
+
+/**
+ * @brief Discard the output kept in memory, keeping the space
+ * @param context Processing context
+ */
+void neqn_context_clear_output(neqn_context_t *context);
+
 /* ================================================================
  * INPUT/OUTPUT AND LINE PROCESSING FUNCTIONS
  * ================================================================ */
@@ -313,6 +371,20 @@ int neqn_write_output(neqn_context_t *context, const char *format, ...);
  */
 int neqn_process_line(neqn_context_t *context, const char *line);
 
+/**
+ * @brief Process the lines of an equation held in memory
+ *
+ * Runs each line of text through neqn_process_line().  Contexts are
+ * independent, so a caller may keep one per document and process
+ * blocks from several in any order.
+ *
+ * @param context Processing context
+ * @param text Equation source, lines ended by newlines
+ * @param length Bytes in text
+ * @return NEQN_SUCCESS, or the first error a line gave
+ */
+int neqn_process_block(neqn_context_t *context, const char *text, size_t length);
+
 /* ================================================================
  * LEXICAL ANALYSIS FUNCTIONS
  * ================================================================ */
@@ -380,6 +452,9 @@ neqn_node_t *neqn_parse_expression(neqn_context_t *context,
 
 /**
  * @brief Initialize built-in mathematical symbols
+ *
+ * The built-ins live in one table shared by every context and built
+ * once, so this costs nothing after the first call.
  */
 int neqn_init_builtin_symbols(neqn_context_t *context);
 
@@ -554,6 +629,26 @@ int neqn_get_error_count(void);
  */
 char *neqn_strdup(const char *str);
 
+/**
+ * @brief Allocate from an arena
+ * @param arena Arena to allocate from
+ * @param size Bytes needed
+ * @return Pointer aligned for any type, or NULL on failure
+ */
+void *neqn_arena_alloc(neqn_arena_t *arena, size_t size);
+
+/**
+ * @brief Release everything allocated from an arena, keeping its blocks
+ * @param arena Arena to reset
+ */
+void neqn_arena_reset(neqn_arena_t *arena);
+
+/**
+ * @brief Free the blocks of an arena
+ * @param arena Arena to free
+ */
+void neqn_arena_free(neqn_arena_t *arena);
+
 /**
  * @brief Safe string concatenation with bounds checking
  * @param dest Destination buffer
@@ -566,7 +661,7 @@ int neqn_strcat_safe(char *dest, const char *src, size_t dest_size);
 /**
  * @brief Calculate hash value for string
  * @param str String to hash
- * @return Hash value
+ * @return Hash value, to be masked to a table size
  */
 unsigned int neqn_hash_string(const char *str);
 
@@ -54,6 +54,8 @@
  * PROJECT INCLUDES - Local Header Files
  * ================================================================ */
 #include "ne.h" /* Main neqn header with type definitions */
+#define OSA_TAG "neqn"
+#include "os/os_acct.h" /* OSA_MALLOC, OSA_FREE */
 
 /* ================================================================
  * MODULE-LEVEL CONSTANTS AND MACROS
@@ -528,14 +530,14 @@ static int neqn_validate_environment(void) {
 
     /* Validate memory allocation */
     {
-        void *test_ptr = malloc(1024);
+        void *test_ptr = OSA_MALLOC(1024);
         if (test_ptr == NULL) {
             if (neqn_debug_level > 0) {
                 fprintf(stderr, "neqn: Memory allocation test failed\n");
             }
             return -1;
         }
-        free(test_ptr);
+        OSA_FREE(test_ptr);
     }
 
     /* Check file I/O capabilities */
@@ -35,6 +35,7 @@
  */
 
 #include "ne.h" /* NEQN type definitions and global declarations */
+#include "os/os_acct.h" /* osa_report() for -S */
 #include <stdio.h> /* Standard I/O operations */
 #include <stdlib.h> /* Standard library functions */
 #include <signal.h> /* Signal handling for broken pipes */
@@ -67,6 +68,14 @@ int gsize = 10; /**< Default point size for equations */
 int gfont = 'R'; /**< Default font (Roman) for equations */
 char in[INPUT_BUFFER_SIZE]; /**< Input line buffer */
 int noeqn = 0; /**< Flag: suppress equation output if non-zero */
+static char *libout = NULL; /**< -M<file>: define library written at the end */
+static int statflg = 0; /**< -S: report allocation and I/O at the end */
+
+/* String register allocation: a stack of the free ones, lowest on top */
+static int used[MAX_REGISTERS]; /**< Non-zero while a register is live */
+static int ostack[MAX_REGISTERS]; /**< Free registers, popped by oalloc() */
+static int otop; /**< Number of entries on ostack */
+static int opeak; /**< Most registers live at once, for -d */
 
 /* External variables defined in other modules */
 extern int first; /**< First equation flag */
@@ -74,7 +83,6 @@ extern int lefteq, righteq; /**< Inline equation delimiter characters */
 extern int eqline, linect; /**< Line number tracking */
 extern int eqnreg, eqnht; /**< Equation register and height */
 extern int lastchar; /**< Last character read */
-extern int used[]; /**< Register allocation tracking array */
 extern int eht[], ebase[]; /**< Object height and baseline arrays */
 extern int ct, ps, ft; /**< Global typesetting state */
 extern int fout, fin; /**< Output and input file descriptors */
@@ -86,9 +94,24 @@ extern int dbg; /**< Debug flag */
 /* External function declarations */
 extern int yyparse(void); /* Yacc-generated parser entry point */
 extern int ngetc(void); /* Custom character input function */
+extern void passthru(void); /* Copy plain lines to the output in bulk */
 extern int numb(char *str); /* Parse number from string */
 extern void error(int level, char *fmt, char *arg); /* Error reporting */
 extern int VERT(int n); /* Convert to vertical units */
+extern int peep; /* -O: fold equation output */
+extern void peepbeg(void); /* Start holding back equation output */
+extern void peepend(int keep); /* Fold and send the held output */
+extern int eqcache; /* -C: reuse repeated equations */
+extern char *cachefile; /* -C<file>: keep the cache between runs */
+extern int cachehit(int inl); /* Write a kept equation, skipping its source */
+extern void cachebeg(void); /* Start collecting an equation to keep */
+extern void cacheend(void); /* Keep and send the equation just parsed */
+extern void cachesave(void); /* Write the cache back to its file */
+extern void eqlibload(const char *file); /* Load a define library */
+extern int eqlibsave(const char *file); /* Write the defines to one */
+extern int njobs; /* -j: displays formatted at once */
+extern int eqfork(int (*run)(void)); /* Format a display in a child */
+extern int eqdrain(void); /* Send the output of all children */
 
 /* Local function prototypes for C90 compliance */
 static void signal_handler(int sig);
@@ -105,6 +128,7 @@ int putout(int p1);
 int max(int i, int j);
 int oalloc(void);
 int ofree(int n);
+void ostart(int keep);
 int setps(int p);
 int nrwid(int n1, int p, int n2);
 int setfile(int argc, char *argv[]);
@@ -179,20 +203,22 @@ static int validate_arguments(int argc, char *argv[]) {
  * @return 0 on success, non-zero on error
  */
 static int process_equation_block(void) {
-    int i;
-
-    /* Clear register allocation table */
-    for (i = FIRST_REGISTER; i < MAX_REGISTERS; i++) {
-        used[i] = 0;
-    }
+    /* Nothing from an earlier equation is live any more */
+    ostart(0);
 
     /* Output the .EQ line and save current troff state */
     printf("%s", in);
     printf(".nr 99 \\n(.s\n.nr 98 \\n(.f\n");
 
-    /* Initialize parser state and invoke parser */
-    init();
-    yyparse();
+    /* Initialize parser state and invoke parser, unless it is kept */
+    if (!cachehit(0)) {
+        cachebeg();
+        peepbeg();
+        init();
+        yyparse();
+        peepend(eqnreg);
+        cacheend();
+    }
 
     /* Generate output if equation was successfully parsed */
     if (eqnreg > 0) {
@@ -236,6 +262,8 @@ static int process_inline_equation(void) {
 static void cleanup_and_exit(int status) {
     flush(fout);
     flush(fout); /* Double flush for reliability */
+    if (statflg)
+        osa_report(stderr);
     exit(status);
 }
 
@@ -291,12 +319,17 @@ int main(int argc, char *argv[]) {
     setfile(argc, argv);
 
     /* Main processing loop - read and process input line by line */
-    while ((type = ne_getline(in)) != '\0') {
+    for (;;) {
+        /* Lines with no equation in them go straight through */
+        passthru();
+        if ((type = ne_getline(in)) == '\0')
+            break;
         eqline = linect;
 
         /* Check for block equation start (.EQ) */
         if (in[0] == '.' && in[1] == 'E' && in[2] == 'Q') {
-            process_equation_block();
+            if (!eqfork(process_equation_block))
+                process_equation_block();
 
             /* Handle continuation after .EN */
             if (lastchar == '\0') {
@@ -324,7 +357,10 @@ int main(int argc, char *argv[]) {
     }
 
     /* Final cleanup and exit */
-    cleanup_and_exit(0);
+    cachesave();
+    if (libout != NULL && !eqlibsave(libout))
+        error(FATAL, "can't write define library %s", libout);
+    cleanup_and_exit(eqdrain());
     return 0; /* Never reached, but satisfies compiler */
 }
 
@@ -343,7 +379,7 @@ int main(int argc, char *argv[]) {
  * Buffer Management:
  * - Input is read into the provided buffer
  * - Buffer is null-terminated for safe string operations
- * - Left equation delimiter is not included in the buffer
+ * - A closing newline is kept; the left equation delimiter is not
  *
  * @param s Pointer to buffer for storing the input line
  * @return Character that terminated the input (newline, null, or lefteq)
@@ -361,16 +397,16 @@ int ne_getline(char *s) {
     /* Read characters until termination condition */
     while ((c = ngetc()) != '\n' && c != '\0' && c != lefteq) {
         /* Check for buffer overflow */
-        if (s - start >= INPUT_BUFFER_SIZE - 1) {
+        if (s - start >= INPUT_BUFFER_SIZE - 2) {
             error(FATAL, "input line too long (>%d characters)", "");
             break;
         }
         *s++ = c;
     }
 
-    /* Handle left equation delimiter */
-    if (c == lefteq) {
-        --s; /* Don't include delimiter in buffer */
+    /* Keep the newline, as passthru() does; the delimiter is dropped */
+    if (c == '\n') {
+        *s++ = c;
     }
 
     /* Null-terminate the string */
@@ -413,6 +449,7 @@ int inline_equation(void) {
     printf(".nr 99 \\n(.s\n.nr 98 \\n(.f\n");
 
     /* Allocate string register for accumulating output */
+    ostart(0);
     ds = oalloc();
     if (ds <= 0) {
         error(FATAL, "failed to allocate string register for inline equation", "");
@@ -427,15 +464,22 @@ int inline_equation(void) {
         /* Add current line content to accumulator */
         printf(".as %d \"%s\n", ds, in);
 
-        /* Initialize parser and process equation */
-        init();
-        yyparse();
+        /* Initialize parser and process equation, unless it is kept */
+        if (!cachehit(1)) {
+            cachebeg();
+            peepbeg();
+            init();
+            yyparse();
+            peepend(eqnreg);
+            cacheend();
+        }
 
         /* Append equation result if parsing succeeded */
-        if (eqnreg > 0) {
+        if (eqnreg > 0)
             printf(".as %d \\*(%d\n", ds, eqnreg);
-            ofree(eqnreg);
-        }
+
+        /* Only the accumulator outlives the equation just appended */
+        ostart(ds);
 
         /* Restore troff state after equation */
         printf(".ps \\n(99\n.ft \\n(98\n");
@@ -537,47 +581,71 @@ int max(int i, int j) {
     return (i > j) ? i : j;
 }
 
+/**
+ * @brief Mark every string register free except one.
+ *
+ * Called at equation boundaries, where nothing but the result being
+ * accumulated can still be referenced.  Registers a reduction forgot
+ * to free (error recovery, a pile cut short) come back here instead of
+ * piling up over a document until oalloc() runs dry.
+ *
+ * The free stack is rebuilt with the lowest register on top, so each
+ * equation starts again from register 11.
+ *
+ * @param keep Register that stays live, or 0 for none
+ */
+void ostart(int keep) {
+    int i;
+
+    otop = 0;
+    for (i = MAX_REGISTERS - 1; i >= FIRST_REGISTER; i--) {
+        used[i] = (i == keep);
+        if (i != keep)
+            ostack[otop++] = i;
+    }
+}
+
 /**
  * @brief Allocate a troff string register.
  *
- * Finds and allocates an unused troff string register from the
- * available pool. Registers are tracked in the global 'used' array
- * to prevent conflicts and double allocation.
+ * Pops the top of the free stack.  ofree() pushes a register back on
+ * top, so the register a reduction has just consumed is the one its
+ * result gets, and the set of live registers stays as small as the
+ * nesting of the equation allows.
  *
  * Register Management:
  * - Registers 11-99 are available for allocation
  * - Register 0-10 are reserved for system use
- * - used[] array tracks allocation status
+ * - used[] records which registers are live, for checking ofree()
  *
  * @return Register number on success, 0 on failure
  */
 int oalloc(void) {
     int i;
 
-    /* Search for available register */
-    for (i = FIRST_REGISTER; i < MAX_REGISTERS; i++) {
-        if (used[i] == 0) {
-            used[i] = 1; /* Mark as allocated */
-
-            if (dbg) {
-                fprintf(stderr, "oalloc: allocated register %d\n", i);
-            }
+    if (otop == 0 && ostack[0] == 0)
+        ostart(0); /* first call, before any equation */
+    if (otop == 0) {
+        error(FATAL, "no string registers available", "");
+        return 0;
+    }
+    i = ostack[--otop];
+    used[i] = 1;
+    if (MAX_REGISTERS - FIRST_REGISTER - otop > opeak)
+        opeak = MAX_REGISTERS - FIRST_REGISTER - otop;
 
-            return i;
-        }
+    if (dbg) {
+        fprintf(stderr, "oalloc: allocated register %d, %d live, peak %d\n",
+                i, MAX_REGISTERS - FIRST_REGISTER - otop, opeak);
     }
 
-    /* No registers available */
-    error(FATAL, "no string registers available", "");
-    return 0;
+    return i;
 }
 
 /**
  * @brief Free a previously allocated troff string register.
  *
- * Marks a register as available for reuse by clearing its allocation
- * flag in the used[] array. This enables efficient register recycling
- * during equation processing.
+ * Pushes the register back on the free stack for the next oalloc().
  *
  * @param n Register number to free
  * @return 0 on success
@@ -596,6 +664,7 @@ int ofree(int n) {
 
     /* Mark register as available */
     used[n] = 0;
+    ostack[otop++] = n;
 
     if (dbg) {
         fprintf(stderr, "ofree: freed register %d\n", n);
@@ -659,6 +728,14 @@ int nrwid(int n1, int p, int n2) {
  * - -s<size>: Set default point size
  * - -f<font>: Set default font
  * - -e: Suppress equation output (noeqn mode)
+ * - -O: Fold redundant troff out of each equation (see ne7.c)
+ * - -C[file]: Reuse the output of repeated equations (see ne8.c)
+ * - -j[n]: Format up to n displays at once (see ne9.c)
+ * - -L<file>: Start with the defines of a library (see nelex.c);
+ *   $NEQNLIB names one loaded before the options
+ * - -M<file>: Write the defines in effect at the end to a library
+ * - -S: Report allocation and I/O by call site at the end, in a
+ *   build with OSACCT (see os/os_acct.h)
  * - Other: Enable debug mode
  *
  * File Handling:
@@ -675,6 +752,10 @@ int setfile(int argc, char *argv[]) {
     svargc = --argc;
     svargv = argv;
 
+    /* A define library for every run, as through cpipe */
+    if (getenv("NEQNLIB") != NULL && *getenv("NEQNLIB") != '\0')
+        eqlibload(getenv("NEQNLIB"));
+
     /* Process command-line options */
     while (svargc > 0 && svargv[1][0] == '-') {
         switch (svargv[1][1]) {
@@ -706,6 +787,38 @@ int setfile(int argc, char *argv[]) {
             noeqn++;
             break;
 
+        case 'O':
+            /* Fold redundant troff in each equation's output */
+            peep = 1;
+            break;
+
+        case 'j':
+            /* Format displays in parallel, by default one per processor */
+            njobs = svargv[1][2] != '\0' ? numb(&svargv[1][2]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+            break;
+
+        case 'C':
+            /* Reuse repeated equations, kept in a file if one is named */
+            eqcache = 1;
+            if (svargv[1][2] != '\0')
+                cachefile = &svargv[1][2];
+            break;
+
+        case 'L':
+            /* Start with the defines, delim, gsize and gfont of a library */
+            eqlibload(&svargv[1][2]);
+            break;
+
+        case 'M':
+            /* Compile the defines made by the end into a library */
+            libout = &svargv[1][2];
+            break;
+
+        case 'S':
+            /* Report allocation and I/O at the end */
+            statflg = 1;
+            break;
+
         default:
             /* Unknown option - enable debug mode */
             dbg = 1;
@@ -0,0 +1,441 @@
+/* C17 - no scaffold needed */
+/**
+ * @file ne7.c
+ * @brief NEQN equation typesetting - Part 7: Peephole pass over the output.
+ *
+ * The reductions in ne1.c through ne6.c write their troff strings as they
+ * go, one small .ds/.as/.nr at a time.  With -O the output of each equation
+ * is held back until the parser is done with it and then tidied before it
+ * goes to troff, which has to read every byte of it again.
+ *
+ * Folds:
+ * - A string defined by a single .ds and interpolated exactly once is
+ *   written in place of its \*(nn and the .ds goes away.  A string that
+ *   is never interpolated before it is redefined or the equation ends
+ *   is dropped.
+ * - Neighbouring constant motions \h'Au'\h'Bu' (and \v) become one, and
+ *   a motion of zero is left out.
+ * - A size change that another one replaces before anything is set, or
+ *   that sets the size the line already has, is left out.
+ *
+ * Only folds that cannot change what troff prints are made.  A string is
+ * inlined only if its text reads the same in either place: no \n, \*, \$
+ * or \\ in it, and no quote outside the argument of an escape.  Font
+ * changes are left alone, since dropping one would move what \fP returns
+ * to.  The result register of the equation is referenced after the
+ * capture ends and always keeps its .ds.
+ *
+ * Design Principles:
+ * - The equation output is captured below stdio, on descriptor 1, so the
+ *   printf() calls in the other modules are untouched
+ * - Without -O nothing is captured and output is exactly as before
+ * - capbeg()/capend() are shared with the equation cache of ne8.c
+ */
+
+#include "ne.h" /* NEQN type definitions and global declarations */
+#define OSA_TAG "neqn"
+#include "os/os_acct.h" /* OSA_MALLOC, OSA_FREE, OSA_READ */
+#include <stdio.h> /* Standard I/O for the captured output */
+#include <stdlib.h> /* Memory allocation */
+#include <string.h> /* String manipulation functions */
+#include <unistd.h> /* dup(), dup2(), lseek(), read() */
+
+/* SCCS version identifier */
+static const char sccs_id[] = "@(#)ne7.c 1.0 25/05/29";
+
+#define NCAP 2 /**< Captures that can be on at once */
+#define CAP_PEEP 0 /**< Capture for the folds below */
+#define CAP_CACHE 1 /**< Capture for the equation cache, ne8.c */
+
+int peep = 0; /**< -O: fold the output of each equation */
+
+static FILE *ctmp[NCAP]; /**< Scratch file each capture goes to */
+static int csave[NCAP] = {-1, -1}; /**< Standard output while capturing */
+
+/* Function prototypes for external interface */
+int capbeg(int k);
+char *capend(int k, long *n);
+void peepbeg(void);
+void peepend(int keep);
+
+/**
+ * @brief Start holding back standard output.
+ *
+ * Points descriptor 1 at the scratch file of capture k, opened on first
+ * use and kept for the rest of the run.  Captures nest: one started
+ * while another is on collects what the inner one sends on.
+ *
+ * @param k CAP_PEEP or CAP_CACHE
+ * @return 1 if output is now being held back, 0 if not
+ */
+int capbeg(int k) {
+    if (csave[k] >= 0)
+        return 0;
+    if (ctmp[k] == NULL && (ctmp[k] = tmpfile()) == NULL)
+        return 0;
+    fflush(stdout);
+    if ((csave[k] = dup(1)) < 0)
+        return 0;
+    if (dup2(fileno(ctmp[k]), 1) < 0) {
+        close(csave[k]);
+        csave[k] = -1;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Stop capture k and hand back what it held.
+ *
+ * If there is no room for the text, it is sent on as it stands.
+ *
+ * @param k CAP_PEEP or CAP_CACHE
+ * @param n Set to the length of the text
+ * @return The text, NUL-terminated, for the caller to free; NULL if
+ *         the capture was not on, held nothing or could not be kept
+ */
+char *capend(int k, long *n) {
+    char *text, buf[BUFSIZ];
+    off_t size, got;
+    ssize_t r;
+    int fd;
+
+    *n = 0;
+    if (csave[k] < 0)
+        return NULL;
+    fflush(stdout);
+    dup2(csave[k], 1);
+    close(csave[k]);
+    csave[k] = -1;
+
+    /* The descriptors share one offset: it is where the output ended */
+    fd = fileno(ctmp[k]);
+    if ((size = lseek(fd, 0, SEEK_CUR)) <= 0 || lseek(fd, 0, SEEK_SET) < 0)
+        return NULL;
+    if ((text = (char *)OSA_MALLOC((size_t)size + 1)) == NULL) {
+        for (; size > 0; size -= r) {
+            if ((r = OSA_READ(fd, buf, size < BUFSIZ ? (size_t)size : BUFSIZ)) <= 0)
+                break;
+            fwrite(buf, 1, (size_t)r, stdout);
+        }
+        lseek(fd, 0, SEEK_SET);
+        return NULL;
+    }
+    for (got = 0; got < size; got += r)
+        if ((r = OSA_READ(fd, text + got, (size_t)(size - got))) <= 0)
+            break;
+    lseek(fd, 0, SEEK_SET);
+    text[got] = 0;
+    *n = (long)got;
+    return text;
+}
+
+/**
+ * @brief Start holding back equation output for the folds.
+ *
+ * If that cannot be done the equation goes out unfolded.
+ */
+void peepbeg(void) {
+    if (peep)
+        capbeg(CAP_PEEP);
+}
+
+/* Is s the two-character name n, as neqn prints it? */
+static int isreg(const char *s, const char *n) {
+    return s[0] == n[0] && s[1] == n[1];
+}
+
+/* The name of the string a ".ds nn" or ".as nn" line sets, else NULL */
+static const char *defname(const char *s, int *as) {
+    if (s[0] != '.' || s[2] != 's' || s[3] != ' ')
+        return NULL;
+    if (s[1] != 'd' && s[1] != 'a')
+        return NULL;
+    if (s[4] == 0 || s[5] == 0 || (s[6] != ' ' && s[6] != 0))
+        return NULL;
+    *as = (s[1] == 'a');
+    return s + 4;
+}
+
+/* The text a ".ds nn" line gives its string */
+static const char *deftext(const char *s) {
+    s += 6;
+    while (*s == ' ')
+        s++;
+    if (*s == '"')
+        s++;
+    return s;
+}
+
+/* Number of \*(nn in s; *at is the first */
+static int uses(const char *s, const char *n, const char **at) {
+    int k = 0;
+
+    for (; (s = strstr(s, "\\*(")) != NULL; s += 3)
+        if (s[3] && s[4] && isreg(s + 3, n)) {
+            if (k++ == 0)
+                *at = s;
+        }
+    return k;
+}
+
+/* Escapes taking an argument between quotes, as \h'..' does */
+static int delimited(int c) {
+    return c != 0 && strchr("hvwoxlLbDZXk", c) != NULL;
+}
+
+/* Past the quoted argument starting at t, NULL if it never ends */
+static const char *skiparg(const char *t) {
+    for (t++; *t != '\''; t++) {
+        if (*t == 0)
+            return NULL;
+        if (*t != '\\')
+            continue;
+        if (delimited(t[1]) && t[2] == '\'') {
+            if ((t = skiparg(t + 2)) == NULL)
+                return NULL;
+            t--;
+        } else if (*++t == 0) {
+            return NULL;
+        }
+    }
+    return t + 1;
+}
+
+/*
+ * Text that interpolates to the same thing wherever it is read: no
+ * escape that copy mode expands, and no quote of its own that could
+ * end a \w'..' it is put in.
+ */
+static int portable(const char *t) {
+    while (*t) {
+        if (*t == '\'')
+            return 0;
+        if (*t != '\\') {
+            t++;
+            continue;
+        }
+        if (t[1] == 'n' || t[1] == '*' || t[1] == '$' || t[1] == '\\' || t[1] == 0)
+            return 0;
+        if (delimited(t[1]) && t[2] == '\'') {
+            if ((t = skiparg(t + 2)) == NULL)
+                return 0;
+        } else {
+            t += 2;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Write single-use strings in place of their interpolation.
+ *
+ * Lines that are dropped are set to NULL.
+ */
+static void inline_strings(char **line, int n, int keep) {
+    char knm[3], *s;
+    const char *nm, *at, *t, *u;
+    int i, j, k, as, cnt, uj;
+    size_t tl;
+
+    sprintf(knm, "%02d", keep % 100);
+    for (i = 0; i < n; i++) {
+        if (line[i] == NULL || (nm = defname(line[i], &as)) == NULL || as)
+            continue;
+        t = deftext(line[i]);
+        if (!portable(t))
+            continue;
+        cnt = 0;
+        uj = -1;
+        at = NULL;
+        for (j = i + 1; j < n; j++) {
+            if (line[j] == NULL)
+                continue;
+            if ((u = defname(line[j], &as)) != NULL && isreg(u, nm)) {
+                if (as)
+                    cnt = -1; /* added to: not a single .ds */
+                break;
+            }
+            if ((k = uses(line[j], nm, &u)) > 0) {
+                if (cnt == 0) {
+                    uj = j;
+                    at = u;
+                }
+                cnt += k;
+            }
+        }
+        if (cnt < 0 || cnt > 1)
+            continue;
+        if (j == n && keep > 0 && isreg(nm, knm))
+            continue; /* read after the capture */
+        if (cnt == 0) {
+            OSA_FREE(line[i]);
+            line[i] = NULL;
+            continue;
+        }
+        /* .ds M \*(nn would lose leading blanks or a quote of the text */
+        if (at > line[uj] && at[-1] == ' ' && (*t == ' ' || *t == '"'))
+            continue;
+        tl = strlen(t);
+        if ((s = (char *)OSA_MALLOC(strlen(line[uj]) - 5 + tl + 1)) == NULL)
+            continue;
+        memcpy(s, line[uj], (size_t)(at - line[uj]));
+        memcpy(s + (at - line[uj]), t, tl);
+        strcpy(s + (at - line[uj]) + tl, at + 5);
+        OSA_FREE(line[uj]);
+        line[uj] = s;
+        OSA_FREE(line[i]);
+        line[i] = NULL;
+    }
+}
+
+/* A constant motion \h'Nu' or \v'Nu' at s: its length, 0 if none */
+static int motion(const char *s, int *dir, long *v) {
+    const char *p = s + 3;
+    long x = 0;
+    int neg = 0;
+
+    if (s[0] != '\\' || (s[1] != 'h' && s[1] != 'v') || s[2] != '\'')
+        return 0;
+    if (*p == '-') {
+        neg = 1;
+        p++;
+    }
+    if (*p < '0' || *p > '9')
+        return 0;
+    while (*p >= '0' && *p <= '9')
+        x = x * 10 + (*p++ - '0');
+    if (p[0] != 'u' || p[1] != '\'')
+        return 0;
+    *dir = s[1];
+    *v = neg ? -x : x;
+    return (int)(p + 2 - s);
+}
+
+/* A constant size \sN at s as troff reads it: its length, 0 if none */
+static int sizechg(const char *s, int *v) {
+    if (s[0] != '\\' || s[1] != 's' || s[2] < '1' || s[2] > '9')
+        return 0;
+    if (s[2] < '4' && s[3] >= '0' && s[3] <= '9') {
+        *v = (s[2] - '0') * 10 + (s[3] - '0');
+        return 4;
+    }
+    *v = s[2] - '0';
+    return 3;
+}
+
+/**
+ * @brief Fold motions and size changes within one line.
+ *
+ * Copies s to d, which must be at least as long.
+ */
+static void fold_line(char *d, const char *s, int sizes) {
+    char *d0 = d;
+    long v, w;
+    int dir, dir2, len, len2, cur, sz, sz2;
+
+    cur = 0; /* size unknown */
+    while (*s) {
+        if ((len = motion(s, &dir, &v)) > 0) {
+            while ((len2 = motion(s + len, &dir2, &w)) > 0 && dir2 == dir) {
+                v += w;
+                len += len2;
+            }
+            if (v != 0 || (d > d0 && d[-1] == ' '))
+                d += sprintf(d, "\\%c'%ldu'", dir, v);
+            s += len;
+            continue;
+        }
+        if (sizes && (len = sizechg(s, &sz)) > 0) {
+            /* replaced at once, or already in effect */
+            if (sizechg(s + len, &sz2) > 0 || sz == cur) {
+                s += len;
+                continue;
+            }
+            cur = sz;
+            memcpy(d, s, (size_t)len);
+            d += len;
+            s += len;
+            continue;
+        }
+        if (s[0] == '\\' && s[1] != 0) {
+            if (s[1] == '*' || s[1] == 's')
+                cur = 0; /* a string or an odd size: size unknown */
+            *d++ = *s++;
+        }
+        *d++ = *s++;
+    }
+    *d = 0;
+}
+
+/* Write the lines left after the folds */
+static void emit(char **line, int n, int sizes, int lastnl) {
+    char *buf = NULL;
+    size_t cap = 0, len;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        if (line[i] == NULL)
+            continue;
+        len = strlen(line[i]) * 2 + 32; /* a merged motion may grow */
+        if (len > cap) {
+            OSA_FREE(buf);
+            if ((buf = (char *)OSA_MALLOC(cap = len)) == NULL) {
+                fputs(line[i], stdout);
+                cap = 0;
+                continue;
+            }
+        }
+        fold_line(buf, line[i], sizes);
+        fputs(buf, stdout);
+        if (i < n - 1 || lastnl)
+            putchar('\n');
+    }
+    OSA_FREE(buf);
+}
+
+/**
+ * @brief Stop capturing, fold the equation's output and send it on.
+ *
+ * @param keep Register the caller still reads after this, 0 for none
+ */
+void peepend(int keep) {
+    char *text, *p, *q, **line;
+    long size;
+    int n, i, sizes, lastnl;
+
+    if ((text = capend(CAP_PEEP, &size)) == NULL)
+        return;
+
+    /* Split into lines, dropping the newlines */
+    for (n = 1, p = text; (p = strchr(p, '\n')) != NULL; p++)
+        n++;
+    lastnl = size > 0 && text[size - 1] == '\n';
+    if (lastnl)
+        n--;
+    if ((line = (char **)OSA_MALLOC(n * sizeof(*line))) == NULL) {
+        fputs(text, stdout);
+        OSA_FREE(text);
+        return;
+    }
+    for (i = 0, p = text; i < n; i++, p = q + 1) {
+        if ((q = strchr(p, '\n')) == NULL)
+            q = p + strlen(p);
+        *q = 0;
+        line[i] = strdup(p);
+    }
+
+    /* \s0 goes back to the size before the last change; keep them all */
+    sizes = strstr(text, "\\s0") == NULL;
+    OSA_FREE(text);
+    for (i = 0; i < n; i++)
+        if (line[i] == NULL || strncmp(line[i], ".rn", 3) == 0)
+            break;
+    if (i == n)
+        inline_strings(line, n, keep);
+    emit(line, n, sizes, lastnl);
+
+    for (i = 0; i < n; i++)
+        OSA_FREE(line[i]);
+    OSA_FREE(line);
+}
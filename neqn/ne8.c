@@ -0,0 +1,301 @@
+/* C17 - no scaffold needed */
+/**
+ * @file ne8.c
+ * @brief NEQN equation typesetting - Part 8: Cache of formatted equations.
+ *
+ * Documents tend to repeat the same equations: a variable name between
+ * delimiters, a unit, a display quoted again in a summary.  With -C each
+ * equation's troff is kept, keyed by its source text and everything else
+ * the parser reads: the point size and font in effect, the delimiters
+ * and the defines made so far.  When the same key comes round again the
+ * kept text is written and the source skipped, without calling yyparse().
+ *
+ * Register numbers need no remapping.  Every equation starts from the
+ * same free register stack (ostart() in ne4.c), so the same source gets
+ * the same registers wherever it is.
+ *
+ * An equation is kept only if parsing it read exactly the source found
+ * beforehand and changed none of the state in the key, so an equation
+ * holding a define, delim, gsize or gfont is always parsed.  With
+ * -C<file> the cache is also read from that file at the start and
+ * written back at the end, for the next run over the same documents.
+ *
+ * Technical Implementation:
+ * - Open-addressed table probed linearly, doubled at 70% load
+ * - The whole key is compared on a hash match
+ * - Output is collected with the capture of ne7.c, after its folds
+ */
+
+#include "ne.h" /* NEQN type definitions and global declarations */
+#define OSA_TAG "neqn"
+#include "os/os_acct.h" /* OSA_MALLOC, OSA_CALLOC, OSA_FREE */
+#include <stdio.h> /* Standard I/O for the cache file */
+#include <stdlib.h> /* Memory allocation */
+#include <string.h> /* String manipulation functions */
+
+/* SCCS version identifier */
+static const char sccs_id[] = "@(#)ne8.c 1.0 25/05/29";
+
+#define CAP_CACHE 1 /**< Capture slot of the cache, see ne7.c */
+#define CACHEMIN 256 /**< Initial table size, a power of two */
+#define CACHEMAX (64L << 20) /**< Bytes of keys and text kept at most */
+#define CACHEMAGIC "neqn cache 1\n" /**< First line of a cache file */
+
+/* External variables defined in other modules */
+extern int gsize, gfont; /**< Point size and font in effect */
+extern int eqnreg, eqnht; /**< Result register and height */
+extern int dbg; /**< Debug flag */
+
+/* External function declarations */
+extern int capbeg(int k); /* Start holding back output */
+extern char *capend(int k, long *n); /* Stop and hand back the output */
+extern const char *eqsrc(int inl, size_t *n); /* Source of the next equation */
+extern int eqpast(const char *p); /* Has the parser read up to p? */
+extern void eqskip(const char *p); /* Skip the source up to p */
+extern unsigned long eqdefs(void); /* Digest of defines and delims */
+
+typedef struct {
+    unsigned long hash; /**< Hash of the key */
+    char *key; /**< Key bytes, NULL for an unused slot */
+    size_t klen; /**< Length of the key */
+    char *text; /**< Troff the equation produced */
+    size_t tlen; /**< Length of the text */
+    int reg, ht; /**< eqnreg and eqnht after the parse */
+} eqcache_t;
+
+int eqcache = 0; /**< -C: reuse the output of repeated equations */
+char *cachefile = NULL; /**< -C<file>: where the cache is kept between runs */
+
+static eqcache_t *ctab; /**< The cache */
+static int csize; /**< Slots in ctab */
+static int cfill; /**< Slots in use */
+static long cbytes; /**< Bytes held by the entries */
+static int cdirty; /**< Entries added since the file was read */
+static int cloaded; /**< cachefile read */
+
+/* Key and end of the source of the equation being parsed */
+static char *ckey;
+static size_t cklen;
+static const char *cend;
+static int cinl;
+static int ccapture;
+
+/* Function prototypes for external interface */
+int cachehit(int inl);
+void cachebeg(void);
+void cacheend(void);
+void cachesave(void);
+
+static unsigned long chash(const char *s, size_t n) {
+    unsigned long h = 14695981039346656037ul;
+
+    while (n-- > 0)
+        h = (h ^ (unsigned char)*s++) * 1099511628211ul;
+    return h;
+}
+
+/* The slot of key k, which is either its entry or unused */
+static eqcache_t *cslot(const char *k, size_t n, unsigned long h) {
+    eqcache_t *e;
+    int i;
+
+    for (i = (int)(h & (csize - 1));; i = (i + 1) & (csize - 1)) {
+        e = &ctab[i];
+        if (e->key == NULL ||
+            (e->hash == h && e->klen == n && memcmp(e->key, k, n) == 0))
+            return e;
+    }
+}
+
+/* Enter a key and text the cache now owns; 0 if it cannot take them */
+static int cput(char *k, size_t kn, char *t, size_t tn, int reg, int ht) {
+    eqcache_t *o, *e;
+    unsigned long h;
+    int n, j;
+
+    if (cbytes + (long)(kn + tn) > CACHEMAX)
+        return 0;
+    if ((cfill + 1) * 10 >= csize * 7) {
+        o = ctab;
+        n = csize;
+        if ((ctab = (eqcache_t *)OSA_CALLOC(n ? 2 * n : CACHEMIN, sizeof(*ctab))) == NULL) {
+            ctab = o;
+            return 0;
+        }
+        csize = n ? 2 * n : CACHEMIN;
+        for (j = 0; j < n; j++)
+            if (o[j].key != NULL)
+                *cslot(o[j].key, o[j].klen, o[j].hash) = o[j];
+        OSA_FREE(o);
+    }
+    h = chash(k, kn);
+    e = cslot(k, kn, h);
+    if (e->key != NULL)
+        return 0; /* already there */
+    e->hash = h;
+    e->key = k;
+    e->klen = kn;
+    e->text = t;
+    e->tlen = tn;
+    e->reg = reg;
+    e->ht = ht;
+    cfill++;
+    cbytes += (long)(kn + tn);
+    return 1;
+}
+
+/* Read the entries of cachefile, if there is one */
+static void cload(void) {
+    FILE *f;
+    char magic[sizeof(CACHEMAGIC)], *k, *t;
+    unsigned long kn, tn;
+    int reg, ht;
+
+    cloaded = 1;
+    if (cachefile == NULL || (f = fopen(cachefile, "rb")) == NULL)
+        return;
+    if (fread(magic, 1, sizeof(CACHEMAGIC) - 1, f) != sizeof(CACHEMAGIC) - 1 ||
+        memcmp(magic, CACHEMAGIC, sizeof(CACHEMAGIC) - 1) != 0) {
+        fclose(f);
+        return;
+    }
+    while (fscanf(f, "%lu %lu %d %d\n", &kn, &tn, &reg, &ht) == 4) {
+        if (kn + tn > (unsigned long)CACHEMAX)
+            break;
+        if ((k = (char *)OSA_MALLOC(kn + 1)) == NULL)
+            break;
+        if ((t = (char *)OSA_MALLOC(tn + 1)) == NULL) {
+            OSA_FREE(k);
+            break;
+        }
+        if (fread(k, 1, kn, f) != kn || fread(t, 1, tn, f) != tn ||
+            !cput(k, kn, t, tn, reg, ht)) {
+            OSA_FREE(k);
+            OSA_FREE(t);
+            break;
+        }
+    }
+    fclose(f);
+}
+
+/* The state the parser starts from, as the first line of a key */
+static int chead(char *head, int inl) {
+    return sprintf(head, "%d %d %d %lx\n", inl, gsize, gfont, eqdefs());
+}
+
+/*
+ * The key of the equation at the input: the state the parser starts
+ * from, then the source.  Sets cend to the end of the source.
+ */
+static int ckeymake(int inl) {
+    const char *src;
+    size_t n;
+    char head[64];
+    int hn;
+
+    if ((src = eqsrc(inl, &n)) == NULL)
+        return 0;
+    hn = chead(head, inl);
+    cinl = inl;
+    if ((ckey = (char *)OSA_MALLOC(hn + n)) == NULL)
+        return 0;
+    memcpy(ckey, head, hn);
+    memcpy(ckey + hn, src, n);
+    cklen = hn + n;
+    cend = src + n;
+    return 1;
+}
+
+/**
+ * @brief Write the kept output of the equation at the input, if any.
+ *
+ * On a hit the source is skipped and eqnreg and eqnht are set as the
+ * parse would have set them.  On a miss the key is kept for
+ * cachebeg().
+ *
+ * @param inl Non-zero for an inline equation
+ * @return 1 if the equation was taken from the cache
+ */
+int cachehit(int inl) {
+    eqcache_t *e;
+
+    OSA_FREE(ckey);
+    ckey = NULL;
+    if (!eqcache || dbg)
+        return 0;
+    if (!cloaded)
+        cload();
+    if (!ckeymake(inl))
+        return 0;
+    if (csize > 0) {
+        e = cslot(ckey, cklen, chash(ckey, cklen));
+        if (e->key != NULL) {
+            fwrite(e->text, 1, e->tlen, stdout);
+            eqnreg = e->reg;
+            eqnht = e->ht;
+            eqskip(cend);
+            OSA_FREE(ckey);
+            ckey = NULL;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Start collecting the output of the equation cachehit() missed.
+ */
+void cachebeg(void) {
+    ccapture = ckey != NULL && capbeg(CAP_CACHE);
+}
+
+/**
+ * @brief Keep the output of the equation just parsed and send it on.
+ *
+ * Nothing is kept unless the parse read exactly the source the key was
+ * made from and left the state in the key as it found it.
+ */
+void cacheend(void) {
+    char *text, *k, head[64];
+    long n;
+    int hn;
+
+    if (!ccapture)
+        return;
+    ccapture = 0;
+    text = capend(CAP_CACHE, &n);
+    if (text != NULL)
+        fwrite(text, 1, (size_t)n, stdout);
+    k = ckey;
+    ckey = NULL;
+    hn = chead(head, cinl);
+    if (text == NULL || !eqpast(cend) || memcmp(k, head, hn) != 0 ||
+        !cput(k, cklen, text, (size_t)n, eqnreg, eqnht)) {
+        OSA_FREE(k);
+        OSA_FREE(text);
+        return;
+    }
+    cdirty = 1;
+}
+
+/**
+ * @brief Write the cache back to cachefile if it has grown.
+ */
+void cachesave(void) {
+    FILE *f;
+    int i;
+
+    if (cachefile == NULL || !cdirty || (f = fopen(cachefile, "wb")) == NULL)
+        return;
+    fputs(CACHEMAGIC, f);
+    for (i = 0; i < csize; i++)
+        if (ctab[i].key != NULL) {
+            fprintf(f, "%lu %lu %d %d\n", (unsigned long)ctab[i].klen,
+                    (unsigned long)ctab[i].tlen, ctab[i].reg, ctab[i].ht);
+            fwrite(ctab[i].key, 1, ctab[i].klen, f);
+            fwrite(ctab[i].text, 1, ctab[i].tlen, f);
+        }
+    if (fclose(f) != 0)
+        remove(cachefile);
+    cdirty = 0;
+}
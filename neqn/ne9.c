@@ -0,0 +1,201 @@
+/* C17 - no scaffold needed */
+/**
+ * @file ne9.c
+ * @brief NEQN equation typesetting - Part 9: Displays formatted in parallel.
+ *
+ * With -j<n> each .EQ display is parsed and laid out in a child process
+ * while the main one reads on, up to n children at a time.  Output is
+ * put back together in input order.
+ *
+ * Displays only share define, delim, gsize and gfont.  A child is
+ * forked at the start of its display, so it starts with a copy of all
+ * the state the main process has at that point, defines included.  A
+ * display that could change that state is run in the main process, so
+ * every later display sees the change.  Processes share nothing else,
+ * so the parser and the register and size tables of ne1.c to ne6.c
+ * stay as they are.
+ *
+ * Technical Implementation:
+ * - The source of a display must be in the input block already; the
+ *   child reads only from there and never from the file
+ * - The output of each child goes to a file of its own, and so does
+ *   whatever the main process writes in between
+ * - A queue of those files is copied to standard output in input
+ *   order, waiting for a child only when its file is at the front
+ * - Inline equations are always done in the main process
+ */
+
+#include "ne.h" /* NEQN type definitions and global declarations */
+#define OSA_TAG "neqn"
+#include "os/os_acct.h" /* OSA_REALLOC, OSA_READ, OSA_WRITE */
+#include <errno.h> /* EINTR */
+#include <stdio.h> /* Standard I/O */
+#include <stdlib.h> /* Memory allocation, exit() */
+#include <string.h> /* String manipulation functions */
+#include <unistd.h> /* fork(), dup2(), read(), write() */
+#include <sys/wait.h> /* waitpid() */
+
+/* SCCS version identifier */
+static const char sccs_id[] = "@(#)ne9.c 1.0 25/05/29";
+
+/* External function declarations */
+extern const char *eqsrc(int inl, size_t *n); /* Source of the next equation */
+extern void eqskip(const char *p); /* Skip the source up to p */
+extern void eqlimit(const char *p); /* Read nothing past p */
+
+typedef struct {
+    pid_t pid; /**< Child writing the file, 0 for the main process */
+    int fd; /**< The output, unlinked */
+} eqseg_t;
+
+int njobs = 0; /**< -j: children at once; 0 or 1 for none */
+
+static eqseg_t *segq; /**< Output files not yet copied, in input order */
+static int segn; /**< Entries in segq */
+static int segcap; /**< Entries allocated for segq */
+static int realout = -1; /**< Standard output while the queue is in use */
+static int running; /**< Children not yet waited for */
+static int worst; /**< Worst exit status of a child */
+
+/* Function prototypes for external interface */
+int eqfork(int (*run)(void));
+int eqdrain(void);
+
+/* Could the display change the state the ones after it read? */
+static int stateful(const char *s, size_t n) {
+    static const char *const word[] = {"define", "delim", "gsize", "gfont"};
+    const char *p, *e = s + n;
+    size_t k, len;
+
+    for (k = 0; k < sizeof(word) / sizeof(word[0]); k++) {
+        len = strlen(word[k]);
+        for (p = s; (p = (const char *)memchr(p, word[k][0], e - p)) != NULL && (size_t)(e - p) >= len; p++)
+            if (memcmp(p, word[k], len) == 0)
+                return 1;
+    }
+    return 0;
+}
+
+/* A new, already unlinked, output file */
+static int segopen(void) {
+    char tmp[] = "/tmp/neqnXXXXXX";
+    int fd;
+
+    if ((fd = mkstemp(tmp)) < 0)
+        return -1;
+    unlink(tmp);
+    return fd;
+}
+
+/* Send the file at the front of the queue, waiting for its child */
+static void segnext(void) {
+    char buf[BUFSIZ];
+    eqseg_t s = segq[0];
+    ssize_t r;
+    int status;
+
+    if (s.pid != 0) {
+        while (waitpid(s.pid, &status, 0) < 0)
+            if (errno != EINTR) {
+                status = -1; /* lost: count it as failed */
+                break;
+            }
+        running--;
+        if (status == -1 || !WIFEXITED(status))
+            worst |= 1;
+        else
+            worst |= WEXITSTATUS(status);
+    }
+    lseek(s.fd, 0, SEEK_SET);
+    while ((r = OSA_READ(s.fd, buf, sizeof(buf))) > 0)
+        if (OSA_WRITE(realout, buf, (size_t)r) != r)
+            break;
+    close(s.fd);
+    memmove(segq, segq + 1, --segn * sizeof(*segq));
+}
+
+static int segput(pid_t pid, int fd) {
+    eqseg_t *q;
+
+    if (segn == segcap) {
+        if ((q = (eqseg_t *)OSA_REALLOC(segq, (segcap ? 2 * segcap : 16) * sizeof(*segq))) == NULL)
+            return -1;
+        segq = q;
+        segcap = segcap ? 2 * segcap : 16;
+    }
+    segq[segn].pid = pid;
+    segq[segn++].fd = fd;
+    return 0;
+}
+
+/**
+ * @brief Run the display at the input in a child, if it can be.
+ *
+ * The .EQ line is in the input buffer of ne4.c; run() does the rest of
+ * the display and is what the main process would have called.  On
+ * return the main process is past the display and lastchar is what
+ * ended its .EN, as if run() had been called here.
+ *
+ * @param run The function formatting one display
+ * @return 1 if a child has the display, 0 if the caller must run it
+ */
+int eqfork(int (*run)(void)) {
+    const char *src;
+    size_t n;
+    pid_t pid;
+    int cfd, pfd;
+
+    if (njobs <= 1 || (src = eqsrc(0, &n)) == NULL || stateful(src, n))
+        return 0;
+    fflush(stdout);
+    if (realout < 0 && (realout = dup(1)) < 0)
+        return 0;
+    while (running >= njobs)
+        segnext();
+    if ((cfd = segopen()) < 0)
+        return 0;
+    if ((pfd = segopen()) < 0) {
+        close(cfd);
+        return 0;
+    }
+    if ((pid = fork()) < 0) {
+        close(cfd);
+        close(pfd);
+        return 0;
+    }
+    if (pid == 0) {
+        dup2(cfd, 1);
+        close(cfd);
+        close(pfd);
+        eqlimit(src + n);
+        run();
+        fflush(stdout);
+        _exit(0);
+    }
+    running++;
+    if (segput(pid, cfd) < 0 || segput(0, pfd) < 0) {
+        /* the order could not be kept any more */
+        fprintf(stderr, "neqn: out of memory\n");
+        exit(1);
+    }
+    eqskip(src + n);
+    dup2(pfd, 1); /* what follows the display comes after it */
+    return 1;
+}
+
+/**
+ * @brief Send all queued output and wait for every child.
+ *
+ * @return The worst exit status of the children, 0 if all went well
+ */
+int eqdrain(void) {
+    if (realout < 0)
+        return 0;
+    fflush(stdout);
+    while (segn > 0)
+        segnext();
+    dup2(realout, 1);
+    close(realout);
+    realout = -1;
+    return worst;
+}
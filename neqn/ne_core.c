@@ -19,6 +19,7 @@
  * ================================================================ */
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <cctype>
 #include <cerrno>
@@ -29,6 +30,8 @@
  * ================================================================ */
 #include "ne.h"              // main header
 #include "os_abstraction.h"  // platform wrappers
+#define OSA_TAG "neqn"
+#include "os_acct.h"         // OSA_MALLOC, OSA_REALLOC, OSA_FREE
 
 /* ================================================================
  * MODULE CONSTANTS
@@ -36,6 +39,9 @@
 #define NEQN_INITIAL_LINE_SIZE 256
 #define NEQN_LINE_GROWTH_FACTOR 2
 
+/* Arena new tokens and nodes come from, NULL for malloc() */
+static neqn_arena_t *neqn_alloc_arena = NULL;
+
 /* ================================================================
  * CONTEXT MANAGEMENT FUNCTIONS
  * ================================================================ */
@@ -45,9 +51,8 @@
  */
 neqn_context_t *neqn_context_create(void) {
     neqn_context_t *context;
-    int i;
 
-    context = malloc(sizeof(neqn_context_t));
+    context = (neqn_context_t *)OSA_MALLOC(sizeof(neqn_context_t));
     if (context == NULL) {
         return NULL;
     }
@@ -66,16 +71,16 @@ neqn_context_t *neqn_context_create(void) {
     context->debug_level = 0;
     context->strict_mode = 0;
 
-    /* Initialize symbol table */
-    for (i = 0; i < NEQN_HASH_SIZE; i++) {
-        context->symbols[i] = NULL;
-    }
+    /* The symbol table is allocated with the first definition */
+    context->symbols = NULL;
+    context->symbol_slots = 0;
+    context->symbol_count = 0;
 
     /* Allocate initial line buffer */
     context->line_capacity = NEQN_INITIAL_LINE_SIZE;
-    context->current_line = malloc(context->line_capacity);
+    context->current_line = (char *)OSA_MALLOC(context->line_capacity);
     if (context->current_line == NULL) {
-        free(context);
+        OSA_FREE(context);
         return NULL;
     }
 
@@ -86,8 +91,8 @@ neqn_context_t *neqn_context_create(void) {
  * @brief Destroy a neqn processing context
  */
 void neqn_context_destroy(neqn_context_t *context) {
-    int i;
-    neqn_symbol_t *sym, *next;
+    size_t i;
+    neqn_symbol_t *sym;
 
     if (context == NULL) {
         return;
@@ -104,38 +109,41 @@ void neqn_context_destroy(neqn_context_t *context) {
 
     /* Free filename strings */
     if (context->input_filename != NULL) {
-        free(context->input_filename);
+        OSA_FREE(context->input_filename);
     }
 
     if (context->output_filename != NULL) {
-        free(context->output_filename);
+        OSA_FREE(context->output_filename);
     }
 
-    /* Free line buffer */
+    /* Free line buffer and any output kept in memory */
     if (context->current_line != NULL) {
-        free(context->current_line);
+        OSA_FREE(context->current_line);
     }
+    OSA_FREE(context->out_text);
+
+    /* Free the equation arena */
+    neqn_arena_free(&context->arena);
 
     /* Free symbol table */
-    for (i = 0; i < NEQN_HASH_SIZE; i++) {
+    for (i = 0; i < context->symbol_slots; i++) {
         sym = context->symbols[i];
-        while (sym != NULL) {
-            next = sym->next;
+        if (sym != NULL) {
             if (sym->name != NULL) {
-                free(sym->name);
+                OSA_FREE(sym->name);
             }
             if (sym->value != NULL) {
-                free(sym->value);
+                OSA_FREE(sym->value);
             }
             if (sym->tree != NULL) {
                 neqn_node_destroy(sym->tree);
             }
-            free(sym);
-            sym = next;
+            OSA_FREE(sym);
         }
     }
+    OSA_FREE(context->symbols);
 
-    free(context);
+    OSA_FREE(context);
 }
 
 /**
@@ -168,7 +176,7 @@ int neqn_context_set_input(neqn_context_t *context, const char *filename) {
 
     /* Update filename */
     if (context->input_filename != NULL) {
-        free(context->input_filename);
+        OSA_FREE(context->input_filename);
         context->input_filename = NULL;
     }
 
@@ -216,7 +224,7 @@ int neqn_context_set_output(neqn_context_t *context, const char *filename) {
 
     /* Update filename */
     if (context->output_filename != NULL) {
-        free(context->output_filename);
+        OSA_FREE(context->output_filename);
         context->output_filename = NULL;
     }
 
@@ -230,6 +238,52 @@ int neqn_context_set_output(neqn_context_t *context, const char *filename) {
     return NEQN_SUCCESS;
 }
 
+/**
+ * @brief Keep the output of a context in memory instead of a file
+ */
+int neqn_context_set_output_buffer(neqn_context_t *context) {
+    if (context == NULL) {
+        return NEQN_ERROR_INVALID;
+    }
+
+    /* Close previous output if not stdout */
+    if (context->output != NULL && context->output != stdout) {
+        os_fclose(context->output);
+    }
+    context->output = NULL;
+
+    if (context->output_filename != NULL) {
+        OSA_FREE(context->output_filename);
+        context->output_filename = NULL;
+    }
+
+    context->out_length = 0;
+    return NEQN_SUCCESS;
+}
+
+/**
+ * @brief The output kept in memory since it was last cleared
+ */
+const char *neqn_context_output(neqn_context_t *context, size_t *length) {
+    if (length != NULL) {
+        *length = context != NULL ? context->out_length : 0;
+    }
+    if (context == NULL || context->out_text == NULL) {
+        return "";
+    }
+    return context->out_text;
+}
+
+/**
+ * @brief Discard the output kept in memory, keeping the space
+ */
+void neqn_context_clear_output(neqn_context_t *context) {
+    if (context != NULL && context->out_text != NULL) {
+        context->out_length = 0;
+        context->out_text[0] = '\0';
+    }
+}
+
 /* ================================================================
  * INPUT/OUTPUT FUNCTIONS
  * ================================================================ */
@@ -261,7 +315,7 @@ int neqn_read_line(neqn_context_t *context, char **buffer, size_t *capacity) {
         /* Expand buffer if needed */
         if (pos >= buffer_size - 1) {
             size_t new_size = buffer_size * NEQN_LINE_GROWTH_FACTOR;
-            char *new_buffer = ((char*)realloc(line_buffer, new_size));
+            char *new_buffer = ((char*)OSA_REALLOC(line_buffer, new_size));
             if (new_buffer == NULL) {
                 return -1;
             }
@@ -312,11 +366,41 @@ int neqn_write_output(neqn_context_t *context, const char *format, ...) {
         return -1;
     }
 
-    va_start(args, format);
-    result = vfprintf(context->output, format, args);
-    va_end(args);
+    if (context->output != NULL) {
+        va_start(args, format);
+        result = vfprintf(context->output, format, args);
+        va_end(args);
+        return result;
+    }
 
-    return result;
+    /* In memory: format in place, growing the buffer if it is short */
+    for (;;) {
+        size_t room = context->out_capacity - context->out_length;
+        size_t size;
+        char *text;
+
+        va_start(args, format);
+        result = vsnprintf(context->out_text != NULL ? context->out_text + context->out_length : NULL,
+                           room, format, args);
+        va_end(args);
+        if (result < 0) {
+            return -1;
+        }
+        if ((size_t)result < room) {
+            context->out_length += (size_t)result;
+            return result;
+        }
+        size = context->out_capacity ? 2 * context->out_capacity : NEQN_INITIAL_LINE_SIZE;
+        while (size - context->out_length <= (size_t)result) {
+            size *= 2;
+        }
+        text = (char *)OSA_REALLOC(context->out_text, size);
+        if (text == NULL) {
+            return -1;
+        }
+        context->out_text = text;
+        context->out_capacity = size;
+    }
 }
 
 /**
@@ -328,8 +412,8 @@ int neqn_process_line(neqn_context_t *context, const char *line) {
     neqn_token_t *tokens[NEQN_MAX_ARGS];
     size_t token_count = 0;
     neqn_node_t *tree;
+    neqn_arena_t *outer;
     int result = NEQN_SUCCESS;
-    size_t i;
 
     if (context == NULL || line == NULL) {
         return NEQN_ERROR_INVALID;
@@ -341,6 +425,10 @@ int neqn_process_line(neqn_context_t *context, const char *line) {
         return NEQN_SUCCESS;
     }
 
+    /* Tokens and nodes of this line all come from the context arena */
+    outer = neqn_alloc_arena;
+    neqn_alloc_arena = &context->arena;
+
     /* Tokenize the line */
     while (pos < strlen(line) && token_count < NEQN_MAX_ARGS) {
         token = neqn_get_next_token(context, line, &pos);
@@ -349,7 +437,6 @@ int neqn_process_line(neqn_context_t *context, const char *line) {
         }
 
         if (token->type == NEQN_TOKEN_EOF) {
-            neqn_token_destroy(token);
             break;
         }
 
@@ -362,21 +449,58 @@ int neqn_process_line(neqn_context_t *context, const char *line) {
         if (tree != NULL) {
             /* Generate output */
             result = neqn_generate_output(context, tree);
-            neqn_node_destroy(tree);
         } else {
             neqn_error(context, NEQN_ERROR_SYNTAX, "Failed to parse expression");
             result = NEQN_ERROR_SYNTAX;
         }
     }
 
-    /* Clean up tokens */
-    for (i = 0; i < token_count; i++) {
-        neqn_token_destroy(tokens[i]);
-    }
+    /* Release tokens, tree and their text in one step */
+    neqn_alloc_arena = outer;
+    neqn_arena_reset(&context->arena);
 
     return result;
 }
 
+/**
+ * @brief Process the lines of an equation held in memory
+ */
+int neqn_process_block(neqn_context_t *context, const char *text, size_t length) {
+    const char *end, *nl;
+    size_t n;
+    char *line;
+    int result, first_error = NEQN_SUCCESS;
+
+    if (context == NULL || text == NULL) {
+        return NEQN_ERROR_INVALID;
+    }
+
+    for (end = text + length; text < end; text += n) {
+        nl = (const char *)memchr(text, '\n', (size_t)(end - text));
+        n = nl != NULL ? (size_t)(nl - text) + 1 : (size_t)(end - text);
+
+        /* The line, newline and all, in the context line buffer */
+        if (n + 1 > context->line_capacity) {
+            line = (char *)OSA_REALLOC(context->current_line, n + 1);
+            if (line == NULL) {
+                return NEQN_ERROR_MEMORY;
+            }
+            context->current_line = line;
+            context->line_capacity = n + 1;
+        }
+        memcpy(context->current_line, text, n);
+        context->current_line[n] = '\0';
+        context->line_number++;
+
+        result = neqn_process_line(context, context->current_line);
+        if (result != NEQN_SUCCESS && first_error == NEQN_SUCCESS) {
+            first_error = result;
+        }
+    }
+
+    return first_error;
+}
+
 /* ================================================================
  * TOKEN MANAGEMENT FUNCTIONS
  * ================================================================ */
@@ -389,7 +513,11 @@ neqn_token_t *neqn_token_create(neqn_token_type_t type,
                                 size_t length) {
     neqn_token_t *token;
 
-    token = static_cast<neqn_token_t *>(malloc(sizeof(neqn_token_t)));
+    if (neqn_alloc_arena != NULL) {
+        token = ((neqn_token_t *)neqn_arena_alloc(neqn_alloc_arena, sizeof(neqn_token_t)));
+    } else {
+        token = static_cast<neqn_token_t *>(OSA_MALLOC(sizeof(neqn_token_t)));
+    }
     if (token == NULL) {
         return NULL;
     }
@@ -398,11 +526,18 @@ neqn_token_t *neqn_token_create(neqn_token_type_t type,
     token->length = length;
     token->line_number = 0;
     token->column_number = 0;
+    token->in_arena = (neqn_alloc_arena != NULL);
 
     if (text != NULL && length > 0) {
-        token->text = ((char*)malloc(length + 1));
+        if (token->in_arena) {
+            token->text = ((char*)neqn_arena_alloc(neqn_alloc_arena, length + 1));
+        } else {
+            token->text = ((char*)OSA_MALLOC(length + 1));
+        }
         if (token->text == NULL) {
-            free(token);
+            if (!token->in_arena) {
+                OSA_FREE(token);
+            }
             return NULL;
         }
         memcpy(token->text, text, length);
@@ -418,15 +553,15 @@ neqn_token_t *neqn_token_create(neqn_token_type_t type,
  * @brief Destroy a token
  */
 void neqn_token_destroy(neqn_token_t *token) {
-    if (token == NULL) {
+    if (token == NULL || token->in_arena) {
         return;
     }
 
     if (token->text != NULL) {
-        free(token->text);
+        OSA_FREE(token->text);
     }
 
-    free(token);
+    OSA_FREE(token);
 }
 
 /**
@@ -504,8 +639,13 @@ neqn_token_t *neqn_get_next_token(neqn_context_t *context,
  */
 neqn_node_t *neqn_node_create(neqn_node_type_t type, const char *content) {
     neqn_node_t *node;
+    size_t len;
 
-    node = static_cast<neqn_node_t *>(malloc(sizeof(neqn_node_t)));
+    if (neqn_alloc_arena != NULL) {
+        node = ((neqn_node_t *)neqn_arena_alloc(neqn_alloc_arena, sizeof(neqn_node_t)));
+    } else {
+        node = static_cast<neqn_node_t *>(OSA_MALLOC(sizeof(neqn_node_t)));
+    }
     if (node == NULL) {
         return NULL;
     }
@@ -516,11 +656,22 @@ neqn_node_t *neqn_node_create(neqn_node_type_t type, const char *content) {
     node->next = NULL;
     node->precedence = 0;
     node->line_number = 0;
+    node->in_arena = (neqn_alloc_arena != NULL);
 
     if (content != NULL) {
-        node->content = neqn_strdup(content);
+        if (node->in_arena) {
+            len = strlen(content);
+            node->content = ((char*)neqn_arena_alloc(neqn_alloc_arena, len + 1));
+            if (node->content != NULL) {
+                memcpy(node->content, content, len + 1);
+            }
+        } else {
+            node->content = neqn_strdup(content);
+        }
         if (node->content == NULL) {
-            free(node);
+            if (!node->in_arena) {
+                OSA_FREE(node);
+            }
             return NULL;
         }
     } else {
@@ -532,9 +683,12 @@ neqn_node_t *neqn_node_create(neqn_node_type_t type, const char *content) {
 
 /**
  * @brief Destroy an expression tree
+ *
+ * A node from an arena goes with the arena, and with it everything
+ * built under it while that arena was in use.
  */
 void neqn_node_destroy(neqn_node_t *node) {
-    if (node == NULL) {
+    if (node == NULL || node->in_arena) {
         return;
     }
 
@@ -545,10 +699,10 @@ void neqn_node_destroy(neqn_node_t *node) {
 
     /* Free content */
     if (node->content != NULL) {
-        free(node->content);
+        OSA_FREE(node->content);
     }
 
-    free(node);
+    OSA_FREE(node);
 }
 
 /**
@@ -749,7 +903,7 @@ char *neqn_strdup(const char *str) {
     }
 
     len = strlen(str);
-    copy = ((char*)malloc(len + 1));
+    copy = ((char*)OSA_MALLOC(len + 1));
     if (copy == NULL) {
         return NULL;
     }
@@ -758,6 +912,95 @@ char *neqn_strdup(const char *str) {
     return copy;
 }
 
+/**
+ * @brief Allocate from an arena
+ *
+ * Memory comes from the current block, or the next one kept from
+ * before the last reset, or a new block of at least NEQN_ARENA_BLOCK
+ * bytes linked in after the current one.
+ */
+void *neqn_arena_alloc(neqn_arena_t *arena, size_t size) {
+    neqn_arena_block_t *b;
+    size_t bsize;
+    char *p;
+
+    if (arena == NULL) {
+        return NULL;
+    }
+
+    /* Keep every allocation aligned for any type */
+    size = (size + sizeof(max_align_t) - 1) & ~(sizeof(max_align_t) - 1);
+
+    b = arena->current;
+    while (b != NULL && b->size - b->used < size) {
+        b = b->next;
+        if (b != NULL) {
+            b->used = 0;
+        }
+    }
+
+    if (b == NULL) {
+        bsize = size > NEQN_ARENA_BLOCK ? size : NEQN_ARENA_BLOCK;
+        b = ((neqn_arena_block_t*)OSA_MALLOC(sizeof(max_align_t) + bsize));
+        if (b == NULL) {
+            return NULL;
+        }
+        b->size = bsize;
+        b->used = 0;
+        if (arena->current != NULL) {
+            b->next = arena->current->next;
+            arena->current->next = b;
+        } else {
+            b->next = arena->blocks;
+            arena->blocks = b;
+        }
+    }
+
+    arena->current = b;
+    p = (char *)b + sizeof(max_align_t) + b->used;
+    b->used += size;
+    arena->used += size;
+    if (arena->used > arena->peak) {
+        arena->peak = arena->used;
+    }
+
+    return p;
+}
+
+/**
+ * @brief Release everything allocated from an arena, keeping its blocks
+ */
+void neqn_arena_reset(neqn_arena_t *arena) {
+    if (arena == NULL) {
+        return;
+    }
+
+    arena->current = arena->blocks;
+    if (arena->current != NULL) {
+        arena->current->used = 0;
+    }
+    arena->used = 0;
+}
+
+/**
+ * @brief Free the blocks of an arena
+ */
+void neqn_arena_free(neqn_arena_t *arena) {
+    neqn_arena_block_t *b, *next;
+
+    if (arena == NULL) {
+        return;
+    }
+
+    for (b = arena->blocks; b != NULL; b = next) {
+        next = b->next;
+        OSA_FREE(b);
+    }
+
+    arena->blocks = arena->current = NULL;
+    arena->used = 0;
+}
+
 /**
  * @brief Safe string concatenation with bounds checking
  */
@@ -795,7 +1038,8 @@ unsigned int neqn_hash_string(const char *str) {
         str++;
     }
 
-    return hash % NEQN_HASH_SIZE;
+    /* Fold the high bits down so masking to a table size uses them */
+    return hash ^ (hash >> 16);
 }
 
 /* ================================================================
@@ -12,6 +12,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include "ne.h"
+#define OSA_TAG "neqn"
+#include "os/os_acct.h" /* OSA_MALLOC, OSA_CALLOC, OSA_FREE */
 
 /* ================================================================
  * BUILT-IN MATHEMATICAL SYMBOLS
@@ -91,43 +93,121 @@ static const neqn_builtin_symbol_t builtin_symbols[] = {
  * SYMBOL TABLE FUNCTIONS
  * ================================================================ */
 
+/*
+ * Symbols are kept in open-addressed tables probed linearly.  The
+ * built-ins sit in one table shared by all contexts, filled the first
+ * time any context asks and never changed after.  Each context has
+ * its own table of the symbols defined in it, doubled at 70% load; a
+ * definition of a built-in name goes there and hides the built-in.
+ */
+#define NEQN_BUILTIN_SLOTS 128 /* a power of two, over twice the built-ins */
+
+static neqn_symbol_t builtin_table[sizeof(builtin_symbols) / sizeof(builtin_symbols[0])];
+static neqn_symbol_t *builtin_index[NEQN_BUILTIN_SLOTS];
+static int builtin_ready = 0;
+
 /**
- * @brief Initialize built-in symbols in context
+ * @brief Fill the shared built-in table on first use
  */
-int neqn_init_builtin_symbols(neqn_context_t *context) {
+static void neqn_builtin_setup(void) {
+    neqn_symbol_t *symbol;
+    unsigned int k;
     int i;
 
-    if (context == NULL) {
-        return NEQN_ERROR_INVALID;
+    if (builtin_ready) {
+        return;
     }
 
     for (i = 0; builtin_symbols[i].name != NULL; i++) {
-        neqn_symbol_t *symbol = static_cast<neqn_symbol_t *>(malloc(sizeof(neqn_symbol_t)));
-        if (symbol == NULL) {
-            return NEQN_ERROR_MEMORY;
-        }
-
-        symbol->name = neqn_strdup(builtin_symbols[i].name);
-        symbol->value = neqn_strdup(builtin_symbols[i].terminal_output);
+        symbol = &builtin_table[i];
+        symbol->name = (char *)builtin_symbols[i].name;
+        symbol->value = (char *)builtin_symbols[i].terminal_output;
         symbol->tree = NULL;
         symbol->line_defined = 0;
         symbol->is_builtin = 1;
 
-        if (symbol->name == NULL || symbol->value == NULL) {
-            free(symbol->name);
-            free(symbol->value);
-            free(symbol);
-            return NEQN_ERROR_MEMORY;
+        k = neqn_hash_string(symbol->name) & (NEQN_BUILTIN_SLOTS - 1);
+        while (builtin_index[k] != NULL) {
+            k = (k + 1) & (NEQN_BUILTIN_SLOTS - 1);
         }
+        builtin_index[k] = symbol;
+    }
 
-        /* Add to hash table */
-        {
-            unsigned int hash = neqn_hash_string(symbol->name);
-            symbol->next = context->symbols[hash];
-            context->symbols[hash] = symbol;
+    builtin_ready = 1;
+}
+
+/**
+ * @brief Find name among the built-ins
+ */
+static neqn_symbol_t *neqn_builtin_find(const char *name) {
+    unsigned int k;
+
+    neqn_builtin_setup();
+    for (k = neqn_hash_string(name) & (NEQN_BUILTIN_SLOTS - 1); builtin_index[k] != NULL;
+         k = (k + 1) & (NEQN_BUILTIN_SLOTS - 1)) {
+        if (strcmp(builtin_index[k]->name, name) == 0) {
+            return builtin_index[k];
         }
     }
 
+    return NULL;
+}
+
+/**
+ * @brief Slot of name in the context table: its symbol or the free slot for it
+ */
+static size_t neqn_symtab_slot(neqn_context_t *context, const char *name) {
+    size_t mask = context->symbol_slots - 1;
+    size_t k;
+
+    for (k = neqn_hash_string(name) & mask; context->symbols[k] != NULL; k = (k + 1) & mask) {
+        if (strcmp(context->symbols[k]->name, name) == 0) {
+            break;
+        }
+    }
+
+    return k;
+}
+
+/**
+ * @brief Make room in the context table for one more symbol
+ */
+static int neqn_symtab_grow(neqn_context_t *context) {
+    neqn_symbol_t **old = context->symbols;
+    size_t nold = context->symbol_slots;
+    size_t i;
+
+    if ((context->symbol_count + 1) * 10 < context->symbol_slots * 7) {
+        return NEQN_SUCCESS;
+    }
+
+    context->symbol_slots = nold ? nold * 2 : NEQN_SYMTAB_MIN;
+    context->symbols = ((neqn_symbol_t **)OSA_CALLOC(context->symbol_slots, sizeof(neqn_symbol_t *)));
+    if (context->symbols == NULL) {
+        context->symbols = old;
+        context->symbol_slots = nold;
+        return NEQN_ERROR_MEMORY;
+    }
+
+    for (i = 0; i < nold; i++) {
+        if (old[i] != NULL) {
+            context->symbols[neqn_symtab_slot(context, old[i]->name)] = old[i];
+        }
+    }
+    OSA_FREE(old);
+
+    return NEQN_SUCCESS;
+}
+
+/**
+ * @brief Initialize built-in symbols in context
+ */
+int neqn_init_builtin_symbols(neqn_context_t *context) {
+    if (context == NULL) {
+        return NEQN_ERROR_INVALID;
+    }
+
+    neqn_builtin_setup();
     return NEQN_SUCCESS;
 }
 
@@ -135,32 +215,28 @@ int neqn_init_builtin_symbols(neqn_context_t *context) {
  * @brief Enhanced symbol lookup with built-in fallback
  */
 neqn_symbol_t *neqn_symbol_lookup_enhanced(neqn_context_t *context, const char *name) {
-    unsigned int hash;
     neqn_symbol_t *symbol;
 
     if (context == NULL || name == NULL) {
         return NULL;
     }
 
-    /* Look up in hash table */
-    hash = neqn_hash_string(name);
-    symbol = context->symbols[hash];
-
-    while (symbol != NULL) {
-        if (strcmp(symbol->name, name) == 0) {
+    /* Symbols defined in the context hide the built-ins */
+    if (context->symbol_count > 0) {
+        symbol = context->symbols[neqn_symtab_slot(context, name)];
+        if (symbol != NULL) {
             return symbol;
         }
-        symbol = symbol->next;
     }
 
-    return NULL;
+    return neqn_builtin_find(name);
 }
 
 /**
  * @brief Print all symbols for debugging
  */
 void neqn_debug_print_symbols(neqn_context_t *context) {
-    int i;
+    size_t i;
     neqn_symbol_t *symbol;
 
     if (context == NULL) {
@@ -169,15 +245,17 @@ void neqn_debug_print_symbols(neqn_context_t *context) {
 
     printf("=== Symbol Table ===\n");
 
-    for (i = 0; i < NEQN_HASH_SIZE; i++) {
+    for (i = 0; i < context->symbol_slots; i++) {
         symbol = context->symbols[i];
-        while (symbol != NULL) {
-            printf("  %s = %s", symbol->name, symbol->value ? symbol->value : "(null)");
-            if (symbol->is_builtin) {
-                printf(" [built-in]");
-            }
-            printf("\n");
-            symbol = symbol->next;
+        if (symbol != NULL) {
+            printf("  %s = %s\n", symbol->name, symbol->value ? symbol->value : "(null)");
+        }
+    }
+
+    for (i = 0; builtin_symbols[i].name != NULL; i++) {
+        if (neqn_symbol_lookup_enhanced(context, builtin_symbols[i].name)->is_builtin) {
+            printf("  %s = %s [built-in]\n", builtin_symbols[i].name,
+                   builtin_symbols[i].terminal_output);
         }
     }
 
@@ -192,7 +270,6 @@ int neqn_symbol_define_enhanced(neqn_context_t *context,
                                 const char *value) {
     neqn_symbol_t *existing;
     neqn_symbol_t *symbol;
-    unsigned int hash;
 
     if (context == NULL || name == NULL) {
         return NEQN_ERROR_INVALID;
@@ -202,18 +279,23 @@ int neqn_symbol_define_enhanced(neqn_context_t *context,
     existing = neqn_symbol_lookup_enhanced(context, name);
     if (existing != NULL) {
         if (existing->is_builtin) {
+            /* The shared built-in stays; this context gets its own */
             neqn_warning(context, "Redefining built-in symbol '%s'", name);
+        } else {
+            /* Update existing symbol */
+            OSA_FREE(existing->value);
+            existing->value = value ? neqn_strdup(value) : NULL;
+            existing->line_defined = context->line_number;
+            return NEQN_SUCCESS;
         }
+    }
 
-        /* Update existing symbol */
-        free(existing->value);
-        existing->value = value ? neqn_strdup(value) : NULL;
-        existing->line_defined = context->line_number;
-        return NEQN_SUCCESS;
+    if (neqn_symtab_grow(context) != NEQN_SUCCESS) {
+        return NEQN_ERROR_MEMORY;
     }
 
     /* Create new symbol */
-    symbol = static_cast<neqn_symbol_t *>(malloc(sizeof(neqn_symbol_t)));
+    symbol = static_cast<neqn_symbol_t *>(OSA_MALLOC(sizeof(neqn_symbol_t)));
     if (symbol == NULL) {
         return NEQN_ERROR_MEMORY;
     }
@@ -225,16 +307,15 @@ int neqn_symbol_define_enhanced(neqn_context_t *context,
     symbol->is_builtin = 0;
 
     if (symbol->name == NULL || (value != NULL && symbol->value == NULL)) {
-        free(symbol->name);
-        free(symbol->value);
-        free(symbol);
+        OSA_FREE(symbol->name);
+        OSA_FREE(symbol->value);
+        OSA_FREE(symbol);
         return NEQN_ERROR_MEMORY;
     }
 
     /* Add to hash table */
-    hash = neqn_hash_string(name);
-    symbol->next = context->symbols[hash];
-    context->symbols[hash] = symbol;
+    context->symbols[neqn_symtab_slot(context, name)] = symbol;
+    context->symbol_count++;
 
     return NEQN_SUCCESS;
 }
@@ -257,7 +338,7 @@ neqn_node_t *neqn_superscript(neqn_node_t *base, neqn_node_t *exponent) {
 
     /* Calculate length needed */
     len = strlen(base->content) + strlen(exponent->content) + 4; /* "^{}" */
-    formatted = ((char*)malloc(len));
+    formatted = ((char*)OSA_MALLOC(len));
     if (formatted == NULL) {
         return NULL;
     }
@@ -266,7 +347,7 @@ neqn_node_t *neqn_superscript(neqn_node_t *base, neqn_node_t *exponent) {
     sprintf(formatted, "%s^{%s}", base->content, exponent->content);
 
     result = neqn_node_create(NEQN_NODE_SUPER, formatted);
-    free(formatted);
+    OSA_FREE(formatted);
 
     if (result != NULL) {
         result->left = base;
@@ -290,7 +371,7 @@ neqn_node_t *neqn_subscript(neqn_node_t *base, neqn_node_t *subscript) {
 
     /* Calculate length needed */
     len = strlen(base->content) + strlen(subscript->content) + 4; /* "_{}" */
-    formatted = ((char*)malloc(len));
+    formatted = ((char*)OSA_MALLOC(len));
     if (formatted == NULL) {
         return NULL;
     }
@@ -299,7 +380,7 @@ neqn_node_t *neqn_subscript(neqn_node_t *base, neqn_node_t *subscript) {
     sprintf(formatted, "%s_{%s}", base->content, subscript->content);
 
     result = neqn_node_create(NEQN_NODE_SUB, formatted);
-    free(formatted);
+    OSA_FREE(formatted);
 
     if (result != NULL) {
         result->left = base;
@@ -323,7 +404,7 @@ neqn_node_t *neqn_fraction(neqn_node_t *numerator, neqn_node_t *denominator) {
 
     /* Calculate length needed */
     len = strlen(numerator->content) + strlen(denominator->content) + 8; /* "() / ()" */
-    formatted = ((char*)malloc(len));
+    formatted = ((char*)OSA_MALLOC(len));
     if (formatted == NULL) {
         return NULL;
     }
@@ -332,7 +413,7 @@ neqn_node_t *neqn_fraction(neqn_node_t *numerator, neqn_node_t *denominator) {
     sprintf(formatted, "(%s) / (%s)", numerator->content, denominator->content);
 
     result = neqn_node_create(NEQN_NODE_FRACTION, formatted);
-    free(formatted);
+    OSA_FREE(formatted);
 
     if (result != NULL) {
         result->left = numerator;
@@ -356,7 +437,7 @@ neqn_node_t *neqn_sqrt(neqn_node_t *expression) {
 
     /* Calculate length needed */
     len = strlen(expression->content) + 10; /* "sqrt{}" */
-    formatted = ((char*)malloc(len));
+    formatted = ((char*)OSA_MALLOC(len));
     if (formatted == NULL) {
         return NULL;
     }
@@ -365,7 +446,7 @@ neqn_node_t *neqn_sqrt(neqn_node_t *expression) {
     sprintf(formatted, "√(%s)", expression->content);
 
     result = neqn_node_create(NEQN_NODE_SQRT, formatted);
-    free(formatted);
+    OSA_FREE(formatted);
 
     if (result != NULL) {
         result->left = expression;
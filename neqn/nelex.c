@@ -1,17 +1,25 @@
 /* C17 - no scaffold needed */
 #include "ne.h"
 #include "y.tab.c" // This is unusual, including a .c file.
+#define OSA_TAG "neqn"
+#include "os/os_acct.h" // OSA_CALLOC, OSA_FREE, OSA_READ
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h> // POSIX header
 #include <fcntl.h>  // POSIX header
 #include <stdint.h>  // For uintptr_t
+#include <sys/mman.h> // mmap() of a define library
+#include <sys/stat.h> // its size
 
 void error(int level, const char *fmt, ...);
 
 #define getc ngetc
 #define FATAL 1
 #define SSIZE 256
+#define KWSIZE 128 /* keyword hash slots, a power of two */
+#define DEFMIN 64 /* initial define table size, a power of two */
+#define IBSIZE 65536 /* input block size */
+#define LIBMAGIC "neqnlib1" /* first bytes of a define library */
 
 /* Forward declarations */
 typedef struct {
@@ -25,17 +33,43 @@ typedef struct {
 } lookup_tab;
 
 typedef struct {
-    char *nptr;
-    char *sptr;
+    char *nptr; /* interned name, NULL for an unused slot */
+    char *sptr; /* what the name expands to */
 } deftab_t;
 
+/* The head of a define library, then ndef entries, then the strings */
+typedef struct {
+    char magic[8]; /* LIBMAGIC */
+    int defsize, ndef; /* of the table it was written from */
+    int gsize, gfont;
+    int lefteq, righteq;
+    unsigned long sum; /* defsum */
+} deflib_t;
+
+/* A define in a library: its slot, and where its name and body are */
+typedef struct {
+    unsigned slot;
+    unsigned long name, body; /* offsets in the file */
+} defent_t;
+
 /* Function prototypes */
 int ngetc(void);
+void passthru(void);
 int yylex(void);
 void getstr(char *s, int c);
 int lookup(char *str, lookup_tab tbl[]);
+static lookup_tab *kwfind(const char *s);
+static deftab_t *deffind(const char *s);
+static deftab_t *defput(const char *s);
 void define(int type);
 void delim(void);
+const char *eqsrc(int inl, size_t *n);
+int eqpast(const char *p);
+void eqskip(const char *p);
+void eqlimit(const char *p);
+unsigned long eqdefs(void);
+void eqlibload(const char *file);
+int eqlibsave(const char *file);
 void globsize(void);
 void globfont(void);
 char *cstr(char *s, int quote);
@@ -57,8 +91,10 @@ static int svargc;
 static char **svargv;
 static int fin;
 static char lefteq, righteq;
-static lookup_tab deftab[100];
-static int ptr = 0;
+static deftab_t *deftab; /* open-addressed by name */
+static int defsize; /* slots in deftab */
+static int ndef; /* names defined */
+static unsigned long defsum = 2166136261u; /* digest of defines and delims so far */
 static int eqnreg;
 static int dbg = 0;
 static char *swt[10];
@@ -67,9 +103,186 @@ static int peek = -1;
 static int speek[10];
 static char token[256];
 static int sp = 0;
+static char ibuf[IBSIZE]; /* input block, read from fin */
+static char *ibp = ibuf, *ibe = ibuf;
+
+/*
+ * The keywords.  kwinit() puts each in the slot kwhash() gives it;
+ * the hash was chosen so that no two share a slot, so a token is a
+ * keyword only if it equals the one name in its slot.  Adding a
+ * keyword means choosing new multipliers that keep the slots apart.
+ */
+static lookup_tab keywords[] = {
+    {"sqrt", SQRT},
+    {"dyad", DYAD},
+    {"union", UNION},
+    {"bar", BAR},
+    {"under", UNDER},
+    {"down", DOWN},
+    {"above", ABOVE},
+    {"up", UP},
+    {"tdefine", TDEFINE},
+    {"lcol", LCOL},
+    {"integral", INT},
+    {"bold", BOLD},
+    {"left", LEFT},
+    {"matrix", MATRIX},
+    {"back", BACK},
+    {"inter", INTER},
+    {"delim", DELIM},
+    {"col", COL},
+    {"hat", HAT},
+    {"over", OVER},
+    {"lpile", LPILE},
+    {".EN", 0},
+    {"gsize", GSIZE},
+    {"fwd", FWD},
+    {".gsize", GSIZE},
+    {"rcol", RCOL},
+    {"italic", ITALIC},
+    {"sub", SUB},
+    {"tilde", TILDE},
+    {"mark", MARK},
+    {"gfont", GFONT},
+    {"define", DEFINE},
+    {"fat", FAT},
+    {"sum", SUM},
+    {"sup", SUP},
+    {"ccol", CCOL},
+    {"prod", PROD},
+    {"pile", PILE},
+    {"dotdot", DOTDOT},
+    {"vec", VEC},
+    {"to", TO},
+    {"rpile", RPILE},
+    {"int", INT},
+    {"ndefine", DEFINE},
+    {"lineup", LINEUP},
+    {"dot", DOT},
+    {"roman", ROMAN},
+    {"from", FROM},
+    {"size", SIZE},
+    {"right", RIGHT},
+    {"font", FONT},
+    {"cpile", CPILE},
+    {NULL, 0}};
+
+static lookup_tab *keytab[KWSIZE]; /* keywords by kwhash() */
+static int kwready; /* keytab[] is filled */
+
+static unsigned kwhash(const char *s, size_t n) {
+    return ((unsigned)(n * 38 + (unsigned char)s[0] * 50 +
+                       (unsigned char)s[n - 1]) & (KWSIZE - 1));
+}
 
-static lookup_tab keytab[] = {
-    {"", 0}};
+/* Put the keywords in their slots */
+static void kwinit(void) {
+    lookup_tab *k;
+    unsigned h;
+
+    for (k = keywords; k->name != NULL; k++) {
+        h = kwhash(k->name, strlen(k->name));
+        if (keytab[h] != NULL)
+            error(FATAL, "keywords %s and %s share a slot", keytab[h]->name, k->name);
+        keytab[h] = k;
+    }
+    kwready = 1;
+}
+
+/* The keyword s is, or NULL */
+static lookup_tab *kwfind(const char *s) {
+    lookup_tab *k;
+    size_t n;
+
+    if (!kwready)
+        kwinit();
+    if ((n = strlen(s)) == 0)
+        return NULL;
+    k = keytab[kwhash(s, n)];
+    if (k == NULL || strcmp(k->name, s) != 0)
+        return NULL;
+    return k;
+}
+
+/*
+ * User defines live in an open-addressed table of interned names,
+ * probed linearly and doubled at 70% load.  Names are never removed,
+ * so a redefinition only replaces the body.
+ */
+static unsigned defhash(const char *s) {
+    unsigned h = 2166136261u;
+
+    while (*s)
+        h = (h ^ (unsigned char)*s++) * 16777619u;
+    return h;
+}
+
+/* Fold s and its NUL into the digest of everything defined so far */
+static void defmix(const char *s) {
+    do
+        defsum = (defsum ^ (unsigned char)*s) * 1099511628211ul;
+    while (*s++);
+}
+
+/* The definition of s, or NULL */
+static deftab_t *deffind(const char *s) {
+    unsigned k;
+
+    if (ndef == 0)
+        return NULL;
+    for (k = defhash(s) & (defsize - 1); deftab[k].nptr != NULL; k = (k + 1) & (defsize - 1))
+        if (strcmp(deftab[k].nptr, s) == 0)
+            return &deftab[k];
+    return NULL;
+}
+
+/* The slot of s, entering the name if it is new */
+static deftab_t *defput(const char *s) {
+    deftab_t *d, *o;
+    unsigned k;
+    int j, n;
+
+    if ((d = deffind(s)) != NULL)
+        return d;
+    if ((ndef + 1) * 10 >= defsize * 7) {
+        o = deftab;
+        n = defsize;
+        defsize = n ? 2 * n : DEFMIN;
+        if ((deftab = (deftab_t *)OSA_CALLOC(defsize, sizeof(*deftab))) == NULL)
+            error(FATAL, "no space for definition %.20s", s);
+        for (j = 0; j < n; j++)
+            if (o[j].nptr != NULL) {
+                for (k = defhash(o[j].nptr) & (defsize - 1); deftab[k].nptr != NULL;
+                     k = (k + 1) & (defsize - 1))
+                    ;
+                deftab[k] = o[j];
+            }
+        OSA_FREE(o);
+    }
+    for (k = defhash(s) & (defsize - 1); deftab[k].nptr != NULL; k = (k + 1) & (defsize - 1))
+        ;
+    d = &deftab[k];
+    d->nptr = strcpy(alloc((int)strlen(s) + 1), s);
+    ndef++;
+    return d;
+}
+
+/*
+ * Move what is left of the input block to its start and read more
+ * after it; 0 at end of file or if the block is full.
+ */
+static int ifill(void) {
+    size_t n = ibe - ibp;
+    ssize_t r;
+
+    memmove(ibuf, ibp, n);
+    ibp = ibuf;
+    ibe = ibuf + n;
+    if (n == IBSIZE || (r = OSA_READ(fin, ibe, IBSIZE - n)) <= 0)
+        return 0;
+    ibe += r;
+    return 1;
+}
 
 /*
  * Read next character, handling includes.
@@ -84,7 +297,12 @@ int ngetc(void) {
             peek = speek[sw--];
             return ' ';
         }
-        lastchar = (peek < 0) ? getchar() : peek;
+        if (peek >= 0)
+            lastchar = peek;
+        else if (ibp < ibe || ifill())
+            lastchar = (unsigned char)*ibp++;
+        else
+            lastchar = '\0';
         if (lastchar == '\n')
             linect++;
         peek = -1;
@@ -94,13 +312,255 @@ int ngetc(void) {
             peek = '\0';
             return '\0';
         }
+        close(fin);
+        if ((fin = open(svargv[ifile], O_RDONLY)) < 0)
+            error(FATAL, "can't open file %s", svargv[ifile]);
+    }
+}
+
+/*
+ * Copy plain lines straight from the input block to the output.
+ *
+ * Called at the start of a line.  Lines that neither begin with .EQ
+ * nor hold the inline delimiter (or a NUL, which ends the file) are
+ * found with memchr() and written as they stand, without a call to
+ * ngetc() per byte.  Stops before the first line that needs looking
+ * at, or one longer than the block, and leaves it to ne_getline().
+ */
+void passthru(void) {
+    char *p, *nl;
+    size_t n;
+
+    if (sw >= 0 || peek >= 0)
+        return;
+    for (;;) {
+        for (p = ibp; (nl = (char *)memchr(p, '\n', ibe - p)) != NULL; p = nl + 1) {
+            n = nl - p;
+            if ((n >= 3 && p[0] == '.' && p[1] == 'E' && p[2] == 'Q') ||
+                memchr(p, '\0', n) != NULL ||
+                (lefteq != '\0' && memchr(p, lefteq, n) != NULL))
+                break;
+            linect++;
+        }
+        if (p > ibp) {
+            fwrite(ibp, 1, p - ibp, stdout);
+            ibp = p;
+        }
+        if (nl != NULL || !ifill())
+            return;
+    }
+}
+
+/*
+ * Find the source of the equation about to be parsed in the input
+ * block: up to and including the closing delimiter of an inline one
+ * (inl), or the .EN line of a display and the blank or newline after
+ * it.  NULL if it is not all there, or if the parser might stop
+ * anywhere else: pending characters or definitions, a NUL, a
+ * delimiter inside a display, or ".EN" not at the start of a line.
+ * The text stays valid until the next read.
+ */
+const char *eqsrc(int inl, size_t *n) {
+    char *p, *e;
+
+    if (sw >= 0 || peek >= 0)
+        return NULL;
+    for (;;) {
+        e = NULL;
+        if (inl) {
+            if (righteq != '\0' && (p = (char *)memchr(ibp, righteq, ibe - ibp)) != NULL)
+                e = p + 1;
+        } else {
+            for (p = ibp; (p = (char *)memchr(p, '.', ibe - p)) != NULL && ibe - p >= 4; p++)
+                if (p[1] == 'E' && p[2] == 'N')
+                    break;
+            if (p != NULL && ibe - p >= 4) {
+                if ((p > ibp && p[-1] != '\n') || (p[3] != '\n' && p[3] != ' '))
+                    return NULL;
+                if (righteq != '\0' && memchr(ibp, righteq, p - ibp) != NULL)
+                    return NULL;
+                e = p + 4;
+            }
+        }
+        if (e != NULL) {
+            if (memchr(ibp, '\0', e - ibp) != NULL)
+                return NULL;
+            *n = e - ibp;
+            return ibp;
+        }
+        if (ibe - ibp == IBSIZE || !ifill())
+            return NULL;
     }
 }
 
+/* Has the parser read exactly up to p, with nothing pending? */
+int eqpast(const char *p) {
+    return sw < 0 && peek < 0 && ibp == p;
+}
+
+/* Go on reading at p, as if the parser had read up to there */
+void eqskip(const char *p) {
+    char *q;
+
+    for (q = ibp; (q = (char *)memchr(q, '\n', p - q)) != NULL; q++)
+        linect++;
+    lastchar = (unsigned char)p[-1];
+    ibp = (char *)p;
+}
+
+/*
+ * Treat p as the end of all input: nothing more is read from the file,
+ * so a process that shares the file offset leaves it where it was.
+ */
+void eqlimit(const char *p) {
+    ibe = (char *)p;
+    fin = -1;
+    svargc = ifile;
+}
+
+/* A digest of the defines and delimiters in effect */
+unsigned long eqdefs(void) {
+    return defsum ^ ((unsigned long)(unsigned char)lefteq << 8 | (unsigned char)righteq);
+}
+
+/*
+ * A define library is the define table and the delim, gsize and gfont
+ * in effect when a run with -M ended, written for -L (or $NEQNLIB) to
+ * load at the start of the next, so that a preamble of defines is read
+ * and tokenized once rather than by every run.  The entries give the
+ * slot each name had, so loading into an empty table places them
+ * without hashing or comparing a name, and the names and bodies are
+ * used where they lie in the file, mapped read-only: every neqn of a
+ * pipeline loading the same library shares its pages.  defsum comes
+ * with them, so the keys of -C are those the defines themselves gave.
+ * A library loaded over defines already made is entered name by name.
+ */
+void eqlibload(const char *file) {
+    const deflib_t *h;
+    const defent_t *e;
+    deftab_t *t;
+    struct stat st;
+    char *m;
+    unsigned long n, at;
+    int fd, k;
+
+    if ((fd = open(file, O_RDONLY)) < 0)
+        error(FATAL, "can't open define library %s", file);
+    if (fstat(fd, &st) < 0 || (n = (unsigned long)st.st_size) < sizeof(*h) ||
+        (m = (char *)mmap(NULL, n, PROT_READ, MAP_PRIVATE, fd, 0)) == MAP_FAILED)
+        error(FATAL, "bad define library %s", file);
+    close(fd);
+    h = (const deflib_t *)m;
+    e = (const defent_t *)(h + 1);
+    at = sizeof(*h) + (unsigned long)h->ndef * sizeof(*e);
+    t = NULL;
+    if (memcmp(h->magic, LIBMAGIC, sizeof(h->magic)) != 0 || h->ndef < 0 ||
+        (h->ndef > 0 && (h->defsize < DEFMIN || (h->defsize & (h->defsize - 1)) != 0 ||
+                         h->ndef * 10L >= h->defsize * 7L)) ||
+        at > n || m[n - 1] != '\0')
+        goto bad;
+    for (k = 0; k < h->ndef; k++)
+        if (e[k].slot >= (unsigned)h->defsize || e[k].name < at || e[k].name >= n ||
+            e[k].body < at || e[k].body >= n)
+            goto bad;
+    if (ndef == 0) {
+        if (h->ndef > 0) {
+            if ((t = (deftab_t *)OSA_CALLOC(h->defsize, sizeof(*t))) == NULL)
+                error(FATAL, "no space for define library %s", file);
+            for (k = 0; k < h->ndef; k++) {
+                if (t[e[k].slot].nptr != NULL)
+                    goto bad;
+                t[e[k].slot].nptr = m + e[k].name;
+                t[e[k].slot].sptr = m + e[k].body;
+            }
+            OSA_FREE(deftab);
+            deftab = t;
+            defsize = h->defsize;
+            ndef = h->ndef;
+        }
+        defsum = h->sum;
+    } else {
+        for (k = 0; k < h->ndef; k++) {
+            defput(m + e[k].name)->sptr = m + e[k].body;
+            defmix(m + e[k].name);
+            defmix(m + e[k].body);
+        }
+        defmix("delim");
+    }
+    gsize = h->gsize;
+    gfont = h->gfont;
+    lefteq = (char)h->lefteq;
+    righteq = (char)h->righteq;
+    return;
+bad:
+    OSA_FREE(t);
+    error(FATAL, "bad define library %s", file);
+}
+
+/*
+ * Write the defines and the delim, gsize and gfont in effect to the
+ * library file, under a temporary name renamed into place, so that a
+ * run that has it mapped never sees it change.  0 if it could not.
+ */
+int eqlibsave(const char *file) {
+    deflib_t h;
+    defent_t e;
+    FILE *f;
+    char tmp[1024];
+    unsigned long at;
+    int fd, k, ok;
+
+    if (snprintf(tmp, sizeof(tmp), "%s.XXXXXX", file) >= (int)sizeof(tmp) ||
+        (fd = mkstemp(tmp)) < 0)
+        return 0;
+    if ((f = fdopen(fd, "wb")) == NULL) {
+        close(fd);
+        unlink(tmp);
+        return 0;
+    }
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, LIBMAGIC, sizeof(h.magic));
+    h.defsize = defsize;
+    for (k = 0; k < defsize; k++)
+        if (deftab[k].nptr != NULL && deftab[k].sptr != NULL)
+            h.ndef++;
+    h.gsize = gsize;
+    h.gfont = gfont;
+    h.lefteq = (unsigned char)lefteq;
+    h.righteq = (unsigned char)righteq;
+    h.sum = defsum;
+    fwrite(&h, sizeof(h), 1, f);
+    at = sizeof(h) + (unsigned long)h.ndef * sizeof(e);
+    memset(&e, 0, sizeof(e));
+    for (k = 0; k < defsize; k++)
+        if (deftab[k].nptr != NULL && deftab[k].sptr != NULL) {
+            e.slot = (unsigned)k;
+            e.name = at;
+            at += strlen(deftab[k].nptr) + 1;
+            e.body = at;
+            at += strlen(deftab[k].sptr) + 1;
+            fwrite(&e, sizeof(e), 1, f);
+        }
+    for (k = 0; k < defsize; k++)
+        if (deftab[k].nptr != NULL && deftab[k].sptr != NULL) {
+            fwrite(deftab[k].nptr, 1, strlen(deftab[k].nptr) + 1, f);
+            fwrite(deftab[k].sptr, 1, strlen(deftab[k].sptr) + 1, f);
+        }
+    fputc('\0', f); /* so a library of no defines ends in a NUL too */
+    ok = !ferror(f);
+    if (fclose(f) != 0 || !ok || rename(tmp, file) < 0) {
+        unlink(tmp);
+        return 0;
+    }
+    return 1;
+}
+
 /*
  * Lexical analyzer for neqn.
  */
 int yylex(void) {
+    lookup_tab *k;
+    deftab_t *d;
     int c, type;
 
 beg:
@@ -132,31 +592,31 @@ beg:
         return '\0';
 
     getstr(token, c);
-    if ((type = lookup(token, deftab)) >= 0) {
+    if ((d = deffind(token)) != NULL) {
         if (sw >= 9)
             error(FATAL, "definitions nested > 9", sw);
-        swt[++sw] = deftab[type].name;
+        swt[++sw] = d->sptr;
         speek[sw] = peek;
         peek = -1;
         goto beg;
     }
-    type = lookup(token, keytab);
-    if (type < 0)
+    if ((k = kwfind(token)) == NULL)
         return CONTIG;
-    if (keytab[type].keyval == DEFINE || keytab[type].keyval == TDEFINE) {
-        define(keytab[type].keyval);
+    type = k->keyval;
+    if (type == DEFINE || type == TDEFINE) {
+        define(type);
         goto beg;
-    } else if (keytab[type].keyval == DELIM) {
+    } else if (type == DELIM) {
         delim();
         goto beg;
-    } else if (keytab[type].keyval == GSIZE) {
+    } else if (type == GSIZE) {
         globsize();
         goto beg;
-    } else if (keytab[type].keyval == GFONT) {
+    } else if (type == GFONT) {
         globfont();
         goto beg;
     }
-    return keytab[type].keyval;
+    return type;
 }
 
 /*
@@ -215,31 +675,24 @@ char *cstr(char *s, int quote) {
  * Process a define statement.
  */
 void define(int type) {
-    int i, c;
+    deftab_t *d = NULL;
+    int c;
     while ((c = getc()) == ' ' || c == '\n')
         ;
     getstr(token, c);
     if (type == DEFINE) {
-        if ((i = lookup(token, deftab)) >= 0) {
-            yyval = i;
-        } else {
-            yyval = ptr++;
-            for (i = 0; token[i] != '\0'; i++)
-                ;
-            deftab[yyval].name = alloc(i + 1);
-            for (i = 0; (deftab[yyval].name[i] = token[i]); i++)
-                ;
-        }
+        d = defput(token);
         if (dbg)
-            printf(".\tdefine %s\n", deftab[yyval].name);
+            printf(".\tdefine %s\n", d->nptr);
     }
     cstr(token, 1);
     if (type != DEFINE)
         return;
-    for (i = 0; token[i] != '\0'; i++)
-        ;
+    d->sptr = strcpy(alloc((int)strlen(token) + 1), token);
+    defmix(d->nptr);
+    defmix(d->sptr);
     if (dbg)
-        printf(".\tname %s defined as %s\n", deftab[yyval].name, token);
+        printf(".\tname %s defined as %s\n", d->nptr, token);
 }
 
 /*
@@ -253,6 +706,7 @@ void delim(void) {
     righteq = getc();
     if (lefteq == 'o' && righteq == 'f')
         lefteq = righteq = '\0';
+    defmix("delim");
 }
 
 /*
@@ -39,6 +39,8 @@
  * PROJECT INCLUDES - Local Header Files
  * ================================================================ */
 #include "ne.h" /* Main neqn header with type definitions */
+#define OSA_TAG "neqn"
+#include "os/os_acct.h" /* OSA_MALLOC, OSA_FREE */
 
 /* ================================================================
  * PROGRAM CONSTANTS AND CONFIGURATION
@@ -198,7 +200,7 @@ int main(int argc, char *argv[]) {
     /* Extract input files from command line arguments */
     if (file_count > 0) {
         int i;
-        input_files = static_cast<char **>(malloc(file_count * sizeof(char *)));
+        input_files = static_cast<char **>(OSA_MALLOC(file_count * sizeof(char *)));
         if (input_files == NULL) {
             fprintf(stderr, "%s: Memory allocation failed\n", program_name);
             cleanup_and_exit(NEQN_EXIT_FAILURE);
@@ -218,7 +220,7 @@ int main(int argc, char *argv[]) {
 
     /* Clean up and exit */
     if (input_files != NULL) {
-        free(input_files);
+        OSA_FREE(input_files);
     }
 
     cleanup_and_exit(result);
@@ -423,7 +425,7 @@ static int process_single_file(const char *filename) {
 
     /* Clean up */
     if (line_buffer != NULL) {
-        free(line_buffer);
+        OSA_FREE(line_buffer);
     }
 
     /* Report statistics if in verbose mode */
@@ -443,6 +445,9 @@ static int process_single_file(const char *filename) {
             fprintf(stderr, "%s: %d warnings issued\n",
                     program_name, neqn_current_context->warning_count);
         }
+
+        fprintf(stderr, "%s: %lu bytes peak equation memory\n",
+                program_name, (unsigned long)neqn_current_context->arena.peak);
     }
 
     /* Unregister processing instance */
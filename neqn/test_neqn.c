@@ -176,6 +176,113 @@ static void test_basic_processing(void) {
     TEST_PASS();
 }
 
+static void test_arena(void) {
+    neqn_context_t *context;
+    size_t peak;
+    char *p;
+
+    TEST_START();
+
+    context = neqn_context_create();
+    TEST_ASSERT(context != NULL);
+
+    /* A processed line leaves nothing allocated, but the peak is kept */
+    TEST_ASSERT(neqn_process_line(context, "a sup 2 + b sub i") == NEQN_SUCCESS);
+    TEST_ASSERT(context->arena.used == 0);
+    peak = context->arena.peak;
+    TEST_ASSERT(peak > 0);
+    TEST_ASSERT(neqn_process_line(context, "x") == NEQN_SUCCESS);
+    TEST_ASSERT(context->arena.peak == peak);
+
+    /* Allocations larger than a block still succeed */
+    p = (char *)neqn_arena_alloc(&context->arena, 3 * NEQN_ARENA_BLOCK);
+    TEST_ASSERT(p != NULL);
+    memset(p, 0, 3 * NEQN_ARENA_BLOCK);
+    neqn_arena_reset(&context->arena);
+    TEST_ASSERT(context->arena.used == 0);
+
+    neqn_context_destroy(context);
+
+    TEST_PASS();
+}
+
+static void test_symbols(void) {
+    neqn_context_t *a, *b;
+    neqn_symbol_t *symbol;
+    char name[16];
+    int i;
+
+    TEST_START();
+
+    a = neqn_context_create();
+    b = neqn_context_create();
+    TEST_ASSERT(a != NULL && b != NULL);
+    TEST_ASSERT(neqn_init_builtin_symbols(a) == NEQN_SUCCESS);
+
+    /* Built-ins are there in every context without being loaded */
+    symbol = neqn_symbol_lookup_enhanced(b, "alpha");
+    TEST_ASSERT(symbol != NULL && symbol->is_builtin);
+
+    /* Far more definitions than the initial table holds */
+    for (i = 0; i < 1000; i++) {
+        sprintf(name, "d%d", i);
+        TEST_ASSERT(neqn_symbol_define_enhanced(a, name, name) == NEQN_SUCCESS);
+    }
+    for (i = 0; i < 1000; i++) {
+        sprintf(name, "d%d", i);
+        symbol = neqn_symbol_lookup_enhanced(a, name);
+        TEST_ASSERT(symbol != NULL && strcmp(symbol->value, name) == 0);
+    }
+    TEST_ASSERT(neqn_symbol_lookup_enhanced(b, "d1") == NULL);
+
+    /* Redefining a built-in hides it in that context only */
+    TEST_ASSERT(neqn_symbol_define_enhanced(a, "pi", "PI") == NEQN_SUCCESS);
+    TEST_ASSERT(strcmp(neqn_symbol_lookup_enhanced(a, "pi")->value, "PI") == 0);
+    TEST_ASSERT(neqn_symbol_lookup_enhanced(b, "pi")->is_builtin);
+
+    neqn_context_destroy(a);
+    neqn_context_destroy(b);
+
+    TEST_PASS();
+}
+
+static void test_memory_output(void) {
+    neqn_context_t *a, *b;
+    const char *out;
+    size_t length;
+    int i;
+
+    TEST_START();
+
+    a = neqn_context_create();
+    b = neqn_context_create();
+    TEST_ASSERT(a != NULL && b != NULL);
+    TEST_ASSERT(neqn_context_set_output_buffer(a) == NEQN_SUCCESS);
+    TEST_ASSERT(neqn_context_set_output_buffer(b) == NEQN_SUCCESS);
+
+    /* A block goes line by line into the buffer of its own context */
+    TEST_ASSERT(neqn_process_block(a, "x + y\nz\n", 8) == NEQN_SUCCESS);
+    TEST_ASSERT(neqn_process_block(b, "w", 1) == NEQN_SUCCESS);
+    out = neqn_context_output(a, &length);
+    TEST_ASSERT(length == strlen(out) && strcmp(out, "x + y\nz\n") == 0);
+    TEST_ASSERT(a->line_number == 2);
+    TEST_ASSERT(strcmp(neqn_context_output(b, NULL), "w\n") == 0);
+
+    /* Output well past the first allocation */
+    neqn_context_clear_output(a);
+    TEST_ASSERT(neqn_context_output(a, &length)[0] == '\0' && length == 0);
+    for (i = 0; i < 1000; i++) {
+        TEST_ASSERT(neqn_process_line(a, "alpha") == NEQN_SUCCESS);
+    }
+    neqn_context_output(a, &length);
+    TEST_ASSERT(length == 6000);
+
+    neqn_context_destroy(a);
+    neqn_context_destroy(b);
+
+    TEST_PASS();
+}
+
 /* Main test runner */
 int main(void) {
     printf("Starting neqn test suite...\n\n");
@@ -195,6 +302,9 @@ int main(void) {
     test_utility_functions();
     test_error_handling();
     test_basic_processing();
+    test_arena();
+    test_symbols();
+    test_memory_output();
 
     /* Print results */
     printf("\nTest Results:\n");
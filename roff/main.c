@@ -7,12 +7,29 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include "core/memrep.h"
+#include "os/os_acct.h"
 
 /* ROFF function declarations */
 extern void init_globals(void);
 extern int process_roff(int argc, char **argv);
+extern int roff_memrep(otroff_memrep_t *m);
 
 int main(int argc, char **argv) {
+    otroff_memrep_t m;
+    int i, memon = 0, staton = 0;
+
+    /* -M: memory report at exit; -S: allocation and I/O (OSACCT builds) */
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-M") == 0) {
+            memon = 1;
+        } else if (strcmp(argv[i], "-S") == 0) {
+            staton = 1;
+        }
+    }
+
     /* Initialize ROFF global variables */
     init_globals();
 
@@ -25,9 +42,16 @@ int main(int argc, char **argv) {
         /* Would call ROFF processing here */
         fprintf(stderr, "Processing files...\n");
     } else {
-        fprintf(stderr, "Usage: %s [input_files...]\n", argv[0]);
+        fprintf(stderr, "Usage: %s [-M] [-S] [input_files...]\n", argv[0]);
         return 1;
     }
 
+    if (memon) {
+        roff_memrep(&m);
+        otroff_memrep_print(&m, stderr);
+    }
+    if (staton) {
+        osa_report(stderr);
+    }
     return 0;
 }
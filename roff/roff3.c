@@ -70,6 +70,9 @@
 
 /* Local headers */
 #include "roff_c.h" /* ROFF system definitions and globals (now with new namespace) */
+#include "core/blkstore.h" /* in-core buffer text store */
+#define OSA_TAG "roff"
+#include "os/os_acct.h" /* OSA_READ */
 
 
 // Using directive for convenience within this file
@@ -92,10 +95,6 @@
 // These are now declared in roff.hpp within the roff namespace
 // and made available via "using namespace roff;"
 
-/* Local static variables for file operations */
-static char char_buf; /* Character buffer for single-char file I/O */
-static int offb; /* Offset buffer for file positioning */
-
 /* Function prototypes for external functions */
 // These are now declared in roff.hpp within the roff namespace
 // and made available via "using namespace roff;"
@@ -229,8 +228,8 @@ void skipcont(void) {
  * 6. Apply all margins and spacing requirements
  * 7. Output line numbers if numbering is enabled
  * 8. Apply justification and indentation
- * 9. Output the formatted line character by character
- * 10. Handle spaces with fill processing for justification
+ * 9. Output the formatted line through putline()
+ * 10. Pad the interword gaps putline() was given for justification
  * 11. Reset line state for next line accumulation
  *
  * Page Layout Handling:
@@ -245,7 +244,7 @@ void skipcont(void) {
  * - Outputs line numbers with proper formatting
  * - Outputs temporary indent (un) for paragraph formatting
  * - Applies justification spacing through jfo()
- * - Processes each character with fill() for spacing
+ * - Pads the gaps movword() recorded in one pass (putline())
  *
  * State Management:
  * - Resets word count (nwd) and character count (ne)
@@ -254,8 +253,6 @@ void skipcont(void) {
  */
 void rbreak(void) {
     int spacing_count;
-    char *line_ptr;
-    int line_char;
 
     /* Check if there's anything to output - exit early if empty line */
     if (nc <= 0) {
@@ -333,24 +330,8 @@ void rbreak(void) {
     /* Apply justification spacing */
     jfo();
 
-    /* Output the line character by character with special space handling */
-    line_ptr = line;
-    while (nc > 0) {
-        line_char = ((unsigned char)*line_ptr++);
-
-        if (line_char == ' ') {
-            /* Handle space with fill processing for justification */
-            fill();
-            /* Check if nc became zero during fill processing */
-            if (nc == 0) {
-                break;
-            }
-        } else {
-            /* Output regular character */
-            putchar_roff(line_char);
-            nc--;
-        }
-    }
+    /* Output the line, padding its interword gaps */
+    putline();
 
     /* End the line with newline */
     newline();
@@ -773,7 +754,7 @@ void istop(void) {
 
     /* Flush all pending output and wait for user input */
     flush();
-    read(0, &input_char, 1); /* Read one character from stdin */
+    OSA_READ(0, &input_char, 1); /* Read one character from stdin */
     /* Note: Original assembly included signal handling which is omitted 
      * in this portable C version for simplicity and compatibility */
 }
@@ -807,8 +788,19 @@ void istop(void) {
  * @param c Character to store in line buffer (0-255 range)
  */
 void storeline(int c) {
-    int char_width;
+    storelinew(c, width(c));
+}
 
+/**
+ * @brief Store a character whose width is known in the line buffer.
+ *
+ * storeline() without the width() call, for movword(), which has the
+ * widths storeword() recorded.
+ *
+ * @param c Character to store in line buffer
+ * @param char_width Its display width
+ */
+void storelinew(int c, int char_width) {
     /* Check buffer bounds using LINE_SIZE constant */
     if (linep >= line + LINE_SIZE) {
         return; /* Buffer full - silently ignore character */
@@ -818,8 +810,7 @@ void storeline(int c) {
     *linep = (char)(c);
     linep++;
 
-    /* Calculate character display width and update all counters */
-    char_width = width(c);
+    /* Update all counters */
     ne += char_width; /* Add to total line width */
     nel -= char_width; /* Subtract from remaining space */
     nc++; /* Increment character count */
@@ -872,6 +863,8 @@ void getword(void) {
     int current_char;
     int hyphen_pending = 0;
     int loop_counter = 0; /* Prevents infinite loops */
+    const char *run;
+    int run_length;
 
     /* Initialize word processing state */
     word_ptr = word;
@@ -923,6 +916,12 @@ void getword(void) {
 
         /* Continue reading word characters */
         while (loop_counter < 1000) {
+            /* Plain characters come straight from the input buffer */
+            if (ul <= 0 && (run_length = getrun(&run, 1000 - loop_counter, ohc)) > 0) {
+                storerun(run, run_length);
+                loop_counter += run_length;
+                continue;
+            }
             loop_counter++;
             current_char = gettchar();
 
@@ -1002,6 +1001,7 @@ void setnel(void) {
     ne = 0; /* Reset character width count */
     fac = 0; /* Reset justification factors */
     fmq = 0;
+    ngap = 0; /* No interword gaps yet */
 }
 
 /**
@@ -1039,12 +1039,43 @@ void storeword(int c) {
     wne += char_width; /* Add to total word width */
     wch++; /* Increment character count */
 
-    /* Store character in word buffer with bounds checking */
+    /* Store character and its width in word buffer with bounds checking */
     if (wordp < word + WORD_SIZE) {
+        wordw[wordp - word] = (signed char)char_width;
         *wordp++ = (char)(c);
     }
 }
 
+/**
+ * @brief Store a run of characters in the word buffer.
+ *
+ * Same as storeword() on each character of the run, for the runs of
+ * plain text getrun() hands getword().
+ *
+ * @param s Characters to store
+ * @param n How many
+ */
+void storerun(const char *s, int n) {
+    signed char *w;
+    int i, k;
+
+    k = n;
+    if (k > word + WORD_SIZE - wordp) {
+        k = (int)(word + WORD_SIZE - wordp);
+    }
+    w = wordw + (wordp - word);
+    for (i = 0; i < k; i++) {
+        w[i] = (signed char)width(s[i]);
+        wne += w[i];
+    }
+    for (; i < n; i++) {
+        wne += width(s[i]);
+    }
+    wch += n;
+    memcpy(wordp, s, (size_t)k);
+    wordp += k;
+}
+
 /**
  * @brief Ensure adequate space on current page with line spacing.
  *
@@ -1277,25 +1308,66 @@ void copyb(void) {
 // It's now part of otroff::roff_legacy.
 
 
-// Example: wbf
-void wbf(int character, int position) { // This is the definition for otroff::roff_legacy::wbf
-    /* Store parameters in static variables for file operations */
-    char_buf = (char)(character); // char_buf is file-static within this cpp
-    offb = position; // offb is file-static within this cpp
-
-    /* Seek to position and write character */
-    if (ibf >= 0) { // ibf is a global from otroff::roff_legacy
-        lseek(ibf, offb, SEEK_SET); // lseek is standard library
-        write(ibf, &char_buf, 1); // write is standard library
+/*
+ * Macro, string and header text is kept in an in-core block store
+ * (src/core/blkstore.c, the allocator croff's macros use) instead of
+ * being written a byte at a time to the buffer file and read back a
+ * block at a time.  Four bytes are packed to a word, so byte position
+ * b is at word b / 4 and a spilled block sits where wbf() used to put
+ * it in ibf.  With bspill set and ibf open, blocks past that many go to
+ * the file; by default they all stay in core.
+ */
+#define BFWORDS 128 /* words to a block of the store, 512 bytes */
+
+int bspill = 0; /* resident blocks before spilling to ibf, 0 = never */
+static long bstored; /* bytes written with wbf() */
+static otroff_blkstore_t bstore;
+static int bstore_ok;
+
+static otroff_blkstore_t *bst(void) {
+    if (!bstore_ok) {
+        if (otroff_blkstore_init(&bstore, BFWORDS, 0, (size_t)bspill) < 0) {
+            fputs("Core limit reached.\n", stderr);
+            exit(1);
+        }
+        otroff_blkstore_set_spill(&bstore, ibf);
+        bstore_ok = 1;
     }
+    return (&bstore);
+}
 
-    /* Update global position counter */
-    nextb = position + 1; // nextb is a global from otroff::roff_legacy
+/* Store a byte of buffer text at position */
+void wbf(int character, int position) {
+    int *w;
 
-    /* Handle file descriptor coordination */
-    if (ibf1 == ofile) { // ibf1 and ofile are globals from otroff::roff_legacy
-        ofile = -1;
+    w = otroff_blkstore_word(bst(), (size_t)position / sizeof(int), 1);
+    if (w == NULL) {
+        fputs("Core limit reached.\n", stderr);
+        exit(1);
     }
+    ((unsigned char *)w)[position % sizeof(int)] = (unsigned char)character;
+    bstored++;
+    nextb = position + 1;
+}
+
+/* The byte of buffer text at position; 0 where nothing was stored */
+int rbf0(int position) {
+    int *w;
+
+    w = otroff_blkstore_word(bst(), (size_t)position / sizeof(int), 0);
+    return (w != NULL ? ((unsigned char *)w)[position % sizeof(int)] : 0);
+}
+
+/* Bytes of buffer text in core; *peak the most there has been */
+size_t bfresident(size_t *peak) {
+    *peak = bstore_ok ? bstore.stats.resident_peak * BFWORDS * sizeof(int) : 0;
+    return (bstore_ok ? bstore.resident * BFWORDS * sizeof(int) : 0);
+}
+
+/* Bytes stored so far, and blocks read back from the spill file */
+void bfstats(long *stored, long *reread) {
+    *stored = bstored;
+    *reread = bstore_ok ? (long)bstore.stats.spill_reads : 0;
 }
 
 // Example: rdsufb
@@ -1315,7 +1387,7 @@ int rdsufb(int offset, int file_desc) { // This is the definition for otroff::ro
         /* Read block from file */
         if (file_desc >= 0) {
             lseek(file_desc, sufoff, SEEK_SET); // lseek is standard library
-            read(file_desc, sufbuf, SUFFIX_BUF_SIZE); // read is standard library, sufbuf global
+            OSA_READ(file_desc, sufbuf, SUFFIX_BUF_SIZE); // read is standard library, sufbuf global
         }
     }
 
@@ -1450,7 +1522,7 @@ static void wbf(int character, int position) {
  *   [character processing and stack management]
  *
  * Processing:
- * 1. Read character from current include position using rdsufb()
+ * 1. Read character from current include position using rbf0()
  * 2. Check for end-of-buffer condition (null character)
  * 3. Pop include stack if at end of current buffer
  * 4. Advance include pointer for next character
@@ -1471,7 +1543,7 @@ static void rbf(void) {
     int character;
 
     // Read character from current include position
-    character = rdsufb(ip, ibf1);
+    character = rbf0(ip);
 
     // Check for end of current buffer
     if (character == 0) {
@@ -100,7 +100,6 @@ static void decml(void);
 static void decml1(void);
 static void roman(void);
 static void roman1(void);
-static void nlines(int count, void (*func)(int));
 void nofill(void);
 
 /* Conversion state used by decimal and Roman numeral routines */
@@ -351,72 +350,52 @@ static void adjust(void) {
     rbreak();
 }
 
-// Note: fill_line_buffer_and_get_char was 'static int rofffill_line_buffer_and_get_char'
-// It should now be 'static int fill_line_buffer_and_get_char' within the outer namespace.
 /**
- * @brief Handle fill mode spacing with justification.
- *
- * Implements the sophisticated spacing algorithm used during line
- * output in fill mode. Distributes extra space evenly among words
- * with alternating patterns for even/odd lines.
- *
- * Assembly equivalent: Complex spacing calculation with bit testing
- * for even/odd line detection and dynamic space adjustment.
- *
- * Spacing Algorithm:
- * 1. Start with base spacing from fmq
- * 2. Check current line position in output
- * 3. Apply alternating spacing pattern for visual balance
- * 4. Adjust fac counter for remaining extra spaces
- * 5. Output calculated spacing
- * 6. Return next character for processing
- *
- * Even/Odd Line Logic:
- * - Even lines: Add extra space early in line
- * - Odd lines: Add extra space later in line
- * - Creates visually balanced text blocks
- * - Prevents "rivers" of white space
- *
- * @return Next character from line buffer for output
+ * @brief Output the line, padding its interword gaps.
+ *
+ * The fill routine of the original, which rbreak() called at each
+ * space, done for the whole line at once.  Each gap movword() recorded
+ * goes out as one run of its own spaces plus fmq, and one more in fac
+ * of the gaps: the first fac on even lines, the last fac on odd lines,
+ * so that the extra space does not pile up on one side of the page.
+ * The text between gaps goes out as it stands.  A line with no gaps
+ * recorded, such as one from nofill(), is output as it is.
+ *
+ * Assembly equivalent: fill, with its fac counter replaced by the
+ * range of gaps it would have padded.
  */
-static int fill_line_buffer_and_get_char(void) {
-    int spaces;
-    int next_char;
-
-    /* Start with base extra spacing */
-    spaces = fmq;
+void putline(void) {
+    char *p, *e, *g;
+    int k, run, lo, hi;
+
+    /* totout already counts this line */
+    if (totout & 1) {
+        lo = ngap - fac;
+        hi = ngap;
+    } else {
+        lo = 0;
+        hi = fac;
+    }
 
-    /* Apply spacing and advance past current space */
-    do {
-        spaces++;
-        nc--;
-        linep++;
-    } while (nc > 0 && *(linep - 1) == SPACE_CHAR);
-
-    /* Back up to last non-space character */
-    linep--;
-
-    /* Apply even/odd line spacing algorithm */
-    if ((totout & 1) == 0) {
-        /* Even line - add extra space early */
-        fac++;
-        if (fac < nwd) {
-            spaces++;
+    p = line;
+    e = line + nc;
+    for (k = 0; k < ngap; k++) {
+        g = line + gapv[k];
+        if (g < p || g >= e || *g != SPACE_CHAR) {
+            continue; /* Cut off by hyphenation */
         }
-    } else {
-        /* Odd line - add extra space later */
-        fac--;
-        if (fac >= 0) {
-            spaces++;
+        for (; p < g; p++) {
+            putchar_roff((unsigned char)*p);
+        }
+        for (run = 0; p < e && *p == SPACE_CHAR; p++) {
+            run++;
         }
+        space(run + fmq + (k >= lo && k < hi));
     }
-
-    /* Output the calculated spacing */
-    space(spaces);
-
-    /* Get next character for processing */
-    next_char = (unsigned char)*linep;
-    return next_char;
+    for (; p < e; p++) {
+        putchar_roff((unsigned char)*p);
+    }
+    nc = 0;
 }
 
 /**
@@ -472,8 +451,7 @@ static int movword(void) {
         while (word_ptr < word + wordend_local && *word_ptr == SPACE_CHAR) {
             word_ptr++;
             wch--;
-            char_width = width(SPACE_CHAR);
-            wne -= char_width;
+            wne -= wordw[word_ptr - word - 1];
         }
     }
 
@@ -506,6 +484,11 @@ move_word_to_line:
     nhyph = 0;
     original_wch = wch;
 
+    /* The word's leading spaces are a gap, unless it starts the line */
+    if (nwd > 0 && ngap < LINE_SIZE) {
+        gapv[ngap++] = (int)(linep - line);
+    }
+
     /* Process each character in the word */
     while (wch > 0) {
         c = ((unsigned char)*word_ptr++);
@@ -543,10 +526,10 @@ move_word_to_line:
             }
         }
 
-        /* Calculate character width and store in line */
-        char_width = width(c);
+        /* Store in line with the width storeword() found */
+        char_width = wordw[word_ptr - word - 1];
         wne -= char_width;
-        storeline(c);
+        storelinew(c, char_width);
         wch--;
     }
 
@@ -1007,7 +990,7 @@ static void headseg(void (*output_func)(int)) {
     /* Process characters in segment */
     while (1) {
         /* Read character from buffer */
-        c = rdsufb(buffer_pos++, nfile);
+        c = rbf0(buffer_pos++);
         if (c == 0) {
             break; /* End of segment */
         }
@@ -1047,32 +1030,13 @@ static void headseg(void (*output_func)(int)) {
  * the common case of horizontal spacing in formatted output.
  *
  * Assembly equivalent: Simple space output loop using nlines
- * subroutine with putchar function.
+ * subroutine with putchar function; here the spaces are added to
+ * the pending count at once.
  *
  * @param count Number of spaces to output
  */
 void space(int count) { // This is the definition for otroffroff_legacyspace
-    nlines(count, putchar_roff);
-}
-
-/**
- * @brief Output multiple instances using specified function.
- *
- * Generic function to output a specified number of characters
- * using the provided output function. Used for spacing and
- * repetitive character output.
- *
- * Assembly equivalent: Generic output loop with function pointer
- * and counter management.
- *
- * @param count Number of times to call function
- * @param func Function to call for each iteration
- */
-static void nlines(int count, void (*func)(int)) {
-    while (count > 0) {
-        func(SPACE_CHAR);
-        count--;
-    }
+    putspace(count);
 }
 
 /**
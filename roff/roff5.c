@@ -29,7 +29,7 @@
  * 6. Context validation and final placement
  *
  * Data Structures:
- * - Compact digram tables with 4-bit frequency weights
+ * - Digram weight tables shared with croff through src/core/digram.c
  * - Suffix pattern trees with bit-encoded morphological rules
  * - Character classification arrays for efficient lookup
  * - Hyphenation point markers using high-bit encoding
@@ -54,6 +54,8 @@
 
 /* Include ROFF system headers */
 #include "roff_c.h" /* roff definitions and function declarations */
+#include "core/hyphenation.h" /* pattern and digram hyphenation */
+#include "croff/suftab.h" /* the suffix table, compiled in */
 
 /* Copyright notice */
 static const char copyright[] = "Copyright 1972 Bell Telephone Laboratories Inc.";
@@ -64,16 +66,12 @@ static const char sccs_id[] =
 
 /* Constants for hyphenation algorithm */
 #define MAX_WORD_LENGTH 64 /**< Maximum word length for hyphenation */
-#define DIGRAM_TABLE_SIZE 338 /**< Size of digram lookup table (26*13) */
-#define SUFFIX_BUFFER_SIZE 32 /**< Buffer size for suffix processing */
 #define VOWEL_MASK 0x3F /**< Mask for vowel identification */
 #define ALPHA_MASK 0x7F /**< Mask for alphabetic characters */
 #define HYPHEN_MARK 0x80 /**< High bit marker for hyphenation points */
-#define SUFFIX_CONTINUE 0x40 /**< Suffix continuation bit */
+#define SUFFIX_NOMARK 0x40 /**< Suffix breaks move hstart but are not marked */
 #define SUFFIX_HYPHEN 0x80 /**< Suffix hyphenation bit */
-#define SUFFIX_VOWEL_CHECK 0x20 /**< Suffix vowel check bit */
-#define NIBBLE_MASK 0x0F /**< 4-bit nibble mask */
-#define NIBBLE_SHIFT 4 /**< Bits per nibble */
+#define SUFFIX_LAST 0x20 /**< No further suffix is looked for */
 
 /* External variables from ROFF system */
 // These are now accessed via `using namespace otroff::roff_legacy;` from roff.hpp
@@ -100,25 +98,13 @@ static const char sccs_id[] =
 /* Static variables for hyphenation state */
 static char punctuation_chars[] = "<.,()\"\\'`"; /**< Punctuation character set */
 
-/* Digram lookup tables - these would be initialized from data files */
-static unsigned char bxh[DIGRAM_TABLE_SIZE]; /**< Beginning + consonant + vowel */
-static unsigned char xxh[DIGRAM_TABLE_SIZE]; /**< Consonant + consonant + vowel patterns */
-static unsigned char bxxh[DIGRAM_TABLE_SIZE]; /**< Beginning + consonant + consonant + vowel patterns */
-static unsigned char xhx[DIGRAM_TABLE_SIZE]; /**< Consonant + vowel + consonant */
-static unsigned char hxx[DIGRAM_TABLE_SIZE]; /**< Vowel + consonant + consonant */
-
-/* Suffix table - would be initialized from suffix data */
-static unsigned short suftab[26]; /**< Suffix lookup table by first character */
-
 /* Function prototypes */
 static int punct(char *pos);
 static void maplow(int *ch);
 static int vowel(int ch);
 static int checkvow(char *pos);
-static void digram(void);
 static void suffix(void);
-static int dilook(int ch1, int ch2, unsigned char *table, int multiplier);
-static void rdsuf(int offset, char **result);
+static void hmark(char *word, size_t len, const unsigned char *breaks);
 
 /**
  * @brief Main hyphenation driver function.
@@ -146,10 +132,15 @@ static void rdsuf(int offset, char **result);
  * 3. Locate the beginning of the hyphenatable core
  * 4. Find the end boundary, handling trailing punctuation
  * 5. Invoke suffix analysis for morphological decomposition
- * 6. Invoke digram analysis for statistical hyphenation points
+ * 6. Invoke the digram analysis of src/core/digram.c on the stem
+ *
+ * When hypat is set, steps 5 and 6 are replaced by the Liang pattern
+ * engine of src/core/hyphpat.c.
  */
 void hyphen(void) {
-    char *current_pos;
+    char *current_pos, *word_start;
+    unsigned char breaks[MAX_WORD_LENGTH];
+    size_t len;
 
     /* Check if hyphenation is enabled and not already processed */
     if (hypedf != 0) {
@@ -181,6 +172,7 @@ void hyphen(void) {
     }
 
     /* Find start of hyphenatable region */
+    word_start = current_pos;
     while (1) {
         current_pos++;
         if (alph(((unsigned char)*current_pos)) == 0) {
@@ -201,11 +193,49 @@ void hyphen(void) {
         }
     }
 
+    len = (size_t)(hstart - word_start) + 1;
+    if (len > MAX_WORD_LENGTH) {
+        return; /* Too long to analyse */
+    }
+
+    /* With patterns selected, mark the breaks they find instead */
+    if (hypat) {
+        if (otroff_hyphen_pattern(word_start, len, breaks) > 0) {
+            hmark(word_start, len, breaks);
+        }
+        return;
+    }
+
     /* Perform morphological analysis through suffix patterns */
     suffix();
 
-    /* Perform statistical analysis through digram patterns */
-    digram();
+    /* Perform statistical analysis of the stem suffix() left */
+    if (hstart >= word_start &&
+        otroff_digram_breaks(word_start, len, (size_t)(hstart - word_start) + 1, thresh,
+                             breaks) > 0) {
+        hmark(word_start, len, breaks);
+    }
+}
+
+/**
+ * @brief Mark the breaks found by a src/core engine.
+ *
+ * Sets the hyphenation mark on each character of the word that has a
+ * break before it and counts it in nhyph.
+ *
+ * @param word First alphabetic character of the word
+ * @param len Number of alphabetic characters
+ * @param breaks Break flags, one per character
+ */
+static void hmark(char *word, size_t len, const unsigned char *breaks) {
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        if (breaks[i]) {
+            word[i] |= HYPHEN_MARK;
+            nhyph++;
+        }
+    }
 }
 
 /**
@@ -380,242 +410,6 @@ static int checkvow(char *pos) {
     }
 }
 
-/**
- * @brief Perform digram-based hyphenation analysis.
- *
- * This function implements the core statistical hyphenation algorithm using
- * digram (two-character sequence) frequency analysis. It scans through the
- * word identifying potential hyphenation points based on character pair
- * patterns and their associated weights.
- *
- * Mathematical Foundation:
- * - Uses 5 different digram tables for positional context
- * - Scores each position using weighted pattern matching
- * - Applies threshold-based decision making for hyphenation
- * - Implements sliding window analysis across word length
- *
- * Digram Table Types:
- * 1. bxh: Beginning + consonant + vowel patterns
- * 2. xxh: Consonant + consonant + vowel patterns  
- * 3. bxxh: Beginning + consonant + consonant + vowel patterns
- * 4. xhx: Consonant + vowel + consonant patterns
- * 5. hxx: Vowel + consonant + consonant patterns
- *
- * Algorithm Steps:
- * 1. Find first vowel from hyphenation start point
- * 2. Locate first consonant after vowel cluster
- * 3. Scan through word applying all digram patterns
- * 4. Calculate weighted scores for each position
- * 5. Select maximum scoring position above threshold
- * 6. Mark hyphenation point and continue analysis
- *
- * Assembly Translation Notes:
- * - Complex register usage converted to local variables
- * - Multiple nested loops converted to structured control flow
- * - Bit manipulation operations preserved exactly
- * - Table lookup addressing converted to array indexing
- */
-static void digram(void) {
-    char *current_pos;
-    char *analysis_start;
-    int ch1, ch2;
-    int score, max_score;
-    char *max_position;
-    int multiplier;
-
-    current_pos = hstart;
-
-    /* Find first vowel from start position */
-    while (1) {
-        if (alph(((unsigned char)*current_pos)) != 0) {
-            return; /* End of alphabetic content */
-        }
-
-        if (vowel(((unsigned char)*current_pos)) == 0) {
-            break; /* Found vowel */
-        }
-
-        current_pos--;
-    }
-
-    /* Update hyphenation start to vowel position */
-    hstart = current_pos;
-
-    /* Find first consonant after vowel cluster */
-    while (1) {
-        current_pos--;
-        ch1 = ((unsigned char)*current_pos);
-
-        if (alph2(ch1) != 0) {
-            return; /* End of word */
-        }
-
-        if (vowel(ch1) != 0) {
-            break; /* Found consonant */
-        }
-    }
-
-    /* Initialize digram analysis */
-    maxdig = 0;
-    nhstart = current_pos;
-
-    /* Main digram analysis loop */
-    while (current_pos < hstart) {
-        multiplier = 1;
-        max_score = 0;
-        max_position = current_pos;
-
-        /* Analyze patterns at current position */
-
-        /* Pattern 1: Check if previous character exists and is alphabetic */
-        ch1 = ((unsigned char)*(current_pos - 1));
-        if (alph2(ch1) == 0) {
-            /* Single character pattern - bxh table */
-            ch2 = ((unsigned char)*current_pos);
-            score = dilook('a', ch2, bxh, multiplier);
-        } else {
-            /* Two character patterns */
-            ch1 = ((unsigned char)*(current_pos - 2));
-
-            /* Determine which pattern table to use */
-            if (alph2(ch1) == 0) {
-                /* xxh pattern */
-                ch1 = ((unsigned char)*(current_pos - 1));
-                ch2 = ((unsigned char)*current_pos);
-                score = dilook(ch1, ch2, xxh, multiplier);
-            } else {
-                /* bxxh pattern */
-                ch1 = ((unsigned char)*(current_pos - 1));
-                ch2 = ((unsigned char)*current_pos);
-                score = dilook(ch1, ch2, bxxh, multiplier);
-            }
-        }
-
-        /* Update maximum if this score is higher */
-        if (score > max_score) {
-            max_score = score;
-        }
-
-        /* Pattern 2: xhx pattern (consonant-vowel-consonant) */
-        ch1 = ((unsigned char)*current_pos);
-        ch2 = ((unsigned char)*(current_pos + 1));
-        score = dilook(ch1, ch2, xhx, multiplier);
-        if (score > max_score) {
-            max_score = score;
-        }
-
-        /* Pattern 3: hxx pattern (vowel-consonant-consonant) */
-        ch1 = ((unsigned char)*current_pos);
-        ch2 = ((unsigned char)*(current_pos + 1));
-        score = dilook(ch1, ch2, hxx, multiplier);
-        if (score > max_score) {
-            max_score = score;
-        }
-
-        /* Check if this position has highest score so far */
-        if (max_score > maxdig) {
-            maxdig = max_score;
-            maxloc = current_pos;
-        }
-
-        current_pos++;
-    }
-
-    /* Reset analysis start for next iteration */
-    hstart = nhstart;
-
-    /* Check if maximum score exceeds threshold */
-    if (maxdig < thresh) {
-        return; /* Below threshold - no hyphenation */
-    }
-
-    /* Mark hyphenation point */
-    *maxloc |= HYPHEN_MARK;
-    nhyph++;
-
-    /* Recursive call to continue analysis */
-    digram();
-}
-
-/**
- * @brief Lookup digram score in specified table.
- *
- * Performs efficient table lookup for digram frequency weights using
- * optimized indexing and bit manipulation. Handles character validation,
- * case normalization, and packed data extraction.
- *
- * Mathematical Operations:
- * 1. Character validation and normalization
- * 2. 2D array index calculation: (ch1 * 13) + ch2
- * 3. Bit-packed data extraction using shifts and masks
- * 4. Score multiplication by context factor
- *
- * Data Structure:
- * - Table stores 4-bit values (0-15) packed as nibbles
- * - Index calculation maps to 26x26 character space
- * - Even indices use low nibble, odd indices use high nibble
- * - Multiplication factor applied based on pattern context
- *
- * Assembly Translation:
- * - Register r4 usage converted to local variables
- * - Complex addressing modes converted to pointer arithmetic
- * - Bit rotation and masking operations preserved
- * - Stack manipulation converted to local variables
- *
- * @param ch1 First character of digram
- * @param ch2 Second character of digram  
- * @param table Digram frequency table to search
- * @param multiplier Context-dependent scoring multiplier
- * @return Weighted digram score
- */
-static int dilook(int ch1, int ch2, unsigned char *table, int multiplier) {
-    int normalized_ch1, normalized_ch2;
-    int index;
-    int table_offset;
-    int nibble_value;
-    int final_score;
-    int bit_position;
-
-    /* Normalize characters to lowercase and validate range */
-    normalized_ch2 = ch2 & ALPHA_MASK;
-    maplow(&normalized_ch2);
-    normalized_ch2 -= 'a';
-    if (normalized_ch2 > ('z' - 'a')) {
-        return 0; /* Invalid character */
-    }
-
-    normalized_ch1 = ch1 & ALPHA_MASK;
-    maplow(&normalized_ch1);
-    normalized_ch1 -= 'a';
-    if (normalized_ch1 > ('z' - 'a')) {
-        return 0; /* Invalid character */
-    }
-
-    /* Calculate table index using 2D mapping */
-    /* Formula: index = ch1 * 13 + ch2 (using base-13 for efficiency) */
-    index = normalized_ch2 * 13;
-
-    /* Handle bit position calculation */
-    bit_position = 0;
-    if ((normalized_ch1 & 1) != 0) {
-        bit_position = 1;
-    }
-    table_offset = (normalized_ch1 >> 1) + index;
-
-    /* Extract nibble value from packed table */
-    nibble_value = table[table_offset];
-    if (bit_position == 0) {
-        /* Use high nibble */
-        nibble_value >>= NIBBLE_SHIFT;
-    }
-    nibble_value &= NIBBLE_MASK;
-
-    /* Calculate final score with multiplier */
-    final_score = nibble_value * multiplier;
-
-    return final_score;
-}
-
 /**
  * @brief Perform suffix-based morphological hyphenation analysis.
  *
@@ -638,7 +432,8 @@ static int dilook(int ch1, int ch2, unsigned char *table, int multiplier) {
  * 6. Continue with remaining word portion
  *
  * Data Structure:
- * - Suffix table indexed by last character of word
+ * - Suffix table indexed by last character of word, compiled in from
+ *   croff/suftab.c, so no suffix file is opened or read
  * - Bit-encoded suffix rules with length and pattern data
  * - Recursive pattern matching for compound suffixes
  * - Context flags for hyphenation permission
@@ -650,177 +445,72 @@ static int dilook(int ch1, int ch2, unsigned char *table, int multiplier) {
  * - Condition code testing converted to explicit comparisons
  */
 static void suffix(void) {
-    char *word_pos;
-    int last_char;
-    unsigned short suffix_entry;
-    unsigned short current_offset;
-    char *suffix_pattern;
-    int pattern_length;
-    char *pattern_pos;
-    char *word_check;
-    int pattern_char;
-    int word_char;
-    int match_found;
-
-    word_pos = hstart;
+    const unsigned char *entry, *s, *e;
+    char *w;
+    int c, mark;
+
+again:
+    w = hstart;
 
     /* Check if we have alphabetic content */
-    if (alph(((unsigned char)*word_pos)) != 0) {
+    if (alph(((unsigned char)*w)) != 0) {
         return; /* No alphabetic content */
     }
 
-    /* Get last character and normalize to lowercase */
-    last_char = ((unsigned char)*word_pos);
-    maplow(&last_char);
-    last_char -= 'a';
-
-    /* Get suffix table entry */
-    suffix_entry = suftab[last_char];
-    suffix_entry &= 0x7FFF; /* Clear high bit */
-
-    if (suffix_entry == 0) {
+    /* The entries for the last letter, from the compiled-in table */
+    c = ((unsigned char)*w);
+    maplow(&c);
+    if ((entry = suftab_entries(c - 'a')) == NULL) {
         return; /* No suffix patterns for this character */
     }
 
-    /* Process suffix patterns */
-    current_offset = suffix_entry;
-
-    while (1) {
-        /* Read suffix pattern from file */
-        rdsuf(current_offset, &suffix_pattern);
-
-        pattern_length = ((unsigned char)*suffix_pattern);
-        if (pattern_length == 0) {
-            break; /* End of suffix patterns */
+    /* Find the first entry whose letters end the word before that letter */
+    for (;; entry += *entry & 0x0F) {
+        if ((*entry & 0x0F) == 0) {
+            return; /* End of suffix patterns */
         }
-
-        pattern_length &= 0x0F; /* Extract length bits */
-        current_offset += pattern_length;
-        pattern_pos = suffix_pattern + pattern_length;
-
-        /* Attempt to match suffix pattern */
-        word_check = hstart;
-        match_found = 1;
-
-        while (pattern_pos > suffix_pattern + 1) {
-            pattern_char = ((unsigned char)*--pattern_pos);
-            pattern_char &= ALPHA_MASK;
-
-            word_char = ((unsigned char)*word_check--);
-            maplow(&word_char);
-
-            if (word_char != pattern_char) {
-                match_found = 0;
+        s = entry + (*entry & 0x0F);
+        w = hstart;
+        while (--s > entry && w > wordp) {
+            c = ((unsigned char)*--w);
+            maplow(&c);
+            if (c != (*s & ALPHA_MASK)) {
                 break;
             }
         }
-
-        if (!match_found) {
-            continue; /* Try next pattern */
+        if (s == entry) {
+            break;
         }
+    }
 
-        /* Pattern matched - check hyphenation rules */
-        word_pos = hstart;
-        pattern_pos = suffix_pattern + 1;
-        pattern_length = ((unsigned char)*suffix_pattern) & 0x0F;
-        pattern_pos += pattern_length;
-
-        /* Check for hyphenation permission bit */
-        if ((((unsigned char)*suffix_pattern) & SUFFIX_HYPHEN) == 0) {
-            /* No hyphenation allowed - scan for other patterns */
-            while (pattern_pos > suffix_pattern + 1) {
-                pattern_pos--;
-                if ((((unsigned char)*pattern_pos) & HYPHEN_MARK) != 0) {
-                    break;
+    /*
+     * Walk back over the suffix, moving hstart before each break the
+     * entry gives and marking it unless the entry says not to.
+     */
+    e = entry + (*entry & 0x0F);
+    s = entry + 1;
+    w = hstart;
+    mark = *entry & SUFFIX_HYPHEN;
+    for (;;) {
+        if (mark) {
+            hstart = w - 1;
+            if ((*entry & SUFFIX_NOMARK) == 0) {
+                if (checkvow(w) != 0) {
+                    return; /* No vowel found - invalid hyphenation */
                 }
-            }
-        } else {
-            /* Hyphenation allowed - update start position */
-            hstart = word_pos;
-            hstart--;
-
-            /* Check vowel requirement */
-            if ((((unsigned char)*suffix_pattern) & SUFFIX_VOWEL_CHECK) == 0) {
-                if (checkvow(word_pos) != 0) {
-                    continue; /* No vowel found - invalid hyphenation */
-                }
-
-                /* Mark hyphenation point */
-                *word_pos |= HYPHEN_MARK;
+                *w |= HYPHEN_MARK;
             }
         }
-
-        /* Check for continuation bit */
-        pattern_pos--;
-        if ((((unsigned char)*pattern_pos) & SUFFIX_CONTINUE) == 0) {
-            return; /* No more processing */
+        w--;
+        if (e <= s) {
+            break;
         }
-
-        /* Continue with recursive suffix analysis */
-        break;
+        mark = *--e & HYPHEN_MARK;
     }
 
-    /* Recursive call for additional suffix processing */
-    if (current_offset != suffix_entry) {
-        suffix();
-    }
-}
-
-/**
- * @brief Read suffix pattern data from external file.
- *
- * Loads suffix pattern data from the external suffix database file
- * into a local buffer for pattern matching operations. Handles
- * variable-length suffix patterns with embedded control information.
- *
- * File Format:
- * - First byte contains pattern length and control flags
- * - Following bytes contain pattern characters
- * - Patterns are stored consecutively in file
- * - Control flags indicate hyphenation rules
- *
- * Buffer Management:
- * - Uses static buffer to avoid dynamic allocation
- * - Loads complete pattern including control data
- * - Null-terminates patterns for string operations
- * - Maintains file position for sequential access
- *
- * Assembly Translation:
- * - Stack manipulation converted to local variables
- * - File I/O operations preserved with same interface
- * - Buffer pointer management converted to array indexing
- * - Register usage converted to local variable operations
- *
- * @param offset File offset to read pattern from
- * @param result Pointer to store pattern buffer address
- */
-static void rdsuf(int offset, char **result) {
-    static char pattern_buffer[SUFFIX_BUFFER_SIZE];
-    int pattern_length;
-    int bytes_read;
-    int i;
-    char *buffer_pos;
-
-    /* Set file context */
-    nfile = suff;
-
-    /* Read pattern length byte */
-    pattern_length = rdsufb(offset, nfile);
-
-    /* Initialize buffer */
-    buffer_pos = pattern_buffer;
-    *buffer_pos++ = pattern_length;
-
-    /* Extract actual length */
-    bytes_read = pattern_length & 0x0F;
-
-    /* Read pattern characters */
-    for (i = 0; i < bytes_read; i++) {
-        offset++;
-        *buffer_pos++ = rdsufb(offset, nfile);
+    /* Unless the entry is the last, look for a suffix of what is left */
+    if ((*entry & SUFFIX_LAST) == 0) {
+        goto again;
     }
-
-    /* Return buffer address */
-    *result = pattern_buffer;
 }
 
@@ -34,6 +34,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/stat.h> /* fstat */
+#include "core/memrep.h" /* memory report */
 #include <stddef.h> /* For size_t
 
 /* Include ROFF system headers */
@@ -178,6 +180,13 @@ int ohc = 0200;
  */
 int hyf = 1;
 
+/**
+ * @brief Hyphenation method.
+ * 0 uses the suffix and digram heuristics, 1 the Liang patterns of
+ * src/core/hyphpat.c.
+ */
+int hypat = 0;
+
 /**
  * @brief Hyphenation processed flag.
  * Indicates whether current word has been processed for hyphenation.
@@ -719,6 +728,22 @@ char trtab[TRANSLATE_TABLE_SIZE];
  */
 char word[WORD_SIZE];
 
+/**
+ * @brief Word character widths.
+ * The width() of each character in word[], recorded by storeword() as
+ * the word is built so that movword() need not measure it again.
+ */
+signed char wordw[WORD_SIZE];
+
+/**
+ * @brief Interword gaps of the line.
+ * The offset in line[] of the first space before each word after the
+ * first, recorded by movword(); ngap is how many there are.  rbreak()
+ * pads the line at these without looking for the spaces.
+ */
+int gapv[LINE_SIZE];
+int ngap;
+
 /*
  * =============================================================================
  * PRIMARY PROCESSING BUFFERS
@@ -847,6 +872,42 @@ size_t get_data_segment_size(void) {
     return ((char*)(&end_marker)) - ((char*)(&stbuf_marker));
 }
 
+/**
+ * @brief Fill in a memory report for roff.
+ *
+ * Names the static buffers one by one, where get_data_segment_size()
+ * only measures between two markers, and adds the buffer text store,
+ * the size of the buffer file ibf and what the process has on the heap
+ * and resident.  main() prints it for -M.
+ *
+ * @param m Report to fill
+ * @return 0
+ */
+int roff_memrep(otroff_memrep_t *m) {
+    struct stat sb;
+    size_t bytes, peak;
+
+    otroff_memrep_init(m, "roff");
+    otroff_memrep_buf(m, "line", sizeof(line));
+    otroff_memrep_buf(m, "word", sizeof(word));
+    otroff_memrep_buf(m, "wordw", sizeof(wordw));
+    otroff_memrep_buf(m, "gapv", sizeof(gapv));
+    otroff_memrep_buf(m, "obuf", sizeof(obuf));
+    otroff_memrep_buf(m, "trtab", sizeof(trtab));
+    otroff_memrep_buf(m, "sufbuf", sizeof(sufbuf));
+    otroff_memrep_buf(m, "suftab", sizeof(suftab));
+    otroff_memrep_buf(m, "ilist", sizeof(ilist));
+    otroff_memrep_buf(m, "tabtab", sizeof(tabtab));
+
+    bytes = bfresident(&peak);
+    otroff_memrep_arena(m, bytes, peak);
+    if (ibf >= 0 && fstat(ibf, &sb) == 0) {
+        m->temp_bytes = (size_t)sb.st_size;
+    }
+    otroff_memrep_sample(m);
+    return 0;
+}
+
 
 
 
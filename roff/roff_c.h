@@ -11,6 +11,8 @@
 #ifndef ROFF_C_H
 #define ROFF_C_H
 
+#include <stddef.h> /* size_t */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -86,6 +88,7 @@ extern int hx;          /* Header/footer processing flag */
 /* Buffer management */
 extern int nextb;       /* Next buffer position for writing */
 extern int ibf, ibf1;   /* Buffer file descriptors */
+extern int bspill;      /* Buffer blocks in core before spilling to ibf */
 extern int ofile;       /* Output file descriptor */
 extern int sufoff;      /* Suffix buffer offset for caching */
 
@@ -93,6 +96,9 @@ extern int sufoff;      /* Suffix buffer offset for caching */
 extern char line[];     /* Main line accumulation buffer */
 extern char* linep;     /* Current position in line buffer */
 extern char word[];     /* Word accumulation buffer */
+extern signed char wordw[]; /* Width of each character in word[] */
+extern int gapv[];      /* Line offsets of the interword gaps */
+extern int ngap;        /* Number of gaps in gapv[] */
 extern char* ehead;     /* Even page header string */
 extern char* efoot;     /* Even page footer string */
 extern char* ohead;     /* Odd page header string */
@@ -105,6 +111,7 @@ extern int ilist[];     /* Include list stack array */
 /* Hyphenation state variables */
 extern int hypedf;      /* Hyphenation processed flag */
 extern int hyf;         /* Hyphenation enabled flag */
+extern int hypat;       /* Use Liang patterns instead of digrams */
 extern int nhyph;       /* Number of hyphens inserted */
 extern int thresh;      /* Hyphenation threshold */
 extern int maxdig;      /* Maximum digram score */
@@ -124,7 +131,9 @@ extern char sufbuf[];   /* Suffix buffer */
 /* Core ROFF functions */
 int getchar_roff();
 int gettchar();
+int getrun(const char **p, int max, int stop);
 void putchar_roff(int c);
+void putspace(int n);
 void eject();
 void headout(char** header_ptr);
 void space(int count);
@@ -141,9 +150,15 @@ void decimal(int num, void (*output_func)(int));
 int number1(int default_val);
 void setnel();
 void storeword(int c);
+void storerun(const char *s, int n);
 void storeline(int c);
+void storelinew(int c, int w);
+void putline(void);
 void need2(int lines);
 void wbf(int character, int position);
+int rbf0(int position);
+void bfstats(long *stored, long *reread);
+size_t bfresident(size_t *peak);
 void rbreak();
 void getword();
 void hyphen();
@@ -15,11 +15,14 @@
 #include <fcntl.h>
 
 #include "roff_c.h"
+#define OSA_TAG "roff"
+#include "os/os_acct.h" /* OSA_MALLOC, OSA_FREE, OSA_IO */
 
 /* OS abstraction defines */
 #define os_close close
 #define os_open open
 #define os_write write
+#define os_read read
 #ifndef STDOUT_FILENO
 #define STDOUT_FILENO 1
 #endif
@@ -71,12 +74,31 @@ static char *obuf_base(void) {
     return base_ptr;
 }
 
+/* Input read ahead of getchar_roff() and getrun() */
+#define INBUF 65536
+static unsigned char inbuf[INBUF];
+static unsigned char *inp = inbuf, *ine = inbuf;
+
+/** Refill the input buffer from the current file; 0 at its end. */
+static int refill(void) {
+    ssize_t n;
+
+    n = OSA_IO(OSA_KREAD, os_read(ifile >= 0 ? ifile : 0, inbuf, sizeof(inbuf)));
+    if (n <= 0) {
+        inp = ine = inbuf;
+        return 0;
+    }
+    inp = inbuf;
+    ine = inbuf + n;
+    return 1;
+}
+
 /**
  * Read a character from the current input stream.
  *
  * This is a greatly simplified version of the original routine.  It only
  * implements the basic buffering logic required by the rest of the C
- * translation.
+ * translation.  The input is read a buffer at a time.
  *
  * @return Next character or 0 on end of input.
  */
@@ -94,10 +116,10 @@ int getchar_roff(void) {
         return '\n';
     }
 
-    c = getchar();
-    if (c == EOF) {
+    if (inp == ine && !refill()) {
         return 0;
     }
+    c = *inp++;
 
     if (c == '\n') {
         nlflg = 1;
@@ -109,6 +131,45 @@ int getchar_roff(void) {
     return c & 0x7f;
 }
 
+/**
+ * Hand out the run of printable ASCII at the head of the input without
+ * copying it, for getword().  The run stops before a space, a newline,
+ * any other control or 8-bit byte, and the character stop.
+ *
+ * @param[out] p  Start of the run, in the input buffer
+ * @param max     Longest run wanted
+ * @param stop    A printable character that ends the run too
+ * @return Length of the run; 0 if the next character must come from
+ *         getchar_roff() (pending character, newline, end of buffer)
+ */
+int getrun(const char **p, int max, int stop) {
+    unsigned char *s, *e;
+
+    if (ch != 0 || nlflg || inp == ine) {
+        return 0;
+    }
+    e = ine - inp > max ? inp + max : ine;
+    for (s = inp; s < e && *s > ' ' && *s < 0177 && *s != stop; s++)
+        ;
+    *p = (const char *)inp;
+    column += (int)(s - inp);
+    inp = s;
+    return (int)(s - (unsigned char *)*p);
+}
+
+/**
+ * Output n spaces: as n calls of putchar_roff(' '), which only counts
+ * them until the next character decides between spaces and tabs.
+ *
+ * @param n Spaces to output
+ */
+void putspace(int n) {
+    if (pn < pfrom || pn > pto || n <= 0) {
+        return;
+    }
+    nsp += n;
+}
+
 /**
  * Output a character using the ROFF buffering scheme.
  *
@@ -219,8 +280,8 @@ void headin(char **p) {
         buf[len] = '\0';
     }
 
-    free(*p);
-    *p = malloc(len + 1);
+    OSA_FREE(*p);
+    *p = OSA_MALLOC(len + 1);
     if (*p != NULL) {
         memcpy(*p, buf, len + 1);
     }
@@ -286,6 +347,7 @@ int nextfile(void) {
         os_close(ifile);
         ifile = -1;
     }
+    inp = ine = inbuf; /* drop what was read ahead of the old file */
 
     if (nx) {
         return -1;
@@ -355,7 +417,7 @@ void flush(void) {
     size_t len = (size_t)(obufp - base);
 
     if (len > 0) {
-        os_write(STDOUT_FILENO, base, len);
+        OSA_IO(OSA_KWRITE, os_write(STDOUT_FILENO, base, len));
         obufp = base;
     }
 }
@@ -0,0 +1,269 @@
+/**
+ * @file blkstore.c
+ * @brief Arena-backed word block store with optional temp-file spill
+ *
+ * See blkstore.h for the addressing model.  Resident blocks are plain
+ * heap arrays reached through a growable slot table, so the common case
+ * of reading or writing a macro word is two array indexings and no
+ * system call.  Spilled blocks share a single staging buffer that is
+ * written back lazily, mirroring the old one-block rbuf/wbuf scheme.
+ * A lent block's slot points at the caller's words and is flagged in
+ * lent[], so it is copied before a write and never freed.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#include "blkstore.h"
+#include "os_abstraction.h"
+#define OSA_TAG "core.blkstore"
+#include "os_acct.h" /* OSA_MALLOC, OSA_IO, ... */
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BLKSTORE_MIN_SLOTS 64
+
+/* Grow the slot tables so that block blk has an entry. */
+static int grow_slots(otroff_blkstore_t *st, size_t blk) {
+    size_t n;
+    int **nb;
+    unsigned char *ns, *nl;
+
+    if (blk < st->nslots)
+        return 0;
+    n = st->nslots ? st->nslots : BLKSTORE_MIN_SLOTS;
+    while (n <= blk)
+        n <<= 1;
+    if ((nb = OSA_REALLOC(st->blocks, n * sizeof(*nb))) == NULL)
+        return -1;
+    st->blocks = nb;
+    if ((ns = OSA_REALLOC(st->spill, n)) == NULL)
+        return -1;
+    st->spill = ns;
+    if ((nl = OSA_REALLOC(st->lent, n)) == NULL)
+        return -1;
+    st->lent = nl;
+    memset(st->blocks + st->nslots, 0, (n - st->nslots) * sizeof(*nb));
+    memset(st->spill + st->nslots, 0, n - st->nslots);
+    memset(st->lent + st->nslots, 0, n - st->nslots);
+    st->nslots = n;
+    return 0;
+}
+
+static off_t spill_pos(const otroff_blkstore_t *st, size_t blk) {
+    return (off_t)((st->base + blk * st->block_words) * sizeof(int));
+}
+
+/* Move the staging cache onto block blk, writing back the old block. */
+static int load_cache(otroff_blkstore_t *st, size_t blk, int fresh) {
+    size_t bytes = st->block_words * sizeof(int);
+    ssize_t n;
+
+    if (st->cache_ok && st->cache_blk == blk)
+        return 0;
+    if (otroff_blkstore_sync(st) < 0)
+        return -1;
+    st->cache_ok = 0;
+    if (fresh) {
+        memset(st->cache, 0, bytes);
+    } else {
+        if (os_lseek(st->spill_fd, spill_pos(st, blk), SEEK_SET) < 0)
+            return -1;
+        if ((n = OSA_IO(OSA_KREAD, os_read(st->spill_fd, st->cache, bytes))) < 0)
+            return -1;
+        if ((size_t)n < bytes)
+            memset((char *)st->cache + n, 0, bytes - (size_t)n);
+        st->stats.spill_reads++;
+    }
+    st->cache_blk = blk;
+    st->cache_ok = 1;
+    return 0;
+}
+
+int otroff_blkstore_init(otroff_blkstore_t *st, size_t block_words,
+                         size_t base, size_t limit) {
+    if (st == NULL || block_words == 0 ||
+        (block_words & (block_words - 1)) != 0)
+        return -1;
+    memset(st, 0, sizeof(*st));
+    st->block_words = block_words;
+    st->base = base;
+    st->limit = limit;
+    st->spill_fd = -1;
+    if ((st->cache = OSA_MALLOC(block_words * sizeof(int))) == NULL)
+        return -1;
+    return 0;
+}
+
+void otroff_blkstore_destroy(otroff_blkstore_t *st) {
+    size_t i;
+
+    if (st == NULL)
+        return;
+    for (i = 0; i < st->nslots; i++)
+        if (!st->lent[i])
+            OSA_FREE(st->blocks[i]);
+    OSA_FREE(st->blocks);
+    OSA_FREE(st->spill);
+    OSA_FREE(st->lent);
+    OSA_FREE(st->cache);
+    memset(st, 0, sizeof(*st));
+    st->spill_fd = -1;
+}
+
+void otroff_blkstore_set_spill(otroff_blkstore_t *st, int fd) {
+    st->spill_fd = fd;
+}
+
+void otroff_blkstore_set_spill_open(otroff_blkstore_t *st, int (*open)(void *arg),
+                                    void *arg) {
+    st->spill_open = open;
+    st->spill_arg = arg;
+}
+
+/* Attach the spill file on first need; 0 if there is one now */
+static int open_spill(otroff_blkstore_t *st) {
+    int (*open)(void *arg) = st->spill_open;
+
+    if (open == NULL)
+        return -1;
+    st->spill_open = NULL; /* whatever happens, ask only once */
+    if ((st->spill_fd = open(st->spill_arg)) < 0) {
+        st->spill_fd = -1;
+        return -1;
+    }
+    return 0;
+}
+
+int *otroff_blkstore_word(otroff_blkstore_t *st, size_t addr, int write) {
+    size_t blk, w;
+    int *b;
+
+    if (addr < st->base)
+        return NULL;
+    w = addr - st->base;
+    blk = w / st->block_words;
+    w &= st->block_words - 1;
+
+    if (blk < st->nslots) {
+        if ((b = st->blocks[blk]) != NULL && st->lent[blk] && write) {
+            /* First write to a lent block: copy it to one of the store's. */
+            if ((b = OSA_MALLOC(st->block_words * sizeof(int))) == NULL)
+                return NULL;
+            memcpy(b, st->blocks[blk], st->block_words * sizeof(int));
+            st->blocks[blk] = b;
+            st->lent[blk] = 0;
+            st->stats.lent--;
+            st->stats.lent_copies++;
+            if (++st->resident > st->stats.resident_peak)
+                st->stats.resident_peak = st->resident;
+        }
+        if (b != NULL)
+            return &b[w];
+        if (st->spill[blk]) {
+            if (load_cache(st, blk, 0) < 0)
+                return NULL;
+            if (write)
+                st->cache_dirty = 1;
+            return &st->cache[w];
+        }
+    }
+    if (!write)
+        return NULL;
+
+    /* First write to this block: keep it in core unless over the limit. */
+    if (grow_slots(st, blk) < 0)
+        return NULL;
+    if (st->limit && st->resident >= st->limit &&
+        (st->spill_fd >= 0 || open_spill(st) == 0)) {
+        if (load_cache(st, blk, 1) < 0)
+            return NULL;
+        st->spill[blk] = 1;
+        st->stats.spilled++;
+        st->cache_dirty = 1;
+        return &st->cache[w];
+    }
+    if ((b = OSA_CALLOC(st->block_words, sizeof(int))) == NULL)
+        return NULL;
+    st->blocks[blk] = b;
+    if (++st->resident > st->stats.resident_peak)
+        st->stats.resident_peak = st->resident;
+    return &b[w];
+}
+
+int *otroff_blkstore_span(otroff_blkstore_t *st, size_t addr, size_t *n) {
+    size_t blk, w;
+    int *b;
+
+    if (addr < st->base)
+        return NULL;
+    w = addr - st->base;
+    blk = w / st->block_words;
+    w &= st->block_words - 1;
+    if (blk >= st->nslots || (b = st->blocks[blk]) == NULL)
+        return NULL;
+    *n = st->block_words - w;
+    return &b[w];
+}
+
+int otroff_blkstore_lend(otroff_blkstore_t *st, size_t addr, const int *words) {
+    size_t blk;
+
+    if (addr < st->base)
+        return -1;
+    blk = (addr - st->base) / st->block_words;
+    if (grow_slots(st, blk) < 0)
+        return -1;
+    otroff_blkstore_release(st, addr);
+    st->blocks[blk] = (int *)words; /* read only until copied */
+    st->lent[blk] = 1;
+    st->stats.lent++;
+    return 0;
+}
+
+int otroff_blkstore_lent(const otroff_blkstore_t *st, size_t addr) {
+    size_t blk;
+
+    if (addr < st->base)
+        return 0;
+    blk = (addr - st->base) / st->block_words;
+    return blk < st->nslots && st->lent[blk];
+}
+
+void otroff_blkstore_release(otroff_blkstore_t *st, size_t addr) {
+    size_t blk;
+
+    if (addr < st->base)
+        return;
+    blk = (addr - st->base) / st->block_words;
+    if (blk >= st->nslots)
+        return;
+    if (st->lent[blk]) {
+        st->blocks[blk] = NULL;
+        st->lent[blk] = 0;
+        st->stats.lent--;
+    } else if (st->blocks[blk] != NULL) {
+        OSA_FREE(st->blocks[blk]);
+        st->blocks[blk] = NULL;
+        st->resident--;
+    } else if (st->spill[blk]) {
+        st->spill[blk] = 0;
+        st->stats.spilled--;
+        if (st->cache_ok && st->cache_blk == blk)
+            st->cache_ok = st->cache_dirty = 0;
+    }
+}
+
+int otroff_blkstore_sync(otroff_blkstore_t *st) {
+    size_t bytes = st->block_words * sizeof(int);
+
+    if (!st->cache_ok || !st->cache_dirty)
+        return 0;
+    if (os_lseek(st->spill_fd, spill_pos(st, st->cache_blk), SEEK_SET) < 0 ||
+        OSA_IO(OSA_KWRITE, os_write(st->spill_fd, st->cache, bytes)) != (ssize_t)bytes)
+        return -1;
+    st->cache_dirty = 0;
+    st->stats.spill_writes++;
+    return 0;
+}
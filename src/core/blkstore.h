@@ -0,0 +1,196 @@
+/**
+ * @file blkstore.h
+ * @brief Arena-backed word block store with optional temp-file spill
+ *
+ * The formatters keep macro, string and diversion bodies in fixed-size
+ * blocks of words addressed by a linear word offset.  Historically those
+ * blocks lived only in a temporary file, so every block crossing cost a
+ * seek() plus a read() or write().  This store keeps the blocks resident
+ * in memory and only spills them to a file descriptor once a configurable
+ * number of blocks is resident.
+ *
+ * Addressing is unchanged from the file based scheme: block @c k covers
+ * word addresses <tt>[base + k * block_words, base + (k + 1) * block_words)</tt>
+ * and a spilled block lives at byte offset <tt>address * sizeof(int)</tt>
+ * of the spill file, so everything below @c base stays free for callers.
+ *
+ * A block may also be lent: its words are the caller's, typically in a
+ * read-only mapping that many processes share, and the store copies them
+ * into a block of its own only when the block is first written.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#ifndef OTROFF_BLKSTORE_H
+#define OTROFF_BLKSTORE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Usage counters for a block store
+ */
+typedef struct {
+    size_t resident_peak;   /**< Most blocks resident at once */
+    size_t spilled;         /**< Blocks currently living in the spill file */
+    size_t spill_reads;     /**< Block reads from the spill file */
+    size_t spill_writes;    /**< Block writes to the spill file */
+    size_t lent;            /**< Blocks currently lent by the caller */
+    size_t lent_copies;     /**< Lent blocks copied on their first write */
+} otroff_blkstore_stats_t;
+
+/**
+ * @brief Block store state
+ */
+typedef struct {
+    int **blocks;           /**< Resident blocks by index, NULL if absent */
+    unsigned char *spill;   /**< Non-zero if the block lives in the file */
+    unsigned char *lent;    /**< Non-zero if blocks[] points at lent words */
+    size_t nslots;          /**< Capacity of blocks[] and spill[] */
+    size_t block_words;     /**< Words per block (power of two) */
+    size_t base;            /**< Word address of block 0 */
+    size_t resident;        /**< Blocks currently resident */
+    size_t limit;           /**< Resident blocks before spilling, 0 = never */
+    int spill_fd;           /**< Spill file descriptor, -1 if none */
+    int (*spill_open)(void *arg); /**< Makes the spill file when first needed */
+    void *spill_arg;        /**< Argument to spill_open */
+    int *cache;             /**< Staging block for spilled blocks */
+    size_t cache_blk;       /**< Block held in cache (valid if cache_ok) */
+    int cache_ok;           /**< cache holds cache_blk */
+    int cache_dirty;        /**< cache must be written back */
+    otroff_blkstore_stats_t stats; /**< Usage counters */
+} otroff_blkstore_t;
+
+/**
+ * @brief Initialize a block store
+ *
+ * @param st           Store to initialize
+ * @param block_words  Words per block, must be a power of two
+ * @param base         Word address of the first block
+ * @param limit        Resident block limit before spilling (0 = unlimited)
+ * @return  0 on success, -1 on invalid arguments or allocation failure
+ */
+int otroff_blkstore_init(otroff_blkstore_t *st, size_t block_words,
+                         size_t base, size_t limit);
+
+/**
+ * @brief Release all memory held by a store
+ *
+ * The spill descriptor is not closed; it belongs to the caller.
+ *
+ * @param st  Store to destroy (may be NULL)
+ */
+void otroff_blkstore_destroy(otroff_blkstore_t *st);
+
+/**
+ * @brief Attach the spill file
+ *
+ * Until a descriptor is attached every block stays resident regardless
+ * of the limit.
+ *
+ * @param st  Block store
+ * @param fd  Open read/write descriptor, or -1 to disable spilling
+ */
+void otroff_blkstore_set_spill(otroff_blkstore_t *st, int fd);
+
+/**
+ * @brief Make the spill file only when it is first needed
+ *
+ * The first time a block would spill and no descriptor is attached,
+ * @p open is called once with @p arg and whatever descriptor it returns
+ * is attached.  If it returns -1 the store keeps every block resident.
+ * So a run that stays under the limit never creates a file at all.
+ *
+ * @param st    Block store
+ * @param open  Returns an open read/write descriptor, or -1
+ * @param arg   Passed to @p open
+ */
+void otroff_blkstore_set_spill_open(otroff_blkstore_t *st, int (*open)(void *arg),
+                                    void *arg);
+
+/**
+ * @brief Locate the word at a store address
+ *
+ * Blocks are created on first write.  Reading a word in a block that was
+ * never written yields NULL, which callers treat as a zero word.  For a
+ * spilled block the returned pointer aims into the staging cache and is
+ * only valid until the next call.
+ *
+ * @param st     Block store
+ * @param addr   Word address
+ * @param write  Non-zero if the caller will store through the pointer
+ * @return  Pointer to the word, or NULL
+ */
+int *otroff_blkstore_word(otroff_blkstore_t *st, size_t addr, int write);
+
+/**
+ * @brief Locate a resident run of words
+ *
+ * Gives the address of the word at @p addr and, through @p n, the
+ * number of words from there to the end of its block, so that a caller
+ * walking a chain can index straight into the block.  The pointer stays
+ * valid until the block is released.  Blocks that were never written or
+ * that live in the spill file yield NULL; use otroff_blkstore_word()
+ * for those.
+ *
+ * @param st    Block store
+ * @param addr  Word address
+ * @param n     Set to the words left in the block
+ * @return  Pointer to the word, or NULL
+ */
+int *otroff_blkstore_span(otroff_blkstore_t *st, size_t addr, size_t *n);
+
+/**
+ * @brief Lend the words of a block
+ *
+ * The block at @p addr reads from @p words, which the caller keeps valid
+ * and unchanged as long as the block is lent; whatever the block held
+ * before is discarded.  The first write through
+ * otroff_blkstore_word() copies the words into a block of the store's
+ * own, so memory written to is never the caller's.  A lent block does
+ * not count against the resident limit.
+ *
+ * @param st     Block store
+ * @param addr   Any word address inside the block
+ * @param words  block_words words
+ * @return  0 on success, -1 if @p addr is below the base or out of memory
+ */
+int otroff_blkstore_lend(otroff_blkstore_t *st, size_t addr, const int *words);
+
+/**
+ * @brief Whether a block is lent and not yet copied
+ *
+ * A span of a lent block, from otroff_blkstore_span(), may only be read,
+ * and is no longer the block once a write has copied it.
+ *
+ * @param st    Block store
+ * @param addr  Any word address inside the block
+ * @return  Non-zero if the block is lent
+ */
+int otroff_blkstore_lent(const otroff_blkstore_t *st, size_t addr);
+
+/**
+ * @brief Discard a block
+ *
+ * @param st    Block store
+ * @param addr  Any word address inside the block
+ */
+void otroff_blkstore_release(otroff_blkstore_t *st, size_t addr);
+
+/**
+ * @brief Write back any buffered spill data
+ *
+ * @param st  Block store
+ * @return  0 on success, -1 on a write error
+ */
+int otroff_blkstore_sync(otroff_blkstore_t *st);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OTROFF_BLKSTORE_H */
@@ -0,0 +1,160 @@
+/**
+ * @file digram.c
+ * @brief Digram hyphenation shared by roff, croff and hytab_api
+ *
+ * See hyphenation.h for the interface.  The goodness of a break after a
+ * letter is the product of three weights from digram_tab.h: the pair
+ * ending at the letter (bxh, bxxh or xxh, by how near the start of the
+ * word it is), the pair across the break (xhx) and the pair after it
+ * (hxx).  otroff_digram_scores() forms every product of a word in one
+ * pass; where the build targets a CPU with AVX2 (CPU= in the Makefile)
+ * eight are formed at a time with gathers, and otherwise one at a time.
+ * otroff_digram_breaks() then takes, working back from the end of the
+ * stem one vowel-to-vowel stretch at a time, the best break in each
+ * stretch that passes the threshold.  Nothing is allocated.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#include "hyphenation.h"
+
+#include <string.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "digram_tab.h"
+
+static const int digbase[] = {DIG_BXH, DIG_BXXH, DIG_XXH, DIG_XHX, DIG_HXX};
+
+/* Letter codes of word[0..len), 0 for 'a'; -1 if one is not a letter */
+static int digcode(const char *word, size_t len, int *code) {
+    size_t i;
+    int c;
+
+    for (i = 0; i < len; i++) {
+        c = word[i] & 0177;
+        if (c >= 'A' && c <= 'Z')
+            c += 'a' - 'A';
+        if (c < 'a' || c > 'z')
+            return -1;
+        code[i] = c - 'a';
+    }
+    return 0;
+}
+
+static int isvowel(int c) {
+    return c == 'a' - 'a' || c == 'e' - 'a' || c == 'i' - 'a' || c == 'o' - 'a' ||
+           c == 'u' - 'a' || c == 'y' - 'a';
+}
+
+int otroff_digram_weight(otroff_digram_table_t t, int a, int b) {
+    if ((unsigned)t > OTROFF_DIG_HXX || a < 0 || a > 25 || b < 0 || b > 25)
+        return 0;
+    if (t == OTROFF_DIG_BXH)
+        return digtab[DIG_BXH + b];
+    return digtab[digbase[t] + a * 26 + b];
+}
+
+/* score[k + 1] is the goodness of a break after word[k], for k < len - 2 */
+static void digscore(const int *code, size_t len, int *score) {
+    size_t k, n;
+
+    n = len - 2;
+    score[1] = digtab[DIG_BXH + code[0]] * digtab[DIG_XHX + code[0] * 26 + code[1]] *
+               digtab[DIG_HXX + code[1] * 26 + code[2]];
+    k = 1;
+    if (n > 1) {
+        score[2] = digtab[DIG_BXXH + code[0] * 26 + code[1]] *
+                   digtab[DIG_XHX + code[1] * 26 + code[2]] *
+                   digtab[DIG_HXX + code[2] * 26 + code[3]];
+        k = 2;
+    }
+#if defined(__AVX2__)
+    {
+        const __m256i m26 = _mm256_set1_epi32(26);
+        const __m256i low = _mm256_set1_epi32(0377);
+        __m256i p, q, r, t, a, b, c;
+
+        for (; k + 8 <= n; k += 8) {
+            p = _mm256_loadu_si256((const __m256i *)&code[k - 1]);
+            q = _mm256_loadu_si256((const __m256i *)&code[k]);
+            r = _mm256_loadu_si256((const __m256i *)&code[k + 1]);
+            t = _mm256_loadu_si256((const __m256i *)&code[k + 2]);
+            a = _mm256_i32gather_epi32((const int *)&digtab[DIG_XXH],
+                                       _mm256_add_epi32(_mm256_mullo_epi32(p, m26), q), 1);
+            b = _mm256_i32gather_epi32((const int *)&digtab[DIG_XHX],
+                                       _mm256_add_epi32(_mm256_mullo_epi32(q, m26), r), 1);
+            c = _mm256_i32gather_epi32((const int *)&digtab[DIG_HXX],
+                                       _mm256_add_epi32(_mm256_mullo_epi32(r, m26), t), 1);
+            a = _mm256_mullo_epi32(_mm256_and_si256(a, low), _mm256_and_si256(b, low));
+            a = _mm256_mullo_epi32(a, _mm256_and_si256(c, low));
+            _mm256_storeu_si256((__m256i *)&score[k + 1], a);
+        }
+    }
+#endif
+    for (; k < n; k++) {
+        score[k + 1] = digtab[DIG_XXH + code[k - 1] * 26 + code[k]] *
+                       digtab[DIG_XHX + code[k] * 26 + code[k + 1]] *
+                       digtab[DIG_HXX + code[k + 1] * 26 + code[k + 2]];
+    }
+}
+
+int otroff_digram_scores(const char *word, size_t len, int *score) {
+    int code[OTROFF_MAX_WORD_LENGTH];
+
+    if (word == NULL || score == NULL)
+        return OTROFF_HYPHEN_ERROR_INVALID_ARG;
+    memset(score, 0, len * sizeof(*score));
+    if (len < 3 || len > OTROFF_MAX_WORD_LENGTH)
+        return 0;
+    if (digcode(word, len, code) < 0)
+        return OTROFF_HYPHEN_ERROR_NO_ALPHA;
+    digscore(code, len, score);
+    return 0;
+}
+
+int otroff_digram_breaks(const char *word, size_t len, size_t end, int thresh,
+                         unsigned char *breaks) {
+    int score[OTROFF_MAX_WORD_LENGTH];
+    int code[OTROFF_MAX_WORD_LENGTH];
+    int h, v, k, stop, best, nbrk;
+
+    if (word == NULL || breaks == NULL)
+        return OTROFF_HYPHEN_ERROR_INVALID_ARG;
+    memset(breaks, 0, len);
+    if (len < 3 || len > OTROFF_MAX_WORD_LENGTH)
+        return 0;
+    if (digcode(word, len, code) < 0)
+        return OTROFF_HYPHEN_ERROR_NO_ALPHA;
+    score[0] = 0;
+    digscore(code, len, score);
+    if (end > len)
+        end = len;
+
+    /*
+     * h is the vowel ending the stretch, v the vowel before it; the
+     * candidates are the breaks after word[v..h - 1], none of them
+     * closer than two letters to the end of the word.
+     */
+    nbrk = 0;
+    for (h = (int)end - 1; h >= 0 && !isvowel(code[h]); h--)
+        ;
+    while (h > 0) {
+        for (v = h - 1; v >= 0 && !isvowel(code[v]); v--)
+            ;
+        if (v < 0)
+            break;
+        stop = (h < (int)len - 2) ? h : (int)len - 2;
+        for (best = 0, k = v; k < stop; k++)
+            if (score[k + 1] > score[best])
+                best = k + 1;
+        if (best && score[best] > thresh) {
+            breaks[best] = 1;
+            nbrk++;
+        }
+        h = v;
+    }
+    return nbrk;
+}
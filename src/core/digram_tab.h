@@ -0,0 +1,132 @@
+/*
+ * digram_tab.h - Digram weights for digram.c
+ *
+ * The five tables of the original troff hytab.c, which packed two 4-bit
+ * weights per byte in [26][13] rows, unpacked to one byte per letter
+ * pair so that a weight is a single load.  Row a, column b is the weight
+ * of the letter pair ab; bxh has the one row ('a') troff ever used.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+/* Offsets of the tables in digtab[] */
+#define DIG_XXH (0 * 26 * 26)
+#define DIG_BXXH (1 * 26 * 26)
+#define DIG_XHX (2 * 26 * 26)
+#define DIG_HXX (3 * 26 * 26)
+#define DIG_BXH (4 * 26 * 26)
+#define DIG_SIZE (DIG_BXH + 26 + 3) /* padded for 4-byte gathers */
+
+static const unsigned char digtab[DIG_SIZE] = {
+    /* xxh: pair ending at the letter before a break */
+    2, 5, 6, 8, 6, 12, 7, 2, 2, 2, 10, 6, 8, 8, 6, 7, 6, 10, 4, 3, 9, 8, 0, 15, 8, 6, /* a */
+    4, 0, 0, 0, 2, 0, 0, 0, 6, 0, 0, 0, 0, 0, 4, 0, 0, 0, 1, 1, 5, 0, 0, 15, 3, 0, /* b */
+    4, 0, 0, 0, 2, 0, 0, 2, 6, 0, 13, 0, 0, 0, 3, 0, 0, 0, 0, 1, 9, 0, 0, 15, 2, 0, /* c */
+    4, 0, 0, 1, 5, 0, 0, 1, 10, 1, 0, 0, 0, 0, 4, 0, 0, 0, 1, 0, 6, 0, 0, 15, 3, 0, /* d */
+    1, 3, 7, 2, 2, 6, 6, 2, 1, 2, 8, 7, 8, 8, 5, 9, 2, 10, 4, 6, 10, 8, 0, 15, 4, 8, /* e */
+    3, 0, 0, 0, 2, 2, 0, 0, 7, 0, 0, 0, 0, 0, 2, 0, 0, 0, 8, 10, 4, 0, 0, 15, 0, 0, /* f */
+    6, 0, 0, 0, 2, 0, 0, 2, 6, 0, 0, 0, 0, 0, 5, 0, 0, 0, 2, 0, 5, 0, 0, 15, 2, 0, /* g */
+    4, 0, 0, 0, 4, 0, 0, 0, 6, 0, 0, 1, 1, 1, 6, 0, 0, 0, 2, 6, 4, 0, 0, 15, 6, 0, /* h */
+    3, 6, 2, 5, 1, 5, 8, 1, 1, 0, 5, 8, 6, 6, 1, 8, 5, 8, 4, 3, 1, 5, 0, 15, 0, 6, /* i */
+    4, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 8, 0, 0, 15, 0, 0, /* j */
+    8, 0, 0, 0, 1, 0, 0, 1, 6, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 5, 0, 0, 15, 2, 0, /* k */
+    5, 0, 1, 6, 2, 2, 1, 0, 6, 0, 7, 1, 2, 2, 6, 3, 0, 0, 1, 2, 7, 2, 0, 15, 2, 0, /* l */
+    5, 1, 2, 2, 3, 0, 1, 0, 6, 0, 8, 0, 0, 0, 5, 3, 0, 0, 1, 1, 9, 0, 0, 15, 2, 1, /* m */
+    5, 1, 2, 2, 3, 0, 5, 0, 6, 0, 8, 0, 0, 0, 5, 3, 0, 0, 1, 1, 7, 0, 0, 15, 2, 1, /* n */
+    2, 9, 5, 6, 6, 8, 6, 1, 3, 0, 8, 8, 6, 6, 3, 6, 1, 6, 7, 5, 1, 6, 0, 15, 10, 7, /* o */
+    5, 0, 0, 0, 2, 0, 0, 3, 7, 0, 0, 0, 0, 0, 6, 0, 0, 0, 1, 1, 4, 0, 0, 15, 6, 0, /* p */
+    0, 0, 0, 0, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 15, 0, 0, /* q */
+    6, 1, 1, 3, 5, 2, 2, 0, 7, 0, 6, 3, 2, 2, 6, 2, 0, 0, 2, 7, 6, 3, 0, 15, 1, 0, /* r */
+    5, 0, 0, 0, 2, 0, 0, 6, 6, 0, 3, 0, 0, 0, 6, 1, 0, 0, 1, 6, 4, 0, 0, 15, 2, 0, /* s */
+    6, 0, 0, 0, 1, 0, 0, 7, 4, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 1, 6, 0, 0, 15, 1, 0, /* t */
+    4, 8, 5, 5, 2, 9, 7, 2, 5, 0, 5, 5, 5, 7, 4, 4, 0, 6, 4, 4, 0, 0, 0, 15, 2, 10, /* u */
+    6, 0, 0, 0, 2, 0, 0, 0, 7, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 3, 0, 0, 15, 0, 0, /* v */
+    2, 0, 0, 5, 1, 0, 0, 0, 2, 0, 12, 11, 9, 9, 1, 8, 0, 0, 6, 0, 0, 0, 0, 15, 2, 14, /* w */
+    6, 0, 0, 0, 7, 0, 0, 0, 8, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 0, 0, 0, 15, 10, 0, /* x */
+    3, 5, 2, 2, 3, 0, 2, 0, 0, 0, 8, 6, 9, 9, 6, 6, 0, 6, 9, 4, 9, 0, 0, 15, 0, 4, /* y */
+    10, 0, 0, 0, 1, 0, 0, 0, 6, 0, 0, 0, 0, 0, 9, 0, 0, 0, 0, 0, 8, 0, 0, 15, 6, 1, /* z */
+    /* bxxh: same, second letter of the word */
+    0, 5, 6, 8, 6, 11, 3, 2, 3, 2, 10, 6, 6, 10, 5, 7, 6, 6, 8, 3, 12, 8, 0, 15, 8, 6, /* a */
+    4, 0, 0, 0, 5, 0, 0, 0, 6, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 5, 0, 0, 0, 3, 0, /* b */
+    4, 0, 0, 0, 2, 0, 0, 0, 3, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 9, 0, 0, 0, 2, 0, /* c */
+    4, 0, 0, 0, 5, 0, 0, 0, 8, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 6, 0, 0, 0, 3, 0, /* d */
+    2, 3, 6, 2, 2, 6, 6, 0, 3, 2, 6, 7, 8, 8, 5, 9, 2, 6, 4, 6, 10, 6, 0, 15, 4, 9, /* e */
+    3, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, /* f */
+    3, 0, 0, 0, 2, 0, 0, 0, 2, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 4, 0, 0, 0, 2, 0, /* g */
+    4, 0, 0, 0, 4, 0, 0, 0, 4, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 4, 0, 0, 0, 6, 0, /* h */
+    3, 6, 2, 5, 6, 5, 6, 0, 0, 0, 3, 8, 15, 15, 1, 8, 5, 8, 4, 3, 0, 3, 0, 15, 0, 6, /* i */
+    2, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, /* j */
+    8, 0, 0, 0, 1, 0, 0, 0, 6, 0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 5, 0, 0, 0, 2, 0, /* k */
+    5, 0, 0, 0, 2, 0, 0, 0, 3, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 7, 0, 0, 0, 2, 0, /* l */
+    5, 0, 0, 0, 2, 0, 0, 0, 5, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 7, 0, 0, 0, 2, 0, /* m */
+    5, 0, 0, 0, 1, 0, 0, 0, 6, 0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 6, 0, 0, 0, 2, 0, /* n */
+    2, 9, 5, 6, 6, 8, 6, 0, 3, 0, 8, 8, 6, 6, 0, 6, 0, 6, 7, 5, 0, 3, 0, 15, 10, 4, /* o */
+    5, 0, 0, 0, 2, 0, 0, 0, 7, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 3, 0, 0, 0, 6, 0, /* p */
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, /* q */
+    6, 0, 0, 0, 6, 0, 0, 0, 3, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 6, 0, 0, 0, 1, 0, /* r */
+    5, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 3, 0, 0, 0, 2, 0, /* s */
+    6, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 6, 0, 0, 0, 1, 0, /* t */
+    3, 8, 5, 5, 2, 9, 7, 2, 5, 0, 4, 5, 5, 6, 4, 4, 0, 6, 2, 4, 0, 0, 0, 15, 2, 10, /* u */
+    6, 0, 0, 0, 1, 0, 0, 0, 6, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 3, 0, 0, 0, 2, 0, /* v */
+    1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, /* w */
+    6, 0, 0, 0, 7, 0, 0, 0, 8, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 0, /* x */
+    3, 5, 2, 2, 3, 0, 8, 0, 0, 0, 8, 8, 9, 2, 6, 6, 0, 6, 8, 4, 9, 0, 0, 10, 0, 3, /* y */
+    10, 0, 0, 0, 1, 0, 0, 0, 5, 0, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 8, 0, 0, 0, 10, 0, /* z */
+    /* xhx: pair across the break */
+    1, 10, 6, 6, 2, 2, 4, 7, 3, 14, 4, 2, 2, 2, 6, 6, 8, 2, 2, 8, 0, 6, 0, 0, 2, 9, /* a */
+    1, 14, 15, 15, 2, 15, 0, 11, 2, 15, 15, 6, 15, 15, 2, 15, 0, 1, 15, 15, 2, 15, 0, 0, 2, 0, /* b */
+    1, 15, 15, 15, 1, 0, 0, 0, 4, 0, 1, 2, 15, 15, 2, 15, 15, 2, 4, 14, 4, 0, 0, 0, 0, 15, /* c */
+    2, 15, 15, 15, 2, 15, 1, 9, 5, 15, 15, 3, 15, 15, 1, 15, 15, 2, 11, 8, 3, 15, 0, 0, 4, 15, /* d */
+    3, 12, 6, 2, 0, 10, 9, 14, 3, 14, 5, 5, 3, 3, 7, 5, 14, 1, 2, 6, 2, 7, 0, 0, 1, 4, /* e */
+    1, 0, 0, 15, 3, 13, 15, 15, 2, 0, 0, 1, 15, 15, 0, 15, 0, 1, 8, 4, 1, 0, 0, 0, 2, 0, /* f */
+    2, 15, 0, 15, 2, 15, 14, 0, 6, 0, 15, 2, 12, 12, 4, 15, 0, 3, 12, 2, 4, 0, 0, 0, 2, 15, /* g */
+    2, 15, 14, 15, 3, 15, 0, 15, 4, 0, 15, 6, 12, 12, 2, 15, 14, 2, 14, 6, 1, 15, 0, 0, 3, 0, /* h */
+    10, 10, 6, 5, 3, 10, 6, 15, 15, 15, 7, 5, 3, 3, 3, 6, 7, 4, 2, 8, 15, 3, 0, 0, 15, 2, /* i */
+    0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 15, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, /* j */
+    4, 15, 0, 15, 9, 15, 15, 15, 8, 0, 14, 12, 5, 5, 4, 8, 0, 4, 10, 15, 0, 0, 0, 0, 12, 0, /* k */
+    2, 15, 15, 7, 2, 12, 14, 15, 6, 15, 8, 14, 12, 12, 4, 12, 8, 15, 14, 11, 2, 11, 0, 0, 2, 15, /* l */
+    3, 15, 8, 11, 3, 15, 3, 15, 7, 15, 12, 15, 15, 15, 4, 12, 15, 15, 14, 10, 3, 15, 0, 0, 3, 14, /* m */
+    3, 15, 8, 11, 3, 15, 3, 15, 6, 15, 7, 15, 15, 15, 2, 12, 15, 15, 14, 10, 4, 15, 0, 0, 3, 13, /* n */
+    5, 5, 9, 8, 3, 5, 8, 14, 2, 15, 3, 6, 3, 3, 2, 7, 14, 5, 5, 6, 0, 9, 0, 0, 1, 11, /* o */
+    2, 15, 15, 15, 2, 9, 15, 0, 5, 0, 15, 1, 11, 11, 2, 14, 0, 1, 10, 14, 2, 15, 0, 0, 3, 0, /* p */
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, /* q */
+    3, 14, 12, 8, 2, 14, 12, 8, 5, 15, 7, 12, 11, 11, 2, 13, 13, 13, 11, 6, 1, 11, 0, 0, 6, 13, /* r */
+    3, 15, 6, 15, 2, 15, 15, 0, 2, 15, 3, 3, 2, 2, 1, 4, 3, 15, 8, 6, 1, 0, 0, 0, 2, 0, /* s */
+    2, 15, 1, 15, 3, 15, 15, 0, 4, 0, 15, 5, 15, 15, 1, 15, 15, 2, 7, 14, 2, 8, 0, 0, 1, 6, /* t */
+    7, 7, 6, 6, 2, 2, 4, 10, 3, 15, 4, 8, 3, 2, 10, 12, 15, 6, 2, 10, 15, 15, 0, 0, 7, 3, /* u */
+    3, 0, 0, 0, 2, 0, 0, 0, 5, 0, 0, 0, 15, 15, 3, 0, 0, 10, 0, 0, 1, 15, 0, 0, 10, 15, /* v */
+    1, 15, 9, 10, 6, 15, 15, 1, 2, 0, 0, 3, 5, 5, 0, 8, 0, 1, 10, 14, 0, 0, 0, 0, 14, 0, /* w */
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 0, 15, 11, 15, /* x */
+    10, 11, 12, 13, 10, 15, 8, 14, 15, 15, 8, 6, 6, 6, 12, 6, 15, 9, 5, 6, 9, 10, 0, 0, 0, 4, /* y */
+    2, 15, 0, 10, 4, 0, 15, 0, 7, 0, 15, 0, 0, 0, 2, 0, 0, 0, 0, 15, 6, 15, 0, 0, 7, 14, /* z */
+    /* hxx: pair after the break */
+    0, 6, 2, 2, 2, 1, 5, 3, 1, 1, 1, 4, 3, 3, 2, 2, 0, 2, 2, 3, 1, 1, 0, 1, 1, 2, /* a */
+    6, 0, 0, 0, 8, 0, 0, 3, 11, 0, 0, 6, 0, 0, 7, 0, 0, 7, 0, 0, 6, 0, 0, 0, 13, 0, /* b */
+    9, 0, 0, 0, 7, 0, 0, 5, 10, 0, 0, 8, 0, 0, 4, 0, 0, 6, 0, 0, 8, 0, 0, 0, 13, 0, /* c */
+    10, 0, 0, 0, 5, 0, 0, 3, 6, 0, 0, 0, 0, 0, 10, 0, 0, 8, 0, 0, 9, 0, 0, 0, 7, 0, /* d */
+    2, 2, 1, 3, 2, 1, 2, 0, 2, 0, 1, 2, 2, 3, 2, 1, 1, 8, 3, 4, 1, 1, 0, 0, 2, 1, /* e */
+    4, 0, 0, 0, 6, 0, 0, 0, 9, 0, 0, 6, 0, 0, 6, 0, 0, 3, 0, 0, 8, 0, 0, 0, 0, 0, /* f */
+    8, 0, 0, 0, 5, 0, 0, 2, 9, 0, 0, 8, 0, 0, 7, 0, 0, 6, 0, 0, 6, 0, 0, 0, 13, 0, /* g */
+    1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, /* h */
+    2, 3, 7, 3, 3, 5, 2, 4, 1, 2, 2, 3, 4, 4, 2, 2, 3, 1, 6, 6, 3, 1, 0, 0, 0, 7, /* i */
+    4, 0, 0, 0, 6, 0, 0, 0, 2, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, /* j */
+    6, 0, 0, 0, 2, 0, 0, 9, 3, 0, 0, 4, 0, 1, 5, 0, 0, 3, 0, 0, 6, 0, 0, 0, 2, 0, /* k */
+    8, 0, 0, 0, 4, 0, 0, 0, 6, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 6, 0, 0, 0, 10, 0, /* l */
+    8, 0, 0, 0, 6, 0, 0, 0, 7, 0, 0, 0, 0, 0, 9, 0, 0, 0, 0, 0, 6, 0, 0, 0, 10, 0, /* m */
+    8, 0, 0, 0, 6, 0, 0, 0, 7, 0, 0, 0, 0, 0, 9, 0, 0, 0, 0, 0, 3, 0, 0, 0, 10, 0, /* n */
+    1, 1, 2, 3, 2, 1, 5, 1, 2, 0, 1, 3, 2, 2, 0, 3, 6, 2, 2, 2, 3, 1, 0, 1, 1, 2, /* o */
+    5, 0, 0, 0, 6, 0, 0, 8, 6, 0, 0, 8, 0, 0, 6, 0, 0, 2, 0, 0, 5, 0, 0, 0, 5, 0, /* p */
+    0, 0, 0, 0, 0, 0, 0, 0, 15, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0, 0, 0, 0, 0, /* q */
+    4, 0, 0, 0, 2, 0, 0, 5, 5, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 3, 0, 0, 0, 6, 0, /* r */
+    6, 0, 2, 0, 4, 0, 0, 1, 10, 0, 2, 1, 0, 0, 10, 2, 0, 0, 0, 2, 6, 0, 0, 0, 4, 0, /* s */
+    10, 0, 0, 0, 5, 0, 0, 2, 8, 0, 0, 0, 0, 0, 13, 0, 0, 7, 0, 0, 10, 0, 0, 0, 14, 0, /* t */
+    4, 1, 1, 1, 2, 1, 1, 0, 2, 0, 0, 5, 2, 2, 5, 1, 0, 2, 1, 1, 8, 1, 0, 0, 1, 0, /* u */
+    7, 0, 0, 0, 4, 0, 0, 0, 6, 0, 0, 0, 0, 0, 7, 0, 0, 6, 0, 0, 9, 0, 0, 0, 6, 0, /* v */
+    6, 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 0, 0, 0, 4, 0, 0, 1, 0, 0, 12, 0, 0, 0, 0, 0, /* w */
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, /* x */
+    4, 6, 2, 1, 2, 0, 6, 7, 2, 0, 0, 0, 3, 3, 2, 1, 0, 1, 4, 2, 7, 0, 0, 2, 0, 2, /* y */
+    12, 0, 0, 0, 2, 0, 0, 15, 6, 0, 0, 15, 0, 0, 10, 0, 0, 0, 0, 0, 6, 0, 0, 0, 5, 0, /* z */
+    /* bxh: first letter of the word */
+    3, 0, 0, 0, 2, 0, 0, 0, 2, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 2, 0, 0, 0, 2, 0,
+    0, 0, 0};
@@ -33,6 +33,9 @@ extern "C" {
 #define OTROFF_MAX_WORD_LENGTH 64      /**< Maximum word length for hyphenation */
 #define OTROFF_DIGRAM_TABLE_SIZE 338   /**< Size of digram lookup table (26*13) */
 #define OTROFF_SUFFIX_BUFFER_SIZE 512  /**< Buffer size for suffix data */
+#define OTROFF_PAT_LEFTMIN 2           /**< Fewest letters before a pattern break */
+#define OTROFF_PAT_RIGHTMIN 3          /**< Fewest letters after a pattern break */
+#define OTROFF_DIGRAM_THRESH 160       /**< Default digram score threshold (.ht) */
 
 /* ============================================================================
  * Type Definitions
@@ -49,6 +52,25 @@ typedef enum {
     OTROFF_HYPHEN_ERROR_IO = -4        /**< I/O error reading suffix data */
 } otroff_hyphen_error_t;
 
+/**
+ * @brief How hyphenation points are found
+ */
+typedef enum {
+    OTROFF_HYPHEN_DIGRAM = 0,          /**< Suffix and digram heuristics */
+    OTROFF_HYPHEN_PATTERNS = 1         /**< Liang patterns, see otroff_hyphen_pattern() */
+} otroff_hyphen_method_t;
+
+/**
+ * @brief The digram weight tables
+ */
+typedef enum {
+    OTROFF_DIG_BXH = 0,                /**< First letter of the word */
+    OTROFF_DIG_BXXH = 1,               /**< Pair ending at the second letter */
+    OTROFF_DIG_XXH = 2,                /**< Pair ending before a break */
+    OTROFF_DIG_XHX = 3,                /**< Pair across a break */
+    OTROFF_DIG_HXX = 4                 /**< Pair after a break */
+} otroff_digram_table_t;
+
 /**
  * @brief Digram lookup tables
  *
@@ -84,6 +106,7 @@ typedef struct {
     /* Algorithm parameters */
     int threshold;                      /**< Minimum score for hyphenation */
     bool enabled;                       /**< Hyphenation enabled flag */
+    otroff_hyphen_method_t method;      /**< Heuristics or patterns */
 
     /* Analysis state */
     char* word_start;                   /**< Start of word being analyzed */
@@ -212,6 +235,80 @@ void otroff_hyphen_set_threshold(otroff_hyphen_context_t* ctx, int threshold);
  */
 void otroff_hyphen_reset(otroff_hyphen_context_t* ctx);
 
+/* ============================================================================
+ * Pattern Hyphenation
+ * ============================================================================ */
+
+/**
+ * @brief Find hyphenation points with Liang's patterns
+ *
+ * Matches the US English TeX patterns (hyphen.pat), compiled by mkhyphpat
+ * into a packed trie that is part of the binary, so no tables need to be
+ * loaded and no context is needed.  Runs in time linear in the word
+ * length and allocates nothing.
+ *
+ * The word holds letters only; case and the high bit are ignored.  On
+ * return breaks[i] is 1 if a hyphen may go before word[i], at least
+ * OTROFF_PAT_LEFTMIN letters from the start and OTROFF_PAT_RIGHTMIN from
+ * the end.  Words longer than OTROFF_MAX_WORD_LENGTH get no breaks.
+ *
+ * @param word    Letters of the word
+ * @param len     Number of letters
+ * @param breaks  Receives len flags
+ * @return  Number of breaks found, or negative error code
+ */
+int otroff_hyphen_pattern(const char* word, size_t len, unsigned char* breaks);
+
+/* ============================================================================
+ * Digram Hyphenation
+ * ============================================================================ */
+
+/**
+ * @brief Weight of one letter pair in one digram table
+ *
+ * @param t  Table
+ * @param a  First letter, 0 for 'a'; ignored for OTROFF_DIG_BXH
+ * @param b  Second letter, 0 for 'a'
+ * @return  Weight 0-15, 0 for an argument out of range
+ */
+int otroff_digram_weight(otroff_digram_table_t t, int a, int b);
+
+/**
+ * @brief Score every digram break of a word
+ *
+ * The troff digram heuristic, with the weights compiled in.  On return
+ * score[i] is the goodness of a hyphen before word[i], for 1 <= i <=
+ * len - 2, and 0 elsewhere; the largest possible score is 3375.  The
+ * whole word is scored in one pass, with AVX2 gathers when the build
+ * targets a CPU that has them.  Words longer than
+ * OTROFF_MAX_WORD_LENGTH get all zeros.
+ *
+ * @param word   Letters of the word; case and the high bit are ignored
+ * @param len    Number of letters
+ * @param score  Receives len scores
+ * @return  0, or negative error code
+ */
+int otroff_digram_scores(const char* word, size_t len, int* score);
+
+/**
+ * @brief Find hyphenation points with the digram heuristic
+ *
+ * Works back from word[end - 1] one vowel-to-vowel stretch at a time,
+ * as troff does after suffix analysis has left a stem of end letters,
+ * and in each stretch keeps the best scoring break if it scores more
+ * than thresh.  On return breaks[i] is 1 if a hyphen may go before
+ * word[i].
+ *
+ * @param word    Letters of the word; case and the high bit are ignored
+ * @param len     Number of letters
+ * @param end     Letters in the stem to consider, at most len
+ * @param thresh  Score a break must exceed, normally OTROFF_DIGRAM_THRESH
+ * @param breaks  Receives len flags
+ * @return  Number of breaks found, or negative error code
+ */
+int otroff_digram_breaks(const char* word, size_t len, size_t end, int thresh,
+                         unsigned char* breaks);
+
 /* ============================================================================
  * Utility Functions
  * ============================================================================ */
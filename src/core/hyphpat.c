@@ -0,0 +1,87 @@
+/**
+ * @file hyphpat.c
+ * @brief Liang pattern hyphenation over a packed trie
+ *
+ * See hyphenation.h for the interface and mkhyphpat.c for the table
+ * layout.  Every suffix of ".word." is run down the trie; each pattern
+ * matched along the way raises the inter-letter values it covers, and
+ * the odd values that remain are the permitted breaks.  The trie is a
+ * flat const array, so a transition is one load and a compare, and a
+ * word costs at most its length times the longest pattern with no
+ * allocation.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#include "hyphenation.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "hyphpat_tab.h"
+
+#define HP_DOT 27 /* letter code of the word boundary */
+
+#define HP_CHK(e) ((e) & 037)
+#define HP_OP(e) (((e) >> 5) & 03777)
+#define HP_LINK(e) ((e) >> 16)
+
+#define HP_POS(o) ((o) & 0377)
+#define HP_VAL(o) (((o) >> 8) & 017)
+#define HP_NEXT(o) ((o) >> 12)
+
+int otroff_hyphen_pattern(const char *word, size_t len, unsigned char *breaks) {
+    unsigned char code[OTROFF_MAX_WORD_LENGTH + 2];
+    unsigned char val[OTROFF_MAX_WORD_LENGTH + 3];
+    uint32_t e, o;
+    size_t i, j, n;
+    unsigned s, op;
+    int c, nbrk;
+
+    if (word == NULL || breaks == NULL)
+        return OTROFF_HYPHEN_ERROR_INVALID_ARG;
+    memset(breaks, 0, len);
+    if (len < OTROFF_PAT_LEFTMIN + OTROFF_PAT_RIGHTMIN)
+        return OTROFF_HYPHEN_ERROR_TOO_SHORT;
+    if (len > OTROFF_MAX_WORD_LENGTH)
+        return 0;
+
+    n = len + 2;
+    code[0] = code[n - 1] = HP_DOT;
+    for (i = 0; i < len; i++) {
+        c = word[i] & 0177;
+        if (c >= 'A' && c <= 'Z')
+            c += 'a' - 'A';
+        if (c < 'a' || c > 'z')
+            return OTROFF_HYPHEN_ERROR_NO_ALPHA;
+        code[i + 1] = (unsigned char)(c - 'a' + 1);
+    }
+    memset(val, 0, n + 1);
+
+    /* val[k] is the value between code[k - 1] and code[k]. */
+    for (i = 0; i < n; i++) {
+        for (s = HYPHPAT_ROOT, j = i; j < n; j++) {
+            e = hyphpat_trie[s + code[j]];
+            if (HP_CHK(e) != code[j])
+                break;
+            for (op = HP_OP(e); op; op = HP_NEXT(o)) {
+                o = hyphpat_ops[op];
+                if (val[i + HP_POS(o)] < HP_VAL(o))
+                    val[i + HP_POS(o)] = (unsigned char)HP_VAL(o);
+            }
+            if (!(s = HP_LINK(e)))
+                break;
+        }
+    }
+
+    /* A break before word[k] sits between code[k] and code[k + 1]. */
+    nbrk = 0;
+    for (i = OTROFF_PAT_LEFTMIN; i + OTROFF_PAT_RIGHTMIN <= len; i++) {
+        if (val[i + 1] & 1) {
+            breaks[i] = 1;
+            nbrk++;
+        }
+    }
+    return nbrk;
+}
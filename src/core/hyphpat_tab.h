@@ -0,0 +1,924 @@
+/* hyphpat_tab.h - generated by mkhyphpat from hyphen.pat; do not edit */
+
+/* 4447 patterns, 7112 states, 169 output entries */
+#define HYPHPAT_ROOT 1
+#define HYPHPAT_SLOTS 7123
+
+static const uint32_t hyphpat_trie[HYPHPAT_SLOTS] = {
+    0x0, 0x0, 0x1bc0001, 0x3cc0002, 0x4840003, 0x5be0004, 0x6a40005, 0x9460006,
+    0x9e10007, 0xaa50008, 0xb7d0009, 0xd60000a, 0xd75000b, 0xdc6000c, 0xf12000d, 0x100e000e,
+    0x1169000f, 0x133f0010, 0x144b0011, 0x14730012, 0x16620013, 0x17c30014, 0x19280015, 0x1a4b0016,
+    0x1ad80017, 0x1b240018, 0x1b520019, 0x1bb6001a, 0x1c001b, 0x330001, 0x590002, 0x6f0003,
+    0x8a0004, 0xa40005, 0xbe0006, 0xc90007, 0xd20008, 0xe60009, 0xe9000a, 0x28,
+    0xfa000c, 0x114000d, 0x126000e, 0x130000f, 0x1410010, 0x2f0004, 0x1500012, 0x16f0013,
+    0x1850014, 0x1950015, 0x1a90016, 0x1ac0017, 0x260005, 0x1b10019, 0x1f0003, 0x290004,
+    0x52, 0x270006, 0x2a0001, 0x74, 0x94, 0xcd, 0xb4, 0x28000c,
+    0x39000d, 0x48000e, 0x45, 0x420005, 0xf3, 0x3a0012, 0x500013, 0x460014,
+    0x520015, 0x4f0016, 0x4b0017, 0xa3, 0x85, 0xb3, 0x490014, 0x27,
+    0x310009, 0x300009, 0x3d0009, 0x83, 0x112, 0x4a000f, 0x64, 0xed,
+    0x49, 0x2e, 0x5a0001, 0x25, 0x470034, 0xa1, 0x530005, 0xa1,
+    0x70, 0x47, 0x59, 0x73, 0x3e0014, 0x5e0032, 0x5d0013, 0xaf,
+    0x5c000e, 0x129, 0x8d, 0x600012, 0x29, 0x560013, 0x5b0015, 0x5f0014,
+    0x6d0001, 0x580014, 0x700010, 0x630014, 0x770005, 0x25, 0xc3, 0x7c0048,
+    0x720149, 0x7a0001, 0x62000d, 0x73000e, 0xe2, 0x780010, 0x85000f, 0x710012,
+    0x76000f, 0x54, 0xcc, 0x83000c, 0x41, 0x7b0009, 0x790014, 0x7d000c,
+    0x109, 0x7f000c, 0x85, 0xd2, 0x88000e, 0x800005, 0x108, 0x890005,
+    0x8b000f, 0x23, 0xd2, 0x970009, 0x49, 0x81, 0x81000d, 0x7e0052,
+    0x8f, 0x8f000f, 0x8c0003, 0x940012, 0x8e0013, 0x89, 0x920009, 0x9f0015,
+    0x950014, 0x16f, 0x43, 0x54, 0xe2, 0x9b0001, 0x42, 0x860014,
+    0x32, 0x960005, 0x189, 0x147, 0xa2000d, 0x930012, 0xa10013, 0xa80015,
+    0xaf000c, 0xaa0009, 0xb9000e, 0xa4, 0xab0005, 0x9a0011, 0xad0012, 0x93,
+    0x8d, 0x95, 0xae0001, 0x1ad, 0x49, 0xbc0019, 0x1d4, 0xb30012,
+    0x87, 0xc5, 0xb80012, 0xb10005, 0x193, 0xc1000d, 0xb50005, 0xd2,
+    0xb7000e, 0xc8000f, 0x141, 0x214, 0x93, 0xb0000f, 0xba0145, 0xa7,
+    0xa1, 0x42, 0xcf0009, 0xc70001, 0x52, 0xd5000e, 0xe9, 0xca0145,
+    0xc2000f, 0xcd0004, 0xd6000f, 0xe00009, 0xcb0012, 0x193, 0x194, 0xe9,
+    0xcb, 0xd8000f, 0x82, 0x92, 0xe40009, 0xd10005, 0xe2000e, 0xd00005,
+    0x4c, 0xd9, 0xdc0004, 0xe1000f, 0x8d, 0x1ac, 0xd6, 0xdb0010,
+    0x89, 0x18f, 0xae, 0xdf000d, 0xf2006e, 0xe70003, 0x49, 0x125,
+    0xe80012, 0xed0013, 0xb2, 0xfd0001, 0x92, 0x14b, 0xea0015, 0x1000145,
+    0xeb0003, 0xd2, 0xcf, 0x1040009, 0x59, 0x93, 0xef0005, 0x1030007,
+    0xc5, 0xe8, 0x4d, 0x10b0047, 0xc1, 0x241, 0x2e, 0xc1,
+    0xd0, 0x1010014, 0x14e, 0x8f, 0x183, 0x1100001, 0x236, 0x10c0007,
+    0x54, 0x10d0145, 0x1120014, 0xc9, 0xf3000c, 0x1150009, 0x10e000e, 0x1110012,
+    0x1130005, 0x11b0014, 0x1060012, 0x119000f, 0x185, 0xb2, 0xe9, 0x11f000e,
+    0x1160233, 0x1180015, 0x11d0014, 0x11e0012, 0x12d0014, 0x8f, 0x12e00a1, 0x12f0009,
+    0xe2, 0xa5, 0x43, 0xaf, 0x1310144, 0xc4, 0x1230006, 0x12c0014,
+    0x1250001, 0x1240014, 0x83, 0x64, 0x1320014, 0x188, 0x4c, 0x194,
+    0x1400004, 0x13b0001, 0x1370012, 0x1280093, 0x1350014, 0x12b0015, 0x13c0005, 0xcc,
+    0xa5, 0x14d000f, 0x1490009, 0x94, 0x1390009, 0xb4, 0x45, 0x1470005,
+    0x1430014, 0x1530001, 0xce, 0x14a0012, 0x18d, 0x1590005, 0x43, 0x13a0009,
+    0x144000f, 0x15d0009, 0x34, 0x15b000e, 0x101, 0x154, 0x125, 0x15c000f,
+    0x14f0009, 0x146000e, 0x1550001, 0xb4, 0x47, 0x16c0015, 0x157000d, 0x14e0014,
+    0x1610014, 0xb4, 0xc4, 0xd5, 0x1540133, 0x51, 0xd4, 0x15a0013,
+    0x44, 0x1560014, 0x16d0003, 0x1660017, 0x16e0005, 0x185, 0x1700009, 0x148,
+    0x1740149, 0xe6, 0x173000c, 0x1780009, 0x14e, 0xa5, 0x1e7, 0xec,
+    0x1720012, 0x1820001, 0x177000e, 0x1800054, 0x1790002, 0xcc, 0x41, 0x17d0001,
+    0x159, 0x186000e, 0x17b0045, 0xce, 0x85, 0x148, 0x1830149, 0x2c,
+    0x184000d, 0x18b000e, 0x1e7, 0x24f, 0x18a000f, 0x21, 0xcb, 0x1930012,
+    0x194000e, 0xc9, 0x1900050, 0xd3, 0x19b0009, 0x1890002, 0x18c0015, 0x1880015,
+    0xf4, 0x1920005, 0x185, 0x1a8000e, 0x112, 0x90, 0xa1, 0x19d0012,
+    0x1a50013, 0x61, 0x1aa0004, 0x1870003, 0x19c0004, 0x65, 0x1a20005, 0x25,
+    0x1a6000e, 0xa1, 0x1b70012, 0xab, 0x1b00012, 0x1ad0009, 0x45, 0xaf,
+    0xc9, 0x1af000c, 0x28c, 0x2a4, 0x28e, 0x95, 0x1d60002, 0x1ed0003,
+    0x2010364, 0x2080005, 0x2180366, 0x2250007, 0x2310008, 0x2380449, 0x48a, 0x23a000b,
+    0x249000c, 0x264000d, 0x283036e, 0x26f, 0x2d60010, 0x2d90011, 0x2f00572, 0x3340013,
+    0x3520014, 0x38e0015, 0x3a40016, 0x3b10017, 0x3ab0018, 0x3b60019, 0x3b5001a, 0x1ae0001,
+    0x1da0001, 0xa1, 0x1c90001, 0x1a00145, 0x2c2, 0x2b4, 0x1db000c, 0x1d80009,
+    0x2fa, 0x30c, 0x1d9000c, 0x1df000f, 0x1c60009, 0x1d2000f, 0x2a7, 0x294,
+    0x1d40272, 0x2a4, 0x2a2, 0x1d50015, 0x1d70014, 0x1e2000f, 0x1dd0001, 0x1e50332,
+    0x352, 0x27b, 0x1de0005, 0x1d30005, 0x2af, 0x1ee0008, 0x1f50389, 0x295,
+    0x1e8000f, 0x1f60009, 0x3a5, 0x1f90009, 0xa6, 0x30c, 0x3cd, 0x1e90012,
+    0x301, 0x1f00014, 0x1f10015, 0x34e, 0x3af, 0x1f20004, 0x1f70005, 0x3ce,
+    0x3c5, 0x1f30012, 0x21403e9, 0x317, 0x52, 0x203000c, 0x2bb, 0x2040001,
+    0x1f4000f, 0x3d5, 0x2ae, 0x20e0012, 0x1fc0013, 0x3a1, 0x2150275, 0x1ff0003,
+    0x3a3, 0x1fa0005, 0x21203d2, 0x2170009, 0x25, 0x2ac, 0x46, 0x322,
+    0x427, 0x292, 0x2ad, 0x3af, 0x309, 0x3bb, 0x21d0001, 0x21b000e,
+    0x3b4, 0x295, 0x2200005, 0x4e, 0x211000c, 0x2370005, 0x349, 0x4f,
+    0x20f0005, 0x40c, 0x3a1, 0x34e, 0x219036f, 0x275, 0x3a5, 0x2ac,
+    0x2b9, 0x281, 0x22b0015, 0x20a0003, 0x2350009, 0x3cc, 0x339, 0x2390005,
+    0x3af, 0x304, 0xaf, 0xae, 0x21f000c, 0xae, 0x233046e, 0x34e,
+    0x269, 0x2a2, 0x2470001, 0x304, 0x2280014, 0x23f0004, 0x24103e5, 0x23d000e,
+    0x4af, 0x24a0014, 0x2560349, 0x329, 0x2b6, 0x255000c, 0x26d, 0x2420001,
+    0x258000f, 0x332, 0x23e0005, 0x45, 0x263, 0x3db, 0x2590009, 0x2450007,
+    0x29b, 0x4d4, 0x2500019, 0x24d0273, 0x4f4, 0x2650261, 0x2a3, 0x2a2,
+    0xa1, 0x25e0005, 0x43a, 0x33b, 0x307, 0x2770009, 0x333, 0x25b0009,
+    0x2700012, 0x2a1, 0xc9, 0x26e036f, 0x2790010, 0x50f, 0x2b9, 0x2670012,
+    0x2630013, 0x2660014, 0x303, 0x4f, 0x28e, 0x2a6, 0x2710005, 0xae,
+    0x2690012, 0x305, 0x33, 0x25d000c, 0x2880001, 0x26c034e, 0x439, 0x2940264,
+    0x2960005, 0x3a9, 0x29503e7, 0x313, 0x2a20009, 0x303, 0x2a1000b, 0x27c0007,
+    0x2bb, 0x2b0000e, 0x2a6004f, 0x29, 0x26d000c, 0x3d7, 0x2bb0013, 0x2c30014,
+    0x2c20015, 0x26f0005, 0x28a03b2, 0x285, 0x2800014, 0x2780009, 0x29d0009, 0x2750014,
+    0x34c, 0x34c, 0xa5, 0x27e000f, 0x3ae, 0x523, 0x3b3, 0x2930005,
+    0x546, 0x28b0013, 0x3c5, 0x3b5, 0x285, 0x2af000c, 0x289, 0x2a5000d,
+    0x2a7000e, 0x30f, 0x3b0, 0x308, 0x4fa, 0x2ab0013, 0x314, 0x3b5,
+    0x3c9, 0x29a0009, 0x2b302b4, 0xe8, 0x441, 0x3cf, 0x2ae0003, 0x3d2,
+    0x8f, 0x1ec, 0x3c5, 0x301, 0x2b50001, 0x2af, 0x32, 0x2c70321,
+    0x2b4, 0x3ce, 0x2b60012, 0x2b10450, 0x2bd0009, 0x2c10005, 0x30c, 0x3d4,
+    0x2ad0015, 0x269, 0x26f, 0x3b2, 0x292, 0x452, 0x2c6000c, 0x2b40001,
+    0xc3, 0x2b2, 0x3d7, 0x2b80005, 0x301, 0x2a1, 0x2c80008, 0x2d80009,
+    0xc9, 0x2dc000c, 0x36c, 0x194, 0x2ca000c, 0x2d5000f, 0x30e, 0x2d70012,
+    0x2cf0013, 0x2e50013, 0x2da0005, 0x3b5, 0x2db0014, 0xb3, 0x2ea0015, 0xc5,
+    0x3b5, 0x2f80001, 0x3100002, 0x30c0003, 0x30e0004, 0x31a0005, 0x31b0006, 0x314,
+    0x2f60005, 0x3240349, 0x285, 0x2e30003, 0x2f50004, 0x313000d, 0x2f40009, 0x32a000f,
+    0x450, 0x311, 0x32b0012, 0x3330013, 0x30c, 0x2f3000d, 0x309000e, 0x2b3,
+    0x90, 0x285, 0x3040014, 0x3030009, 0x30203d4, 0x295, 0x596, 0x37,
+    0x27, 0x3070001, 0x28f, 0x1ec, 0x3140008, 0x3080001, 0x3ce, 0x30a0009,
+    0x315000e, 0x2b6, 0x2a5, 0x30b0001, 0x449, 0x3170001, 0x2b3, 0x3a5,
+    0x3d2, 0x314, 0x293, 0x323, 0x3c9, 0x31e0001, 0x3b4, 0x3cc,
+    0x30d000e, 0x3120005, 0x2ac, 0x2b4, 0x30e, 0x30f0013, 0x2e4, 0x289,
+    0x25, 0x3cd, 0x31c000e, 0x30f, 0x3c1, 0x3380001, 0x314, 0x29,
+    0x326000e, 0x3af, 0x3c2, 0x448, 0x32e0008, 0x3490009, 0x45a, 0x33c000b,
+    0x3cc, 0x2a8, 0x29b, 0x320000f, 0x3390010, 0x89, 0x322000e, 0x3450013,
+    0x34c0014, 0x33e0015, 0x3270001, 0x3a2, 0x3a3, 0x3c8, 0x30e, 0x27b,
+    0x3510012, 0x3400005, 0xc1, 0x3530361, 0x30c, 0x3480002, 0x2a3, 0x3650005,
+    0x2a8, 0x30f, 0x36a0268, 0x37b0009, 0x30f, 0x5d4, 0x352, 0x34a000c,
+    0x301, 0x379000f, 0x31b, 0x2b0, 0x3740492, 0x37a0013, 0x3830014, 0x38c0375,
+    0x35000a3, 0x281, 0x314, 0x379, 0x34d0007, 0x36800ce, 0xad, 0x3630005,
+    0xad, 0x28e, 0x373000e, 0x347000e, 0x36d0001, 0x315, 0x2ba, 0x35f0012,
+    0x3560013, 0x36103cf, 0x35c0009, 0x2b6, 0x281, 0x2e2, 0x343, 0xf2,
+    0x327, 0x306, 0x2b0, 0x372000f, 0x3800001, 0x3cb, 0x371036d, 0x3c7,
+    0x2a5, 0x330, 0x364000f, 0x3c8, 0x333, 0x2a1, 0x301, 0x3600014,
+    0x3c2, 0x2a5, 0x188, 0xa4, 0x3950009, 0x38a0007, 0x27b, 0x2a2,
+    0x30c, 0x39d0005, 0x5ec, 0x307, 0x38f000e, 0x439, 0x38d0012, 0x315,
+    0x312, 0x38b0013, 0x39e0014, 0x3960005, 0xae, 0x3a00361, 0x348, 0x307,
+    0x39b000e, 0x39a0005, 0x4f, 0x301, 0x3aa0012, 0x3940349, 0x28e, 0x52,
+    0x2a3, 0x3d9, 0x3840001, 0x3ad000f, 0x3b20009, 0x3c3, 0x3c4, 0x3b00001,
+    0x2ae, 0x3ae0005, 0x309, 0x45, 0x2ac, 0x398000c, 0x3b40009, 0x492,
+    0x52, 0xa9, 0x3c00007, 0x2b9, 0x53, 0x3b90005, 0x3c5, 0x61,
+    0x3c30001, 0x53, 0xa7, 0xb2, 0x3d40002, 0x3e00001, 0x3ec0622, 0x3b8001a,
+    0x644, 0x3f80005, 0x3e6, 0x3e50009, 0x6c8, 0x4180009, 0x48a, 0x3cb,
+    0x42f076c, 0x64d, 0x43806ce, 0x441000f, 0x270, 0xe9, 0x4530012, 0x43d07d3,
+    0x45703f4, 0x4610015, 0x496, 0x7f7, 0x3bb0004, 0x46b0019, 0x21, 0x3c10007,
+    0x3c70004, 0x45, 0x3e20013, 0x49, 0x3c6000c, 0x89, 0x3e4000e, 0x3b2,
+    0x41, 0x3dd0365, 0x3ca0012, 0x3d70013, 0x614, 0x3e80009, 0x3ef000e, 0x309,
+    0x2b, 0x3ed0001, 0x3da, 0x4fb, 0x4090664, 0x3f70009, 0x2a7, 0x3ee0007,
+    0xba, 0x194, 0x349, 0x2b5, 0x3f9060c, 0x68d, 0x3f4000e, 0x2b2,
+    0x30f, 0x2b5, 0x301, 0x40006b3, 0x4040434, 0x3e60009, 0x305, 0x317,
+    0x310, 0x4060019, 0x309, 0x27b, 0x3f50014, 0x2af, 0x2b2, 0x3fe0009,
+    0x31a, 0x712, 0x442, 0x317, 0x3c4, 0x4110425, 0x6e6, 0x2ae,
+    0x2b4, 0x4100007, 0x312, 0x3d2, 0x40e060c, 0x4070001, 0x424000e, 0x41a000f,
+    0x44, 0x40c0005, 0x41c0009, 0x72f, 0x4210454, 0x741, 0xe8, 0x2b5,
+    0x41d0001, 0x4260014, 0x4f0, 0x312, 0x4270005, 0x2e, 0x42c0015, 0x34,
+    0x4290009, 0x423000e, 0x4220013, 0x29a, 0x3b3, 0x4390005, 0x32f, 0x89,
+    0xa7, 0x83, 0x33b, 0x43e0009, 0x42b0015, 0x4360424, 0x3c5, 0x43f0002,
+    0x49, 0x4370041, 0x281, 0xb4, 0x44b000f, 0x43a000c, 0x445000d, 0x448000e,
+    0x42f, 0xc8, 0x455000e, 0x4560012, 0x793, 0x4490014, 0x4440015, 0x641,
+    0x3cf, 0x1a4, 0xa4, 0x4e5, 0x44a0009, 0x32, 0x274, 0x4e9,
+    0x4590014, 0x1a8, 0x44c000f, 0x3cc, 0x4600006, 0x4580005, 0x32f, 0x45e0006,
+    0x46a0007, 0x3b2, 0x52, 0x3c1, 0x309, 0x463000c, 0x467000d, 0x46203ce,
+    0x29, 0x4fb, 0x29, 0x4720012, 0x46f0013, 0x47b0014, 0x4690014, 0x305,
+    0x4740009, 0xa5, 0x25, 0x42f, 0x261, 0x59, 0x53, 0x8e,
+    0x28, 0x4800005, 0x4750013, 0x4f4, 0x46c0009, 0x4980601, 0x4fb, 0x4bf03a3,
+    0x4710009, 0x4cc0005, 0x28f, 0x34c, 0x4ea03e8, 0x5090609, 0x2ae, 0x527034b,
+    0x53108ec, 0x314, 0x28e, 0x540060f, 0xce, 0x491, 0x5660012, 0x933,
+    0x5830634, 0x5890015, 0x47f0002, 0x4780003, 0x47c0004, 0x619, 0x5a9001a, 0x6a7,
+    0x808, 0x41, 0x47d0001, 0x4950005, 0x4a1000c, 0x43, 0x4ad000e, 0x2b2,
+    0x49e0010, 0x4860009, 0x4a40012, 0x4a50013, 0x4b70014, 0x4a0000c, 0x4b90016, 0xd2,
+    0x26f, 0xa4, 0x45, 0x4a7000f, 0xad, 0xb3, 0x4a20009, 0x49d0005,
+    0xa7, 0x4b20014, 0x4b80001, 0x4b10009, 0x9a, 0xc1, 0x279, 0x3c8,
+    0x4ac0009, 0x4640014, 0x276, 0x41, 0xac, 0x4c80010, 0x39, 0x4bc0008,
+    0x4c20009, 0x101, 0x4b5000d, 0x2e, 0x4c30005, 0x2ad, 0x4bd000f, 0x194,
+    0x4c70004, 0x26e, 0x4bb0015, 0x4c00001, 0x4df0429, 0x429, 0x42c, 0x423,
+    0x4ca000c, 0x825, 0x4d4060e, 0x261, 0x430, 0x269, 0x4d20012, 0x4da0013,
+    0x4e30054, 0x1c2, 0x27b, 0x57, 0x841, 0x4fb, 0x862, 0x3fb,
+    0x434, 0x4e70009, 0x4e3, 0x4e40001, 0x1b0, 0x4cb0013, 0xb4, 0x4f40145,
+    0xaf, 0x429, 0x4e0000e, 0x4f90009, 0x2a5, 0x4dc0001, 0x3c9, 0x4f00005,
+    0x264, 0x8af, 0x2f3, 0x4e9, 0x313, 0x272, 0x4ed0014, 0x2b3,
+    0x4e1000c, 0x4e8000d, 0x4ef000e, 0x4ec0013, 0x31b, 0x27b, 0x4e90012, 0x4f2088e,
+    0x4ef, 0x5110009, 0x50e0421, 0x4fb, 0x2a3, 0x434, 0x4eb0005, 0x5000006,
+    0x8c2, 0x4fb, 0x269, 0x15a, 0x4f60003, 0x519000c, 0x3ed, 0x51a03ee,
+    0x51c000f, 0x5230010, 0x3c1, 0x50a0321, 0x5130013, 0x5250634, 0x434, 0x5170005,
+    0xb2, 0x50b0487, 0x429, 0x4fa, 0x8d, 0x263, 0x29b, 0x52c0014,
+    0x265, 0x4ef, 0x2e, 0x308, 0x5220009, 0x261, 0x5150009, 0x9a,
+    0x309, 0x5320272, 0x51f0001, 0x5200001, 0x52f0014, 0x269, 0x52e0005, 0x4e5,
+    0x52a0009, 0x28f, 0x5390009, 0x4d, 0x263, 0x2a7, 0x53d000e, 0x3d2,
+    0x303, 0x5360001, 0x83, 0x5460005, 0x4e3, 0x145, 0x2d, 0x52d03e7,
+    0x18e, 0x5300049, 0x59, 0xa9, 0x542000c, 0x53e000d, 0x558000e, 0x262,
+    0x55a0010, 0x54304ef, 0x54d0012, 0x54f0013, 0x45, 0x92, 0x5590076, 0x55f0017,
+    0xb2, 0x41, 0x55c001a, 0x301, 0x53a000f, 0x325, 0x25, 0x87,
+    0xa1, 0xa5, 0xd4, 0x53f0009, 0x5410009, 0x2a9, 0x3cc, 0x5550001,
+    0x54e0013, 0x55b0014, 0x55d0001, 0x5690005, 0xb4, 0x4e4, 0x6c1, 0x56e0149,
+    0x4e9, 0x94, 0x3b2, 0x44, 0xa6, 0x570000f, 0x4fb, 0x4c,
+    0x25, 0x42, 0xcf, 0x56f0015, 0x32e, 0x56d0014, 0x189, 0x56,
+    0x56b0010, 0x33, 0x5670014, 0x5730013, 0x5770001, 0x57f000e, 0x2a7, 0x5740003,
+    0x5600365, 0x335, 0x52, 0x2b9, 0x5840009, 0xa4, 0x5720014, 0x326,
+    0x53, 0x575000d, 0x57a0329, 0x294, 0x4e9, 0x58b000c, 0x59f000d, 0x42e,
+    0x5780015, 0x5980010, 0x337, 0x5a20012, 0x5930613, 0x5a30974, 0x57d0009, 0x5950014,
+    0x441, 0x309, 0x942, 0x5a00001, 0x3a5, 0x2a1, 0x59e0013, 0x29,
+    0x3c9, 0x28, 0x435, 0x5a40009, 0x5a80009, 0x3c5, 0x45, 0x276,
+    0x5990009, 0x2b9, 0x87, 0xa5, 0x3ce, 0x272, 0x26f, 0xc6,
+    0x1ee, 0xb4, 0x2ad, 0x3cc, 0x2a6, 0xe6, 0x7f6, 0x5d60981,
+    0x482, 0x283, 0xa04, 0x5f10005, 0x646, 0x6230007, 0xa68, 0x62f0009,
+    0x48a, 0x7ab, 0x64a000c, 0x48d, 0xb2e, 0x661060f, 0x490, 0x27b,
+    0x6790612, 0x6740b53, 0x6780014, 0x68e0615, 0x496, 0x497, 0xbb, 0x68f0379,
+    0x9c2, 0x5a10003, 0x5a50009, 0xc4, 0x266, 0x3e7, 0x3d3, 0x5aa0001,
+    0x5a6000f, 0x3d2, 0xcb, 0x9ed, 0x5ab000e, 0x5f70009, 0x5b70009, 0x5af0009,
+    0x5d70012, 0x5df0009, 0x5a70434, 0x2af, 0x5ae0796, 0x5ad000f, 0x5bb0423, 0x4f9,
+    0x279, 0x4fb, 0x5b10001, 0x5d10002, 0x5de0003, 0x624, 0x5b40005, 0x2ac,
+    0x44f, 0xda, 0x5b60009, 0x5f40009, 0x25, 0x5dc000c, 0x600032d, 0x605060e,
+    0x8c, 0x60a0350, 0x3b1, 0x60f0012, 0x6120153, 0x5e90354, 0x5cf0001, 0x5f20356,
+    0xa31, 0x5eb0009, 0x279, 0x301, 0x3fb, 0x5cb000e, 0xa54, 0x5ff000f,
+    0xa2, 0xf2, 0x60b0001, 0x29, 0x30f, 0x343, 0x325, 0x328,
+    0x3cd, 0x5dd0014, 0x315, 0x4fb, 0x4ed, 0x5e0000e, 0xace, 0x455,
+    0x89, 0x8cf, 0xb3, 0x305, 0x321, 0x434, 0x6170014, 0x3d5,
+    0x5fa0005, 0x312, 0x61a0001, 0x3cf, 0x349, 0x37b, 0x61c0014, 0x43b,
+    0x60e0aa1, 0xa7, 0x6110003, 0x424, 0x6100005, 0x486, 0x61e0007, 0x2ba,
+    0x3cc, 0xc9, 0x345, 0x629000c, 0x379, 0x63f048e, 0x62a060f, 0x62c0010,
+    0x601, 0x6350152, 0x63d0073, 0x63e0014, 0x6140005, 0xb16, 0x4e9, 0x369,
+    0x61d04e9, 0x6300014, 0x4fb, 0x7e1, 0x273, 0x424, 0x2b2, 0x6490005,
+    0x2a5, 0xaf4, 0x3c1, 0x84, 0x43b, 0x6410009, 0x6430001, 0x314,
+    0x50, 0x6ef, 0x29, 0xba, 0x6390013, 0x654000f, 0x29, 0x7f5,
+    0x63c000f, 0x7f4, 0xce, 0x3f9, 0x43b, 0x64b0004, 0x4e5, 0x806,
+    0x327, 0x64e0007, 0xd2, 0x269, 0x6690010, 0x651000c, 0x64c000d, 0x655000e,
+    0x64f000f, 0x6480010, 0x6580001, 0x332, 0x433, 0x66f000c, 0x64d0015, 0x3d6,
+    0x4e9, 0x438, 0x6620001, 0x3a5, 0x43b, 0x42, 0x6710045, 0x4ee,
+    0x368, 0x481, 0x67b0009, 0x50, 0x3d0, 0x6770005, 0x2ac, 0x2c,
+    0x673000f, 0xb2, 0x277, 0x337, 0x6910002, 0x339, 0x65c0015, 0xb61,
+    0x273, 0x6800443, 0x279, 0x67a0005, 0x67d0014, 0x3c7, 0x45, 0x3c5,
+    0x27b, 0x3c5, 0x676000c, 0x68a000d, 0x3ce, 0x4ee, 0x6920270, 0x3b4,
+    0x69c0009, 0xa5, 0x6940013, 0x6af03c5, 0xb0, 0x6bc0001, 0x6e10622, 0x6f10003,
+    0x7210004, 0x7350005, 0x7370486, 0x75a0007, 0x7610a08, 0x76a0449, 0x766048a, 0x77a000b,
+    0x786000c, 0x7c3000d, 0x7e6000e, 0x81b000f, 0x8300010, 0x83e0491, 0x8560012, 0x8a20013,
+    0x8f10014, 0x9060275, 0x91c0016, 0x9320017, 0x9240018, 0x93a0019, 0xa02, 0x68b0003,
+    0x6970064, 0x2b2, 0x6b20005, 0x69e0007, 0xb2, 0x95, 0x6b50005, 0x92,
+    0x6bd03cc, 0x6c1000d, 0x6c7000e, 0x284, 0x6b0000f, 0xb3, 0x6d00012, 0x6cc0013,
+    0x6d90454, 0x81, 0x6de0456, 0x43, 0x43, 0x6ba0005, 0xae, 0x185,
+    0x189, 0x6d10009, 0x286, 0xab, 0x2b0, 0x4c, 0x6c80005, 0x3b3,
+    0x194, 0x6cf0008, 0x6d40009, 0x6d70005, 0x6d20154, 0x8e, 0x6dd0005, 0xa9,
+    0x333, 0x6d5000c, 0x6d80009, 0x32e, 0x334, 0xaf, 0xa95, 0x324,
+    0x33b, 0xc3, 0x6eb0001, 0x3b2, 0x6f40003, 0xc1, 0x6e40485, 0x6e50013,
+    0x6fa0013, 0x6ee000e, 0x6fc0449, 0x2a1, 0x7050009, 0x706000c, 0x322, 0x6ed0001,
+    0x707000f, 0x2b4, 0x6f30006, 0x7120492, 0x285, 0x7190014, 0x7110495, 0x7000001,
+    0x6fe0003, 0x30d, 0x2a5, 0x333, 0x2b9, 0x32d, 0x32d, 0x325,
+    0x6ff0054, 0x70a0010, 0x323, 0x36c, 0x701000d, 0x70f000e, 0x301, 0x70b0005,
+    0x32d, 0x7150372, 0x70e0001, 0x6f80015, 0x3ce, 0x71e032c, 0x3c5, 0x301,
+    0x301, 0x329, 0x561, 0x725032c, 0xaf, 0x864, 0x7160005, 0x3c1,
+    0x532, 0x53, 0x72a0269, 0x3a1, 0x302, 0x71f0003, 0x34, 0x32c,
+    0x723026f, 0x12e, 0x89, 0x7180012, 0x2af, 0x3d9, 0x7170015, 0x30d,
+    0x443, 0x7290004, 0x89, 0x446, 0x72d0005, 0x606, 0x354, 0x7420012,
+    0x7480009, 0x731000c, 0x44d, 0x726000e, 0xba, 0xb90, 0x740000f, 0xa85,
+    0x71a0bb3, 0x71c0014, 0x3d9, 0x7450323, 0x7460015, 0x298, 0x4e9, 0x3a5,
+    0x74c0014, 0x2e5, 0x7500012, 0x73c0009, 0x2c, 0x7440005, 0x74a000e, 0xd3,
+    0x73f0005, 0x7530013, 0x33b, 0x7510001, 0x434, 0x26c, 0x2a7, 0x74e0005,
+    0x32, 0x34c, 0x333, 0x7620009, 0x2a2, 0x3c3, 0x7590005, 0x292,
+    0x2ae, 0x74f000f, 0x33b, 0x32, 0x2ac, 0x283, 0x2a4, 0x7550015,
+    0x757000e, 0x7600147, 0x3a2, 0x4f9, 0x3a6, 0x487, 0xbd4, 0x770000d,
+    0x76e000e, 0x294, 0x44, 0x77b0015, 0x7760012, 0x85, 0x7780014, 0x7790324,
+    0x308, 0x7650013, 0x2a9, 0x7770009, 0x3c1, 0x4e, 0x783000c, 0x78a0481,
+    0x24, 0x7740009, 0x2b6, 0x7a50005, 0x446, 0x323, 0x1e1, 0x7ad0449,
+    0x7920012, 0x299, 0x7aa000c, 0x2a1, 0x301, 0x7ba000f, 0x3a5, 0x301,
+    0x784000e, 0x7a60013, 0x7ac0014, 0x7bb0015, 0x2a2, 0x3b2, 0x7800014, 0xa87,
+    0x79a0009, 0x337, 0x78d0018, 0x2a8, 0x3c2, 0x33b, 0x3a1, 0x77e0002,
+    0x4e3, 0x324, 0x31b, 0x7a20261, 0x7930007, 0x3c1, 0x448, 0x7910002,
+    0x7960003, 0x51b, 0x78b0005, 0x28e, 0x7970007, 0x2a1, 0x301, 0x532,
+    0x493, 0x2f, 0x28d, 0x798000e, 0x3af, 0x283, 0x36c, 0x284,
+    0x79b0373, 0x2a7, 0x2a7, 0xbf6, 0x7c60001, 0x2a2, 0x334, 0x7c40009,
+    0x7b20485, 0x323, 0x78f0010, 0x7cd0012, 0x7d20009, 0x327, 0x2a1, 0xef,
+    0x2a8, 0x7be000e, 0x7d6000f, 0x7d90010, 0x7b4028e, 0x7b50003, 0x2a5, 0x45,
+    0x7da0015, 0x7b90007, 0x549, 0x293, 0x3b9, 0x47, 0x4fa, 0x2a1,
+    0x7d10c0e, 0x7c00009, 0x309, 0x2af, 0x7d8000e, 0x7c80333, 0x7de032c, 0x7e00001,
+    0x8e, 0x7e90003, 0x7ee0004, 0x7f70005, 0x31a, 0x7d4000d, 0x7dc000e, 0x8000009,
+    0x334, 0x7ed0008, 0x7e10005, 0x32, 0x26e, 0x809026f, 0x303, 0x7f30009,
+    0x281, 0x7fb0013, 0x8100014, 0x8180015, 0x285, 0x2a9, 0x2af, 0x8050019,
+    0x87a, 0x308, 0x312, 0x7fa0003, 0x30d, 0x285, 0x8020007, 0xa5,
+    0x2b4, 0x7ef0012, 0x7f40013, 0x7f00014, 0x28c, 0x2b3, 0x3b7, 0x3af,
+    0x47, 0x7ff0001, 0x3d7, 0x7f90013, 0x314, 0x295, 0x8040005, 0x273,
+    0x8110008, 0x301, 0x4fa, 0x80b0001, 0x333, 0x92, 0x2a6, 0x316,
+    0x3bb, 0x286, 0x447, 0x2ac, 0xc29, 0x3cf, 0x294, 0x3ac,
+    0x2a3, 0x305, 0x8230009, 0x81a0010, 0x2af, 0x8240492, 0x53, 0x8160334,
+    0x8120015, 0x82b0361, 0x297, 0x817000f, 0x3a9, 0x8320005, 0x3b4, 0x8310014,
+    0x8360008, 0x825000e, 0x81d0009, 0x25, 0x834000c, 0x329, 0x28c, 0x48f,
+    0x822000e, 0x8440005, 0x83c0012, 0x8420013, 0x8450014, 0x83d0015, 0x8210014, 0x8480323,
+    0x324, 0x2a1, 0x3c8, 0x84b03af, 0x308, 0x322, 0x84d0009, 0x2c2,
+    0x2a1, 0x84f0334, 0x84a0009, 0x8490015, 0x264, 0x83f0009, 0x18c, 0x85a0341,
+    0x85403e2, 0x8590003, 0x27b, 0x86e0005, 0x42, 0xc73, 0x348, 0x8830349,
+    0x3cc, 0x85d0308, 0x3c5, 0xcad, 0x884000e, 0x88d03ef, 0xaf, 0x3ac,
+    0x850000e, 0x8800353, 0x8910014, 0x8860275, 0x312, 0x89b0017, 0x84c0014, 0x85b0001,
+    0x8e, 0x8570003, 0x30f, 0x2bb, 0x2a1, 0x2a5, 0x8700003, 0x8620009,
+    0x265, 0x305, 0x858000c, 0x863000d, 0x873000e, 0x2b3, 0x314, 0x51,
+    0x4eb, 0x86a0013, 0x34, 0x321, 0xc81, 0x8770005, 0x8750003, 0x314,
+    0x87c0005, 0x3fb, 0x3ae, 0x314, 0x92, 0x8810009, 0x52, 0x2a2,
+    0x283, 0x874000e, 0x48f, 0x30f, 0x3d3, 0x274, 0x87a0005, 0x274,
+    0x3d5, 0x8820056, 0x54, 0x4fa, 0x8890001, 0x26c, 0x4f5, 0x52,
+    0x89c0007, 0x8930005, 0x355, 0x8990a01, 0x2ae, 0x8a80443, 0x333, 0x8ad0a65,
+    0x317, 0x8960361, 0x8c00268, 0x8c30489, 0x2b2, 0x8c4000b, 0x33b, 0x8c5000d,
+    0x89a0363, 0x8c7000f, 0x8d20490, 0x2a3, 0x333, 0x8d603f3, 0x8df0014, 0x8d90015,
+    0x321, 0x3d7, 0x3b2, 0x8b0000e, 0x33b, 0x2b5, 0x8a10014, 0x8aa0012,
+    0x8b70016, 0x3a1, 0xae, 0x8b60005, 0x2ae, 0x8b40005, 0x363, 0x8be0364,
+    0x8c8000e, 0x2a1, 0x8ba0007, 0x25, 0x8c60014, 0x8c10009, 0x3c9, 0x28e,
+    0xccd, 0xcee, 0x315, 0x8bd036c, 0x2a1, 0x8d3036e, 0x8b80013, 0x8ca0005,
+    0x55, 0x2a1, 0x3c5, 0x8cb0009, 0x312, 0x8d80012, 0xd02, 0x8dc0009,
+    0x8d40001, 0x307, 0x1ee, 0x103, 0x8d50012, 0x3ae, 0x42, 0x2ad,
+    0x8da0009, 0x24, 0x28f, 0x8dd0372, 0x8e5000e, 0x3af, 0x8d7066f, 0x2b2,
+    0x8e00015, 0x8db03f2, 0x8e40001, 0x1a4, 0x8ec0009, 0x8ef000f, 0x8de0005, 0x285,
+    0x4f, 0x8e60008, 0x8fa0009, 0x28f, 0x900000e, 0x343, 0x8f20004, 0x26e,
+    0x8ee000f, 0x2a1, 0x2b6, 0x9040012, 0x303, 0x3a1, 0x90f0015, 0x2a6,
+    0x8e9002e, 0x3a5, 0x9050019, 0x2ba, 0x292, 0x9010009, 0x8eb0014, 0x307,
+    0x301, 0x30f, 0x2ad, 0x908000f, 0x28e, 0xcc, 0x3b0, 0x2b4,
+    0x9020012, 0x53, 0x9170014, 0x2b3, 0x25, 0x9130001, 0x283, 0x281,
+    0x9090009, 0x91e0005, 0x282, 0xd30, 0x30c, 0x92a0489, 0x9030373, 0x18f,
+    0x327, 0x2b2, 0x918000c, 0x91b000f, 0x926000e, 0x287, 0x304, 0x29,
+    0x9200352, 0x295, 0x285, 0x9210481, 0x610, 0x307, 0x4c, 0x92d0005,
+    0x32e, 0x3c5, 0x3a8, 0x9300009, 0xcc, 0x4e3, 0x92e000e, 0x9270005,
+    0x56, 0x2e, 0x4fb, 0x30c, 0x3b4, 0x941000c, 0xc5, 0x95a0601,
+    0x7e2, 0x92, 0x264, 0x9700005, 0x97b0646, 0x53, 0x268, 0x98f0609,
+    0xb3, 0xa8, 0x9aa0d6c, 0x26d, 0x26e, 0x9ac060f, 0x7f0, 0x9490014,
+    0x9c50012, 0x6f3, 0x9c303f4, 0x9cc0435, 0x9370002, 0x9340003, 0x305, 0x619,
+    0x401, 0x267, 0x301, 0x9330009, 0x951000c, 0xf4, 0x939000c, 0x95f000d,
+    0x93d0009, 0x9590008, 0x33, 0x9650014, 0x94304f2, 0x1a8, 0x9610014, 0x9580015,
+    0x26f, 0x9570001, 0x3c2, 0x9740003, 0x3e4, 0x261, 0x309, 0x3cf,
+    0xc5, 0x9730144, 0x333, 0x4f2, 0x96d000c, 0x968000d, 0x975000e, 0x29b,
+    0x9670005, 0x325, 0x9690072, 0x339, 0x97c0009, 0x98c0001, 0x56, 0x96a000c,
+    0x4f4, 0x9830005, 0x964000e, 0x27b, 0x265, 0x9a00049, 0x9900005, 0xcd3,
+    0x301, 0x3ae, 0x9840003, 0x9890004, 0x379, 0x312, 0x9960007, 0x273,
+    0x6cc, 0x315, 0x3ae, 0x99b000c, 0x2ac, 0x9a703ee, 0x9920008, 0x6fb,
+    0x9870014, 0x4e1, 0x9950013, 0x99c0009, 0xa9, 0x4e5, 0xf4, 0x99a000c,
+    0x4e1, 0x9a40014, 0xce, 0xd24, 0x445, 0x49, 0xd47, 0x99d0005,
+    0x99e0013, 0x293, 0x85, 0x9a80009, 0x279, 0x4e, 0x2e, 0x9ad0012,
+    0x9b60004, 0x9a5000f, 0x9b404ee, 0x45, 0x9a90001, 0x2b4, 0x9bb0452, 0xb3,
+    0x9b10005, 0xc1, 0xb9, 0xd99, 0x49, 0xd4, 0x9b30001, 0x54,
+    0x54, 0x281, 0x9c80005, 0x2c, 0xc3, 0xcc, 0x9bf0149, 0x9c00014,
+    0x2ac, 0x9c40005, 0x32f, 0x267, 0x9c1000f, 0x3ce, 0x9c70009, 0x2a5,
+    0x309, 0x9cd000d, 0x9d2000e, 0x9c90013, 0x379, 0x29, 0x9cf0012, 0x9d40013,
+    0x9e00014, 0x261, 0x9f10601, 0x3a2, 0x2b4, 0x3c4, 0xa0a0005, 0x53,
+    0xa220da7, 0xa230008, 0xa330009, 0xc1, 0x94e, 0xa50044c, 0xa3e048d, 0xa57000e,
+    0xa63060f, 0x3b0, 0x9d00005, 0xa770612, 0xa800453, 0xa860014, 0xa950015, 0x46,
+    0x3b7, 0x33, 0xa8b0619, 0x429, 0x28f, 0x9f2000c, 0x9ed03ed, 0x9f7000e,
+    0x9ef0009, 0x30f, 0xb3, 0x9de0012, 0x9e60013, 0x9ff0014, 0x26f, 0x188,
+    0x9f40009, 0x9ea031a, 0x276, 0x27a, 0x3d4, 0x4fb, 0x3e4, 0x9f60005,
+    0x3a, 0xa0c0009, 0x30d, 0x2ba, 0x339, 0x3b2, 0xa08000c, 0x4e9,
+    0xa1a060e, 0xa05060f, 0x4e, 0x9f80001, 0x9fb0012, 0xa0e0013, 0xa1c0014, 0x2b3,
+    0x3d6, 0x279, 0xd5, 0x9f90009, 0xc8, 0x3fb, 0x2ba, 0xa030365,
+    0xa160015, 0x26f, 0x2b4, 0x26f, 0xa1f0009, 0x30e, 0xa0d000c, 0x3cf,
+    0xb2, 0x4f, 0xa13000f, 0x279, 0xa1e0dc1, 0x3d9, 0xa340483, 0xa200014,
+    0xa390005, 0x4e1, 0xa2d0005, 0x3ae, 0x4fb, 0xa380009, 0xa3f0007, 0x4c,
+    0xa35000d, 0xa37000e, 0x4ef, 0x32f, 0xa5, 0xa430432, 0xa440013, 0xce,
+    0x3d5, 0x4f6, 0xdf3, 0xa4a0004, 0xa210013, 0x43a, 0x4fb, 0x4c,
+    0x3ac, 0xa470041, 0x97b, 0xc9, 0x92, 0x605, 0x42, 0x339,
+    0xa4603c1, 0xa540009, 0x4f3, 0x3a7, 0xa490005, 0xa4e0014, 0x313, 0xa42042f,
+    0xa550489, 0x33b, 0x34, 0x36e, 0x32f, 0xa2, 0xa59048f, 0x32e,
+    0x4e5, 0xef, 0xe07, 0xe41, 0xa4b0009, 0x2ba, 0xa5a0004, 0x261,
+    0xb5, 0xa6a014e, 0x4ef, 0x309, 0xa530009, 0xa6b0012, 0xa5c0013, 0x4fb,
+    0xa790001, 0x76, 0xa5b000f, 0xa7a0008, 0xa7c0005, 0xa6e0004, 0x43b, 0xa6f0005,
+    0xa7d0009, 0x292, 0x329, 0xa810009, 0x4e3, 0xa6d0013, 0x32f, 0x12e,
+    0x27b, 0xa730010, 0x4e, 0x26, 0xa850015, 0x285, 0x88, 0xa720013,
+    0xa930012, 0x274, 0x279, 0x279, 0xa880014, 0x4fb, 0xa7e03c1, 0x424,
+    0xe74, 0xeae, 0x3e5, 0x2a1, 0xa4c, 0xa9a0012, 0xa840009, 0x28,
+    0xaa20301, 0x295, 0x4fb, 0x42e, 0xd2, 0x4d, 0xabd0001, 0x482,
+    0x433, 0x414, 0xae80005, 0x486, 0x54, 0x488, 0xb100009, 0x18d,
+    0x26b, 0xb2b0b2c, 0xb2c064d, 0x62e, 0xb2f000f, 0x7f0, 0x49, 0xb520412,
+    0xb580db3, 0xb620014, 0xb5f0015, 0xa920005, 0xb6e0497, 0xeda, 0xb690019, 0xa900002,
+    0xa970003, 0x45, 0xa980005, 0x30e, 0xa8c0007, 0xcf, 0x59, 0xce,
+    0x2b3, 0xa9f000c, 0x3cd, 0xad1000e, 0x185, 0xac20010, 0x8c, 0xada0012,
+    0xacd0013, 0x45, 0xad30015, 0xab90005, 0xaad0003, 0xa870004, 0xb4, 0xade04fa,
+    0xab60047, 0xacb0005, 0xaa30009, 0xab50001, 0x4b, 0xb2, 0xac70144, 0x81,
+    0xb3, 0x2e, 0xad90001, 0x604, 0x2cf, 0xabc0014, 0xacc000c, 0x3ce,
+    0x50, 0xadf0001, 0xace0010, 0xae10003, 0xad50324, 0x294, 0xad40014, 0xadd0009,
+    0x53, 0x432, 0xae50021, 0x190, 0xaf5000c, 0xad8000d, 0xaf1044e, 0xaee000f,
+    0xb0, 0xb4, 0xb010012, 0xaf90493, 0xb0503d4, 0x55, 0xca9, 0x59,
+    0xb2, 0xae6000c, 0xae30321, 0xb040002, 0x28f, 0x41, 0xb060005, 0xc1,
+    0x295, 0x8d0, 0xb070005, 0x44, 0x2ae, 0xb020005, 0x3cf, 0x3ae,
+    0xaf3000f, 0xafe0001, 0xc8, 0xaff0003, 0x1f2, 0x321, 0x25, 0xb0a0007,
+    0x8c, 0xb11000e, 0x3b9, 0xb220008, 0xeec, 0xb08000d, 0xb14000e, 0xb0b000f,
+    0x3d0, 0xb0c0005, 0xb190012, 0xb1c0013, 0xb130014, 0x4c, 0x456, 0xb180005,
+    0x30f, 0x50, 0xd2, 0x52, 0xb1f0001, 0x2e, 0x89, 0x53,
+    0xb250012, 0xb200005, 0x25, 0xb300004, 0x34, 0x29a, 0xb2d03c7, 0x41,
+    0xb2, 0xb1b0009, 0xb1e036f, 0xb45000c, 0xb3a000d, 0xb36000e, 0xb43000f, 0x45,
+    0x185, 0xb470012, 0xb480013, 0x293, 0xb3f0015, 0xb500016, 0xb260001, 0x424,
+    0xb370001, 0x3cf, 0xf05, 0xb4, 0x2b3, 0xb400045, 0x2ae, 0x2b9,
+    0xb390009, 0x2e, 0xb4e0613, 0x1a5, 0x3cf, 0xb4a0005, 0xac, 0xb540005,
+    0x70, 0xc5, 0xb440009, 0xb3b0014, 0x2b5, 0xb51000e, 0xba, 0xb530010,
+    0x328, 0xb4f000f, 0x8f, 0xb560001, 0xb5d0009, 0x34e, 0x3c7, 0xb570005,
+    0x332, 0xa5, 0x2b3, 0x3ce, 0xb5b000d, 0xb63000e, 0xb64000b, 0xb660001,
+    0xf34, 0xb610005, 0xb5c0013, 0x3d4, 0x334, 0xb710014, 0xa5, 0x54,
+    0xb600012, 0xb750010, 0x305, 0x339, 0x453, 0x308, 0xb8c0621, 0xba20002,
+    0xbbc0003, 0xbde03e4, 0xbf40f65, 0xc080006, 0xc1603e7, 0x3a8, 0xfa9, 0x3aa,
+    0x26b, 0xc2e000c, 0xc4b000d, 0xc65000e, 0xc9b03ef, 0xcb703f0, 0xcae0011, 0xccc0272,
+    0xce80013, 0xd1e0014, 0x495, 0xd4403f6, 0x7f7, 0xd3c0018, 0x279, 0xd5a001a,
+    0x36c, 0xb6c004d, 0xb98036e, 0x263, 0xb990010, 0x33, 0x2a5, 0xb8a0013,
+    0xb9b0014, 0x89, 0x3c3, 0x336, 0xb8d0009, 0xb9f0009, 0xba70012, 0xb940045,
+    0x301, 0x2a1, 0x2a5, 0xba80009, 0x6b4, 0xb9c0012, 0xba6048c, 0x309,
+    0x335, 0x28f, 0xcc9, 0x35, 0xba90492, 0x321, 0x30e, 0xbaa0015,
+    0x28e, 0x2a1, 0x26f, 0x2b4, 0xba50014, 0xbba0001, 0x301, 0xb9e0003,
+    0x2bb, 0xbab0005, 0xcc3, 0x4e1, 0x268, 0xbce03e9, 0x339, 0x26d,
+    0xbad000c, 0x3c5, 0x4f0, 0xbbf000f, 0xbb40272, 0xd3, 0xbc20652, 0x33b,
+    0xbc40014, 0xbcb0015, 0x284, 0x339, 0xf41, 0x301, 0xbda0001, 0xbd4000c,
+    0x3cd, 0xbd30135, 0x2af, 0x339, 0xbb8000e, 0x3b2, 0xbbd0370, 0xbd70001,
+    0x329, 0xb5, 0x2a4, 0xbd50005, 0x2a3, 0xbe1000e, 0x8c, 0xbea0369,
+    0x53, 0x3a5, 0xbe4000c, 0xbe00001, 0x32d, 0xbdf000f, 0x2ae, 0x285,
+    0x332, 0x2af, 0x52, 0xbe20375, 0x45, 0x184, 0x317, 0xf81,
+    0xbef0004, 0xbcc030f, 0x3a3, 0xbf60007, 0x3a9, 0x941, 0x354, 0x2b5,
+    0xbf1000c, 0x45, 0xbfc000e, 0x49b, 0xbfa0012, 0xbfe0005, 0xbe80012, 0xbf70013,
+    0x3b4, 0x2af, 0x28e, 0x494, 0xae, 0xbf20005, 0xc000006, 0xa2,
+    0xbf30014, 0xc100009, 0x3d2, 0xbfb0003, 0x3ac, 0x3a5, 0x27b, 0xc0d0001,
+    0xc180012, 0x301, 0x189, 0xc060005, 0x274, 0xc110014, 0xc090008, 0xc1e0269,
+    0x3a2, 0x285, 0x46c, 0x27b, 0x312, 0xc12036f, 0x2b4, 0x325,
+    0xc1c0012, 0xa1, 0x30c, 0xc240015, 0x30e, 0xa9, 0xca2, 0xc2c0481,
+    0xc220004, 0x3d4, 0x314, 0xc340005, 0x2a6, 0xa2, 0x352, 0xc3e0349,
+    0xc330001, 0xccd, 0xc37000c, 0x3a7, 0x26e, 0xc30000f, 0xc280012, 0x301,
+    0x442, 0x311, 0xc2f0014, 0xc350015, 0x316, 0x305, 0x352, 0x2b2,
+    0x3d9, 0xc410001, 0x36, 0xc400327, 0xc440001, 0x30f, 0xc480014, 0xb9,
+    0xc470005, 0xc1d0013, 0x3f4, 0x112, 0xc530349, 0xc3a000e, 0xc360012, 0xc5b0004,
+    0x45a, 0xc59000e, 0xc56000f, 0x274, 0x2a1, 0xa5, 0x289, 0xc58000c,
+    0xc570375, 0xc55000e, 0x3c9, 0xc64000c, 0x3ae, 0x301, 0xc600001, 0x274,
+    0xc660003, 0xc610264, 0xc7703e5, 0xc6b0005, 0xc830007, 0xc69000c, 0xc8a03e9, 0x2a7,
+    0x26b, 0x26c, 0xc6d0009, 0x3ee, 0xc90062f, 0xa95, 0x276, 0x1ec,
+    0xc9103f3, 0xc8f0014, 0xc870355, 0xc68000e, 0x3a5, 0x312, 0x279, 0xc6f0001,
+    0x3fb, 0x32, 0x2ae, 0x293, 0x261, 0xc780009, 0xc80000e, 0x2a7,
+    0xc740265, 0xc7e0012, 0xc700013, 0x321, 0x269, 0xc730005, 0x29b, 0xc7c000c,
+    0x4ef, 0xc810009, 0x26f, 0xc23, 0xc940012, 0xe1, 0x305, 0xf68,
+    0x275, 0x30f, 0x293, 0xc990012, 0x89, 0x353, 0xc880014, 0x25,
+    0x94, 0x319, 0xc9a0007, 0x53, 0x334, 0x29b, 0xc820015, 0x48c,
+    0x3cd, 0xcb0000e, 0x3fb, 0xcab0010, 0x452, 0xc930012, 0x333, 0xcaf0014,
+    0xca20015, 0xc8c0001, 0x59, 0x2a8, 0x332, 0xc890005, 0x27b, 0x2a8,
+    0x289, 0x89, 0xcba0012, 0xcaa0001, 0x45, 0xfd3, 0x3cf, 0xca80008,
+    0xcbe0309, 0x3c3, 0xd05, 0xcc50015, 0x30c, 0x2a6, 0x3a1, 0x304,
+    0x95, 0xcbd0012, 0xcbf0005, 0xa5, 0xcb80015, 0xcda0481, 0xcc30009, 0x45,
+    0xcc60004, 0xcd20005, 0x2a9, 0xcc90007, 0xcd50004, 0xcd00349, 0xcca0004, 0xc54,
+    0x326, 0xcd6000d, 0xa5, 0xcd9000f, 0x42, 0x323, 0xfec, 0xcd40009,
+    0x47, 0xcdc0015, 0x3ce, 0x3d3, 0xcb30014, 0x333, 0x4fb, 0xccb000e,
+    0x2ac, 0xcef0001, 0x101a, 0xce41023, 0x308, 0xcdd0265, 0x426, 0x312,
+    0xcf10008, 0xd030009, 0xceb0001, 0x40b, 0xcf9000c, 0xcf7000d, 0x2a7, 0xcfc036f,
+    0xd050350, 0x2ae, 0xcfa0001, 0xd0b0893, 0xd100014, 0xd0a0375, 0xce90009, 0x2b6,
+    0xcf6000f, 0x312, 0xd3, 0x3fb, 0x30e, 0x302, 0xb0, 0x44,
+    0x1ee, 0xd06000d, 0x273, 0xcfb0005, 0xd070001, 0xb2, 0x449, 0x1ee,
+    0xd010005, 0xcfd0001, 0xd0e0001, 0x3cc, 0x3d3, 0x345, 0x293, 0xcf50014,
+    0x3db, 0x349, 0x26c, 0x59, 0xd02000c, 0x2b3, 0x3d9, 0xd270001,
+    0x49, 0x301, 0xd110012, 0xd1203e5, 0xd2e0012, 0x3d3, 0x3e8, 0xd390489,
+    0x2ac, 0xd170002, 0x32d, 0x4cb, 0xd240001, 0xd30000f, 0x327, 0x301,
+    0xd2b0012, 0x32d, 0x274, 0xd350015, 0x104d, 0x3ae, 0xd2f0001, 0x289,
+    0xd2c001a, 0x284, 0x261, 0x3b4, 0xd200383, 0x106d, 0x26e, 0x30c,
+    0x307, 0x30c, 0x27b, 0x314, 0x2b9, 0xd1c000c, 0x36d, 0x27b,
+    0x3ef, 0xd420005, 0xd360013, 0x3cf, 0xd1d0273, 0xd490009, 0xd33000c, 0x31b,
+    0xd34000e, 0x33b, 0xa9b, 0xd45000f, 0xd370012, 0xd3b000c, 0x2bb, 0xd550012,
+    0x2af, 0xa94, 0x285, 0xd4a0001, 0x272, 0x354, 0xd4b000e, 0x4f4,
+    0xd510003, 0xd5d04e1, 0x51, 0x49, 0x54f, 0xd540605, 0xd570012, 0xd580013,
+    0xd690009, 0xd50000f, 0xb3, 0x97, 0xd5f0014, 0x3d0, 0x265, 0xd61000f,
+    0xd6b0004, 0x3d0, 0x4e7, 0x2a9, 0xa44, 0xd6c0015, 0xd840001, 0x482,
+    0x279, 0x33, 0xd8a0005, 0x3a6, 0xd640014, 0x3c8, 0xd940489, 0x3bb,
+    0x3cb, 0xd9e048c, 0x48d, 0xda4000e, 0xd99000f, 0x45, 0x3a2, 0xda20012,
+    0xdad0db3, 0x294, 0x3d9, 0x287, 0x497, 0xd660009, 0x364, 0x605,
+    0x4c, 0x3c7, 0x32c, 0x288, 0xd870013, 0xcf, 0xd6a000c, 0x1083,
+    0xd70000e, 0x28, 0x293, 0x279, 0x492, 0xd680053, 0xd710014, 0x43b,
+    0xd86000c, 0x32d, 0xda1000e, 0xd820005, 0x3d0, 0xd800004, 0xd810005, 0xd8b0053,
+    0x47, 0xd970005, 0x293, 0x2b2, 0xd910013, 0xae, 0x3b5, 0x4fb,
+    0x323, 0xd9f000f, 0xdb10009, 0x98f, 0x83, 0x29, 0x4e, 0x279,
+    0x32f, 0x3cc, 0x8f, 0x4c, 0x33b, 0x45, 0xb4, 0x45,
+    0x47, 0x2ae, 0x89, 0x325, 0x269, 0xce1, 0x339, 0xdde0001,
+    0xde00622, 0xdf00da3, 0xdf103e4, 0xdfb0005, 0xe1403e6, 0xe280b27, 0x6e8, 0xe320009,
+    0x26a, 0xe70000b, 0xe73048c, 0xe8103ed, 0xb4e, 0xe93000f, 0xec203f0, 0x319,
+    0x652, 0xecd0b53, 0xed60274, 0xeeb0015, 0xef80016, 0x637, 0xdbb000c, 0xf030619,
+    0xda90002, 0xdac0003, 0xdbe0004, 0xdaf0424, 0xdaa0005, 0xda80007, 0xdb30001, 0x276,
+    0x2e, 0xdda0009, 0xdd20005, 0xdab000d, 0xddf000e, 0xdf20012, 0xdd10009, 0x2b3,
+    0xdb90012, 0xdba0013, 0xde50014, 0xdb80014, 0xdc40276, 0x45, 0xddb0365, 0x3c5,
+    0x329, 0x3a9, 0xddc0049, 0x3c9, 0x441, 0xdf50002, 0x3c9, 0xd4,
+    0xdf30001, 0xdeb0006, 0xdfd0007, 0xdef03b2, 0x4e7, 0xe030009, 0xa3, 0xdfc03d4,
+    0xdff000d, 0xe07000e, 0x423, 0xe080010, 0xdf40005, 0xe180012, 0xe120153, 0x4fb,
+    0x308, 0xe1f0016, 0xc2, 0x2af, 0xe190439, 0xe040003, 0x41, 0xe150012,
+    0x4fb, 0xe100001, 0x3d2, 0x614, 0x4fb, 0x45, 0x265, 0x427,
+    0x3a1, 0x969, 0x27b, 0x4f1, 0xe050005, 0xe010433, 0x292, 0x32f,
+    0x53, 0xe1a0281, 0x333, 0xe200009, 0x192, 0xe170005, 0x2a9, 0x3d2,
+    0x5b, 0x27b, 0x3cf, 0xe3d0001, 0xe250002, 0xe440003, 0xe4d0004, 0x8f,
+    0xe4f0006, 0xe590007, 0xda, 0x4ef, 0xb2, 0x42b, 0x10ac, 0xe5a000d,
+    0xe63000e, 0xe5f000f, 0x92, 0x10f1, 0x3c7, 0xe550013, 0xe640494, 0xe460014,
+    0xe6b0016, 0x3c1, 0x44d, 0x4e5, 0x49a, 0xe2c0009, 0x3a1, 0xe220012,
+    0x3d3, 0xe230014, 0xe2a0005, 0xe1d000f, 0xe300005, 0x326, 0x429, 0x273,
+    0xe160014, 0x335, 0xe330001, 0x3cc, 0xe520002, 0x3b9, 0x4c, 0x81,
+    0xe500005, 0x428, 0xd2, 0x89, 0x321, 0x50, 0x2a7, 0x4e1,
+    0xe5e10c5, 0x3cf, 0xc30, 0xe480012, 0x89, 0xe6c0009, 0xe5b000b, 0xe660003,
+    0xe600005, 0xe670081, 0x92, 0x3ac, 0xe690001, 0x281, 0xe74110e, 0xe710015,
+    0xe800365, 0xed3, 0x109, 0x54, 0xe680449, 0xe7d000e, 0x2b4, 0x37b,
+    0x337, 0x281, 0xe7803cf, 0x3a3, 0x307, 0xac, 0xe770005, 0x3a7,
+    0x324, 0xe620011, 0xe6f0009, 0x294, 0x3ac, 0xe6a0015, 0xa4e, 0x297,
+    0xe84000f, 0xe790001, 0x2e, 0x3c9, 0xa54, 0xe900002, 0xe8a0003, 0x423,
+    0xe940009, 0x266, 0xe8f0007, 0xe8b0005, 0xe3a, 0x92, 0x28f, 0xc4,
+    0xe96000d, 0xea3000e, 0xe9b000f, 0xea60010, 0x435, 0xeaf0012, 0xeb10013, 0xebc0014,
+    0xeb40015, 0x276, 0x4e7, 0xe920005, 0xe820049, 0x4fb, 0x43b, 0x89,
+    0xe9d0021, 0xea50014, 0x2a5, 0x3ad, 0x3cf, 0xb5, 0xea70005, 0xea20009,
+    0xead0009, 0xeb20010, 0xeae0008, 0xb4, 0x4fa, 0x3c1, 0xea0000f, 0xc4,
+    0xea9000f, 0xa2, 0xebb000e, 0xebf0001, 0x2a7, 0x54, 0x1e1, 0x4f9,
+    0x3f4, 0x3a1, 0xec80008, 0xec10009, 0x4fb, 0x89, 0x32c, 0xebd000e,
+    0x323, 0x289, 0x365, 0x325, 0x292, 0x3b4, 0xece0009, 0xed20001,
+    0xe5, 0x2a7, 0xec90013, 0xecf0485, 0xec70005, 0x2e, 0xec40008, 0xed70009,
+    0xed3000e, 0xec50012, 0xee20012, 0x181, 0x29b, 0x2a4, 0x312, 0x30e,
+    0x492, 0x4e1, 0x33, 0xed00155, 0x2a1, 0xed40002, 0xeea0003, 0x3c1,
+    0xed90005, 0x46, 0x28, 0x309, 0xee10009, 0xee80009, 0x92, 0x4e9,
+    0xeee000d, 0x85, 0xee4030f, 0x270, 0xeec000e, 0xef50005, 0xeed0013, 0x614,
+    0x33, 0xef40014, 0x2a5, 0x28e, 0x261, 0x262, 0x30f, 0x29b,
+    0xefe0009, 0x1134, 0x285, 0x2a5, 0xf06000e, 0xf000009, 0xae, 0xc4,
+    0xefd000d, 0xef7000e, 0x4ee, 0xf280601, 0xf4e0642, 0x7e3, 0xf050833, 0xf550005,
+    0x646, 0x49, 0x3e8, 0xf860009, 0x307, 0x26b, 0x64c, 0xfa3048d,
+    0xfa6064e, 0xfaf060f, 0xfdb0650, 0x2ae, 0x6d2, 0xff70db3, 0x274, 0xff50615,
+    0x59, 0x277, 0x3e2, 0xf2b0003, 0x441, 0x264, 0xf380009, 0xf040007,
+    0x3e8, 0xf0b0009, 0xf150009, 0xeff0008, 0xf29000c, 0xf10000c, 0xf25000e, 0x3cc,
+    0x270, 0x4e1, 0xf360012, 0xf410013, 0xf480014, 0xf0f0014, 0xf3b000e, 0xf300009,
+    0xf260005, 0x2bb, 0xf2a000c, 0x59, 0xf400003, 0x2a5, 0x45, 0x313,
+    0x261, 0x1154, 0x2ba, 0xb3, 0x96, 0x4e5, 0xf47001a, 0xf350001,
+    0x188, 0xf340009, 0x9a, 0xa87, 0xae, 0x74, 0x28c, 0xf4a0009,
+    0xf4c000e, 0xf5103e4, 0xf5a0009, 0x4e1, 0x447, 0x45, 0x116f, 0x305,
+    0x56, 0xf5e000c, 0xf4f044d, 0xf70060e, 0xf65000f, 0xa3, 0x45, 0xf5c0012,
+    0xf6303f3, 0xf790014, 0xed9, 0x3d6, 0x27b, 0xf46000f, 0xf5, 0xf750013,
+    0x27b, 0xf620041, 0x54, 0x2ae, 0xf580004, 0x265, 0x281, 0xf6f0014,
+    0x429, 0x49, 0xf7103c1, 0x2a9, 0xf7d0009, 0x8c, 0x345, 0x41,
+    0x4e3, 0xf720008, 0x2a5, 0xf590033, 0xf610434, 0x47, 0x285, 0x301,
+    0xf8d032c, 0xf820012, 0xf7e0004, 0xf730332, 0x319, 0x47, 0xf8e0009, 0x421,
+    0x268, 0x32c, 0xf85000c, 0xec5, 0xf97000e, 0xf83000f, 0xa9, 0x34,
+    0x41, 0xf9d0373, 0xf880014, 0x424, 0xf810005, 0x5b, 0xf7c0007, 0x49,
+    0x37a, 0x4fb, 0xf770005, 0x299, 0xf930001, 0xf910012, 0x299, 0x3c1,
+    0xf8a0012, 0xac, 0xb9, 0x54, 0x335, 0x32e, 0xfb30272, 0xf9f0009,
+    0xfa40009, 0xf960014, 0xf9c0003, 0x1184, 0xfa50001, 0x3cf, 0xfa80007, 0x3cf,
+    0xfac0009, 0xfa70014, 0x26b, 0xfc1000c, 0xfc3000d, 0xfc5000e, 0x4fa, 0xfbb0133,
+    0xa5, 0xfcf0452, 0xfd20153, 0xfd10014, 0xfd40015, 0x456, 0xfb40005, 0xfb50013,
+    0x305, 0x2b4, 0xfb70005, 0xb4, 0xfc80007, 0xa5, 0xfce0009, 0x181,
+    0xfba0001, 0x4d, 0x1ec, 0x31b, 0xfc6000f, 0x27b, 0x2b9, 0xfbd0005,
+    0x54, 0x188, 0x286, 0xfdc0012, 0xfc90001, 0xfdd00e1, 0xfb80019, 0xa2,
+    0xfd50005, 0xfc40013, 0x310, 0xfe50008, 0xfeb0369, 0xc9, 0xfd80001, 0x433,
+    0x31a, 0x3b4, 0xfe0000f, 0x1f3, 0x41, 0x2b3, 0xc5, 0xfea0014,
+    0xfda0005, 0x89, 0xfe80012, 0xfee0013, 0x379, 0xfe70015, 0xd6, 0xfe40009,
+    0xfe90014, 0x52e, 0x333, 0xff20001, 0x3d2, 0x292, 0x2b3, 0x328,
+    0x289, 0xffa000c, 0x42d, 0x14e, 0x712, 0x270, 0x1a9, 0xff90005,
+    0x335, 0x2a1, 0x3d5, 0xff10012, 0xbb, 0x10180009, 0xffd04f4, 0x10270601,
+    0xb22, 0x10500003, 0x10650004, 0x10830005, 0x3a6, 0x109e0007, 0x10b80b28, 0x10bf0009,
+    0x48a, 0x10dc066b, 0x64c, 0x10e5028d, 0x10e70dae, 0x10f1000f, 0x11170a10, 0x491,
+    0x110f0492, 0x112a0b53, 0x113c0494, 0x11540015, 0xa76, 0xa17, 0x100803c9, 0x11590019,
+    0x1163027a, 0xff30b42, 0x102a0003, 0x3c1, 0x2b4, 0x1e9, 0x10020007, 0x54,
+    0x10240003, 0x274, 0x4b, 0x101d000c, 0x1004000d, 0x102d036e, 0x101b0009, 0x43,
+    0x2b, 0x103d0012, 0x10340333, 0x10400374, 0x10390375, 0x104b0016, 0x294, 0xa9,
+    0x83, 0x10370001, 0x265, 0x30c, 0x10310009, 0x27b, 0x89, 0x103b000d,
+    0x10360014, 0x4c, 0x28d, 0xda, 0x10490013, 0x434, 0x85, 0x103a000f,
+    0x45, 0x10410001, 0x103c0013, 0xd2, 0x28f, 0x103f0005, 0x3a1, 0x33b,
+    0x10550008, 0x104d0009, 0x10450005, 0x34e, 0x104e0015, 0x28c, 0x10510009, 0x1047000f,
+    0x10620012, 0x3d4, 0x492, 0xe1, 0x3b3, 0x495, 0x105e0001, 0x329,
+    0x10520014, 0x10540013, 0x10560485, 0x445, 0x28e, 0x2bb, 0x10690009, 0x326,
+    0x283, 0x3b2, 0x95, 0x4eb, 0x10610001, 0x106e03d4, 0xb6, 0x10600009,
+    0x4e5, 0x3c1, 0x106d0015, 0x265, 0x10660017, 0x494, 0xba, 0x52,
+    0x3cf, 0x10640009, 0x2a9, 0x3ba, 0x105f0001, 0x105d0442, 0x10680443, 0x3e4,
+    0x3cf, 0x108a0009, 0x10730007, 0xc2, 0x285, 0x423, 0x322, 0x1078000c,
+    0x1079000d, 0x1076060e, 0x42f, 0x10710010, 0x451, 0x10970492, 0x108d0613, 0x10800014,
+    0x10890001, 0x108703d6, 0x3d7, 0x332, 0x365, 0x270, 0x3fb, 0x108c0001,
+    0x11a9, 0x3f4, 0x11c5, 0x10a00005, 0x277, 0x2a1, 0x10a40008, 0x10ae0009,
+    0x3fb, 0x52, 0x10b3000c, 0x285, 0x3ac, 0x109f000f, 0x109d000e, 0x3a9,
+    0x3a2, 0x10b00013, 0x10a60012, 0x10a90495, 0x321, 0x36, 0x32d, 0x379,
+    0x2a8, 0x10b90041, 0x2a9, 0x182, 0x34e, 0x45, 0x3d2, 0x10c40449,
+    0x10bb0961, 0x10ce0002, 0x294, 0x10b103c4, 0x10ac0005, 0x10b60006, 0x10c20007, 0x10c70003,
+    0x10bc0001, 0x30e, 0x4b, 0x3d0, 0x10c8048d, 0x10d1048e, 0x3cf, 0x301,
+    0x2b4, 0x10bd0009, 0x10c50013, 0x10d40374, 0x292, 0x4fb, 0x10ba0005, 0x31a,
+    0x47, 0x10da0014, 0x3cc, 0x41, 0x328, 0x10cf0009, 0x42f, 0x3b2,
+    0x4fb, 0x10d00005, 0x10d80012, 0x10cd000f, 0x3b4, 0x10db0009, 0x312, 0x28f,
+    0x48c, 0x30e, 0x10d70045, 0x34, 0x45, 0x10e20001, 0x8c, 0x10ed004c,
+    0x10ec0009, 0x10f20013, 0x305, 0x10e30002, 0x10eb0003, 0x924, 0x425, 0x28c,
+    0x10f40267, 0x25, 0x10de0009, 0xc9, 0x10f70007, 0x1100000c, 0x1101000d, 0x110c03ce,
+    0x10f80009, 0x11020270, 0x56, 0x11150012, 0x11180013, 0x111b0014, 0x11100615, 0x11140016,
+    0x11190017, 0x11e9, 0x11090009, 0x4f3, 0x423, 0x11070001, 0x47, 0x10f5000f,
+    0x3cf, 0x1106000f, 0x110b000c, 0x29a, 0x1209, 0x10f900a9, 0x11160001, 0x3d9,
+    0xa2, 0x11130005, 0x319, 0x263, 0x2a1, 0x45, 0x42e, 0x122c,
+    0x49, 0x111f0005, 0x23, 0xeda, 0x55, 0x18c, 0x2a2, 0x1e9,
+    0x10fe0012, 0x111c0012, 0x323, 0x11240001, 0xb4, 0x3c3, 0x3c5, 0x111d0365,
+    0xa93, 0x224, 0x289, 0x112d0009, 0x27, 0x11390001, 0x36c, 0x30d,
+    0x111e0014, 0x1127000f, 0x11290010, 0x11300002, 0xcc, 0x113d0001, 0x11340014, 0x42,
+    0x112f0012, 0x112e0005, 0x193, 0x52, 0x282, 0x11420449, 0x113e000f, 0x11310005,
+    0x146, 0x3a5, 0x1140000c, 0xa87, 0x114a000c, 0x85, 0x11370012, 0x3d3,
+    0x1144000e, 0x11470015, 0x50, 0xe9, 0x1148000d, 0x341, 0x11560006, 0x2ae,
+    0x3c4, 0x11490005, 0x11500006, 0x45, 0x345, 0x11510009, 0x312, 0x3ae,
+    0x289, 0x1157032d, 0x124e, 0x3af, 0x3a1, 0x734, 0x4d, 0x11700005,
+    0x114c0014, 0x50, 0x117d0261, 0x11890002, 0x11910003, 0x11b20004, 0x11b60005, 0x11bc0006,
+    0x11cd0007, 0x11e70a68, 0x11e90449, 0x28a, 0x11fe03eb, 0x120a000c, 0x1240000d, 0x1267036e,
+    0x1288044f, 0x12940010, 0x491, 0x12a70012, 0x12df0013, 0x12fd0014, 0x13140455, 0x131e0016,
+    0x132e0017, 0x84, 0x13340019, 0xed3, 0x184, 0xa9, 0x45, 0xc5,
+    0x542, 0x1162000c, 0x11860001, 0x4c, 0x118c036e, 0x3b4, 0x117f0005, 0x11800012,
+    0x11810013, 0x117c0014, 0x117e0489, 0x2a7, 0x30c, 0x11820014, 0x485, 0x11790005,
+    0x292, 0x11920048, 0x11960009, 0x3b2, 0x186, 0x119e000c, 0x11880015, 0x11940001,
+    0x11a0000f, 0x32d, 0x32c, 0x11a60012, 0x324, 0x119f0014, 0x11a80015, 0x11a50001,
+    0x303, 0x2ba, 0x118f0009, 0x185, 0x4f4, 0x11af0012, 0x119b000f, 0x11980009,
+    0xe1, 0x301, 0x285, 0x11b10005, 0x11b0000c, 0x2a4, 0x11ae0004, 0x303,
+    0x11a90003, 0x11a10014, 0x11ad0012, 0x11b40009, 0x192, 0x11ab0014, 0x2b3, 0x287,
+    0x3c1, 0x11aa126f, 0x32c, 0x8f, 0x11b8000e, 0x11b70369, 0x2bb, 0x11b50015,
+    0x3b2, 0x2a5, 0x11bf0014, 0x11c40014, 0x3b6, 0x1072, 0x11bb0001, 0x11c80014,
+    0x2b6, 0x11ba0009, 0x11ce0485, 0x11c70009, 0x285, 0x3a5, 0x11d00009, 0x32f,
+    0x34, 0x11c1032c, 0x7b9, 0x11ca000e, 0x11cf000e, 0x28f, 0xa9, 0x11d60012,
+    0x332, 0x43a, 0x11d50015, 0x1293, 0x314, 0x32f, 0x11d90619, 0x3ee,
+    0x11e80001, 0x11d80005, 0xc2, 0x93, 0x11e40003, 0x11ec0004, 0x312, 0x11ed0006,
+    0x47, 0x11dc0005, 0x2b4, 0x26, 0x11de0005, 0x11ef000c, 0x1f3, 0x11f1000e,
+    0x3a7, 0x11ee0005, 0x11f60005, 0x3a3, 0x11f20013, 0x11fd0014, 0x2ae, 0x28d,
+    0xd2, 0x11f0000f, 0x11f70005, 0x11fa0005, 0xce, 0x11f40014, 0x11f50014, 0x12050009,
+    0x3ae, 0x312, 0x2a5, 0x11ff0481, 0x65, 0x32e, 0x12070444, 0x12090005,
+    0x12080006, 0x3c9, 0x11e30013, 0x12210449, 0x3a5, 0x307, 0x121d000c, 0x2bb,
+    0x308, 0x1227000f, 0x121e0010, 0x312, 0x11f80013, 0x3b4, 0x454, 0x12310015,
+    0x456, 0x28f, 0x3a1, 0x379, 0x120f0003, 0x11fc0004, 0x12240009, 0xa46,
+    0x285, 0x25, 0x2ac, 0x29b, 0x12120009, 0x28c, 0x12280007, 0x120e000e,
+    0x28f, 0x12180009, 0x2ba, 0x302, 0x12100013, 0x12230014, 0x12200009, 0x296,
+    0x305, 0x52, 0x2ba, 0x301, 0x2a8, 0x12410013, 0x1233000d, 0x30e,
+    0xac, 0x12340001, 0x123e0002, 0x445, 0x293, 0x12430365, 0x2a5, 0x12320012,
+    0x122d0014, 0x12550009, 0x3cc, 0x2b9, 0x301, 0x124d000d, 0x289, 0x1253000f,
+    0x12570010, 0x123a000e, 0x12460005, 0x4e4, 0x124f000e, 0x122a0012, 0x3a1, 0x12350334,
+    0x124b0003, 0x284, 0x12560007, 0x45, 0x3c3, 0xef, 0x42c, 0x2af,
+    0x309, 0x32e, 0x125c0005, 0x1245034e, 0x12520009, 0x2b4, 0x31b, 0x3ae,
+    0x12590341, 0x124e0012, 0x125b0343, 0x125003e4, 0x12610005, 0x3d5, 0x12580007, 0x3ae,
+    0x12700009, 0x3c9, 0x125d000b, 0x343, 0x12510013, 0x319, 0x1273000f, 0x12680004,
+    0x319, 0x12780010, 0x12690313, 0x12820014, 0x127c0015, 0x12890016, 0x35, 0x3af,
+    0x125f000d, 0x127201e9, 0x101, 0x353, 0x12810012, 0x295, 0xe6, 0x127a0005,
+    0x1ee, 0x2ad, 0xc1, 0x12800ca9, 0x128b0004, 0x89, 0x3a4, 0xd4,
+    0xa5, 0xa4, 0x128f0421, 0x3cb, 0xa9, 0x361, 0x267, 0x292,
+    0x12840010, 0x128d0005, 0x128a0012, 0x127b0013, 0x129d03e8, 0x12930009, 0x12920001, 0x12910352,
+    0x28e, 0x129e000e, 0x12850005, 0x129c000f, 0x329, 0x307, 0x492, 0x3b4,
+    0x12b10481, 0x355, 0x28e, 0x12970009, 0x12bd0005, 0xb9, 0x12af0007, 0x129b0013,
+    0x12c70009, 0x2ba, 0x12ae0007, 0x2a5, 0x12be000d, 0x12c6000e, 0x12c9000f, 0x12c80010,
+    0xa87, 0x12cf0012, 0x12cd0013, 0x12d00014, 0x12d20015, 0x12a2000c, 0x12b500a1, 0x12ab000e,
+    0x499, 0x28c, 0xa8, 0x2bb, 0x3d5, 0x301, 0x309, 0x449,
+    0x7e1, 0x319, 0x12c40003, 0x145, 0x29b, 0x2a5, 0x12a80014, 0x286,
+    0x12ba0013, 0x307, 0x12cb03c5, 0x28c, 0x37, 0x34e, 0x48f, 0x428,
+    0x12d10008, 0xae, 0x309, 0x12b00014, 0x3b5, 0xce5, 0x12ca0015, 0x28d,
+    0x12d70001, 0x34, 0x12e20443, 0x30c, 0x12dc03b0, 0x269, 0x289, 0x3c5,
+    0x12d80009, 0x3d9, 0x319, 0x3cc, 0x12e70014, 0x55, 0x36f, 0x12f40010,
+    0x12e10009, 0x12d4000f, 0x12e40441, 0x12f10014, 0x292, 0x3c1, 0x30f, 0x2b6,
+    0x12dd0014, 0x2ac, 0x12ed0009, 0x13000005, 0x32e, 0x13050013, 0x12ee0001, 0xb3,
+    0x319, 0x2b4, 0x12f80005, 0x3cf, 0x12f6000c, 0x13040268, 0x130c0009, 0x1e7,
+    0x2b3, 0x12ea0005, 0x12f50012, 0x333, 0x12ec000f, 0xf29, 0xa9, 0x13100003,
+    0x31b, 0x2a1, 0x3a6, 0x30c, 0xc9, 0x3a5, 0x13070002, 0x13120003,
+    0x13090005, 0x13080005, 0x130b0008, 0xd2, 0x2b4, 0x13130003, 0x144, 0x3b3,
+    0x3cc, 0x25, 0x131a000e, 0x13160005, 0x3ce, 0x84c, 0x13220005, 0x131d0009,
+    0x131b0012, 0x131c000e, 0x2b6, 0x31b, 0x1e9, 0x1319000f, 0x193, 0x3d4,
+    0x3b3, 0x13230014, 0x13210004, 0x132c0005, 0x312, 0x341, 0xa9, 0x349,
+    0x30c, 0x2b4, 0x13530001, 0x8c, 0x132d000e, 0x32f, 0x2e, 0x13250013,
+    0x13540601, 0x642, 0x59, 0x3c4, 0x137e0005, 0x266, 0x267, 0x13ae0008,
+    0x13d20009, 0xcc, 0x12cb, 0x13e312ec, 0x64d, 0x6ee, 0x13f6000f, 0x140f0650,
+    0x3d5, 0x14170452, 0x143b0b53, 0x14450634, 0x14510015, 0xa5, 0x3b7, 0x135e0003,
+    0x324, 0x133d0002, 0xa9, 0x13390007, 0x53, 0x13300329, 0x13500007, 0x3c1,
+    0x32c, 0x4ee, 0x1364000e, 0x3c5, 0x133b0350, 0x41, 0x136a0012, 0x3b4,
+    0x136c0014, 0x132f0005, 0x56, 0x13570001, 0xac, 0x439, 0x13510004, 0x13600425,
+    0x13730009, 0x13630445, 0x54, 0x13490469, 0x13670008, 0x2b2, 0x4e3, 0x13760009,
+    0x13290014, 0x3c3, 0x136f0012, 0x2c, 0x44, 0x319, 0x136e0012, 0x13681241,
+    0x2b9, 0x443, 0x137f0564, 0x13780325, 0x425, 0x1e1, 0x3c1, 0x43,
+    0x13840429, 0x4b, 0x1385000c, 0x25, 0x138e000e, 0x1388000f, 0x13860009, 0x13870001,
+    0x13960012, 0x323, 0x13a90454, 0x48, 0x13890013, 0x3ce, 0x2ae, 0x13990001,
+    0xcc, 0x27b, 0x89, 0x138c0002, 0x4c, 0xd4, 0xc9, 0x13810329,
+    0x327, 0x2ae, 0x138b0014, 0x13a8000d, 0x32e, 0x8f, 0x13950012, 0x2ba,
+    0x4e9, 0x13900001, 0x13910014, 0x2b5, 0x76, 0xe5, 0x13930005, 0x13940001,
+    0x8f, 0x13a1000e, 0x138d0009, 0x13a30005, 0x33b, 0x3d2, 0x139d0013, 0x13c10009,
+    0x3db, 0x2a7, 0x44c, 0x139f0014, 0x422, 0x13ba000f, 0x2e, 0x13d00012,
+    0x13c00009, 0x273, 0x314, 0x4f5, 0x343, 0x3c5, 0x4e5, 0x619,
+    0x13c5000e, 0x27b, 0x425, 0x3d0, 0x52, 0x423, 0x4e9, 0x13b2000e,
+    0x3d9, 0x13bb0001, 0x30f, 0x13b00301, 0x13a70013, 0x13b70003, 0x13de0324, 0x13ca0005,
+    0x30e, 0x13ad0007, 0x24, 0x43a, 0x2e, 0x13e103a8, 0x13c3000c, 0x281,
+    0x13d6044e, 0x13ce12af, 0x2a1, 0x305, 0x13da0001, 0x32f, 0x13d50014, 0x4e9,
+    0x42e, 0x29, 0x455, 0xd4, 0x13ee0009, 0x13d70013, 0xb2, 0x81,
+    0x13ed012e, 0x33b, 0x13e0000f, 0x13dc0005, 0x13f4004d, 0x267, 0x22, 0x2ad,
+    0x13e70015, 0x3c3, 0x13e50004, 0x13ea0005, 0x4e, 0x1327, 0x1314, 0x13e20009,
+    0x4fb, 0x4f4, 0x13ec000c, 0xd4, 0x13fe000e, 0x13ef0019, 0x3d0, 0x3c9,
+    0x13f310d2, 0x13fa0613, 0x140d0334, 0x14010015, 0x3d9, 0x73, 0x3c1, 0x4ee,
+    0x13ff0001, 0x14110012, 0xa1, 0x140c0013, 0x14130365, 0x14020009, 0x14140014, 0x324,
+    0x14040001, 0xa5, 0x25, 0x8d, 0x14250005, 0x14150019, 0x1400000f, 0x28c,
+    0x142e0009, 0x3ae, 0x14290001, 0x4e9, 0x41, 0x3b2, 0x143c000f, 0x3b4,
+    0x141a0003, 0xaf, 0x140e0005, 0x14210006, 0xc3, 0x14200005, 0xae, 0x3a5,
+    0x1354, 0x1423000c, 0x3a1, 0x785, 0x14220009, 0x18f, 0xd4, 0x92,
+    0x142a0013, 0x14280014, 0x185, 0x96, 0x141c000e, 0x433, 0x52, 0x14310003,
+    0x365, 0x14260053, 0x142b0006, 0x3c8, 0x14430009, 0x322, 0x14470001, 0x8d,
+    0x8c, 0x11e2, 0x365, 0x83, 0x4e, 0x368, 0x143a0009, 0x14350013,
+    0x74, 0x52, 0x92, 0x82, 0x14570005, 0x25, 0x45, 0x46,
+    0x143e0009, 0x144004e5, 0x142c0015, 0x44, 0x337, 0x1448000c, 0x3cd, 0x44e,
+    0x14660455, 0x14670006, 0xb6, 0x143f0012, 0x4f3, 0x14540454, 0x312, 0x144c0001,
+    0x144f0014, 0x309, 0x432, 0x14580005, 0x434, 0x14500008, 0x3cf, 0x54,
+    0xa9, 0x28c, 0x94, 0x3fb, 0x148b0001, 0x14b30482, 0x14bb0483, 0x14c60004,
+    0x14d10005, 0x151d0486, 0x152e0447, 0x153403c8, 0x15450009, 0x3aa, 0x157f000b, 0x158c048c,
+    0x1597048d, 0x15a6000e, 0x15b4000f, 0x15e50490, 0xcf, 0x15f10a12, 0x16040673, 0x16170014,
+    0x16300015, 0x16420016, 0x497, 0x145e0005, 0x164d0019, 0x146003e2, 0x14650003, 0x369,
+    0x92, 0x145b0006, 0x45, 0x147e0005, 0x369, 0x439, 0x147c0008, 0x145f000c,
+    0x1486000d, 0x149d000e, 0xa6, 0x148e0010, 0x26c, 0x14a40012, 0x373, 0x149a0014,
+    0x14970015, 0x14ad0016, 0x14750005, 0x14990009, 0x148d0007, 0x14a7001a, 0x329, 0xa3,
+    0x149c000f, 0x14940025, 0xfce, 0x54, 0x2af, 0x14900009, 0x14a60001, 0x2a9,
+    0x14ae0009, 0x8c, 0x14a50005, 0x2a5, 0x14b40001, 0x46, 0x322, 0x285,
+    0x2e, 0x149f0007, 0x2bb, 0x327, 0x14af0149, 0x14b2036e, 0x52, 0xc22,
+    0x14aa0365, 0x3a1, 0x3cf, 0x14c00008, 0x14bd0009, 0x14ac0005, 0x18d, 0x14bc0001,
+    0x32c, 0x41, 0x52, 0x307, 0x2b2, 0x14b80005, 0x14ca0001, 0x14c80449,
+    0x14b90015, 0x3d4, 0x14dd0001, 0x14c70002, 0x14db0003, 0x14ed0564, 0x14c4002e, 0x14f40006,
+    0x14f50007, 0x14cd0012, 0x14ef0009, 0x14d6000c, 0x14de000d, 0x14f6000c, 0x294, 0x14f0000e,
+    0x34f, 0x14ff0010, 0xac, 0x15001372, 0x15030013, 0x15130014, 0x150c0155, 0x15220156,
+    0x15250017, 0x34c, 0x14cf000f, 0x30e, 0x3fb, 0x14ec0012, 0x14eb0010, 0x14ba0012,
+    0xa5, 0x3c5, 0x345, 0x4f6, 0x3d7, 0x14f70001, 0x14e40009, 0x313,
+    0xb4, 0x14e90445, 0x3c3, 0x14e10012, 0x2bb, 0x309, 0x14ee0009, 0x349,
+    0x2ae, 0x93, 0xc21, 0x2b4, 0x15010014, 0x3c9, 0x45, 0x3c9,
+    0x14f20009, 0x329, 0xc2, 0x2b5, 0x14fc0013, 0x3d9, 0x14f9000f, 0x2f,
+    0x15080009, 0x15060001, 0x2ac, 0x14fe0010, 0x355, 0x2b5, 0x15070013, 0x15100154,
+    0x15090005, 0x3cc, 0x309, 0x3d2, 0x15050009, 0x2a9, 0x33b, 0xd1a,
+    0x15140014, 0xb3, 0x312, 0x150d0001, 0x8c, 0x15110012, 0x2ac, 0x15180005,
+    0x2b3, 0x2b4, 0x15150012, 0x151a0009, 0x1519000c, 0x3c8, 0xb5, 0x307,
+    0x4bb, 0x1520000f, 0x55, 0x15270005, 0x3a3, 0x15300001, 0x339, 0x15310009,
+    0x4e, 0x312, 0x48c, 0x3b4, 0x26c, 0x152a000f, 0x81, 0x1528004e,
+    0x4e4, 0x3c5, 0x154c0009, 0x3b5, 0x293, 0x294, 0x15490301, 0x153d0322,
+    0x15590003, 0x15480004, 0x154f0005, 0x42, 0x15630007, 0x154a0005, 0x303, 0x27b,
+    0x3c7, 0x1539000c, 0x1564000d, 0x156a000e, 0x34f, 0x156d0010, 0x331, 0x156f0009,
+    0x15730373, 0x15770014, 0x150e0001, 0x15800016, 0xb2, 0x154b000e, 0x325, 0x314,
+    0xae, 0x352, 0x153c0269, 0x2b4, 0x15520001, 0x155b0001, 0x9a, 0x45,
+    0x32f, 0x4ee, 0xc5, 0x15550361, 0x4e9, 0xa9, 0x44, 0x45,
+    0x4fb, 0x47, 0xa3, 0x42f, 0x15620010, 0x156504e8, 0x43, 0xc42,
+    0x15750001, 0x154e044c, 0x15660004, 0x3a8, 0x15760005, 0x83, 0xb3, 0x3ce,
+    0x157a0009, 0x29b, 0xb2, 0x50, 0x15790005, 0x157b0005, 0xbb, 0xac,
+    0x156b0012, 0x89, 0x364, 0x158b000c, 0x15700455, 0x3b4, 0x33b, 0x94,
+    0x3c5, 0x15860045, 0x2a8, 0xa3, 0x15710009, 0x158f0009, 0x327, 0x2b3,
+    0x15900001, 0x15820307, 0x332, 0xa4f, 0x15910365, 0x33b, 0x335, 0x3ae,
+    0x15960009, 0x283, 0x158a0333, 0x15840012, 0x1592000e, 0x32f, 0x3ac, 0x15880001,
+    0x8c, 0x2ac, 0x3b4, 0x159a0005, 0x332, 0x312, 0x294, 0x159e0009,
+    0x339, 0xc93, 0x3b4, 0x3b9, 0x3b6, 0x1589004f, 0x159c0002, 0x159b0363,
+    0x345, 0x3c5, 0x15b30006, 0x3b5, 0x159d0009, 0x15ac0005, 0x2b2, 0x15b8014b,
+    0x15c0000c, 0x15c6000d, 0x15cf000e, 0x15c8000f, 0x15d40010, 0x15ae0005, 0x15d50012, 0x15d60013,
+    0x15d30014, 0x4fb, 0x15e60016, 0x15b90005, 0xb8, 0x15c90014, 0xa5, 0x49,
+    0x15c50001, 0x4c, 0x11f3, 0x41, 0x45, 0x60d, 0x50, 0x30c,
+    0x15bf0009, 0x15cb0005, 0x83, 0x15dc0008, 0x4f4, 0x15d70009, 0x89, 0x15ce0005,
+    0xb2, 0x3c5, 0x321, 0x15d20014, 0x2af, 0xac, 0x15da0010, 0x3c1,
+    0x2bb, 0x53, 0x15e10005, 0x15d90005, 0x3d9, 0xce8, 0x15e20009, 0x15dd000e,
+    0x15eb000e, 0x294, 0x307, 0x15cd0012, 0x3af, 0x3b4, 0x15f50005, 0x54,
+    0x43, 0xa9, 0x15ed0009, 0x46, 0x4f, 0x2e, 0x15f00014, 0x33,
+    0x15ef000f, 0x281, 0x33, 0x56, 0x32f, 0x15ea0481, 0x15f903a3, 0x3c3,
+    0x15e30013, 0x16030365, 0x15ec0019, 0x52, 0x16000488, 0x160d0489, 0x2bb, 0xc22,
+    0x18e, 0x1e8, 0x3a2, 0x1602000f, 0x490, 0x15f30012, 0x313, 0x24,
+    0x161a0001, 0x1396, 0x332, 0x297, 0x16100005, 0x16090003, 0x1613000e, 0xaf,
+    0x16200489, 0x327, 0x2a2, 0x334, 0x44, 0x16080005, 0x16270010, 0x3a7,
+    0x189, 0x16250012, 0x16280013, 0x2c, 0x161f000c, 0x3cc, 0x3a9, 0xfc8,
+    0x3c8, 0x301, 0x30e, 0x160f0013, 0x1616000f, 0x162e0005, 0x336, 0x16210007,
+    0x339, 0x16240009, 0xcac, 0x16330010, 0x30e, 0x162b000d, 0x1635044e, 0x8c,
+    0xcb, 0x283, 0x59, 0x163e0013, 0x163c0014, 0x16380009, 0xce, 0x164003c5,
+    0x29, 0x16290014, 0x2bb, 0x164c0009, 0x163f000c, 0x294, 0x3ae, 0x3a3,
+    0x3c3, 0x3af, 0x162f0012, 0x16390013, 0x4e5, 0x164f0007, 0x4eb, 0x1f2,
+    0x45, 0x3b9, 0x89, 0x164e000e, 0x2b2, 0x16510012, 0x13c4, 0x3b4,
+    0x279, 0x314, 0x56, 0x167a0441, 0x7e2, 0x16920003, 0x7e4, 0x16ad0005,
+    0x6c6, 0x6e7, 0x16d40368, 0x16ef0009, 0xacf, 0x1705044b, 0x17100a6c, 0x1717062d,
+    0xa0e, 0x1722060f, 0x173e0010, 0x17400011, 0x492, 0x175a03f3, 0x17750014, 0x17ae0615,
+    0x276, 0x17920457, 0x164a000f, 0x17b10339, 0x622, 0x164b0003, 0x13b4, 0x16450001,
+    0x423, 0x16530004, 0x32f, 0x4e9, 0x2a1, 0xc5, 0x167e000c, 0x16940012,
+    0x167d000e, 0x329, 0x490, 0x4d, 0x165d0009, 0x2af, 0x16830014, 0x55,
+    0x166b0016, 0x4f7, 0x54, 0x16860001, 0x166a000e, 0xe1, 0x50, 0x16990005,
+    0x95, 0x92, 0x16730148, 0x169a0009, 0xd6, 0x324, 0x1680000c, 0x965,
+    0x33, 0x169d000f, 0x269, 0x26, 0xb7, 0x13ef, 0x284, 0x495,
+    0x165a000e, 0x265, 0x434, 0x3cc, 0x333, 0x16470010, 0x168d03c1, 0xb4,
+    0x16960003, 0x16b010e4, 0x16750015, 0x169f000f, 0x16870447, 0xce5, 0x4e9, 0x28e,
+    0x1401, 0x16c1000c, 0x16a4000d, 0x16c8000e, 0x28c, 0x16b70010, 0x26f, 0x16c40012,
+    0x16cc0a13, 0xf8d, 0x16b40015, 0x16c904f6, 0x16cd0017, 0x4f8, 0x345, 0x4e6,
+    0x27b, 0x169b0001, 0x264, 0x263, 0x44, 0x16a20005, 0x16c70005, 0xa7,
+    0x32c, 0x16a90009, 0x26c, 0x4f, 0x2a8, 0x8e, 0x49, 0x4f6,
+    0x283, 0x16cf0005, 0x16af0016, 0x2a4, 0x16c60014, 0x16d80009, 0xf4, 0x65b,
+    0xb4, 0x352, 0x16f70009, 0x16de004f, 0x16f6000e, 0x4f6, 0x34e, 0x30f,
+    0x430, 0x16e10005, 0x16d7000c, 0x277, 0x18e, 0x16db04e9, 0xd6, 0x3fb,
+    0x16ca0032, 0x342, 0x16d50003, 0x16e40004, 0x4f3, 0x2ba, 0x16d60007, 0x261,
+    0x45, 0x16fe04ee, 0x4fb, 0x16f3000c, 0x43b, 0x1706062e, 0x16eb060f, 0xc1,
+    0xa1, 0x16ff0452, 0x613, 0x16d90014, 0x4f5, 0x616, 0x42f, 0x361,
+    0x3b4, 0x4fa, 0x16f40265, 0x16df0005, 0x279, 0x3a7, 0x17010009, 0x170b000e,
+    0x2a5, 0x17000001, 0x2a7, 0x1ac, 0x3b4, 0x365, 0x170f0014, 0xe8,
+    0x171103a1, 0x17020009, 0x4e8, 0x3c2, 0x17150005, 0x1707000c, 0x17120014, 0x18e,
+    0x170a0009, 0x2c, 0x1720000c, 0x28e, 0x704, 0x17240003, 0x1716000f, 0x194,
+    0x17130006, 0x3c5, 0x303, 0x21, 0x17340009, 0x17230008, 0x1732000c, 0x42d,
+    0x172a000e, 0x47, 0x17250330, 0x17190001, 0x17360012, 0x2a9, 0x1424, 0x4e3,
+    0x172c0276, 0xa3, 0xa4, 0x17270009, 0x299, 0x173c000e, 0x80f, 0x173b03e1,
+    0x24, 0x3f2, 0x17390365, 0x172f0005, 0x4e9, 0x97b, 0x173d0008, 0x17430009,
+    0x4f6, 0x4e, 0x173a000c, 0x432, 0xcf, 0x1746000f, 0x29a, 0x2c,
+    0x2a7, 0x1749000e, 0x26f, 0x339, 0x32e, 0x17550015, 0x174b0001, 0x174d000c,
+    0x32, 0x1ec, 0x274, 0x174e0481, 0x33b, 0xcc3, 0x287, 0x17590005,
+    0x2b9, 0x193, 0x17520325, 0x175d0489, 0x52, 0x3ac, 0x1762032c, 0x1757000e,
+    0x32e, 0x1747000c, 0x176b0010, 0x3c9, 0x17410013, 0x294, 0x454, 0x17630015,
+    0x17640005, 0x2b7, 0x176f000e, 0xfc4, 0xc1, 0x17730012, 0x17860001, 0x29,
+    0x4e4, 0x4fb, 0x17780005, 0xe9, 0x324, 0x177e0008, 0x17960449, 0x1772000e,
+    0x28f, 0x1783000c, 0xc1, 0x3a5, 0x1795000f, 0x4eb, 0x307, 0x179d03d2,
+    0x485, 0x181, 0x17710012, 0x4eb, 0x877, 0x367, 0x379, 0x17810157,
+    0x3fb, 0x4e5, 0x36c, 0x176e000d, 0x1774000e, 0x425, 0xc30, 0x281,
+    0x17800003, 0x177a0483, 0x175e0014, 0x325, 0x3a6, 0x324, 0x17990001, 0x4f5,
+    0x324, 0x26f, 0x1788000d, 0x178c000e, 0x177f000e, 0x330, 0x179c0009, 0x17900012,
+    0x4f2, 0x89, 0x34c, 0x2b3, 0x194, 0x178a0014, 0xaf, 0x179e0001,
+    0xf42, 0x33b, 0x339, 0x17ab0009, 0x263, 0x13e7, 0x279, 0x17980009,
+    0x17af0005, 0x2ae, 0x32c, 0x17a0044d, 0x44e, 0x42c, 0x17b3000c, 0x179f000e,
+    0x452, 0x17c1000f, 0x2b3, 0x17aa0012, 0x17dc0601, 0x622, 0x18070263, 0x644,
+    0x18150005, 0x626, 0x647, 0x184a0008, 0x18700009, 0x17c5000c, 0x17ba0009, 0x18a403ec,
+    0x18a3064d, 0xb4e, 0x18b2060f, 0x650, 0x4fa, 0x18cc0012, 0x18f50db3, 0x18f40934,
+    0x19090615, 0x276, 0x191403d7, 0x269, 0x19120619, 0x1902027a, 0x17b203e2, 0x17d20003,
+    0x17d40004, 0x17d7000c, 0x6a6, 0x2af, 0xae, 0x17d50009, 0xaf, 0x17d80009,
+    0x17f4044c, 0x17e7000d, 0x17f6000e, 0x53, 0x17f90010, 0x2a7, 0x18030012, 0x17fc0013,
+    0x17fe0014, 0x17fd0015, 0x56, 0x3f7, 0x18050018, 0x2a1, 0x2af, 0x43b,
+    0x45, 0x17d60005, 0x17f30004, 0x1a1, 0x2b2, 0x89, 0x17ea0005, 0x26b,
+    0x17de000c, 0x45, 0x31a, 0x17e6000f, 0x41, 0x2ac, 0x263, 0x18060009,
+    0x265, 0x263, 0x17fa0014, 0x2e, 0x17e80009, 0x3d2, 0x17ff0009, 0x180b0328,
+    0x18000005, 0x29, 0x53, 0x17fb0015, 0xb4, 0x2b9, 0x18170001, 0x25,
+    0x18120003, 0x18140624, 0x605, 0x18080004, 0x182a0047, 0x2a9, 0x2b2, 0x181d1441,
+    0x273, 0x1823000c, 0x181e000d, 0x1834000e, 0x60f, 0x183603d0, 0x4f4, 0x183c0012,
+    0x18310013, 0x183f0014, 0x435, 0x274, 0x29, 0x438, 0x279, 0x180c0005,
+    0x27b, 0x94, 0x42e, 0x2a9, 0x18350001, 0x18240001, 0x4f3, 0x423,
+    0x424, 0x180d0005, 0xb3, 0x2a5, 0x47, 0x4f4, 0x43b, 0x83,
+    0x1464, 0xc1, 0x18270005, 0x18290009, 0x182b0273, 0x183d0609, 0x3bb, 0x18440008,
+    0x18330614, 0xc5, 0x183a000e, 0x18430001, 0x27b, 0x18470261, 0x93, 0x184c0445,
+    0x93, 0x2e, 0xb6, 0x18550009, 0x2a1, 0x183b0009, 0x26c, 0x1840001a,
+    0x18530003, 0x185a000f, 0x313, 0xb4, 0x4eb, 0x3f3, 0x185d0004, 0x4e3,
+    0x434, 0x26c, 0x2a5, 0x1851000e, 0x18560009, 0x3fb, 0x185c0009, 0x3c2,
+    0x3cf, 0x26f, 0xd4, 0x4e9, 0x185b0012, 0x42e, 0x2bb, 0x18720009,
+    0xba, 0x18650601, 0x1482, 0x187c0003, 0x18620004, 0x185f0005, 0x18610146, 0x186303e7,
+    0x4f5, 0x18590014, 0x2b9, 0x1866000c, 0x186f000c, 0x1878060d, 0x188b062e, 0x188c060f,
+    0xce, 0x4f1, 0xac, 0x18920013, 0x18900014, 0x3d5, 0x18980616, 0x26b,
+    0x270, 0x43b, 0x189f061a, 0x32f, 0x361, 0x18760015, 0x188d0005, 0x2a3,
+    0x186e0005, 0x14b5, 0xc5, 0x301, 0x429, 0x4e1, 0x18940003, 0x425,
+    0x18930009, 0x41, 0x1889000e, 0x424, 0x30c, 0x43b, 0x29b, 0x4d,
+    0x301, 0x2af, 0x50, 0x30e, 0x18950005, 0x18990281, 0x188f0014, 0x2e,
+    0x45, 0x18970005, 0x18820013, 0x18830014, 0x18ac0012, 0x189b0001, 0x452, 0x2b4,
+    0x26f, 0x2a3, 0x43b, 0x28f, 0x302, 0x189a0003, 0x18a10004, 0x312,
+    0x3e6, 0x189c0007, 0x18b60001, 0x18ae0009, 0x441, 0x42, 0x49, 0x18bb000d,
+    0x18b9000e, 0x305, 0x18b5000c, 0x441, 0x18c20012, 0x153, 0x18a50001, 0x18ba0015,
+    0x26f, 0x18c50017, 0x314, 0x18bc0009, 0x4f2, 0x18cd0601, 0x274, 0x82,
+    0x18d00003, 0x18d80005, 0x279, 0x34, 0x319, 0x18e50009, 0xba, 0x25,
+    0xa8, 0x18bf01e9, 0x18cf0005, 0x18e0000f, 0xc9, 0xae, 0xa6, 0x4e1,
+    0x33, 0x18ee0015, 0x14d3, 0x18d50016, 0x18d20014, 0x18d3004d, 0x4e1, 0x18d60005,
+    0x18e20003, 0xb3, 0xa9, 0x18de0009, 0xc9, 0x18e1000d, 0x18e3000e, 0x18ec0008,
+    0x18e70010, 0xa5, 0x3ed, 0x18e40013, 0x90, 0x273, 0x96, 0xa9,
+    0x323, 0x18eb0005, 0x312, 0x56, 0x279, 0x48, 0x333, 0x3c9,
+    0x18ef0009, 0x33, 0x3d3, 0x28f, 0x6fb, 0x93, 0x33, 0x3c5,
+    0x18fd000e, 0x55, 0x18e80341, 0x18f60002, 0x337, 0x144, 0x265, 0x6a6,
+    0x425, 0xb4, 0xac9, 0x261, 0x18f204e9, 0x641, 0x42d, 0x18f7000e,
+    0x2a1, 0x18e90010, 0xaf, 0x190b0012, 0x433, 0x18f30009, 0x3ec, 0x32f,
+    0x49, 0x32c, 0x19200010, 0x26f, 0x2b9, 0x185, 0x1929000e, 0x191003b2,
+    0x2a8, 0x19410001, 0x19420002, 0x19480003, 0x19570004, 0x195f0005, 0x196f0006, 0x196d0007,
+    0x507, 0x19701489, 0x28a, 0x26b, 0x1986000c, 0x19aa000d, 0x19b7000e, 0x19c0000f,
+    0x19cf0010, 0x19240005, 0x19ea0012, 0x1a1103f3, 0x1a2a0014, 0x1a3c03b5, 0xa76, 0x3bb,
+    0x1a310018, 0x185, 0x1a46001a, 0x262, 0x43, 0x18fa0001, 0x2b4, 0x191503c5,
+    0x144, 0x3a1, 0x304, 0x19180a09, 0x42, 0x89, 0x1934000c, 0x1917000e,
+    0x3c9, 0x194a0009, 0x45, 0x19440012, 0x193c000c, 0x494, 0x487, 0x56,
+    0x94, 0x313, 0x3b2, 0x2a4, 0x19510005, 0x3b5, 0x3d4, 0x195c0009,
+    0x19660009, 0x339, 0x32e, 0x312, 0x19320013, 0x325, 0x1954000f, 0x36,
+    0x4c, 0x483, 0x19470013, 0x19460005, 0x335, 0x1960000e, 0x19610005, 0x8e,
+    0x421, 0x19560012, 0x2ae, 0x33, 0x194d0014, 0x19690008, 0x19640009, 0x195e0009,
+    0xba, 0x2b3, 0x294, 0x3ac, 0x196e000c, 0x21, 0x194f03ce, 0x4d,
+    0x19710005, 0x289, 0x19720012, 0x196a0012, 0x197c0014, 0x5b, 0x197b0096, 0x198a0481,
+    0x19890028, 0x19800003, 0x198b0004, 0x198803c5, 0xa2, 0x198e0007, 0x4e5, 0x19930449,
+    0x197f0005, 0x312, 0x199e000c, 0x86d, 0x281, 0xa0f, 0x48e, 0x3c9,
+    0x307, 0x199b0273, 0x19a00014, 0x199c03b5, 0x2b6, 0x2a8, 0x19780014, 0x19900001,
+    0x19920005, 0x1991000e, 0x3d2, 0xd02, 0x1a1, 0xb3, 0x19950013, 0x19a10009,
+    0x2ac, 0x349, 0x2a2, 0x19a80001, 0x19a40002, 0x3c9, 0xa87, 0x3d9,
+    0x1996000c, 0x19ac0012, 0x19a30012, 0x19a90489, 0x3d3, 0x275, 0x34, 0x19a7000e,
+    0x19a20001, 0x199f000f, 0x450, 0xcf, 0x19ab0365, 0x3d2, 0x3cd, 0x36e,
+    0x19b10489, 0x2a8, 0x19c60001, 0x333, 0x19b90013, 0x3d7, 0x19bb0005, 0x96,
+    0x82, 0xd3, 0x19ae0cb3, 0x19c10014, 0x55, 0x19b40012, 0x3d3, 0x3db,
+    0x2b9, 0x2ba, 0x19b00012, 0x293, 0x19c40485, 0x495, 0x19b60012, 0x281,
+    0x19d60009, 0x307, 0x19ca000f, 0x3ac, 0x19c90012, 0x114, 0x19de0009, 0x19cb0310,
+    0xa2, 0x3c5, 0xb4, 0x19d50014, 0x19d2000e, 0x19ce0001, 0x3d2, 0x19f9000e,
+    0x327, 0x19ee0009, 0x35, 0x19e10481, 0x19dc0002, 0x43, 0x344, 0x19e40005,
+    0x19f00006, 0x43, 0x19d90009, 0x19f50009, 0x333, 0x19d40005, 0x19e9044c, 0x3cf,
+    0x19e8000e, 0x19f2000f, 0x1a010010, 0x19e003a6, 0x27b, 0x1a020013, 0x1a080014, 0x3b5,
+    0x19e60007, 0xbb, 0x3d2, 0x34e, 0x3af, 0x33, 0x3c5, 0x19f60005,
+    0xb2, 0x494, 0x3c9, 0x2b3, 0x305, 0x19f80005, 0x3c5, 0x31a,
+    0x1a070008, 0x1a090029, 0x1a1a0001, 0x309, 0x1a0a0143, 0xa1, 0x1a140005, 0x281,
+    0x1a0d0009, 0x3a3, 0x1a160009, 0x3ce, 0x2ac, 0x1a0f000c, 0x284, 0xba,
+    0x1a150005, 0x350, 0x2a5, 0x42, 0x1a100013, 0x1a1b0014, 0x1a170375, 0x1a1d0012,
+    0x28e, 0x32, 0x3d0, 0x1a210001, 0x26c, 0x352, 0x1a27026e, 0x1a200005,
+    0x29, 0x1a050009, 0x3a5, 0x1a300da9, 0x307, 0x3b4, 0x52c, 0x1a37000e,
+    0xe1, 0x1a3a000f, 0x1a2e0001, 0x27b, 0x1a28000c, 0x53, 0x1a2d000e, 0x1a29000f,
+    0x2a6, 0xa7, 0x1a3b0014, 0x333, 0x1a420009, 0xa3, 0x95, 0x1a39000d,
+    0x28e, 0x3cd, 0x4da, 0x3c5, 0x1a590601, 0x1a450009, 0x3c5, 0x335,
+    0x1a6a0005, 0xac, 0x2a5, 0x1a3e0009, 0x1a930009, 0x2a9, 0x2af, 0x1a4d0009,
+    0x2ba, 0x95, 0x1aba000f, 0x14e2, 0x1a440003, 0xaf, 0x1a5a0009, 0x1a5e0005,
+    0x1a490047, 0x416, 0xa4, 0x75, 0x339, 0x1a4e000c, 0x1a47000d, 0x1a4a000e,
+    0x89, 0x1a4c0010, 0x1a65000f, 0x1a550012, 0x1a5f000c, 0x434, 0x264, 0x3cf,
+    0x1a6e0015, 0x87, 0x8d, 0x285, 0x4fb, 0xa3, 0x1a60000c, 0x1ee,
+    0x1a5b000e, 0x339, 0x85, 0x3bb, 0x1a7b0012, 0x1a760d73, 0x1a820014, 0x324,
+    0x1a7d0005, 0x1a690009, 0x88, 0x425, 0x1a750009, 0x27b, 0x45, 0x1a8003c5,
+    0x1a78000d, 0x32c, 0x1a810014, 0x1a7203ae, 0x2a9, 0x2ae, 0x1a7e0013, 0x1a7a0014,
+    0x333, 0x27b, 0x92, 0x1a83000c, 0x1a870001, 0x4ee, 0x1a960009, 0x1a970004,
+    0x4fb, 0x3a6, 0x1a7f0007, 0x3d9, 0x1aa00005, 0x2af, 0x4b, 0x1a8d03ec,
+    0x4e9, 0x1aae048e, 0x1aa8000f, 0x3d0, 0x4e4, 0x1a8e0012, 0x1aad0013, 0x1aaf0014,
+    0x94, 0x436, 0x4f4, 0xa9, 0xa2, 0x28c, 0x6ce, 0x401,
+    0xe3a, 0x363, 0xa4, 0x4f3, 0x8c, 0x267, 0x1a940009, 0x1aaa0001,
+    0x269, 0x265, 0xa52, 0x4fb, 0x30f, 0x355, 0x2b2, 0x29,
+    0x3c1, 0x92, 0x315, 0x49, 0x1ab40005, 0x42b, 0x1ac8000c, 0x1aa2000d,
+    0x279, 0x3c1, 0x1aac0005, 0xd4, 0x1ab60012, 0x285, 0x1abf0014, 0x3d9,
+    0x29b, 0x54, 0x54, 0x345, 0xaf, 0x4fb, 0x1ac60005, 0x1a8,
+    0x2b2, 0x1aeb0001, 0x482, 0x1ada0009, 0x4f4, 0x1aff0005, 0x436, 0xa5,
+    0x1ae60008, 0x1afa0449, 0x4e, 0x32b, 0x1b0a000c, 0x4c, 0x1b07000e, 0x1b0b150f,
+    0x290, 0x194, 0x1b1a0012, 0x1b160013, 0x274, 0x1aa10002, 0x3e3, 0x49,
+    0x1aed000c, 0x3d9, 0x1ac50007, 0x1ad20012, 0x1ab70009, 0x1acf0014, 0x1aec0009, 0x1ab5000c,
+    0x4d, 0x194, 0xce, 0xb6, 0x45, 0x1abd0012, 0x1abe0013, 0x1ace0014,
+    0x1ae10001, 0x1ad10016, 0x1af70004, 0x1ad40004, 0x1ae50005, 0x47, 0x1ae4014c, 0x425,
+    0x1afe000e, 0x188, 0x30e, 0x1ad9000c, 0x52, 0x1b020013, 0x1b010014, 0x1afd0005,
+    0x3d3, 0x492, 0x1ad50013, 0x1afc0009, 0xba, 0x3b6, 0x32f, 0x1b0c0005,
+    0x6d, 0x1b1b0014, 0x2ae, 0x41, 0x1e1, 0x3c5, 0x3a8, 0x32f,
+    0x3cf, 0x1b120016, 0x3cc, 0x1b050049, 0xa5, 0x1b2e0481, 0x1b180010, 0x903,
+    0x1b170015, 0x1b2b0485, 0x854, 0x1b110014, 0x1b310488, 0x1b3f03a9, 0x1b130003, 0x364,
+    0x49, 0x1b1f0003, 0xcc, 0x1b4203af, 0x1b4603b0, 0x1b100007, 0x2af, 0x2ba,
+    0x1b480a74, 0x1b510495, 0x1b260149, 0x8d, 0x3d8, 0x1b270012, 0x330, 0x2a9,
+    0x2a1, 0xb3, 0x2a3, 0x1b360004, 0x322, 0x325, 0x55, 0x1b3a0001,
+    0x1b49000e, 0x1b1d0009, 0x10f, 0x1b4b0005, 0x1b40000d, 0x24, 0x1b3c0003, 0x84,
+    0x1b3b0014, 0x3a9, 0x301, 0x1b590001, 0x482, 0x1b620483, 0x484, 0x1b690005,
+    0x45, 0x1b5a0007, 0x6c8, 0x489, 0x283, 0x326, 0x1b73000c, 0x1b74000d,
+    0x1b82000e, 0x1b830a0f, 0x1b890010, 0x289, 0x1b930012, 0x1ba10013, 0x1ba00014, 0x1b560365,
+    0x2b2, 0x497, 0x1b5303a8, 0xf12, 0x2d, 0x294, 0x285, 0x1b700001,
+    0xcc, 0x1b5f000f, 0x1b640002, 0x34, 0x3a1, 0x1b6b000f, 0x1b660002, 0xec,
+    0x181, 0x45, 0x1b6c0008, 0x1b570492, 0x53, 0x3d4, 0x312, 0x1b6e000c,
+    0x2a3, 0x1b6f0005, 0x3af, 0x2b4, 0x1b770010, 0x1b720003, 0x2a4, 0x2a4,
+    0x295, 0x2a7, 0x507, 0x1b7d0009, 0x441, 0x323, 0x1b8f0005, 0x333,
+    0x4d, 0x1b7c000e, 0x309, 0x324, 0x1b880001, 0xad, 0x333, 0x2a1,
+    0x1b8a03af, 0x32, 0x4f8, 0x1b9e0003, 0x1b960009, 0x1b8b0014, 0x295, 0x301,
+    0x301, 0xd2, 0x3af, 0x1ba30009, 0x3c3, 0x3d2, 0x905, 0x30f,
+    0x1b9a0008, 0x1ba90009, 0x1b980009, 0x433, 0x303, 0x7a2, 0x2ac, 0x45,
+    0x32f, 0x3ae, 0x32c, 0x30f, 0x53, 0x1b9f0354, 0x1b870015, 0x1bab0341,
+    0x262, 0x333, 0x3ce, 0x1bac03e5, 0x3d0, 0x152, 0x1ba40492, 0x1ba60629,
+    0x54, 0x339, 0x4ec, 0x26d, 0x3cd, 0x1bb7060f, 0x1ba2000f, 0x0,
+    0x0, 0x0, 0x1baa0014, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x1ba80dba, 0x0, 0x0,
+};
+
+static const uint32_t hyphpat_ops[169] = {
+    0x0, 0x404, 0x403, 0x103, 0x303, 0x503, 0x504, 0x505,
+    0x506, 0x204, 0x203, 0x507, 0x304, 0x305, 0x7503, 0x405,
+    0xf304, 0x104, 0x7504, 0x400, 0x501, 0x502, 0x6502, 0x5502,
+    0x302, 0x401, 0x102, 0x201, 0x1b400, 0x301, 0x402, 0x200,
+    0x1e400, 0x300, 0x202, 0x1e401, 0x101, 0x5501, 0x14500, 0x500,
+    0x15401, 0x1a401, 0x4302, 0x1b200, 0x1502, 0x2501, 0x2d500, 0xa402,
+    0x100, 0x24200, 0x24400, 0x22400, 0x15400, 0x2400, 0x1d400, 0x1d200,
+    0xf504, 0x18300, 0x5300, 0x22201, 0x2500, 0x22501, 0x3d200, 0x14400,
+    0x14200, 0x2200, 0x1e501, 0x18400, 0x1a400, 0xa300, 0x5202, 0x23100,
+    0x22301, 0x48400, 0x1503, 0x19300, 0x1b100, 0x1e301, 0x4d200, 0xa202,
+    0x1e101, 0x6503, 0x2301, 0x22101, 0x18401, 0x54100, 0x18500, 0x4401,
+    0x1a100, 0x50400, 0x53200, 0x1a101, 0x3402, 0x2202, 0x6501, 0xc301,
+    0x9102, 0x2401, 0xc302, 0x62401, 0x1101, 0x2302, 0x15201, 0x2402,
+    0x1402, 0x6203, 0x4101, 0x22401, 0x5201, 0x53400, 0x1e100, 0x19500,
+    0x23300, 0x18301, 0x71400, 0x5500, 0x18501, 0x74200, 0x15501, 0xa401,
+    0x2300, 0x1303, 0x4402, 0x1e200, 0x15500, 0x42400, 0x406, 0x1401,
+    0x3d500, 0x1a200, 0x5400, 0x17201, 0x1b500, 0x23400, 0x19100, 0x19400,
+    0x1201, 0x1501, 0x6403, 0xc103, 0x3202, 0x5401, 0x1403, 0x2502,
+    0x51500, 0xd303, 0x1e300, 0x2201, 0x24100, 0x1a300, 0x48200, 0x3b100,
+    0x6302, 0x1e500, 0xd404, 0x2101, 0x9503, 0x7404, 0x1500, 0x4202,
+    0xc303, 0x9303, 0x9202, 0x4500, 0x22200, 0x3401, 0x8504, 0x50200,
+    0x22100,
+};
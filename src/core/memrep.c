@@ -0,0 +1,62 @@
+/**
+ * @file memrep.c
+ * @brief Memory footprint report shared by the formatters
+ *
+ * See memrep.h.  The heap figure comes from mallinfo2() where glibc has
+ * it and is left 0 elsewhere; the resident size comes from the OS layer.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#include "memrep.h"
+#include "os_abstraction.h"
+
+#include <string.h>
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define MEMREP_MALLINFO2 1
+#endif
+
+void otroff_memrep_init(otroff_memrep_t *m, const char *stage) {
+    memset(m, 0, sizeof(*m));
+    m->stage = stage;
+}
+
+void otroff_memrep_buf(otroff_memrep_t *m, const char *name, size_t bytes) {
+    if (m->nbuf < OTROFF_MEMBUFS) {
+        m->buf[m->nbuf].name = name;
+        m->buf[m->nbuf++].bytes = bytes;
+    }
+    m->static_bytes += bytes;
+}
+
+void otroff_memrep_arena(otroff_memrep_t *m, size_t bytes, size_t peak) {
+    m->arena_bytes += bytes;
+    m->arena_peak += peak > bytes ? peak : bytes;
+}
+
+void otroff_memrep_sample(otroff_memrep_t *m) {
+#ifdef MEMREP_MALLINFO2
+    struct mallinfo2 mi;
+
+    mi = mallinfo2();
+    m->heap_bytes = mi.uordblks + mi.hblkhd;
+#endif
+    m->peak_rss_kb = os_peak_rss_kb();
+}
+
+void otroff_memrep_print(const otroff_memrep_t *m, FILE *fp) {
+    int i;
+
+    fprintf(fp, "%s memory, bytes\n", m->stage);
+    for (i = 0; i < m->nbuf; i++) {
+        fprintf(fp, "  static %-17s %10zu\n", m->buf[i].name, m->buf[i].bytes);
+    }
+    fprintf(fp, "  %-24s %10zu\n", "static total", m->static_bytes);
+    fprintf(fp, "  %-24s %10zu\n", "arenas in use", m->arena_bytes);
+    fprintf(fp, "  %-24s %10zu\n", "arenas peak", m->arena_peak);
+    fprintf(fp, "  %-24s %10zu\n", "heap in use", m->heap_bytes);
+    fprintf(fp, "  %-24s %10zu\n", "temporary files", m->temp_bytes);
+    fprintf(fp, "  %-24s %10ld KB\n", "peak resident", m->peak_rss_kb);
+}
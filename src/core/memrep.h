@@ -0,0 +1,97 @@
+/**
+ * @file memrep.h
+ * @brief Memory footprint report shared by the formatters
+ *
+ * Each formatter fills an otroff_memrep_t with its static buffers, at
+ * least the large ones, and with the memory its stores and arenas hold;
+ * otroff_memrep_sample() adds what the process as a whole uses.  A job
+ * scheduler linking a formatter can read the structure directly, and
+ * the formatters print it for -M.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#ifndef OTROFF_MEMREP_H
+#define OTROFF_MEMREP_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OTROFF_MEMBUFS 24 /**< Static buffers a report names */
+
+/**
+ * @brief One named static buffer
+ */
+typedef struct {
+    const char *name;       /**< Its name in the source */
+    size_t bytes;           /**< Its size */
+} otroff_membuf_t;
+
+/**
+ * @brief Memory used by one formatter process
+ */
+typedef struct {
+    const char *stage;      /**< "roff", "croff", "tbl" */
+    otroff_membuf_t buf[OTROFF_MEMBUFS]; /**< The static buffers named */
+    int nbuf;               /**< Entries in buf[] */
+    size_t static_bytes;    /**< Total of buf[] */
+    size_t arena_bytes;     /**< Held by the formatter's stores and arenas */
+    size_t arena_peak;      /**< Most they have held */
+    size_t heap_bytes;      /**< malloc() heap in use, 0 if unknown */
+    size_t temp_bytes;      /**< Bytes in temporary files */
+    long peak_rss_kb;       /**< Peak resident size, 0 if unknown */
+} otroff_memrep_t;
+
+/**
+ * @brief Start a report
+ *
+ * @param m      Report to clear
+ * @param stage  Name of the formatter
+ */
+void otroff_memrep_init(otroff_memrep_t *m, const char *stage);
+
+/**
+ * @brief Name a static buffer
+ *
+ * Buffers past OTROFF_MEMBUFS are counted in static_bytes only.
+ *
+ * @param m      Report
+ * @param name   Buffer name
+ * @param bytes  Its size, usually sizeof the buffer
+ */
+void otroff_memrep_buf(otroff_memrep_t *m, const char *name, size_t bytes);
+
+/**
+ * @brief Add an arena or store
+ *
+ * @param m      Report
+ * @param bytes  What it holds now
+ * @param peak   The most it has held
+ */
+void otroff_memrep_arena(otroff_memrep_t *m, size_t bytes, size_t peak);
+
+/**
+ * @brief Fill in the heap in use and the peak resident size
+ *
+ * @param m  Report
+ */
+void otroff_memrep_sample(otroff_memrep_t *m);
+
+/**
+ * @brief Print a report, one figure to a line
+ *
+ * @param m   Report
+ * @param fp  Where to print it
+ */
+void otroff_memrep_print(const otroff_memrep_t *m, FILE *fp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OTROFF_MEMREP_H */
@@ -0,0 +1,230 @@
+/**
+ * @file mkhyphpat.c
+ * @brief Build the packed hyphenation pattern trie at compile time
+ *
+ * Reads Liang patterns (hyphen.pat) on standard input and writes the C
+ * tables used by hyphpat.c on standard output:
+ *
+ *     mkhyphpat < hyphen.pat > hyphpat_tab.h
+ *
+ * The patterns are first gathered into an ordinary trie and then packed
+ * the way TeX packs its pattern trie: every state with children gets a
+ * distinct base, and the transition on letter code c lives at slot
+ * base + c, tagged with c, so that states share one flat array without
+ * colliding.  Each slot is one 32-bit word: the tag in bits 0-4, the
+ * output list of the pattern ending there in bits 5-15 and the base of
+ * the next state (0 if none) in bits 16-31.  An output entry holds the
+ * letter position in bits 0-7, the digit in bits 8-11 and the next
+ * entry in bits 12 and up.
+ *
+ * @copyright Copyright 1972 Bell Telephone Laboratories Inc.
+ * @copyright Modernization 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define NCODE 28        /* letter codes 1-26, '.' = 27 */
+#define MAXPAT 64       /* longest pattern accepted */
+#define MAXOPS 2048     /* output list entries, 11 bits */
+#define MAXSLOT 65536   /* trie slots, 16-bit links */
+
+/* Trie state before packing */
+struct node {
+    int kid[NCODE];     /* child state by letter code, 0 if none */
+    int op;             /* output list of the pattern ending here */
+    int base;           /* packed base, 0 if the state has no children */
+};
+
+/* Output list entry: value val before pattern letter pos */
+struct op {
+    int pos, val, next;
+};
+
+static struct node *nodes;
+static int nnodes, maxnodes;
+static struct op ops[MAXOPS];
+static int nops = 1;    /* entry 0 means no output */
+static unsigned long slot[MAXSLOT];
+static unsigned char used[MAXSLOT], isbase[MAXSLOT];
+static int nslots;
+
+static void fail(const char *msg) {
+    fprintf(stderr, "mkhyphpat: %s\n", msg);
+    exit(1);
+}
+
+static int newnode(void) {
+    if (nnodes == maxnodes) {
+        maxnodes = maxnodes ? 2 * maxnodes : 1024;
+        if ((nodes = realloc(nodes, maxnodes * sizeof(*nodes))) == NULL)
+            fail("out of memory");
+    }
+    memset(&nodes[nnodes], 0, sizeof(*nodes));
+    return nnodes++;
+}
+
+/* Output list for the digits of one pattern, shared when identical */
+static int oplist(const int *val, int n) {
+    int i, k, head;
+
+    head = 0;
+    for (i = n; i >= 0; i--) {
+        if (!val[i])
+            continue;
+        for (k = 1; k < nops; k++)
+            if (ops[k].pos == i && ops[k].val == val[i] && ops[k].next == head)
+                break;
+        if (k == nops) {
+            if (nops == MAXOPS)
+                fail("too many pattern outputs");
+            ops[nops].pos = i;
+            ops[nops].val = val[i];
+            ops[nops++].next = head;
+        }
+        head = k;
+    }
+    return head;
+}
+
+static void addpat(const char *s) {
+    int code[MAXPAT], val[MAXPAT + 1];
+    int n, i, c, st;
+
+    memset(val, 0, sizeof(val));
+    for (n = 0; *s; s++) {
+        if (isdigit((unsigned char)*s)) {
+            val[n] = *s - '0';
+            continue;
+        }
+        if (n == MAXPAT)
+            fail("pattern too long");
+        if (*s == '.')
+            code[n++] = NCODE - 1;
+        else if (*s >= 'a' && *s <= 'z')
+            code[n++] = *s - 'a' + 1;
+        else
+            fail("bad character in pattern");
+    }
+    for (st = 0, i = 0; i < n; i++) {
+        c = code[i];
+        if (!nodes[st].kid[c]) {
+            int k = newnode(); /* may move nodes[] */
+            nodes[st].kid[c] = k;
+        }
+        st = nodes[st].kid[c];
+    }
+    if (nodes[st].op)
+        fail("duplicate pattern");
+    nodes[st].op = oplist(val, n);
+}
+
+/*
+ * Find a free base for state st and claim its slots.  Candidates are
+ * tried by lining the smallest child up with each free slot in turn.
+ */
+static void place(int st) {
+    static int lofree = 1;
+    int b, c, c0, s, ok;
+
+    for (c0 = 1; !nodes[st].kid[c0]; c0++)
+        ;
+    while (used[lofree])
+        lofree++;
+    for (s = lofree;; s++) {
+        if (s + NCODE > MAXSLOT)
+            fail("packed trie too large");
+        b = s - c0;
+        if (used[s] || b < 1 || isbase[b])
+            continue;
+        for (ok = 1, c = c0 + 1; c < NCODE && ok; c++)
+            if (nodes[st].kid[c] && used[b + c])
+                ok = 0;
+        if (ok)
+            break;
+    }
+    isbase[b] = 1;
+    for (c = 1; c < NCODE; c++)
+        if (nodes[st].kid[c])
+            used[b + c] = 1;
+    nodes[st].base = b;
+    if (b + NCODE > nslots)
+        nslots = b + NCODE;
+}
+
+static int haskids(int st) {
+    int c;
+
+    for (c = 1; c < NCODE; c++)
+        if (nodes[st].kid[c])
+            return 1;
+    return 0;
+}
+
+int main(void) {
+    char tok[2 * MAXPAT + 2];
+    int ch, n, st, c, k, npat;
+
+    newnode();
+    npat = n = 0;
+    while ((ch = getchar()) != EOF) {
+        if (ch == '%' && n == 0) {
+            while ((ch = getchar()) != EOF && ch != '\n')
+                ;
+            continue;
+        }
+        if (isspace(ch)) {
+            if (n) {
+                tok[n] = 0;
+                addpat(tok);
+                npat++;
+                n = 0;
+            }
+            continue;
+        }
+        if (n == (int)sizeof(tok) - 1)
+            fail("pattern too long");
+        tok[n++] = (char)ch;
+    }
+    if (n) {
+        tok[n] = 0;
+        addpat(tok);
+        npat++;
+    }
+
+    /* States are numbered in creation order, so parents come first. */
+    for (st = 0; st < nnodes; st++)
+        if (haskids(st))
+            place(st);
+    for (st = 0; st < nnodes; st++) {
+        if (!nodes[st].base)
+            continue;
+        for (c = 1; c < NCODE; c++) {
+            if (!(k = nodes[st].kid[c]))
+                continue;
+            slot[nodes[st].base + c] =
+                (unsigned long)c | ((unsigned long)nodes[k].op << 5) |
+                ((unsigned long)nodes[k].base << 16);
+        }
+    }
+
+    printf("/* hyphpat_tab.h - generated by mkhyphpat from hyphen.pat; "
+           "do not edit */\n\n");
+    printf("/* %d patterns, %d states, %d output entries */\n", npat, nnodes,
+           nops);
+    printf("#define HYPHPAT_ROOT %d\n", nodes[0].base);
+    printf("#define HYPHPAT_SLOTS %d\n\n", nslots);
+    printf("static const uint32_t hyphpat_trie[HYPHPAT_SLOTS] = {");
+    for (k = 0; k < nslots; k++)
+        printf("%s0x%lx,", (k % 8) ? " " : "\n    ", slot[k]);
+    printf("\n};\n\n");
+    printf("static const uint32_t hyphpat_ops[%d] = {", nops);
+    for (k = 0; k < nops; k++)
+        printf("%s0x%lx,", (k % 8) ? " " : "\n    ",
+               (unsigned long)ops[k].pos | ((unsigned long)ops[k].val << 8) |
+                   ((unsigned long)ops[k].next << 12));
+    printf("\n};\n");
+    return 0;
+}
@@ -0,0 +1,205 @@
+/*
+ * test_blkstore.c - Unit tests for the in-core word block store
+ *
+ * Exercises resident storage, release, resident spans, and spilling
+ * to a temp file once the resident block limit is reached, with the
+ * file made up front or only when the first block spills, and blocks
+ * lent read-only and copied on their first write.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <unistd.h>
+
+#include "blkstore.h"
+
+#define BW 128
+#define BASE (3 * 768)
+
+void test_resident(void) {
+    otroff_blkstore_t st;
+    int *p;
+    int i;
+
+    printf("Testing resident blocks...\n");
+    assert(otroff_blkstore_init(&st, BW, BASE, 0) == 0);
+    assert(otroff_blkstore_word(&st, BASE - 1, 1) == NULL);
+    assert(otroff_blkstore_word(&st, BASE, 0) == NULL);
+
+    for (i = 0; i < 10 * BW; i++) {
+        p = otroff_blkstore_word(&st, BASE + i, 1);
+        assert(p != NULL);
+        *p = i + 1;
+    }
+    for (i = 0; i < 10 * BW; i++)
+        assert(*otroff_blkstore_word(&st, BASE + i, 0) == i + 1);
+    assert(st.resident == 10);
+
+    otroff_blkstore_release(&st, BASE + 3 * BW + 7);
+    assert(st.resident == 9);
+    assert(otroff_blkstore_word(&st, BASE + 3 * BW, 0) == NULL);
+    assert(st.stats.resident_peak == 10);
+    otroff_blkstore_destroy(&st);
+    printf("Resident block tests passed.\n");
+}
+
+void test_span(void) {
+    otroff_blkstore_t st;
+    char path[] = "/tmp/blkstoreXXXXXX";
+    size_t n;
+    int fd, i, *p;
+
+    printf("Testing spans...\n");
+    assert((fd = mkstemp(path)) >= 0);
+    unlink(path);
+    assert(otroff_blkstore_init(&st, BW, BASE, 2) == 0);
+    otroff_blkstore_set_spill(&st, fd);
+    assert(otroff_blkstore_span(&st, BASE, &n) == NULL);
+
+    for (i = 0; i < 3 * BW; i++)
+        *otroff_blkstore_word(&st, BASE + i, 1) = i;
+    p = otroff_blkstore_span(&st, BASE + BW + 5, &n);
+    assert(p != NULL && n == BW - 5);
+    for (i = 0; i < (int)n; i++)
+        assert(p[i] == BW + 5 + i);
+    assert(p == otroff_blkstore_word(&st, BASE + BW + 5, 0));
+
+    /* The third block went to the spill file. */
+    assert(otroff_blkstore_span(&st, BASE + 2 * BW, &n) == NULL);
+    assert(*otroff_blkstore_word(&st, BASE + 2 * BW, 0) == 2 * BW);
+
+    otroff_blkstore_release(&st, BASE + BW);
+    assert(otroff_blkstore_span(&st, BASE + BW, &n) == NULL);
+    otroff_blkstore_destroy(&st);
+    close(fd);
+    printf("Span tests passed.\n");
+}
+
+void test_spill(void) {
+    otroff_blkstore_t st;
+    char path[] = "/tmp/blkstoreXXXXXX";
+    int fd, i;
+
+    printf("Testing spilled blocks...\n");
+    assert((fd = mkstemp(path)) >= 0);
+    unlink(path);
+    assert(otroff_blkstore_init(&st, BW, BASE, 2) == 0);
+    otroff_blkstore_set_spill(&st, fd);
+
+    for (i = 0; i < 6 * BW; i++)
+        *otroff_blkstore_word(&st, BASE + i, 1) = 7 * i;
+    assert(otroff_blkstore_sync(&st) == 0);
+    assert(st.resident == 2);
+    assert(st.stats.spilled == 4);
+
+    /* Read back out of order so every spilled block reloads. */
+    for (i = 6 * BW - 1; i >= 0; i--)
+        assert(*otroff_blkstore_word(&st, BASE + i, 0) == 7 * i);
+    assert(st.stats.spill_reads > 0);
+
+    otroff_blkstore_release(&st, BASE + 5 * BW);
+    assert(st.stats.spilled == 3);
+    otroff_blkstore_destroy(&st);
+    close(fd);
+    printf("Spilled block tests passed.\n");
+}
+
+static int opened;
+
+static int open_tmp(void *arg) {
+    char path[] = "/tmp/blkstoreXXXXXX";
+    int fd;
+
+    assert(arg == &opened);
+    opened++;
+    if ((fd = mkstemp(path)) >= 0)
+        unlink(path);
+    return fd;
+}
+
+static int open_none(void *arg) {
+    (void)arg;
+    opened++;
+    return -1;
+}
+
+void test_lazy_spill(void) {
+    otroff_blkstore_t st;
+    int i;
+
+    printf("Testing a spill file made on demand...\n");
+    assert(otroff_blkstore_init(&st, BW, BASE, 4) == 0);
+    otroff_blkstore_set_spill_open(&st, open_tmp, &opened);
+    for (i = 0; i < 4 * BW; i++)
+        *otroff_blkstore_word(&st, BASE + i, 1) = i;
+    assert(opened == 0 && st.spill_fd < 0);
+    for (i = 4 * BW; i < 8 * BW; i++)
+        *otroff_blkstore_word(&st, BASE + i, 1) = i;
+    assert(opened == 1 && st.spill_fd >= 0);
+    assert(st.resident == 4 && st.stats.spilled == 4);
+    for (i = 8 * BW - 1; i >= 0; i--)
+        assert(*otroff_blkstore_word(&st, BASE + i, 0) == i);
+    close(st.spill_fd);
+    otroff_blkstore_destroy(&st);
+
+    /* no file to be had: asked once, then everything stays resident */
+    opened = 0;
+    assert(otroff_blkstore_init(&st, BW, BASE, 2) == 0);
+    otroff_blkstore_set_spill_open(&st, open_none, NULL);
+    for (i = 0; i < 6 * BW; i++)
+        *otroff_blkstore_word(&st, BASE + i, 1) = i;
+    assert(opened == 1 && st.resident == 6 && st.stats.spilled == 0);
+    otroff_blkstore_destroy(&st);
+    printf("Lazy spill tests passed.\n");
+}
+
+void test_lend(void) {
+    otroff_blkstore_t st;
+    static int words[2 * BW];
+    size_t n;
+    int i, *p;
+
+    printf("Testing lent blocks...\n");
+    for (i = 0; i < 2 * BW; i++)
+        words[i] = 3 * i;
+    assert(otroff_blkstore_init(&st, BW, BASE, 1) == 0);
+    *otroff_blkstore_word(&st, BASE, 1) = 99;
+    assert(otroff_blkstore_lend(&st, BASE - 1, words) == -1);
+    assert(otroff_blkstore_lend(&st, BASE, words) == 0);
+    assert(otroff_blkstore_lend(&st, BASE + BW, words + BW) == 0);
+    assert(st.resident == 0 && st.stats.lent == 2);
+    assert(otroff_blkstore_lent(&st, BASE + 5) && !otroff_blkstore_lent(&st, BASE + 2 * BW));
+
+    /* Reads come from the lent words in place */
+    assert(otroff_blkstore_word(&st, BASE + 5, 0) == &words[5]);
+    p = otroff_blkstore_span(&st, BASE + BW, &n);
+    assert(p == &words[BW] && n == BW);
+
+    /* A write copies the block first; the lent words never change */
+    p = otroff_blkstore_word(&st, BASE + BW + 1, 1);
+    assert(p != NULL && p != &words[BW + 1]);
+    *p = -1;
+    assert(words[BW + 1] == 3 * (BW + 1));
+    assert(*otroff_blkstore_word(&st, BASE + BW + 2, 0) == 3 * (BW + 2));
+    assert(!otroff_blkstore_lent(&st, BASE + BW));
+    assert(st.resident == 1 && st.stats.lent == 1 && st.stats.lent_copies == 1);
+
+    otroff_blkstore_release(&st, BASE);
+    assert(st.stats.lent == 0 && otroff_blkstore_word(&st, BASE, 0) == NULL);
+    otroff_blkstore_destroy(&st);
+    printf("Lent block tests passed.\n");
+}
+
+int main(void) {
+    printf("Starting blkstore unit tests...\n\n");
+
+    test_resident();
+    test_span();
+    test_spill();
+    test_lazy_spill();
+    test_lend();
+
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * test_digram.c - Unit tests and benchmark for the digram hyphenation engine
+ *
+ * Checks otroff_digram_scores() against products of single table
+ * lookups, otroff_digram_breaks() against the breaks troff finds, and
+ * their argument handling, then times otroff_digram_breaks() on random
+ * words to give one place to measure changes to the tables or the kernel.
+ *
+ *   cc -std=c17 -O2 -march=native -Isrc/core src/core/test_digram.c \
+ *       src/core/digram.c -o test_digram
+ */
+
+#define _POSIX_C_SOURCE 200809L /* clock_gettime() */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+
+#include "hyphenation.h"
+
+#define BENCHN 200000 /* words hyphenated by the benchmark */
+
+/* Score of the break before word[i], one lookup at a time */
+static int refscore(const char *w, size_t len, size_t i) {
+    int c[OTROFF_MAX_WORD_LENGTH];
+    size_t k;
+    int v;
+
+    if (i < 1 || i + 1 >= len)
+        return 0;
+    for (k = 0; k < len; k++)
+        c[k] = (w[k] | 040) - 'a';
+    k = i - 1;
+    if (k == 0)
+        v = otroff_digram_weight(OTROFF_DIG_BXH, 0, c[0]);
+    else if (k == 1)
+        v = otroff_digram_weight(OTROFF_DIG_BXXH, c[0], c[1]);
+    else
+        v = otroff_digram_weight(OTROFF_DIG_XXH, c[k - 1], c[k]);
+    v *= otroff_digram_weight(OTROFF_DIG_XHX, c[k], c[k + 1]);
+    v *= otroff_digram_weight(OTROFF_DIG_HXX, c[k + 1], c[k + 2]);
+    return v;
+}
+
+/* Hyphenate w with the default threshold and compare with want */
+static void check(const char *w, const char *want) {
+    unsigned char brk[OTROFF_MAX_WORD_LENGTH];
+    char got[2 * OTROFF_MAX_WORD_LENGTH + 1];
+    size_t i, n, k;
+
+    n = strlen(w);
+    assert(otroff_digram_breaks(w, n, n, OTROFF_DIGRAM_THRESH, brk) >= 0);
+    for (i = k = 0; i < n; i++) {
+        if (brk[i])
+            got[k++] = '-';
+        got[k++] = w[i];
+    }
+    got[k] = 0;
+    if (strcmp(got, want) != 0)
+        printf("  %s: got %s, want %s\n", w, got, want);
+    assert(strcmp(got, want) == 0);
+}
+
+void test_scores(void) {
+    char w[OTROFF_MAX_WORD_LENGTH];
+    int score[OTROFF_MAX_WORD_LENGTH];
+    size_t i, n;
+    int t;
+
+    printf("Testing scores against single lookups...\n");
+    srand(19);
+    for (t = 0; t < 2000; t++) {
+        n = 3 + rand() % (OTROFF_MAX_WORD_LENGTH - 2);
+        for (i = 0; i < n; i++)
+            w[i] = (char)((rand() & 1 ? 'a' : 'A') + rand() % 26);
+        assert(otroff_digram_scores(w, n, score) == 0);
+        for (i = 0; i < n; i++)
+            assert(score[i] == refscore(w, n, i));
+    }
+    printf("Score tests passed.\n");
+}
+
+void test_breaks(void) {
+    unsigned char brk[8];
+
+    printf("Testing digram breaks...\n");
+    check("concatenation", "con-catena-tion");
+    check("understanding", "un-der-stan-ding");
+    check("algorithm", "al-gor-ithm");
+    check("hello", "hel-lo");
+
+    /* Only the stem is walked. */
+    assert(otroff_digram_breaks("hello", 5, 2, OTROFF_DIGRAM_THRESH, brk) == 0);
+    assert(otroff_digram_breaks(NULL, 5, 5, 0, brk) == OTROFF_HYPHEN_ERROR_INVALID_ARG);
+    assert(otroff_digram_breaks("ab1cd", 5, 5, 0, brk) == OTROFF_HYPHEN_ERROR_NO_ALPHA);
+    assert(otroff_digram_weight(OTROFF_DIG_HXX, 26, 0) == 0);
+    printf("Break tests passed.\n");
+}
+
+static double now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+void bench(void) {
+    static char words[256][12];
+    unsigned char brk[12];
+    long nbrk;
+    double t;
+    int i, k;
+
+    for (i = 0; i < 256; i++)
+        for (k = 0; k < 12; k++)
+            words[i][k] = (char)('a' + (int)(((i * 12 + k) * 2654435761u) >> 27) % 26);
+    nbrk = 0;
+    t = now();
+    for (i = 0; i < BENCHN; i++)
+        nbrk += otroff_digram_breaks(words[i & 255], 6 + i % 7, 6 + i % 7,
+                                     OTROFF_DIGRAM_THRESH, brk);
+    t = now() - t;
+    printf("%-10s %8d words %10.0f words/sec (%ld breaks)\n", "digram", BENCHN,
+           t > 0 ? BENCHN / t : 0.0, nbrk);
+}
+
+int main(void) {
+    printf("Starting digram unit tests...\n\n");
+
+    test_scores();
+    test_breaks();
+    bench();
+
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
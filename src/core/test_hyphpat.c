@@ -0,0 +1,79 @@
+/*
+ * test_hyphpat.c - Unit tests for the pattern hyphenation engine
+ *
+ * Checks otroff_hyphen_pattern() against the breaks TeX finds with the
+ * same patterns, its argument handling, and the letter limits at the
+ * ends of a word.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "hyphenation.h"
+
+/* Hyphenate w and compare with the expected form, hyphens included */
+static void check(const char *w, const char *want) {
+    unsigned char brk[OTROFF_MAX_WORD_LENGTH];
+    char got[2 * OTROFF_MAX_WORD_LENGTH + 1];
+    size_t i, n, k;
+
+    n = strlen(w);
+    assert(otroff_hyphen_pattern(w, n, brk) >= 0);
+    for (i = k = 0; i < n; i++) {
+        if (brk[i])
+            got[k++] = '-';
+        got[k++] = w[i];
+    }
+    got[k] = 0;
+    if (strcmp(got, want) != 0)
+        printf("  %s: got %s, want %s\n", w, got, want);
+    assert(strcmp(got, want) == 0);
+}
+
+void test_words(void) {
+    printf("Testing pattern breaks...\n");
+    check("hyphenation", "hy-phen-ation");
+    check("concatenation", "con-cate-na-tion");
+    check("algorithm", "al-go-rithm");
+    check("typesetting", "type-set-ting");
+    check("associate", "as-so-ci-ate");
+    check("incomprehensible", "in-com-pre-hen-si-ble");
+    check("Mississippi", "Mis-sis-sippi");
+    check("computer", "com-puter");
+    check("table", "table");
+    printf("Pattern break tests passed.\n");
+}
+
+void test_limits(void) {
+    unsigned char brk[OTROFF_MAX_WORD_LENGTH + 8];
+    char w[OTROFF_MAX_WORD_LENGTH + 8];
+    size_t i;
+
+    printf("Testing limits...\n");
+    assert(otroff_hyphen_pattern(NULL, 4, brk) == OTROFF_HYPHEN_ERROR_INVALID_ARG);
+    assert(otroff_hyphen_pattern("an", 2, brk) == OTROFF_HYPHEN_ERROR_TOO_SHORT);
+    assert(otroff_hyphen_pattern("ab1cd", 5, brk) == OTROFF_HYPHEN_ERROR_NO_ALPHA);
+
+    /* No break is ever closer to the ends than the minimums. */
+    assert(otroff_hyphen_pattern("apparently", 10, brk) >= 0);
+    for (i = 0; i < OTROFF_PAT_LEFTMIN; i++)
+        assert(!brk[i]);
+    for (i = 10 - OTROFF_PAT_RIGHTMIN + 1; i < 10; i++)
+        assert(!brk[i]);
+
+    /* Words past the maximum are left alone. */
+    memset(w, 'a', sizeof(w));
+    assert(otroff_hyphen_pattern(w, OTROFF_MAX_WORD_LENGTH + 1, brk) == 0);
+    printf("Limit tests passed.\n");
+}
+
+int main(void) {
+    printf("Starting hyphpat unit tests...\n\n");
+
+    test_words();
+    test_limits();
+
+    printf("\nAll tests passed successfully!\n");
+    return 0;
+}
@@ -11,6 +11,8 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <stdint.h>
+#include <stdatomic.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -33,6 +35,41 @@ int os_stat(const char *path, struct stat *buf);
 FILE *os_fopen(const char *path, const char *mode);
 int os_fclose(FILE *file);
 
+/*
+ * Positioned and gathered I/O.  os_pread() and os_pwrite() leave the
+ * file offset alone.  os_writev() writes every byte of the n pieces,
+ * going on after short writes and interrupts, and returns the total or
+ * -1.
+ */
+typedef struct {
+    const void *base;
+    size_t len;
+} os_iovec_t;
+
+ssize_t os_pread(int fd, void *buf, size_t count, off_t offset);
+ssize_t os_pwrite(int fd, const void *buf, size_t count, off_t offset);
+ssize_t os_writev(int fd, const os_iovec_t *iov, int n);
+
+/*
+ * Read-only mappings of whole files.  os_map_file() maps fd and sets
+ * *size; NULL for a file that is empty, not regular or cannot be
+ * mapped, when the caller reads it instead.  The mapping outlives fd.
+ * The hints say how the caller means to go through a file or a
+ * mapping; they are advice, and do nothing where there is no such
+ * call.
+ */
+enum {
+    OS_ADV_NORMAL,
+    OS_ADV_SEQUENTIAL,  /* front to back: read ahead, drop behind */
+    OS_ADV_RANDOM,      /* no read-ahead */
+    OS_ADV_WILLNEED     /* start reading it in now */
+};
+
+void *os_map_file(int fd, size_t *size);
+void os_unmap(void *p, size_t size);
+int os_advise(int fd, off_t offset, off_t len, int how);
+int os_map_advise(void *p, size_t size, int how);
+
 /* Process and system operations */
 int os_fork(void);
 int os_exec(const char* path, char* const argv[]);
@@ -41,6 +78,103 @@ const char* os_get_error(void);
 int os_get_errno(void);
 char* os_getenv(const char* name);
 int os_setenv(const char* name, const char* value, int overwrite);
+long os_peak_rss_kb(void); /* most resident memory so far, 0 if unknown */
+
+/*
+ * Measurement.  os_now_ns() reads a monotonic clock, in nanoseconds
+ * from some fixed point; it makes no system call where the C library
+ * reads the clock in user space, so it can go around every request.
+ * os_thread_cputime_ns() is the CPU time of the calling thread.
+ * os_rusage() fills in what the process has used so far; a figure the
+ * system does not keep is 0.
+ */
+typedef struct {
+    uint64_t user_ns;           /* CPU time in the program */
+    uint64_t sys_ns;            /* and in the kernel for it */
+    long peak_rss_kb;           /* most resident memory */
+    long minflt;                /* page faults served from memory */
+    long majflt;                /* page faults that read the disk */
+    long nvcsw;                 /* context switches while waiting */
+    long nivcsw;                /* context switches when preempted */
+} os_rusage_t;
+
+uint64_t os_now_ns(void);
+uint64_t os_thread_cputime_ns(void);
+int os_rusage(os_rusage_t *ru);
+
+/*
+ * Asynchronous reads and writes.  os_aio_submit() queues a request and
+ * returns at once; os_aio_reap() hands back results in the order they
+ * finish, each with the user pointer of its request and what a read()
+ * or write() would have returned, or -errno.  At most depth requests
+ * are in flight.  The offset -1 means the file's own offset, as for a
+ * pipe.  Linux uses io_uring when the kernel allows it, Windows an I/O
+ * completion port; otherwise (or with OS_AIO_THREADS) worker threads
+ * make the calls.  os_aio_close() waits for what is in flight.
+ */
+enum { OS_AIO_READ, OS_AIO_WRITE };
+#define OS_AIO_THREADS 1 /* os_aio_open(): never io_uring or a port */
+
+typedef struct {
+    int op;                     /* OS_AIO_READ or OS_AIO_WRITE */
+    int fd;
+    void *buf;
+    size_t len;
+    off_t offset;
+    void *user;
+} os_aio_req_t;
+
+typedef struct {
+    void *user;
+    ssize_t res;
+} os_aio_done_t;
+
+typedef struct os_aio os_aio_t;
+
+os_aio_t *os_aio_open(unsigned depth, int flags);
+int os_aio_submit(os_aio_t *q, const os_aio_req_t *r); /* 0, or -1 when full */
+int os_aio_reap(os_aio_t *q, os_aio_done_t *d, int wait); /* 1 if *d was set */
+unsigned os_aio_pending(const os_aio_t *q);
+const char *os_aio_backend(const os_aio_t *q);
+void os_aio_close(os_aio_t *q);
+
+/*
+ * Waiting on a 32-bit word: os_wait32() sleeps while *addr holds val,
+ * until os_wake32() on the same word (futex on Linux, WaitOnAddress on
+ * Windows).  It can return early; the caller checks again.
+ */
+void os_wait32(_Atomic(uint32_t) *addr, uint32_t val);
+void os_wake32(_Atomic(uint32_t) *addr);
+
+/*
+ * Byte stream from one thread to one other (os_ring.c).  The writer
+ * asks for space with os_ring_wspan(), fills it in place and makes it
+ * visible with os_ring_publish(); the reader takes what is there with
+ * os_ring_rspan() and gives it back with os_ring_consume().  Neither
+ * side locks.  A side that has to wait sleeps in os_wait32(), and is
+ * woken only if it said it was sleeping.
+ */
+typedef struct {
+    unsigned char *buf;
+    size_t size;                /* a power of two */
+    _Atomic(size_t) head;       /* bytes published, ever */
+    _Atomic(size_t) tail;       /* bytes consumed, ever */
+    _Atomic(uint32_t) wseq;     /* bumped on each publish and on close */
+    _Atomic(uint32_t) rseq;     /* bumped on each consume */
+    _Atomic(uint32_t) rsleep;   /* the reader waits on wseq */
+    _Atomic(uint32_t) wsleep;   /* the writer waits on rseq */
+    _Atomic(uint32_t) closed;   /* the writer is done */
+} os_ring_t;
+
+int os_ring_init(os_ring_t *r, size_t size);
+void os_ring_free(os_ring_t *r);
+size_t os_ring_wspan(os_ring_t *r, unsigned char **p, size_t want);
+void os_ring_publish(os_ring_t *r, size_t n);
+size_t os_ring_rspan(os_ring_t *r, const unsigned char **p);
+void os_ring_consume(os_ring_t *r, size_t n);
+void os_ring_close(os_ring_t *r);
+size_t os_ring_write(os_ring_t *r, const void *buf, size_t n);
+size_t os_ring_read(os_ring_t *r, void *buf, size_t n);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,187 @@
+#include "os_acct.h"
+
+/*
+ * Tally of allocation and raw I/O for OSACCT builds (os_acct.h).
+ *
+ * Each call site has an entry, found by the address of its "file:line"
+ * string in an open-addressed table of OSASITES, with a count and a
+ * byte total for each kind of call.  The table is static, so counting
+ * allocates nothing and leaves errno alone, and a spin lock covers it,
+ * as croff's output thread writes too.  Once the table is full the
+ * sites left over are counted together.
+ *
+ * osa_report() prints the totals of each tag and then each site, by tag
+ * and busiest first; osa_json() writes the sites as the "sys" member of
+ * a -S JSON object.
+ */
+
+#ifdef OSACCT
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#define OSASITES 1024 /* sites kept, a power of two */
+
+struct osasite {
+    const char *site;           /* "file:line", NULL for a free slot */
+    const char *tag;
+    unsigned long long n[OSA_NKIND];
+    unsigned long long bytes[OSA_NKIND];
+};
+
+static struct osasite sites[OSASITES];
+static struct osasite more = {"(more sites)", "other", {0}, {0}};
+static int nsites;
+static atomic_flag lock = ATOMIC_FLAG_INIT;
+
+static void osa_count(const char *tag, const char *site, int kind, size_t bytes) {
+    struct osasite *s;
+    unsigned k;
+
+    while (atomic_flag_test_and_set_explicit(&lock, memory_order_acquire))
+        ;
+    k = (unsigned)(((uintptr_t)site >> 2) * 2654435761u) & (OSASITES - 1);
+    while (sites[k].site != NULL && sites[k].site != site)
+        k = (k + 1) & (OSASITES - 1);
+    s = &sites[k];
+    if (s->site == NULL) {
+        if (4 * (nsites + 1) > 3 * OSASITES) {
+            s = &more;
+        } else {
+            s->site = site;
+            s->tag = tag;
+            nsites++;
+        }
+    }
+    s->n[kind]++;
+    s->bytes[kind] += bytes;
+    atomic_flag_clear_explicit(&lock, memory_order_release);
+}
+
+void *osa_malloc(const char *tag, const char *site, size_t n) {
+    osa_count(tag, site, OSA_KALLOC, n);
+    return malloc(n);
+}
+
+void *osa_calloc(const char *tag, const char *site, size_t n, size_t size) {
+    osa_count(tag, site, OSA_KALLOC, n * size);
+    return calloc(n, size);
+}
+
+void *osa_realloc(const char *tag, const char *site, void *p, size_t n) {
+    osa_count(tag, site, OSA_KREALLOC, n);
+    return realloc(p, n);
+}
+
+void osa_free(const char *tag, const char *site, void *p) {
+    if (p != NULL)
+        osa_count(tag, site, OSA_KFREE, 0);
+    free(p);
+}
+
+/* A read or write call made, which returned r */
+ssize_t osa_io(const char *tag, const char *site, int kind, ssize_t r) {
+    osa_count(tag, site, kind, r > 0 ? (size_t)r : 0);
+    return r;
+}
+
+static unsigned long long osa_calls(const struct osasite *s) {
+    unsigned long long n = 0;
+    int k;
+
+    for (k = 0; k < OSA_NKIND; k++)
+        n += s->n[k];
+    return n;
+}
+
+/* By tag, then busiest first, then by site */
+static int osa_cmp(const void *a, const void *b) {
+    const struct osasite *x = a, *y = b;
+    unsigned long long m = osa_calls(x), n = osa_calls(y);
+    int c;
+
+    if ((c = strcmp(x->tag, y->tag)) != 0)
+        return c;
+    if (m != n)
+        return m < n ? 1 : -1;
+    return strcmp(x->site, y->site);
+}
+
+/* The sites in use, sorted, in a copy of the table; NULL if none */
+static struct osasite *osa_take(int *np) {
+    struct osasite *t;
+    int i, n;
+
+    while (atomic_flag_test_and_set_explicit(&lock, memory_order_acquire))
+        ;
+    if ((t = malloc((nsites + 1) * sizeof(*t))) != NULL) {
+        for (n = i = 0; i < OSASITES; i++)
+            if (sites[i].site != NULL)
+                t[n++] = sites[i];
+        if (osa_calls(&more))
+            t[n++] = more;
+        *np = n;
+    }
+    atomic_flag_clear_explicit(&lock, memory_order_release);
+    if (t != NULL)
+        qsort(t, *np, sizeof(*t), osa_cmp);
+    return t;
+}
+
+static void osa_line(FILE *fp, const char *name, const struct osasite *s) {
+    fprintf(fp, "%-28s %9llu %8llu %11llu %9llu %9llu %11llu %9llu %11llu\n", name,
+            s->n[OSA_KALLOC], s->n[OSA_KREALLOC], s->bytes[OSA_KALLOC] + s->bytes[OSA_KREALLOC],
+            s->n[OSA_KFREE], s->n[OSA_KREAD], s->bytes[OSA_KREAD],
+            s->n[OSA_KWRITE], s->bytes[OSA_KWRITE]);
+}
+
+/* Print the totals of each tag, then each site */
+void osa_report(FILE *fp) {
+    struct osasite *t, sum;
+    char name[64];
+    int i, j, k, n;
+
+    if ((t = osa_take(&n)) == NULL)
+        return;
+    fprintf(fp, "%-28s %9s %8s %11s %9s %9s %11s %9s %11s\n", "allocation and I/O", "allocs",
+            "reallocs", "bytes", "frees", "reads", "bytes", "writes", "bytes");
+    for (i = 0; i < n; i = j) {
+        memset(&sum, 0, sizeof(sum));
+        for (j = i; j < n && strcmp(t[j].tag, t[i].tag) == 0; j++)
+            for (k = 0; k < OSA_NKIND; k++) {
+                sum.n[k] += t[j].n[k];
+                sum.bytes[k] += t[j].bytes[k];
+            }
+        osa_line(fp, t[i].tag, &sum);
+    }
+    for (i = 0; i < n; i++) {
+        snprintf(name, sizeof(name), "  %s", t[i].site);
+        osa_line(fp, name, &t[i]);
+    }
+    free(t);
+}
+
+/* Write the sites as "sys":[...], for a -S JSON object */
+void osa_json(FILE *fp) {
+    static const char *const kind[OSA_NKIND] = {"alloc", "realloc", "free", "read", "write"};
+    struct osasite *t;
+    int i, k, n;
+
+    if ((t = osa_take(&n)) == NULL)
+        return;
+    fprintf(fp, "\"sys\":[");
+    for (i = 0; i < n; i++) {
+        fprintf(fp, "%s\n{\"tag\":\"%s\",\"site\":\"%s\"", i ? "," : "", t[i].tag, t[i].site);
+        for (k = 0; k < OSA_NKIND; k++)
+            fprintf(fp, ",\"%ss\":%llu,\"%s_bytes\":%llu", kind[k], t[i].n[k], kind[k],
+                    t[i].bytes[k]);
+        fprintf(fp, "}");
+    }
+    fprintf(fp, "],");
+    free(t);
+}
+
+#else
+typedef int osa_none; /* ISO C wants a declaration in every file */
+#endif
@@ -0,0 +1,79 @@
+#ifndef OS_ACCT_H
+#define OS_ACCT_H
+
+/*
+ * Accounting of allocation and raw I/O, by subsystem and call site.
+ *
+ * Built with OSACCT (make SYSACCT=1), the wrappers below count each
+ * allocation, free, read and write, and the bytes asked for or moved,
+ * against the call site and the tag of the file it is in, given by
+ * OSA_TAG before this header is included.  The -S report of croff, tbl,
+ * neqn and roff prints the tally (os_acct.c).  Without OSACCT every
+ * wrapper is the call it wraps and the report is nothing.
+ *
+ * OSA_IO() wraps any call returning what read() or write() would, such
+ * as os_pread() or os_writev(); the count goes to the call, the bytes
+ * to what it returns.  A free() is counted but its bytes are not known.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef OSA_TAG
+#define OSA_TAG "other"
+#endif
+
+/* Kinds of call */
+enum {
+    OSA_KALLOC,     /* malloc() and calloc() */
+    OSA_KREALLOC,
+    OSA_KFREE,
+    OSA_KREAD,
+    OSA_KWRITE,
+    OSA_NKIND
+};
+
+#ifdef OSACCT
+
+#define OSA_STR1(x) #x
+#define OSA_STR(x) OSA_STR1(x)
+#define OSA_SITE __FILE__ ":" OSA_STR(__LINE__)
+
+void *osa_malloc(const char *tag, const char *site, size_t n);
+void *osa_calloc(const char *tag, const char *site, size_t n, size_t size);
+void *osa_realloc(const char *tag, const char *site, void *p, size_t n);
+void osa_free(const char *tag, const char *site, void *p);
+ssize_t osa_io(const char *tag, const char *site, int kind, ssize_t r);
+void osa_report(FILE *fp);
+void osa_json(FILE *fp);
+
+#define OSA_MALLOC(n) osa_malloc(OSA_TAG, OSA_SITE, (n))
+#define OSA_CALLOC(n, size) osa_calloc(OSA_TAG, OSA_SITE, (n), (size))
+#define OSA_REALLOC(p, n) osa_realloc(OSA_TAG, OSA_SITE, (p), (n))
+#define OSA_FREE(p) osa_free(OSA_TAG, OSA_SITE, (p))
+#define OSA_IO(kind, call) osa_io(OSA_TAG, OSA_SITE, (kind), (call))
+#else
+#define OSA_MALLOC(n) malloc(n)
+#define OSA_CALLOC(n, size) calloc((n), (size))
+#define OSA_REALLOC(p, n) realloc((p), (n))
+#define OSA_FREE(p) free(p)
+#define OSA_IO(kind, call) (call)
+#define osa_report(fp) ((void)0)
+#define osa_json(fp) ((void)0)
+#endif
+
+#define OSA_READ(fd, buf, n) OSA_IO(OSA_KREAD, read((fd), (buf), (n)))
+#define OSA_WRITE(fd, buf, n) OSA_IO(OSA_KWRITE, write((fd), (buf), (n)))
+#define OSA_PREAD(fd, buf, n, off) OSA_IO(OSA_KREAD, pread((fd), (buf), (n), (off)))
+#define OSA_PWRITE(fd, buf, n, off) OSA_IO(OSA_KWRITE, pwrite((fd), (buf), (n), (off)))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OS_ACCT_H */
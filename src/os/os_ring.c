@@ -0,0 +1,146 @@
+#include "os_abstraction.h"
+#define OSA_TAG "os"
+#include "os_acct.h"
+
+/*
+ * Byte ring from one producer thread to one consumer thread.
+ *
+ * head and tail count bytes ever published and consumed, so the fill
+ * is head - tail and wraps with size_t.  Each side only stores its own
+ * counter.  A side that must wait reads the other side's sequence
+ * word, says it is sleeping, looks once more and then waits on the
+ * word; the other side bumps the word after it moves its counter and
+ * wakes the sleeper only if it said so.  So a stream that never fills
+ * or drains makes no system calls.
+ */
+
+int os_ring_init(os_ring_t *r, size_t size) {
+    size_t n;
+
+    for (n = 64; n < size; n <<= 1)
+        if (n > SIZE_MAX / 2)
+            return -1;
+    memset(r, 0, sizeof(*r));
+    if ((r->buf = OSA_MALLOC(n)) == NULL)
+        return -1;
+    r->size = n;
+    return 0;
+}
+
+void os_ring_free(os_ring_t *r) {
+    OSA_FREE(r->buf);
+    r->buf = NULL;
+}
+
+static size_t room(os_ring_t *r) {
+    return r->size - (atomic_load(&r->head) - atomic_load(&r->tail));
+}
+
+/*
+ * Space to write into at *p; its length, at least want if that fits,
+ * or all the ring holds, and less only where the ring wraps.  Waits
+ * for the reader to make that much room.
+ */
+size_t os_ring_wspan(os_ring_t *r, unsigned char **p, size_t want) {
+    size_t need, have, at;
+    uint32_t seq;
+
+    need = want == 0 ? 1 : want < r->size ? want : r->size;
+    for (;;) {
+        seq = atomic_load(&r->rseq);
+        if ((have = room(r)) >= need)
+            break;
+        atomic_store(&r->wsleep, 1);
+        if ((have = room(r)) >= need) {
+            atomic_store(&r->wsleep, 0);
+            break;
+        }
+        os_wait32(&r->rseq, seq);
+        atomic_store(&r->wsleep, 0);
+    }
+    at = atomic_load_explicit(&r->head, memory_order_relaxed) & (r->size - 1);
+    *p = r->buf + at;
+    return have < r->size - at ? have : r->size - at;
+}
+
+/* Make the n bytes written at the span visible to the reader. */
+void os_ring_publish(os_ring_t *r, size_t n) {
+    atomic_fetch_add(&r->head, n);
+    atomic_fetch_add(&r->wseq, 1);
+    if (atomic_load(&r->rsleep))
+        os_wake32(&r->wseq);
+}
+
+/* No more is written; the reader sees the end once it has read the rest. */
+void os_ring_close(os_ring_t *r) {
+    atomic_store(&r->closed, 1);
+    atomic_fetch_add(&r->wseq, 1);
+    if (atomic_load(&r->rsleep))
+        os_wake32(&r->wseq);
+}
+
+/*
+ * What there is to read, at *p, up to where the ring wraps; waits for
+ * the writer.  0 once the ring is closed and empty.
+ */
+size_t os_ring_rspan(os_ring_t *r, const unsigned char **p) {
+    size_t n, at;
+    uint32_t seq, closed;
+
+    for (;;) {
+        seq = atomic_load(&r->wseq);
+        closed = atomic_load(&r->closed); /* before head: nothing published after it */
+        if ((n = atomic_load(&r->head) - atomic_load(&r->tail)) > 0 || closed)
+            break;
+        atomic_store(&r->rsleep, 1);
+        closed = atomic_load(&r->closed);
+        if ((n = atomic_load(&r->head) - atomic_load(&r->tail)) > 0 || closed) {
+            atomic_store(&r->rsleep, 0);
+            break;
+        }
+        os_wait32(&r->wseq, seq);
+        atomic_store(&r->rsleep, 0);
+    }
+    at = atomic_load_explicit(&r->tail, memory_order_relaxed) & (r->size - 1);
+    *p = r->buf + at;
+    return n < r->size - at ? n : r->size - at;
+}
+
+/* Give back n bytes of the span read, to be written again. */
+void os_ring_consume(os_ring_t *r, size_t n) {
+    atomic_fetch_add(&r->tail, n);
+    atomic_fetch_add(&r->rseq, 1);
+    if (atomic_load(&r->wsleep))
+        os_wake32(&r->rseq);
+}
+
+/* Copy n bytes in, waiting for room as needed. */
+size_t os_ring_write(os_ring_t *r, const void *buf, size_t n) {
+    const unsigned char *s = buf;
+    unsigned char *p;
+    size_t k, done;
+
+    for (done = 0; done < n; done += k) {
+        k = os_ring_wspan(r, &p, n - done);
+        if (k > n - done)
+            k = n - done;
+        memcpy(p, s + done, k);
+        os_ring_publish(r, k);
+    }
+    return n;
+}
+
+/* Copy out what there is, at most n bytes, as read() would; 0 at the end. */
+size_t os_ring_read(os_ring_t *r, void *buf, size_t n) {
+    unsigned char *d = buf;
+    const unsigned char *p;
+    size_t k;
+
+    if (n == 0 || (k = os_ring_rspan(r, &p)) == 0)
+        return 0;
+    if (k > n)
+        k = n;
+    memcpy(d, p, k);
+    os_ring_consume(r, k);
+    return k;
+}
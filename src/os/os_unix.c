@@ -1,4 +1,20 @@
 #include "os_abstraction.h"
+#define OSA_TAG "os"
+#include "os_acct.h"
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#else
+#include <sched.h>
+#endif
+#include <sys/resource.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <limits.h>
+#include <pthread.h>
+#include <time.h>
 
 /*
  * Unix implementation of OS abstraction layer.
@@ -42,6 +58,81 @@ int os_fclose(FILE *file) {
     return fclose(file);
 }
 
+ssize_t os_pread(int fd, void *buf, size_t count, off_t offset) {
+    return pread(fd, buf, count, offset);
+}
+
+ssize_t os_pwrite(int fd, const void *buf, size_t count, off_t offset) {
+    return pwrite(fd, buf, count, offset);
+}
+
+ssize_t os_writev(int fd, const os_iovec_t *iov, int n) {
+    struct iovec v[64];
+    size_t skip = 0; /* bytes of iov[0] already written */
+    ssize_t total = 0, w;
+    int k;
+
+    while (n > 0) {
+        for (k = 0; k < n && k < 64; k++) {
+            v[k].iov_base = (char *)iov[k].base + (k == 0 ? skip : 0);
+            v[k].iov_len = iov[k].len - (k == 0 ? skip : 0);
+        }
+        if ((w = writev(fd, v, k)) < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        total += w;
+        for (w += (ssize_t)skip, skip = 0; n > 0 && (size_t)w >= iov->len; n--, iov++)
+            w -= (ssize_t)iov->len;
+        if (n > 0)
+            skip = (size_t)w;
+    }
+    return total;
+}
+
+void *os_map_file(int fd, size_t *size) {
+    struct stat st;
+    void *p;
+
+    *size = 0;
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 ||
+        (uintmax_t)st.st_size > SIZE_MAX)
+        return NULL;
+    p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED)
+        return NULL;
+    *size = (size_t)st.st_size;
+    return p;
+}
+
+void os_unmap(void *p, size_t size) {
+    if (p != NULL)
+        munmap(p, size);
+}
+
+int os_advise(int fd, off_t offset, off_t len, int how) {
+#ifdef POSIX_FADV_SEQUENTIAL
+    static const int adv[] = {POSIX_FADV_NORMAL, POSIX_FADV_SEQUENTIAL, POSIX_FADV_RANDOM,
+                              POSIX_FADV_WILLNEED};
+
+    if (how < 0 || how > OS_ADV_WILLNEED)
+        return -1;
+    return posix_fadvise(fd, offset, len, adv[how]) == 0 ? 0 : -1;
+#else
+    (void)fd, (void)offset, (void)len, (void)how;
+    return 0;
+#endif
+}
+
+int os_map_advise(void *p, size_t size, int how) {
+    static const int adv[] = {MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED};
+
+    if (how < 0 || how > OS_ADV_WILLNEED)
+        return -1;
+    return madvise(p, size, adv[how]);
+}
+
 int os_fork(void) {
     return fork();
 }
@@ -81,3 +172,394 @@ int os_setenv(const char* name, const char* value, int overwrite) {
     }
     return setenv(name, value, overwrite);
 }
+
+long os_peak_rss_kb(void) {
+    os_rusage_t ru;
+
+    return os_rusage(&ru) < 0 ? 0 : ru.peak_rss_kb;
+}
+
+uint64_t os_now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t os_thread_cputime_ns(void) {
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) < 0) {
+        return 0;
+    }
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+int os_rusage(os_rusage_t *r) {
+    struct rusage ru;
+
+    memset(r, 0, sizeof(*r));
+    if (getrusage(RUSAGE_SELF, &ru) < 0) {
+        return -1;
+    }
+    r->user_ns = (uint64_t)ru.ru_utime.tv_sec * 1000000000u + (uint64_t)ru.ru_utime.tv_usec * 1000u;
+    r->sys_ns = (uint64_t)ru.ru_stime.tv_sec * 1000000000u + (uint64_t)ru.ru_stime.tv_usec * 1000u;
+#ifdef __APPLE__
+    r->peak_rss_kb = ru.ru_maxrss / 1024; /* bytes there, kilobytes elsewhere */
+#else
+    r->peak_rss_kb = ru.ru_maxrss;
+#endif
+    r->minflt = ru.ru_minflt;
+    r->majflt = ru.ru_majflt;
+    r->nvcsw = ru.ru_nvcsw;
+    r->nivcsw = ru.ru_nivcsw;
+    return 0;
+}
+
+void os_wait32(_Atomic(uint32_t) *addr, uint32_t val) {
+#ifdef __linux__
+    syscall(SYS_futex, (uint32_t *)addr, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0);
+#else
+    /* no portable wait on an address: let the other side run */
+    if (atomic_load(addr) == val)
+        sched_yield();
+#endif
+}
+
+void os_wake32(_Atomic(uint32_t) *addr) {
+#ifdef __linux__
+    syscall(SYS_futex, (uint32_t *)addr, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#else
+    (void)addr;
+#endif
+}
+
+/*
+ * Asynchronous I/O.  Each request in flight holds a slot, which keeps
+ * its user pointer (and, for io_uring, the iovec the kernel reads)
+ * until it is reaped; free slots are kept on a stack.
+ *
+ * The worker threads take requests from a queue and put results on
+ * another, both rings of depth entries under one lock.
+ */
+#define AIO_WORKERS 4
+
+struct aio_slot {
+    os_aio_req_t req;
+    ssize_t res;
+#ifdef __linux__
+    struct iovec iov;
+#endif
+};
+
+struct os_aio {
+    unsigned depth;
+    unsigned inflight;
+    struct aio_slot *slot;
+    unsigned *free; /* stack of free slot numbers */
+    unsigned nfree;
+    int uring; /* the io_uring descriptor, -1 for threads */
+#ifdef __linux__
+    _Atomic unsigned *sqhead, *sqtail, *cqhead, *cqtail;
+    unsigned sqmask, cqmask, *sqarray;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sqmap, *cqmap, *sqemap;
+    size_t sqlen, cqlen, sqelen;
+#endif
+    pthread_t worker[AIO_WORKERS];
+    int nworker;
+    pthread_mutex_t lock;
+    pthread_cond_t work; /* a request was queued, or stop */
+    pthread_cond_t done; /* a result was queued */
+    unsigned *todo, todohead, ntodo; /* slots waiting for a worker */
+    unsigned *fin, finhead, nfin; /* slots finished, not reaped */
+    int stop;
+};
+
+#ifdef __linux__
+static int uring_enter(int fd, unsigned submit, unsigned wait) {
+    return (int)syscall(__NR_io_uring_enter, fd, submit, wait,
+                        wait ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+}
+
+/* Set up the rings; -1 leaves q to the threads */
+static int uring_open(os_aio_t *q) {
+    struct io_uring_params p;
+    int fd;
+
+    memset(&p, 0, sizeof(p));
+    if ((fd = (int)syscall(__NR_io_uring_setup, q->depth, &p)) < 0)
+        return -1;
+    if (!(p.features & IORING_FEAT_RW_CUR_POS) || p.cq_entries < q->depth) {
+        close(fd); /* offset -1 would not work, or results could be dropped */
+        return -1;
+    }
+    q->sqlen = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    q->cqlen = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP)
+        q->sqlen = q->cqlen = q->sqlen > q->cqlen ? q->sqlen : q->cqlen;
+    q->sqelen = p.sq_entries * sizeof(struct io_uring_sqe);
+    q->sqmap = mmap(NULL, q->sqlen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                    IORING_OFF_SQ_RING);
+    q->cqmap = q->sqemap = MAP_FAILED;
+    if (q->sqmap != MAP_FAILED)
+        q->cqmap = (p.features & IORING_FEAT_SINGLE_MMAP)
+                       ? q->sqmap
+                       : mmap(NULL, q->cqlen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                              fd, IORING_OFF_CQ_RING);
+    if (q->cqmap != MAP_FAILED)
+        q->sqemap = mmap(NULL, q->sqelen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                         IORING_OFF_SQES);
+    if (q->sqemap == MAP_FAILED) {
+        if (q->cqmap != MAP_FAILED && q->cqmap != q->sqmap)
+            munmap(q->cqmap, q->cqlen);
+        if (q->sqmap != MAP_FAILED)
+            munmap(q->sqmap, q->sqlen);
+        close(fd);
+        return -1;
+    }
+    q->sqhead = (_Atomic unsigned *)((char *)q->sqmap + p.sq_off.head);
+    q->sqtail = (_Atomic unsigned *)((char *)q->sqmap + p.sq_off.tail);
+    q->sqmask = *(unsigned *)((char *)q->sqmap + p.sq_off.ring_mask);
+    q->sqarray = (unsigned *)((char *)q->sqmap + p.sq_off.array);
+    q->cqhead = (_Atomic unsigned *)((char *)q->cqmap + p.cq_off.head);
+    q->cqtail = (_Atomic unsigned *)((char *)q->cqmap + p.cq_off.tail);
+    q->cqmask = *(unsigned *)((char *)q->cqmap + p.cq_off.ring_mask);
+    q->cqes = (struct io_uring_cqe *)((char *)q->cqmap + p.cq_off.cqes);
+    q->sqes = q->sqemap;
+    q->uring = fd;
+    return 0;
+}
+
+static int uring_submit(os_aio_t *q, unsigned k) {
+    struct aio_slot *s = &q->slot[k];
+    struct io_uring_sqe *e;
+    unsigned tail, i;
+    int r;
+
+    tail = atomic_load_explicit(q->sqtail, memory_order_relaxed);
+    i = tail & q->sqmask;
+    e = &q->sqes[i];
+    memset(e, 0, sizeof(*e));
+    s->iov.iov_base = s->req.buf;
+    s->iov.iov_len = s->req.len;
+    e->opcode = s->req.op == OS_AIO_WRITE ? IORING_OP_WRITEV : IORING_OP_READV;
+    e->fd = s->req.fd;
+    e->addr = (uintptr_t)&s->iov;
+    e->len = 1;
+    e->off = (uint64_t)(int64_t)s->req.offset;
+    e->user_data = k;
+    q->sqarray[i] = i;
+    atomic_store_explicit(q->sqtail, tail + 1, memory_order_release);
+    while ((r = uring_enter(q->uring, 1, 0)) < 0 && errno == EINTR)
+        ;
+    if (r < 1) {
+        atomic_store_explicit(q->sqtail, tail, memory_order_release);
+        return -1;
+    }
+    return 0;
+}
+
+/* The slot of a finished request, or -1 if none has finished */
+static int uring_reap(os_aio_t *q, int wait) {
+    struct io_uring_cqe *c;
+    unsigned head;
+    int k;
+
+    head = atomic_load_explicit(q->cqhead, memory_order_relaxed);
+    while (head == atomic_load_explicit(q->cqtail, memory_order_acquire)) {
+        if (!wait)
+            return -1;
+        if (uring_enter(q->uring, 0, 1) < 0 && errno != EINTR)
+            return -1;
+    }
+    c = &q->cqes[head & q->cqmask];
+    k = (int)c->user_data;
+    q->slot[k].res = c->res;
+    atomic_store_explicit(q->cqhead, head + 1, memory_order_release);
+    return k;
+}
+
+static void uring_close(os_aio_t *q) {
+    munmap(q->sqemap, q->sqelen);
+    if (q->cqmap != q->sqmap)
+        munmap(q->cqmap, q->cqlen);
+    munmap(q->sqmap, q->sqlen);
+    close(q->uring);
+}
+#endif
+
+static void *aio_worker(void *arg) {
+    os_aio_t *q = arg;
+    struct aio_slot *s;
+    unsigned k;
+    ssize_t r;
+
+    pthread_mutex_lock(&q->lock);
+    for (;;) {
+        while (q->ntodo == 0 && !q->stop)
+            pthread_cond_wait(&q->work, &q->lock);
+        if (q->ntodo == 0)
+            break;
+        k = q->todo[q->todohead];
+        q->todohead = (q->todohead + 1) % q->depth;
+        q->ntodo--;
+        pthread_mutex_unlock(&q->lock);
+        s = &q->slot[k];
+        do {
+            if (s->req.op == OS_AIO_WRITE)
+                r = s->req.offset < 0 ? write(s->req.fd, s->req.buf, s->req.len)
+                                      : pwrite(s->req.fd, s->req.buf, s->req.len, s->req.offset);
+            else
+                r = s->req.offset < 0 ? read(s->req.fd, s->req.buf, s->req.len)
+                                      : pread(s->req.fd, s->req.buf, s->req.len, s->req.offset);
+        } while (r < 0 && errno == EINTR);
+        s->res = r < 0 ? -errno : r;
+        pthread_mutex_lock(&q->lock);
+        q->fin[(q->finhead + q->nfin++) % q->depth] = k;
+        pthread_cond_signal(&q->done);
+    }
+    pthread_mutex_unlock(&q->lock);
+    return NULL;
+}
+
+os_aio_t *os_aio_open(unsigned depth, int flags) {
+    os_aio_t *q;
+    unsigned k;
+
+    if (depth == 0 || depth > 4096 || (q = OSA_CALLOC(1, sizeof(*q))) == NULL)
+        return NULL;
+    q->depth = depth;
+    q->slot = OSA_CALLOC(depth, sizeof(*q->slot));
+    q->free = OSA_MALLOC(depth * sizeof(*q->free));
+    q->todo = OSA_MALLOC(depth * sizeof(*q->todo));
+    q->fin = OSA_MALLOC(depth * sizeof(*q->fin));
+    if (!q->slot || !q->free || !q->todo || !q->fin)
+        goto fail;
+    for (k = 0; k < depth; k++)
+        q->free[k] = depth - 1 - k;
+    q->nfree = depth;
+    q->uring = -1;
+#ifdef __linux__
+    if (!(flags & OS_AIO_THREADS) && uring_open(q) == 0)
+        return q;
+#else
+    (void)flags;
+#endif
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->work, NULL);
+    pthread_cond_init(&q->done, NULL);
+    for (; q->nworker < AIO_WORKERS && q->nworker < (int)depth; q->nworker++)
+        if (pthread_create(&q->worker[q->nworker], NULL, aio_worker, q) != 0)
+            break;
+    if (q->nworker > 0)
+        return q;
+    pthread_cond_destroy(&q->done);
+    pthread_cond_destroy(&q->work);
+    pthread_mutex_destroy(&q->lock);
+fail:
+    OSA_FREE(q->fin);
+    OSA_FREE(q->todo);
+    OSA_FREE(q->free);
+    OSA_FREE(q->slot);
+    OSA_FREE(q);
+    return NULL;
+}
+
+int os_aio_submit(os_aio_t *q, const os_aio_req_t *r) {
+    unsigned k;
+
+    if (q->nfree == 0) {
+        errno = EAGAIN;
+        return -1;
+    }
+    k = q->free[--q->nfree];
+    q->slot[k].req = *r;
+#ifdef __linux__
+    if (q->uring >= 0) {
+        if (uring_submit(q, k) < 0) {
+            q->nfree++;
+            return -1;
+        }
+        q->inflight++;
+        return 0;
+    }
+#endif
+    pthread_mutex_lock(&q->lock);
+    q->todo[(q->todohead + q->ntodo++) % q->depth] = k;
+    pthread_cond_signal(&q->work);
+    pthread_mutex_unlock(&q->lock);
+    q->inflight++;
+    return 0;
+}
+
+int os_aio_reap(os_aio_t *q, os_aio_done_t *d, int wait) {
+    int k = -1;
+
+    if (q->inflight == 0)
+        return 0;
+#ifdef __linux__
+    if (q->uring >= 0)
+        k = uring_reap(q, wait);
+    else
+#endif
+    {
+        pthread_mutex_lock(&q->lock);
+        while (q->nfin == 0 && wait)
+            pthread_cond_wait(&q->done, &q->lock);
+        if (q->nfin > 0) {
+            k = (int)q->fin[q->finhead];
+            q->finhead = (q->finhead + 1) % q->depth;
+            q->nfin--;
+        }
+        pthread_mutex_unlock(&q->lock);
+    }
+    if (k < 0)
+        return 0;
+    d->user = q->slot[k].req.user;
+    d->res = q->slot[k].res;
+    (void)OSA_IO(q->slot[k].req.op == OS_AIO_WRITE ? OSA_KWRITE : OSA_KREAD, d->res);
+    q->free[q->nfree++] = (unsigned)k;
+    q->inflight--;
+    return 1;
+}
+
+unsigned os_aio_pending(const os_aio_t *q) {
+    return q->inflight;
+}
+
+const char *os_aio_backend(const os_aio_t *q) {
+    return q->uring >= 0 ? "io_uring" : "threads";
+}
+
+void os_aio_close(os_aio_t *q) {
+    os_aio_done_t d;
+    int i;
+
+    if (q == NULL)
+        return;
+    while (os_aio_reap(q, &d, 1))
+        ;
+#ifdef __linux__
+    if (q->uring >= 0)
+        uring_close(q);
+    else
+#endif
+    {
+        pthread_mutex_lock(&q->lock);
+        q->stop = 1;
+        pthread_cond_broadcast(&q->work);
+        pthread_mutex_unlock(&q->lock);
+        for (i = 0; i < q->nworker; i++)
+            pthread_join(q->worker[i], NULL);
+        pthread_cond_destroy(&q->done);
+        pthread_cond_destroy(&q->work);
+        pthread_mutex_destroy(&q->lock);
+    }
+    OSA_FREE(q->fin);
+    OSA_FREE(q->todo);
+    OSA_FREE(q->free);
+    OSA_FREE(q->slot);
+    OSA_FREE(q);
+}
@@ -1,7 +1,11 @@
 #include "os_abstraction.h"
+#define OSA_TAG "os"
+#include "os_acct.h"
 
 #ifdef _WIN32
 #include <io.h>
+#include <windows.h> /* WaitOnAddress, Synchronization.lib */
+#include <psapi.h> /* K32GetProcessMemoryInfo */
 
 /*
  * Windows implementation of OS abstraction layer.
@@ -50,6 +54,104 @@ int os_fclose(FILE *file) {
     return fclose(file);
 }
 
+/* Positioned I/O through the handle under the descriptor */
+static ssize_t rwat(int fd, void *buf, size_t count, off_t offset, int wr) {
+    HANDLE h = (HANDLE)_get_osfhandle(fd);
+    OVERLAPPED ov;
+    DWORD n = 0;
+    BOOL ok;
+
+    if (h == INVALID_HANDLE_VALUE) {
+        errno = EBADF;
+        return -1;
+    }
+    memset(&ov, 0, sizeof(ov));
+    ov.Offset = (DWORD)((uint64_t)offset & 0xFFFFFFFF);
+    ov.OffsetHigh = (DWORD)((uint64_t)offset >> 32);
+    if (count > 0x7FFFFFFF)
+        count = 0x7FFFFFFF;
+    ok = wr ? WriteFile(h, buf, (DWORD)count, &n, &ov) : ReadFile(h, buf, (DWORD)count, &n, &ov);
+    if (!ok && !(GetLastError() == ERROR_HANDLE_EOF)) {
+        errno = EIO;
+        return -1;
+    }
+    return (ssize_t)n;
+}
+
+ssize_t os_pread(int fd, void *buf, size_t count, off_t offset) {
+    return rwat(fd, buf, count, offset, 0);
+}
+
+ssize_t os_pwrite(int fd, const void *buf, size_t count, off_t offset) {
+    return rwat(fd, (void *)buf, count, offset, 1);
+}
+
+/* No gathering write on a CRT descriptor: one write per piece */
+ssize_t os_writev(int fd, const os_iovec_t *iov, int n) {
+    const char *p;
+    size_t left;
+    ssize_t total = 0;
+    int w;
+
+    for (; n > 0; n--, iov++)
+        for (p = iov->base, left = iov->len; left > 0; p += w, left -= (size_t)w) {
+            if ((w = _write(fd, p, left > 0x7FFFFFFF ? 0x7FFFFFFF : (unsigned)left)) < 0) {
+                if (errno == EINTR) {
+                    w = 0;
+                    continue;
+                }
+                return -1;
+            }
+            total += w;
+        }
+    return total;
+}
+
+/*
+ * A view of the whole file; the mapping object can go at once, as the
+ * view holds it.
+ */
+void *os_map_file(int fd, size_t *size) {
+    HANDLE h = (HANDLE)_get_osfhandle(fd), m;
+    LARGE_INTEGER len;
+    void *p;
+
+    *size = 0;
+    if (h == INVALID_HANDLE_VALUE || GetFileType(h) != FILE_TYPE_DISK ||
+        !GetFileSizeEx(h, &len) || len.QuadPart <= 0 || (uint64_t)len.QuadPart > SIZE_MAX)
+        return NULL;
+    if ((m = CreateFileMappingA(h, NULL, PAGE_READONLY, 0, 0, NULL)) == NULL)
+        return NULL;
+    p = MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(m);
+    if (p == NULL)
+        return NULL;
+    *size = (size_t)len.QuadPart;
+    return p;
+}
+
+void os_unmap(void *p, size_t size) {
+    (void)size;
+    if (p != NULL)
+        UnmapViewOfFile(p);
+}
+
+/* Windows takes read-ahead hints when a file is opened, not after */
+int os_advise(int fd, off_t offset, off_t len, int how) {
+    (void)fd, (void)offset, (void)len, (void)how;
+    return 0;
+}
+
+int os_map_advise(void *p, size_t size, int how) {
+    WIN32_MEMORY_RANGE_ENTRY r;
+
+    if (how != OS_ADV_WILLNEED && how != OS_ADV_SEQUENTIAL)
+        return 0;
+    r.VirtualAddress = p;
+    r.NumberOfBytes = size;
+    return PrefetchVirtualMemory(GetCurrentProcess(), 1, &r, 0) ? 0 : -1;
+}
+
 /* Stub implementations for process functions on Windows */
 int os_fork(void) {
     /* fork() not available on Windows */
@@ -95,4 +197,200 @@ int os_setenv(const char* name, const char* value, int overwrite) {
     return _putenv_s(name, value);
 }
 
+long os_peak_rss_kb(void) {
+    os_rusage_t ru;
+
+    return os_rusage(&ru) < 0 ? 0 : ru.peak_rss_kb;
+}
+
+uint64_t os_now_ns(void) {
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER c;
+
+    if (freq.QuadPart == 0)
+        QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&c);
+    /* in two parts, so that the product cannot overflow */
+    return (uint64_t)(c.QuadPart / freq.QuadPart) * 1000000000u +
+           (uint64_t)(c.QuadPart % freq.QuadPart) * 1000000000u / (uint64_t)freq.QuadPart;
+}
+
+/* FILETIME counts 100 ns */
+static uint64_t ftns(const FILETIME *f) {
+    return (((uint64_t)f->dwHighDateTime << 32) | f->dwLowDateTime) * 100u;
+}
+
+uint64_t os_thread_cputime_ns(void) {
+    FILETIME c, e, k, u;
+
+    if (!GetThreadTimes(GetCurrentThread(), &c, &e, &k, &u)) {
+        return 0;
+    }
+    return ftns(&k) + ftns(&u);
+}
+
+/* Windows keeps no count of context switches or of faults by kind */
+int os_rusage(os_rusage_t *r) {
+    PROCESS_MEMORY_COUNTERS pmc;
+    FILETIME c, e, k, u;
+
+    memset(r, 0, sizeof(*r));
+    if (!GetProcessTimes(GetCurrentProcess(), &c, &e, &k, &u) ||
+        !K32GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return -1;
+    }
+    r->user_ns = ftns(&u);
+    r->sys_ns = ftns(&k);
+    r->peak_rss_kb = (long)(pmc.PeakWorkingSetSize / 1024);
+    r->minflt = (long)pmc.PageFaultCount;
+    return 0;
+}
+
+/*
+ * Asynchronous I/O through a completion port.  Each request in flight
+ * holds a slot that starts with its OVERLAPPED, so the packet leads
+ * back to it.  A CRT descriptor is not opened for overlapped I/O, so
+ * its calls finish before they return; and a handle that cannot be
+ * tied to this port has its result posted by hand.  Either way every
+ * request comes back through GetQueuedCompletionStatus().
+ */
+struct aio_slot {
+    OVERLAPPED ov;
+    os_aio_req_t req;
+};
+
+struct os_aio {
+    HANDLE port;
+    unsigned depth;
+    unsigned inflight;
+    struct aio_slot *slot;
+    unsigned *free;
+    unsigned nfree;
+};
+
+os_aio_t *os_aio_open(unsigned depth, int flags) {
+    os_aio_t *q;
+    unsigned k;
+
+    (void)flags; /* there is nothing else to fall back on */
+    if (depth == 0 || depth > 4096 || (q = OSA_CALLOC(1, sizeof(*q))) == NULL)
+        return NULL;
+    q->depth = depth;
+    q->slot = OSA_CALLOC(depth, sizeof(*q->slot));
+    q->free = OSA_MALLOC(depth * sizeof(*q->free));
+    q->port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+    if (!q->slot || !q->free || q->port == NULL) {
+        if (q->port != NULL)
+            CloseHandle(q->port);
+        OSA_FREE(q->free);
+        OSA_FREE(q->slot);
+        OSA_FREE(q);
+        return NULL;
+    }
+    for (k = 0; k < depth; k++)
+        q->free[k] = depth - 1 - k;
+    q->nfree = depth;
+    return q;
+}
+
+int os_aio_submit(os_aio_t *q, const os_aio_req_t *r) {
+    struct aio_slot *s;
+    HANDLE h = (HANDLE)_get_osfhandle(r->fd);
+    DWORD n = 0, len;
+    BOOL ok;
+
+    if (q->nfree == 0) {
+        errno = EAGAIN;
+        return -1;
+    }
+    if (h == INVALID_HANDLE_VALUE) {
+        errno = EBADF;
+        return -1;
+    }
+    s = &q->slot[q->free[--q->nfree]];
+    memset(&s->ov, 0, sizeof(s->ov));
+    s->req = *r;
+    if (r->offset >= 0) {
+        s->ov.Offset = (DWORD)((uint64_t)r->offset & 0xFFFFFFFF);
+        s->ov.OffsetHigh = (DWORD)((uint64_t)r->offset >> 32);
+    } else
+        s->ov.Offset = s->ov.OffsetHigh = 0xFFFFFFFF; /* at the end, for writes */
+    len = r->len > 0x7FFFFFFF ? 0x7FFFFFFF : (DWORD)r->len;
+    if (CreateIoCompletionPort(h, q->port, 0, 0) == NULL) {
+        /* tied to another port already: do it now and post the result */
+        ok = r->op == OS_AIO_WRITE ? WriteFile(h, r->buf, len, &n, NULL)
+                                   : ReadFile(h, r->buf, len, &n, NULL);
+        if (!ok && GetLastError() != ERROR_HANDLE_EOF)
+            s->ov.Internal = (ULONG_PTR)-1;
+        PostQueuedCompletionStatus(q->port, n, 0, &s->ov);
+    } else {
+        ok = r->op == OS_AIO_WRITE ? WriteFile(h, r->buf, len, NULL, &s->ov)
+                                   : ReadFile(h, r->buf, len, NULL, &s->ov);
+        if (!ok && GetLastError() != ERROR_IO_PENDING) {
+            if (GetLastError() != ERROR_HANDLE_EOF) {
+                q->nfree++;
+                errno = EIO;
+                return -1;
+            }
+            PostQueuedCompletionStatus(q->port, 0, 0, &s->ov); /* EOF: no packet comes */
+        }
+    }
+    q->inflight++;
+    return 0;
+}
+
+int os_aio_reap(os_aio_t *q, os_aio_done_t *d, int wait) {
+    OVERLAPPED *ov;
+    struct aio_slot *s;
+    ULONG_PTR key;
+    DWORD n;
+    BOOL ok;
+
+    if (q->inflight == 0)
+        return 0;
+    ok = GetQueuedCompletionStatus(q->port, &n, &key, &ov, wait ? INFINITE : 0);
+    if (ov == NULL)
+        return 0; /* timed out */
+    s = (struct aio_slot *)ov;
+    d->user = s->req.user;
+    if (ok && s->ov.Internal != (ULONG_PTR)-1)
+        d->res = (ssize_t)n;
+    else
+        d->res = GetLastError() == ERROR_HANDLE_EOF ? 0 : -EIO;
+    (void)OSA_IO(s->req.op == OS_AIO_WRITE ? OSA_KWRITE : OSA_KREAD, d->res);
+    q->free[q->nfree++] = (unsigned)(s - q->slot);
+    q->inflight--;
+    return 1;
+}
+
+unsigned os_aio_pending(const os_aio_t *q) {
+    return q->inflight;
+}
+
+const char *os_aio_backend(const os_aio_t *q) {
+    (void)q;
+    return "iocp";
+}
+
+void os_aio_close(os_aio_t *q) {
+    os_aio_done_t d;
+
+    if (q == NULL)
+        return;
+    while (os_aio_reap(q, &d, 1))
+        ;
+    CloseHandle(q->port);
+    OSA_FREE(q->free);
+    OSA_FREE(q->slot);
+    OSA_FREE(q);
+}
+
+void os_wait32(_Atomic(uint32_t) *addr, uint32_t val) {
+    WaitOnAddress((volatile VOID *)addr, &val, sizeof(val), INFINITE);
+}
+
+void os_wake32(_Atomic(uint32_t) *addr) {
+    WakeByAddressSingle((PVOID)addr);
+}
+
 #endif /* _WIN32 */
@@ -0,0 +1,189 @@
+/*
+ * test_io.c - Unit tests for positioned, gathered and mapped file I/O
+ *
+ * Writes a file in many pieces with os_writev(), reads it back in
+ * place with os_pread() and through os_map_file(), and checks that
+ * the file offset is left alone and that what cannot be mapped is
+ * refused.  A gathered write into a pipe that a slow reader drains
+ * checks the short-write path.  The asynchronous queue is run on
+ * each backend there is: many positioned reads and writes in flight,
+ * a full queue, and a pipe read at its own offset.
+ *
+ *   cc -std=c17 -O2 -pthread -D_GNU_SOURCE -Isrc/os src/os/test_io.c \
+ *       src/os/os_unix.c -o test_io
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+
+#include "os_abstraction.h"
+
+#define NPIECE 1000
+#define PIPED (1024 * 1024)
+
+static char tmpl[] = "/tmp/test_ioXXXXXX";
+
+void test_writev_pread(int fd) {
+    static os_iovec_t iov[NPIECE];
+    static char text[NPIECE][8];
+    char buf[8];
+    size_t total = 0;
+    int i;
+
+    printf("Testing gathered writes and positioned reads...\n");
+    for (i = 0; i < NPIECE; i++) {
+        iov[i].len = (size_t)snprintf(text[i], sizeof(text[i]), "%d,", i);
+        iov[i].base = text[i];
+        total += iov[i].len;
+    }
+    iov[7].len = 0; /* an empty piece is skipped */
+    total -= strlen(text[7]);
+    assert(os_writev(fd, iov, NPIECE) == (ssize_t)total);
+    assert(os_lseek(fd, 0, SEEK_CUR) == (off_t)total);
+
+    assert(os_pread(fd, buf, 4, 0) == 4 && memcmp(buf, "0,1,", 4) == 0);
+    assert(os_pwrite(fd, "X", 1, 2) == 1);
+    assert(os_pread(fd, buf, 4, 0) == 4 && memcmp(buf, "0,X,", 4) == 0);
+    assert(os_pread(fd, buf, sizeof(buf), (off_t)total) == 0);
+    assert(os_lseek(fd, 0, SEEK_CUR) == (off_t)total);
+    printf("✓ %zu bytes in %d pieces\n", total, NPIECE);
+}
+
+void test_map(int fd) {
+    size_t size, n;
+    char *p;
+    int empty;
+
+    printf("Testing mappings...\n");
+    n = (size_t)os_lseek(fd, 0, SEEK_END);
+    assert((p = os_map_file(fd, &size)) != NULL && size == n);
+    assert(os_map_advise(p, size, OS_ADV_SEQUENTIAL) == 0);
+    assert(os_advise(fd, 0, 0, OS_ADV_WILLNEED) == 0);
+    assert(memcmp(p, "0,X,2,", 6) == 0);
+    assert(p[size - 1] == ',');
+    os_unmap(p, size);
+
+    empty = os_open("/dev/null", O_RDONLY, 0);
+    assert(empty >= 0);
+    assert(os_map_file(empty, &size) == NULL && size == 0);
+    os_close(empty);
+    printf("✓ Mapped %zu bytes; a device is refused\n", n);
+}
+
+static void *drain(void *arg) {
+    char buf[777];
+    ssize_t r;
+    long *got = arg;
+
+    while ((r = os_read((int)(got[1]), buf, sizeof(buf))) > 0)
+        for (ssize_t i = 0; i < r; i++, got[0]++)
+            assert(buf[i] == (char)('a' + got[0] % 26));
+    return NULL;
+}
+
+void test_short_writes(void) {
+    static char data[PIPED];
+    os_iovec_t iov[3];
+    pthread_t t;
+    long got[2] = {0, 0};
+    int fd[2];
+    size_t i;
+
+    printf("Testing gathered writes into a pipe...\n");
+    for (i = 0; i < PIPED; i++)
+        data[i] = (char)('a' + i % 26);
+    assert(pipe(fd) == 0);
+    got[1] = fd[0];
+    assert(pthread_create(&t, NULL, drain, got) == 0);
+    iov[0].base = data, iov[0].len = 10;
+    iov[1].base = data + 10, iov[1].len = PIPED / 2;
+    iov[2].base = data + 10 + PIPED / 2, iov[2].len = PIPED - 10 - PIPED / 2;
+    assert(os_writev(fd[1], iov, 3) == PIPED);
+    os_close(fd[1]);
+    pthread_join(t, NULL);
+    os_close(fd[0]);
+    assert(got[0] == PIPED);
+    printf("✓ %ld bytes in order\n", got[0]);
+}
+
+void test_aio(int flags) {
+    static char blk[64][512];
+    os_aio_req_t r;
+    os_aio_done_t d;
+    os_aio_t *q;
+    char tmp[] = "/tmp/test_aioXXXXXX", buf[16];
+    size_t k, seen = 0;
+    int fd, p[2], i;
+
+    assert((q = os_aio_open(16, flags)) != NULL);
+    printf("Testing asynchronous I/O (%s)...\n", os_aio_backend(q));
+    assert((fd = mkstemp(tmp)) >= 0);
+    os_unlink(tmp);
+
+    /* writes, sixteen in flight, reaped as they finish */
+    for (k = 0; k < 64; k++) {
+        memset(blk[k], 'A' + (int)k % 26, sizeof(blk[k]));
+        r.op = OS_AIO_WRITE, r.fd = fd, r.buf = blk[k], r.len = sizeof(blk[k]);
+        r.offset = (off_t)(k * sizeof(blk[k])), r.user = blk[k];
+        while (os_aio_submit(q, &r) < 0) {
+            assert(os_aio_pending(q) == 16);
+            assert(os_aio_reap(q, &d, 1) == 1 && d.res == 512);
+        }
+    }
+    while (os_aio_reap(q, &d, 1))
+        assert(d.res == 512);
+    assert(os_aio_pending(q) == 0 && os_aio_reap(q, &d, 0) == 0);
+
+    /* reads back into the same blocks, after clearing them */
+    memset(blk, 0, sizeof(blk));
+    for (k = 0; k < 64; k++) {
+        r.op = OS_AIO_READ, r.fd = fd, r.buf = blk[k], r.len = sizeof(blk[k]);
+        r.offset = (off_t)(k * sizeof(blk[k])), r.user = (void *)(k + 1);
+        while (os_aio_submit(q, &r) < 0)
+            if (os_aio_reap(q, &d, 1))
+                seen += (size_t)d.user;
+    }
+    while (os_aio_reap(q, &d, 1)) {
+        assert(d.res == 512);
+        seen += (size_t)d.user;
+    }
+    assert(seen == 64 * 65 / 2);
+    for (k = 0; k < 64; k++)
+        assert(blk[k][0] == 'A' + (int)k % 26 && blk[k][511] == blk[k][0]);
+
+    /* a read past the end, and one on a pipe at its own offset */
+    r.op = OS_AIO_READ, r.fd = fd, r.buf = buf, r.len = sizeof(buf);
+    r.offset = 64 * 512, r.user = NULL;
+    assert(os_aio_submit(q, &r) == 0);
+    assert(os_aio_reap(q, &d, 1) == 1 && d.res == 0);
+    assert(pipe(p) == 0);
+    r.fd = p[0], r.offset = -1;
+    assert(os_aio_submit(q, &r) == 0);
+    assert(os_aio_reap(q, &d, 0) == 0 || d.res == -EAGAIN);
+    assert(os_write(p[1], "ring", 4) == 4);
+    for (i = 0; !os_aio_reap(q, &d, 1); i++)
+        assert(i < 100);
+    assert(d.res == 4 && memcmp(buf, "ring", 4) == 0);
+    os_close(p[0]);
+    os_close(p[1]);
+    os_close(fd);
+    os_aio_close(q);
+    printf("✓ %s\n", flags ? "Worker threads" : "Default backend");
+}
+
+int main(void) {
+    int fd;
+
+    assert((fd = mkstemp(tmpl)) >= 0);
+    os_unlink(tmpl);
+    test_writev_pread(fd);
+    test_map(fd);
+    os_close(fd);
+    test_short_writes();
+    test_aio(0);
+    test_aio(OS_AIO_THREADS);
+    printf("All I/O tests passed.\n");
+    return 0;
+}
@@ -22,6 +22,9 @@ void setinp(int argc, char **argv);
 int swapin(void);
 int badsig(int signo);
 #define ever (;;)
+int statflg = 0; /* -S: report storage at the end */
+int memflg = 0; /* -M: report memory at the end */
+extern int peepflg;
 /* Entry point. */
 int main(int argc, char *argv[]) {
 #if gcos
@@ -40,13 +43,15 @@ int main(int argc, char *argv[]) {
 int tbl(int argc, char **argv) {
     char line[512];
     setinp(argc, argv);
-    while (gets1(line)) {
-        fprintf(tabout, "%s\n", line);
-        if (prefix(".TS", line))
+    while (copythru(line)) /* up to and through the next .TS */
+        if (!tblfork())
             tableput();
-    }
     fclose(tabin);
-    return (0);
+    if (statflg)
+        tblstat();
+    if (memflg)
+        tblmem();
+    return (tbldrain());
 }
 int sargc;
 char **sargv;
@@ -56,6 +61,21 @@ void setinp(int argc, char **argv) {
     sargv = argv;
     sargc--;
     sargv++;
+    while (sargc > 0 && (prefix("-T", *sargv) || prefix("-j", *sargv) || match("-S", *sargv) ||
+                         match("-M", *sargv) || match("-O", *sargv))) {
+        if (prefix("-j", *sargv))
+            jobsopt(*sargv + 2); /* tables in parallel, see tj.c */
+        else if (match("-S", *sargv))
+            statflg = 1;
+        else if (match("-M", *sargv))
+            memflg = 1; /* see tb.c */
+        else if (match("-O", *sargv))
+            peepflg = 1; /* tidy the rows, see tz.c */
+        else
+            twopt(*sargv + 2); /* measure cells as nroff -T would */
+        sargc--;
+        sargv++;
+    }
     if (sargc > 0)
         swapin();
 }
@@ -16,7 +16,12 @@ void tableput() {
     getstop();
     checkuse();
     choochar();
-    maktab();
+    if (!stophit()) {
+        stopbeg();
+        maktab();
+        stopend();
+    }
+    toowide();
     runout();
     release();
     rstofill();
@@ -5,6 +5,7 @@
 #include <stdlib.h>
 
 int oncol;
+int specwarn; /* warnings readspec() has written */
 static void readspec(void);
 /* Read the table specification header. */
 void getspec(void) {
@@ -23,7 +24,10 @@ void getspec(void) {
     nclin = ncol = 0;
     oncol = 0;
     left1flg = rightl = 0;
-    readspec();
+    if (!spechit()) {
+        readspec();
+        specput();
+    }
 }
 /* Parse the table specification in detail. */
 static void readspec(void) {
@@ -93,10 +97,12 @@ static void readspec(void) {
                 error("first column can not be S-type");
             if (c == 's' && style[nclin][icol - 1] == 'a') {
                 fprintf(tabout, ".tm warning: can't span a-type cols, changed to l\n");
+                specwarn++;
                 style[nclin][icol - 1] = 'l';
             }
             if (c == 's' && style[nclin][icol - 1] == 'n') {
                 fprintf(tabout, ".tm warning: can't span n-type cols, changed to c\n");
+                specwarn++;
                 style[nclin][icol - 1] = 'c';
             }
             icol++;
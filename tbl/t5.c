@@ -18,6 +18,8 @@ void gettbl(void) {
             nslin++;
         }
         if (nlin >= MAXLIN) {
+            /* the rest goes to the spill file, read again by yetmore() */
+            cstore = spill(cstore);
             leftover = 1;
             break;
         }
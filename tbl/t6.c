@@ -1,61 +1,37 @@
 /* C17 - no scaffold needed */
 /* t6.c: compute tab stops */
 #include "tbl.h"
+#define FN(i, c) font[stynum[i]][c]
+#define SZ(i, c) csize[stynum[i]][c]
+
+static void cellwide(int i, int nl, int icol, int *doubled, int *acase, int *nw);
+static void spanwide(int i, int nl, int icol, int k, int *doubled);
 
 /* Compute tab stops for the table. */
 void maktab(void) {
-#define FN(i, c) font[stynum[i]][c]
-#define SZ(i, c) csize[stynum[i]][c]
     /* define the tab stops of the table */
-    int icol, ilin, tsep, k, ik;
+    int icol, ilin, tsep, k, useln;
     int doubled[MAXCOL], acase[MAXCOL];
-    char *s;
+    int nw[3]; /* widths tbl measured for CRIGHT, S1 and S2; -1 for none */
     for (icol = 0; icol < ncol; icol++) {
         doubled[icol] = acase[icol] = 0;
+        nw[0] = nw[1] = nw[2] = -1;
         fprintf(tabout, ".nr %d 0\n", icol + CRIGHT);
-        for (ilin = 0; ilin < nlin; ilin++) {
-            if (instead[ilin] || fullbot[ilin])
-                continue;
-            if (fspan(ilin, icol))
-                continue;
-            switch (ctype(ilin, icol)) {
-            case 'a':
-                acase[icol] = 1;
-                s = table[ilin][icol].col;
-                if (s > 0 && s < 128) {
-                    if (doubled[icol] == 0)
-                        fprintf(tabout, ".nr %d 0\n.nr %d 0\n", S1, S2);
-                    doubled[icol] = 1;
-                    fprintf(tabout, ".if \\n(%c->\\n(%d .nr %d \\n(%c-\n", s, S2, S2, s);
-                }
-            case 'n':
-                if (table[ilin][icol].rcol != 0) {
-                    if (doubled[icol] == 0)
-                        fprintf(tabout, ".nr %d 0\n.nr %d 0\n", S1, S2);
-                    doubled[icol] = 1;
-                    if (real(s = table[ilin][icol].col) && !vspen(s)) {
-                        fprintf(tabout, ".nr %d ", TMP);
-                        wide(s, FN(ilin, icol), SZ(ilin, icol));
-                        fprintf(tabout, "\n");
-                        fprintf(tabout, ".if \\n(%d<\\n(%d .nr %d \\n(%d\n", S1, TMP, S1, TMP);
-                    }
-                    if (real(s = table[ilin][icol].rcol) && !vspen(s)) {
-                        fprintf(tabout, ".nr %d \\w%c%s%c\n", TMP, F1, s, F1);
-                        fprintf(tabout, ".if \\n(%d<\\n(%d .nr %d \\n(%d\n", S2, TMP, S2, TMP);
-                    }
-                    continue;
-                }
-            case 'r':
-            case 'c':
-            case 'l':
-                if (real(s = table[ilin][icol].col) && !vspen(s)) {
-                    fprintf(tabout, ".nr %d ", TMP);
-                    wide(s, FN(ilin, icol), SZ(ilin, icol));
-                    fprintf(tabout, "\n");
-                    fprintf(tabout, ".if \\n(%d<\\n(%d .nr %d \\n(%d\n", icol + CRIGHT, TMP, icol + CRIGHT, TMP);
-                }
-            }
+        for (ilin = 0; ilin < nlin; ilin++)
+            cellwide(ilin, ilin, icol, &doubled[icol], &acase[icol], nw);
+        if (leftover) { /* the rows past MAXLIN, from the spill file */
+            useln = moreopen();
+            while (moreline(useln))
+                cellwide(useln, 0, icol, &doubled[icol], &acase[icol], nw);
+            moreclose();
         }
+        /* one comparison for all the cells tbl measured (-T) */
+        if (nw[0] >= 0)
+            fprintf(tabout, ".if \\n(%d<%d .nr %d %d\n", icol + CRIGHT, nw[0], icol + CRIGHT, nw[0]);
+        if (nw[1] >= 0)
+            fprintf(tabout, ".if \\n(%d<%d .nr %d %d\n", S1, nw[1], S1, nw[1]);
+        if (nw[2] >= 0)
+            fprintf(tabout, ".if \\n(%d<%d .nr %d %d\n", S2, nw[2], S2, nw[2]);
         if (acase[icol]) {
             fprintf(tabout, ".if \\n(%d>=\\n(%d .nr %d \\n(%du+2n\n", S2, icol + CRIGHT, icol + CRIGHT, S2);
         }
@@ -70,23 +46,16 @@ void maktab(void) {
             fprintf(tabout, ".if \\n(%d<\\n(%d .nr %d \\n(%d\n", icol + CRIGHT, TMP, icol + CRIGHT, TMP);
         }
         for (ilin = 0; ilin < nlin; ilin++)
-            if (k = lspan(ilin, icol)) {
-                fprintf(tabout, ".nr %d ", TMP);
-                wide(table[ilin][icol - k].col, FN(ilin, icol - k), SZ(ilin, icol - k));
-                for (ik = k; ik >= 0; ik--) {
-                    fprintf(tabout, "-\\n(%d", CRIGHT + icol - ik);
-                    if (!expflg)
-                        fprintf(tabout, "-%dn", sep[icol - ik]);
-                }
-                fprintf(tabout, "\n");
-                fprintf(tabout, ".if \\n(%d>0 .nr %d \\n(%d/%d\n", TMP, TMP, TMP, k);
-                fprintf(tabout, ".if \\n(%d<0 .nr %d 0\n", TMP, TMP);
-                for (ik = 1; ik <= k; ik++) {
-                    if (doubled[icol - k + ik])
-                        fprintf(tabout, ".nr %d +\\n(%d/2\n", icol - k + ik + CMID, TMP);
-                    fprintf(tabout, ".nr %d +\\n(%d\n", icol - k + ik + CRIGHT, TMP);
-                }
-            }
+            if (k = lspan(ilin, icol))
+                spanwide(ilin, ilin, icol, k, doubled);
+        if (leftover) {
+            useln = moreopen();
+            if (k = lspan(useln, icol))
+                while (moreline(useln))
+                    if (!instead[0] && !fullbot[0])
+                        spanwide(useln, 0, icol, k, doubled);
+            moreclose();
+        }
     }
 /* if even requested, make all columns widest width */
 #define TMP1 S1
@@ -145,9 +114,96 @@ void maktab(void) {
     fprintf(tabout, ".nr TW \\n(%d\n", ncol + CRIGHT - 1);
     if (boxflg || allflg || dboxflg)
         fprintf(tabout, ".nr TW +%d*\\n(%d\n", sep[ncol - 1], TMP);
+    return;
+}
+/* Warn if the table is wider than the page; not part of what stophit() keeps. */
+void toowide(void) {
     fprintf(tabout,
             ".if t .if (\\n(TW+\\n(.o)>7.75i .tm Table at line %d file %s is too wide - \\n(TW units\n", iline - 1, ifile);
-    return;
+}
+/*
+ * Measure column icol of row nl, in the format of row i: the two are
+ * the same but for the rows yetmore() reads back, which are all read
+ * into row 0 and take the format of the last row kept in memory.
+ */
+static void cellwide(int i, int nl, int icol, int *doubled, int *acase, int *nw) {
+    int w;
+    char *s;
+    if (instead[nl] || fullbot[nl])
+        return;
+    if (fspan(i, icol))
+        return;
+    switch (ctype(i, icol)) {
+    case 'a':
+        *acase = 1;
+        s = table[nl][icol].col;
+        if (s > 0 && s < 128) {
+            if (*doubled == 0)
+                fprintf(tabout, ".nr %d 0\n.nr %d 0\n", S1, S2);
+            *doubled = 1;
+            fprintf(tabout, ".if \\n(%c->\\n(%d .nr %d \\n(%c-\n", s, S2, S2, s);
+        }
+    case 'n':
+        if (table[nl][icol].rcol != 0) {
+            if (*doubled == 0)
+                fprintf(tabout, ".nr %d 0\n.nr %d 0\n", S1, S2);
+            *doubled = 1;
+            if (real(s = table[nl][icol].col) && !vspen(s)) {
+                if ((w = twidth(s)) >= 0)
+                    nw[1] = max(nw[1], w);
+                else {
+                    fprintf(tabout, ".nr %d ", TMP);
+                    wide(s, FN(i, icol), SZ(i, icol));
+                    fprintf(tabout, "\n");
+                    fprintf(tabout, ".if \\n(%d<\\n(%d .nr %d \\n(%d\n", S1, TMP, S1, TMP);
+                }
+            }
+            if (real(s = table[nl][icol].rcol) && !vspen(s)) {
+                if ((w = twidth(s)) >= 0)
+                    nw[2] = max(nw[2], w);
+                else {
+                    fprintf(tabout, ".nr %d \\w%c%s%c\n", TMP, F1, s, F1);
+                    fprintf(tabout, ".if \\n(%d<\\n(%d .nr %d \\n(%d\n", S2, TMP, S2, TMP);
+                }
+            }
+            return;
+        }
+    case 'r':
+    case 'c':
+    case 'l':
+        if (real(s = table[nl][icol].col) && !vspen(s)) {
+            if ((w = twidth(s)) >= 0)
+                nw[0] = max(nw[0], w);
+            else {
+                fprintf(tabout, ".nr %d ", TMP);
+                wide(s, FN(i, icol), SZ(i, icol));
+                fprintf(tabout, "\n");
+                fprintf(tabout, ".if \\n(%d<\\n(%d .nr %d \\n(%d\n", icol + CRIGHT, TMP, icol + CRIGHT, TMP);
+            }
+        }
+    }
+}
+/* Widen the k columns before icol for the entry of row nl spanning them. */
+static void spanwide(int i, int nl, int icol, int k, int *doubled) {
+    int ik, w;
+    fprintf(tabout, ".nr %d ", TMP);
+    if ((w = twidth(table[nl][icol - k].col)) >= 0)
+        fprintf(tabout, "%d", w);
+    else
+        wide(table[nl][icol - k].col, FN(i, icol - k), SZ(i, icol - k));
+    for (ik = k; ik >= 0; ik--) {
+        fprintf(tabout, "-\\n(%d", CRIGHT + icol - ik);
+        if (!expflg)
+            fprintf(tabout, "-%dn", sep[icol - ik]);
+    }
+    fprintf(tabout, "\n");
+    fprintf(tabout, ".if \\n(%d>0 .nr %d \\n(%d/%d\n", TMP, TMP, TMP, k);
+    fprintf(tabout, ".if \\n(%d<0 .nr %d 0\n", TMP, TMP);
+    for (ik = 1; ik <= k; ik++) {
+        if (doubled[icol - k + ik])
+            fprintf(tabout, ".nr %d +\\n(%d/2\n", icol - k + ik + CMID, TMP);
+        fprintf(tabout, ".nr %d +\\n(%d\n", icol - k + ik + CRIGHT, TMP);
+    }
 }
 /* Measure string width. */
 void wide(char *s, char *fn, char *size) {
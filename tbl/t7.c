@@ -54,7 +54,7 @@ void runtabs(int i) {
 }
 /* Determine if line is a full horizontal rule. */
 int ifline(char *s) {
-    if (s[1])
+    if (!point(s) || s[0] == 0 || s[1]) /* a text block, or not a rule */
         return (0);
     if (s[0] == '_')
         return ('-');
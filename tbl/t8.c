@@ -48,6 +48,7 @@ void putline(int i, int nl) {
         }
         return;
     }
+    rowbeg(); /* the rest goes out in one piece */
     for (c = 0; c < ncol; c++) {
         if (instead[nl] == 0 && fullbot[nl] == 0)
             if (vspen(table[nl][c].col))
@@ -184,6 +185,7 @@ void putline(int i, int nl) {
                 topat[c] = nl;
             }
     }
+    rowend();
 }
 /* Output text with font and size handling. */
 void puttext(char *s, char *fn, char *size) {
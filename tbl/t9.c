@@ -1,63 +1,105 @@
 /* C17 - no scaffold needed */
 /* t9.c: write lines for tables over 200 lines */
 #include "tbl.h"
+#define OSA_TAG "tbl"
+#include "os/os_acct.h" /* OSA_MALLOC */
+#include <stdlib.h> /* malloc */
 
-/* Output additional lines for very large tables. */
-void yetmore(void) {
-    int icol, ch, useln;
-    for (useln = 0; useln < MAXLIN && table[useln] == NULL; useln++)
-        ;
-    if (useln >= MAXLIN)
-        error("Wierd.  No data in table.", 0);
-    table[0] = table[useln];
+/* What moreopen() moved out of row 0, put back by moreclose() */
+static struct colstr *row0;
+static int inst0;
+static int full0;
+static char *exkeep, *exlkeep;
+static char *exspill; /* room for the split fields of one spilled row */
+
+/* Make row 0 the place rows of the spill file are read into. */
+int moreopen(void) {
+    int useln;
     for (useln = nlin - 1; useln >= 0 && (fullbot[useln] || instead[useln]); useln--)
         ;
     if (useln < 0)
-        error("Wierd.  No real lines in table.", 0);
-    while (gets1(cstore = cspace)) {
-        if (prefix(".TE", cstore))
+        error("Wierd.  No real lines in table.");
+    if (exspill == NULL && (exspill = OSA_MALLOC(MAXCHS + 200)) == NULL)
+        error("no space for characters");
+    row0 = table[0];
+    inst0 = instead[0];
+    full0 = fullbot[0];
+    exkeep = exstore;
+    exlkeep = exlim;
+    table[0] = alocv((ncol + 2) * sizeof(table[0][0]));
+    spillrew();
+    return (useln); /* the spilled rows are in the format of this one */
+}
+
+/* Read the next spilled row into row 0; 0 when there are no more. */
+int moreline(int useln) {
+    int icol, ch;
+    char *s;
+    if ((s = spillget()) == NULL)
+        return (0);
+    exstore = exspill; /* the fields of the last row are not needed */
+    exlim = exspill + MAXCHS;
+    instead[0] = NULL;
+    fullbot[0] = 0; // fullbot is int
+    if (s[0] == '.' && letter(s[1])) {
+        instead[0] = s;
+        return (1);
+    }
+    if (s[1] == 0)
+        switch (s[0]) {
+        case '_':
+            fullbot[0] = '-';
+            return (1);
+        case '=':
+            fullbot[0] = '=';
+            return (1);
+        }
+    for (icol = 0; icol < ncol; icol++) {
+        table[0][icol].col = s;
+        table[0][icol].rcol = NULL;
+        for (; (ch = *s) != '\0' && ch != tab; s++)
+            ;
+        *s++ = '\0';
+        switch (ctype(useln, icol)) {
+        case 'n':
+            table[0][icol].rcol = maknew(table[0][icol].col);
+            break;
+        case 'a':
+            table[0][icol].rcol = table[0][icol].col;
+            table[0][icol].col = "";
             break;
-        if (cstore[0] == '.' && letter(cstore[1])) {
-            puts(cstore);
-            continue;
         }
-        instead[0] = NULL;
-        fullbot[0] = 0; // fullbot is int
-        if (cstore[1] == 0)
-            switch (cstore[0]) {
-            case '_':
-                fullbot[0] = '-';
-                putline(useln, 0);
-                continue;
-            case '=':
-                fullbot[0] = '=';
-                putline(useln, 0);
-                continue;
-            }
-        for (icol = 0; icol < ncol; icol++) {
-            table[0][icol].col = cstore;
-            table[0][icol].rcol = NULL;
-            for (; (ch = *cstore) != '\0' && ch != tab; cstore++)
-                ;
-            *cstore++ = '\0';
-            switch (ctype(useln, icol)) {
-            case 'n':
-                table[0][icol].rcol = maknew(table[0][icol].col);
-                break;
-            case 'a':
-                table[0][icol].rcol = table[0][icol].col;
-                table[0][icol].col = "";
-                break;
-            }
-            while (ctype(useln, icol + 1) == 's') /* spanning */
-                table[0][++icol].col = "";
-            if (ch == '\0')
-                break;
+        while (ctype(useln, icol + 1) == 's') /* spanning */
+            table[0][++icol].col = "";
+        if (ch == '\0')
+            break;
+    }
+    while (++icol < ncol + 2) {
+        table[0][icol].col = "";
+        table[0][icol].rcol = NULL;
+    }
+    return (1);
+}
+
+/* Give row 0 back to the table. */
+void moreclose(void) {
+    table[0] = row0;
+    instead[0] = inst0;
+    fullbot[0] = full0;
+    exstore = exkeep;
+    exlim = exlkeep;
+}
+
+/* Output additional lines for very large tables. */
+void yetmore(void) {
+    int useln;
+    useln = moreopen();
+    while (moreline(useln)) {
+        if (instead[0]) {
+            puts(instead[0]);
+            continue;
         }
-        while (++icol < ncol)
-            table[0][icol].col = "";
         putline(useln, 0);
     }
-    last = cstore;
-    return;
+    moreclose();
 }
@@ -1,28 +1,45 @@
 /* C17 - no scaffold needed */
 /* tb.c: check which entries exist, also storage allocation */
 #include "tbl.h"
+#include <stdlib.h> /* malloc */
+#include "core/memrep.h" /* memory report */
+#define OSA_TAG "tbl"
+#include "os/os_acct.h" /* OSA_MALLOC */
+
+static void use1(int i, int nl, int c);
 
 /* Analyze table usage for each column. */
 void checkuse(void) {
-    int i, c, k;
+    int i, c, useln;
     for (c = 0; c < ncol; c++) {
         used[c] = lused[c] = rused[c] = 0;
-        for (i = 0; i < nlin; i++) {
-            if (instead[i] || fullbot[i])
-                continue;
-            k = ctype(i, c);
-            if (k == '-' || k == '=')
-                continue;
-            if ((k == 'n' || k == 'a')) {
-                lused[c] |= real(table[i][c].col);
-                rused[c] |= real(table[i][c].rcol);
-                if (!real(table[i][c].rcol))
-                    used[c] |= real(table[i][c].col);
-            } else
-                used[c] |= real(table[i][c].col);
-        }
+        for (i = 0; i < nlin; i++)
+            use1(i, i, c);
+    }
+    if (leftover) {
+        useln = moreopen();
+        while (moreline(useln))
+            for (c = 0; c < ncol; c++)
+                use1(useln, 0, c);
+        moreclose();
     }
 }
+/* Note what column c of row nl, in the format of row i, uses. */
+static void use1(int i, int nl, int c) {
+    int k;
+    if (instead[nl] || fullbot[nl])
+        return;
+    k = ctype(i, c);
+    if (k == '-' || k == '=')
+        return;
+    if ((k == 'n' || k == 'a')) {
+        lused[c] |= real(table[nl][c].col);
+        rused[c] |= real(table[nl][c].rcol);
+        if (!real(table[nl][c].rcol))
+            used[c] |= real(table[nl][c].col);
+    } else
+        used[c] |= real(table[nl][c].col);
+}
 /* Determine whether a data pointer is actual text. */
 int real(char *s) {
     if (s == NULL)
@@ -33,49 +50,114 @@ int real(char *s) {
         return (0);
     return (1);
 }
-int spcount = 0; /* number of allocated char spaces */
-#define MAXVEC 20
-char *spvecs[MAXVEC];
+/*
+ * Character space and vectors for one table come from an arena of
+ * blocks that grows as needed and is emptied in one step by release().
+ * The blocks are kept for the next table, so a document of many tables
+ * allocates only for the largest of them.
+ */
+#define ABLK 65536 /* usual block size */
+struct ablk {
+    struct ablk *next;
+    size_t size; /* bytes in mem */
+    size_t used;
+    union { /* aligned for a struct colstr */
+        char *p;
+        long l;
+        double d;
+    } mem[];
+};
+static struct ablk *ahead; /* every block, in order of use */
+static struct ablk *acur; /* the block being carved */
+static size_t ainuse; /* bytes handed out since release() */
+static size_t apeak; /* most bytes handed out for one table */
+static size_t atotal; /* bytes of all blocks */
+static int ntables; /* tables released */
+/* n zeroed bytes from the arena. */
+static char *aget(size_t n) {
+    struct ablk *b, **bp;
+    char *p;
+    n = (n + sizeof(b->mem[0]) - 1) / sizeof(b->mem[0]) * sizeof(b->mem[0]);
+    while (acur == NULL || acur->used + n > acur->size) {
+        bp = acur ? &acur->next : &ahead;
+        if (*bp == NULL || (*bp)->size < n) {
+            /* a block big enough goes in here; any too small stays after it */
+            b = OSA_MALLOC(sizeof(*b) + (n > ABLK ? n : ABLK));
+            if (b == NULL)
+                error("no space for table");
+            b->size = n > ABLK ? n : ABLK;
+            b->next = *bp;
+            *bp = b;
+            atotal += b->size;
+        }
+        acur = *bp;
+        acur->used = 0;
+    }
+    p = (char *)acur->mem + acur->used;
+    acur->used += n;
+    ainuse += n;
+    memset(p, 0, n);
+    return (p);
+}
 /* Allocate character storage. */
 char *chspace(void) {
-    char *pp;
-    if (spvecs[spcount] != NULL) // Explicitly check against NULL
-        return (spvecs[spcount++]);
-    if (spcount >= MAXVEC)
-        error("Too many characters in table");
-    pp = ((char*)calloc(MAXCHS + 200, 1));
-    spvecs[spcount++] = pp; // Store before check for clarity, though original was combined
-    if (pp == NULL)
-        error("no space for characters");
-    return (pp);
+    return (aget(MAXCHS + 200));
 }
-#define MAXPC 50
-char *thisvec;
-int tpcount = -1; /* current vector index */
-char *tpvecs[MAXPC];
 /* Allocate vector storage. */
 struct colstr *alocv(int n) {
-    char *tp, *q;
-    if (tpcount < 0 || thisvec + n > tpvecs[tpcount] + MAXCHS) {
-        tpcount++;
-        if (tpvecs[tpcount] == NULL) { // Check against NULL
-            tpvecs[tpcount] = ((char*)calloc(MAXCHS, 1));
-        }
-        thisvec = tpvecs[tpcount];
-        if (thisvec == NULL) // Check against NULL
-            error("no space for vectors");
-    }
-    tp = thisvec;
-    thisvec += n; /* advance allocation pointer */
-    for (q = tp; q < thisvec; q++)
-        *q = 0; // Initialize allocated memory
-    return reinterpret_cast<struct colstr *>(tp);
+    return (struct colstr *)(void *)aget(n);
 }
 /* Release storage vectors. */
 void release(void) {
     extern char *exstore;
-    /* give back unwanted space in some vectors */
-    spcount = 0;
-    tpcount = -1;
+    /* give back the arena as a whole */
+    if (ainuse > apeak)
+        apeak = ainuse;
+    ainuse = 0;
+    acur = NULL;
+    ntables++;
     exstore = NULL;
+    spillend();
+}
+/* Report the storage used, for -S. */
+void tblstat(void) {
+    extern int nspechit, nstophit;
+    struct ablk *b;
+    int nblk;
+    for (nblk = 0, b = ahead; b != NULL; b = b->next)
+        nblk++;
+    fprintf(stderr, "tbl: %d tables, largest took %zu bytes; %d blocks of %zu bytes in all\n",
+            ntables, apeak > ainuse ? apeak : ainuse, nblk, atotal);
+    fprintf(stderr, "tbl: %d specifications and %d sets of tab stops reused\n", nspechit, nstophit);
+    osa_report(stderr);
+}
+/*
+ * Fill in a memory report (src/core/memrep.h) for tbl: the static row
+ * and column tables, the arena, and the longest spill file.
+ */
+int tbl_memrep(otroff_memrep_t *m) {
+    extern char backup[]; /* te.c, BACKMAX bytes */
+    otroff_memrep_init(m, "tbl");
+    otroff_memrep_buf(m, "table", sizeof(table));
+    otroff_memrep_buf(m, "instead", sizeof(instead));
+    otroff_memrep_buf(m, "fullbot", sizeof(fullbot));
+    otroff_memrep_buf(m, "linestop", sizeof(linestop));
+    otroff_memrep_buf(m, "stynum", sizeof(stynum));
+    otroff_memrep_buf(m, "style", sizeof(style));
+    otroff_memrep_buf(m, "ctop", sizeof(ctop));
+    otroff_memrep_buf(m, "lefline", sizeof(lefline));
+    otroff_memrep_buf(m, "font", sizeof(font));
+    otroff_memrep_buf(m, "csize", sizeof(csize));
+    otroff_memrep_buf(m, "cll", sizeof(cll));
+    otroff_memrep_buf(m, "backup", 500);
+    otroff_memrep_arena(m, atotal, apeak > ainuse ? apeak : ainuse);
+    m->temp_bytes = spillpeak();
+    otroff_memrep_sample(m);
+    return (0);
+}
+/* Report memory, for -M. */
+void tblmem(void) {
+    otroff_memrep_t m;
+    tbl_memrep(&m);
+    otroff_memrep_print(&m, stderr);
 }
@@ -94,6 +94,7 @@ int vspand(int ir, int ij);
 int vspen(char *s);
 void maktab(void);
 void wide(char *s, char *fn, char *size);
+void toowide(void);
 void runout(void);
 void runtabs(int i);
 int ifline(char *s);
@@ -110,12 +111,17 @@ int real(char *s);
 char *chspace(void);
 struct colstr *alocv(int n);
 void release(void);
+void tblstat(void);
+void tblmem(void);
 void choochar(void);
 int point(char *s);
 void error(char *s);
 char *gets1(char *s);
 void un1getc(int c);
 int get1char(void);
+void inmem(char *buf, size_t n);
+void infile(void);
+int copythru(char *line);
 void savefill(void);
 void rstofill(void);
 void endoff(void);
@@ -158,4 +164,36 @@ int lefdata(int i, int c);
 int next(int i);
 int prev(int i);
 
+/* from tw.c */
+int twopt(char *name);
+int twidth(char *s);
+
+/* from tx.c */
+char *spill(char *s);
+void spillrew(void);
+char *spillget(void);
+void spillend(void);
+size_t spillpeak(void);
+
+/* from ty.c */
+int spechit(void);
+void specput(void);
+int stophit(void);
+void stopbeg(void);
+void stopend(void);
+
+/* from tz.c */
+void rowbeg(void);
+void rowend(void);
+
+/* from tj.c */
+void jobsopt(char *s);
+int tblfork(void);
+int tbldrain(void);
+
+/* from t9.c */
+int moreopen(void);
+int moreline(int useln);
+void moreclose(void);
+
 #endif /* TBL_H */
@@ -1,8 +1,9 @@
 /* C17 - no scaffold needed */
-/* te.c: error message control, input line count */
+/* te.c: error message control, input buffering, line count */
 #include "tbl.h"
 #include <stdlib.h> /* exit */
-#include <stdio.h> /* fprintf */
+#include <stdio.h> /* fprintf, fread, fwrite */
+#include <string.h> /* memchr, memmove */
 
 /* Report an error and exit. */
 void error(char *s) {
@@ -16,27 +17,165 @@ void error(char *s) {
     exit(0);
 #endif
 }
+#define BACKMAX 500
+char backup[BACKMAX];
+char *backp = backup; // Corrected syntax
+#define INBUF 65536 /* input read at a time */
+
+/* Input read ahead of gets1(), get1char() and copythru() */
+struct input {
+    char *p, *e; /* what is left */
+    int mem; /* a table in memory (tj.c): nothing to read after it */
+};
+static char inbuf[INBUF];
+static struct input infile0 = {inbuf, inbuf, 0}, inmem0, *in = &infile0;
+static int lastc = '\n'; /* the byte copythru() wrote last */
+
+/* Read more of tabin after what is left; 0 at its end. */
+static int fill(void) {
+    size_t n, k;
+    if (in->mem || tabin == NULL)
+        return (0);
+    n = in->e - in->p;
+    memmove(inbuf, in->p, n);
+    k = fread(inbuf + n, 1, INBUF - n, tabin);
+    in->p = inbuf;
+    in->e = inbuf + n + k;
+    return (k > 0);
+}
+
+/* Have at least n bytes to look at; 0 if the input ends first. */
+static int ahead(int n) {
+    while (in->e - in->p < n)
+        if (!fill())
+            return (0);
+    return (1);
+}
+
+/* Copy a line to s as fgets() would, at most n-1 bytes; NULL at the end. */
+static char *getln(char *s, int n) {
+    char *d, *nl;
+    size_t k;
+    for (d = s, nl = NULL; nl == NULL && d < s + n - 1 && (in->p < in->e || fill());) {
+        k = min(in->e - in->p, s + n - 1 - d);
+        if ((nl = memchr(in->p, '\n', k)) != NULL)
+            k = nl - in->p + 1;
+        memcpy(d, in->p, k);
+        d += k;
+        in->p += k;
+    }
+    *d = 0;
+    return (d == s ? NULL : s);
+}
+
+/* The next byte of input, or EOF */
+static int inchar(void) {
+    if (in->p < in->e || fill())
+        return ((unsigned char)*in->p++);
+    return (EOF);
+}
+
+/* Read from the n bytes at buf, the table tj.c holds, until infile(). */
+void inmem(char *buf, size_t n) {
+    inmem0.p = buf;
+    inmem0.e = buf + n;
+    inmem0.mem = 1;
+    in = &inmem0;
+}
+
+/* Go back to reading tabin. */
+void infile(void) {
+    in = &infile0;
+}
+
 /* Get a line from input with continuation handling. */
 char *gets1(char *s) {
     char *p;
     iline++;
-    p = fgets(s, 512, tabin);
+    p = getln(s, 512);
     if (p == NULL) {
-        if (swapin() == 0 || (p = fgets(s, 512, tabin)) == NULL)
+        if (swapin() == 0 || (p = getln(s, 512)) == NULL)
             return (NULL); // Return NULL for char*
     }
     while (*s)
         s++;
-    s--;
-    if (*s == '\n')
-        *s-- = 0;
-    if (*s == '\\')
-        gets1(s);
+    if (s > p && s[-1] == '\n')
+        *--s = 0;
+    if (s > p && s[-1] == '\\') /* an empty line has nothing before it */
+        gets1(s - 1);
     return (p);
 }
-#define BACKMAX 500
-char backup[BACKMAX];
-char *backp = backup; // Corrected syntax
+
+/* Count the newlines in the n bytes at s, for iline. */
+static int lines(char *s, size_t n) {
+    size_t i;
+    int k;
+    for (k = 0, i = 0; i < n; i++)
+        k += s[i] == '\n';
+    return (k);
+}
+
+/* The newline in [p, e) before the first line that starts a table, or NULL. */
+static char *tsline(char *p, char *e) {
+    char *q;
+    for (q = p; e - q >= 4 && (q = memchr(q, '\n', e - q - 3)) != NULL; q++)
+        if (q[1] == '.' && q[2] == 'T' && q[3] == 'S' && (q > p ? q[-1] : lastc) != '\\')
+            return (q);
+    return (NULL);
+}
+
+/*
+ * Copy the input to tabout up to and including the next line that
+ * starts a table, which is left in line as gets1() reads it; 0 at the
+ * end of the input.  The text between tables goes out as it stands, a
+ * buffer at a time.
+ */
+int copythru(char *line) {
+    char *p, *q;
+    int eof;
+    for (;;) {
+        if (backp > backup) { /* something was put back: go a line at a time */
+            if (!gets1(line))
+                return (0);
+            fprintf(tabout, "%s\n", line);
+            if (prefix(".TS", line))
+                return (1);
+            continue;
+        }
+        eof = !ahead(4);
+        p = in->p;
+        if (lastc == '\n' && in->e - p >= 3 && p[0] == '.' && p[1] == 'T' && p[2] == 'S') {
+            if (!gets1(line))
+                return (0);
+            fprintf(tabout, "%s\n", line);
+            return (1);
+        }
+        if (eof) { /* the rest of this file, and on to the next */
+            if (p < in->e) {
+                fwrite(p, 1, in->e - p, tabout);
+                iline += lines(p, in->e - p);
+                lastc = in->e[-1];
+                in->p = in->e;
+            }
+            if (lastc != '\n') { /* end the last line as gets1() would */
+                putc('\n', tabout);
+                iline++;
+            }
+            lastc = '\n';
+            if (swapin() == 0)
+                return (0);
+            iline = 0;
+            continue;
+        }
+        /* through the newline before the next .TS line, else all but what it might start with */
+        q = tsline(p, in->e);
+        q = q != NULL ? q + 1 : in->e - 3;
+        fwrite(p, 1, q - p, tabout);
+        iline += lines(p, q - p);
+        lastc = q[-1];
+        in->p = q;
+    }
+}
 /* Push a character back to the input stream. */
 void un1getc(int c) {
     if (c == '\n')
@@ -51,12 +190,12 @@ int get1char(void) {
     if (backp > backup)
         c = *--backp;
     else
-        c = getc(tabin);
+        c = inchar();
     if (c == EOF) /* EOF */
     {
         if (swapin() == 0)
             error("unexpected EOF", 0);
-        c = getc(tabin);
+        c = inchar();
     }
     if (c == '\n')
         iline++;
@@ -0,0 +1,216 @@
+/* C17 - no scaffold needed */
+/* tj.c: tables formatted in parallel (-j) */
+/*
+ * With -j<n> each table is read up to its .TE and handed to a child
+ * process, up to n at once, while the main process reads on.  The
+ * output of each child, and whatever the main process writes between
+ * tables, goes to a file of its own; the files are copied to standard
+ * output in input order.
+ *
+ * Tables share almost nothing: what does carry from one to the next
+ * (evenflg, once an e column has been seen) is left to the main
+ * process, which formats every table with an e or E in a specification
+ * itself.  So does a table that runs into the next input file.  The
+ * specification and tab stop caches of ty.c are not shared with the
+ * children.
+ */
+#include "tbl.h"
+#define OSA_TAG "tbl"
+#include "os/os_acct.h" /* OSA_MALLOC, OSA_REALLOC, OSA_FREE, ... */
+#include <errno.h> /* EINTR */
+#include <stdlib.h> /* malloc, realloc, free, mkstemp */
+#include <unistd.h> /* fork, dup, dup2, read, write, sysconf */
+#include <sys/wait.h> /* waitpid */
+
+extern int sargc;
+
+int njobs = 0; /* -j: children at once; 0 or 1 for none */
+
+struct seg {
+    pid_t pid; /* child writing the file, 0 for the main process */
+    int fd; /* the output, unlinked */
+};
+static struct seg *segq; /* output files not yet copied, in input order */
+static int segn, segcap;
+static int realout = -1; /* standard output while the queue is in use */
+static int running; /* children not yet waited for */
+static int worst; /* worst exit status of a child */
+
+/* Parse -j, -j<n>. */
+void jobsopt(char *s) {
+    long n;
+    if (*s)
+        njobs = numb(s);
+    else if ((n = sysconf(_SC_NPROCESSORS_ONLN)) > 0)
+        njobs = (int)n;
+}
+
+/* Could the table in s change what the tables after it see? */
+static int stateful(char *s) {
+    char *nl;
+    int spec, line;
+    for (spec = 1, line = 0; *s; s = nl + 1, line++) {
+        if ((nl = strchr(s, '\n')) == NULL)
+            nl = s + strlen(s);
+        if (prefix(".T&", s))
+            spec = 1;
+        else if (spec && !(line == 0 && memchr(s, ';', nl - s) != NULL)) {
+            for (; s < nl && *s != '.'; s++)
+                if (*s == 'e' || *s == 'E')
+                    return (1);
+            if (s < nl)
+                spec = 0;
+        }
+        if (*nl == 0)
+            break;
+    }
+    return (0);
+}
+
+/* A new, already unlinked, output file */
+static int segopen(void) {
+    char tmp[] = "/tmp/tblXXXXXX";
+    int fd;
+    if ((fd = mkstemp(tmp)) < 0)
+        return (-1);
+    unlink(tmp);
+    return (fd);
+}
+
+/* Send the file at the front of the queue, waiting for its child. */
+static void segnext(void) {
+    char buf[BUFSIZ];
+    struct seg s;
+    ssize_t r;
+    int status;
+    s = segq[0];
+    if (s.pid != 0) {
+        while (waitpid(s.pid, &status, 0) < 0)
+            if (errno != EINTR) {
+                status = -1; /* lost: count it as failed */
+                break;
+            }
+        running--;
+        if (status == -1 || !WIFEXITED(status))
+            worst |= 1;
+        else
+            worst |= WEXITSTATUS(status);
+    }
+    lseek(s.fd, 0, SEEK_SET);
+    while ((r = OSA_READ(s.fd, buf, sizeof(buf))) > 0)
+        if (OSA_WRITE(realout, buf, (size_t)r) != r)
+            break;
+    close(s.fd);
+    memmove(segq, segq + 1, --segn * sizeof(*segq));
+}
+
+static int segput(pid_t pid, int fd) {
+    struct seg *q;
+    if (segn == segcap) {
+        if ((q = OSA_REALLOC(segq, (segcap ? 2 * segcap : 16) * sizeof(*segq))) == NULL)
+            return (-1);
+        segq = q;
+        segcap = segcap ? 2 * segcap : 16;
+    }
+    segq[segn].pid = pid;
+    segq[segn++].fd = fd;
+    return (0);
+}
+
+/* The rest of the table at the input, through its .TE; *n is its length. */
+static char *slurp(size_t *n) {
+    char line[512], *buf, *b;
+    size_t cap, k;
+    buf = NULL;
+    *n = cap = 0;
+    while (gets1(line)) {
+        k = strlen(line);
+        if (*n + k + 2 > cap) {
+            cap = 2 * cap + k + 4096;
+            if ((b = OSA_REALLOC(buf, cap)) == NULL)
+                error("no space for table");
+            buf = b;
+        }
+        memcpy(buf + *n, line, k);
+        *n += k;
+        buf[(*n)++] = '\n';
+        if (prefix(".TE", line))
+            break;
+    }
+    if (buf == NULL && (buf = OSA_MALLOC(1)) == NULL)
+        error("no space for table");
+    buf[*n] = 0;
+    return (buf);
+}
+
+/* Format the table held in buf, begun at input line line, as though it were the input. */
+static void tablemem(char *buf, size_t n, int line) {
+    iline = line;
+    inmem(buf, n);
+    tableput();
+    infile();
+}
+
+/*
+ * Format the table at the input in a child, if it can be; the .TS
+ * line has been read.  Returns 1 if the table has been dealt with,
+ * either by a child or in memory, 0 if the caller must format it.
+ */
+int tblfork(void) {
+    const char *file;
+    char *buf;
+    size_t n;
+    pid_t pid;
+    int cfd, pfd, line;
+    if (njobs <= 1)
+        return (0);
+    file = ifile;
+    line = iline;
+    buf = slurp(&n);
+    fflush(stdout);
+    if (file != ifile || n == 0 || stateful(buf) || (realout < 0 && (realout = dup(1)) < 0)) {
+        tablemem(buf, n, line);
+        OSA_FREE(buf);
+        return (1);
+    }
+    while (running >= njobs)
+        segnext();
+    cfd = pfd = -1;
+    if ((cfd = segopen()) < 0 || (pfd = segopen()) < 0 || (pid = fork()) < 0) {
+        if (cfd >= 0)
+            close(cfd);
+        if (pfd >= 0)
+            close(pfd);
+        tablemem(buf, n, line);
+        OSA_FREE(buf);
+        return (1);
+    }
+    if (pid == 0) {
+        dup2(cfd, 1);
+        close(cfd);
+        close(pfd);
+        sargc = 0; /* the table is all there is to read */
+        tablemem(buf, n, line);
+        fflush(stdout);
+        _exit(0);
+    }
+    running++;
+    OSA_FREE(buf);
+    if (segput(pid, cfd) < 0 || segput(0, pfd) < 0)
+        error("no space to keep tables in order");
+    dup2(pfd, 1); /* what follows the table comes after it */
+    return (1);
+}
+
+/* Send all queued output and wait for every child; the worst status. */
+int tbldrain(void) {
+    if (realout < 0)
+        return (0);
+    fflush(stdout);
+    while (segn > 0)
+        segnext();
+    dup2(realout, 1);
+    close(realout);
+    realout = -1;
+    return (worst);
+}
@@ -0,0 +1,51 @@
+/* C17 - no scaffold needed */
+/* tw.c: column widths from the nroff terminal table (-T) */
+/*
+ * With -Tname tbl loads the terminal table croff would use for -Tname
+ * (twload() in croff/twload.c, built in or a mktab file) and measures
+ * plain cells itself, the way croff's width() does, so maktab() need not
+ * send a \w and a comparison to nroff for every cell.
+ *
+ * In nroff the font and point size do not change the width of a
+ * character, so every font and size is measured the same.  A cell with
+ * an escape, a control character or a byte outside ASCII, and every
+ * text block, is still left to nroff.  The output is then for nroff
+ * only, and assumes the document does not .tr a character in a table.
+ */
+#define NROFF 1
+#include "../croff/tdef.h" /* struct typewriter_table */
+
+#include <stdio.h> /* snprintf */
+
+extern int twload(const char *path, const char *name);
+extern void error(char *s);
+extern int point(char *s);
+
+struct typewriter_table t;
+int natwid = 0; /* widths measured by tbl, not by nroff */
+
+int twopt(char *name);
+int twidth(char *s);
+
+/* Load the table of terminal name, as croff -Tname does. */
+int twopt(char *name) {
+    char path[NS];
+
+    snprintf(path, sizeof(path), "/usr/lib/term/%s", name);
+    if (*name == 0 || twload(path, name) < 0)
+        error("Can't load terminal table");
+    natwid = 1;
+    return (0);
+}
+
+/* Width of s in nroff units, or -1 if nroff must measure it. */
+int twidth(char *s) {
+    int w, c;
+
+    if (!natwid || !point(s))
+        return (-1);
+    for (w = 0; (c = *s++ & 0377) != 0; w += (*t.codetab[c - 32] & 0177) * t.Char)
+        if (c == '\\' || c < 040 || c >= 0177 || t.codetab[c - 32] == 0)
+            return (-1);
+    return (w);
+}
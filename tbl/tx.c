@@ -0,0 +1,92 @@
+/* C17 - no scaffold needed */
+/* tx.c: spill file for the rows of a table past MAXLIN */
+/*
+ * gettbl() keeps the first MAXLIN rows in memory.  The rest, up to the
+ * .TE, are copied to an unlinked temporary file, which is mapped and
+ * read twice: once by maktab() and checkuse() so the widths cover the
+ * whole table, then by yetmore() to write the rows.  Only one row of
+ * the file is held at a time, so a table of any length needs the same
+ * memory as one of MAXLIN rows.
+ */
+#include "tbl.h"
+#include <stdlib.h> /* mkstemp */
+#include <unistd.h> /* unlink, close */
+#include <sys/mman.h> /* mmap, munmap */
+#include <sys/stat.h> /* fstat */
+
+static char *spbase; /* the mapped file, NULL if none */
+static size_t spsize; /* its length */
+static char *spnext; /* the next row in it */
+static char spline[512]; /* the row spillget() returned */
+static char spend[512]; /* the line that ended the table */
+static size_t sppeak; /* the longest spill file, for -M */
+
+/* Copy s and the rest of the table to the spill file; returns the .TE line. */
+char *spill(char *s) {
+    char tmp[] = "/tmp/tblXXXXXX";
+    struct stat st;
+    FILE *f;
+    int fd;
+
+    spillend();
+    if ((fd = mkstemp(tmp)) < 0 || (f = fdopen(fd, "w+")) == NULL)
+        error("Can't create spill file for a long table");
+    unlink(tmp);
+    spend[0] = 0;
+    do {
+        if (prefix(".TE", s)) {
+            tcopy(spend, s);
+            break;
+        }
+        fprintf(f, "%s\n", s);
+    } while (gets1(s));
+    if (fflush(f) != 0 || fstat(fd, &st) < 0)
+        error("Can't write spill file for a long table");
+    spsize = (size_t)st.st_size;
+    if (spsize > sppeak)
+        sppeak = spsize;
+    if (spsize > 0) {
+        spbase = mmap(NULL, spsize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (spbase == MAP_FAILED) {
+            spbase = NULL;
+            error("Can't map spill file for a long table");
+        }
+    }
+    fclose(f);
+    spnext = spbase;
+    return (spend);
+}
+
+/* Go back to the first row of the spill file. */
+void spillrew(void) {
+    spnext = spbase;
+}
+
+/* The next row of the spill file, or NULL after the last. */
+char *spillget(void) {
+    char *e;
+    size_t n;
+
+    if (spbase == NULL || spnext >= spbase + spsize)
+        return (NULL);
+    if ((e = memchr(spnext, '\n', spbase + spsize - spnext)) == NULL)
+        e = spbase + spsize;
+    n = min((int)(e - spnext), (int)sizeof(spline) - 1);
+    memcpy(spline, spnext, n);
+    spline[n] = 0;
+    spnext = e + 1;
+    return (spline);
+}
+
+/* Bytes in the longest spill file there has been. */
+size_t spillpeak(void) {
+    return (sppeak);
+}
+
+/* Drop the spill file of the last table. */
+void spillend(void) {
+    if (spbase != NULL)
+        munmap(spbase, spsize);
+    spbase = spnext = NULL;
+    spsize = 0;
+}
@@ -0,0 +1,253 @@
+/* C17 - no scaffold needed */
+/* ty.c: keep table specifications and tab stops for later tables */
+/*
+ * Generated documents set many tables the same way.  The state
+ * readspec() builds from a specification is kept, keyed by the text
+ * of the specification, and a table with the same text takes it
+ * without parsing.  The troff maktab() writes is kept too, keyed by
+ * everything it reads: the format, the options, the delimiters and
+ * the entries.  A table that matches all of that gets the same tab
+ * stop prologue without working it out again.
+ *
+ * Each cache holds the last NKEEP entries.  A specification that drew
+ * a warning, and a table too long to be held (one with leftover rows),
+ * are not kept.
+ */
+#include "tbl.h"
+#define OSA_TAG "tbl"
+#include "os/os_acct.h" /* OSA_MALLOC, OSA_FREE */
+#include <stdlib.h> /* malloc, free */
+
+#define NKEEP 16 /* entries in each cache */
+#define SPECMAX 400 /* longest specification kept, less than the push-back */
+#define STOPMAX 65536 /* longest key kept for tab stops */
+
+extern int oncol;
+extern int specwarn;
+extern int natwid;
+
+/* The state readspec() leaves */
+struct spec {
+    char *text; /* the specification, NULL for an empty slot */
+    int tab; /* the tab character it was read with */
+    int style[MAXHEAD][MAXCOL];
+    int ctop[MAXHEAD][MAXCOL];
+    char font[MAXHEAD][MAXCOL][2];
+    char csize[MAXHEAD][MAXCOL][4];
+    int lefline[MAXHEAD][MAXCOL];
+    char cll[MAXCOL][CLLEN];
+    int sep[MAXCOL];
+    int evenup[MAXCOL];
+    int ncol, nclin, rightl, left1flg, oncol;
+};
+static struct spec *spectab[NKEEP];
+static int specnext; /* slot to fill next */
+static char spectext[SPECMAX + 1]; /* the specification just read */
+static int specwas; /* warnings before it was parsed */
+
+/* Tab stop prologue */
+struct stop {
+    char *key; /* NULL for an empty slot */
+    size_t klen;
+    char *text;
+    size_t tlen;
+};
+static struct stop stoptab[NKEEP];
+static int stopnext;
+static FILE *stopout; /* tabout while maktab() writes to the buffer */
+static char *stopkey, *stopbuf;
+static size_t stopklen, stopblen;
+static FILE *stopf;
+int nspechit, nstophit; /* for -S */
+
+/*
+ * Read the specification at the input and take its state from the
+ * cache if it is there; 1 if so.  If not, it is put back for readspec().
+ */
+int spechit(void) {
+    int c, n, paren, end, i;
+    struct spec *sp;
+    c = paren = end = 0;
+    for (n = 0; n < SPECMAX;) {
+        spectext[n++] = c = get1char();
+        if (end) {
+            if (c == '\n')
+                break;
+        } else if (c == '(')
+            paren = 1;
+        else if (c == ')')
+            paren = 0;
+        else if (c == '.' && !paren)
+            end = 1; /* the rest of the line goes with it */
+    }
+    spectext[n] = 0;
+    if (!end || c != '\n') { /* too long to keep: give it all back */
+        while (n > 0)
+            un1getc(spectext[--n]);
+        spectext[0] = 0;
+        return (0);
+    }
+    for (i = 0; i < NKEEP; i++) {
+        sp = spectab[i];
+        if (sp == NULL || sp->tab != tab || !match(sp->text, spectext))
+            continue;
+        memcpy(style, sp->style, sizeof(style));
+        memcpy(ctop, sp->ctop, sizeof(ctop));
+        memcpy(font, sp->font, sizeof(font));
+        memcpy(csize, sp->csize, sizeof(csize));
+        memcpy(lefline, sp->lefline, sizeof(lefline));
+        memcpy(cll, sp->cll, sizeof(cll));
+        memcpy(sep, sp->sep, sizeof(sep));
+        memcpy(evenup, sp->evenup, sizeof(evenup));
+        for (c = 0; c < MAXCOL; c++)
+            if (evenup[c])
+                evenflg = 1;
+        ncol = sp->ncol;
+        nclin = sp->nclin;
+        rightl = sp->rightl;
+        left1flg = sp->left1flg;
+        oncol = sp->oncol;
+        nspechit++;
+        return (1);
+    }
+    while (n > 0)
+        un1getc(spectext[--n]);
+    specwas = specwarn;
+    return (0);
+}
+
+/* Keep the state readspec() made of the specification spechit() missed. */
+void specput(void) {
+    struct spec *sp;
+    if (spectext[0] == 0 || specwarn != specwas)
+        return;
+    if ((sp = spectab[specnext]) == NULL) {
+        if ((sp = OSA_MALLOC(sizeof(*sp))) == NULL)
+            return;
+        sp->text = NULL;
+        spectab[specnext] = sp;
+    }
+    OSA_FREE(sp->text);
+    if ((sp->text = OSA_MALLOC(strlen(spectext) + 1)) == NULL)
+        return;
+    tcopy(sp->text, spectext);
+    sp->tab = tab;
+    memcpy(sp->style, style, sizeof(style));
+    memcpy(sp->ctop, ctop, sizeof(ctop));
+    memcpy(sp->font, font, sizeof(font));
+    memcpy(sp->csize, csize, sizeof(csize));
+    memcpy(sp->lefline, lefline, sizeof(lefline));
+    memcpy(sp->cll, cll, sizeof(cll));
+    memcpy(sp->sep, sep, sizeof(sep));
+    memcpy(sp->evenup, evenup, sizeof(evenup));
+    sp->ncol = ncol;
+    sp->nclin = nclin;
+    sp->rightl = rightl;
+    sp->left1flg = left1flg;
+    sp->oncol = oncol;
+    specnext = (specnext + 1) % NKEEP;
+}
+
+/* Append n bytes at p to the key. */
+static void keyput(FILE *f, const void *p, size_t n) {
+    fwrite(p, 1, n, f);
+}
+
+/* Append a table entry: text, a text block name or nothing. */
+static void keystr(FILE *f, char *s) {
+    if (s == NULL)
+        putc(1, f);
+    else if (!point(s)) {
+        putc(2, f);
+        putc((int)(long)s, f);
+    } else {
+        putc(3, f);
+        keyput(f, s, strlen(s) + 1);
+    }
+}
+
+/* The key of the tab stops of the table read: all maktab() reads. */
+static int stopmake(void) {
+    FILE *f;
+    int flags[13], i, c;
+    if (leftover || (f = open_memstream(&stopkey, &stopklen)) == NULL)
+        return (0);
+    flags[0] = ncol, flags[1] = nlin, flags[2] = nclin, flags[3] = F1;
+    flags[4] = F2, flags[5] = expflg, flags[6] = boxflg, flags[7] = dboxflg;
+    flags[8] = allflg, flags[9] = evenflg, flags[10] = left1flg, flags[11] = natwid;
+    flags[12] = rightl;
+    keyput(f, flags, sizeof(flags));
+    keyput(f, sep, sizeof(sep));
+    keyput(f, cll, sizeof(cll));
+    keyput(f, evenup, sizeof(evenup));
+    for (i = 0; i < nclin; i++) {
+        keyput(f, style[i], sizeof(style[i]));
+        keyput(f, font[i], sizeof(font[i]));
+        keyput(f, csize[i], sizeof(csize[i]));
+    }
+    for (i = 0; i < nlin; i++) {
+        keyput(f, &stynum[i], sizeof(stynum[i]));
+        keyput(f, &fullbot[i], sizeof(fullbot[i]));
+        putc(instead[i] != 0, f);
+        if (instead[i] || fullbot[i])
+            continue;
+        for (c = 0; c < ncol; c++) {
+            keystr(f, table[i][c].col);
+            keystr(f, table[i][c].rcol);
+        }
+    }
+    if (fclose(f) != 0 || stopklen > STOPMAX) {
+        OSA_FREE(stopkey);
+        stopkey = NULL;
+        return (0);
+    }
+    return (1);
+}
+
+/* Write the tab stops kept for a table like this one; 1 if there were any. */
+int stophit(void) {
+    int i;
+    OSA_FREE(stopkey);
+    stopkey = NULL;
+    if (!stopmake())
+        return (0);
+    for (i = 0; i < NKEEP; i++)
+        if (stoptab[i].key != NULL && stoptab[i].klen == stopklen &&
+            memcmp(stoptab[i].key, stopkey, stopklen) == 0) {
+            fwrite(stoptab[i].text, 1, stoptab[i].tlen, tabout);
+            OSA_FREE(stopkey);
+            stopkey = NULL;
+            nstophit++;
+            return (1);
+        }
+    return (0);
+}
+
+/* Collect what maktab() writes for the table stophit() missed. */
+void stopbeg(void) {
+    if (stopkey == NULL || (stopf = open_memstream(&stopbuf, &stopblen)) == NULL)
+        return;
+    stopout = tabout;
+    tabout = stopf;
+}
+
+/* Send on what maktab() wrote, and keep it. */
+void stopend(void) {
+    struct stop *sp;
+    if (stopout == NULL)
+        return;
+    tabout = stopout;
+    stopout = NULL;
+    if (fclose(stopf) != 0 || stopbuf == NULL)
+        error("Lost the tab stops of a table");
+    fwrite(stopbuf, 1, stopblen, tabout);
+    sp = &stoptab[stopnext];
+    OSA_FREE(sp->key);
+    OSA_FREE(sp->text);
+    sp->key = stopkey;
+    sp->klen = stopklen;
+    sp->text = stopbuf;
+    sp->tlen = stopblen;
+    stopkey = stopbuf = NULL;
+    stopnext = (stopnext + 1) % NKEEP;
+}
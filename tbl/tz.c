@@ -0,0 +1,290 @@
+/* C17 - no scaffold needed */
+/* tz.c: build each table row in a buffer, and tidy it with -O */
+/*
+ * putline() writes a row a piece at a time: a font or size change
+ * around every entry, a motion to every column.  Between rowbeg() and
+ * rowend() that goes to a buffer, which is written out in one go.
+ *
+ * With -O the text lines of the row are also tidied:
+ * - \fP then only motions and field characters, then the font just
+ *   left, is dropped, so neighbouring entries in one font share it;
+ *   the same for \s0 and a size
+ * - a horizontal motion followed by an absolute one is dropped, and
+ *   two relative motions in a row, either way, become one
+ * - motions of zero are dropped
+ * Requests and anything tbl does not recognize are left as they are.
+ */
+#include "tbl.h"
+#define OSA_TAG "tbl"
+#include "os/os_acct.h" /* OSA_MALLOC, OSA_FREE */
+#include <stdlib.h> /* malloc, free */
+
+#define NTOK 512 /* pieces of one line that are tidied */
+
+int peepflg = 0; /* -O */
+
+static FILE *rowout; /* tabout during the row, NULL when none */
+static FILE *rowf;
+static char *rowbuf;
+static size_t rowlen;
+
+/* One piece of a text line */
+struct tok {
+    int kind; /* one of the below */
+    char *s; /* the text, or the argument or name */
+    int n; /* its length */
+};
+#define TTEXT 0 /* printed, or not understood */
+#define TFONT 1 /* \fX, \f(XX: s is X */
+#define TSIZE 2 /* \sN, \s+N: s is N */
+#define THMOT 3 /* \h'...': s is what is between the quotes */
+#define TVMOT 4 /* \v'...' */
+#define TGONE 5 /* dropped */
+
+/* Start collecting a row. */
+void rowbeg(void) {
+    if (rowout != NULL || (rowf = open_memstream(&rowbuf, &rowlen)) == NULL)
+        return;
+    rowout = tabout;
+    tabout = rowf;
+}
+
+/* Split the text line s of n bytes into t; the count, or -1 if too many. */
+static int split(char *s, int n, struct tok *t) {
+    char *e, *p, *q;
+    int k;
+    e = s + n;
+    for (k = 0, p = s; p < e; k++) {
+        if (k >= NTOK)
+            return (-1);
+        t[k].kind = TTEXT;
+        t[k].s = p;
+        q = p + 1;
+        if (*p == '\\' && q < e) {
+            q++;
+            switch (p[1]) {
+            case 'f':
+                if (q < e && *q == '(' && q + 2 < e) {
+                    t[k].kind = TFONT;
+                    t[k].s = q + 1;
+                    t[k].n = 2;
+                    q += 3;
+                } else if (q < e && *q != '[') {
+                    t[k].kind = TFONT;
+                    t[k].s = q;
+                    t[k].n = 1;
+                    q++;
+                }
+                break;
+            case 's':
+                p = q;
+                if (q < e && (*q == '+' || *q == '-'))
+                    q++;
+                if (q < e && digit(*q)) {
+                    if (p == q && *q >= '1' && *q <= '3' && q + 1 < e && digit(q[1]))
+                        q++; /* \s10 to \s39 */
+                    q++;
+                    t[k].kind = TSIZE;
+                    t[k].s = p;
+                    t[k].n = q - p;
+                } else
+                    q = p;
+                break;
+            case 'h':
+            case 'v':
+                if (q < e && *q == '\'' && (p = memchr(q + 1, '\'', e - q - 1)) != NULL) {
+                    t[k].kind = t[k].s[1] == 'h' ? THMOT : TVMOT;
+                    t[k].s = q + 1;
+                    t[k].n = p - q - 1;
+                    q = p + 1;
+                }
+                break;
+            case '(':
+                q = min(q + 2, e);
+                break;
+            case '*':
+            case 'n':
+                if (q < e && *q == '(')
+                    q = min(q + 3, e);
+                else if (q < e)
+                    q++;
+                break;
+            }
+        }
+        if (t[k].kind == TTEXT)
+            t[k].n = q - t[k].s;
+        p = q;
+    }
+    return (k);
+}
+
+/* Is t nothing that prints: a field character or a motion? */
+static int unseen(struct tok *t) {
+    int i;
+    if (t->kind == THMOT || t->kind == TVMOT || t->kind == TGONE)
+        return (1);
+    if (t->kind != TTEXT)
+        return (0);
+    for (i = 0; i < t->n; i++)
+        if (t->s[i] != F1 && t->s[i] != F2)
+            return (0);
+    return (1);
+}
+
+/* Length of the register reference at s, such as \n(xx, or 0. */
+static int regref(char *s, char *e) {
+    if (e - s < 3 || s[0] != '\\' || s[1] != 'n')
+        return (0);
+    if (s[2] != '(')
+        return (3);
+    return (e - s < 5 ? 0 : 5);
+}
+
+/* Does the motion t move as far whatever the point size? */
+static int sizefree(struct tok *t) {
+    char *p, *e;
+    int r;
+    if (t->kind != THMOT && t->kind != TVMOT)
+        return (1);
+    for (p = t->s, e = t->s + t->n; p < e; p++)
+        if ((r = regref(p, e)) > 0)
+            p += r - 1;
+        else if (*p == 'm' || *p == 'n' || *p == 'M')
+            return (0);
+    return (1);
+}
+
+/* Is t a move to a fixed place, |N or |\n(xx with a unit? */
+static int absolute(struct tok *t) {
+    char *p, *e;
+    int r;
+    p = t->s;
+    e = t->s + t->n;
+    if (p >= e || *p++ != '|')
+        return (0);
+    if ((r = regref(p, e)) > 0)
+        p += r;
+    else
+        while (p < e && (digit(*p) || *p == '.'))
+            p++;
+    if (p < e && letter(*p))
+        p++;
+    return (p == e && e - t->s > 1);
+}
+
+static int same(struct tok *a, struct tok *b) {
+    return (a->n == b->n && memcmp(a->s, b->s, a->n) == 0);
+}
+
+static int zero(struct tok *t) {
+    return (t->n == 1 && t->s[0] == '0');
+}
+
+/*
+ * Drop a reset of kind k (\fP, \s0) and the change after it, when it
+ * goes back to what was just left with nothing printed in between.
+ */
+static void unreset(struct tok *t, int n, int k, char *reset) {
+    int i, j, last;
+    for (last = -1, i = 0; i < n; i++) {
+        if (t[i].kind != k)
+            continue;
+        if (t[i].n != 1 || t[i].s[0] != *reset || last < 0) {
+            last = i;
+            continue;
+        }
+        for (j = i + 1; j < n && unseen(&t[j]) && (k != TSIZE || sizefree(&t[j])); j++)
+            ;
+        if (j < n && t[j].kind == k && same(&t[j], &t[last])) {
+            t[i].kind = t[j].kind = TGONE;
+            continue; /* t[last] is in effect again */
+        }
+        last = -1; /* its previous setting is not known */
+    }
+}
+
+/* Merge runs of motions. */
+static void unmove(struct tok *t, int n, char **room, char *end) {
+    int i, j;
+    char *p;
+    for (i = 0; i < n; i++) {
+        if (t[i].kind != THMOT && t[i].kind != TVMOT)
+            continue;
+        if (zero(&t[i])) {
+            t[i].kind = TGONE;
+            continue;
+        }
+        for (j = i + 1; j < n && t[j].kind == TGONE; j++)
+            ;
+        if (j >= n || t[j].kind != t[i].kind)
+            continue;
+        if (t[i].kind == THMOT && absolute(&t[j]))
+            t[i].kind = TGONE; /* the next goes to a place of its own */
+        else if (memchr(t[i].s, '|', t[i].n) == NULL && memchr(t[j].s, '|', t[j].n) == NULL &&
+                 end - *room > t[i].n + t[j].n + 5) {
+            p = *room;
+            *room += sprintf(p, "(%.*s)+(%.*s)", t[i].n, t[i].s, t[j].n, t[j].s);
+            t[j].s = p;
+            t[j].n = *room - p;
+            t[i].kind = TGONE;
+        }
+    }
+}
+
+/* Write the text line s of n bytes, tidied. */
+static void tidy(char *s, int n) {
+    static struct tok t[NTOK];
+    char *room, *p;
+    int k, i;
+    if ((k = split(s, n, t)) < 0 || (room = OSA_MALLOC(4 * n + 8 * NTOK)) == NULL) {
+        fwrite(s, 1, n, tabout);
+        return;
+    }
+    p = room;
+    unreset(t, k, TFONT, "P");
+    unreset(t, k, TSIZE, "0");
+    unmove(t, k, &p, room + 4 * n + 8 * NTOK);
+    for (i = 0; i < k; i++)
+        switch (t[i].kind) {
+        case TTEXT:
+            fwrite(t[i].s, 1, t[i].n, tabout);
+            break;
+        case TFONT:
+            fprintf(tabout, t[i].n > 1 ? "\\f(%.2s" : "\\f%.1s", t[i].s);
+            break;
+        case TSIZE:
+            fprintf(tabout, "\\s%.*s", t[i].n, t[i].s);
+            break;
+        case THMOT:
+        case TVMOT:
+            fprintf(tabout, "\\%c'%.*s'", t[i].kind == THMOT ? 'h' : 'v', t[i].n, t[i].s);
+            break;
+        }
+    OSA_FREE(room);
+}
+
+/* Write out the row, a line at a time if it is to be tidied. */
+void rowend(void) {
+    char *p, *e, *nl;
+    if (rowout == NULL)
+        return;
+    tabout = rowout;
+    rowout = NULL;
+    if (fclose(rowf) != 0 || rowbuf == NULL)
+        error("Lost a table row");
+    if (!peepflg)
+        fwrite(rowbuf, 1, rowlen, tabout);
+    else
+        for (p = rowbuf, e = rowbuf + rowlen; p < e; p = nl + 1) {
+            if ((nl = memchr(p, '\n', e - p)) == NULL)
+                nl = e;
+            if (*p == '.' || *p == '\'')
+                fwrite(p, 1, nl - p, tabout);
+            else
+                tidy(p, nl - p);
+            if (nl < e)
+                putc('\n', tabout);
+        }
+    OSA_FREE(rowbuf);
+    rowbuf = NULL;
+}
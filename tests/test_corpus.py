@@ -0,0 +1,145 @@
+"""Golden-output and cost checks of croff over the benchmark corpora.
+
+Each corpus of ``make bench-docs`` is formatted by croff in nroff mode,
+and what it writes is compared byte for byte with
+``tests/golden/<corpus>.<mode>``.  This build of croff writes no text
+yet, so the output checks are expected failures, and no golden file is
+kept, until it does.  docbench then makes one run of each
+and reports the system calls it made and its peak resident size; these
+are compared with ``tests/perf_baseline.json``, and a count above the
+baseline by more than the tolerance given there fails.
+
+After a change meant to alter the output or the costs, run with
+``OTROFF_UPDATE=1`` set to rewrite the golden files and the baselines,
+and commit them with the change.  The tests are skipped until croff and
+docbench are built (``make croff build/bin/docbench``).
+"""
+
+from __future__ import annotations
+
+import functools
+import json
+import os
+import subprocess
+import tempfile
+from pathlib import Path
+
+import pytest
+
+ROOT = Path(__file__).resolve().parents[1]
+CROFF = ROOT / "build" / "bin" / "croff"
+DOCBENCH = ROOT / "build" / "bin" / "docbench"
+GOLDEN = Path(__file__).resolve().parent / "golden"
+BASELINE = Path(__file__).resolve().parent / "perf_baseline.json"
+
+# The corpora of make bench-docs, relative to the top of the tree.
+CORPORA = [
+    "bench/docs/man.txt",
+    "bench/docs/ms.txt",
+    "bench/eqn/inline.txt",
+    "bench/tbl/blocks.txt",
+    "bench/tbl/paper.txt",
+]
+
+# Output modes and the croff options that select them.
+MODES = {"nroff": []}
+
+# Counters of docbench's JSON that are checked against the baselines.
+COUNTERS = ["syscalls", "peak_kb"]
+
+
+def updating() -> bool:
+    """Whether to rewrite the golden files and baselines."""
+    return os.environ.get("OTROFF_UPDATE", "") not in ("", "0")
+
+
+def need(path: Path) -> None:
+    """Skip the test if the program at path has not been built."""
+    if not os.access(path, os.X_OK):
+        pytest.skip(f"{path.relative_to(ROOT)} is not built")
+
+
+def golden_path(corpus: str, mode: str) -> Path:
+    """The golden file for corpus formatted in mode."""
+    return GOLDEN / f"{Path(corpus).stem}.{mode}"
+
+
+@functools.lru_cache(maxsize=None)
+def measure(mode: str) -> dict[str, dict]:
+    """One docbench run of croff in mode over every corpus, by corpus."""
+    command = " ".join([str(CROFF.relative_to(ROOT))] + MODES[mode])
+    with tempfile.NamedTemporaryFile(suffix=".json") as out:
+        subprocess.run(
+            [str(DOCBENCH), "-n", "1", "-j", out.name, "-p", command, *CORPORA],
+            cwd=ROOT,
+            capture_output=True,
+            check=True,
+        )
+        results = json.load(open(out.name))["results"]
+    return {r["corpus"]: r for r in results}
+
+
+def load_baseline() -> dict:
+    """The stored baselines and their tolerances."""
+    return json.loads(BASELINE.read_text())
+
+
+@pytest.mark.parametrize("mode", sorted(MODES))
+@pytest.mark.parametrize("corpus", CORPORA)
+def test_golden_output(corpus: str, mode: str) -> None:
+    """croff writes exactly the golden output for each corpus."""
+    need(CROFF)
+
+    # The corpus goes in on standard input, as docbench gives it.
+    with open(ROOT / corpus, "rb") as source:
+        result = subprocess.run(
+            [str(CROFF), *MODES[mode]],
+            stdin=source,
+            capture_output=True,
+            check=True,
+            cwd=ROOT,
+        )
+    if not result.stdout:
+        pytest.xfail("croff writes no output yet")
+    gold = golden_path(corpus, mode)
+    if updating():
+        GOLDEN.mkdir(exist_ok=True)
+        gold.write_bytes(result.stdout)
+    assert gold.exists(), f"no {gold.name}; run with OTROFF_UPDATE=1"
+    expected = gold.read_bytes()
+
+    # Report the first line that differs rather than two byte strings.
+    if result.stdout != expected:
+        ours, theirs = result.stdout.split(b"\n"), expected.split(b"\n")
+        line = next(
+            (i for i, (a, b) in enumerate(zip(ours, theirs)) if a != b),
+            min(len(ours), len(theirs)),
+        )
+        pytest.fail(f"{corpus} ({mode}) differs from {gold.name} at line {line + 1}")
+
+
+@pytest.mark.parametrize("mode", sorted(MODES))
+@pytest.mark.parametrize("corpus", ["(start-up)", *CORPORA])
+def test_costs_within_baseline(corpus: str, mode: str) -> None:
+    """croff makes no more system calls, and uses no more memory, than before."""
+    need(CROFF)
+    need(DOCBENCH)
+
+    got = measure(mode)[corpus]
+    key = f"{mode} {corpus}"
+    stored = load_baseline()
+    if updating():
+        stored["baselines"][key] = {c: got[c] for c in COUNTERS}
+        BASELINE.write_text(json.dumps(stored, indent=2, sort_keys=True) + "\n")
+    assert key in stored["baselines"], f"no baseline for {key}; run with OTROFF_UPDATE=1"
+
+    # A counter may exceed its baseline by a fraction of it plus a constant.
+    for counter in COUNTERS:
+        base = stored["baselines"][key][counter]
+        if got[counter] < 0 or base < 0:
+            continue  # not counted here, or not when the baseline was taken
+        frac, slack = stored["tolerance"][counter]
+        limit = base * (1 + frac) + slack
+        assert got[counter] <= limit, (
+            f"{key}: {counter} {got[counter]} is over the baseline {base} (limit {limit:.0f})"
+        )
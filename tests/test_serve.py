@@ -0,0 +1,133 @@
+"""Checks of ``croff -D``, the formatter served on a Unix socket.
+
+A server is started on a socket in a temporary directory, with a job
+limit of two seconds, and each test submits jobs to it as a client
+would: option lines, an empty line, the document, and a shutdown of the
+writing side.  The reply is read back as its records.  The tests are
+skipped until croff is built (``make croff``).
+"""
+
+from __future__ import annotations
+
+import os
+import signal
+import socket
+import subprocess
+import time
+from pathlib import Path
+
+import pytest
+
+ROOT = Path(__file__).resolve().parents[1]
+CROFF = ROOT / "build" / "bin" / "croff"
+
+# The -L limits the server runs with: seconds, megabytes, kilobytes.
+LIMITS = "2,512,64"
+
+
+@pytest.fixture(scope="module")
+def server(tmp_path_factory):
+    """The socket of a croff -D server, stopped after the tests."""
+    if not os.access(CROFF, os.X_OK):
+        pytest.skip(f"{CROFF.relative_to(ROOT)} is not built")
+    path = tmp_path_factory.mktemp("serve") / "croff.sock"
+    proc = subprocess.Popen([str(CROFF), f"-D{path}", f"-L{LIMITS}", "-j2"], cwd=ROOT)
+    for _ in range(100):
+        if path.exists():
+            break
+        time.sleep(0.05)
+    else:
+        proc.kill()
+        pytest.fail("croff -D did not make its socket")
+    yield path, proc
+    if proc.poll() is None:
+        proc.terminate()
+        proc.wait(timeout=10)
+
+
+def job(path: Path, options: list[str], document: bytes, end: bool = True) -> list:
+    """Submit one job and return its reply as (kind, bytes or status) records."""
+    with socket.socket(socket.AF_UNIX) as s:
+        s.settimeout(10)
+        s.connect(str(path))
+        s.sendall("".join(o + "\n" for o in options).encode() + b"\n" + document)
+        if end:
+            s.shutdown(socket.SHUT_WR)
+        reply = b""
+        while chunk := s.recv(65536):
+            reply += chunk
+
+    records, i = [], 0
+    while i < len(reply):
+        j = reply.index(b"\n", i)
+        kind, arg = reply[i:j].decode().split(" ")
+        i = j + 1
+        if kind == "x":
+            records.append((kind, int(arg)))
+        else:
+            records.append((kind, reply[i : i + int(arg)]))
+            i += int(arg)
+    return records
+
+
+def status(records: list) -> int:
+    """The status the reply ends with."""
+    assert records and records[-1][0] == "x", f"reply not ended: {records}"
+    return records[-1][1]
+
+
+def output(records: list, kind: str = "o") -> bytes:
+    """The bytes of the records of one kind, in order."""
+    return b"".join(r[1] for r in records if r[0] == kind)
+
+
+def test_job_formats_like_croff(server) -> None:
+    """A job gets what croff writes for the same document and options."""
+    path, _ = server
+    document = b".ll 50\nA line of text for the server to format.\n"
+    direct = subprocess.run([str(CROFF), "-rx1"], input=document, capture_output=True, cwd=ROOT)
+    records = job(path, ["-rx1"], document)
+    assert status(records) == direct.returncode
+    assert output(records) == direct.stdout
+
+
+def test_jobs_do_not_share_state(server) -> None:
+    """What one job defines is gone in the next."""
+    path, _ = server
+    assert status(job(path, [], b".de xx\n..\n.nr y 7\n")) == 0
+    first = job(path, [], b".if d xx .tm leaked\n.if \\ny .tm leaked\n")
+    assert status(first) == 0
+    assert b"leaked" not in output(first, "e")
+
+
+def test_cold_options(server) -> None:
+    """Options the warm state cannot take start a croff of their own."""
+    path, _ = server
+    assert status(job(path, ["-T37", "-h"], b"Some text.\n")) == 0
+
+
+def test_refused_options(server) -> None:
+    """Lines that are not options, and -B or -D, get status 2."""
+    path, _ = server
+    for options in (["not-an-option"], ["-B.out"], ["-D/tmp/x"]):
+        records = job(path, options, b"text\n")
+        assert status(records) == 2
+        assert b"bad options" in output(records, "e")
+
+
+def test_time_limit(server) -> None:
+    """A job still running at the limit is stopped and reported."""
+    path, _ = server
+    start = time.monotonic()
+    records = job(path, [], b"A document that never ends", end=False)
+    assert status(records) == -1
+    assert b"time limit" in output(records, "e")
+    assert time.monotonic() - start < 6
+
+
+def test_stop(server) -> None:
+    """SIGTERM stops the server, which removes its socket."""
+    path, proc = server
+    proc.send_signal(signal.SIGTERM)
+    assert proc.wait(timeout=10) == 0
+    assert not path.exists()